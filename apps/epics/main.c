@@ -1353,6 +1353,7 @@ int main(int argc, char *argv[])
     BACNET_READ_ACCESS_DATA *rpm_object = NULL;
     KEY nextKey;
 
+    bactext_init();
     CheckCommandLineArgs(argc, argv); /* Won't return if there is an issue. */
     memset(&src, 0, sizeof(BACNET_ADDRESS));
 
@@ -254,6 +254,7 @@ int main(int argc, char *argv[])
     const char *filename = NULL;
     unsigned found_index = 0;
 
+    bactext_init();
     filename = filename_remove_path(argv[0]);
     for (argi = 1; argi < argc; argi++) {
         if (strcmp(argv[argi], "--help") == 0) {
@@ -28,6 +28,7 @@
 #include "bacnet/basic/tsm/tsm.h"
 #include "bacnet/basic/services.h"
 #include "bacnet/basic/sys/debug.h"
+#include "bacnet/basic/sys/mstimer.h"
 #include "bacnet/datalink/datalink.h"
 #include "bacnet/datalink/dlenv.h"
 /* include the device object */
@@ -62,6 +63,28 @@ static const char *BACnet_Version = BACNET_VERSION_TEXT;
 
 /* routed devices - I-Am on startup */
 static unsigned Routed_Device_Index;
+/* objects of the routed devices: only their own Device object.
+   The Device object functions are set by Routed_Device_Object_Table_Set() */
+static object_functions_t Routed_Object_Table[] = {
+    { OBJECT_DEVICE, NULL /* Init */, Device_Count,
+      NULL /* Index_To_Instance */, NULL /* Valid_Instance */,
+      NULL /* Object_Name */, NULL /* Read_Property */,
+      NULL /* Write_Property */, Device_Property_Lists,
+      NULL /* ReadRangeInfo */, NULL /* Iterator */,
+      NULL /* Value_Lists */, NULL /* COV */, NULL /* COV Clear */,
+      NULL /* Intrinsic Reporting */, NULL /* Add_List_Element */,
+      NULL /* Remove_List_Element */, NULL /* Create */, NULL /* Delete */,
+      NULL /* Timer */, NULL /* Read_Property_Multiple */ },
+    { MAX_BACNET_OBJECT_TYPE, NULL /* Init */, NULL /* Count */,
+      NULL /* Index_To_Instance */, NULL /* Valid_Instance */,
+      NULL /* Object_Name */, NULL /* Read_Property */,
+      NULL /* Write_Property */, NULL /* Property_Lists */,
+      NULL /* ReadRangeInfo */, NULL /* Iterator */, NULL /* Value_Lists */,
+      NULL /* COV */, NULL /* COV Clear */, NULL /* Intrinsic Reporting */,
+      NULL /* Add_List_Element */, NULL /* Remove_List_Element */,
+      NULL /* Create */, NULL /* Delete */, NULL /* Timer */,
+      NULL /* Read_Property_Multiple */ }
+};
 
 /** Initialize the Device Objects and each of the child Object instances.
  * @param first_object_instance Set the first (gateway) Device to this
@@ -70,6 +93,7 @@ static unsigned Routed_Device_Index;
 static void Devices_Init(uint32_t first_object_instance)
 {
     int i;
+    uint16_t idx;
     char nameText[MAX_DEV_NAME_LEN];
     char descText[MAX_DEV_DESC_LEN];
     BACNET_CHARACTER_STRING name_string;
@@ -79,12 +103,15 @@ static void Devices_Init(uint32_t first_object_instance)
     Routed_Device_Set_Description(DEV_DESCR_GATEWAY, strlen(DEV_DESCR_GATEWAY));
 
     /* Now initialize the remote Device objects. */
-    for (i = 1; i < MAX_NUM_DEVICES; i++) {
+    for (i = 1; i < Routed_Device_Max(); i++) {
         snprintf(nameText, MAX_DEV_NAME_LEN, "%s %d", DEV_NAME_BASE, i + 1);
         snprintf(descText, MAX_DEV_DESC_LEN, "%s %d", DEV_DESCR_REMOTE, i);
         characterstring_init_ansi(&name_string, nameText);
 
-        Add_Routed_Device((first_object_instance + i), &name_string, descText);
+        idx = Add_Routed_Device(
+            (first_object_instance + i), &name_string, descText);
+        /* each routed Device has only its own Device object */
+        Routed_Device_Object_Table_Set(idx, Routed_Object_Table);
     }
 }
 
@@ -101,6 +128,7 @@ static void Initialize_Device_Addresses(void)
     int i = 0; /* First entry is Gateway Device */
     uint32_t virtual_mac = 0;
     BACNET_ADDRESS virtual_address = { 0 };
+    BACNET_ADDRESS routed_address = { 0 };
     DEVICE_OBJECT_DATA *pDev = NULL;
     /* Setup info for the main gateway device first */
     pDev = Get_Routed_Device_Object(i);
@@ -121,23 +149,25 @@ static void Initialize_Device_Addresses(void)
 #else
 #error "No support for this Data Link Layer type "
 #endif
-    bacnet_address_copy(&pDev->bacDevAddr, &virtual_address);
+    Routed_Device_Address_Set(i, &virtual_address);
     /* broadcast an I-Am on startup */
+    Routed_Device_Context_Set(i);
     Send_I_Am(&Handler_Transmit_Buffer[0]);
 
-    for (i = 1; i < MAX_NUM_DEVICES; i++) {
+    for (i = 1; i < Routed_Device_Count(); i++) {
         pDev = Get_Routed_Device_Object(i);
         if (pDev == NULL) {
             continue;
         }
         /* start with the router address */
-        bacnet_address_copy(&pDev->bacDevAddr, &virtual_address);
+        bacnet_address_copy(&routed_address, &virtual_address);
         /* add the network number to each gateway device */
-        pDev->bacDevAddr.net = VIRTUAL_DNET;
+        routed_address.net = VIRTUAL_DNET;
         /* use a virtual MAC for each gateway device */
         virtual_mac = pDev->bacObj.Object_Instance_Number;
-        encode_unsigned24(&pDev->bacDevAddr.adr[0], virtual_mac);
-        pDev->bacDevAddr.len = 3;
+        encode_unsigned24(&routed_address.adr[0], virtual_mac);
+        routed_address.len = 3;
+        Routed_Device_Address_Set(i, &routed_address);
     }
 }
 
@@ -153,10 +183,11 @@ static void Init_Service_Handlers(uint32_t first_object_instance)
      * For the gateway, we will use the unicast variety so we can
      * get back through switches to different subnets.
      * Don't need the routed versions, since the npdu handler calls
-     * each device in turn.
+     * each device in turn.  The I-Am responses are scheduled with a
+     * random delay so the routed devices do not answer in one burst.
      */
     apdu_set_unconfirmed_handler(
-        SERVICE_UNCONFIRMED_WHO_IS, handler_who_is_unicast);
+        SERVICE_UNCONFIRMED_WHO_IS, handler_who_is_unicast_scheduled);
     apdu_set_unconfirmed_handler(SERVICE_UNCONFIRMED_WHO_HAS, handler_who_has);
     /* set the handler for all the services we don't implement */
     /* It is required to send the proper reject message... */
@@ -199,19 +230,22 @@ static void Init_Service_Handlers(uint32_t first_object_instance)
  *      handler_cov_task, tsm_timer_milliseconds
  *
  * @param argc [in] Arg count.
- * @param argv [in] Takes one argument: the Device Instance #.
+ * @param argv [in] Takes two optional arguments: the Device Instance #
+ *  of the gateway, and the number of Devices including the gateway.
  * @return 0 on success.
  */
 int main(int argc, char *argv[])
 {
     BACNET_ADDRESS src = { 0 }; /* address where message came from */
     uint16_t pdu_len = 0;
-    unsigned timeout = 1000; /* milliseconds */
+    unsigned timeout = 10; /* milliseconds */
+    struct mstimer who_is_timer;
     time_t last_seconds = 0;
     time_t current_seconds = 0;
     uint32_t elapsed_seconds = 0;
     uint32_t elapsed_milliseconds = 0;
     uint32_t first_object_instance = FIRST_DEVICE_NUMBER;
+    long device_count = MAX_NUM_DEVICES;
 #ifdef BACNET_TEST_VMAC
     /* Router data */
     BACNET_DEVICE_PROFILE *device;
@@ -228,18 +262,31 @@ int main(int argc, char *argv[])
             exit(1);
         }
     }
+    /* allow the number of devices, including the gateway, to be set */
+    if (argc > 2) {
+        device_count = strtol(argv[2], NULL, 0);
+        if ((device_count < 1) || (device_count >= UINT16_MAX)) {
+            printf("Error: Invalid Device count %s \n", argv[2]);
+            printf("Provide a number from 1 to %u \n", UINT16_MAX - 1);
+            exit(1);
+        }
+    }
+    Routed_Device_Max_Set((uint16_t)device_count);
     printf(
         "BACnet Router Demo\n"
         "BACnet Stack Version %s\n"
         "BACnet Device ID: %u\n"
         "Max APDU: %d\n"
         "Max Devices: %d\n",
-        BACnet_Version, first_object_instance, MAX_APDU, MAX_NUM_DEVICES);
+        BACnet_Version, first_object_instance, MAX_APDU,
+        (int)Routed_Device_Max());
     Init_Service_Handlers(first_object_instance);
     dlenv_init();
     atexit(datalink_cleanup);
     Devices_Init(first_object_instance);
     Initialize_Device_Addresses();
+    /* the I-Am queue holds a response from each routed device */
+    handler_who_is_scheduled_init(Routed_Device_Max());
 
 #ifdef BACNET_TEST_VMAC
     /* initialize vmac table and router device */
@@ -248,6 +295,8 @@ int main(int argc, char *argv[])
 #endif
     /* configure the timeout values */
     last_seconds = time(NULL);
+    /* the I-Am responses of the routed devices are spread out */
+    mstimer_set(&who_is_timer, 10);
 
     /* broadcast an I-am-router-to-network on startup */
     printf("Remote Network DNET Number %d \n", DNET_list[0]);
@@ -276,12 +325,17 @@ int main(int argc, char *argv[])
             tsm_timer_milliseconds(elapsed_milliseconds);
             Device_Timer(elapsed_milliseconds);
         }
+        if (mstimer_expired(&who_is_timer)) {
+            mstimer_reset(&who_is_timer);
+            handler_who_is_timer(mstimer_interval(&who_is_timer));
+        }
         handler_cov_task();
-        if (Routed_Device_Index < MAX_NUM_DEVICES) {
+        if ((Routed_Device_Index + 1) < Routed_Device_Count()) {
             Routed_Device_Index++;
-            Get_Routed_Device_Object(Routed_Device_Index);
             /* broadcast an I-Am for each routed Device now */
+            Routed_Device_Context_Set(Routed_Device_Index);
             Send_I_Am(&Handler_Transmit_Buffer[0]);
+            Routed_Device_Context_Set(0);
         }
     }
     /* Dummy return */
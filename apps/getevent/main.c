@@ -192,6 +192,7 @@ int main(int argc, char *argv[])
     time_t timeout_seconds = 0;
     bool found = false;
 
+    bactext_init();
     LastReceivedObjectIdentifier.instance = 0;
     LastReceivedObjectIdentifier.type = 0;
     if (argc <= 1) {
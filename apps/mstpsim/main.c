@@ -0,0 +1,740 @@
+/**
+ * @file
+ * @brief command line tool that simulates an MS/TP line of master nodes
+ * on an in-process virtual bus, so that token rotation time, frames per
+ * second, reply latency, and Max_Info_Frames and Max_Master tuning can
+ * be measured without RS-485 hardware.
+ *
+ * The bus runs in virtual time: one step is the time of one octet
+ * (10 bit times) at the simulated baud rate, so a simulation is
+ * deterministic and runs faster than the real line would.
+ * @author Steve Karg <skarg@users.sourceforge.net>
+ * @date 2026
+ * @copyright SPDX-License-Identifier: MIT
+ */
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+/* BACnet Stack defines - first */
+#include "bacnet/bacdef.h"
+/* BACnet Stack API */
+#include "bacnet/npdu.h"
+#include "bacnet/version.h"
+#include "bacnet/basic/sys/filename.h"
+#include "bacnet/datalink/mstp.h"
+#include "bacnet/datalink/mstpdef.h"
+
+#ifndef MSTPSIM_NODES_MAX
+#define MSTPSIM_NODES_MAX 128
+#endif
+/* largest MS/TP frame: header, data, and data CRC */
+#define MSTPSIM_MPDU_MAX (8 + MAX_PDU + 2)
+/* a node may queue a frame while its previous frame is on the wire */
+#define MSTPSIM_TX_MAX (2 * MSTPSIM_MPDU_MAX)
+/* BACnet ReadProperty service choice, used for the simulated requests */
+#define MSTPSIM_SERVICE_CHOICE 12
+
+/* data for one simulated MS/TP node */
+struct mstpsim_node {
+    struct mstp_port_struct_t port;
+    uint8_t input_buffer[MSTPSIM_MPDU_MAX];
+    uint8_t output_buffer[MSTPSIM_MPDU_MAX];
+    /* virtual time of the last silence timer reset */
+    uint64_t silence_start_us;
+    /* octets queued for, or being sent on, the bus */
+    uint8_t tx_buffer[MSTPSIM_TX_MAX];
+    unsigned tx_len;
+    unsigned tx_index;
+    /* application traffic */
+    double pdu_credit;
+    uint8_t invoke_id;
+    uint64_t request_time_us[256];
+    bool request_pending[256];
+    bool reply_pending;
+    uint8_t reply_destination;
+    uint8_t reply_invoke_id;
+    uint64_t reply_ready_us;
+    /* token rotation */
+    uint64_t token_time_us;
+    bool token_seen;
+};
+
+/* simulation parameters */
+static unsigned Nodes_Count = 4;
+static uint32_t Baud_Rate = 38400;
+static uint8_t Max_Info_Frames = 1;
+static uint8_t Max_Master = 127;
+static unsigned Duration_Seconds = 10;
+static unsigned PDU_Rate;
+static unsigned APDU_Size = 50;
+static unsigned DER_Percent = 50;
+static unsigned Reply_Delay_Milliseconds;
+static unsigned Minimum_Frames_Per_Second;
+static unsigned Random_Seed = 1;
+static bool Verbose;
+
+static struct mstpsim_node Nodes[MSTPSIM_NODES_MAX];
+/* virtual time in microseconds */
+static uint64_t Now_us;
+/* virtual time when the last octet was on the bus */
+static uint64_t Bus_Active_us;
+
+/* statistics */
+static unsigned long Frames_Sent;
+static unsigned long Frames_Token;
+static unsigned long Frames_Poll_For_Master;
+static unsigned long Frames_Data;
+static unsigned long Frames_Reply_Postponed;
+static unsigned long PDU_Received;
+static unsigned long Octets_Sent;
+static unsigned long Collisions;
+static unsigned long Token_Rotations;
+static uint64_t Token_Rotation_Sum_us;
+static uint64_t Token_Rotation_Max_us;
+static uint64_t Token_Rotation_Min_us;
+static unsigned long Replies;
+static uint64_t Reply_Latency_Sum_us;
+static uint64_t Reply_Latency_Max_us;
+
+/**
+ * @brief Get the elapsed silence time of a node, in milliseconds
+ * @param pArg - the MS/TP port of the node
+ * @return milliseconds since the silence timer was reset
+ */
+static uint32_t Timer_Silence(void *pArg)
+{
+    struct mstp_port_struct_t *mstp_port = pArg;
+    struct mstpsim_node *node = mstp_port->UserData;
+
+    return (uint32_t)((Now_us - node->silence_start_us) / 1000);
+}
+
+/**
+ * @brief Reset the silence timer of a node
+ * @param pArg - the MS/TP port of the node
+ */
+static void Timer_Silence_Reset(void *pArg)
+{
+    struct mstp_port_struct_t *mstp_port = pArg;
+    struct mstpsim_node *node = mstp_port->UserData;
+
+    node->silence_start_us = Now_us;
+}
+
+/**
+ * @brief Encode the NPDU and APDU of a simulated PDU
+ * @param pdu - buffer for the PDU
+ * @param pdu_size - size of the buffer
+ * @param pdu_type - APDU type: confirmed request, unconfirmed request,
+ *  or simple ACK
+ * @param invoke_id - invoke ID of the request or reply
+ * @return number of bytes encoded
+ */
+static uint16_t mstpsim_pdu_encode(
+    uint8_t *pdu, uint16_t pdu_size, uint8_t pdu_type, uint8_t invoke_id)
+{
+    BACNET_NPDU_DATA npdu_data = { 0 };
+    uint16_t pdu_len = 0;
+    unsigned i;
+
+    npdu_encode_npdu_data(
+        &npdu_data, pdu_type == PDU_TYPE_CONFIRMED_SERVICE_REQUEST,
+        MESSAGE_PRIORITY_NORMAL);
+    pdu_len = bacnet_npdu_encode_pdu(pdu, pdu_size, NULL, NULL, &npdu_data);
+    pdu[pdu_len++] = pdu_type;
+    if (pdu_type == PDU_TYPE_CONFIRMED_SERVICE_REQUEST) {
+        pdu[pdu_len++] = 0x05; /* max segments, max APDU */
+        pdu[pdu_len++] = invoke_id;
+        pdu[pdu_len++] = MSTPSIM_SERVICE_CHOICE;
+    } else if (pdu_type == PDU_TYPE_SIMPLE_ACK) {
+        pdu[pdu_len++] = invoke_id;
+        pdu[pdu_len++] = MSTPSIM_SERVICE_CHOICE;
+        return pdu_len;
+    } else {
+        pdu[pdu_len++] = SERVICE_UNCONFIRMED_PRIVATE_TRANSFER;
+    }
+    /* pad the service data to the configured APDU size */
+    for (i = 0; (i < APDU_Size) && (pdu_len < pdu_size); i++) {
+        pdu[pdu_len++] = (uint8_t)i;
+    }
+
+    return pdu_len;
+}
+
+/**
+ * @brief Get the APDU type and invoke ID of a received PDU
+ * @param pdu - received PDU
+ * @param pdu_len - number of bytes in the PDU
+ * @param invoke_id - [out] invoke ID of a request or reply
+ * @return APDU type, or 0xFF if not an APDU
+ */
+static uint8_t
+mstpsim_pdu_decode(const uint8_t *pdu, uint16_t pdu_len, uint8_t *invoke_id)
+{
+    BACNET_NPDU_DATA npdu_data = { 0 };
+    int offset;
+    uint8_t pdu_type;
+
+    offset = bacnet_npdu_decode(pdu, pdu_len, NULL, NULL, &npdu_data);
+    if ((offset <= 0) || npdu_data.network_layer_message ||
+        ((offset + 2) >= pdu_len)) {
+        return 0xFF;
+    }
+    pdu_type = pdu[offset] & 0xF0;
+    if (pdu_type == PDU_TYPE_CONFIRMED_SERVICE_REQUEST) {
+        *invoke_id = pdu[offset + 2];
+    } else if (pdu_type == PDU_TYPE_SIMPLE_ACK) {
+        *invoke_id = pdu[offset + 1];
+    }
+
+    return pdu_type;
+}
+
+/**
+ * @brief MS/TP state machine callback to put received data
+ * @param mstp_port - the MS/TP port of the node
+ * @return number of bytes received
+ */
+uint16_t MSTP_Put_Receive(struct mstp_port_struct_t *mstp_port)
+{
+    struct mstpsim_node *node = mstp_port->UserData;
+    uint8_t invoke_id = 0;
+    uint8_t pdu_type;
+    uint64_t latency;
+
+    PDU_Received++;
+    pdu_type = mstpsim_pdu_decode(
+        mstp_port->InputBuffer, mstp_port->DataLength, &invoke_id);
+    if (pdu_type == PDU_TYPE_CONFIRMED_SERVICE_REQUEST) {
+        node->reply_pending = true;
+        node->reply_destination = mstp_port->SourceAddress;
+        node->reply_invoke_id = invoke_id;
+        node->reply_ready_us =
+            Now_us + ((uint64_t)Reply_Delay_Milliseconds * 1000);
+    } else if (pdu_type == PDU_TYPE_SIMPLE_ACK) {
+        if (node->request_pending[invoke_id]) {
+            node->request_pending[invoke_id] = false;
+            latency = Now_us - node->request_time_us[invoke_id];
+            Replies++;
+            Reply_Latency_Sum_us += latency;
+            if (latency > Reply_Latency_Max_us) {
+                Reply_Latency_Max_us = latency;
+            }
+        }
+    }
+
+    return mstp_port->DataLength;
+}
+
+/**
+ * @brief Create the frame of a pending reply, if it is ready
+ * @param mstp_port - the MS/TP port of the node
+ * @param destination - MAC address the reply is for
+ * @return number of bytes in the frame, or 0 if no reply is ready
+ */
+static uint16_t
+mstpsim_reply_frame(struct mstp_port_struct_t *mstp_port, uint8_t destination)
+{
+    struct mstpsim_node *node = mstp_port->UserData;
+    uint8_t pdu[MAX_PDU];
+    uint16_t pdu_len;
+
+    if (!node->reply_pending || (node->reply_destination != destination) ||
+        (Now_us < node->reply_ready_us)) {
+        return 0;
+    }
+    node->reply_pending = false;
+    pdu_len = mstpsim_pdu_encode(
+        pdu, sizeof(pdu), PDU_TYPE_SIMPLE_ACK, node->reply_invoke_id);
+
+    return MSTP_Create_Frame(
+        mstp_port->OutputBuffer, mstp_port->OutputBufferSize,
+        FRAME_TYPE_BACNET_DATA_NOT_EXPECTING_REPLY, destination,
+        mstp_port->This_Station, pdu, pdu_len);
+}
+
+/**
+ * @brief MS/TP state machine callback to get data to send
+ * @param mstp_port - the MS/TP port of the node
+ * @param timeout - not used
+ * @return number of bytes in the frame, or 0 if nothing to send
+ */
+uint16_t MSTP_Get_Send(struct mstp_port_struct_t *mstp_port, unsigned timeout)
+{
+    struct mstpsim_node *node = mstp_port->UserData;
+    uint8_t pdu[MAX_PDU];
+    uint16_t pdu_len;
+    uint8_t destination;
+    uint8_t frame_type;
+    bool expecting_reply;
+
+    (void)timeout;
+    /* a postponed reply goes first */
+    if (node->reply_pending) {
+        pdu_len = mstpsim_reply_frame(mstp_port, node->reply_destination);
+        if (pdu_len) {
+            return pdu_len;
+        }
+    }
+    if (PDU_Rate && (node->pdu_credit < 1.0)) {
+        return 0;
+    }
+    destination = (uint8_t)((mstp_port->This_Station + 1) % Nodes_Count);
+    if (destination == mstp_port->This_Station) {
+        return 0;
+    }
+    expecting_reply = ((unsigned)(rand() % 100) < DER_Percent);
+    if (expecting_reply) {
+        node->invoke_id++;
+        if (node->request_pending[node->invoke_id]) {
+            /* no free invoke ID - wait for the replies */
+            node->invoke_id--;
+            return 0;
+        }
+        node->request_pending[node->invoke_id] = true;
+        node->request_time_us[node->invoke_id] = Now_us;
+        pdu_len = mstpsim_pdu_encode(
+            pdu, sizeof(pdu), PDU_TYPE_CONFIRMED_SERVICE_REQUEST,
+            node->invoke_id);
+        frame_type = FRAME_TYPE_BACNET_DATA_EXPECTING_REPLY;
+    } else {
+        pdu_len = mstpsim_pdu_encode(
+            pdu, sizeof(pdu), PDU_TYPE_UNCONFIRMED_SERVICE_REQUEST, 0);
+        frame_type = FRAME_TYPE_BACNET_DATA_NOT_EXPECTING_REPLY;
+    }
+    if (PDU_Rate) {
+        node->pdu_credit -= 1.0;
+    }
+
+    return MSTP_Create_Frame(
+        mstp_port->OutputBuffer, mstp_port->OutputBufferSize, frame_type,
+        destination, mstp_port->This_Station, pdu, pdu_len);
+}
+
+/**
+ * @brief MS/TP state machine callback to get the reply to a
+ *  DATA_EXPECTING_REPLY frame
+ * @param mstp_port - the MS/TP port of the node
+ * @param timeout - not used
+ * @return number of bytes in the frame, or 0 to send Reply Postponed
+ */
+uint16_t MSTP_Get_Reply(struct mstp_port_struct_t *mstp_port, unsigned timeout)
+{
+    (void)timeout;
+
+    return mstpsim_reply_frame(mstp_port, mstp_port->SourceAddress);
+}
+
+/**
+ * @brief MS/TP state machine callback to send a frame on the bus.
+ *  The node is blocked until the frame has been sent, as it would
+ *  be with a real RS-485 driver.
+ * @param mstp_port - the MS/TP port of the node
+ * @param buffer - frame to send
+ * @param nbytes - number of bytes in the frame
+ */
+void MSTP_Send_Frame(
+    struct mstp_port_struct_t *mstp_port,
+    const uint8_t *buffer,
+    uint16_t nbytes)
+{
+    struct mstpsim_node *node = mstp_port->UserData;
+
+    if ((node->tx_len + nbytes) > sizeof(node->tx_buffer)) {
+        fprintf(
+            stderr, "MS/TP node %u: transmit overrun!\n",
+            (unsigned)mstp_port->This_Station);
+        return;
+    }
+    memcpy(&node->tx_buffer[node->tx_len], buffer, nbytes);
+    node->tx_len += nbytes;
+    Frames_Sent++;
+    switch (buffer[2]) {
+        case FRAME_TYPE_TOKEN:
+            Frames_Token++;
+            break;
+        case FRAME_TYPE_POLL_FOR_MASTER:
+            Frames_Poll_For_Master++;
+            break;
+        case FRAME_TYPE_REPLY_POSTPONED:
+            Frames_Reply_Postponed++;
+            break;
+        case FRAME_TYPE_BACNET_DATA_EXPECTING_REPLY:
+        case FRAME_TYPE_BACNET_DATA_NOT_EXPECTING_REPLY:
+        case FRAME_TYPE_BACNET_EXTENDED_DATA_EXPECTING_REPLY:
+        case FRAME_TYPE_BACNET_EXTENDED_DATA_NOT_EXPECTING_REPLY:
+            Frames_Data++;
+            break;
+        default:
+            break;
+    }
+}
+
+/**
+ * @brief Initialize the simulated nodes
+ */
+static void mstpsim_init(void)
+{
+    struct mstpsim_node *node;
+    unsigned i;
+
+    for (i = 0; i < Nodes_Count; i++) {
+        node = &Nodes[i];
+        memset(node, 0, sizeof(*node));
+        node->port.UserData = node;
+        node->port.This_Station = (uint8_t)i;
+        node->port.Nmax_info_frames = Max_Info_Frames;
+        node->port.Nmax_master = Max_Master;
+        node->port.InputBuffer = node->input_buffer;
+        node->port.InputBufferSize = sizeof(node->input_buffer);
+        node->port.OutputBuffer = node->output_buffer;
+        node->port.OutputBufferSize = sizeof(node->output_buffer);
+        node->port.SilenceTimer = Timer_Silence;
+        node->port.SilenceTimerReset = Timer_Silence_Reset;
+        node->port.Tframe_abort = 1 + ((60 * 1000UL) / Baud_Rate);
+        node->port.Tturnaround_timeout =
+            1 + ((Tturnaround * 1000UL) / Baud_Rate);
+        MSTP_Init(&node->port);
+    }
+}
+
+/**
+ * @brief Measure the token rotation time at the first node
+ * @param node - node that received a valid frame
+ */
+static void mstpsim_token_rotation(struct mstpsim_node *node)
+{
+    uint64_t rotation;
+
+    if ((node->port.FrameType != FRAME_TYPE_TOKEN) ||
+        (node->port.DestinationAddress != node->port.This_Station)) {
+        return;
+    }
+    if (node->token_seen) {
+        rotation = Now_us - node->token_time_us;
+        Token_Rotations++;
+        Token_Rotation_Sum_us += rotation;
+        if (rotation > Token_Rotation_Max_us) {
+            Token_Rotation_Max_us = rotation;
+        }
+        if ((Token_Rotations == 1) || (rotation < Token_Rotation_Min_us)) {
+            Token_Rotation_Min_us = rotation;
+        }
+    }
+    node->token_seen = true;
+    node->token_time_us = Now_us;
+}
+
+/**
+ * @brief Put the next octet of each transmitting node on the bus, and
+ *  deliver it to every other node
+ * @param turnaround_us - minimum bus silence before a node starts sending
+ */
+static void mstpsim_bus_task(uint64_t turnaround_us)
+{
+    struct mstpsim_node *node;
+    unsigned i, j, talkers = 0;
+    uint8_t octet = 0;
+    unsigned talker = 0;
+
+    for (i = 0; i < Nodes_Count; i++) {
+        node = &Nodes[i];
+        if (node->tx_index >= node->tx_len) {
+            continue;
+        }
+        if ((node->tx_index == 0) &&
+            (Now_us < (Bus_Active_us + turnaround_us))) {
+            /* wait for the turnaround time before enabling the driver */
+            continue;
+        }
+        octet = node->tx_buffer[node->tx_index++];
+        talker = i;
+        talkers++;
+        Octets_Sent++;
+        /* the silence timer is reset as each octet is transmitted */
+        node->silence_start_us = Now_us;
+        if (node->tx_index >= node->tx_len) {
+            node->tx_index = 0;
+            node->tx_len = 0;
+        }
+    }
+    if (talkers == 0) {
+        return;
+    }
+    if (talkers > 1) {
+        Collisions++;
+    }
+    Bus_Active_us = Now_us;
+    for (j = 0; j < Nodes_Count; j++) {
+        node = &Nodes[j];
+        if ((talkers == 1) && (j == talker)) {
+            continue;
+        }
+        if (talkers > 1) {
+            node->port.ReceiveError = true;
+        } else {
+            node->port.DataRegister = octet;
+            node->port.DataAvailable = true;
+        }
+    }
+}
+
+/**
+ * @brief Run the receive and master node state machines of a node
+ * @param node - node to run
+ */
+static void mstpsim_node_task(struct mstpsim_node *node)
+{
+    unsigned loops = 0;
+
+    if (node->tx_len) {
+        /* blocked while sending */
+        return;
+    }
+    if (!node->port.ReceivedValidFrame && !node->port.ReceivedInvalidFrame) {
+        MSTP_Receive_Frame_FSM(&node->port);
+        if (node->port.ReceivedValidFrame) {
+            mstpsim_token_rotation(node);
+        }
+    }
+    while (MSTP_Master_Node_FSM(&node->port) && (node->tx_len == 0) &&
+           (loops < 255)) {
+        /* do nothing while immediate transitioning */
+        loops++;
+    }
+}
+
+/**
+ * @brief Run the simulation for the configured duration
+ */
+static void mstpsim_run(void)
+{
+    uint64_t end_us;
+    uint64_t octet_count = 0;
+    uint64_t turnaround_us;
+    double pdu_per_octet = 0.0;
+    unsigned i;
+
+    end_us = (uint64_t)Duration_Seconds * 1000000UL;
+    turnaround_us = ((uint64_t)Tturnaround * 1000000UL) / Baud_Rate;
+    if (PDU_Rate) {
+        pdu_per_octet = (double)PDU_Rate * 10.0 / (double)Baud_Rate;
+    }
+    while (Now_us < end_us) {
+        octet_count++;
+        Now_us = (octet_count * 10 * 1000000UL) / Baud_Rate;
+        mstpsim_bus_task(turnaround_us);
+        for (i = 0; i < Nodes_Count; i++) {
+            if (PDU_Rate && (Nodes[i].pdu_credit < 2.0)) {
+                Nodes[i].pdu_credit += pdu_per_octet;
+            }
+            mstpsim_node_task(&Nodes[i]);
+        }
+    }
+}
+
+/**
+ * @brief Print the simulation results
+ * @return frames per second on the bus
+ */
+static unsigned long mstpsim_report(void)
+{
+    unsigned long frames_per_second;
+    double utilization;
+
+    frames_per_second = Frames_Sent / Duration_Seconds;
+    utilization = (100.0 * (double)Octets_Sent * 10.0) /
+        ((double)Baud_Rate * (double)Duration_Seconds);
+    printf(
+        "MS/TP simulation: %u nodes, %lu bps, Max_Info_Frames=%u, "
+        "Max_Master=%u, %u seconds\n",
+        Nodes_Count, (unsigned long)Baud_Rate, (unsigned)Max_Info_Frames,
+        (unsigned)Max_Master, Duration_Seconds);
+    printf(
+        "frames: %lu (%lu/s) token=%lu poll-for-master=%lu data=%lu "
+        "reply-postponed=%lu\n",
+        Frames_Sent, frames_per_second, Frames_Token, Frames_Poll_For_Master,
+        Frames_Data, Frames_Reply_Postponed);
+    printf(
+        "PDU received: %lu (%lu/s), bus utilization: %.1f%%\n", PDU_Received,
+        PDU_Received / Duration_Seconds, utilization);
+    if (Token_Rotations) {
+        printf(
+            "token rotation: min=%.2fms avg=%.2fms max=%.2fms\n",
+            (double)Token_Rotation_Min_us / 1000.0,
+            (double)Token_Rotation_Sum_us / (1000.0 * Token_Rotations),
+            (double)Token_Rotation_Max_us / 1000.0);
+    } else {
+        printf("token rotation: none\n");
+    }
+    if (Replies) {
+        printf(
+            "reply latency: avg=%.2fms max=%.2fms (%lu replies)\n",
+            (double)Reply_Latency_Sum_us / (1000.0 * Replies),
+            (double)Reply_Latency_Max_us / 1000.0, Replies);
+    }
+    printf("collisions: %lu\n", Collisions);
+
+    return frames_per_second;
+}
+
+static void print_usage(const char *filename)
+{
+    printf("Usage: %s [--nodes N][--baud B][--max-info-frames N]\n", filename);
+    printf("       [--max-master N][--seconds N][--rate N][--size N]\n");
+    printf("       [--der N][--reply-delay N][--min-fps N][--seed N]\n");
+    printf("       [--verbose][--version][--help]\n");
+}
+
+static void print_help(const char *filename)
+{
+    printf("Simulate MS/TP master nodes on a virtual bus and report\n"
+           "the token rotation time, frames per second and reply latency.\n");
+    printf("\n");
+    printf("--nodes N\n"
+           "Number of master nodes, using MAC addresses 0 to N-1.\n"
+           "Each node sends its PDUs to the next node. Default 4.\n");
+    printf("--baud B\n"
+           "Baud rate of the simulated line. Default 38400.\n");
+    printf("--max-info-frames N\n"
+           "Max_Info_Frames of every node. Default 1.\n");
+    printf("--max-master N\n"
+           "Max_Master of every node. Default 127.\n");
+    printf("--seconds N\n"
+           "Simulated time to run. Default 10.\n");
+    printf("--rate N\n"
+           "PDUs per second queued by each node, or 0 to always have\n"
+           "a PDU to send. Default 0.\n");
+    printf("--size N\n"
+           "APDU service data size of each PDU. Default 50.\n");
+    printf("--der N\n"
+           "Percent of PDUs that are confirmed requests expecting\n"
+           "a reply. Default 50.\n");
+    printf("--reply-delay N\n"
+           "Milliseconds a node takes to build a reply. Replies that\n"
+           "are not ready in time are sent after a Reply Postponed.\n"
+           "Default 0.\n");
+    printf("--min-fps N\n"
+           "Exit with an error if fewer than N frames per second\n"
+           "were sent, for use in regression tests.\n");
+    printf("--seed N\n"
+           "Seed of the random choice of the PDUs that expect a reply,\n"
+           "so that runs with the same seed are repeatable. Default 1.\n");
+    printf("\n");
+    printf(
+        "Example:\n"
+        "%s --nodes 32 --baud 76800 --max-master 31 --max-info-frames 4\n",
+        filename);
+}
+
+int main(int argc, char *argv[])
+{
+    int argi = 0;
+    const char *filename = NULL;
+    unsigned long value;
+    unsigned long frames_per_second;
+
+    filename = filename_remove_path(argv[0]);
+    for (argi = 1; argi < argc; argi++) {
+        if (strcmp(argv[argi], "--help") == 0) {
+            print_usage(filename);
+            print_help(filename);
+            return 0;
+        }
+        if (strcmp(argv[argi], "--version") == 0) {
+            printf("%s %s\n", filename, BACNET_VERSION_TEXT);
+            printf("Copyright (C) 2026 by Steve Karg and others.\n"
+                   "This is free software; see the source for copying "
+                   "conditions.\n"
+                   "There is NO warranty; not even for MERCHANTABILITY or\n"
+                   "FITNESS FOR A PARTICULAR PURPOSE.\n");
+            return 0;
+        }
+        if (strcmp(argv[argi], "--verbose") == 0) {
+            Verbose = true;
+            continue;
+        }
+        if ((argi + 1) >= argc) {
+            print_usage(filename);
+            return 1;
+        }
+        value = strtoul(argv[argi + 1], NULL, 0);
+        if (strcmp(argv[argi], "--nodes") == 0) {
+            if ((value < 1) || (value > MSTPSIM_NODES_MAX) ||
+                (value > (MSTP_BROADCAST_ADDRESS - 1))) {
+                fprintf(
+                    stderr, "nodes must be 1 to %u\n",
+                    (unsigned)MSTPSIM_NODES_MAX);
+                return 1;
+            }
+            Nodes_Count = (unsigned)value;
+        } else if (strcmp(argv[argi], "--baud") == 0) {
+            if (value < 1200) {
+                fprintf(stderr, "baud must be 1200 or more\n");
+                return 1;
+            }
+            Baud_Rate = (uint32_t)value;
+        } else if (strcmp(argv[argi], "--max-info-frames") == 0) {
+            if ((value < 1) || (value > 255)) {
+                fprintf(stderr, "max-info-frames must be 1 to 255\n");
+                return 1;
+            }
+            Max_Info_Frames = (uint8_t)value;
+        } else if (strcmp(argv[argi], "--max-master") == 0) {
+            if (value > 127) {
+                fprintf(stderr, "max-master must be 0 to 127\n");
+                return 1;
+            }
+            Max_Master = (uint8_t)value;
+        } else if (strcmp(argv[argi], "--seconds") == 0) {
+            Duration_Seconds = (value > 0) ? (unsigned)value : 1;
+        } else if (strcmp(argv[argi], "--rate") == 0) {
+            PDU_Rate = (unsigned)value;
+        } else if (strcmp(argv[argi], "--size") == 0) {
+            APDU_Size = (unsigned)value;
+        } else if (strcmp(argv[argi], "--der") == 0) {
+            DER_Percent = (value > 100) ? 100 : (unsigned)value;
+        } else if (strcmp(argv[argi], "--reply-delay") == 0) {
+            Reply_Delay_Milliseconds = (unsigned)value;
+        } else if (strcmp(argv[argi], "--min-fps") == 0) {
+            Minimum_Frames_Per_Second = (unsigned)value;
+        } else if (strcmp(argv[argi], "--seed") == 0) {
+            Random_Seed = (unsigned)value;
+        } else {
+            print_usage(filename);
+            return 1;
+        }
+        argi++;
+    }
+    if (Max_Master < (Nodes_Count - 1)) {
+        fprintf(
+            stderr, "max-master must be at least %u for %u nodes\n",
+            Nodes_Count - 1, Nodes_Count);
+        return 1;
+    }
+    /* repeatable traffic between runs */
+    srand(Random_Seed);
+    mstpsim_init();
+    mstpsim_run();
+    frames_per_second = mstpsim_report();
+    if (Verbose) {
+        unsigned i;
+        for (i = 0; i < Nodes_Count; i++) {
+            printf(
+                "node %u: next-station=%u state=%d\n", i,
+                (unsigned)Nodes[i].port.Next_Station,
+                (int)Nodes[i].port.master_state);
+        }
+    }
+    if (frames_per_second < Minimum_Frames_Per_Second) {
+        fprintf(
+            stderr, "%lu frames/s is below the minimum of %u\n",
+            frames_per_second, Minimum_Frames_Per_Second);
+        return 1;
+    }
+
+    return 0;
+}
@@ -257,6 +257,7 @@ int main(int argc, char *argv[])
     time_t current_seconds = 0;
     time_t timeout_seconds = 0;
 
+    bactext_init();
     if (argc < 3) {
         printf(
             "Usage: %s DNET status [MAC]\r\n", filename_remove_path(argv[0]));
@@ -485,6 +485,7 @@ void BacnetPrepareComm()
     /* setup my info */
     Device_Set_Object_Instance_Number(BACNET_MAX_INSTANCE);
     address_init();
+    bactext_init();
     Init_Service_Handlers();
     dlenv_init();
 }
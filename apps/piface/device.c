@@ -25,6 +25,8 @@
 #include "bacnet/datalink/datalink.h"
 #include "bacnet/basic/services.h"
 #include "bacnet/basic/binding/address.h"
+#include "bacnet/basic/sys/key.h"
+#include "bacnet/basic/sys/keylist.h"
 #include "bacnet/basic/object/device.h"
 #include "bacnet/basic/object/bi.h"
 #include "bacnet/basic/object/blo.h"
@@ -35,6 +37,8 @@
 
 /* may be overridden by outside table */
 static object_functions_t *Object_Table;
+/* objects with a timed operation in progress, keyed by type and instance */
+static OS_Keylist Object_Timer_List;
 
 static object_functions_t My_Object_Table[] = {
     { OBJECT_DEVICE,
@@ -56,7 +60,8 @@ static object_functions_t My_Object_Table[] = {
       NULL /* Remove_List_Element */,
       NULL /* Create */,
       NULL /* Delete */,
-      NULL /* Timer */ },
+      NULL /* Timer */,
+      NULL /* Read_Property_Multiple */ },
 #if (BACNET_PROTOCOL_REVISION >= 17)
     { OBJECT_NETWORK_PORT,
       Network_Port_Init,
@@ -77,7 +82,8 @@ static object_functions_t My_Object_Table[] = {
       NULL /* Remove_List_Element */,
       NULL /* Create */,
       NULL /* Delete */,
-      NULL /* Timer */ },
+      NULL /* Timer */,
+      NULL /* Read_Property_Multiple */ },
 #endif
     { OBJECT_BINARY_INPUT,
       Binary_Input_Init,
@@ -98,7 +104,8 @@ static object_functions_t My_Object_Table[] = {
       NULL /* Remove_List_Element */,
       NULL /* Create */,
       NULL /* Delete */,
-      NULL /* Timer */ },
+      NULL /* Timer */,
+      NULL /* Read_Property_Multiple */ },
     { OBJECT_BINARY_LIGHTING_OUTPUT,
       Binary_Lighting_Output_Init,
       Binary_Lighting_Output_Count,
@@ -118,7 +125,8 @@ static object_functions_t My_Object_Table[] = {
       NULL /* Remove_List_Element */,
       Binary_Lighting_Output_Create,
       Binary_Lighting_Output_Delete,
-      Binary_Lighting_Output_Timer },
+      Binary_Lighting_Output_Timer,
+      NULL /* Read_Property_Multiple */ },
     { OBJECT_BINARY_OUTPUT,
       Binary_Output_Init,
       Binary_Output_Count,
@@ -138,7 +146,8 @@ static object_functions_t My_Object_Table[] = {
       NULL /* Remove_List_Element */,
       Binary_Output_Create,
       Binary_Output_Delete,
-      NULL /* Timer */ },
+      NULL /* Timer */,
+      NULL /* Read_Property_Multiple */ },
     { MAX_BACNET_OBJECT_TYPE,
       NULL /* Init */,
       NULL /* Count */,
@@ -158,7 +167,8 @@ static object_functions_t My_Object_Table[] = {
       NULL /* Remove_List_Element */,
       NULL /* Create */,
       NULL /* Delete */,
-      NULL /* Timer */ }
+      NULL /* Timer */,
+      NULL /* Read_Property_Multiple */ }
 };
 
 /** Glue function to let the Device object, when called by a handler,
@@ -1349,6 +1359,31 @@ int Device_Read_Property(BACNET_READ_PROPERTY_DATA *rpdata)
     return apdu_len;
 }
 
+/**
+ * @brief Looks up the requested Object once, and encodes the values of its
+ *  special property ALL, REQUIRED, or OPTIONAL directly into the
+ *  ReadPropertyMultiple-Ack, using the object fast path when available.
+ * @ingroup ObjIntf
+ * @param writer [in] bounded writer for the listOfResults of the reply
+ * @param rpdata [in,out] Structure with the desired Object and the special
+ *  property on entry, and the error code on abort or reject.
+ * @return BACNET_STATUS_OK, or BACNET_STATUS_ABORT or BACNET_STATUS_REJECT
+ */
+int Device_Read_Property_Multiple(
+    BACNET_WRITER *writer, BACNET_READ_PROPERTY_DATA *rpdata)
+{
+    struct object_functions *pObject = NULL;
+    read_property_multiple_function read_property_multiple = NULL;
+
+    pObject = Device_Objects_Find_Functions(rpdata->object_type);
+    if (pObject) {
+        read_property_multiple = pObject->Object_Read_Property_Multiple;
+    }
+
+    return handler_read_property_multiple_object_encode(
+        writer, rpdata, read_property_multiple);
+}
+
 /* returns true if successful */
 bool Device_Write_Property_Local(BACNET_WRITE_PROPERTY_DATA *wp_data)
 {
@@ -2019,6 +2054,11 @@ void Device_Init(object_functions_t *object_table)
     } else {
         Object_Table = &My_Object_Table[0];
     }
+    if (Object_Timer_List) {
+        /* the timers belong to the previous object table */
+        while (Keylist_Data_Pop(Object_Timer_List)) {
+        }
+    }
     pObject = Object_Table;
     while (pObject->Object_Type < MAX_BACNET_OBJECT_TYPE) {
         if (pObject->Object_Init) {
@@ -2069,28 +2109,109 @@ bool DeviceGetRRInfo(
 }
 
 /**
- * @brief Updates all the object timers with elapsed milliseconds
+ * @brief Find the index of the first registered timer after a key
+ * @param key - the key of a registered timer, which may have been removed
+ * @return index of the next registered timer
+ */
+static int Device_Timer_Index_After(KEY key)
+{
+    int left = 0;
+    int right = Keylist_Count(Object_Timer_List);
+    int middle;
+    KEY middle_key = 0;
+
+    while (left < right) {
+        middle = left + ((right - left) / 2);
+        (void)Keylist_Index_Key(Object_Timer_List, middle, &middle_key);
+        if (middle_key <= key) {
+            left = middle + 1;
+        } else {
+            right = middle;
+        }
+    }
+
+    return left;
+}
+
+/**
+ * @brief Updates the object timers with elapsed milliseconds.
+ *  Only the objects that registered a timed operation in progress
+ *  are called, so the cost is proportional to the active operations
+ *  rather than to the number of objects in the device.
  * @param milliseconds - number of milliseconds elapsed
  */
 void Device_Timer(uint16_t milliseconds)
 {
     struct object_functions *pObject;
-    unsigned count = 0;
-    uint32_t instance;
+    KEY key = 0;
+    int index = 0;
+
+    while (Keylist_Index_Key(Object_Timer_List, index, &key)) {
+        pObject = Keylist_Data_Index(Object_Timer_List, index);
+        if (pObject && pObject->Object_Timer) {
+            pObject->Object_Timer(
+                (uint32_t)KEY_DECODE_ID(key), milliseconds);
+        }
+        /* the timer may register or unregister objects */
+        index = Device_Timer_Index_After(key);
+    }
+}
+
+/**
+ * @brief Registers an object with a timed operation in progress, such as
+ *  a fade, ramp, step, blink-warn, or load shed, so that Device_Timer()
+ *  calls the timer of the object until the object is unregistered.
+ * @param object_type - BACnet object type of the object
+ * @param object_instance - object-instance number of the object
+ * @return true if the object is registered, or was already registered
+ */
+bool Device_Timer_Register(
+    BACNET_OBJECT_TYPE object_type, uint32_t object_instance)
+{
+    struct object_functions *pObject;
+    KEY key;
 
+    if ((object_instance > BACNET_MAX_INSTANCE) || (!Object_Table)) {
+        return false;
+    }
+    key = KEY_ENCODE(object_type, object_instance);
+    if (Keylist_Index(Object_Timer_List, key) >= 0) {
+        return true;
+    }
     pObject = Object_Table;
     while (pObject->Object_Type < MAX_BACNET_OBJECT_TYPE) {
-        if (pObject->Object_Count) {
-            count = pObject->Object_Count();
-        }
-        while (count) {
-            count--;
-            if ((pObject->Object_Timer) &&
-                (pObject->Object_Index_To_Instance)) {
-                instance = pObject->Object_Index_To_Instance(count);
-                pObject->Object_Timer(instance, milliseconds);
-            }
+        if (pObject->Object_Type == object_type) {
+            break;
         }
         pObject++;
     }
+    if ((pObject->Object_Type != object_type) || (!pObject->Object_Timer)) {
+        return false;
+    }
+    if (!Object_Timer_List) {
+        Object_Timer_List = Keylist_Create();
+    }
+
+    return Keylist_Data_Add(Object_Timer_List, key, pObject) >= 0;
+}
+
+/**
+ * @brief Unregisters an object when its timed operation has ended
+ * @param object_type - BACnet object type of the object
+ * @param object_instance - object-instance number of the object
+ */
+void Device_Timer_Unregister(
+    BACNET_OBJECT_TYPE object_type, uint32_t object_instance)
+{
+    (void)Keylist_Data_Delete(
+        Object_Timer_List, KEY_ENCODE(object_type, object_instance));
+}
+
+/**
+ * @brief Get the number of objects registered with the Device timer
+ * @return number of objects with a timed operation in progress
+ */
+unsigned Device_Timer_Count(void)
+{
+    return (unsigned)Keylist_Count(Object_Timer_List);
 }
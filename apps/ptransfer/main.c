@@ -179,6 +179,7 @@ int main(int argc, char *argv[])
     int iType = 0;
     int iKey;
 
+    bactext_init();
     if (((argc != 2) && (argc != 3)) ||
         ((argc >= 2) && (strcmp(argv[1], "--help") == 0))) {
         printf("%s\n", argv[0]);
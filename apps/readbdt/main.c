@@ -92,6 +92,7 @@ int main(int argc, char *argv[])
     time_t timeout_seconds = 0;
     long port = 0;
 
+    bactext_init();
     if (argc < 2) {
         printf("Usage: %s IP [port]\r\n", filename_remove_path(argv[0]));
         return 0;
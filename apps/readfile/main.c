@@ -27,6 +27,7 @@
 #include "bacnet/basic/object/device.h"
 #include "bacnet/basic/sys/filename.h"
 #include "bacnet/basic/services.h"
+#include "bacnet/basic/client/bac-file.h"
 #include "bacnet/basic/tsm/tsm.h"
 #include "bacnet/datalink/datalink.h"
 #include "bacnet/datalink/dlenv.h"
@@ -43,127 +44,7 @@ static uint32_t Target_File_Object_Instance = BACNET_MAX_INSTANCE;
 static uint32_t Target_Device_Object_Instance = BACNET_MAX_INSTANCE;
 static BACNET_ADDRESS Target_Address;
 static char *Local_File_Name = NULL;
-static int Target_File_Start_Position;
-static unsigned int Target_File_Requested_Octet_Count;
-static bool End_Of_File_Detected = false;
 static bool Error_Detected = false;
-static uint8_t Request_Invoke_ID = 0;
-
-static void Atomic_Read_File_Error_Handler(
-    BACNET_ADDRESS *src,
-    uint8_t invoke_id,
-    BACNET_ERROR_CLASS error_class,
-    BACNET_ERROR_CODE error_code)
-{
-    if (address_match(&Target_Address, src) &&
-        (invoke_id == Request_Invoke_ID)) {
-        printf(
-            "BACnet Error: %s: %s\n",
-            bactext_error_class_name((int)error_class),
-            bactext_error_code_name((int)error_code));
-        Error_Detected = true;
-    }
-}
-
-static void MyAbortHandler(
-    BACNET_ADDRESS *src, uint8_t invoke_id, uint8_t abort_reason, bool server)
-{
-    (void)server;
-    if (address_match(&Target_Address, src) &&
-        (invoke_id == Request_Invoke_ID)) {
-        printf(
-            "BACnet Abort: %s\n", bactext_abort_reason_name((int)abort_reason));
-        Error_Detected = true;
-    }
-}
-
-static void
-MyRejectHandler(BACNET_ADDRESS *src, uint8_t invoke_id, uint8_t reject_reason)
-{
-    if (address_match(&Target_Address, src) &&
-        (invoke_id == Request_Invoke_ID)) {
-        printf(
-            "BACnet Reject: %s\n",
-            bactext_reject_reason_name((int)reject_reason));
-        Error_Detected = true;
-    }
-}
-
-static void AtomicReadFileAckHandler(
-    uint8_t *service_request,
-    uint16_t service_len,
-    BACNET_ADDRESS *src,
-    BACNET_CONFIRMED_SERVICE_ACK_DATA *service_data)
-{
-    int len = 0;
-    int result = 0;
-    BACNET_ATOMIC_READ_FILE_DATA data;
-    FILE *pFile = NULL; /* stream pointer */
-    size_t octets_written = 0;
-    size_t octet_count = 0;
-    uint8_t *octet_buffer = NULL;
-
-    if (address_match(&Target_Address, src) &&
-        (service_data->invoke_id == Request_Invoke_ID)) {
-        len =
-            arf_ack_decode_service_request(service_request, service_len, &data);
-        if ((len > 0) && (data.access == FILE_STREAM_ACCESS)) {
-            if (data.type.stream.fileStartPosition == 0) {
-                pFile = fopen(Local_File_Name, "wb");
-            } else {
-                pFile = fopen(Local_File_Name, "rb+");
-            }
-            if (pFile) {
-                octet_count = octetstring_length(&data.fileData[0]);
-                if (octet_count == 0) {
-                    /* asked for many octets, and got zero. Force EOF */
-                    if (!data.endOfFile) {
-                        fprintf(stderr, "Missing EOF!\n");
-                        data.endOfFile = true;
-                    }
-                } else {
-                    result = fseek(
-                        pFile, data.type.stream.fileStartPosition, SEEK_SET);
-                    if (result == 0) {
-                        /* unit to write in bytes -
-                           in our case, an octet is one byte */
-                        octet_buffer = octetstring_value(&data.fileData[0]);
-                        octets_written =
-                            fwrite(octet_buffer, 1, octet_count, pFile);
-                        if (octets_written != octet_count) {
-                            fprintf(
-                                stderr,
-                                "Unable to write data to file \"%s\".\n",
-                                Local_File_Name);
-                        } else {
-                            Target_File_Start_Position =
-                                data.type.stream.fileStartPosition +
-                                octets_written;
-                            printf(
-                                "\r%d bytes", (int)Target_File_Start_Position);
-                        }
-                        fflush(pFile);
-                    } else {
-                        fprintf(
-                            stderr, "Unable to seek to %d!\n",
-                            data.type.stream.fileStartPosition);
-                    }
-                }
-                fclose(pFile);
-            }
-            if (data.endOfFile) {
-                End_Of_File_Detected = true;
-                printf("\n");
-            }
-        } else {
-            fprintf(stderr, "Decode error! %d bytes decoded.\n", len);
-        }
-    } else {
-        fprintf(
-            stderr, "Address & Invoke ID mismatch! Invoke ID=%d\n",
-            Request_Invoke_ID);
-    }
-}
 
 static void LocalIAmHandler(
     uint8_t *service_request, uint16_t service_len, BACNET_ADDRESS *src)
@@ -201,20 +82,14 @@ static void Init_Service_Handlers(void)
     /* we must implement read property - it's required! */
     apdu_set_confirmed_handler(
         SERVICE_CONFIRMED_READ_PROPERTY, handler_read_property);
-    /* handle the data coming back from confirmed requests */
-    apdu_set_confirmed_ack_handler(
-        SERVICE_CONFIRMED_ATOMIC_READ_FILE, AtomicReadFileAckHandler);
-    /* handle any errors coming back */
-    apdu_set_error_handler(
-        SERVICE_CONFIRMED_ATOMIC_READ_FILE, Atomic_Read_File_Error_Handler);
-    apdu_set_abort_handler(MyAbortHandler);
-    apdu_set_reject_handler(MyRejectHandler);
+    /* handle the data, errors, aborts and rejects of the file chunks */
+    bacnet_file_transfer_init();
 }
 
 static void print_usage(const char *filename)
 {
     printf("Usage: %s device-instance file-instance local-name\n", filename);
-    printf("       [--version][--help]\n");
+    printf("       [--window chunks][--version][--help]\n");
 }
 
 static void print_help(const char *filename)
@@ -237,6 +112,13 @@ static void print_help(const char *filename)
     printf("local-name:\n"
            "The name of the file that will be stored locally.\n");
     printf("\n");
+    printf(
+        "--window chunks:\n"
+        "The number of file chunk requests that are sent before their\n"
+        "acknowledgement is received.  Use 1 to request one chunk at\n"
+        "a time.  Default is %u.\n",
+        bacnet_file_transfer_window());
+    printf("\n");
     printf(
         "Example:\n"
         "If you want read File 2 from Device 123 and save it to temp.txt,\n"
@@ -255,12 +137,17 @@ int main(int argc, char *argv[])
     time_t last_seconds = 0;
     time_t current_seconds = 0;
     time_t timeout_seconds = 0;
-    uint8_t invoke_id = 0;
     bool found = false;
-    uint16_t my_max_apdu = 0;
+    bool started = false;
+    unsigned long octets = 0;
+    BACNET_FILE_TRANSFER_STATUS status;
+    BACNET_ERROR_CLASS error_class;
+    BACNET_ERROR_CODE error_code;
     int argi = 0;
+    unsigned int target_args = 0;
     const char *filename = NULL;
 
+    bactext_init();
     /* print help if requested */
     filename = filename_remove_path(argv[0]);
     for (argi = 1; argi < argc; argi++) {
@@ -278,15 +165,29 @@ int main(int argc, char *argv[])
                    "FITNESS FOR A PARTICULAR PURPOSE.\n");
             return 0;
         }
+        if (strcmp(argv[argi], "--window") == 0) {
+            if (++argi < argc) {
+                bacnet_file_transfer_window_set(
+                    (unsigned)strtoul(argv[argi], NULL, 0));
+            }
+        } else if (target_args == 0) {
+            Target_Device_Object_Instance = strtol(argv[argi], NULL, 0);
+            target_args++;
+        } else if (target_args == 1) {
+            Target_File_Object_Instance = strtol(argv[argi], NULL, 0);
+            target_args++;
+        } else if (target_args == 2) {
+            Local_File_Name = argv[argi];
+            target_args++;
+        } else {
+            print_usage(filename);
+            return 1;
+        }
     }
-    if (argc < 4) {
+    if (target_args < 3) {
         print_usage(filename);
         return 0;
     }
-    /* decode the command line parameters */
-    Target_Device_Object_Instance = strtol(argv[1], NULL, 0);
-    Target_File_Object_Instance = strtol(argv[2], NULL, 0);
-    Local_File_Name = argv[3];
     if (Target_Device_Object_Instance > BACNET_MAX_INSTANCE) {
         fprintf(
             stderr, "device-instance=%u - not greater than %u\n",
@@ -338,43 +239,35 @@ int main(int argc, char *argv[])
                 Target_Device_Object_Instance, &max_apdu, &Target_Address);
         }
         if (found) {
-            /* calculate the smaller of our APDU size or theirs
-               and remove the overhead of the APDU (about 16 octets max).
-               note: we could fail if there is a bottle neck (router)
-               and smaller MPDU in betweeen. */
-            if (max_apdu < MAX_APDU) {
-                my_max_apdu = max_apdu;
-            } else {
-                my_max_apdu = MAX_APDU;
-            }
-            /* Typical sizes are 50, 128, 206, 480, 1024, and 1476 octets */
-            if (my_max_apdu <= 50) {
-                Target_File_Requested_Octet_Count = my_max_apdu - 20;
-            } else if (my_max_apdu <= 480) {
-                Target_File_Requested_Octet_Count = my_max_apdu - 32;
-            } else if (my_max_apdu <= 1476) {
-                Target_File_Requested_Octet_Count = my_max_apdu - 64;
-            } else {
-                Target_File_Requested_Octet_Count = my_max_apdu / 2;
-            }
-            /* has the previous invoke id expired or returned?
-               note: invoke ID = 0 is invalid, so it will be idle */
-            if ((invoke_id == 0) || tsm_invoke_id_free(invoke_id)) {
-                if (End_Of_File_Detected || Error_Detected) {
+            if (!started) {
+                /* the file is read in chunks less than max_apdu
+                   to keep unsegmented, with several chunks in flight */
+                started = bacnet_file_read_start(
+                    Target_Device_Object_Instance, Target_File_Object_Instance,
+                    Local_File_Name);
+                if (!started) {
+                    fprintf(
+                        stderr, "Unable to open file \"%s\".\n",
+                        Local_File_Name);
+                    Error_Detected = true;
                     break;
                 }
-                /* the ACK will increment the start position if OK */
-                /* we'll read the file in chunks
-                   less than max_apdu to keep unsegmented */
-                invoke_id = Send_Atomic_Read_File_Stream(
-                    Target_Device_Object_Instance, Target_File_Object_Instance,
-                    Target_File_Start_Position,
-                    Target_File_Requested_Octet_Count);
-                Request_Invoke_ID = invoke_id;
-            } else if (tsm_invoke_id_failed(invoke_id)) {
-                fprintf(stderr, "\rError: TSM Timeout!\n");
-                tsm_free_invoke_id(invoke_id);
-                /* try again or abort? */
+            }
+            bacnet_file_transfer_task();
+            if (octets != bacnet_file_transfer_octets()) {
+                octets = bacnet_file_transfer_octets();
+                printf("\r%lu bytes", octets);
+            }
+            status = bacnet_file_transfer_status();
+            if (status == BACNET_FILE_TRANSFER_COMPLETE) {
+                printf("\n");
+                break;
+            } else if (status != BACNET_FILE_TRANSFER_BUSY) {
+                bacnet_file_transfer_error(&error_class, &error_code);
+                printf(
+                    "\nBACnet Error: %s: %s\n",
+                    bactext_error_class_name((int)error_class),
+                    bactext_error_code_name((int)error_code));
                 Error_Detected = true;
                 break;
             }
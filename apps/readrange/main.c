@@ -204,6 +204,7 @@ int main(int argc, char *argv[])
     unsigned object_property = 0;
     const char *filename = NULL;
 
+    bactext_init();
     filename = filename_remove_path(argv[0]);
     for (argi = 1; argi < argc; argi++) {
         if (strcmp(argv[argi], "--help") == 0) {
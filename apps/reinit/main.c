@@ -125,6 +125,7 @@ int main(int argc, char *argv[])
     uint8_t invoke_id = 0;
     bool found = false;
 
+    bactext_init();
     if (argc < 3) {
         /* note: priority 16 and 0 should produce the same end results... */
         printf(
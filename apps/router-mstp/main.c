@@ -1181,6 +1181,7 @@ int main(int argc, char *argv[])
 
     (void)argc;
     (void)argv;
+    bactext_init();
     printf("BACnet Simple MS/TP to IP Router Demo\n");
     printf("BACnet Stack Version %s\n", BACnet_Version);
     datalink_init();
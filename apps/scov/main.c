@@ -238,6 +238,7 @@ int main(int argc, char *argv[])
     int arg_remaining = 0;
     unsigned uint;
 
+    bactext_init();
     if (argc < 6) {
         print_usage_terse = true;
     }
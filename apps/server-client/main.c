@@ -106,6 +106,7 @@ int main(int argc, char *argv[])
     uint32_t target_object_instance = BACNET_MAX_INSTANCE;
     BACNET_OBJECT_TYPE target_object_type = OBJECT_ANALOG_INPUT;
 
+    bactext_init();
     filename = filename_remove_path(argv[0]);
     for (argi = 1; argi < argc; argi++) {
         if (strcmp(argv[argi], "--help") == 0) {
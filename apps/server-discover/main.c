@@ -176,7 +176,7 @@ static void print_usage(const char *filename)
 {
     printf("Usage: %s [--dnet]\n", filename);
     printf("       [--discover-seconds][--print-seconds][--print-summary]\n");
-    printf("       [--version][--help]\n");
+    printf("       [--read-property][--version][--help]\n");
 }
 
 /**
@@ -191,6 +191,9 @@ static void print_help(const char *filename)
            "Number of seconds to wait before printing list of devices.\n");
     printf("--print-summary:\n"
            "Print only the list of devices.\n");
+    printf("--read-property:\n"
+           "Discover using only ReadProperty instead of batching the\n"
+           "requests with ReadPropertyMultiple.\n");
     printf("--dnet N\n"
            "Optional BACnet network number N for directed requests.\n"
            "Valid range is from 0 to 65535 where 0 is the local connection\n"
@@ -215,7 +218,9 @@ int main(int argc, char *argv[])
     unsigned long print_seconds = 60;
     unsigned long discover_seconds = 60;
     uint16_t dnet = 0;
+    bool read_property_multiple = true;
 
+    bactext_init();
     filename = filename_remove_path(argv[0]);
     for (argi = 1; argi < argc; argi++) {
         if (strcmp(argv[argi], "--help") == 0) {
@@ -242,6 +247,8 @@ int main(int argc, char *argv[])
             }
         } else if (strcmp(argv[argi], "--print-summary") == 0) {
             Print_Summary = true;
+        } else if (strcmp(argv[argi], "--read-property") == 0) {
+            read_property_multiple = false;
         } else if (strcmp(argv[argi], "--dnet") == 0) {
             if (++argi < argc) {
                 long_value = strtol(argv[argi], NULL, 0);
@@ -278,6 +285,7 @@ int main(int argc, char *argv[])
     /* configure the discovery module */
     bacnet_discover_dnet_set(dnet);
     bacnet_discover_seconds_set(discover_seconds);
+    bacnet_discover_read_property_multiple_set(read_property_multiple);
     bacnet_discover_init();
     atexit(bacnet_discover_cleanup);
     mstimer_set(&BACnet_Print_Timer, print_seconds * 1000UL);
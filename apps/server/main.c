@@ -34,7 +34,9 @@
 #include "bacnet/datetime.h"
 /* include the device object */
 #include "bacnet/basic/object/device.h"
+#include "bacnet/basic/object/objstore.h"
 /* objects that have tasks inside them */
+#include "bacnet/basic/object/schedule.h"
 #if (BACNET_PROTOCOL_REVISION >= 14)
 #include "bacnet/basic/object/lo.h"
 #include "bacnet/basic/object/channel.h"
@@ -177,7 +179,8 @@ static void Init_Service_Handlers(void)
     /* update structured view with this device instance */
     Structured_View_Update();
     /* we need to handle who-is to support dynamic device binding */
-    apdu_set_unconfirmed_handler(SERVICE_UNCONFIRMED_WHO_IS, handler_who_is);
+    apdu_set_unconfirmed_handler(
+        SERVICE_UNCONFIRMED_WHO_IS, handler_who_is_scheduled);
     apdu_set_unconfirmed_handler(SERVICE_UNCONFIRMED_WHO_HAS, handler_who_has);
     /* set the handler for all the services we don't implement */
     /* It is required to send the proper reject message... */
@@ -271,6 +274,9 @@ static void print_help(const char *filename)
         "To simulate Device 123 named Fred, use following command:\n"
         "%s 123 Fred\n",
         filename);
+    printf("\nTo keep the created, deleted, and written objects between\n"
+           "restarts, set the BACNET_OBJECT_STORE environment variable\n"
+           "to the name of the file that stores them.\n");
 }
 
 /** Main function of server demo.
@@ -292,15 +298,15 @@ int main(int argc, char *argv[])
     uint32_t elapsed_milliseconds = 0;
     uint32_t elapsed_seconds = 0;
     BACNET_CHARACTER_STRING DeviceName;
-#if defined(BACNET_TIME_MASTER)
     BACNET_DATE_TIME bdatetime;
-#endif
 #if defined(BAC_UCI)
     int uciId = 0;
     struct uci_context *ctx;
 #endif
     int argi = 0;
     const char *filename = NULL;
+    const char *pEnv = NULL;
+    unsigned restored = 0;
 
     filename = filename_remove_path(argv[0]);
     for (argi = 1; argi < argc; argi++) {
@@ -348,7 +354,19 @@ int main(int argc, char *argv[])
     /* load any static address bindings to show up
        in our device bindings list */
     address_init();
+    bactext_init();
     Init_Service_Handlers();
+    /* restore the objects stored before a restart */
+    pEnv = getenv("BACNET_OBJECT_STORE");
+    if (pEnv && Object_Store_Init(pEnv)) {
+        restored = Object_Store_Restore(
+            Device_Create_Object, Device_Delete_Object, Device_Write_Property);
+        printf("Restored %u objects and properties from %s\n", restored, pEnv);
+        Device_Write_Property_Store_Callback_Set(Object_Store_Write_Property);
+        Device_Create_Object_Store_Callback_Set(Object_Store_Create_Object);
+        Device_Delete_Object_Store_Callback_Set(Object_Store_Delete_Object);
+        atexit(Object_Store_Cleanup);
+    }
     /* initialize timesync callback function. */
     handler_timesync_set_callback_set(&datetime_timesync);
 
@@ -375,6 +393,8 @@ int main(int argc, char *argv[])
     }
     dlenv_init();
     atexit(datalink_cleanup);
+    /* seed the I-Am delays from our device instance and MAC address */
+    handler_who_is_scheduled_init(1);
     /* broadcast an I-Am on startup */
     Send_I_Am(&Handler_Transmit_Buffer[0]);
     /* loop forever */
@@ -396,11 +416,12 @@ int main(int argc, char *argv[])
             dlenv_maintenance_timer(elapsed_seconds);
             handler_cov_timer_seconds(elapsed_seconds);
             trend_log_timer(elapsed_seconds);
+            Device_getCurrentDateTime(&bdatetime);
+            Schedule_Task(&bdatetime);
 #if defined(INTRINSIC_REPORTING)
             Device_local_reporting();
 #endif
 #if defined(BACNET_TIME_MASTER)
-            Device_getCurrentDateTime(&bdatetime);
             handler_timesync_task(&bdatetime);
 #endif
         }
@@ -408,6 +429,7 @@ int main(int argc, char *argv[])
             mstimer_reset(&BACnet_TSM_Timer);
             elapsed_milliseconds = mstimer_interval(&BACnet_TSM_Timer);
             tsm_timer_milliseconds(elapsed_milliseconds);
+            handler_who_is_timer(elapsed_milliseconds);
         }
         if (mstimer_expired(&BACnet_Address_Timer)) {
             mstimer_reset(&BACnet_Address_Timer);
@@ -130,6 +130,7 @@ int main(int argc, char *argv[])
     unsigned object_type = 0;
     unsigned object_property = 0;
 
+    bactext_init();
     if (argc < 7) {
         print_usage(filename_remove_path(argv[0]));
         return 0;
@@ -196,6 +196,7 @@ int main(int argc, char *argv[])
     int len = 0;
     bool sent_message = false;
 
+    bactext_init();
     if (argc < 6) {
         filename = filename_remove_path(argv[0]);
         print_usage(filename);
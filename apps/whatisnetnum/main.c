@@ -241,6 +241,7 @@ int main(int argc, char *argv[])
     time_t current_seconds = 0;
     time_t timeout_seconds = 0;
 
+    bactext_init();
     if ((argc > 1) && (strcmp(argv[1], "--help") == 0)) {
         printf(
             "Send BACnet What-Is-Network-Number message to a network.\r\n"
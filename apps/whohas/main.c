@@ -122,6 +122,7 @@ int main(int argc, char *argv[])
     unsigned object_type = 0;
     bool by_name = false;
 
+    bactext_init();
     if (argc < 2) {
         print_usage(filename_remove_path(argv[0]));
         return 0;
@@ -351,6 +351,7 @@ int main(int argc, char *argv[])
     bool repeat_forever = false;
     long retry_count = 0;
 
+    bactext_init();
     /* check for local environment settings */
     if (getenv("BACNET_DEBUG")) {
         BACnet_Debug_Enabled = true;
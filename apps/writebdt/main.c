@@ -104,6 +104,7 @@ int main(int argc, char *argv[])
     int c = 0;
     uint16_t result_code = 0;
 
+    bactext_init();
     if (argc < 2) {
         printf(
             "Usage: %s IP port <IP:port[:mask]> [<IP:port[:mask]>]\r\n",
@@ -26,6 +26,7 @@
 #include "bacnet/basic/object/device.h"
 #include "bacnet/basic/sys/filename.h"
 #include "bacnet/basic/services.h"
+#include "bacnet/basic/client/bac-file.h"
 #include "bacnet/basic/tsm/tsm.h"
 #include "bacnet/datalink/datalink.h"
 #include "bacnet/datalink/dlenv.h"
@@ -37,53 +38,9 @@ static uint8_t Rx_Buf[MAX_MPDU] = { 0 };
 /* global variables used in this file */
 static uint32_t Target_File_Object_Instance = 4194303;
 static uint32_t Target_Device_Object_Instance = 4194303;
-static uint32_t Target_File_Requested_Octet_Count;
-static uint8_t Target_File_Requested_Octet_Pad_Byte;
 static BACNET_ADDRESS Target_Address;
 static char *Local_File_Name = NULL;
-static bool End_Of_File_Detected = false;
 static bool Error_Detected = false;
-static uint8_t Current_Invoke_ID = 0;
-
-static void Atomic_Write_File_Error_Handler(
-    BACNET_ADDRESS *src,
-    uint8_t invoke_id,
-    BACNET_ERROR_CLASS error_class,
-    BACNET_ERROR_CODE error_code)
-{
-    if (address_match(&Target_Address, src) &&
-        (invoke_id == Current_Invoke_ID)) {
-        printf("\r\nBACnet Error!\r\n");
-        printf("Error Class: %s\r\n", bactext_error_class_name(error_class));
-        printf("Error Code: %s\r\n", bactext_error_code_name(error_code));
-        Error_Detected = true;
-    }
-}
-
-static void MyAbortHandler(
-    BACNET_ADDRESS *src, uint8_t invoke_id, uint8_t abort_reason, bool server)
-{
-    (void)server;
-    if (address_match(&Target_Address, src) &&
-        (invoke_id == Current_Invoke_ID)) {
-        printf(
-            "BACnet Abort: %s\r\n",
-            bactext_abort_reason_name((int)abort_reason));
-        Error_Detected = true;
-    }
-}
-
-static void
-MyRejectHandler(BACNET_ADDRESS *src, uint8_t invoke_id, uint8_t reject_reason)
-{
-    if (address_match(&Target_Address, src) &&
-        (invoke_id == Current_Invoke_ID)) {
-        printf(
-            "BACnet Reject: %s\r\n",
-            bactext_reject_reason_name((int)reject_reason));
-        Error_Detected = true;
-    }
-}
 
 static void LocalIAmHandler(
     uint8_t *service_request, uint16_t service_len, BACNET_ADDRESS *src)
@@ -121,11 +78,8 @@ static void Init_Service_Handlers(void)
     /* we must implement read property - it's required! */
     apdu_set_confirmed_handler(
         SERVICE_CONFIRMED_READ_PROPERTY, handler_read_property);
-    /* handle any errors coming back */
-    apdu_set_error_handler(
-        SERVICE_CONFIRMED_ATOMIC_WRITE_FILE, Atomic_Write_File_Error_Handler);
-    apdu_set_abort_handler(MyAbortHandler);
-    apdu_set_reject_handler(MyRejectHandler);
+    /* handle the acks, errors, aborts and rejects of the file chunks */
+    bacnet_file_transfer_init();
 }
 
 int main(int argc, char *argv[])
@@ -138,16 +92,14 @@ int main(int argc, char *argv[])
     time_t last_seconds = 0;
     time_t current_seconds = 0;
     time_t timeout_seconds = 0;
-    int fileStartPosition = 0;
-    unsigned requestedOctetCount = 0;
-    uint8_t invoke_id = 0;
     bool found = false;
-    uint16_t my_max_apdu = 0;
-    FILE *pFile = NULL;
-    static BACNET_OCTET_STRING fileData;
-    size_t len = 0;
-    bool pad_byte = false;
+    bool started = false;
+    unsigned long octets = 0;
+    BACNET_FILE_TRANSFER_STATUS status;
+    BACNET_ERROR_CLASS error_class;
+    BACNET_ERROR_CODE error_code;
 
+    bactext_init();
     if (argc < 4) {
         /* FIXME: what about access method - record or stream? */
         printf(
@@ -173,11 +125,12 @@ int main(int argc, char *argv[])
         return 1;
     }
     if (argc > 4) {
-        Target_File_Requested_Octet_Count = strtol(argv[4], NULL, 0);
+        bacnet_file_transfer_chunk_size_set(
+            (unsigned)strtol(argv[4], NULL, 0));
     }
     if (argc > 5) {
-        Target_File_Requested_Octet_Pad_Byte = strtol(argv[5], NULL, 0);
-        pad_byte = true;
+        bacnet_file_transfer_pad_set(
+            true, (uint8_t)strtol(argv[5], NULL, 0));
     }
     /* setup my info */
     Device_Set_Object_Instance_Number(BACNET_MAX_INSTANCE);
@@ -218,72 +171,38 @@ int main(int argc, char *argv[])
                 Target_Device_Object_Instance, &max_apdu, &Target_Address);
         }
         if (found) {
-            if (Target_File_Requested_Octet_Count) {
-                requestedOctetCount = Target_File_Requested_Octet_Count;
-            } else {
-                /* calculate the smaller of our APDU size or theirs
-                   and remove the overhead of the APDU (varies depending on
-                   size). note: we could fail if there is a bottle neck (router)
-                   and smaller MPDU in betweeen. */
-                if (max_apdu < MAX_APDU) {
-                    my_max_apdu = max_apdu;
-                } else {
-                    my_max_apdu = MAX_APDU;
-                }
-                /* Typical sizes are 50, 128, 206, 480, 1024, and 1476 octets */
-                if (my_max_apdu <= 50) {
-                    requestedOctetCount = my_max_apdu - 19;
-                } else if (my_max_apdu <= 480) {
-                    requestedOctetCount = my_max_apdu - 32;
-                } else if (my_max_apdu <= 1476) {
-                    requestedOctetCount = my_max_apdu - 64;
-                } else {
-                    requestedOctetCount = my_max_apdu / 2;
-                }
-            }
-            /* has the previous invoke id expired or returned?
-               note: invoke ID = 0 is invalid, so it will be idle */
-            if ((invoke_id == 0) || tsm_invoke_id_free(invoke_id)) {
-                if (End_Of_File_Detected || Error_Detected) {
-                    printf("\r\n");
+            if (!started) {
+                /* the file is written in chunks less than max_apdu
+                   to keep unsegmented, with several chunks in flight */
+                started = bacnet_file_write_start(
+                    Target_Device_Object_Instance, Target_File_Object_Instance,
+                    Local_File_Name);
+                if (!started) {
+                    fprintf(
+                        stderr, "Unable to open file \"%s\".\r\n",
+                        Local_File_Name);
+                    Error_Detected = true;
                     break;
                 }
-                if (invoke_id != 0) {
-                    fileStartPosition += requestedOctetCount;
-                }
-                /* we'll read the file in chunks
-                   less than max_apdu to keep unsegmented */
-                pFile = fopen(Local_File_Name, "rb");
-                if (pFile) {
-                    (void)fseek(pFile, fileStartPosition, SEEK_SET);
-                    len = fread(
-                        octetstring_value(&fileData), 1, requestedOctetCount,
-                        pFile);
-                    if (len < requestedOctetCount) {
-                        End_Of_File_Detected = true;
-                        if (pad_byte) {
-                            memset(
-                                octetstring_value(&fileData) + len + 1,
-                                (int)Target_File_Requested_Octet_Pad_Byte,
-                                requestedOctetCount - len);
-                            len = requestedOctetCount;
-                        }
-                    }
-                    octetstring_truncate(&fileData, len);
-                    fclose(pFile);
-                } else {
-                    End_Of_File_Detected = true;
-                }
-                printf("\rSending %d bytes", (int)(fileStartPosition + len));
-                invoke_id = Send_Atomic_Write_File_Stream(
-                    Target_Device_Object_Instance, Target_File_Object_Instance,
-                    fileStartPosition, &fileData);
-                Current_Invoke_ID = invoke_id;
-            } else if (tsm_invoke_id_failed(invoke_id)) {
-                fprintf(stderr, "\rError: TSM Timeout!\r\n");
-                tsm_free_invoke_id(invoke_id);
+            }
+            bacnet_file_transfer_task();
+            if (octets != bacnet_file_transfer_octets()) {
+                octets = bacnet_file_transfer_octets();
+                printf("\rSent %lu bytes", octets);
+            }
+            status = bacnet_file_transfer_status();
+            if (status == BACNET_FILE_TRANSFER_COMPLETE) {
+                printf("\r\n");
+                break;
+            } else if (status != BACNET_FILE_TRANSFER_BUSY) {
+                bacnet_file_transfer_error(&error_class, &error_code);
+                printf("\r\nBACnet Error!\r\n");
+                printf(
+                    "Error Class: %s\r\n",
+                    bactext_error_class_name(error_class));
+                printf(
+                    "Error Code: %s\r\n", bactext_error_code_name(error_code));
                 Error_Detected = true;
-                /* try again or abort? */
                 break;
             }
         } else {
@@ -151,6 +151,7 @@ int main(int argc, char *argv[])
     int argi = 0;
     int len = 0;
 
+    bactext_init();
     if (argc < 4) {
         print_usage(filename_remove_path(argv[0]));
         return 0;
@@ -658,6 +658,12 @@ static void *bws_srv_worker(void *arg)
     return NULL;
 }
 
+void bws_srv_set_threads_num(int threads_num)
+{
+    /* the servers of this port are serviced by one thread */
+    (void)threads_num;
+}
+
 BSC_WEBSOCKET_RET bws_srv_start(BSC_WEBSOCKET_PROTOCOL proto,
     int port,
     char *iface,
@@ -29,9 +29,15 @@
 
 /* Number of MS/TP Packets Rx/Tx */
 uint16_t MSTP_Packets = 0;
+/* Number of MS/TP Packets dropped by the receive queue */
+uint16_t MSTP_Dropped_Packets = 0;
 
-/* packet queues */
-static DLMSTP_PACKET Receive_Packet;
+/* packet queues - count must be a power of 2 for ringbuf library */
+#ifndef MSTP_RECEIVE_PACKET_COUNT
+#define MSTP_RECEIVE_PACKET_COUNT 8
+#endif
+static DLMSTP_PACKET Receive_Buffer[MSTP_RECEIVE_PACKET_COUNT];
+static RING_BUFFER Receive_Queue;
 /* mechanism to wait for a packet */
 static pthread_cond_t Receive_Packet_Flag;
 static pthread_mutex_t Receive_Packet_Mutex;
@@ -52,6 +58,9 @@ static uint8_t RxBuffer[DLMSTP_MPDU_MAX];
 /* data structure for MS/TP PDU Queue */
 struct mstp_pdu_packet {
     bool data_expecting_reply;
+    /* index for matching a reply to a DATA_EXPECTING_REPLY frame */
+    bool reply_candidate;
+    uint8_t reply_invoke_id;
     uint8_t destination_mac;
     uint16_t length;
     uint8_t buffer[DLMSTP_MPDU_MAX];
@@ -175,6 +184,41 @@ void dlmstp_cleanup(void)
     pthread_mutex_destroy(&Ring_Buffer_Mutex);
 }
 
+/**
+ * @brief Find the invoke ID of an APDU that could be the reply to
+ *  a confirmed request, so that queued replies can be matched without
+ *  decoding every queued PDU.
+ * @param pdu - NPDU to check
+ * @param pdu_len - number of bytes in the NPDU
+ * @param invoke_id - [out] invoke ID of the reply
+ * @return true if the NPDU is an ACK, Error, Reject or Abort APDU
+ */
+static bool
+dlmstp_reply_invoke_id(const uint8_t *pdu, uint16_t pdu_len, uint8_t *invoke_id)
+{
+    BACNET_NPDU_DATA npdu_data = { 0 };
+    int offset;
+
+    offset = bacnet_npdu_decode(pdu, pdu_len, NULL, NULL, &npdu_data);
+    if ((offset <= 0) || npdu_data.network_layer_message ||
+        ((offset + 1) >= pdu_len)) {
+        return false;
+    }
+    switch (pdu[offset] & 0xF0) {
+        case PDU_TYPE_SIMPLE_ACK:
+        case PDU_TYPE_COMPLEX_ACK:
+        case PDU_TYPE_ERROR:
+        case PDU_TYPE_REJECT:
+        case PDU_TYPE_ABORT:
+            *invoke_id = pdu[offset + 1];
+            return true;
+        default:
+            break;
+    }
+
+    return false;
+}
+
 /* returns number of bytes sent on success, zero on failure */
 int dlmstp_send_pdu(
     BACNET_ADDRESS *dest, /* destination address */
@@ -193,6 +237,8 @@ int dlmstp_send_pdu(
             pkt->buffer[i] = pdu[i];
         }
         pkt->length = pdu_len;
+        pkt->reply_candidate = dlmstp_reply_invoke_id(
+            pkt->buffer, pkt->length, &pkt->reply_invoke_id);
         if (dest && dest->mac_len) {
             pkt->destination_mac = dest->mac[0];
         } else {
@@ -216,28 +262,36 @@ uint16_t dlmstp_receive(
 { /* milliseconds to wait for a packet */
     uint16_t pdu_len = 0;
     struct timespec abstime;
+    DLMSTP_PACKET *pkt;
+    int rv = 0;
 
-    (void)max_pdu;
-    /* see if there is a packet available, and a place
-       to put the reply (if necessary) and process it */
     pthread_mutex_lock(&Receive_Packet_Mutex);
-    get_abstime(&abstime, timeout);
-    pthread_cond_timedwait(
-        &Receive_Packet_Flag, &Receive_Packet_Mutex, &abstime);
-    if (Receive_Packet.ready) {
-        if (Receive_Packet.pdu_len) {
+    /* only wait when no packet is already queued */
+    if (Ringbuf_Empty(&Receive_Queue) && timeout) {
+        get_abstime(&abstime, timeout);
+        while (Ringbuf_Empty(&Receive_Queue) && (rv == 0)) {
+            rv = pthread_cond_timedwait(
+                &Receive_Packet_Flag, &Receive_Packet_Mutex, &abstime);
+        }
+    }
+    pkt = (DLMSTP_PACKET *)Ringbuf_Peek(&Receive_Queue);
+    if (pkt) {
+        if (pkt->pdu_len > max_pdu) {
+            MSTP_Dropped_Packets++;
+            debug_printf(
+                "MS/TP: Dropped! PDU Length %u > %u.\n",
+                (unsigned)pkt->pdu_len, (unsigned)max_pdu);
+        } else if (pkt->pdu_len) {
             MSTP_Packets++;
             if (src) {
-                memmove(
-                    src, &Receive_Packet.address,
-                    sizeof(Receive_Packet.address));
+                memmove(src, &pkt->address, sizeof(pkt->address));
             }
             if (pdu) {
-                memmove(pdu, &Receive_Packet.pdu, sizeof(Receive_Packet.pdu));
+                memmove(pdu, &pkt->pdu, pkt->pdu_len);
             }
-            pdu_len = Receive_Packet.pdu_len;
+            pdu_len = pkt->pdu_len;
         }
-        Receive_Packet.ready = false;
+        (void)Ringbuf_Pop(&Receive_Queue, NULL);
     }
     pthread_mutex_unlock(&Receive_Packet_Mutex);
 
@@ -334,26 +388,29 @@ void dlmstp_fill_bacnet_address(BACNET_ADDRESS *src, uint8_t mstp_address)
 uint16_t MSTP_Put_Receive(struct mstp_port_struct_t *mstp_port)
 {
     uint16_t pdu_len = 0;
+    DLMSTP_PACKET *pkt;
 
     pthread_mutex_lock(&Receive_Packet_Mutex);
-    if (Receive_Packet.ready) {
-        debug_printf("MS/TP: Dropped! Not Ready.\n");
+    pkt = (DLMSTP_PACKET *)Ringbuf_Data_Peek(&Receive_Queue);
+    if (!pkt) {
+        MSTP_Dropped_Packets++;
+        debug_printf("MS/TP: Dropped! Receive queue full.\n");
     } else {
         /* bounds check - maybe this should send an abort? */
         pdu_len = mstp_port->DataLength;
-        if (pdu_len > sizeof(Receive_Packet.pdu)) {
-            pdu_len = sizeof(Receive_Packet.pdu);
+        if (pdu_len > sizeof(pkt->pdu)) {
+            pdu_len = sizeof(pkt->pdu);
         }
         if (pdu_len == 0) {
             debug_printf("MS/TP: PDU Length is 0!\n");
         }
         memmove(
-            (void *)&Receive_Packet.pdu[0], (void *)&mstp_port->InputBuffer[0],
+            (void *)&pkt->pdu[0], (void *)&mstp_port->InputBuffer[0],
             pdu_len);
-        dlmstp_fill_bacnet_address(
-            &Receive_Packet.address, mstp_port->SourceAddress);
-        Receive_Packet.pdu_len = mstp_port->DataLength;
-        Receive_Packet.ready = true;
+        dlmstp_fill_bacnet_address(&pkt->address, mstp_port->SourceAddress);
+        pkt->pdu_len = pdu_len;
+        pkt->ready = true;
+        (void)Ringbuf_Data_Put(&Receive_Queue, (uint8_t *)pkt);
         pthread_cond_signal(&Receive_Packet_Flag);
     }
     pthread_mutex_unlock(&Receive_Packet_Mutex);
@@ -544,19 +601,42 @@ uint16_t MSTP_Get_Reply(struct mstp_port_struct_t *mstp_port, unsigned timeout)
     uint16_t pdu_len = 0; /* return value */
     bool matched = false;
     uint8_t frame_type = 0;
+    uint8_t invoke_id = 0;
     struct mstp_pdu_packet *pkt;
+    BACNET_NPDU_DATA npdu_data = { 0 };
+    int offset;
 
     (void)timeout;
-    if (Ringbuf_Empty(&PDU_Queue)) {
+    /* only a confirmed request can have a reply */
+    offset = bacnet_npdu_decode(
+        &mstp_port->InputBuffer[0], mstp_port->DataLength, NULL, NULL,
+        &npdu_data);
+    if ((offset <= 0) || npdu_data.network_layer_message ||
+        ((offset + 2) >= mstp_port->DataLength) ||
+        ((mstp_port->InputBuffer[offset] & 0xF0) !=
+         PDU_TYPE_CONFIRMED_SERVICE_REQUEST)) {
         return 0;
     }
+    invoke_id = mstp_port->InputBuffer[offset + 2];
+    pthread_mutex_lock(&Ring_Buffer_Mutex);
+    /* the reply may be queued behind other PDUs: use the index to skip
+       the PDUs that cannot be the reply to the DER */
     pkt = (struct mstp_pdu_packet *)Ringbuf_Peek(&PDU_Queue);
-    /* is this the reply to the DER? */
-    matched = dlmstp_compare_data_expecting_reply(
-        &mstp_port->InputBuffer[0], mstp_port->DataLength,
-        mstp_port->SourceAddress, (uint8_t *)&pkt->buffer[0], pkt->length,
-        pkt->destination_mac);
+    while (pkt && !matched) {
+        if (pkt->reply_candidate && (pkt->reply_invoke_id == invoke_id) &&
+            (pkt->destination_mac == mstp_port->SourceAddress)) {
+            matched = dlmstp_compare_data_expecting_reply(
+                &mstp_port->InputBuffer[0], mstp_port->DataLength,
+                mstp_port->SourceAddress, (uint8_t *)&pkt->buffer[0],
+                pkt->length, pkt->destination_mac);
+        }
+        if (!matched) {
+            pkt = (struct mstp_pdu_packet *)Ringbuf_Peek_Next(
+                &PDU_Queue, (uint8_t *)pkt);
+        }
+    }
     if (!matched) {
+        pthread_mutex_unlock(&Ring_Buffer_Mutex);
         return 0;
     }
     if (pkt->data_expecting_reply) {
@@ -569,7 +649,9 @@ uint16_t MSTP_Get_Reply(struct mstp_port_struct_t *mstp_port, unsigned timeout)
         &mstp_port->OutputBuffer[0], /* <-- loading this */
         mstp_port->OutputBufferSize, frame_type, pkt->destination_mac,
         mstp_port->This_Station, (uint8_t *)&pkt->buffer[0], pkt->length);
-    (void)Ringbuf_Pop(&PDU_Queue, NULL);
+    /* pop the element no matter where it was found */
+    (void)Ringbuf_Pop_Element(&PDU_Queue, (uint8_t *)pkt, NULL);
+    pthread_mutex_unlock(&Ring_Buffer_Mutex);
 
     return pdu_len;
 }
@@ -698,8 +780,9 @@ bool dlmstp_init(char *ifname)
         &PDU_Queue, (uint8_t *)&PDU_Buffer, sizeof(struct mstp_pdu_packet),
         MSTP_PDU_PACKET_COUNT);
     /* initialize packet queue */
-    Receive_Packet.ready = false;
-    Receive_Packet.pdu_len = 0;
+    Ringbuf_Init(
+        &Receive_Queue, (uint8_t *)&Receive_Buffer, sizeof(DLMSTP_PACKET),
+        MSTP_RECEIVE_PACKET_COUNT);
     rv = pthread_cond_init(&Receive_Packet_Flag, &attr);
     if (rv != 0) {
         fprintf(
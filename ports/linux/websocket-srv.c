@@ -59,12 +59,18 @@ typedef struct {
     size_t fragment_buffer_size;
     size_t fragment_buffer_len;
     BACNET_ERROR_CODE err_code;
+    /* index of the service thread which owns the connection */
+    int tsi;
 } BSC_WEBSOCKET_CONNECTION;
 
 #if BSC_CONF_WEBSOCKET_SERVERS_NUM < 1
 #error "BSC_CONF_WEBSOCKET_SERVERS_NUM must be >= 1"
 #endif
 
+#if BSC_CONF_WEBSOCKET_SERVER_THREADS_NUM < 1
+#error "BSC_CONF_WEBSOCKET_SERVER_THREADS_NUM must be >= 1"
+#endif
+
 static pthread_mutex_t bws_global_mutex =
     PTHREAD_RECURSIVE_MUTEX_INITIALIZER_NP;
 static pthread_mutex_t bws_srv_direct_mutex[BSC_CONF_WEBSOCKET_SERVERS_NUM];
@@ -86,6 +92,13 @@ static BSC_WEBSOCKET_CONNECTION
 static BSC_WEBSOCKET_CONNECTION bws_direct_conn[1][1] = { 0 };
 #endif
 
+struct BACNetWebsocketServerContext;
+
+typedef struct {
+    struct BACNetWebsocketServerContext *ctx;
+    int tsi;
+} BSC_WEBSOCKET_WORKER;
+
 typedef struct BACNetWebsocketServerContext {
     bool used;
     struct lws_context *wsctx;
@@ -95,8 +108,18 @@ typedef struct BACNetWebsocketServerContext {
     BSC_WEBSOCKET_SRV_DISPATCH dispatch_func;
     void *user_param;
     bool stop_worker;
+    /* service threads of the server, worker 0 emits the started and
+       stopped events and destroys the libwebsockets context once the
+       other workers have left it */
+    BSC_WEBSOCKET_WORKER worker[BSC_CONF_WEBSOCKET_SERVER_THREADS_NUM];
+    int workers_num;
+    int workers_running;
+    pthread_cond_t workers_cond;
 } BSC_WEBSOCKET_CONTEXT;
 
+/* number of service threads of the servers which are started next */
+static int bws_srv_threads_num = BSC_CONF_WEBSOCKET_SERVER_THREADS_NUM;
+
 static BSC_WEBSOCKET_CONTEXT bws_hub_ctx[BSC_CONF_WEBSOCKET_SERVERS_NUM] = {
     0
 };
@@ -150,6 +173,12 @@ static BSC_WEBSOCKET_CONTEXT *bws_alloc_server_ctx(BSC_WEBSOCKET_PROTOCOL proto)
                 pthread_mutex_unlock(&bws_global_mutex);
                 return NULL;
             }
+            if (pthread_cond_init(&ctx[i].workers_cond, NULL) != 0) {
+                pthread_mutex_destroy(ctx[i].mutex);
+                DEBUG_PRINTF("bws_alloc_server_ctx() <<< ret = NULL\n");
+                pthread_mutex_unlock(&bws_global_mutex);
+                return NULL;
+            }
             ctx[i].used = true;
             DEBUG_PRINTF("bws_alloc_server_ctx() <<< ret = %p\n", &ctx[i]);
             pthread_mutex_unlock(&bws_global_mutex);
@@ -226,6 +255,7 @@ static void bws_free_server_ctx(BSC_WEBSOCKET_CONTEXT *ctx)
     ctx->conn = NULL;
     pthread_mutex_destroy(ctx->mutex);
     ctx->mutex = NULL;
+    pthread_cond_destroy(&ctx->workers_cond);
     ctx->dispatch_func = NULL;
     ctx->user_param = NULL;
     DEBUG_PRINTF("bws_free_server_ctx() <<< \n");
@@ -364,6 +394,7 @@ static int bws_srv_websocket_event(
                 " socket %d to BACNET_WEBSOCKET_STATE_CONNECTING\n",
                 ctx, ctx->proto, h);
             ctx->conn[h].ws = wsi;
+            ctx->conn[h].tsi = lws_get_tsi(wsi);
             ctx->conn[h].state = BSC_WEBSOCKET_STATE_CONNECTED;
             ctx->conn[h].err_code = ERROR_CODE_SUCCESS;
             dispatch_func = ctx->dispatch_func;
@@ -572,23 +603,28 @@ static int bws_srv_websocket_event(
 
 static void *bws_srv_worker(void *arg)
 {
-    BSC_WEBSOCKET_CONTEXT *ctx = (BSC_WEBSOCKET_CONTEXT *)arg;
+    BSC_WEBSOCKET_WORKER *worker = (BSC_WEBSOCKET_WORKER *)arg;
+    BSC_WEBSOCKET_CONTEXT *ctx = worker->ctx;
+    int tsi = worker->tsi;
     int i;
     BSC_WEBSOCKET_SRV_DISPATCH dispatch_func;
     void *user_param;
 
     DEBUG_PRINTF(
-        "bws_srv_worker() started for ctx %p proto %d user_param %p\n", ctx,
-        ctx->proto, ctx->user_param);
+        "bws_srv_worker() started for ctx %p proto %d user_param %p "
+        "tsi %d\n",
+        ctx, ctx->proto, ctx->user_param, tsi);
 
-    pthread_mutex_lock(ctx->mutex);
-    dispatch_func = ctx->dispatch_func;
-    user_param = ctx->user_param;
-    pthread_mutex_unlock(ctx->mutex);
+    if (tsi == 0) {
+        pthread_mutex_lock(ctx->mutex);
+        dispatch_func = ctx->dispatch_func;
+        user_param = ctx->user_param;
+        pthread_mutex_unlock(ctx->mutex);
 
-    dispatch_func(
-        (BSC_WEBSOCKET_SRV_HANDLE)ctx, 0, BSC_WEBSOCKET_SERVER_STARTED, 0, NULL,
-        NULL, 0, user_param);
+        dispatch_func(
+            (BSC_WEBSOCKET_SRV_HANDLE)ctx, 0, BSC_WEBSOCKET_SERVER_STARTED, 0,
+            NULL, NULL, 0, user_param);
+    }
 
     while (1) {
         DEBUG_PRINTF(
@@ -596,11 +632,27 @@ static void *bws_srv_worker(void *arg)
             ctx->proto, ctx->user_param);
         pthread_mutex_lock(ctx->mutex);
 
+        if (ctx->stop_worker && tsi != 0) {
+            DEBUG_PRINTF(
+                "bws_srv_worker() ctx %p proto %d tsi %d stopped\n", ctx,
+                ctx->proto, tsi);
+            ctx->workers_running--;
+            pthread_cond_broadcast(&ctx->workers_cond);
+            pthread_mutex_unlock(ctx->mutex);
+            return NULL;
+        }
+
         if (ctx->stop_worker) {
             DEBUG_PRINTF(
                 "bws_srv_worker() ctx %p user_param %p proto %d going "
                 "to stop\n",
                 ctx, ctx->user_param, ctx->proto);
+            /* the other service threads are woken up by the
+               lws_cancel_service() call of bws_srv_stop() */
+            while (ctx->workers_running > 1) {
+                pthread_cond_wait(&ctx->workers_cond, ctx->mutex);
+            }
+            ctx->workers_running = 0;
             DEBUG_PRINTF(
                 "bws_srv_worker() destroy wsctx %p, ctx = %p, "
                 "user_param = %p\n",
@@ -651,6 +703,11 @@ static void *bws_srv_worker(void *arg)
                 "socket %d(%p) state = %d\n",
                 ctx, ctx->user_param, ctx->proto, i, &ctx->conn[i],
                 ctx->conn[i].state);
+            if (ctx->conn[i].tsi != tsi) {
+                /* libwebsockets requires that a connection is only
+                   serviced by the thread that owns it */
+                continue;
+            }
             if (ctx->conn[i].state == BSC_WEBSOCKET_STATE_CONNECTED) {
                 if (ctx->conn[i].want_send_data) {
                     DEBUG_PRINTF(
@@ -677,12 +734,24 @@ static void *bws_srv_worker(void *arg)
             "bws_srv_worker() ctx %p user_param %p proto %d going to block on "
             "lws_service() call\n",
             ctx, ctx->user_param, ctx->proto);
-        lws_service(ctx->wsctx, 0);
+        lws_service_tsi(ctx->wsctx, 0, tsi);
     }
 
     return NULL;
 }
 
+void bws_srv_set_threads_num(int threads_num)
+{
+    if (threads_num < 1) {
+        threads_num = 1;
+    } else if (threads_num > BSC_CONF_WEBSOCKET_SERVER_THREADS_NUM) {
+        threads_num = BSC_CONF_WEBSOCKET_SERVER_THREADS_NUM;
+    }
+    pthread_mutex_lock(&bws_global_mutex);
+    bws_srv_threads_num = threads_num;
+    pthread_mutex_unlock(&bws_global_mutex);
+}
+
 BSC_WEBSOCKET_RET bws_srv_start(
     BSC_WEBSOCKET_PROTOCOL proto,
     int port,
@@ -703,6 +772,8 @@ BSC_WEBSOCKET_RET bws_srv_start(
     BSC_WEBSOCKET_CONTEXT *ctx;
     pthread_attr_t attr;
     int r;
+    int i;
+    int threads_num;
     struct lws_protocols protos[] = { { NULL, bws_srv_websocket_event, 0, 0, 0,
                                         NULL, 0 },
                                       LWS_PROTOCOL_LIST_TERM };
@@ -745,6 +816,10 @@ BSC_WEBSOCKET_RET bws_srv_start(
 
     bsc_websocket_init_log();
 
+    pthread_mutex_lock(&bws_global_mutex);
+    threads_num = bws_srv_threads_num;
+    pthread_mutex_unlock(&bws_global_mutex);
+
     pthread_mutex_lock(ctx->mutex);
     info.port = port;
     info.iface = iface;
@@ -762,6 +837,7 @@ BSC_WEBSOCKET_RET bws_srv_start(
     info.timeout_secs = timeout_s;
     info.connect_timeout_secs = timeout_s;
     info.user = ctx;
+    info.count_threads = threads_num;
 
     /* TRICKY: check comments related to lws_context_destroy() call */
 
@@ -781,17 +857,38 @@ BSC_WEBSOCKET_RET bws_srv_start(
     ctx->dispatch_func = dispatch_func;
     ctx->user_param = dispatch_func_user_param;
     ctx->proto = proto;
+    /* libwebsockets limits the number of service threads to LWS_MAX_SMP */
+    ctx->workers_num = lws_get_count_threads(ctx->wsctx);
+    if (ctx->workers_num < 1) {
+        ctx->workers_num = 1;
+    } else if (ctx->workers_num > threads_num) {
+        ctx->workers_num = threads_num;
+    }
+    ctx->workers_running = 0;
     r = pthread_attr_init(&attr);
 
     if (!r) {
         r = pthread_attr_setdetachstate(&attr, PTHREAD_CREATE_DETACHED);
     }
 
-    if (!r) {
-        r = pthread_create(&thread_id, &attr, &bws_srv_worker, ctx);
+    /* worker 0 emits the started event, so it is created last */
+    for (i = ctx->workers_num - 1; !r && i >= 0; i--) {
+        ctx->worker[i].ctx = ctx;
+        ctx->worker[i].tsi = i;
+        r = pthread_create(&thread_id, &attr, &bws_srv_worker, &ctx->worker[i]);
+        if (!r) {
+            ctx->workers_running++;
+        }
     }
 
     if (r) {
+        /* stop the service threads which were already started */
+        ctx->stop_worker = true;
+        lws_cancel_service(ctx->wsctx);
+        while (ctx->workers_running > 0) {
+            pthread_cond_wait(&ctx->workers_cond, ctx->mutex);
+        }
+        ctx->stop_worker = false;
         /* TRICKY: Libwebsockets API is not designed to be used from
                    multipe service threads, as a result lws_context_destroy()
                    is not thread safe. More over, on different platforms the
@@ -957,6 +1054,8 @@ BSC_WEBSOCKET_RET bws_srv_dispatch_send(
         return BSC_WEBSOCKET_INVALID_OPERATION;
     }
 
+    /* The caller holds the dispatch lock of the stack, which serializes
+       the sends of all connections, so the context lock is kept. */
     written =
         lws_write(ctx->conn[h].ws, payload, payload_size, LWS_WRITE_BINARY);
 
@@ -273,6 +273,19 @@ void Device_Objects_Property_List(BACNET_OBJECT_TYPE object_type,
     return;
 }
 
+/**
+ * @brief Encodes the values of the special property ALL, REQUIRED, or
+ *  OPTIONAL of an object directly into the ReadPropertyMultiple-Ack.
+ * @param writer [in] bounded writer for the listOfResults of the reply
+ * @param rpdata [in,out] object and special property to encode
+ * @return BACNET_STATUS_OK, or BACNET_STATUS_ABORT or BACNET_STATUS_REJECT
+ */
+int Device_Read_Property_Multiple(
+    BACNET_WRITER *writer, BACNET_READ_PROPERTY_DATA *rpdata)
+{
+    return handler_read_property_multiple_object_encode(writer, rpdata, NULL);
+}
+
 void Device_Property_Lists(
     const int **pRequired, const int **pOptional, const int **pProprietary)
 {
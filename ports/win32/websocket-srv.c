@@ -668,6 +668,12 @@ static DWORD WINAPI bws_srv_worker(LPVOID arg)
     return 0;
 }
 
+void bws_srv_set_threads_num(int threads_num)
+{
+    /* the servers of this port are serviced by one thread */
+    (void)threads_num;
+}
+
 BSC_WEBSOCKET_RET bws_srv_start(
     BSC_WEBSOCKET_PROTOCOL proto,
     int port,
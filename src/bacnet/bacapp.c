@@ -553,6 +553,120 @@ int bacapp_encode_application_data(
     return apdu_len;
 }
 
+/**
+ * @brief Encode application data given by a pointer using a bounded writer.
+ *  Primitive values are written once at the writer position without
+ *  a separate length pass; constructed values are sized first.
+ * @param writer - bounded writer to encode into
+ * @param value - Pointer to the application data value to encode from
+ * @return number of bytes encoded, or zero if the value did not fit
+ */
+int bacapp_encode_application_data_writer(
+    BACNET_WRITER *writer, const BACNET_APPLICATION_DATA_VALUE *value)
+{
+    int len = 0;
+    uint8_t *apdu;
+
+    if (!writer || !value) {
+        return 0;
+    }
+    switch (value->tag) {
+#if defined(BACAPP_NULL)
+        case BACNET_APPLICATION_TAG_NULL:
+            len = bacnet_writer_application_null(writer);
+            break;
+#endif
+#if defined(BACAPP_BOOLEAN)
+        case BACNET_APPLICATION_TAG_BOOLEAN:
+            len = bacnet_writer_application_boolean(
+                writer, value->type.Boolean);
+            break;
+#endif
+#if defined(BACAPP_UNSIGNED)
+        case BACNET_APPLICATION_TAG_UNSIGNED_INT:
+            len = bacnet_writer_application_unsigned(
+                writer, value->type.Unsigned_Int);
+            break;
+#endif
+#if defined(BACAPP_SIGNED)
+        case BACNET_APPLICATION_TAG_SIGNED_INT:
+            len = bacnet_writer_application_signed(
+                writer, value->type.Signed_Int);
+            break;
+#endif
+#if defined(BACAPP_REAL)
+        case BACNET_APPLICATION_TAG_REAL:
+            len = bacnet_writer_application_real(writer, value->type.Real);
+            break;
+#endif
+#if defined(BACAPP_DOUBLE)
+        case BACNET_APPLICATION_TAG_DOUBLE:
+            len = bacnet_writer_application_double(writer, value->type.Double);
+            break;
+#endif
+#if defined(BACAPP_OCTET_STRING)
+        case BACNET_APPLICATION_TAG_OCTET_STRING:
+            len = bacnet_writer_application_octet_string(
+                writer, &value->type.Octet_String);
+            break;
+#endif
+#if defined(BACAPP_CHARACTER_STRING)
+        case BACNET_APPLICATION_TAG_CHARACTER_STRING:
+            len = bacnet_writer_application_character_string(
+                writer, &value->type.Character_String);
+            break;
+#endif
+#if defined(BACAPP_BIT_STRING)
+        case BACNET_APPLICATION_TAG_BIT_STRING:
+            len = bacnet_writer_application_bitstring(
+                writer, &value->type.Bit_String);
+            break;
+#endif
+#if defined(BACAPP_ENUMERATED)
+        case BACNET_APPLICATION_TAG_ENUMERATED:
+            len = bacnet_writer_application_enumerated(
+                writer, value->type.Enumerated);
+            break;
+#endif
+#if defined(BACAPP_DATE)
+        case BACNET_APPLICATION_TAG_DATE:
+            len = bacnet_writer_application_date(writer, &value->type.Date);
+            break;
+#endif
+#if defined(BACAPP_TIME)
+        case BACNET_APPLICATION_TAG_TIME:
+            len = bacnet_writer_application_time(writer, &value->type.Time);
+            break;
+#endif
+#if defined(BACAPP_OBJECT_ID)
+        case BACNET_APPLICATION_TAG_OBJECT_ID:
+            len = bacnet_writer_application_object_id(
+                writer, value->type.Object_Id.type,
+                value->type.Object_Id.instance);
+            break;
+#endif
+        case BACNET_APPLICATION_TAG_EMPTYLIST:
+            /* Empty data list */
+            len = 0;
+            break;
+        default:
+            /* constructed values have no small upper bound */
+            len = bacapp_encode_application_data(NULL, value);
+            apdu = bacnet_writer_reserve(writer, (size_t)len);
+            if (apdu) {
+                len = bacapp_encode_application_data(apdu, value);
+                if (!bacnet_writer_commit(writer, (size_t)len)) {
+                    len = 0;
+                }
+            } else {
+                len = 0;
+            }
+            break;
+    }
+
+    return len;
+}
+
 /**
  * @brief Decode application tagged data and store it into value.
  * @param apdu  Receive buffer
@@ -17,6 +17,7 @@
 /* BACnet Stack API */
 #include "bacnet/access_rule.h"
 #include "bacnet/bacaction.h"
+#include "bacnet/bacdcode.h"
 #include "bacnet/bacdest.h"
 #include "bacnet/bacint.h"
 #include "bacnet/bacstr.h"
@@ -279,6 +280,9 @@ bool bacapp_decode_application_data_safe(
 BACNET_STACK_EXPORT
 int bacapp_encode_application_data(
     uint8_t *apdu, const BACNET_APPLICATION_DATA_VALUE *value);
+BACNET_STACK_EXPORT
+int bacapp_encode_application_data_writer(
+    BACNET_WRITER *writer, const BACNET_APPLICATION_DATA_VALUE *value);
 
 BACNET_STACK_EXPORT
 int bacapp_decode_context_data(
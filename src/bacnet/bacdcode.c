@@ -4888,3 +4888,693 @@ BACNET_ERROR_CODE bacnet_array_write(
 
     return error_code;
 }
+
+/**
+ * @brief Initialize a bounded writer for single pass encoding
+ * @param writer [out] writer to initialize
+ * @param apdu [in] buffer to encode into
+ * @param size [in] capacity of the buffer, in octets
+ */
+void bacnet_writer_init(BACNET_WRITER *writer, uint8_t *apdu, size_t size)
+{
+    if (writer) {
+        writer->apdu = apdu;
+        writer->size = apdu ? size : 0;
+        writer->len = 0;
+        writer->overflow = false;
+    }
+}
+
+/**
+ * @brief Get the number of octets written
+ * @param writer [in] writer to query
+ * @return number of octets written
+ */
+size_t bacnet_writer_length(const BACNET_WRITER *writer)
+{
+    return writer ? writer->len : 0;
+}
+
+/**
+ * @brief Get the number of octets that can still be written
+ * @param writer [in] writer to query
+ * @return remaining capacity, or zero once the writer has overflowed
+ */
+size_t bacnet_writer_remaining(const BACNET_WRITER *writer)
+{
+    if (!writer || writer->overflow) {
+        return 0;
+    }
+
+    return writer->size - writer->len;
+}
+
+/**
+ * @brief Determine if an encoding did not fit in the writer
+ * @param writer [in] writer to query
+ * @return true if any encoding did not fit since init or the last rewind
+ */
+bool bacnet_writer_overflow(const BACNET_WRITER *writer)
+{
+    return writer ? writer->overflow : true;
+}
+
+/**
+ * @brief Get the current write position
+ * @param writer [in] writer to query
+ * @return pointer to the next octet to be written, or NULL
+ */
+uint8_t *bacnet_writer_position(const BACNET_WRITER *writer)
+{
+    if (!writer || !writer->apdu) {
+        return NULL;
+    }
+
+    return &writer->apdu[writer->len];
+}
+
+/**
+ * @brief Reserve space for an encoding of a known length. The space is
+ *  not consumed until bacnet_writer_commit() is called.
+ * @param writer [in] writer to reserve from
+ * @param len [in] number of octets needed
+ * @return pointer to write the encoding, or NULL and the overflow flag
+ *  is set if the encoding will not fit.
+ */
+uint8_t *bacnet_writer_reserve(BACNET_WRITER *writer, size_t len)
+{
+    if (!writer) {
+        return NULL;
+    }
+    if (len > bacnet_writer_remaining(writer)) {
+        writer->overflow = true;
+        return NULL;
+    }
+
+    return bacnet_writer_position(writer);
+}
+
+/**
+ * @brief Consume octets that were written at the current write position
+ * @param writer [in] writer to advance
+ * @param len [in] number of octets written
+ * @return true if the octets fit, false and the overflow flag is set if not
+ */
+bool bacnet_writer_commit(BACNET_WRITER *writer, size_t len)
+{
+    if (!writer) {
+        return false;
+    }
+    if (len > bacnet_writer_remaining(writer)) {
+        writer->overflow = true;
+        return false;
+    }
+    writer->len += len;
+
+    return true;
+}
+
+/**
+ * @brief Discard the octets written after a previous length, and clear
+ *  the overflow flag so that a shorter encoding can be tried.
+ * @param writer [in] writer to rewind
+ * @param len [in] length returned earlier by bacnet_writer_length()
+ */
+void bacnet_writer_rewind(BACNET_WRITER *writer, size_t len)
+{
+    if (writer && (len <= writer->len)) {
+        writer->len = len;
+        writer->overflow = false;
+    }
+}
+
+/**
+ * @brief Append already encoded octets
+ * @param writer [in] writer to append to
+ * @param data [in] octets to append
+ * @param data_len [in] number of octets to append
+ * @return true if the octets fit, false and the overflow flag is set if not
+ */
+bool bacnet_writer_append(
+    BACNET_WRITER *writer, const uint8_t *data, size_t data_len)
+{
+    uint8_t *apdu;
+
+    apdu = bacnet_writer_reserve(writer, data_len);
+    if (!apdu) {
+        return false;
+    }
+    if (data_len > 0) {
+        memmove(apdu, data, data_len);
+    }
+    writer->len += data_len;
+
+    return true;
+}
+
+/**
+ * @brief Get the write position when at least bound octets remain, so that
+ *  an encoding that is known to be no larger than bound can be written
+ *  without first computing its length.
+ * @param writer [in] writer to query
+ * @param bound [in] upper bound of the encoding length
+ * @return pointer to the write position, or NULL if bound does not fit
+ */
+static uint8_t *bacnet_writer_bounded(const BACNET_WRITER *writer, size_t bound)
+{
+    if (bound > bacnet_writer_remaining(writer)) {
+        return NULL;
+    }
+
+    return bacnet_writer_position(writer);
+}
+
+/**
+ * @brief Consume an encoding written at a position returned by
+ *  bacnet_writer_bounded() or bacnet_writer_reserve()
+ * @param writer [in] writer to advance
+ * @param len [in] number of octets encoded
+ * @return number of octets encoded, or zero if they did not fit
+ */
+static int bacnet_writer_encoded(BACNET_WRITER *writer, int len)
+{
+    if ((len < 0) || !bacnet_writer_commit(writer, (size_t)len)) {
+        return 0;
+    }
+
+    return len;
+}
+
+/**
+ * @brief Encode an opening tag using a bounded writer
+ * @param writer [in] writer to encode into
+ * @param tag_number [in] tag number to encode
+ * @return number of octets encoded, or zero if they did not fit
+ */
+int bacnet_writer_opening_tag(BACNET_WRITER *writer, uint8_t tag_number)
+{
+    uint8_t *apdu;
+
+    apdu = bacnet_writer_reserve(writer, encode_opening_tag(NULL, tag_number));
+    if (!apdu) {
+        return 0;
+    }
+
+    return bacnet_writer_encoded(writer, encode_opening_tag(apdu, tag_number));
+}
+
+/**
+ * @brief Encode a closing tag using a bounded writer
+ * @param writer [in] writer to encode into
+ * @param tag_number [in] tag number to encode
+ * @return number of octets encoded, or zero if they did not fit
+ */
+int bacnet_writer_closing_tag(BACNET_WRITER *writer, uint8_t tag_number)
+{
+    uint8_t *apdu;
+
+    apdu = bacnet_writer_reserve(writer, encode_closing_tag(NULL, tag_number));
+    if (!apdu) {
+        return 0;
+    }
+
+    return bacnet_writer_encoded(writer, encode_closing_tag(apdu, tag_number));
+}
+
+/**
+ * @brief Encode an application tagged NULL using a bounded writer
+ * @param writer [in] writer to encode into
+ * @return number of octets encoded, or zero if they did not fit
+ */
+int bacnet_writer_application_null(BACNET_WRITER *writer)
+{
+    uint8_t *apdu;
+
+    apdu = bacnet_writer_reserve(writer, 1);
+    if (!apdu) {
+        return 0;
+    }
+
+    return bacnet_writer_encoded(writer, encode_application_null(apdu));
+}
+
+/**
+ * @brief Encode an application tagged Boolean using a bounded writer
+ * @param writer [in] writer to encode into
+ * @param value [in] value to encode
+ * @return number of octets encoded, or zero if they did not fit
+ */
+int bacnet_writer_application_boolean(BACNET_WRITER *writer, bool value)
+{
+    uint8_t *apdu;
+
+    apdu = bacnet_writer_reserve(writer, 1);
+    if (!apdu) {
+        return 0;
+    }
+
+    return bacnet_writer_encoded(
+        writer, encode_application_boolean(apdu, value));
+}
+
+/**
+ * @brief Encode an application tagged Unsigned Integer using a bounded writer
+ * @param writer [in] writer to encode into
+ * @param value [in] value to encode
+ * @return number of octets encoded, or zero if they did not fit
+ */
+int bacnet_writer_application_unsigned(
+    BACNET_WRITER *writer, BACNET_UNSIGNED_INTEGER value)
+{
+    uint8_t *apdu;
+
+    apdu = bacnet_writer_bounded(writer, BACNET_WRITER_PRIMITIVE_SIZE);
+    if (!apdu) {
+        apdu = bacnet_writer_reserve(
+            writer, encode_application_unsigned(NULL, value));
+        if (!apdu) {
+            return 0;
+        }
+    }
+
+    return bacnet_writer_encoded(
+        writer, encode_application_unsigned(apdu, value));
+}
+
+/**
+ * @brief Encode an application tagged Signed Integer using a bounded writer
+ * @param writer [in] writer to encode into
+ * @param value [in] value to encode
+ * @return number of octets encoded, or zero if they did not fit
+ */
+int bacnet_writer_application_signed(BACNET_WRITER *writer, int32_t value)
+{
+    uint8_t *apdu;
+
+    apdu = bacnet_writer_bounded(writer, BACNET_WRITER_PRIMITIVE_SIZE);
+    if (!apdu) {
+        apdu = bacnet_writer_reserve(
+            writer, encode_application_signed(NULL, value));
+        if (!apdu) {
+            return 0;
+        }
+    }
+
+    return bacnet_writer_encoded(
+        writer, encode_application_signed(apdu, value));
+}
+
+/**
+ * @brief Encode an application tagged Enumerated using a bounded writer
+ * @param writer [in] writer to encode into
+ * @param value [in] value to encode
+ * @return number of octets encoded, or zero if they did not fit
+ */
+int bacnet_writer_application_enumerated(BACNET_WRITER *writer, uint32_t value)
+{
+    uint8_t *apdu;
+
+    apdu = bacnet_writer_bounded(writer, BACNET_WRITER_PRIMITIVE_SIZE);
+    if (!apdu) {
+        apdu = bacnet_writer_reserve(
+            writer, encode_application_enumerated(NULL, value));
+        if (!apdu) {
+            return 0;
+        }
+    }
+
+    return bacnet_writer_encoded(
+        writer, encode_application_enumerated(apdu, value));
+}
+
+/**
+ * @brief Encode an application tagged Real using a bounded writer
+ * @param writer [in] writer to encode into
+ * @param value [in] value to encode
+ * @return number of octets encoded, or zero if they did not fit
+ */
+int bacnet_writer_application_real(BACNET_WRITER *writer, float value)
+{
+    uint8_t *apdu;
+
+    apdu = bacnet_writer_bounded(writer, BACNET_WRITER_PRIMITIVE_SIZE);
+    if (!apdu) {
+        apdu = bacnet_writer_reserve(
+            writer, encode_application_real(NULL, value));
+        if (!apdu) {
+            return 0;
+        }
+    }
+
+    return bacnet_writer_encoded(writer, encode_application_real(apdu, value));
+}
+
+/**
+ * @brief Encode an application tagged Double using a bounded writer
+ * @param writer [in] writer to encode into
+ * @param value [in] value to encode
+ * @return number of octets encoded, or zero if they did not fit
+ */
+int bacnet_writer_application_double(BACNET_WRITER *writer, double value)
+{
+    uint8_t *apdu;
+
+    apdu = bacnet_writer_bounded(writer, BACNET_WRITER_PRIMITIVE_SIZE);
+    if (!apdu) {
+        apdu = bacnet_writer_reserve(
+            writer, encode_application_double(NULL, value));
+        if (!apdu) {
+            return 0;
+        }
+    }
+
+    return bacnet_writer_encoded(
+        writer, encode_application_double(apdu, value));
+}
+
+/**
+ * @brief Encode an application tagged Object Identifier using a bounded writer
+ * @param writer [in] writer to encode into
+ * @param object_type [in] object type to encode
+ * @param instance [in] object instance to encode
+ * @return number of octets encoded, or zero if they did not fit
+ */
+int bacnet_writer_application_object_id(
+    BACNET_WRITER *writer, BACNET_OBJECT_TYPE object_type, uint32_t instance)
+{
+    uint8_t *apdu;
+
+    apdu = bacnet_writer_bounded(writer, BACNET_WRITER_PRIMITIVE_SIZE);
+    if (!apdu) {
+        apdu = bacnet_writer_reserve(
+            writer, encode_application_object_id(NULL, object_type, instance));
+        if (!apdu) {
+            return 0;
+        }
+    }
+
+    return bacnet_writer_encoded(
+        writer, encode_application_object_id(apdu, object_type, instance));
+}
+
+/**
+ * @brief Encode an application tagged Octet String using a bounded writer
+ * @param writer [in] writer to encode into
+ * @param value [in] value to encode
+ * @return number of octets encoded, or zero if they did not fit
+ */
+int bacnet_writer_application_octet_string(
+    BACNET_WRITER *writer, const BACNET_OCTET_STRING *value)
+{
+    uint8_t *apdu;
+
+    apdu = bacnet_writer_bounded(
+        writer, BACNET_TAG_SIZE + octetstring_length(value));
+    if (!apdu) {
+        apdu = bacnet_writer_reserve(
+            writer, encode_application_octet_string(NULL, value));
+        if (!apdu) {
+            return 0;
+        }
+    }
+
+    return bacnet_writer_encoded(
+        writer, encode_application_octet_string(apdu, value));
+}
+
+/**
+ * @brief Encode an application tagged Character String using a bounded writer
+ * @param writer [in] writer to encode into
+ * @param value [in] value to encode
+ * @return number of octets encoded, or zero if they did not fit
+ */
+int bacnet_writer_application_character_string(
+    BACNET_WRITER *writer, const BACNET_CHARACTER_STRING *value)
+{
+    uint8_t *apdu;
+
+    apdu = bacnet_writer_bounded(
+        writer, BACNET_TAG_SIZE + 1 + characterstring_length(value));
+    if (!apdu) {
+        apdu = bacnet_writer_reserve(
+            writer, encode_application_character_string(NULL, value));
+        if (!apdu) {
+            return 0;
+        }
+    }
+
+    return bacnet_writer_encoded(
+        writer, encode_application_character_string(apdu, value));
+}
+
+/**
+ * @brief Encode an application tagged Bit String using a bounded writer
+ * @param writer [in] writer to encode into
+ * @param value [in] value to encode
+ * @return number of octets encoded, or zero if they did not fit
+ */
+int bacnet_writer_application_bitstring(
+    BACNET_WRITER *writer, const BACNET_BIT_STRING *value)
+{
+    uint8_t *apdu;
+
+    apdu = bacnet_writer_bounded(
+        writer, BACNET_TAG_SIZE + 1 + bitstring_bytes_used(value));
+    if (!apdu) {
+        apdu = bacnet_writer_reserve(
+            writer, encode_application_bitstring(NULL, value));
+        if (!apdu) {
+            return 0;
+        }
+    }
+
+    return bacnet_writer_encoded(
+        writer, encode_application_bitstring(apdu, value));
+}
+
+/**
+ * @brief Encode an application tagged Date using a bounded writer
+ * @param writer [in] writer to encode into
+ * @param value [in] value to encode
+ * @return number of octets encoded, or zero if they did not fit
+ */
+int bacnet_writer_application_date(
+    BACNET_WRITER *writer, const BACNET_DATE *value)
+{
+    uint8_t *apdu;
+
+    apdu = bacnet_writer_bounded(writer, BACNET_WRITER_PRIMITIVE_SIZE);
+    if (!apdu) {
+        apdu = bacnet_writer_reserve(
+            writer, encode_application_date(NULL, value));
+        if (!apdu) {
+            return 0;
+        }
+    }
+
+    return bacnet_writer_encoded(writer, encode_application_date(apdu, value));
+}
+
+/**
+ * @brief Encode an application tagged Time using a bounded writer
+ * @param writer [in] writer to encode into
+ * @param value [in] value to encode
+ * @return number of octets encoded, or zero if they did not fit
+ */
+int bacnet_writer_application_time(
+    BACNET_WRITER *writer, const BACNET_TIME *value)
+{
+    uint8_t *apdu;
+
+    apdu = bacnet_writer_bounded(writer, BACNET_WRITER_PRIMITIVE_SIZE);
+    if (!apdu) {
+        apdu = bacnet_writer_reserve(
+            writer, encode_application_time(NULL, value));
+        if (!apdu) {
+            return 0;
+        }
+    }
+
+    return bacnet_writer_encoded(writer, encode_application_time(apdu, value));
+}
+
+/**
+ * @brief Encode a context tagged Boolean using a bounded writer
+ * @param writer [in] writer to encode into
+ * @param tag_number [in] context tag number to encode
+ * @param value [in] value to encode
+ * @return number of octets encoded, or zero if they did not fit
+ */
+int bacnet_writer_context_boolean(
+    BACNET_WRITER *writer, uint8_t tag_number, bool value)
+{
+    uint8_t *apdu;
+
+    apdu = bacnet_writer_reserve(
+        writer, encode_context_boolean(NULL, tag_number, value));
+    if (!apdu) {
+        return 0;
+    }
+
+    return bacnet_writer_encoded(
+        writer, encode_context_boolean(apdu, tag_number, value));
+}
+
+/**
+ * @brief Encode a context tagged Unsigned Integer using a bounded writer
+ * @param writer [in] writer to encode into
+ * @param tag_number [in] context tag number to encode
+ * @param value [in] value to encode
+ * @return number of octets encoded, or zero if they did not fit
+ */
+int bacnet_writer_context_unsigned(
+    BACNET_WRITER *writer, uint8_t tag_number, BACNET_UNSIGNED_INTEGER value)
+{
+    uint8_t *apdu;
+
+    apdu = bacnet_writer_bounded(writer, BACNET_WRITER_PRIMITIVE_SIZE);
+    if (!apdu) {
+        apdu = bacnet_writer_reserve(
+            writer, encode_context_unsigned(NULL, tag_number, value));
+        if (!apdu) {
+            return 0;
+        }
+    }
+
+    return bacnet_writer_encoded(
+        writer, encode_context_unsigned(apdu, tag_number, value));
+}
+
+/**
+ * @brief Encode a context tagged Signed Integer using a bounded writer
+ * @param writer [in] writer to encode into
+ * @param tag_number [in] context tag number to encode
+ * @param value [in] value to encode
+ * @return number of octets encoded, or zero if they did not fit
+ */
+int bacnet_writer_context_signed(
+    BACNET_WRITER *writer, uint8_t tag_number, int32_t value)
+{
+    uint8_t *apdu;
+
+    apdu = bacnet_writer_bounded(writer, BACNET_WRITER_PRIMITIVE_SIZE);
+    if (!apdu) {
+        apdu = bacnet_writer_reserve(
+            writer, encode_context_signed(NULL, tag_number, value));
+        if (!apdu) {
+            return 0;
+        }
+    }
+
+    return bacnet_writer_encoded(
+        writer, encode_context_signed(apdu, tag_number, value));
+}
+
+/**
+ * @brief Encode a context tagged Enumerated using a bounded writer
+ * @param writer [in] writer to encode into
+ * @param tag_number [in] context tag number to encode
+ * @param value [in] value to encode
+ * @return number of octets encoded, or zero if they did not fit
+ */
+int bacnet_writer_context_enumerated(
+    BACNET_WRITER *writer, uint8_t tag_number, uint32_t value)
+{
+    uint8_t *apdu;
+
+    apdu = bacnet_writer_bounded(writer, BACNET_WRITER_PRIMITIVE_SIZE);
+    if (!apdu) {
+        apdu = bacnet_writer_reserve(
+            writer, encode_context_enumerated(NULL, tag_number, value));
+        if (!apdu) {
+            return 0;
+        }
+    }
+
+    return bacnet_writer_encoded(
+        writer, encode_context_enumerated(apdu, tag_number, value));
+}
+
+/**
+ * @brief Encode a context tagged Real using a bounded writer
+ * @param writer [in] writer to encode into
+ * @param tag_number [in] context tag number to encode
+ * @param value [in] value to encode
+ * @return number of octets encoded, or zero if they did not fit
+ */
+int bacnet_writer_context_real(
+    BACNET_WRITER *writer, uint8_t tag_number, float value)
+{
+    uint8_t *apdu;
+
+    apdu = bacnet_writer_bounded(writer, BACNET_WRITER_PRIMITIVE_SIZE);
+    if (!apdu) {
+        apdu = bacnet_writer_reserve(
+            writer, encode_context_real(NULL, tag_number, value));
+        if (!apdu) {
+            return 0;
+        }
+    }
+
+    return bacnet_writer_encoded(
+        writer, encode_context_real(apdu, tag_number, value));
+}
+
+/**
+ * @brief Encode a context tagged Object Identifier using a bounded writer
+ * @param writer [in] writer to encode into
+ * @param tag_number [in] context tag number to encode
+ * @param object_type [in] object type to encode
+ * @param instance [in] object instance to encode
+ * @return number of octets encoded, or zero if they did not fit
+ */
+int bacnet_writer_context_object_id(
+    BACNET_WRITER *writer,
+    uint8_t tag_number,
+    BACNET_OBJECT_TYPE object_type,
+    uint32_t instance)
+{
+    uint8_t *apdu;
+
+    apdu = bacnet_writer_bounded(writer, BACNET_WRITER_PRIMITIVE_SIZE);
+    if (!apdu) {
+        apdu = bacnet_writer_reserve(
+            writer,
+            encode_context_object_id(NULL, tag_number, object_type, instance));
+        if (!apdu) {
+            return 0;
+        }
+    }
+
+    return bacnet_writer_encoded(
+        writer,
+        encode_context_object_id(apdu, tag_number, object_type, instance));
+}
+
+/**
+ * @brief Encode a context tagged Character String using a bounded writer
+ * @param writer [in] writer to encode into
+ * @param tag_number [in] context tag number to encode
+ * @param value [in] value to encode
+ * @return number of octets encoded, or zero if they did not fit
+ */
+int bacnet_writer_context_character_string(
+    BACNET_WRITER *writer,
+    uint8_t tag_number,
+    const BACNET_CHARACTER_STRING *value)
+{
+    uint8_t *apdu;
+
+    apdu = bacnet_writer_bounded(
+        writer, BACNET_TAG_SIZE + 1 + characterstring_length(value));
+    if (!apdu) {
+        apdu = bacnet_writer_reserve(
+            writer, encode_context_character_string(NULL, tag_number, value));
+        if (!apdu) {
+            return 0;
+        }
+    }
+
+    return bacnet_writer_encoded(
+        writer, encode_context_character_string(apdu, tag_number, value));
+}
@@ -69,6 +69,26 @@ typedef struct BACnetTag {
 /* max size of a BACnet tag */
 #define BACNET_TAG_SIZE 7
 
+/**
+ * @brief Bounded writer used to encode directly into an APDU in one pass.
+ * Each encoding either fits into the remaining capacity and is written
+ * once, or is not written at all and the overflow flag is set.
+ */
+typedef struct BACnet_Writer {
+    /* start of the buffer */
+    uint8_t *apdu;
+    /* capacity of the buffer, in octets */
+    size_t size;
+    /* number of octets written so far */
+    size_t len;
+    /* set when an encoding did not fit in the remaining capacity */
+    bool overflow;
+} BACNET_WRITER;
+
+/* max size of a tagged primitive value that has a fixed upper bound
+   (64-bit unsigned, double, date, time, object identifier) */
+#define BACNET_WRITER_PRIMITIVE_SIZE (BACNET_TAG_SIZE + 8)
+
 #ifdef __cplusplus
 extern "C" {
 #endif /* __cplusplus */
@@ -646,6 +666,93 @@ BACNET_ERROR_CODE bacnet_array_write(
     uint8_t *apdu,
     size_t apdu_size);
 
+BACNET_STACK_EXPORT
+void bacnet_writer_init(BACNET_WRITER *writer, uint8_t *apdu, size_t size);
+BACNET_STACK_EXPORT
+size_t bacnet_writer_length(const BACNET_WRITER *writer);
+BACNET_STACK_EXPORT
+size_t bacnet_writer_remaining(const BACNET_WRITER *writer);
+BACNET_STACK_EXPORT
+bool bacnet_writer_overflow(const BACNET_WRITER *writer);
+BACNET_STACK_EXPORT
+uint8_t *bacnet_writer_position(const BACNET_WRITER *writer);
+BACNET_STACK_EXPORT
+uint8_t *bacnet_writer_reserve(BACNET_WRITER *writer, size_t len);
+BACNET_STACK_EXPORT
+bool bacnet_writer_commit(BACNET_WRITER *writer, size_t len);
+BACNET_STACK_EXPORT
+void bacnet_writer_rewind(BACNET_WRITER *writer, size_t len);
+BACNET_STACK_EXPORT
+bool bacnet_writer_append(
+    BACNET_WRITER *writer, const uint8_t *data, size_t data_len);
+
+BACNET_STACK_EXPORT
+int bacnet_writer_opening_tag(BACNET_WRITER *writer, uint8_t tag_number);
+BACNET_STACK_EXPORT
+int bacnet_writer_closing_tag(BACNET_WRITER *writer, uint8_t tag_number);
+BACNET_STACK_EXPORT
+int bacnet_writer_application_null(BACNET_WRITER *writer);
+BACNET_STACK_EXPORT
+int bacnet_writer_application_boolean(BACNET_WRITER *writer, bool value);
+BACNET_STACK_EXPORT
+int bacnet_writer_application_unsigned(
+    BACNET_WRITER *writer, BACNET_UNSIGNED_INTEGER value);
+BACNET_STACK_EXPORT
+int bacnet_writer_application_signed(BACNET_WRITER *writer, int32_t value);
+BACNET_STACK_EXPORT
+int bacnet_writer_application_enumerated(
+    BACNET_WRITER *writer, uint32_t value);
+BACNET_STACK_EXPORT
+int bacnet_writer_application_real(BACNET_WRITER *writer, float value);
+BACNET_STACK_EXPORT
+int bacnet_writer_application_double(BACNET_WRITER *writer, double value);
+BACNET_STACK_EXPORT
+int bacnet_writer_application_object_id(
+    BACNET_WRITER *writer,
+    BACNET_OBJECT_TYPE object_type,
+    uint32_t instance);
+BACNET_STACK_EXPORT
+int bacnet_writer_application_octet_string(
+    BACNET_WRITER *writer, const BACNET_OCTET_STRING *value);
+BACNET_STACK_EXPORT
+int bacnet_writer_application_character_string(
+    BACNET_WRITER *writer, const BACNET_CHARACTER_STRING *value);
+BACNET_STACK_EXPORT
+int bacnet_writer_application_bitstring(
+    BACNET_WRITER *writer, const BACNET_BIT_STRING *value);
+BACNET_STACK_EXPORT
+int bacnet_writer_application_date(
+    BACNET_WRITER *writer, const BACNET_DATE *value);
+BACNET_STACK_EXPORT
+int bacnet_writer_application_time(
+    BACNET_WRITER *writer, const BACNET_TIME *value);
+BACNET_STACK_EXPORT
+int bacnet_writer_context_boolean(
+    BACNET_WRITER *writer, uint8_t tag_number, bool value);
+BACNET_STACK_EXPORT
+int bacnet_writer_context_unsigned(
+    BACNET_WRITER *writer, uint8_t tag_number, BACNET_UNSIGNED_INTEGER value);
+BACNET_STACK_EXPORT
+int bacnet_writer_context_signed(
+    BACNET_WRITER *writer, uint8_t tag_number, int32_t value);
+BACNET_STACK_EXPORT
+int bacnet_writer_context_enumerated(
+    BACNET_WRITER *writer, uint8_t tag_number, uint32_t value);
+BACNET_STACK_EXPORT
+int bacnet_writer_context_real(
+    BACNET_WRITER *writer, uint8_t tag_number, float value);
+BACNET_STACK_EXPORT
+int bacnet_writer_context_object_id(
+    BACNET_WRITER *writer,
+    uint8_t tag_number,
+    BACNET_OBJECT_TYPE object_type,
+    uint32_t instance);
+BACNET_STACK_EXPORT
+int bacnet_writer_context_character_string(
+    BACNET_WRITER *writer,
+    uint8_t tag_number,
+    const BACNET_CHARACTER_STRING *value);
+
 /* from clause 20.2.1.2 Tag Number */
 /* true if extended tag numbering is used */
 #define IS_EXTENDED_TAG_NUMBER(x) (((x) & 0xF0) == 0xF0)
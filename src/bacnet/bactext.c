@@ -14,29 +14,42 @@
 static const char *ASHRAE_Reserved_String = "Reserved for Use by ASHRAE";
 static const char *Vendor_Proprietary_String = "Vendor Proprietary Value";
 
+/* The largest text lists are searched using sorted views built
+   by bactext_init(), rather than a linear search.  Each view costs
+   two 16-bit words of RAM per list element. */
+#ifndef BACNET_TEXT_INDEX
+#define BACNET_TEXT_INDEX 0
+#endif
+
+/* Convert the text to an integer value. */
+static bool bactext_strtol(const char *search_name, unsigned *found_index)
+{
+    char *endptr;
+    long value;
+
+    value = strtol(search_name, &endptr, 0);
+    if (endptr == search_name) {
+        /* No digits found */
+        return false;
+    } else if (*endptr != '\0') {
+        /* Extra text found */
+        return false;
+    }
+    *found_index = (unsigned)value;
+
+    return true;
+}
+
 /* Search for a text value first based on the corresponding text list, then by
  * attempting to convert to an integer value. */
 static bool bactext_strtol_index(
     INDTEXT_DATA *istring, const char *search_name, unsigned *found_index)
 {
-    char *endptr;
-    long value;
-
     if (indtext_by_istring(istring, search_name, found_index) == true) {
         return true;
-    } else {
-        value = strtol(search_name, &endptr, 0);
-        if (endptr == search_name) {
-            /* No digits found */
-            return false;
-        } else if (*endptr != '\0') {
-            /* Extra text found */
-            return false;
-        } else {
-            *found_index = (unsigned)value;
-            return true;
-        }
     }
+
+    return bactext_strtol(search_name, found_index);
 }
 
 INDTEXT_DATA bacnet_confirmed_service_names[] = {
@@ -235,23 +248,49 @@ INDTEXT_DATA bacnet_object_type_names[] = {
     { 0, NULL }
 };
 
+#if BACNET_TEXT_INDEX
+static uint16_t Object_Type_Name_Order[sizeof(bacnet_object_type_names) /
+    sizeof(bacnet_object_type_names[0])];
+static uint16_t Object_Type_Index_Order[sizeof(bacnet_object_type_names) /
+    sizeof(bacnet_object_type_names[0])];
+static INDTEXT_INDEX Object_Type_Index = {
+    bacnet_object_type_names, Object_Type_Name_Order,
+    Object_Type_Index_Order, 0, false
+};
+#endif
+
 const char *bactext_object_type_name(unsigned index)
 {
+#if BACNET_TEXT_INDEX
+    return indtext_index_by_index_default(
+        &Object_Type_Index, index,
+        index < OBJECT_PROPRIETARY_MIN ? ASHRAE_Reserved_String
+                                       : Vendor_Proprietary_String);
+#else
     return indtext_by_index_split_default(
         bacnet_object_type_names, index, OBJECT_PROPRIETARY_MIN,
         ASHRAE_Reserved_String, Vendor_Proprietary_String);
+#endif
 }
 
 bool bactext_object_type_index(const char *search_name, unsigned *found_index)
 {
+#if BACNET_TEXT_INDEX
+    return indtext_index_by_istring(
+        &Object_Type_Index, search_name, found_index);
+#else
     return indtext_by_istring(
         bacnet_object_type_names, search_name, found_index);
+#endif
 }
 
 bool bactext_object_type_strtol(const char *search_name, unsigned *found_index)
 {
-    return bactext_strtol_index(
-        bacnet_object_type_names, search_name, found_index);
+    if (bactext_object_type_index(search_name, found_index)) {
+        return true;
+    }
+
+    return bactext_strtol(search_name, found_index);
 }
 
 INDTEXT_DATA bacnet_property_names[] = {
@@ -792,6 +831,16 @@ INDTEXT_DATA bacnet_property_names[] = {
     { 0, NULL }
 };
 
+#if BACNET_TEXT_INDEX
+static uint16_t Property_Name_Order[sizeof(bacnet_property_names) /
+    sizeof(bacnet_property_names[0])];
+static uint16_t Property_Index_Order[sizeof(bacnet_property_names) /
+    sizeof(bacnet_property_names[0])];
+static INDTEXT_INDEX Property_Index = {
+    bacnet_property_names, Property_Name_Order, Property_Index_Order, 0, false
+};
+#endif
+
 bool bactext_property_name_proprietary(unsigned index)
 {
     bool status = false;
@@ -812,32 +861,49 @@ const char *bactext_property_name(unsigned index)
     if (bactext_property_name_proprietary(index)) {
         return Vendor_Proprietary_String;
     } else {
-        return indtext_by_index_default(
-            bacnet_property_names, index, ASHRAE_Reserved_String);
+        return bactext_property_name_default(index, ASHRAE_Reserved_String);
     }
 }
 
 const char *
 bactext_property_name_default(unsigned index, const char *default_string)
 {
+#if BACNET_TEXT_INDEX
+    return indtext_index_by_index_default(
+        &Property_Index, index, default_string);
+#else
     return indtext_by_index_default(
         bacnet_property_names, index, default_string);
+#endif
 }
 
 unsigned bactext_property_id(const char *name)
 {
-    return indtext_by_istring_default(bacnet_property_names, name, 0);
+    unsigned index = 0;
+
+    if (!bactext_property_index(name, &index)) {
+        index = 0;
+    }
+
+    return index;
 }
 
 bool bactext_property_index(const char *search_name, unsigned *found_index)
 {
+#if BACNET_TEXT_INDEX
+    return indtext_index_by_istring(&Property_Index, search_name, found_index);
+#else
     return indtext_by_istring(bacnet_property_names, search_name, found_index);
+#endif
 }
 
 bool bactext_property_strtol(const char *search_name, unsigned *found_index)
 {
-    return bactext_strtol_index(
-        bacnet_property_names, search_name, found_index);
+    if (bactext_property_index(search_name, found_index)) {
+        return true;
+    }
+
+    return bactext_strtol(search_name, found_index);
 }
 
 INDTEXT_DATA bacnet_engineering_unit_names[] = {
@@ -1275,6 +1341,19 @@ INDTEXT_DATA bacnet_engineering_unit_names[] = {
        subject to the procedures and constraints described in Clause 23. */
 };
 
+#if BACNET_TEXT_INDEX
+static uint16_t Engineering_Unit_Name_Order
+    [sizeof(bacnet_engineering_unit_names) /
+     sizeof(bacnet_engineering_unit_names[0])];
+static uint16_t Engineering_Unit_Index_Order
+    [sizeof(bacnet_engineering_unit_names) /
+     sizeof(bacnet_engineering_unit_names[0])];
+static INDTEXT_INDEX Engineering_Unit_Index = {
+    bacnet_engineering_unit_names, Engineering_Unit_Name_Order,
+    Engineering_Unit_Index_Order, 0, false
+};
+#endif
+
 bool bactext_engineering_unit_name_proprietary(unsigned index)
 {
     bool status = false;
@@ -1296,8 +1375,13 @@ const char *bactext_engineering_unit_name(unsigned index)
     if (bactext_engineering_unit_name_proprietary(index)) {
         return Vendor_Proprietary_String;
     } else if (index <= UNITS_RESERVED_RANGE_MAX2) {
+#if BACNET_TEXT_INDEX
+        return indtext_index_by_index_default(
+            &Engineering_Unit_Index, index, ASHRAE_Reserved_String);
+#else
         return indtext_by_index_default(
             bacnet_engineering_unit_names, index, ASHRAE_Reserved_String);
+#endif
     }
 
     return ASHRAE_Reserved_String;
@@ -1306,8 +1390,13 @@ const char *bactext_engineering_unit_name(unsigned index)
 bool bactext_engineering_unit_index(
     const char *search_name, unsigned *found_index)
 {
+#if BACNET_TEXT_INDEX
+    return indtext_index_by_istring(
+        &Engineering_Unit_Index, search_name, found_index);
+#else
     return indtext_by_istring(
         bacnet_engineering_unit_names, search_name, found_index);
+#endif
 }
 
 INDTEXT_DATA bacnet_reject_reason_names[] = {
@@ -1625,11 +1714,29 @@ INDTEXT_DATA bacnet_error_code_names[] = {
     { 0, NULL }
 };
 
+#if BACNET_TEXT_INDEX
+static uint16_t Error_Code_Name_Order[sizeof(bacnet_error_code_names) /
+    sizeof(bacnet_error_code_names[0])];
+static uint16_t Error_Code_Index_Order[sizeof(bacnet_error_code_names) /
+    sizeof(bacnet_error_code_names[0])];
+static INDTEXT_INDEX Error_Code_Index = {
+    bacnet_error_code_names, Error_Code_Name_Order,
+    Error_Code_Index_Order, 0, false
+};
+#endif
+
 const char *bactext_error_code_name(unsigned index)
 {
+#if BACNET_TEXT_INDEX
+    return indtext_index_by_index_default(
+        &Error_Code_Index, index,
+        index < ERROR_CODE_PROPRIETARY_FIRST ? ASHRAE_Reserved_String
+                                             : Vendor_Proprietary_String);
+#else
     return indtext_by_index_split_default(
         bacnet_error_code_names, index, ERROR_CODE_PROPRIETARY_FIRST,
         ASHRAE_Reserved_String, Vendor_Proprietary_String);
+#endif
 }
 
 INDTEXT_DATA bacnet_month_names[] = {
@@ -2148,3 +2255,18 @@ const char *bactext_shed_level_type_name(unsigned index)
     return indtext_by_index_default(
         bacnet_shed_level_type_names, index, ASHRAE_Reserved_String);
 }
+
+/**
+ * @brief Build the sorted views used to search the largest text lists.
+ *  Call once at startup, before any other thread uses the bactext API.
+ *  Until then, the lookups use a linear search of the text lists.
+ */
+void bactext_init(void)
+{
+#if BACNET_TEXT_INDEX
+    indtext_index_init(&Object_Type_Index);
+    indtext_index_init(&Property_Index);
+    indtext_index_init(&Engineering_Unit_Index);
+    indtext_index_init(&Error_Code_Index);
+#endif
+}
@@ -24,6 +24,9 @@
 extern "C" {
 #endif /* __cplusplus */
 
+BACNET_STACK_EXPORT
+void bactext_init(void);
+
 BACNET_STACK_EXPORT
 const char *bactext_confirmed_service_name(unsigned index);
 BACNET_STACK_EXPORT
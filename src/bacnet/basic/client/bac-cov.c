@@ -0,0 +1,562 @@
+/**
+ * @file
+ * @brief Client COV subscription manager
+ * @details Keeps the SubscribeCOV subscriptions of many consumers to
+ *  the objects of other BACnet devices.  Consumers of the same object
+ *  share one subscription, which is renewed before its lifetime lapses.
+ *  The renewals are spread over a quarter of the lifetime so that
+ *  subscriptions made at the same time are not renewed in a burst.
+ *  The subscriptions are found with a hash of the device and object,
+ *  which routes each COV notification to the consumers of the object.
+ * @author Steve Karg <skarg@users.sourceforge.net>
+ * @date 2024
+ * @copyright SPDX-License-Identifier: MIT
+ */
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdlib.h>
+/* BACnet Stack defines - first */
+#include "bacnet/bacdef.h"
+/* BACnet Stack API */
+#include "bacnet/apdu.h"
+#include "bacnet/cov.h"
+#include "bacnet/basic/services.h"
+#include "bacnet/basic/sys/hash_table.h"
+#include "bacnet/basic/sys/mstimer.h"
+#include "bacnet/basic/client/bac-rw.h"
+/* me */
+#include "bacnet/basic/client/bac-cov.h"
+
+/* number of subscriptions */
+#ifndef BACNET_COV_SUBSCRIPTIONS_MAX
+#define BACNET_COV_SUBSCRIPTIONS_MAX 65535UL
+#endif
+/* lifetime of the subscriptions in seconds */
+#ifndef BACNET_COV_LIFETIME
+#define BACNET_COV_LIFETIME 300
+#endif
+/* subscriber process identifier of the subscriptions */
+#ifndef BACNET_COV_PROCESS_ID
+#define BACNET_COV_PROCESS_ID 0xBAC0
+#endif
+/* seconds before a subscription that timed out is tried again */
+#ifndef BACNET_COV_RETRY_SECONDS
+#define BACNET_COV_RETRY_SECONDS 10
+#endif
+/* longest time between scans for renewals, in milliseconds */
+#define BACNET_COV_SCAN_MS 1000UL
+/* end of a list of subscriptions */
+#define BACNET_COV_NONE HASH_TABLE_NONE
+
+/* a consumer of a subscription */
+typedef struct bacnet_cov_consumer {
+    bacnet_cov_callback_t callback;
+    void *context;
+    struct bacnet_cov_consumer *next;
+} BACNET_COV_CONSUMER;
+
+/* a subscription to an object of a remote device */
+typedef struct bacnet_cov_subscription {
+    uint32_t Device_ID;
+    uint32_t Object_ID;
+    uint16_t Object_Type;
+    /* next subscription in the hash bucket, or in the free list */
+    uint32_t Next;
+    /* time until the subscription lapses */
+    struct mstimer Lifetime_Timer;
+    /* time until the next SubscribeCOV request */
+    struct mstimer Renew_Timer;
+    BACNET_COV_CONSUMER *Consumers;
+    uint8_t Status;
+    /* a SubscribeCOV request is queued or in flight */
+    bool Queued;
+} BACNET_COV_SUBSCRIPTION;
+/* table of subscriptions, and the hash buckets of the subscriptions */
+static HASH_TABLE Subscription_Table;
+
+/* renewal scan: next subscription, and the least time until a renewal */
+static struct mstimer Scan_Timer;
+static uint32_t Scan_Index;
+static unsigned long Scan_Next = BACNET_COV_SCAN_MS;
+
+static uint32_t COV_Lifetime = BACNET_COV_LIFETIME;
+static BACNET_COV_NOTIFICATION COV_Notification;
+static BACNET_COV_NOTIFICATION COV_Confirmed_Notification;
+
+/**
+ * @brief Hash the device and object of a subscription
+ * @param device_id - device instance number
+ * @param object_type - object type of the monitored object
+ * @param object_instance - object instance of the monitored object
+ * @return hash of the subscription
+ */
+static uint32_t bacnet_cov_hash(
+    uint32_t device_id, uint16_t object_type, uint32_t object_instance)
+{
+    uint32_t hash = hash_table_key_init();
+
+    hash = hash_table_key_add(hash, device_id);
+    hash = hash_table_key_add(hash, (uint32_t)object_type << 22);
+    hash = hash_table_key_add(hash, object_instance);
+
+    return hash_table_key_final(hash);
+}
+
+/**
+ * @brief Hash the device and object of a subscription in the table
+ * @param entry - subscription in the table
+ * @return hash of the subscription
+ */
+static uint32_t bacnet_cov_entry_hash(const void *entry)
+{
+    const BACNET_COV_SUBSCRIPTION *subscription = entry;
+
+    return bacnet_cov_hash(
+        subscription->Device_ID, subscription->Object_Type,
+        subscription->Object_ID);
+}
+
+/**
+ * @brief Get a subscription in the table
+ * @param index - index of the subscription
+ * @return the subscription
+ */
+static BACNET_COV_SUBSCRIPTION *bacnet_cov_subscription(uint32_t index)
+{
+    return hash_table_entry(&Subscription_Table, index);
+}
+
+/**
+ * @brief Find the index of a subscription
+ * @param device_id - device instance number
+ * @param object_type - object type of the monitored object
+ * @param object_instance - object instance of the monitored object
+ * @return index of the subscription, or BACNET_COV_NONE if not found
+ */
+static uint32_t bacnet_cov_index_find(
+    uint32_t device_id, uint16_t object_type, uint32_t object_instance)
+{
+    const BACNET_COV_SUBSCRIPTION *subscription;
+    uint32_t index;
+
+    index = hash_table_first(
+        &Subscription_Table,
+        bacnet_cov_hash(device_id, object_type, object_instance));
+    while (index != BACNET_COV_NONE) {
+        subscription = bacnet_cov_subscription(index);
+        if ((subscription->Device_ID == device_id) &&
+            (subscription->Object_Type == object_type) &&
+            (subscription->Object_ID == object_instance)) {
+            return index;
+        }
+        index = hash_table_next(&Subscription_Table, index);
+    }
+
+    return BACNET_COV_NONE;
+}
+
+/**
+ * @brief Get a spread of a time, fixed for each subscription, so that
+ *  the subscriptions made at the same time are renewed at different times
+ * @param subscription - the subscription
+ * @param milliseconds - the time to spread
+ * @return a time from 0 to milliseconds
+ */
+static unsigned long bacnet_cov_spread(
+    const BACNET_COV_SUBSCRIPTION *subscription, unsigned long milliseconds)
+{
+    if (milliseconds == 0) {
+        return 0;
+    }
+
+    return bacnet_cov_hash(
+               subscription->Device_ID, subscription->Object_Type,
+               subscription->Object_ID) %
+        (milliseconds + 1);
+}
+
+/**
+ * @brief Schedule the next SubscribeCOV of a subscription, and make
+ *  sure that the renewal scan does not sleep past it
+ * @param subscription - the subscription
+ * @param milliseconds - time until the next SubscribeCOV
+ */
+static void bacnet_cov_schedule(
+    BACNET_COV_SUBSCRIPTION *subscription, unsigned long milliseconds)
+{
+    if (milliseconds == 0) {
+        /* a timer without an interval never expires */
+        milliseconds = 1;
+    }
+    mstimer_set(&subscription->Renew_Timer, milliseconds);
+    if (milliseconds < Scan_Next) {
+        Scan_Next = milliseconds;
+    }
+    if (mstimer_remaining(&Scan_Timer) > milliseconds) {
+        mstimer_set(&Scan_Timer, milliseconds);
+    }
+}
+
+/**
+ * @brief Free a subscription without consumers
+ * @param index - index of the subscription
+ */
+static void bacnet_cov_free(uint32_t index)
+{
+    BACNET_COV_SUBSCRIPTION *subscription = bacnet_cov_subscription(index);
+
+    (void)hash_table_remove(
+        &Subscription_Table, bacnet_cov_entry_hash(subscription), index);
+    subscription->Consumers = NULL;
+}
+
+/**
+ * @brief Handle the result of a SubscribeCOV request
+ * @param device_id - device instance number of the request
+ * @param cov_data - the subscription, with the error class and code
+ */
+static void
+bacnet_cov_result(uint32_t device_id, BACNET_SUBSCRIBE_COV_DATA *cov_data)
+{
+    BACNET_COV_SUBSCRIPTION *subscription;
+    unsigned long lifetime;
+    uint32_t index, i;
+
+    if (!cov_data || cov_data->cancellationRequest ||
+        (cov_data->subscriberProcessIdentifier != BACNET_COV_PROCESS_ID)) {
+        return;
+    }
+    index = bacnet_cov_index_find(
+        device_id, cov_data->monitoredObjectIdentifier.type,
+        cov_data->monitoredObjectIdentifier.instance);
+    if (index == BACNET_COV_NONE) {
+        return;
+    }
+    subscription = bacnet_cov_subscription(index);
+    subscription->Queued = false;
+    lifetime = cov_data->lifetime * 1000UL;
+    if (cov_data->error_code == ERROR_CODE_SUCCESS) {
+        subscription->Status = BACNET_COV_STATUS_ACTIVE;
+        mstimer_set(&subscription->Lifetime_Timer, lifetime);
+        /* renew between half and three quarters of the lifetime */
+        bacnet_cov_schedule(
+            subscription,
+            (lifetime / 2) + bacnet_cov_spread(subscription, lifetime / 4));
+    } else if (
+        (cov_data->error_code == ERROR_CODE_TIMEOUT) ||
+        (cov_data->error_code == ERROR_CODE_ABORT_TSM_TIMEOUT)) {
+        if (subscription->Status != BACNET_COV_STATUS_ACTIVE) {
+            subscription->Status = BACNET_COV_STATUS_PENDING;
+        }
+        lifetime = BACNET_COV_RETRY_SECONDS * 1000UL;
+        bacnet_cov_schedule(
+            subscription, lifetime + bacnet_cov_spread(subscription, lifetime));
+    } else if (
+        cov_data->error_code == ERROR_CODE_REJECT_UNRECOGNIZED_SERVICE) {
+        /* none of the objects of this device can be subscribed */
+        for (i = 0; i < hash_table_used(&Subscription_Table); i++) {
+            subscription = bacnet_cov_subscription(i);
+            if (subscription->Consumers &&
+                (subscription->Device_ID == device_id)) {
+                subscription->Status = BACNET_COV_STATUS_UNSUPPORTED;
+            }
+        }
+    } else {
+        subscription->Status = BACNET_COV_STATUS_FAILED;
+        bacnet_cov_schedule(
+            subscription, lifetime + bacnet_cov_spread(subscription, lifetime));
+    }
+}
+
+/**
+ * @brief Route a COV notification to the consumers of the subscription
+ * @param cov_data - the decoded COV notification
+ */
+static void bacnet_cov_notification(BACNET_COV_DATA *cov_data)
+{
+    BACNET_COV_SUBSCRIPTION *subscription;
+    BACNET_COV_CONSUMER *consumer;
+    uint32_t index;
+
+    if (cov_data->subscriberProcessIdentifier != BACNET_COV_PROCESS_ID) {
+        return;
+    }
+    index = bacnet_cov_index_find(
+        cov_data->initiatingDeviceIdentifier,
+        cov_data->monitoredObjectIdentifier.type,
+        cov_data->monitoredObjectIdentifier.instance);
+    if (index == BACNET_COV_NONE) {
+        return;
+    }
+    subscription = bacnet_cov_subscription(index);
+    if ((subscription->Status == BACNET_COV_STATUS_ACTIVE) &&
+        (cov_data->timeRemaining > 0)) {
+        mstimer_set(
+            &subscription->Lifetime_Timer, cov_data->timeRemaining * 1000UL);
+    }
+    consumer = subscription->Consumers;
+    while (consumer) {
+        consumer->callback(cov_data, consumer->context);
+        consumer = consumer->next;
+    }
+}
+
+/**
+ * @brief Queue the SubscribeCOV requests that are due.  The scan stops
+ *  when the request queue is full, and continues at the next task.
+ *  After a full scan, the scan sleeps until the next renewal is due.
+ */
+void bacnet_cov_task(void)
+{
+    BACNET_COV_SUBSCRIPTION *subscription;
+    unsigned long remaining;
+
+    if (!mstimer_expired(&Scan_Timer)) {
+        return;
+    }
+    while (Scan_Index < hash_table_used(&Subscription_Table)) {
+        subscription = bacnet_cov_subscription(Scan_Index);
+        if (subscription->Consumers && !subscription->Queued &&
+            (subscription->Status != BACNET_COV_STATUS_UNSUPPORTED)) {
+            if (mstimer_expired(&subscription->Renew_Timer)) {
+                if (!bacnet_subscribe_cov_queue(
+                        subscription->Device_ID,
+                        (BACNET_OBJECT_TYPE)subscription->Object_Type,
+                        subscription->Object_ID, BACNET_COV_PROCESS_ID,
+                        COV_Lifetime, false)) {
+                    /* queue is full - continue here next time */
+                    return;
+                }
+                subscription->Queued = true;
+            } else {
+                remaining = mstimer_remaining(&subscription->Renew_Timer);
+                if (remaining < Scan_Next) {
+                    Scan_Next = remaining;
+                }
+            }
+        }
+        Scan_Index++;
+    }
+    mstimer_set(&Scan_Timer, Scan_Next);
+    Scan_Index = 0;
+    Scan_Next = BACNET_COV_SCAN_MS;
+}
+
+/**
+ * @brief Subscribe a consumer to the COV notifications of a remote object.
+ *  The consumers of the same object share one subscription.
+ * @param device_id - device instance number
+ * @param object_type - object type of the monitored object
+ * @param object_instance - object instance of the monitored object
+ * @param callback - function called with each notification
+ * @param context - passed to the callback
+ * @return true if subscribed, or already subscribed, false if the
+ *  subscription could not be stored
+ */
+bool bacnet_cov_subscribe(
+    uint32_t device_id,
+    BACNET_OBJECT_TYPE object_type,
+    uint32_t object_instance,
+    bacnet_cov_callback_t callback,
+    void *context)
+{
+    BACNET_COV_SUBSCRIPTION *subscription;
+    BACNET_COV_CONSUMER *consumer;
+    uint32_t index;
+
+    if (!callback || (device_id >= BACNET_MAX_INSTANCE) ||
+        (object_type >= MAX_BACNET_OBJECT_TYPE) ||
+        (object_instance >= BACNET_MAX_INSTANCE)) {
+        return false;
+    }
+    index = bacnet_cov_index_find(device_id, object_type, object_instance);
+    if (index != BACNET_COV_NONE) {
+        subscription = bacnet_cov_subscription(index);
+        consumer = subscription->Consumers;
+        while (consumer) {
+            if ((consumer->callback == callback) &&
+                (consumer->context == context)) {
+                return true;
+            }
+            consumer = consumer->next;
+        }
+    }
+    consumer = calloc(1, sizeof(BACNET_COV_CONSUMER));
+    if (!consumer) {
+        return false;
+    }
+    consumer->callback = callback;
+    consumer->context = context;
+    if (index == BACNET_COV_NONE) {
+        index = hash_table_add(
+            &Subscription_Table,
+            bacnet_cov_hash(device_id, object_type, object_instance));
+        if (index == BACNET_COV_NONE) {
+            free(consumer);
+            return false;
+        }
+        subscription = bacnet_cov_subscription(index);
+        subscription->Device_ID = device_id;
+        subscription->Object_Type = object_type;
+        subscription->Object_ID = object_instance;
+        subscription->Status = BACNET_COV_STATUS_PENDING;
+        subscription->Queued = false;
+        subscription->Consumers = NULL;
+        mstimer_set(&subscription->Lifetime_Timer, 0);
+        bacnet_cov_schedule(subscription, 0);
+    }
+    subscription = bacnet_cov_subscription(index);
+    consumer->next = subscription->Consumers;
+    subscription->Consumers = consumer;
+
+    return true;
+}
+
+/**
+ * @brief Unsubscribe a consumer from the COV notifications of a remote
+ *  object.  The subscription is cancelled when it has no more consumers.
+ * @param device_id - device instance number
+ * @param object_type - object type of the monitored object
+ * @param object_instance - object instance of the monitored object
+ * @param callback - function given when subscribing
+ * @param context - context given when subscribing
+ * @return true if the consumer was found and removed
+ */
+bool bacnet_cov_unsubscribe(
+    uint32_t device_id,
+    BACNET_OBJECT_TYPE object_type,
+    uint32_t object_instance,
+    bacnet_cov_callback_t callback,
+    void *context)
+{
+    BACNET_COV_SUBSCRIPTION *subscription;
+    BACNET_COV_CONSUMER *consumer, **link;
+    uint32_t index;
+
+    index = bacnet_cov_index_find(device_id, object_type, object_instance);
+    if (index == BACNET_COV_NONE) {
+        return false;
+    }
+    subscription = bacnet_cov_subscription(index);
+    link = &subscription->Consumers;
+    while (*link) {
+        consumer = *link;
+        if ((consumer->callback == callback) &&
+            (consumer->context == context)) {
+            *link = consumer->next;
+            free(consumer);
+            if (!subscription->Consumers) {
+                if ((subscription->Status == BACNET_COV_STATUS_ACTIVE) ||
+                    subscription->Queued) {
+                    /* best effort - otherwise the subscription lapses */
+                    bacnet_subscribe_cov_queue(
+                        device_id, object_type, object_instance,
+                        BACNET_COV_PROCESS_ID, 0, true);
+                }
+                bacnet_cov_free(index);
+            }
+            return true;
+        }
+        link = &consumer->next;
+    }
+
+    return false;
+}
+
+/**
+ * @brief Get the status of the subscription to a remote object
+ * @param device_id - device instance number
+ * @param object_type - object type of the monitored object
+ * @param object_instance - object instance of the monitored object
+ * @return status of the subscription
+ */
+BACNET_COV_STATUS bacnet_cov_status(
+    uint32_t device_id,
+    BACNET_OBJECT_TYPE object_type,
+    uint32_t object_instance)
+{
+    const BACNET_COV_SUBSCRIPTION *subscription;
+    uint32_t index;
+
+    index = bacnet_cov_index_find(device_id, object_type, object_instance);
+    if (index == BACNET_COV_NONE) {
+        return BACNET_COV_STATUS_NONE;
+    }
+    subscription = bacnet_cov_subscription(index);
+    if ((subscription->Status == BACNET_COV_STATUS_ACTIVE) &&
+        mstimer_expired(&subscription->Lifetime_Timer)) {
+        /* lapsed while the renewal is outstanding */
+        return BACNET_COV_STATUS_PENDING;
+    }
+
+    return (BACNET_COV_STATUS)subscription->Status;
+}
+
+/**
+ * @brief Get the number of subscriptions
+ * @return number of subscriptions
+ */
+unsigned long bacnet_cov_subscription_count(void)
+{
+    return hash_table_count(&Subscription_Table);
+}
+
+/**
+ * @brief Set the lifetime of the subscriptions.  A subscription is
+ *  renewed between one half and three quarters of its lifetime.
+ * @param seconds - lifetime in seconds, greater than 0
+ */
+void bacnet_cov_lifetime_set(uint32_t seconds)
+{
+    if (seconds > 0) {
+        COV_Lifetime = seconds;
+    }
+}
+
+/**
+ * @brief Get the lifetime of the subscriptions
+ * @return lifetime in seconds
+ */
+uint32_t bacnet_cov_lifetime(void)
+{
+    return COV_Lifetime;
+}
+
+/**
+ * @brief Initializes the COV subscription manager, and frees the
+ *  subscriptions of a previous initialization.  The requests are sent
+ *  by the bac-rw module, which must be initialized and run by the
+ *  application.
+ */
+void bacnet_cov_init(void)
+{
+    BACNET_COV_SUBSCRIPTION *subscription;
+    BACNET_COV_CONSUMER *consumer;
+    uint32_t i;
+
+    for (i = 0; i < hash_table_used(&Subscription_Table); i++) {
+        subscription = bacnet_cov_subscription(i);
+        while (subscription->Consumers) {
+            consumer = subscription->Consumers;
+            subscription->Consumers = consumer->next;
+            free(consumer);
+        }
+    }
+    hash_table_cleanup(&Subscription_Table);
+    hash_table_init(
+        &Subscription_Table, sizeof(BACNET_COV_SUBSCRIPTION),
+        offsetof(BACNET_COV_SUBSCRIPTION, Next), BACNET_COV_SUBSCRIPTIONS_MAX,
+        bacnet_cov_entry_hash);
+    Scan_Index = 0;
+    Scan_Next = BACNET_COV_SCAN_MS;
+    mstimer_set(&Scan_Timer, BACNET_COV_SCAN_MS);
+    bacnet_read_write_cov_callback_set(bacnet_cov_result);
+    /* handle the notifications of our subscriptions */
+    COV_Notification.callback = bacnet_cov_notification;
+    handler_ucov_notification_add(&COV_Notification);
+    COV_Confirmed_Notification.callback = bacnet_cov_notification;
+    handler_ccov_notification_add(&COV_Confirmed_Notification);
+    apdu_set_unconfirmed_handler(
+        SERVICE_UNCONFIRMED_COV_NOTIFICATION, handler_ucov_notification);
+}
@@ -0,0 +1,77 @@
+/**
+ * @file
+ * @brief API for the client COV subscription manager
+ * @author Steve Karg <skarg@users.sourceforge.net>
+ * @date 2024
+ * @copyright SPDX-License-Identifier: MIT
+ */
+#ifndef BACNET_BASIC_CLIENT_COV_H
+#define BACNET_BASIC_CLIENT_COV_H
+
+#include <stdint.h>
+#include <stdbool.h>
+/* BACnet Stack defines - first */
+#include "bacnet/bacdef.h"
+/* BACnet Stack API */
+#include "bacnet/cov.h"
+
+/* status of a COV subscription */
+typedef enum bacnet_cov_status {
+    /* no subscription to the object */
+    BACNET_COV_STATUS_NONE,
+    /* waiting for the subscription to be acknowledged or renewed */
+    BACNET_COV_STATUS_PENDING,
+    /* the subscription is acknowledged, and has not lapsed */
+    BACNET_COV_STATUS_ACTIVE,
+    /* the subscription was refused, and is tried again later */
+    BACNET_COV_STATUS_FAILED,
+    /* the device does not support SubscribeCOV */
+    BACNET_COV_STATUS_UNSUPPORTED
+} BACNET_COV_STATUS;
+
+/**
+ * Deliver a COV notification to a consumer of a subscription
+ *
+ * @param cov_data [in] the decoded COV notification
+ * @param context [in] the context given when subscribing
+ */
+typedef void (*bacnet_cov_callback_t)(BACNET_COV_DATA *cov_data, void *context);
+
+#ifdef __cplusplus
+extern "C" {
+#endif /* __cplusplus */
+
+BACNET_STACK_EXPORT
+void bacnet_cov_init(void);
+BACNET_STACK_EXPORT
+void bacnet_cov_task(void);
+BACNET_STACK_EXPORT
+bool bacnet_cov_subscribe(
+    uint32_t device_id,
+    BACNET_OBJECT_TYPE object_type,
+    uint32_t object_instance,
+    bacnet_cov_callback_t callback,
+    void *context);
+BACNET_STACK_EXPORT
+bool bacnet_cov_unsubscribe(
+    uint32_t device_id,
+    BACNET_OBJECT_TYPE object_type,
+    uint32_t object_instance,
+    bacnet_cov_callback_t callback,
+    void *context);
+BACNET_STACK_EXPORT
+BACNET_COV_STATUS bacnet_cov_status(
+    uint32_t device_id,
+    BACNET_OBJECT_TYPE object_type,
+    uint32_t object_instance);
+BACNET_STACK_EXPORT
+unsigned long bacnet_cov_subscription_count(void);
+BACNET_STACK_EXPORT
+void bacnet_cov_lifetime_set(uint32_t seconds);
+BACNET_STACK_EXPORT
+uint32_t bacnet_cov_lifetime(void);
+
+#ifdef __cplusplus
+}
+#endif /* __cplusplus */
+#endif
@@ -3,23 +3,57 @@
  * @author Steve Karg <skarg@users.sourceforge.net>
  * @date 2013
  * @brief Store properties from other BACnet devices
+ * @details The remote points are kept in a table that grows on demand,
+ *  and are found with a hash of the device, object, and property.
+ *  The Present_Value points are subscribed with the bac-cov subscription
+ *  manager when the device supports COV.  The other points, and the
+ *  points without an active subscription, are polled with
+ *  ReadPropertyMultiple batches grouped by device, or with ReadProperty
+ *  when a device does not support ReadPropertyMultiple.
  * @copyright SPDX-License-Identifier: MIT
  */
+#include <stddef.h>
 #include <stdint.h>
 #include <stdbool.h>
-#include <assert.h>
+#include <stdlib.h>
 /* BACnet Stack defines - first */
 #include "bacnet/bacdef.h"
 /* BACnet Stack API */
+#include "bacnet/bacstr.h"
+#include "bacnet/cov.h"
+#include "bacnet/rpm.h"
+#include "bacnet/basic/binding/address.h"
+#include "bacnet/basic/sys/hash_table.h"
+#include "bacnet/basic/sys/keylist.h"
 #include "bacnet/basic/sys/mstimer.h"
 /* us */
+#include "bacnet/basic/client/bac-cov.h"
 #include "bacnet/basic/client/bac-rw.h"
 #include "bacnet/basic/client/bac-data.h"
 
-/* number of objects data stored */
+/* number of remote points stored */
 #ifndef BACNET_DATA_OBJECT_MAX
-#define BACNET_DATA_OBJECT_MAX 16
+#define BACNET_DATA_OBJECT_MAX 65535UL
 #endif
+/* number of points read by one ReadPropertyMultiple request */
+#ifndef BACNET_DATA_RPM_POINTS_MAX
+#define BACNET_DATA_RPM_POINTS_MAX 16
+#endif
+/* number of ReadPropertyMultiple requests in flight */
+#ifndef BACNET_DATA_RPM_BATCHES
+#define BACNET_DATA_RPM_BATCHES 8
+#endif
+/* lifetime of the COV subscriptions in seconds, 0=polling only */
+#ifndef BACNET_DATA_COV_LIFETIME
+#define BACNET_DATA_COV_LIFETIME 300
+#endif
+/* max APDU assumed for a device that is not bound yet */
+#define BACNET_DATA_RPM_APDU_MIN 50
+/* estimated ReadPropertyMultiple-ACK bytes of each point, and of the ACK */
+#define BACNET_DATA_RPM_POINT_SIZE 16
+#define BACNET_DATA_RPM_ACK_OVERHEAD 16
+/* end of a list of points */
+#define BACNET_DATA_POINT_NONE HASH_TABLE_NONE
 /* Polling interval timer */
 static struct mstimer Object_Poll_Timer;
 /* property R/W process interval timer */
@@ -30,121 +64,385 @@ typedef struct bacnet_object_data {
     uint32_t Device_ID;
     uint16_t Object_Type;
     uint32_t Object_ID;
+    uint32_t Object_Property;
+    /* next point in the hash bucket, or in the free list */
+    uint32_t Next;
+    /* next point of the same device */
+    uint32_t Device_Next;
+    /* mstimer_now() of the last value stored */
+    unsigned long Timestamp;
     struct bacnet_present_value {
-        /* application tag data type for writing */
+        /* application tag data type of the value */
         uint8_t tag;
         union {
             bool Boolean;
             float Real;
+            double Double;
             uint32_t Unsigned_Int;
             int32_t Signed_Int;
             uint32_t Enumerated;
+            struct {
+                uint32_t value;
+                uint8_t bits_used;
+            } Bit_String;
         } type;
     } Present_Value;
+    /* subscribed to COV notifications with bac-cov */
+    bool cov;
+    bool valid;
     bool refresh;
 } BACNET_DATA_OBJECT;
-static BACNET_DATA_OBJECT Object_Table[BACNET_DATA_OBJECT_MAX];
+/* table of points, and the hash buckets of the points */
+static HASH_TABLE Object_Table;
+
+/* variables for each remote BACnet device */
+typedef struct bacnet_data_device {
+    /* list of the points of this device */
+    uint32_t Point_Head;
+    /* next point to poll, or BACNET_DATA_POINT_NONE when done */
+    uint32_t Poll_Cursor;
+    /* number of points read by one ReadPropertyMultiple, 0=not sized */
+    uint8_t RPM_Points;
+    bool RPM_Unsupported;
+} BACNET_DATA_DEVICE;
+static OS_Keylist Device_List;
+static int Device_Index;
+
+/* storage of a ReadPropertyMultiple request in flight */
+typedef struct bacnet_data_batch {
+    uint32_t Device_ID;
+    bool in_use;
+    BACNET_READ_ACCESS_DATA Read_Access_Data[BACNET_DATA_RPM_POINTS_MAX];
+    BACNET_PROPERTY_REFERENCE Property_Reference[BACNET_DATA_RPM_POINTS_MAX];
+} BACNET_DATA_BATCH;
+static BACNET_DATA_BATCH RPM_Batch[BACNET_DATA_RPM_BATCHES];
+
+static uint32_t COV_Lifetime = BACNET_DATA_COV_LIFETIME;
+
+/**
+ * @brief Hash the device, object, and property of a point
+ * @param  device_instance - object-instance number of the device object
+ * @param  object_type - object type of the object
+ * @param  object_instance - object-instance number of the object
+ * @param  object_property - property of the object
+ * @return hash of the point
+ */
+static uint32_t bacnet_data_object_hash(
+    uint32_t device_instance,
+    uint16_t object_type,
+    uint32_t object_instance,
+    uint32_t object_property)
+{
+    uint32_t hash = hash_table_key_init();
+
+    hash = hash_table_key_add(hash, device_instance);
+    hash = hash_table_key_add(hash, (uint32_t)object_type << 22);
+    hash = hash_table_key_add(hash, object_instance);
+    hash = hash_table_key_add(hash, object_property);
+
+    return hash_table_key_final(hash);
+}
+
+/**
+ * @brief Hash the device, object, and property of a point in the table
+ * @param entry - point in the table
+ * @return hash of the point
+ */
+static uint32_t bacnet_data_object_entry_hash(const void *entry)
+{
+    const BACNET_DATA_OBJECT *object = entry;
+
+    return bacnet_data_object_hash(
+        object->Device_ID, object->Object_Type, object->Object_ID,
+        object->Object_Property);
+}
+
+/**
+ * @brief Get a point in the table
+ * @param index - index of the point
+ * @return the point
+ */
+static BACNET_DATA_OBJECT *bacnet_data_object(uint32_t index)
+{
+    return hash_table_entry(&Object_Table, index);
+}
 
 /**
- * @brief Find the index of a BACnet object type of a given instance.
+ * @brief Find the index of a point
  * @param  device_instance - object-instance number of the device object
+ * @param  object_type - object type of the object
  * @param  object_instance - object-instance number of the object
- * @return The index of the object sought, or BACNET_STATUS_ERROR if
+ * @param  object_property - property of the object
+ * @return The index of the point sought, or BACNET_DATA_POINT_NONE if
  *  not found.
  */
-static int bacnet_data_object_index_find(
-    uint32_t device_instance, uint16_t object_type, uint32_t object_instance)
+static uint32_t bacnet_data_object_index_find(
+    uint32_t device_instance,
+    uint16_t object_type,
+    uint32_t object_instance,
+    uint32_t object_property)
 {
-    BACNET_DATA_OBJECT *object = NULL;
-    unsigned i = 0;
+    const BACNET_DATA_OBJECT *object;
+    uint32_t index;
 
-    for (i = 0; i < BACNET_DATA_OBJECT_MAX; i++) {
-        object = &Object_Table[i];
+    index = hash_table_first(
+        &Object_Table,
+        bacnet_data_object_hash(
+            device_instance, object_type, object_instance, object_property));
+    while (index != BACNET_DATA_POINT_NONE) {
+        object = bacnet_data_object(index);
         if ((object->Device_ID == device_instance) &&
             (object->Object_Type == object_type) &&
-            (object->Object_ID == object_instance)) {
-            return i;
+            (object->Object_ID == object_instance) &&
+            (object->Object_Property == object_property)) {
+            return index;
         }
+        index = hash_table_next(&Object_Table, index);
     }
 
-    return BACNET_STATUS_ERROR;
+    return BACNET_DATA_POINT_NONE;
 }
 
 /**
- * @brief Find a free index of an BACnet value object type
- * @return The index of a free element, or BACNET_STATUS_ERROR if
- *  no free elements exist
+ * @brief Find a remote device, and optionally add it
+ * @param device_id - device instance number
+ * @param add - true to add the device if it is not found
+ * @return the device, or NULL if not found or added
  */
-static int bacnet_data_object_index_find_free(void)
+static BACNET_DATA_DEVICE *bacnet_data_device(uint32_t device_id, bool add)
 {
-    BACNET_DATA_OBJECT *object = NULL;
-    unsigned i = 0;
+    BACNET_DATA_DEVICE *device;
 
-    for (i = 0; i < BACNET_DATA_OBJECT_MAX; i++) {
-        object = &Object_Table[i];
-        if ((object->Device_ID >= BACNET_MAX_INSTANCE) &&
-            (object->Object_Type == MAX_BACNET_OBJECT_TYPE) &&
-            (object->Object_ID >= BACNET_MAX_INSTANCE)) {
-            return i;
+    device = Keylist_Data(Device_List, device_id);
+    if (!device && add) {
+        device = calloc(1, sizeof(BACNET_DATA_DEVICE));
+        if (device) {
+            device->Point_Head = BACNET_DATA_POINT_NONE;
+            device->Poll_Cursor = BACNET_DATA_POINT_NONE;
+            if (Keylist_Data_Add(Device_List, device_id, device) < 0) {
+                free(device);
+                device = NULL;
+            }
         }
     }
 
-    return BACNET_STATUS_ERROR;
+    return device;
+}
+
+/**
+ * @brief Find a point, or add it to the table
+ * @param  device_instance - object-instance number of the device object
+ * @param  object_type - object type of the object
+ * @param  object_instance - object-instance number of the object
+ * @param  object_property - property of the object
+ * @return The index of the point, or BACNET_DATA_POINT_NONE if the
+ *  point is not found and cannot be added
+ */
+static uint32_t bacnet_data_object_index_add(
+    uint32_t device_instance,
+    uint16_t object_type,
+    uint32_t object_instance,
+    uint32_t object_property)
+{
+    BACNET_DATA_DEVICE *device;
+    BACNET_DATA_OBJECT *object;
+    uint32_t index;
+
+    index = bacnet_data_object_index_find(
+        device_instance, object_type, object_instance, object_property);
+    if (index != BACNET_DATA_POINT_NONE) {
+        return index;
+    }
+    device = bacnet_data_device(device_instance, true);
+    if (!device) {
+        return BACNET_DATA_POINT_NONE;
+    }
+    index = hash_table_add(
+        &Object_Table,
+        bacnet_data_object_hash(
+            device_instance, object_type, object_instance, object_property));
+    if (index == BACNET_DATA_POINT_NONE) {
+        return BACNET_DATA_POINT_NONE;
+    }
+    object = bacnet_data_object(index);
+    object->Device_ID = device_instance;
+    object->Object_Type = object_type;
+    object->Object_ID = object_instance;
+    object->Object_Property = object_property;
+    object->Timestamp = 0;
+    object->Present_Value.tag = BACNET_APPLICATION_TAG_NULL;
+    object->cov = false;
+    object->valid = false;
+    object->refresh = true;
+    object->Device_Next = device->Point_Head;
+    device->Point_Head = index;
+    /* the new point is ahead of the cursor - the points between them
+       that were already polled are skipped */
+    device->Poll_Cursor = index;
+
+    return index;
 }
 
 /**
- * @brief Initializes the BACnet object data
+ * @brief Initializes the BACnet object data, and frees the points
+ *  of a previous initialization
  */
 static void bacnet_data_object_init(void)
 {
-    unsigned i = 0;
-    BACNET_DATA_OBJECT *object = NULL;
+    BACNET_DATA_DEVICE *device;
+    unsigned i;
 
-    for (i = 0; i < BACNET_DATA_OBJECT_MAX; i++) {
-        object = &Object_Table[i];
-        object->Device_ID = BACNET_MAX_INSTANCE;
-        object->Object_Type = MAX_BACNET_OBJECT_TYPE;
-        object->Object_ID = BACNET_MAX_INSTANCE;
+    hash_table_cleanup(&Object_Table);
+    hash_table_init(
+        &Object_Table, sizeof(BACNET_DATA_OBJECT),
+        offsetof(BACNET_DATA_OBJECT, Next), BACNET_DATA_OBJECT_MAX,
+        bacnet_data_object_entry_hash);
+    if (Device_List) {
+        do {
+            device = Keylist_Data_Pop(Device_List);
+            free(device);
+        } while (device);
+    } else {
+        Device_List = Keylist_Create();
+    }
+    Device_Index = 0;
+    for (i = 0; i < BACNET_DATA_RPM_BATCHES; i++) {
+        RPM_Batch[i].in_use = false;
     }
 }
 
+/**
+ * @brief Store a value in a point
+ * @param object - point to store the value
+ * @param value - value to store
+ */
 static void bacnet_data_object_store(
-    int index,
-    const BACNET_READ_PROPERTY_DATA *rp_data,
-    const BACNET_APPLICATION_DATA_VALUE *value)
-{
-    BACNET_DATA_OBJECT *object = NULL;
-
-    assert(rp_data != NULL);
-    assert(value != NULL);
-    if ((index < BACNET_DATA_OBJECT_MAX) && (!value->context_specific)) {
-        object = &Object_Table[index];
-        switch (rp_data->object_property) {
-            case PROP_PRESENT_VALUE:
-                if (value->tag == BACNET_APPLICATION_TAG_REAL) {
-                    object->Present_Value.tag = value->tag;
-                    object->Present_Value.type.Real = value->type.Real;
-                }
-                if (value->tag == BACNET_APPLICATION_TAG_UNSIGNED_INT) {
-                    object->Present_Value.tag = value->tag;
-                    object->Present_Value.type.Unsigned_Int =
-                        value->type.Unsigned_Int;
+    BACNET_DATA_OBJECT *object, const BACNET_APPLICATION_DATA_VALUE *value)
+{
+    uint8_t i, bits_used;
+
+    if (value->context_specific) {
+        return;
+    }
+    switch (value->tag) {
+        case BACNET_APPLICATION_TAG_NULL:
+            break;
+        case BACNET_APPLICATION_TAG_BOOLEAN:
+            object->Present_Value.type.Boolean = value->type.Boolean;
+            break;
+        case BACNET_APPLICATION_TAG_REAL:
+            object->Present_Value.type.Real = value->type.Real;
+            break;
+        case BACNET_APPLICATION_TAG_DOUBLE:
+            object->Present_Value.type.Double = value->type.Double;
+            break;
+        case BACNET_APPLICATION_TAG_UNSIGNED_INT:
+            object->Present_Value.type.Unsigned_Int =
+                (uint32_t)value->type.Unsigned_Int;
+            break;
+        case BACNET_APPLICATION_TAG_SIGNED_INT:
+            object->Present_Value.type.Signed_Int = value->type.Signed_Int;
+            break;
+        case BACNET_APPLICATION_TAG_ENUMERATED:
+            object->Present_Value.type.Enumerated = value->type.Enumerated;
+            break;
+        case BACNET_APPLICATION_TAG_BIT_STRING:
+            bits_used = bitstring_bits_used(&value->type.Bit_String);
+            if (bits_used > 32) {
+                bits_used = 32;
+            }
+            object->Present_Value.type.Bit_String.value = 0;
+            object->Present_Value.type.Bit_String.bits_used = bits_used;
+            for (i = 0; i < bits_used; i++) {
+                if (bitstring_bit(&value->type.Bit_String, i)) {
+                    object->Present_Value.type.Bit_String.value |= 1UL << i;
                 }
-                if (value->tag == BACNET_APPLICATION_TAG_ENUMERATED) {
-                    object->Present_Value.tag = value->tag;
-                    object->Present_Value.type.Enumerated =
-                        value->type.Enumerated;
+            }
+            break;
+        default:
+            /* not a data type that is stored */
+            return;
+    }
+    object->Present_Value.tag = value->tag;
+    object->Timestamp = mstimer_now();
+    object->valid = true;
+}
+
+/**
+ * @brief Determine if the COV subscription of a point is active,
+ *  so that the Present_Value and Status_Flags are not polled
+ * @param object - point to test
+ * @return true if the point is kept up to date by COV notifications
+ */
+static bool bacnet_data_object_cov_active(const BACNET_DATA_OBJECT *object)
+{
+    uint32_t index;
+
+    if (object->Object_Property == PROP_STATUS_FLAGS) {
+        index = bacnet_data_object_index_find(
+            object->Device_ID, object->Object_Type, object->Object_ID,
+            PROP_PRESENT_VALUE);
+        if (index == BACNET_DATA_POINT_NONE) {
+            return false;
+        }
+        object = bacnet_data_object(index);
+    } else if (object->Object_Property != PROP_PRESENT_VALUE) {
+        return false;
+    }
+
+    return object->cov &&
+        (bacnet_cov_status(
+             object->Device_ID, (BACNET_OBJECT_TYPE)object->Object_Type,
+             object->Object_ID) == BACNET_COV_STATUS_ACTIVE);
+}
+
+/**
+ * @brief Handle an error reading a point
+ * @param device_instance - device instance number where the error originated
+ * @param rp_data - object, property, and error of the read
+ */
+static void bacnet_data_object_error(
+    uint32_t device_instance, const BACNET_READ_PROPERTY_DATA *rp_data)
+{
+    BACNET_DATA_DEVICE *device;
+    uint32_t index;
+
+    device = bacnet_data_device(device_instance, false);
+    if (!device) {
+        return;
+    }
+    if (rp_data->error_class == ERROR_CLASS_SERVICES) {
+        switch (rp_data->error_code) {
+            case ERROR_CODE_REJECT_UNRECOGNIZED_SERVICE:
+                /* poll this device with ReadProperty */
+                device->RPM_Unsupported = true;
+                break;
+            case ERROR_CODE_ABORT_SEGMENTATION_NOT_SUPPORTED:
+            case ERROR_CODE_ABORT_BUFFER_OVERFLOW:
+            case ERROR_CODE_ABORT_APDU_TOO_LONG:
+                /* the reply did not fit - use smaller batches */
+                if (device->RPM_Points > 1) {
+                    device->RPM_Points /= 2;
                 }
                 break;
             default:
                 break;
         }
-        object->refresh = false;
+    } else {
+        /* the object or property is in error - not a valid value */
+        index = bacnet_data_object_index_find(
+            device_instance, rp_data->object_type, rp_data->object_instance,
+            rp_data->object_property);
+        if (index != BACNET_DATA_POINT_NONE) {
+            bacnet_data_object(index)->valid = false;
+        }
     }
 }
 
 /**
- * @brief Find the index of an analog value object type of a given instance.
+ * @brief Save the value of a point from a ReadProperty or
+ *  ReadPropertyMultiple acknowledgment.
+ * @param device_instance - device instance number where the data originated
  * @param rp_data [in] Pointer to the BACNET_READ_PROPERTY_DATA structure,
  *  which is packed with the information from the ReadProperty request.
  * @param value [in] pointer to the BACNET_APPLICATION_DATA_VALUE structure
@@ -155,51 +453,471 @@ void bacnet_data_value_save(
     BACNET_READ_PROPERTY_DATA *rp_data,
     BACNET_APPLICATION_DATA_VALUE *value)
 {
-    int index = 0;
+    uint32_t index;
 
     if (!rp_data) {
         return;
     }
-    if (rp_data->error_code != ERROR_CODE_SUCCESS) {
+    if ((rp_data->error_code != ERROR_CODE_SUCCESS) || !value) {
+        bacnet_data_object_error(device_instance, rp_data);
+        return;
+    }
+    index = bacnet_data_object_index_find(
+        device_instance, rp_data->object_type, rp_data->object_instance,
+        rp_data->object_property);
+    if (index != BACNET_DATA_POINT_NONE) {
+        bacnet_data_object_store(bacnet_data_object(index), value);
+    }
+}
+
+/**
+ * @brief Save the values of the points from a COV notification
+ * @param cov_data - the decoded COV notification
+ * @param context - not used
+ */
+static void
+bacnet_data_cov_notification(BACNET_COV_DATA *cov_data, void *context)
+{
+    BACNET_PROPERTY_VALUE *property_value;
+    uint32_t index;
+
+    (void)context;
+    property_value = cov_data->listOfValues;
+    while (property_value) {
+        index = bacnet_data_object_index_find(
+            cov_data->initiatingDeviceIdentifier,
+            cov_data->monitoredObjectIdentifier.type,
+            cov_data->monitoredObjectIdentifier.instance,
+            property_value->propertyIdentifier);
+        if ((index != BACNET_DATA_POINT_NONE) &&
+            (property_value->propertyArrayIndex == BACNET_ARRAY_ALL)) {
+            bacnet_data_object_store(
+                bacnet_data_object(index), &property_value->value);
+        }
+        property_value = property_value->next;
+    }
+}
+
+/**
+ * @brief Get the number of points read by one ReadPropertyMultiple
+ *  request to a device, from the max APDU of both devices
+ * @param device_id - device instance number
+ * @param device - device data
+ * @return number of points
+ */
+static unsigned
+bacnet_data_rpm_points(uint32_t device_id, BACNET_DATA_DEVICE *device)
+{
+    BACNET_ADDRESS dest;
+    unsigned max_apdu = 0;
+    unsigned points;
+
+    if (device->RPM_Points > 0) {
+        return device->RPM_Points;
+    }
+    if (!address_get_by_device(device_id, &max_apdu, &dest)) {
+        /* not bound yet - use the smallest APDU until it is */
+        max_apdu = BACNET_DATA_RPM_APDU_MIN;
+    }
+    if (max_apdu > MAX_APDU) {
+        max_apdu = MAX_APDU;
+    }
+    points = 1;
+    if (max_apdu > BACNET_DATA_RPM_ACK_OVERHEAD) {
+        points = (max_apdu - BACNET_DATA_RPM_ACK_OVERHEAD) /
+            BACNET_DATA_RPM_POINT_SIZE;
+    }
+    if (points < 1) {
+        points = 1;
+    } else if (points > BACNET_DATA_RPM_POINTS_MAX) {
+        points = BACNET_DATA_RPM_POINTS_MAX;
+    }
+    if (max_apdu != BACNET_DATA_RPM_APDU_MIN) {
+        device->RPM_Points = (uint8_t)points;
+    }
+
+    return points;
+}
+
+/**
+ * @brief Find the storage of a free ReadPropertyMultiple request,
+ *  and free the storage of the requests that are finished
+ * @return storage of a free request, or NULL if none are free
+ */
+static BACNET_DATA_BATCH *bacnet_data_batch_free(void)
+{
+    BACNET_DATA_BATCH *batch, *free_batch = NULL;
+    unsigned i;
+
+    for (i = 0; i < BACNET_DATA_RPM_BATCHES; i++) {
+        batch = &RPM_Batch[i];
+        if (batch->in_use && bacnet_read_write_device_idle(batch->Device_ID)) {
+            batch->in_use = false;
+        }
+        if (!batch->in_use && !free_batch) {
+            free_batch = batch;
+        }
+    }
+
+    return free_batch;
+}
+
+/**
+ * @brief Add a point to a ReadPropertyMultiple request.  A point of the
+ *  same object as the previous point is added to the same object.
+ * @param batch - request storage
+ * @param count - number of points already in the request
+ * @param object - point to add
+ */
+static void bacnet_data_batch_add(
+    BACNET_DATA_BATCH *batch, unsigned count, const BACNET_DATA_OBJECT *object)
+{
+    BACNET_PROPERTY_REFERENCE *reference;
+    BACNET_READ_ACCESS_DATA *rad;
+
+    reference = &batch->Property_Reference[count];
+    reference->propertyIdentifier = object->Object_Property;
+    reference->propertyArrayIndex = BACNET_ARRAY_ALL;
+    reference->value = NULL;
+    reference->error.error_class = ERROR_CLASS_DEVICE;
+    reference->error.error_code = ERROR_CODE_OTHER;
+    reference->next = NULL;
+    if (count > 0) {
+        rad = &batch->Read_Access_Data[0];
+        while (rad->next) {
+            rad = rad->next;
+        }
+        if ((rad->object_type == object->Object_Type) &&
+            (rad->object_instance == object->Object_ID)) {
+            batch->Property_Reference[count - 1].next = reference;
+            return;
+        }
+        rad->next = &batch->Read_Access_Data[count];
+    }
+    rad = &batch->Read_Access_Data[count];
+    rad->object_type = object->Object_Type;
+    rad->object_instance = object->Object_ID;
+    rad->listOfProperties = reference;
+    rad->next = NULL;
+}
+
+/**
+ * @brief Subscribe, and poll the points of a device that are due,
+ *  starting at the poll cursor of the device
+ * @param device_id - device instance number
+ * @param device - device data
+ */
+static void
+bacnet_data_device_process(uint32_t device_id, BACNET_DATA_DEVICE *device)
+{
+    BACNET_DATA_BATCH *batch = NULL;
+    BACNET_DATA_OBJECT *object;
+    uint32_t index, start;
+    unsigned count = 0, points = 1;
+    bool queued;
+
+    if (device->Poll_Cursor == BACNET_DATA_POINT_NONE) {
         return;
     }
+    if (!device->RPM_Unsupported) {
+        batch = bacnet_data_batch_free();
+        if (!batch) {
+            return;
+        }
+        points = bacnet_data_rpm_points(device_id, device);
+    }
+    start = device->Poll_Cursor;
+    index = start;
+    while ((index != BACNET_DATA_POINT_NONE) && (count < points)) {
+        object = bacnet_data_object(index);
+        if ((COV_Lifetime > 0) && !object->cov &&
+            (object->Object_Property == PROP_PRESENT_VALUE)) {
+            object->cov = bacnet_cov_subscribe(
+                device_id, (BACNET_OBJECT_TYPE)object->Object_Type,
+                object->Object_ID, bacnet_data_cov_notification, NULL);
+        }
+        if (object->refresh && !bacnet_data_object_cov_active(object)) {
+            if (batch) {
+                bacnet_data_batch_add(batch, count, object);
+            } else if (!bacnet_read_property_queue(
+                           device_id, (BACNET_OBJECT_TYPE)object->Object_Type,
+                           object->Object_ID,
+                           (BACNET_PROPERTY_ID)object->Object_Property,
+                           BACNET_ARRAY_ALL)) {
+                break;
+            }
+            count++;
+        }
+        object->refresh = false;
+        index = object->Device_Next;
+    }
+    device->Poll_Cursor = index;
+    if (batch && (count > 0)) {
+        queued = bacnet_read_property_multiple_queue(
+            device_id, &batch->Read_Access_Data[0]);
+        if (queued) {
+            batch->Device_ID = device_id;
+            batch->in_use = true;
+        } else {
+            /* try these points again when the queue has room */
+            index = start;
+            while (index != device->Poll_Cursor) {
+                object = bacnet_data_object(index);
+                object->refresh = true;
+                index = object->Device_Next;
+            }
+            device->Poll_Cursor = start;
+        }
+    }
+}
+
+/**
+ * @brief Process the devices, one after the other, until the
+ *  request queue is full or every device had its turn
+ */
+static void bacnet_data_devices_process(void)
+{
+    BACNET_DATA_DEVICE *device;
+    KEY device_id = 0;
+    int count, i;
+
+    count = Keylist_Count(Device_List);
+    for (i = 0; i < count; i++) {
+        if (bacnet_read_write_busy()) {
+            break;
+        }
+        if (Device_Index >= count) {
+            Device_Index = 0;
+        }
+        device = Keylist_Data_Index(Device_List, Device_Index);
+        if (device &&
+            Keylist_Index_Key(Device_List, Device_Index, &device_id)) {
+            bacnet_data_device_process(device_id, device);
+        }
+        Device_Index++;
+    }
+}
+
+/**
+ * @brief Flag every point to be polled, and restart the poll of
+ *  every device at its first point
+ */
+static void bacnet_data_poll_refresh(void)
+{
+    BACNET_DATA_DEVICE *device;
+    uint32_t i;
+    int count, d;
+
+    for (i = 0; i < hash_table_used(&Object_Table); i++) {
+        bacnet_data_object(i)->refresh = true;
+    }
+    count = Keylist_Count(Device_List);
+    for (d = 0; d < count; d++) {
+        device = Keylist_Data_Index(Device_List, d);
+        if (device) {
+            device->Poll_Cursor = device->Point_Head;
+        }
+    }
+}
+
+/**
+ * @brief Adds a BACnet Data remote point of any property.
+ *  A Present_Value point is kept up to date with a COV subscription
+ *  when the device supports COV, and polled otherwise.  The other
+ *  properties are polled.
+ * @param device_id - ID of the destination device
+ * @param object_type - Type of the object whose property is to be read.
+ * @param object_instance - Instance # of the object to be read.
+ * @param object_property - Property to be read, but not ALL, REQUIRED, or
+ *  OPTIONAL.
+ * @return true if added or existing, false if not added or existing
+ */
+bool bacnet_data_point_add(
+    uint32_t device_id,
+    BACNET_OBJECT_TYPE object_type,
+    uint32_t object_instance,
+    BACNET_PROPERTY_ID object_property)
+{
+    if ((device_id >= BACNET_MAX_INSTANCE) ||
+        (object_type >= MAX_BACNET_OBJECT_TYPE) ||
+        (object_instance >= BACNET_MAX_INSTANCE) ||
+        (object_property == PROP_ALL) || (object_property == PROP_REQUIRED) ||
+        (object_property == PROP_OPTIONAL)) {
+        return false;
+    }
+
+    return bacnet_data_object_index_add(
+               device_id, object_type, object_instance, object_property) !=
+        BACNET_DATA_POINT_NONE;
+}
+
+/**
+ * @brief Removes a BACnet Data remote point, and cancels its
+ *  COV subscription
+ * @param device_id - ID of the destination device
+ * @param object_type - Type of the object
+ * @param object_instance - Instance # of the object
+ * @param object_property - Property of the object
+ * @return true if removed, false if not found
+ */
+bool bacnet_data_point_remove(
+    uint32_t device_id,
+    BACNET_OBJECT_TYPE object_type,
+    uint32_t object_instance,
+    BACNET_PROPERTY_ID object_property)
+{
+    BACNET_DATA_DEVICE *device;
+    BACNET_DATA_OBJECT *object;
+    uint32_t index, *link;
+
+    index = bacnet_data_object_index_find(
+        device_id, object_type, object_instance, object_property);
+    if (index == BACNET_DATA_POINT_NONE) {
+        return false;
+    }
+    object = bacnet_data_object(index);
+    device = bacnet_data_device(device_id, false);
+    if (device) {
+        link = &device->Point_Head;
+        while (*link != index) {
+            link = &bacnet_data_object(*link)->Device_Next;
+        }
+        *link = object->Device_Next;
+        if (device->Poll_Cursor == index) {
+            device->Poll_Cursor = object->Device_Next;
+        }
+    }
+    if (object->cov) {
+        bacnet_cov_unsubscribe(
+            device_id, object_type, object_instance,
+            bacnet_data_cov_notification, NULL);
+    }
+    (void)hash_table_remove(
+        &Object_Table,
+        bacnet_data_object_hash(
+            device_id, object_type, object_instance, object_property),
+        index);
+    object->Device_ID = BACNET_MAX_INSTANCE;
+    object->Object_Type = MAX_BACNET_OBJECT_TYPE;
+    object->Object_ID = BACNET_MAX_INSTANCE;
+
+    return true;
+}
+
+/**
+ * @brief Gets the last value stored for a remote point
+ * @param device_id - ID of the destination device
+ * @param object_type - Type of the object
+ * @param object_instance - Instance # of the object
+ * @param object_property - Property of the object
+ * @param value [out] the value stored, if valid
+ * @return true if the point is found and has a valid value
+ */
+bool bacnet_data_point_value(
+    uint32_t device_id,
+    BACNET_OBJECT_TYPE object_type,
+    uint32_t object_instance,
+    BACNET_PROPERTY_ID object_property,
+    BACNET_APPLICATION_DATA_VALUE *value)
+{
+    const BACNET_DATA_OBJECT *object;
+    uint32_t index;
+    uint8_t i;
+
+    index = bacnet_data_object_index_find(
+        device_id, object_type, object_instance, object_property);
+    if (index == BACNET_DATA_POINT_NONE) {
+        return false;
+    }
+    object = bacnet_data_object(index);
+    if (!object->valid) {
+        return false;
+    }
     if (value) {
-        switch (rp_data->object_type) {
-            case OBJECT_ANALOG_INPUT:
-            case OBJECT_ANALOG_OUTPUT:
-            case OBJECT_ANALOG_VALUE:
-            case OBJECT_BINARY_INPUT:
-            case OBJECT_BINARY_OUTPUT:
-            case OBJECT_BINARY_VALUE:
-            case OBJECT_MULTI_STATE_INPUT:
-            case OBJECT_MULTI_STATE_OUTPUT:
-            case OBJECT_MULTI_STATE_VALUE:
-                index = bacnet_data_object_index_find(
-                    device_instance, rp_data->object_type,
-                    rp_data->object_instance);
-                if (index != BACNET_STATUS_ERROR) {
-                    bacnet_data_object_store(index, rp_data, value);
+        bacapp_value_list_init(value, 1);
+        value->tag = object->Present_Value.tag;
+        switch (object->Present_Value.tag) {
+            case BACNET_APPLICATION_TAG_BOOLEAN:
+                value->type.Boolean = object->Present_Value.type.Boolean;
+                break;
+            case BACNET_APPLICATION_TAG_REAL:
+                value->type.Real = object->Present_Value.type.Real;
+                break;
+            case BACNET_APPLICATION_TAG_DOUBLE:
+                value->type.Double = object->Present_Value.type.Double;
+                break;
+            case BACNET_APPLICATION_TAG_UNSIGNED_INT:
+                value->type.Unsigned_Int =
+                    object->Present_Value.type.Unsigned_Int;
+                break;
+            case BACNET_APPLICATION_TAG_SIGNED_INT:
+                value->type.Signed_Int = object->Present_Value.type.Signed_Int;
+                break;
+            case BACNET_APPLICATION_TAG_ENUMERATED:
+                value->type.Enumerated = object->Present_Value.type.Enumerated;
+                break;
+            case BACNET_APPLICATION_TAG_BIT_STRING:
+                bitstring_init(&value->type.Bit_String);
+                for (i = 0; i < object->Present_Value.type.Bit_String.bits_used;
+                     i++) {
+                    bitstring_set_bit(
+                        &value->type.Bit_String, i,
+                        (object->Present_Value.type.Bit_String.value &
+                         (1UL << i)) != 0);
                 }
                 break;
-            case OBJECT_DEVICE:
             default:
                 break;
         }
     }
+
+    return true;
 }
 
 /**
- * @brief Handles the BACnet Data Analog Value processing
- * @param object - BACnet object structure data pointer
+ * @brief Determines if the value of a remote point is out of date.
+ *  A point is up to date while its COV subscription is active, or
+ *  for two poll intervals after its value was stored.
+ * @param device_id - ID of the destination device
+ * @param object_type - Type of the object
+ * @param object_instance - Instance # of the object
+ * @param object_property - Property of the object
+ * @return true if the point is not found, has no valid value, or
+ *  the value is out of date
  */
-static void bacnet_data_object_process(const BACNET_DATA_OBJECT *object)
+bool bacnet_data_point_stale(
+    uint32_t device_id,
+    BACNET_OBJECT_TYPE object_type,
+    uint32_t object_instance,
+    BACNET_PROPERTY_ID object_property)
 {
-    if (object && (object->Device_ID < BACNET_MAX_INSTANCE) &&
-        (object->Object_ID < BACNET_MAX_INSTANCE)) {
-        bacnet_read_property_queue(
-            object->Device_ID, (BACNET_OBJECT_TYPE)object->Object_Type,
-            object->Object_ID, PROP_PRESENT_VALUE, BACNET_ARRAY_ALL);
+    const BACNET_DATA_OBJECT *object;
+    uint32_t index;
+
+    index = bacnet_data_object_index_find(
+        device_id, object_type, object_instance, object_property);
+    if (index == BACNET_DATA_POINT_NONE) {
+        return true;
     }
+    object = bacnet_data_object(index);
+    if (!object->valid) {
+        return true;
+    }
+    if (bacnet_data_object_cov_active(object)) {
+        return false;
+    }
+
+    return (mstimer_now() - object->Timestamp) >
+        (2UL * mstimer_interval(&Object_Poll_Timer));
+}
+
+/**
+ * @brief Gets the number of remote points stored
+ * @return number of remote points
+ */
+unsigned long bacnet_data_point_count(void)
+{
+    return hash_table_count(&Object_Table);
 }
 
 /**
@@ -214,9 +932,7 @@ bool bacnet_data_object_add(
     BACNET_OBJECT_TYPE object_type,
     uint32_t object_instance)
 {
-    BACNET_DATA_OBJECT *object = NULL;
     bool status = false;
-    int index = 0;
 
     switch (object_type) {
         case OBJECT_ANALOG_INPUT:
@@ -228,23 +944,8 @@ bool bacnet_data_object_add(
         case OBJECT_MULTI_STATE_INPUT:
         case OBJECT_MULTI_STATE_OUTPUT:
         case OBJECT_MULTI_STATE_VALUE:
-            index = bacnet_data_object_index_find(
-                device_id, object_type, object_instance);
-            if (index == BACNET_STATUS_ERROR) {
-                index = bacnet_data_object_index_find_free();
-                if (index != BACNET_STATUS_ERROR) {
-                    object = &Object_Table[index];
-                    object->Device_ID = device_id;
-                    object->Object_Type = object_type;
-                    object->Object_ID = object_instance;
-                    object->refresh = true;
-                    status = true;
-                }
-            } else {
-                object = &Object_Table[index];
-                object->refresh = true;
-                status = true;
-            }
+            status = bacnet_data_point_add(
+                device_id, object_type, object_instance, PROP_PRESENT_VALUE);
             break;
         case OBJECT_DEVICE:
         default:
@@ -269,18 +970,18 @@ bool bacnet_data_analog_present_value(
     float *float_value)
 {
     bool status = false;
-    int index = 0;
-    BACNET_DATA_OBJECT *object = NULL;
+    uint32_t index;
+    const BACNET_DATA_OBJECT *object = NULL;
 
-    index =
-        bacnet_data_object_index_find(device_id, object_type, object_instance);
-    if (index == BACNET_STATUS_ERROR) {
+    index = bacnet_data_object_index_find(
+        device_id, object_type, object_instance, PROP_PRESENT_VALUE);
+    if (index == BACNET_DATA_POINT_NONE) {
         /* add to our object table if not found */
         bacnet_data_object_add(device_id, object_type, object_instance);
     } else {
         status = true;
         if (float_value) {
-            object = &Object_Table[index];
+            object = bacnet_data_object(index);
             *float_value = object->Present_Value.type.Real;
         }
     }
@@ -303,19 +1004,19 @@ bool bacnet_data_binary_present_value(
     bool *bool_value)
 {
     bool status = false;
-    int index = 0;
-    BACNET_DATA_OBJECT *object = NULL;
+    uint32_t index;
+    const BACNET_DATA_OBJECT *object = NULL;
 
-    index =
-        bacnet_data_object_index_find(device_id, object_type, object_instance);
-    if (index == BACNET_STATUS_ERROR) {
+    index = bacnet_data_object_index_find(
+        device_id, object_type, object_instance, PROP_PRESENT_VALUE);
+    if (index == BACNET_DATA_POINT_NONE) {
         /* add to our object table if not found */
         bacnet_data_object_add(
             device_id, (BACNET_OBJECT_TYPE)object_type, object_instance);
     } else {
         status = true;
         if (bool_value) {
-            object = &Object_Table[index];
+            object = bacnet_data_object(index);
             if (object->Present_Value.type.Enumerated == BINARY_INACTIVE) {
                 *bool_value = false;
             } else {
@@ -342,19 +1043,19 @@ bool bacnet_data_multistate_present_value(
     uint32_t *unsigned_value)
 {
     bool status = false;
-    int index = 0;
-    BACNET_DATA_OBJECT *object = NULL;
+    uint32_t index;
+    const BACNET_DATA_OBJECT *object = NULL;
 
-    index =
-        bacnet_data_object_index_find(device_id, object_type, object_instance);
-    if (index == BACNET_STATUS_ERROR) {
+    index = bacnet_data_object_index_find(
+        device_id, object_type, object_instance, PROP_PRESENT_VALUE);
+    if (index == BACNET_DATA_POINT_NONE) {
         /* add to our object table if not found */
         bacnet_data_object_add(
             device_id, (BACNET_OBJECT_TYPE)object_type, object_instance);
     } else {
         status = true;
         if (unsigned_value) {
-            object = &Object_Table[index];
+            object = bacnet_data_object(index);
             *unsigned_value = object->Present_Value.type.Unsigned_Int;
         }
     }
@@ -367,32 +1068,16 @@ bool bacnet_data_multistate_present_value(
  */
 void bacnet_data_task(void)
 {
-    static unsigned object_index = 0;
-    BACNET_DATA_OBJECT *object = NULL;
-    unsigned i = 0;
-
     if (mstimer_expired(&Object_Poll_Timer)) {
         mstimer_reset(&Object_Poll_Timer);
-        for (i = 0; i < BACNET_DATA_OBJECT_MAX; i++) {
-            object = &Object_Table[i];
-            object->refresh = true;
-        }
+        bacnet_data_poll_refresh();
     }
     if (mstimer_expired(&Read_Write_Timer)) {
         mstimer_reset(&Read_Write_Timer);
         bacnet_read_write_task();
     }
-    if (bacnet_read_write_idle()) {
-        object = &Object_Table[object_index];
-        if (object->refresh) {
-            object->refresh = false;
-            bacnet_data_object_process(object);
-        }
-        object_index++;
-        if (object_index >= BACNET_DATA_OBJECT_MAX) {
-            object_index = 0;
-        }
-    }
+    bacnet_cov_task();
+    bacnet_data_devices_process();
 }
 
 /**
@@ -410,7 +1095,28 @@ void bacnet_data_poll_seconds_set(unsigned int seconds)
  */
 unsigned int bacnet_data_poll_seconds(void)
 {
-    return mstimer_interval(&Object_Poll_Timer) * 1000;
+    return mstimer_interval(&Object_Poll_Timer) / 1000;
+}
+
+/**
+ * @brief Set the lifetime of the COV subscriptions of the
+ *  Present_Value points.  The lifetime should be longer than the
+ *  poll interval, which is when the subscriptions are renewed.
+ * @param seconds - lifetime in seconds, or 0 to poll every point
+ */
+void bacnet_data_cov_lifetime_set(uint32_t seconds)
+{
+    COV_Lifetime = seconds;
+    bacnet_cov_lifetime_set(seconds);
+}
+
+/**
+ * @brief Get the lifetime of the COV subscriptions
+ * @return lifetime in seconds, or 0 if every point is polled
+ */
+uint32_t bacnet_data_cov_lifetime(void)
+{
+    return COV_Lifetime;
 }
 
 /**
@@ -424,4 +1130,6 @@ void bacnet_data_init(void)
     mstimer_set(&Object_Poll_Timer, 1 * 60 * 1000);
     mstimer_set(&Read_Write_Timer, 10);
     bacnet_read_write_value_callback_set(bacnet_data_value_save);
+    bacnet_cov_init();
+    bacnet_cov_lifetime_set(COV_Lifetime);
 }
@@ -40,6 +40,37 @@ void bacnet_data_value_save(
     BACNET_READ_PROPERTY_DATA *rp_data,
     BACNET_APPLICATION_DATA_VALUE *value);
 BACNET_STACK_EXPORT
+void bacnet_data_cov_lifetime_set(uint32_t seconds);
+BACNET_STACK_EXPORT
+uint32_t bacnet_data_cov_lifetime(void);
+BACNET_STACK_EXPORT
+bool bacnet_data_point_add(
+    uint32_t device_id,
+    BACNET_OBJECT_TYPE object_type,
+    uint32_t object_instance,
+    BACNET_PROPERTY_ID object_property);
+BACNET_STACK_EXPORT
+bool bacnet_data_point_remove(
+    uint32_t device_id,
+    BACNET_OBJECT_TYPE object_type,
+    uint32_t object_instance,
+    BACNET_PROPERTY_ID object_property);
+BACNET_STACK_EXPORT
+bool bacnet_data_point_value(
+    uint32_t device_id,
+    BACNET_OBJECT_TYPE object_type,
+    uint32_t object_instance,
+    BACNET_PROPERTY_ID object_property,
+    BACNET_APPLICATION_DATA_VALUE *value);
+BACNET_STACK_EXPORT
+bool bacnet_data_point_stale(
+    uint32_t device_id,
+    BACNET_OBJECT_TYPE object_type,
+    uint32_t object_instance,
+    BACNET_PROPERTY_ID object_property);
+BACNET_STACK_EXPORT
+unsigned long bacnet_data_point_count(void);
+BACNET_STACK_EXPORT
 bool bacnet_data_object_add(
     uint32_t device_id,
     BACNET_OBJECT_TYPE object_type,
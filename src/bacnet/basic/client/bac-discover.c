@@ -35,10 +35,25 @@ static OS_Keylist Device_List = NULL;
 static uint16_t Target_DNET = 0;
 /* re-discovery time */
 static unsigned long Discovery_Milliseconds;
+/* discover with ReadPropertyMultiple, many devices at a time */
+static bool Discovery_RPM = true;
+/* most objects read with PROP_ALL in one ReadPropertyMultiple */
+#ifndef BACNET_DISCOVER_RPM_OBJECTS_MAX
+#define BACNET_DISCOVER_RPM_OBJECTS_MAX 16
+#endif
+/* encoded size of an object-list element in a ReadPropertyMultiple-ACK:
+   property identifier, array index, opening and closing tags, object id */
+#define BACNET_DISCOVER_RPM_OBJECT_LIST_ELEMENT_SIZE 13
+/* encoded size of a ReadPropertyMultiple-ACK without its results */
+#define BACNET_DISCOVER_RPM_ACK_OVERHEAD 16
+/* smallest maximum APDU that any BACnet device accepts */
+#define BACNET_DISCOVER_RPM_APDU_MIN 50
 /* states of discovery */
 typedef enum bacnet_discover_state_enum {
     BACNET_DISCOVER_STATE_INIT = 0,
     BACNET_DISCOVER_STATE_BINDING,
+    BACNET_DISCOVER_STATE_DATABASE_REVISION_REQUEST,
+    BACNET_DISCOVER_STATE_DATABASE_REVISION_RESPONSE,
     BACNET_DISCOVER_STATE_OBJECT_LIST_SIZE_REQUEST,
     BACNET_DISCOVER_STATE_OBJECT_LIST_SIZE_RESPONSE,
     BACNET_DISCOVER_STATE_OBJECT_LIST_REQUEST,
@@ -70,6 +85,21 @@ typedef struct bacnet_device_data_t {
     struct mstimer Discovery_Timer;
     unsigned long Discovery_Elapsed_Milliseconds;
     BACNET_DISCOVER_STATE Discovery_State;
+    /* used for discovering with ReadPropertyMultiple */
+    bool RPM_Disabled;
+    unsigned Max_APDU;
+    uint32_t Object_List_Per_Request;
+    uint32_t Objects_Per_Request;
+    /* number of object-list elements or objects in the request */
+    uint32_t Batch_Count;
+    BACNET_READ_ACCESS_DATA *Read_Access_Data;
+    unsigned Read_Access_Data_Size;
+    BACNET_PROPERTY_REFERENCE *Property_Reference;
+    unsigned Property_Reference_Size;
+    /* used for rediscovering only when the database changes */
+    uint32_t Database_Revision;
+    bool Database_Revision_Valid;
+    bool Database_Revision_Unchanged;
 } BACNET_DEVICE_DATA;
 
 /**
@@ -246,6 +276,8 @@ void bacnet_discover_cleanup(void)
         data = Keylist_Data_Pop(Device_List);
         if (data) {
             bacnet_object_data_cleanup(data->Object_List);
+            free(data->Read_Access_Data);
+            free(data->Property_Reference);
             free(data);
         }
     } while (data);
@@ -347,6 +379,10 @@ size_t bacnet_discover_device_memory(uint32_t device_id)
     device = Keylist_Data(Device_List, key);
     if (device) {
         heap_size += sizeof(BACNET_DEVICE_DATA);
+        heap_size +=
+            device->Read_Access_Data_Size * sizeof(BACNET_READ_ACCESS_DATA);
+        heap_size +=
+            device->Property_Reference_Size * sizeof(BACNET_PROPERTY_REFERENCE);
         object_count = Keylist_Count(device->Object_List);
         heap_size += (object_count * sizeof(BACNET_OBJECT_DATA));
         for (i = 0; i < object_count; i++) {
@@ -576,11 +612,6 @@ static void bacnet_device_object_property_add(
         if (value->tag == BACNET_APPLICATION_TAG_UNSIGNED_INT) {
             device_data->Object_List_Size = value->type.Unsigned_Int;
             device_data->Object_List_Index = 0;
-            if (device_data->Discovery_State ==
-                BACNET_DISCOVER_STATE_OBJECT_LIST_SIZE_REQUEST) {
-                device_data->Discovery_State =
-                    BACNET_DISCOVER_STATE_OBJECT_LIST_SIZE_RESPONSE;
-            }
         } else if (value->tag == BACNET_APPLICATION_TAG_OBJECT_ID) {
             if (rp_data->array_index <= device_data->Object_List_Size) {
                 object_data = bacnet_object_data_add(
@@ -592,19 +623,17 @@ static void bacnet_device_object_property_add(
                     bactext_object_type_name(value->type.Object_Id.type),
                     (unsigned long)value->type.Object_Id.instance,
                     object_data ? "success" : "fail");
-                if (device_data->Discovery_State ==
-                    BACNET_DISCOVER_STATE_OBJECT_LIST_REQUEST) {
-                    device_data->Discovery_State =
-                        BACNET_DISCOVER_STATE_OBJECT_LIST_RESPONSE;
-                }
             }
         }
     } else {
-        /* move to next state */
-        if (device_data->Discovery_State ==
-            BACNET_DISCOVER_STATE_OBJECT_GET_PROPERTY_REQUEST) {
-            device_data->Discovery_State =
-                BACNET_DISCOVER_STATE_OBJECT_GET_PROPERTY_RESPONSE;
+        if ((device_data->Discovery_State ==
+             BACNET_DISCOVER_STATE_DATABASE_REVISION_REQUEST) &&
+            (rp_data->object_type == OBJECT_DEVICE) &&
+            (rp_data->object_instance == device_id) &&
+            (rp_data->object_property == PROP_DATABASE_REVISION) &&
+            (value->tag == BACNET_APPLICATION_TAG_UNSIGNED_INT) &&
+            (value->type.Unsigned_Int == device_data->Database_Revision)) {
+            device_data->Database_Revision_Unchanged = true;
         }
         object_data = bacnet_object_data_add(
             device_data->Object_List, rp_data->object_type,
@@ -674,6 +703,81 @@ static void bacnet_device_object_property_add(
     }
 }
 
+/**
+ * @brief Determine if a device is discovered with ReadPropertyMultiple
+ * @param device_data - Pointer to the device data structure
+ * @return true if the device is discovered with ReadPropertyMultiple
+ */
+static bool bacnet_discover_device_rpm(const BACNET_DEVICE_DATA *device_data)
+{
+    return Discovery_RPM && !device_data->RPM_Disabled;
+}
+
+/**
+ * @brief Handle the error of a whole ReadPropertyMultiple request
+ *  from the discovery of a device
+ * @param device_id - device instance number where data originated
+ * @param rp_data - ReadProperty data of the first object and property
+ *  of the request, with the error
+ * @param device_data - Pointer to the device data structure
+ */
+static void bacnet_discover_rpm_error(
+    uint32_t device_id,
+    BACNET_READ_PROPERTY_DATA *rp_data,
+    BACNET_DEVICE_DATA *device_data)
+{
+    bool status = false;
+    uint32_t *per_request;
+
+    if (device_data->Discovery_State ==
+        BACNET_DISCOVER_STATE_OBJECT_LIST_REQUEST) {
+        per_request = &device_data->Object_List_Per_Request;
+    } else {
+        per_request = &device_data->Objects_Per_Request;
+    }
+    /* resend the elements or objects of the request */
+    if (device_data->Object_List_Index >= device_data->Batch_Count) {
+        device_data->Object_List_Index -= device_data->Batch_Count;
+    } else {
+        device_data->Object_List_Index = 0;
+    }
+    switch (rp_data->error_code) {
+        case ERROR_CODE_TIMEOUT:
+        case ERROR_CODE_ABORT_TSM_TIMEOUT:
+            break;
+        case ERROR_CODE_ABORT_SEGMENTATION_NOT_SUPPORTED:
+        case ERROR_CODE_ABORT_BUFFER_OVERFLOW:
+            /* the reply did not fit - ask for less */
+            if (device_data->Batch_Count > 1) {
+                *per_request = device_data->Batch_Count / 2;
+            } else if (
+                device_data->Discovery_State ==
+                BACNET_DISCOVER_STATE_OBJECT_GET_PROPERTY_REQUEST) {
+                /* fallback to ReadProperty of the object-name */
+                status = bacnet_read_property_queue(
+                    device_id, rp_data->object_type, rp_data->object_instance,
+                    PROP_OBJECT_NAME, BACNET_ARRAY_ALL);
+                if (status) {
+                    device_data->Object_List_Index++;
+                }
+            } else {
+                device_data->RPM_Disabled = true;
+            }
+            break;
+        case ERROR_CODE_REJECT_UNRECOGNIZED_SERVICE:
+        case ERROR_CODE_SERVICE_REQUEST_DENIED:
+            debug_printf(
+                "%u - ReadPropertyMultiple not supported.\n", device_id);
+            device_data->RPM_Disabled = true;
+            break;
+        default:
+            /* skip */
+            device_data->Object_List_Index += device_data->Batch_Count;
+            break;
+    }
+    device_data->Batch_Count = 0;
+}
+
 /**
  * @brief Handle the error from a ReadProperty or ReadPropertyMultiple
  * @param device_id - device instance number where data originated
@@ -691,6 +795,14 @@ static void Device_Error_Handler(
         debug_printf(
             "%u - %s\n", device_id,
             bactext_error_code_name((int)rp_data->error_code));
+        if (device_data->Batch_Count > 0) {
+            /* errors of single properties in a ReadPropertyMultiple-ACK
+               are skipped; errors of the whole request are services */
+            if (rp_data->error_class == ERROR_CLASS_SERVICES) {
+                bacnet_discover_rpm_error(device_id, rp_data, device_data);
+            }
+            return;
+        }
         switch (device_data->Discovery_State) {
             case BACNET_DISCOVER_STATE_OBJECT_LIST_REQUEST:
                 /* resend request */
@@ -770,6 +882,197 @@ static void bacnet_read_property_reply(
     }
 }
 
+/**
+ * @brief Size the ReadPropertyMultiple request storage of a device
+ * @param device_data - Pointer to the device data structure
+ * @param objects - number of objects in the request
+ * @param references - number of property references in the request
+ * @return true if the storage is available
+ */
+static bool bacnet_discover_rpm_storage(
+    BACNET_DEVICE_DATA *device_data, unsigned objects, unsigned references)
+{
+    void *data;
+
+    if (device_data->Read_Access_Data_Size < objects) {
+        data = realloc(
+            device_data->Read_Access_Data,
+            objects * sizeof(BACNET_READ_ACCESS_DATA));
+        if (!data) {
+            return false;
+        }
+        device_data->Read_Access_Data = data;
+        device_data->Read_Access_Data_Size = objects;
+    }
+    if (device_data->Property_Reference_Size < references) {
+        data = realloc(
+            device_data->Property_Reference,
+            references * sizeof(BACNET_PROPERTY_REFERENCE));
+        if (!data) {
+            return false;
+        }
+        device_data->Property_Reference = data;
+        device_data->Property_Reference_Size = references;
+    }
+
+    return true;
+}
+
+/**
+ * @brief Queue a ReadPropertyMultiple of the next object-list elements,
+ *  as many as fit in the maximum APDU of the device
+ * @param device_id - Device ID from discovered device
+ * @param device_data - Pointer to the device data structure
+ * @return true if the request was queued
+ */
+static bool bacnet_discover_object_list_rpm_queue(
+    uint32_t device_id, BACNET_DEVICE_DATA *device_data)
+{
+    BACNET_READ_ACCESS_DATA *rad;
+    BACNET_PROPERTY_REFERENCE *reference;
+    uint32_t count, i;
+
+    count = device_data->Object_List_Size - device_data->Object_List_Index;
+    if (count > device_data->Object_List_Per_Request) {
+        count = device_data->Object_List_Per_Request;
+    }
+    if (!bacnet_discover_rpm_storage(device_data, 1, count)) {
+        return false;
+    }
+    rad = &device_data->Read_Access_Data[0];
+    rad->object_type = OBJECT_DEVICE;
+    rad->object_instance = device_id;
+    rad->listOfProperties = &device_data->Property_Reference[0];
+    rad->next = NULL;
+    for (i = 0; i < count; i++) {
+        reference = &device_data->Property_Reference[i];
+        reference->propertyIdentifier = PROP_OBJECT_LIST;
+        reference->propertyArrayIndex = device_data->Object_List_Index + 1 + i;
+        reference->value = NULL;
+        reference->next = NULL;
+        if (i > 0) {
+            device_data->Property_Reference[i - 1].next = reference;
+        }
+    }
+    if (!bacnet_read_property_multiple_queue(device_id, rad)) {
+        return false;
+    }
+    debug_printf(
+        "%u object-list[%u..%u] size=%u.\n", device_id,
+        device_data->Object_List_Index + 1,
+        device_data->Object_List_Index + count, device_data->Object_List_Size);
+    device_data->Object_List_Index += count;
+    device_data->Batch_Count = count;
+
+    return true;
+}
+
+/**
+ * @brief Queue a ReadPropertyMultiple of ALL properties of the next objects
+ * @param device_id - Device ID from discovered device
+ * @param device_data - Pointer to the device data structure
+ * @param object_count - number of objects in the object list
+ * @return true if the request was queued
+ */
+static bool bacnet_discover_objects_rpm_queue(
+    uint32_t device_id, BACNET_DEVICE_DATA *device_data, uint32_t object_count)
+{
+    BACNET_READ_ACCESS_DATA *rad;
+    BACNET_PROPERTY_REFERENCE *reference;
+    uint32_t count, i;
+    KEY key = 0;
+
+    count = object_count - device_data->Object_List_Index;
+    if (count > device_data->Objects_Per_Request) {
+        count = device_data->Objects_Per_Request;
+    }
+    if (!bacnet_discover_rpm_storage(device_data, count, count)) {
+        return false;
+    }
+    for (i = 0; i < count; i++) {
+        if (!Keylist_Index_Key(
+                device_data->Object_List, device_data->Object_List_Index + i,
+                &key)) {
+            return false;
+        }
+        reference = &device_data->Property_Reference[i];
+        reference->propertyIdentifier = PROP_ALL;
+        reference->propertyArrayIndex = BACNET_ARRAY_ALL;
+        reference->value = NULL;
+        reference->next = NULL;
+        rad = &device_data->Read_Access_Data[i];
+        rad->object_type = KEY_DECODE_TYPE(key);
+        rad->object_instance = KEY_DECODE_ID(key);
+        rad->listOfProperties = reference;
+        rad->next = NULL;
+        if (i > 0) {
+            device_data->Read_Access_Data[i - 1].next = rad;
+        }
+    }
+    if (!bacnet_read_property_multiple_queue(
+            device_id, &device_data->Read_Access_Data[0])) {
+        return false;
+    }
+    debug_printf(
+        "%u object-list[%u..%u] read ALL.\n", device_id,
+        device_data->Object_List_Index,
+        device_data->Object_List_Index + count - 1);
+    device_data->Object_List_Index += count;
+    device_data->Batch_Count = count;
+
+    return true;
+}
+
+/**
+ * @brief Set the ReadPropertyMultiple request sizes of a device
+ *  from its maximum APDU
+ * @param device_data - Pointer to the device data structure
+ */
+static void bacnet_discover_rpm_size_init(BACNET_DEVICE_DATA *device_data)
+{
+    unsigned max_apdu = device_data->Max_APDU;
+
+    /* the reply is limited by the smaller of the two devices */
+    if (max_apdu > MAX_APDU) {
+        max_apdu = MAX_APDU;
+    }
+    if (max_apdu < BACNET_DISCOVER_RPM_APDU_MIN) {
+        max_apdu = BACNET_DISCOVER_RPM_APDU_MIN;
+    }
+    device_data->Object_List_Per_Request =
+        (max_apdu - BACNET_DISCOVER_RPM_ACK_OVERHEAD) /
+        BACNET_DISCOVER_RPM_OBJECT_LIST_ELEMENT_SIZE;
+    /* a typical object with ALL properties is a couple hundred octets */
+    device_data->Objects_Per_Request = max_apdu / 256;
+    if (device_data->Objects_Per_Request < 1) {
+        device_data->Objects_Per_Request = 1;
+    } else if (
+        device_data->Objects_Per_Request > BACNET_DISCOVER_RPM_OBJECTS_MAX) {
+        device_data->Objects_Per_Request = BACNET_DISCOVER_RPM_OBJECTS_MAX;
+    }
+}
+
+/**
+ * @brief Save the Database_Revision of a discovered device, to be able
+ *  to skip the next rediscovery if the database has not changed
+ * @param device_id - Device ID from discovered device
+ * @param device_data - Pointer to the device data structure
+ */
+static void bacnet_discover_database_revision_save(
+    uint32_t device_id, BACNET_DEVICE_DATA *device_data)
+{
+    BACNET_APPLICATION_DATA_VALUE value = { 0 };
+
+    device_data->Database_Revision_Valid = false;
+    if (bacnet_discover_property_value(
+            device_id, OBJECT_DEVICE, device_id, PROP_DATABASE_REVISION,
+            &value) &&
+        (value.tag == BACNET_APPLICATION_TAG_UNSIGNED_INT)) {
+        device_data->Database_Revision = value.type.Unsigned_Int;
+        device_data->Database_Revision_Valid = true;
+    }
+}
+
 /**
  * @brief Non-blocking task for running BACnet discover state machine
  * @param device_id - Device ID from discovered device
@@ -781,6 +1084,7 @@ bacnet_discover_device_fsm(uint32_t device_id, BACNET_DEVICE_DATA *device_data)
     KEY key = 0;
     BACNET_OBJECT_TYPE object_type = 0;
     uint32_t object_instance = 0;
+    uint32_t object_count = 0;
     bool status = false;
 
     if (!device_data) {
@@ -788,9 +1092,27 @@ bacnet_discover_device_fsm(uint32_t device_id, BACNET_DEVICE_DATA *device_data)
     }
     switch (device_data->Discovery_State) {
         case BACNET_DISCOVER_STATE_INIT:
+            device_data->Batch_Count = 0;
+            if (Discovery_RPM && device_data->Database_Revision_Valid) {
+                /* rediscover only if the database has changed */
+                device_data->Database_Revision_Unchanged = false;
+                status = bacnet_read_property_queue(
+                    device_id, OBJECT_DEVICE, device_id,
+                    PROP_DATABASE_REVISION, BACNET_ARRAY_ALL);
+                if (status) {
+                    device_data->Discovery_State =
+                        BACNET_DISCOVER_STATE_DATABASE_REVISION_REQUEST;
+                } else {
+                    debug_fprintf(
+                        stderr, "%u database-revision fail to queue!\n",
+                        device_id);
+                }
+                break;
+            }
             status = bacnet_read_property_queue(
                 device_id, OBJECT_DEVICE, device_id, PROP_OBJECT_LIST, 0);
             if (status) {
+                bacnet_discover_rpm_size_init(device_data);
                 device_data->Discovery_State =
                     BACNET_DISCOVER_STATE_OBJECT_LIST_SIZE_REQUEST;
             } else {
@@ -798,9 +1120,36 @@ bacnet_discover_device_fsm(uint32_t device_id, BACNET_DEVICE_DATA *device_data)
                     stderr, "%u object-list-size fail to queue!\n", device_id);
             }
             break;
+        case BACNET_DISCOVER_STATE_DATABASE_REVISION_REQUEST:
+            /* waiting for response */
+            if (bacnet_read_write_device_idle(device_id)) {
+                device_data->Discovery_State =
+                    BACNET_DISCOVER_STATE_DATABASE_REVISION_RESPONSE;
+            }
+            break;
+        case BACNET_DISCOVER_STATE_DATABASE_REVISION_RESPONSE:
+            if (device_data->Database_Revision_Unchanged) {
+                debug_printf(
+                    "%u database-revision=%lu unchanged.\n", device_id,
+                    (unsigned long)device_data->Database_Revision);
+                mstimer_set(
+                    &device_data->Discovery_Timer, Discovery_Milliseconds);
+                device_data->Discovery_State = BACNET_DISCOVER_STATE_DONE;
+            } else {
+                /* objects may have been added or removed */
+                bacnet_object_data_cleanup(device_data->Object_List);
+                device_data->Object_List = Keylist_Create();
+                device_data->Database_Revision_Valid = false;
+                device_data->Discovery_State = BACNET_DISCOVER_STATE_INIT;
+            }
+            break;
         case BACNET_DISCOVER_STATE_OBJECT_LIST_SIZE_REQUEST:
             /* waiting for response */
-            return;
+            if (bacnet_read_write_device_idle(device_id)) {
+                device_data->Discovery_State =
+                    BACNET_DISCOVER_STATE_OBJECT_LIST_SIZE_RESPONSE;
+            }
+            break;
         case BACNET_DISCOVER_STATE_OBJECT_LIST_SIZE_RESPONSE:
             device_data->Object_List_Index = 0;
             device_data->Discovery_State =
@@ -808,8 +1157,28 @@ bacnet_discover_device_fsm(uint32_t device_id, BACNET_DEVICE_DATA *device_data)
             break;
         case BACNET_DISCOVER_STATE_OBJECT_LIST_REQUEST:
             /* waiting for response */
+            if (bacnet_read_write_device_idle(device_id)) {
+                device_data->Batch_Count = 0;
+                device_data->Discovery_State =
+                    BACNET_DISCOVER_STATE_OBJECT_LIST_RESPONSE;
+            }
             break;
         case BACNET_DISCOVER_STATE_OBJECT_LIST_RESPONSE:
+            if (bacnet_discover_device_rpm(device_data) &&
+                (device_data->Object_List_Index <
+                 device_data->Object_List_Size)) {
+                status = bacnet_discover_object_list_rpm_queue(
+                    device_id, device_data);
+                if (status) {
+                    device_data->Discovery_State =
+                        BACNET_DISCOVER_STATE_OBJECT_LIST_REQUEST;
+                } else {
+                    debug_fprintf(
+                        stderr, "%u object-list[%u] fail to queue!\n",
+                        device_id, device_data->Object_List_Index + 1);
+                }
+                break;
+            }
             device_data->Object_List_Index++;
             if (device_data->Object_List_Index <=
                 device_data->Object_List_Size) {
@@ -840,9 +1209,31 @@ bacnet_discover_device_fsm(uint32_t device_id, BACNET_DEVICE_DATA *device_data)
             break;
         case BACNET_DISCOVER_STATE_OBJECT_GET_PROPERTY_REQUEST:
             /* waiting for response */
+            if (bacnet_read_write_device_idle(device_id)) {
+                device_data->Batch_Count = 0;
+                device_data->Discovery_State =
+                    BACNET_DISCOVER_STATE_OBJECT_GET_PROPERTY_RESPONSE;
+            }
             break;
         case BACNET_DISCOVER_STATE_OBJECT_GET_PROPERTY_RESPONSE:
-            if (device_data->Object_List_Index <
+            object_count = Keylist_Count(device_data->Object_List);
+            if (object_count > device_data->Object_List_Size) {
+                object_count = device_data->Object_List_Size;
+            }
+            if (bacnet_discover_device_rpm(device_data) &&
+                (device_data->Object_List_Index < object_count)) {
+                status = bacnet_discover_objects_rpm_queue(
+                    device_id, device_data, object_count);
+                if (status) {
+                    device_data->Discovery_State =
+                        BACNET_DISCOVER_STATE_OBJECT_GET_PROPERTY_REQUEST;
+                } else {
+                    debug_fprintf(
+                        stderr, "%u object-list[%u] fail to queue!\n",
+                        device_id, device_data->Object_List_Index);
+                }
+            } else if (
+                device_data->Object_List_Index <
                 device_data->Object_List_Size) {
                 if (Keylist_Index_Key(
                         device_data->Object_List,
@@ -873,6 +1264,10 @@ bacnet_discover_device_fsm(uint32_t device_id, BACNET_DEVICE_DATA *device_data)
                 /* track the duration */
                 device_data->Discovery_Elapsed_Milliseconds =
                     mstimer_elapsed(&device_data->Discovery_Timer);
+                if (Discovery_RPM) {
+                    bacnet_discover_database_revision_save(
+                        device_id, device_data);
+                }
                 /* rediscover in the future */
                 mstimer_set(
                     &device_data->Discovery_Timer, Discovery_Milliseconds);
@@ -1089,7 +1484,12 @@ void bacnet_discover_task(void)
         mstimer_restart(&Read_Write_Timer);
         bacnet_read_write_task();
     }
-    if (bacnet_read_write_idle()) {
+    if (Discovery_RPM) {
+        /* discover many devices at the same time */
+        if (!bacnet_read_write_busy()) {
+            bacnet_discover_devices_task();
+        }
+    } else if (bacnet_read_write_idle()) {
         bacnet_discover_devices_task();
     }
 }
@@ -1150,6 +1550,30 @@ unsigned int bacnet_discover_seconds(void)
     return Discovery_Milliseconds = 1000;
 }
 
+/**
+ * @brief Enable discovery with ReadPropertyMultiple (default=enabled).
+ *  The object-list is read in chunks sized to the maximum APDU of each
+ *  device, the objects are read several at a time with PROP_ALL, many
+ *  devices are discovered at the same time, and a device is rediscovered
+ *  only when its Database_Revision changes.  When disabled, or when a
+ *  device does not support ReadPropertyMultiple, each object-list element
+ *  and each object is read with its own request, one device at a time.
+ * @param enable - true to discover with ReadPropertyMultiple
+ */
+void bacnet_discover_read_property_multiple_set(bool enable)
+{
+    Discovery_RPM = enable;
+}
+
+/**
+ * @brief Get the enable of discovery with ReadPropertyMultiple
+ * @return true if discovery uses ReadPropertyMultiple
+ */
+bool bacnet_discover_read_property_multiple(void)
+{
+    return Discovery_RPM;
+}
+
 /**
  * @brief Set the millisecond timer for the read propcess (default=10ms)
  * @param milliseconds - read process task time
@@ -1184,9 +1608,11 @@ void bacnet_discover_device_add(
 {
     BACNET_DEVICE_DATA *device_data;
 
-    (void)max_apdu;
     (void)segmentation;
     device_data = bacnet_device_data_add(device_instance);
+    if (device_data) {
+        device_data->Max_APDU = max_apdu;
+    }
     debug_printf(
         "device[%d] %lu - vendor=%u %s.\n",
         Keylist_Index(Device_List, device_instance), device_instance, vendor_id,
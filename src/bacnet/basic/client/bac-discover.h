@@ -119,6 +119,11 @@ void bacnet_discover_seconds_set(unsigned int seconds);
 BACNET_STACK_EXPORT
 unsigned int bacnet_discover_seconds(void);
 
+BACNET_STACK_EXPORT
+void bacnet_discover_read_property_multiple_set(bool enable);
+BACNET_STACK_EXPORT
+bool bacnet_discover_read_property_multiple(void);
+
 BACNET_STACK_EXPORT
 void bacnet_discover_read_process_milliseconds_set(unsigned long milliseconds);
 BACNET_STACK_EXPORT
@@ -0,0 +1,736 @@
+/**
+ * @file
+ * @brief Client AtomicReadFile and AtomicWriteFile transfers
+ * @details Transfers a file between a local file and a File object of
+ *  another BACnet device using stream access.  The file is split into
+ *  chunks that fit the maximum APDU of the device, and several chunk
+ *  requests are kept in flight so that the transfer is not limited to
+ *  one chunk per round trip.  Each chunk carries its own file position,
+ *  so the acknowledgements are written to, or counted from, the local
+ *  file in any order.  A chunk that times out, is aborted or rejected,
+ *  or is only partly read, is requested again on its own.  Each chunk
+ *  has its own timeout, and keeps the reason that it last failed.
+ * @author Steve Karg <skarg@users.sourceforge.net>
+ * @date 2024
+ * @copyright SPDX-License-Identifier: MIT
+ */
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <string.h>
+/* BACnet Stack defines - first */
+#include "bacnet/bacdef.h"
+/* BACnet Stack API */
+#include "bacnet/abort.h"
+#include "bacnet/apdu.h"
+#include "bacnet/arf.h"
+#include "bacnet/awf.h"
+#include "bacnet/bacstr.h"
+#include "bacnet/reject.h"
+#include "bacnet/basic/binding/address.h"
+#include "bacnet/basic/services.h"
+#include "bacnet/basic/sys/mstimer.h"
+#include "bacnet/basic/tsm/tsm.h"
+/* me */
+#include "bacnet/basic/client/bac-file.h"
+
+/* number of chunk requests that can be in flight */
+#ifndef BACNET_FILE_TRANSFER_WINDOW_MAX
+#define BACNET_FILE_TRANSFER_WINDOW_MAX 8
+#endif
+/* default number of chunk requests in flight */
+#ifndef BACNET_FILE_TRANSFER_WINDOW
+#define BACNET_FILE_TRANSFER_WINDOW 4
+#endif
+/* number of times a chunk is requested again before the transfer fails */
+#ifndef BACNET_FILE_TRANSFER_RETRIES
+#define BACNET_FILE_TRANSFER_RETRIES 3
+#endif
+
+/* state of a chunk request */
+typedef enum bacnet_file_chunk_state {
+    BACNET_FILE_CHUNK_FREE,
+    /* waiting to be sent, or sent again */
+    BACNET_FILE_CHUNK_QUEUED,
+    /* waiting for the acknowledgement */
+    BACNET_FILE_CHUNK_SENT
+} BACNET_FILE_CHUNK_STATE;
+
+/* a chunk of the file requested from, or sent to, the device */
+typedef struct bacnet_file_chunk {
+    int32_t Position;
+    uint32_t Octets;
+    uint8_t Invoke_ID;
+    uint8_t Retries;
+    uint8_t State;
+    /* time allowed for the acknowledgement, including the TSM retries */
+    struct mstimer Timer;
+    /* reason that the last request of the chunk failed */
+    BACNET_ERROR_CODE Error_Code;
+} BACNET_FILE_CHUNK;
+static BACNET_FILE_CHUNK Chunk_Table[BACNET_FILE_TRANSFER_WINDOW_MAX];
+static unsigned Chunk_Window = BACNET_FILE_TRANSFER_WINDOW;
+static unsigned Chunk_Size_Requested;
+/* the transfer */
+static BACNET_FILE_TRANSFER_STATUS Transfer_Status;
+static BACNET_ERROR_CLASS Transfer_Error_Class;
+static BACNET_ERROR_CODE Transfer_Error_Code;
+static uint32_t Target_Device_ID;
+static uint32_t Target_File_Instance;
+static BACNET_ADDRESS Target_Address;
+static FILE *Local_File;
+static bool Transfer_Write;
+static uint32_t Chunk_Octets;
+/* next file position to request */
+static int32_t Next_Position;
+/* end of the file, or -1 until it is known */
+static int32_t End_Position;
+/* a write at position 0 truncates the file, and is acknowledged
+   before the other chunks are written */
+static bool First_Chunk_Queued;
+static bool First_Chunk_Acked;
+static unsigned long Transfer_Octets;
+static bool Pad_Enabled;
+static uint8_t Pad_Value;
+/* buffer for the data of a chunk to write */
+static BACNET_OCTET_STRING Write_Data;
+/* the Abort and Reject handlers that were set before ours */
+static abort_function Abort_Handler_Next;
+static reject_function Reject_Handler_Next;
+
+/**
+ * @brief Determine the number of file octets in each chunk, so that
+ *  the requests and acknowledgements are not segmented
+ * @param max_apdu - the maximum APDU accepted by the device
+ * @return number of octets in each chunk
+ */
+static uint32_t bacnet_file_chunk_octets(unsigned max_apdu)
+{
+    unsigned my_max_apdu;
+    uint32_t octets;
+
+    /* calculate the smaller of our APDU size or theirs
+       and remove the overhead of the APDU (varies depending on
+       size). note: we could fail if there is a bottle neck (router)
+       and smaller MPDU in betweeen. */
+    if (max_apdu < MAX_APDU) {
+        my_max_apdu = max_apdu;
+    } else {
+        my_max_apdu = MAX_APDU;
+    }
+    /* Typical sizes are 50, 128, 206, 480, 1024, and 1476 octets */
+    if (my_max_apdu <= 50) {
+        octets = my_max_apdu - 20;
+    } else if (my_max_apdu <= 480) {
+        octets = my_max_apdu - 32;
+    } else if (my_max_apdu <= 1476) {
+        octets = my_max_apdu - 64;
+    } else {
+        octets = my_max_apdu / 2;
+    }
+    if (octets > MAX_OCTET_STRING_BYTES) {
+        octets = MAX_OCTET_STRING_BYTES;
+    }
+
+    return octets;
+}
+
+/**
+ * @brief Stop the transfer with an error
+ * @param error_class - the error class
+ * @param error_code - the error code
+ */
+static void bacnet_file_transfer_fail(
+    BACNET_ERROR_CLASS error_class, BACNET_ERROR_CODE error_code)
+{
+    bacnet_file_transfer_stop();
+    Transfer_Status = BACNET_FILE_TRANSFER_FAILED;
+    Transfer_Error_Class = error_class;
+    Transfer_Error_Code = error_code;
+}
+
+/**
+ * @brief Find the chunk of an acknowledgement or error
+ * @param src - source address of the message
+ * @param invoke_id - invoke ID of the message
+ * @return the chunk, or NULL if the message is not for this transfer
+ */
+static BACNET_FILE_CHUNK *
+bacnet_file_chunk_find(BACNET_ADDRESS *src, uint8_t invoke_id)
+{
+    BACNET_FILE_CHUNK *chunk;
+    unsigned i;
+
+    if ((Transfer_Status != BACNET_FILE_TRANSFER_BUSY) ||
+        !address_match(&Target_Address, src)) {
+        return NULL;
+    }
+    for (i = 0; i < BACNET_FILE_TRANSFER_WINDOW_MAX; i++) {
+        chunk = &Chunk_Table[i];
+        if ((chunk->State == BACNET_FILE_CHUNK_SENT) &&
+            (chunk->Invoke_ID == invoke_id)) {
+            return chunk;
+        }
+    }
+
+    return NULL;
+}
+
+/**
+ * @brief Move the end of the file to a lower position, if known earlier
+ * @param position - file position where the file ends
+ */
+static void bacnet_file_end_set(int32_t position)
+{
+    if ((End_Position < 0) || (position < End_Position)) {
+        End_Position = position;
+    }
+}
+
+/**
+ * @brief Handle an AtomicReadFile-ACK by writing its data to the local
+ *  file at the position of the chunk
+ * @param service_request [in] The contents of the service request.
+ * @param service_len [in] The length of the service_request.
+ * @param src [in] BACNET_ADDRESS of the source of the message
+ * @param service_data [in] The BACNET_CONFIRMED_SERVICE_DATA information
+ */
+static void bacnet_file_read_ack_handler(
+    uint8_t *service_request,
+    uint16_t service_len,
+    BACNET_ADDRESS *src,
+    BACNET_CONFIRMED_SERVICE_ACK_DATA *service_data)
+{
+    BACNET_ATOMIC_READ_FILE_DATA data;
+    BACNET_FILE_CHUNK *chunk;
+    int len;
+    size_t octet_count;
+
+    chunk = bacnet_file_chunk_find(src, service_data->invoke_id);
+    if (!chunk || Transfer_Write) {
+        return;
+    }
+    len = arf_ack_decode_service_request(service_request, service_len, &data);
+    if ((len <= 0) || (data.access != FILE_STREAM_ACCESS)) {
+        bacnet_file_transfer_fail(
+            ERROR_CLASS_SERVICES, ERROR_CODE_INVALID_DATA_ENCODING);
+        return;
+    }
+    octet_count = octetstring_length(&data.fileData[0]);
+    if (octet_count > chunk->Octets) {
+        octet_count = chunk->Octets;
+    }
+    if (octet_count > 0) {
+        if ((fseek(Local_File, chunk->Position, SEEK_SET) != 0) ||
+            (fwrite(
+                 octetstring_value(&data.fileData[0]), 1, octet_count,
+                 Local_File) != octet_count)) {
+            bacnet_file_transfer_fail(
+                ERROR_CLASS_RESOURCES, ERROR_CODE_NO_SPACE_TO_WRITE_PROPERTY);
+            return;
+        }
+        Transfer_Octets += octet_count;
+    }
+    if (data.endOfFile || (octet_count == 0)) {
+        /* asked for many octets, and got zero, is also the end */
+        bacnet_file_end_set(chunk->Position + (int32_t)octet_count);
+        chunk->State = BACNET_FILE_CHUNK_FREE;
+    } else if (octet_count < chunk->Octets) {
+        /* request the rest of the chunk */
+        chunk->Position += (int32_t)octet_count;
+        chunk->Octets -= (uint32_t)octet_count;
+        chunk->Retries = 0;
+        chunk->State = BACNET_FILE_CHUNK_QUEUED;
+    } else {
+        chunk->State = BACNET_FILE_CHUNK_FREE;
+    }
+}
+
+/**
+ * @brief Handle an AtomicWriteFile-ACK by counting the chunk as written
+ * @param service_request [in] The contents of the service request.
+ * @param service_len [in] The length of the service_request.
+ * @param src [in] BACNET_ADDRESS of the source of the message
+ * @param service_data [in] The BACNET_CONFIRMED_SERVICE_DATA information
+ */
+static void bacnet_file_write_ack_handler(
+    uint8_t *service_request,
+    uint16_t service_len,
+    BACNET_ADDRESS *src,
+    BACNET_CONFIRMED_SERVICE_ACK_DATA *service_data)
+{
+    BACNET_ATOMIC_WRITE_FILE_DATA data;
+    BACNET_FILE_CHUNK *chunk;
+    int len;
+
+    chunk = bacnet_file_chunk_find(src, service_data->invoke_id);
+    if (!chunk || !Transfer_Write) {
+        return;
+    }
+    len = awf_ack_decode_service_request(service_request, service_len, &data);
+    if (len <= 0) {
+        bacnet_file_transfer_fail(
+            ERROR_CLASS_SERVICES, ERROR_CODE_INVALID_DATA_ENCODING);
+        return;
+    }
+    if (chunk->Position == 0) {
+        First_Chunk_Acked = true;
+    }
+    Transfer_Octets += chunk->Octets;
+    chunk->State = BACNET_FILE_CHUNK_FREE;
+}
+
+/**
+ * @brief Handle an Error PDU of an AtomicReadFile or AtomicWriteFile
+ * @param src [in] BACNET_ADDRESS of the source of the message
+ * @param invoke_id [in] the invokeID from the rejected message
+ * @param error_class [in] the error class
+ * @param error_code [in] the error code
+ */
+static void bacnet_file_error_handler(
+    BACNET_ADDRESS *src,
+    uint8_t invoke_id,
+    BACNET_ERROR_CLASS error_class,
+    BACNET_ERROR_CODE error_code)
+{
+    BACNET_FILE_CHUNK *chunk;
+
+    chunk = bacnet_file_chunk_find(src, invoke_id);
+    if (!chunk) {
+        return;
+    }
+    if (!Transfer_Write &&
+        (error_code == ERROR_CODE_INVALID_FILE_START_POSITION)) {
+        /* a chunk requested past the end of the file */
+        bacnet_file_end_set(chunk->Position);
+        chunk->State = BACNET_FILE_CHUNK_FREE;
+    } else {
+        bacnet_file_transfer_fail(error_class, error_code);
+    }
+}
+
+/**
+ * @brief Handle an Abort PDU by keeping its reason with the chunk, which
+ *  is requested again when the TSM frees its invoke ID.  Every Abort is
+ *  passed on to the handler that was set before.
+ * @param src [in] BACNET_ADDRESS of the source of the message
+ * @param invoke_id [in] the invokeID from the aborted message
+ * @param abort_reason [in] the reason for the message abort
+ * @param server [in] true if the abort was sent by a server
+ */
+static void bacnet_file_abort_handler(
+    BACNET_ADDRESS *src, uint8_t invoke_id, uint8_t abort_reason, bool server)
+{
+    BACNET_FILE_CHUNK *chunk;
+
+    chunk = bacnet_file_chunk_find(src, invoke_id);
+    if (chunk) {
+        chunk->Error_Code = abort_convert_to_error_code(abort_reason);
+    }
+    if (Abort_Handler_Next) {
+        Abort_Handler_Next(src, invoke_id, abort_reason, server);
+    }
+}
+
+/**
+ * @brief Handle a Reject PDU by keeping its reason with the chunk, which
+ *  is requested again when the TSM frees its invoke ID.  Every Reject is
+ *  passed on to the handler that was set before.
+ * @param src [in] BACNET_ADDRESS of the source of the message
+ * @param invoke_id [in] the invokeID from the rejected message
+ * @param reject_reason [in] the reason for the rejection
+ */
+static void bacnet_file_reject_handler(
+    BACNET_ADDRESS *src, uint8_t invoke_id, uint8_t reject_reason)
+{
+    BACNET_FILE_CHUNK *chunk;
+
+    chunk = bacnet_file_chunk_find(src, invoke_id);
+    if (chunk) {
+        chunk->Error_Code = reject_convert_to_error_code(reject_reason);
+    }
+    if (Reject_Handler_Next) {
+        Reject_Handler_Next(src, invoke_id, reject_reason);
+    }
+}
+
+/**
+ * @brief Send the request of a chunk
+ * @param chunk - the chunk to request
+ * @return true if the request was sent
+ */
+static bool bacnet_file_chunk_send(BACNET_FILE_CHUNK *chunk)
+{
+    uint8_t *value;
+    size_t len = 0;
+
+    if (Transfer_Write) {
+        value = octetstring_value(&Write_Data);
+        if (fseek(Local_File, chunk->Position, SEEK_SET) == 0) {
+            len = fread(value, 1, chunk->Octets, Local_File);
+        }
+        if (len < chunk->Octets) {
+            if (Pad_Enabled) {
+                memset(&value[len], Pad_Value, chunk->Octets - len);
+                len = chunk->Octets;
+            } else {
+                chunk->Octets = (uint32_t)len;
+            }
+        }
+        octetstring_truncate(&Write_Data, len);
+        chunk->Invoke_ID = Send_Atomic_Write_File_Stream(
+            Target_Device_ID, Target_File_Instance, chunk->Position,
+            &Write_Data);
+    } else {
+        chunk->Invoke_ID = Send_Atomic_Read_File_Stream(
+            Target_Device_ID, Target_File_Instance, chunk->Position,
+            chunk->Octets);
+    }
+    if (chunk->Invoke_ID == 0) {
+        return false;
+    }
+    mstimer_set(
+        &chunk->Timer, (unsigned long)apdu_timeout() * (apdu_retries() + 1));
+    chunk->Error_Code = ERROR_CODE_ABORT_TSM_TIMEOUT;
+    chunk->State = BACNET_FILE_CHUNK_SENT;
+
+    return true;
+}
+
+/**
+ * @brief Check a chunk that was sent for a timeout, or for an Abort or
+ *  Reject, which free the invoke ID without an acknowledgement.  The
+ *  chunk is queued to be sent again until its retries are used up, and
+ *  then the transfer fails with the reason of the last failure.
+ * @param chunk - the chunk that was sent
+ */
+static void bacnet_file_chunk_check(BACNET_FILE_CHUNK *chunk)
+{
+    bool failed = false;
+
+    if (tsm_invoke_id_failed(chunk->Invoke_ID)) {
+        tsm_free_invoke_id(chunk->Invoke_ID);
+        failed = true;
+    } else if (tsm_invoke_id_free(chunk->Invoke_ID)) {
+        failed = true;
+    } else if (mstimer_expired(&chunk->Timer)) {
+        /* the chunk has its own timeout, in case the TSM is slow */
+        tsm_free_invoke_id(chunk->Invoke_ID);
+        failed = true;
+    }
+    if (failed) {
+        if (chunk->Retries < BACNET_FILE_TRANSFER_RETRIES) {
+            chunk->Retries++;
+            chunk->State = BACNET_FILE_CHUNK_QUEUED;
+        } else {
+            bacnet_file_transfer_fail(ERROR_CLASS_SERVICES, chunk->Error_Code);
+        }
+    }
+}
+
+/**
+ * @brief Get the next new chunk to request, if any
+ * @param chunk - the free chunk to fill
+ * @return true if the chunk was filled
+ */
+static bool bacnet_file_chunk_next(BACNET_FILE_CHUNK *chunk)
+{
+    uint32_t octets = Chunk_Octets;
+
+    if (Transfer_Write) {
+        if (First_Chunk_Queued) {
+            if (!First_Chunk_Acked) {
+                /* wait for the write that truncates the file */
+                return false;
+            }
+            if (Next_Position >= End_Position) {
+                return false;
+            }
+        }
+        if (!Pad_Enabled &&
+            ((uint32_t)(End_Position - Next_Position) < octets)) {
+            octets = (uint32_t)(End_Position - Next_Position);
+        }
+    } else if ((End_Position >= 0) && (Next_Position >= End_Position)) {
+        return false;
+    }
+    chunk->Position = Next_Position;
+    chunk->Octets = octets;
+    chunk->Retries = 0;
+    chunk->State = BACNET_FILE_CHUNK_QUEUED;
+    Next_Position += (int32_t)octets;
+    First_Chunk_Queued = true;
+
+    return true;
+}
+
+/**
+ * @brief Send the queued chunks and new chunks while the window and the
+ *  TSM have room, and detect the end of the transfer.  Call this task
+ *  periodically, along with the TSM timer.
+ */
+void bacnet_file_transfer_task(void)
+{
+    BACNET_FILE_CHUNK *chunk;
+    unsigned i, busy = 0;
+
+    if (Transfer_Status != BACNET_FILE_TRANSFER_BUSY) {
+        return;
+    }
+    for (i = 0; i < BACNET_FILE_TRANSFER_WINDOW_MAX; i++) {
+        chunk = &Chunk_Table[i];
+        if ((chunk->State != BACNET_FILE_CHUNK_FREE) && (End_Position >= 0) &&
+            (chunk->Position >= End_Position) && !Transfer_Write) {
+            /* past the end of the file - any reply is ignored */
+            chunk->State = BACNET_FILE_CHUNK_FREE;
+        }
+        if (chunk->State == BACNET_FILE_CHUNK_SENT) {
+            bacnet_file_chunk_check(chunk);
+            if (Transfer_Status != BACNET_FILE_TRANSFER_BUSY) {
+                return;
+            }
+        }
+    }
+    for (i = 0; i < BACNET_FILE_TRANSFER_WINDOW_MAX; i++) {
+        chunk = &Chunk_Table[i];
+        if ((i < Chunk_Window) && (chunk->State == BACNET_FILE_CHUNK_FREE)) {
+            (void)bacnet_file_chunk_next(chunk);
+        }
+        if (chunk->State == BACNET_FILE_CHUNK_QUEUED) {
+            if (!tsm_transaction_available() ||
+                !bacnet_file_chunk_send(chunk)) {
+                /* try again at the next task */
+                busy++;
+                break;
+            }
+        }
+        if (chunk->State != BACNET_FILE_CHUNK_FREE) {
+            busy++;
+        }
+    }
+    if (busy == 0) {
+        bacnet_file_transfer_stop();
+        Transfer_Status = BACNET_FILE_TRANSFER_COMPLETE;
+    }
+}
+
+/**
+ * @brief Start a transfer of a local file, which is created or
+ *  truncated, and the chunks of the file at the device
+ * @param device_id - device instance number of the bound device
+ * @param pathname - local file
+ * @param write - true to write the local file to the device
+ * @return true if the transfer started
+ */
+static bool bacnet_file_transfer_start(
+    uint32_t device_id,
+    uint32_t file_instance,
+    const char *pathname,
+    bool write)
+{
+    unsigned max_apdu = 0;
+    long size;
+
+    bacnet_file_transfer_stop();
+    Transfer_Status = BACNET_FILE_TRANSFER_IDLE;
+    if (!address_get_by_device(device_id, &max_apdu, &Target_Address)) {
+        return false;
+    }
+    if (write) {
+        Local_File = fopen(pathname, "rb");
+    } else {
+        Local_File = fopen(pathname, "wb");
+    }
+    if (!Local_File) {
+        return false;
+    }
+    End_Position = -1;
+    if (write) {
+        (void)fseek(Local_File, 0L, SEEK_END);
+        size = ftell(Local_File);
+        if (size < 0) {
+            size = 0;
+        }
+        End_Position = (int32_t)size;
+    }
+    Target_Device_ID = device_id;
+    Target_File_Instance = file_instance;
+    Transfer_Write = write;
+    Chunk_Octets = bacnet_file_chunk_octets(max_apdu);
+    if (Chunk_Size_Requested) {
+        Chunk_Octets = Chunk_Size_Requested;
+        if (Chunk_Octets > MAX_OCTET_STRING_BYTES) {
+            Chunk_Octets = MAX_OCTET_STRING_BYTES;
+        }
+    }
+    Next_Position = 0;
+    First_Chunk_Queued = false;
+    First_Chunk_Acked = false;
+    Transfer_Octets = 0;
+    Transfer_Error_Class = ERROR_CLASS_SERVICES;
+    Transfer_Error_Code = ERROR_CODE_SUCCESS;
+    Transfer_Status = BACNET_FILE_TRANSFER_BUSY;
+
+    return true;
+}
+
+/**
+ * @brief Start reading a File object of a device into a local file
+ * @param device_id - device instance number, which must be bound
+ * @param file_instance - instance number of the File object
+ * @param pathname - local file, which is created or truncated
+ * @return true if the transfer started
+ */
+bool bacnet_file_read_start(
+    uint32_t device_id, uint32_t file_instance, const char *pathname)
+{
+    return bacnet_file_transfer_start(
+        device_id, file_instance, pathname, false);
+}
+
+/**
+ * @brief Start writing a local file to a File object of a device
+ * @param device_id - device instance number, which must be bound
+ * @param file_instance - instance number of the File object
+ * @param pathname - local file
+ * @return true if the transfer started
+ */
+bool bacnet_file_write_start(
+    uint32_t device_id, uint32_t file_instance, const char *pathname)
+{
+    return bacnet_file_transfer_start(
+        device_id, file_instance, pathname, true);
+}
+
+/**
+ * @brief Stop the transfer, and close the local file.  The replies to
+ *  the chunks in flight are ignored.
+ */
+void bacnet_file_transfer_stop(void)
+{
+    unsigned i;
+
+    for (i = 0; i < BACNET_FILE_TRANSFER_WINDOW_MAX; i++) {
+        Chunk_Table[i].State = BACNET_FILE_CHUNK_FREE;
+    }
+    if (Local_File) {
+        fclose(Local_File);
+        Local_File = NULL;
+    }
+    if (Transfer_Status == BACNET_FILE_TRANSFER_BUSY) {
+        Transfer_Status = BACNET_FILE_TRANSFER_IDLE;
+    }
+}
+
+/**
+ * @brief Get the status of the transfer
+ * @return status of the transfer
+ */
+BACNET_FILE_TRANSFER_STATUS bacnet_file_transfer_status(void)
+{
+    return Transfer_Status;
+}
+
+/**
+ * @brief Get the error that stopped a failed transfer
+ * @param error_class [out] the error class
+ * @param error_code [out] the error code
+ */
+void bacnet_file_transfer_error(
+    BACNET_ERROR_CLASS *error_class, BACNET_ERROR_CODE *error_code)
+{
+    if (error_class) {
+        *error_class = Transfer_Error_Class;
+    }
+    if (error_code) {
+        *error_code = Transfer_Error_Code;
+    }
+}
+
+/**
+ * @brief Get the number of file octets acknowledged so far
+ * @return number of octets transferred
+ */
+unsigned long bacnet_file_transfer_octets(void)
+{
+    return Transfer_Octets;
+}
+
+/**
+ * @brief Set the number of chunk requests kept in flight
+ * @param chunks - number of chunks, from 1 to
+ *  BACNET_FILE_TRANSFER_WINDOW_MAX
+ */
+void bacnet_file_transfer_window_set(unsigned chunks)
+{
+    if (chunks < 1) {
+        chunks = 1;
+    } else if (chunks > BACNET_FILE_TRANSFER_WINDOW_MAX) {
+        chunks = BACNET_FILE_TRANSFER_WINDOW_MAX;
+    }
+    Chunk_Window = chunks;
+}
+
+/**
+ * @brief Get the number of chunk requests kept in flight
+ * @return number of chunks
+ */
+unsigned bacnet_file_transfer_window(void)
+{
+    return Chunk_Window;
+}
+
+/**
+ * @brief Set the number of file octets in each chunk of the next
+ *  transfer, which is otherwise sized to the maximum APDU of the device
+ * @param octets - number of octets, or 0 to size to the maximum APDU
+ */
+void bacnet_file_transfer_chunk_size_set(unsigned octets)
+{
+    Chunk_Size_Requested = octets;
+}
+
+/**
+ * @brief Pad the last chunk written to the size of the other chunks
+ * @param pad - true to pad the last chunk
+ * @param value - value of the pad octets
+ */
+void bacnet_file_transfer_pad_set(bool pad, uint8_t value)
+{
+    Pad_Enabled = pad;
+    Pad_Value = value;
+}
+
+/**
+ * @brief Initializes the file transfer client, and installs the handlers
+ *  of the AtomicReadFile and AtomicWriteFile acknowledgements and errors,
+ *  and the Abort and Reject handlers that keep the reason of a failed chunk.
+ *  The Abort and Reject handlers are global, so the handlers that were
+ *  set before are kept, and are called with every Abort and Reject.
+ */
+void bacnet_file_transfer_init(void)
+{
+    abort_function abort_handler;
+    reject_function reject_handler;
+
+    bacnet_file_transfer_stop();
+    Transfer_Status = BACNET_FILE_TRANSFER_IDLE;
+    apdu_set_confirmed_ack_handler(
+        SERVICE_CONFIRMED_ATOMIC_READ_FILE, bacnet_file_read_ack_handler);
+    apdu_set_confirmed_ack_handler(
+        SERVICE_CONFIRMED_ATOMIC_WRITE_FILE, bacnet_file_write_ack_handler);
+    apdu_set_error_handler(
+        SERVICE_CONFIRMED_ATOMIC_READ_FILE, bacnet_file_error_handler);
+    apdu_set_error_handler(
+        SERVICE_CONFIRMED_ATOMIC_WRITE_FILE, bacnet_file_error_handler);
+    abort_handler = apdu_abort_handler();
+    if (abort_handler != bacnet_file_abort_handler) {
+        Abort_Handler_Next = abort_handler;
+    }
+    apdu_set_abort_handler(bacnet_file_abort_handler);
+    reject_handler = apdu_reject_handler();
+    if (reject_handler != bacnet_file_reject_handler) {
+        Reject_Handler_Next = reject_handler;
+    }
+    apdu_set_reject_handler(bacnet_file_reject_handler);
+}
@@ -0,0 +1,72 @@
+/**
+ * @file
+ * @brief API for the client AtomicReadFile and AtomicWriteFile transfers
+ * @author Steve Karg <skarg@users.sourceforge.net>
+ * @date 2024
+ * @copyright SPDX-License-Identifier: MIT
+ */
+#ifndef BACNET_BASIC_CLIENT_FILE_H
+#define BACNET_BASIC_CLIENT_FILE_H
+#include <stdbool.h>
+#include <stdint.h>
+/* BACnet Stack defines - first */
+#include "bacnet/bacdef.h"
+/* BACnet Stack API */
+#include "bacnet/bacenum.h"
+
+/* status of a file transfer */
+typedef enum bacnet_file_transfer_status {
+    /* no transfer was started */
+    BACNET_FILE_TRANSFER_IDLE,
+    /* chunks of the file are being transferred */
+    BACNET_FILE_TRANSFER_BUSY,
+    /* the whole file was transferred */
+    BACNET_FILE_TRANSFER_COMPLETE,
+    /* the transfer stopped with an error */
+    BACNET_FILE_TRANSFER_FAILED
+} BACNET_FILE_TRANSFER_STATUS;
+
+/* bacnet_file_transfer_init() sets the global Abort and Reject handlers
+   of the APDU layer, with apdu_set_abort_handler() and
+   apdu_set_reject_handler(), to learn why a chunk failed.  The handlers
+   that were set before it are called with every Abort and Reject.  An
+   application that sets its own Abort or Reject handler afterwards
+   replaces the handler of the transfer, and the transfer then reports
+   a failed chunk as a TSM timeout. */
+
+#ifdef __cplusplus
+extern "C" {
+#endif /* __cplusplus */
+
+BACNET_STACK_EXPORT
+void bacnet_file_transfer_init(void);
+BACNET_STACK_EXPORT
+void bacnet_file_transfer_task(void);
+BACNET_STACK_EXPORT
+bool bacnet_file_read_start(
+    uint32_t device_id, uint32_t file_instance, const char *pathname);
+BACNET_STACK_EXPORT
+bool bacnet_file_write_start(
+    uint32_t device_id, uint32_t file_instance, const char *pathname);
+BACNET_STACK_EXPORT
+void bacnet_file_transfer_stop(void);
+BACNET_STACK_EXPORT
+BACNET_FILE_TRANSFER_STATUS bacnet_file_transfer_status(void);
+BACNET_STACK_EXPORT
+void bacnet_file_transfer_error(
+    BACNET_ERROR_CLASS *error_class, BACNET_ERROR_CODE *error_code);
+BACNET_STACK_EXPORT
+unsigned long bacnet_file_transfer_octets(void);
+BACNET_STACK_EXPORT
+void bacnet_file_transfer_window_set(unsigned chunks);
+BACNET_STACK_EXPORT
+unsigned bacnet_file_transfer_window(void);
+BACNET_STACK_EXPORT
+void bacnet_file_transfer_chunk_size_set(unsigned octets);
+BACNET_STACK_EXPORT
+void bacnet_file_transfer_pad_set(bool pad, uint8_t value);
+
+#ifdef __cplusplus
+}
+#endif /* __cplusplus */
+#endif
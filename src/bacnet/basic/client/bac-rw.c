@@ -10,9 +10,13 @@
 #include <stdlib.h>
 #include "bacnet/abort.h"
 #include "bacnet/apdu.h"
+#include "bacnet/cov.h"
+#include "bacnet/dcc.h"
 #include "bacnet/iam.h"
+#include "bacnet/npdu.h"
 #include "bacnet/reject.h"
 #include "bacnet/rp.h"
+#include "bacnet/rpm.h"
 #include "bacnet/wp.h"
 #include "bacnet/datalink/datalink.h"
 #include "bacnet/basic/binding/address.h"
@@ -27,12 +31,12 @@
 /* timer for address cache */
 static struct mstimer Cache_Timer;
 #define CACHE_CYCLE_SECONDS 60
-/* timeout timer for read-write task */
-static struct mstimer Read_Write_Timer;
 /* where the data from the read is stored */
 static bacnet_read_write_value_callback_t bacnet_read_write_value_callback;
 /* where the data from the I-Am is called */
 static bacnet_read_write_device_callback_t bacnet_read_write_device_callback;
+/* where the result of a SubscribeCOV is reported */
+static bacnet_read_write_cov_callback_t bacnet_read_write_cov_callback;
 
 /* states for client task */
 typedef enum {
@@ -46,11 +50,18 @@ typedef enum {
 /* data queue */
 typedef struct target_data_t {
     bool write_property;
+    bool subscribe_cov;
     uint32_t device_id;
     uint32_t object_instance;
     BACNET_OBJECT_TYPE object_type;
     BACNET_PROPERTY_ID object_property;
     int32_t array_index;
+    /* caller storage of a ReadPropertyMultiple request, or NULL */
+    BACNET_READ_ACCESS_DATA *read_access_data;
+    /* SubscribeCOV process identifier, lifetime, and cancellation */
+    uint32_t process_id;
+    uint32_t lifetime;
+    bool cancel;
     uint8_t priority;
     /* application tag data type for writing */
     uint8_t tag;
@@ -70,17 +81,101 @@ typedef struct target_data_t {
 #endif
 static TARGET_DATA Target_Data_Buffer[TARGET_DATA_QUEUE_COUNT];
 static RING_BUFFER Target_Data_Queue;
+/* number of requests that are in flight at the same time */
+#ifndef BACNET_READ_WRITE_REQUESTS_MAX
+#define BACNET_READ_WRITE_REQUESTS_MAX 8
+#endif
+/* a request in flight */
+typedef struct read_write_request_t {
+    TARGET_DATA target;
+    /* the address and invoke id are needed to filter incoming messages */
+    BACNET_ADDRESS address;
+    unsigned max_apdu;
+    uint8_t invoke_id;
+    /* timeout timer for the binding and sending */
+    struct mstimer timer;
+    bool error_detected;
+    BACNET_ERROR_CLASS error_class;
+    BACNET_ERROR_CODE error_code;
+    BACNET_CLIENT_STATE state;
+} READ_WRITE_REQUEST;
+static READ_WRITE_REQUEST Read_Write_Request[BACNET_READ_WRITE_REQUESTS_MAX];
 /* local storage - keeps it off the c-stack */
 static BACNET_APPLICATION_DATA_VALUE Target_Decoded_Property_Value;
-/* the invoke id is needed to filter incoming messages */
-static uint8_t Request_Invoke_ID;
-static BACNET_ADDRESS Target_Address;
-static uint32_t Target_Device_ID;
+static uint8_t Read_Write_PDU[MAX_PDU];
 static uint16_t Target_Vendor_ID;
-static bool Error_Detected = false;
-static BACNET_ERROR_CLASS Error_Class;
-static BACNET_ERROR_CODE Error_Code;
-static BACNET_CLIENT_STATE RW_State = BACNET_CLIENT_IDLE;
+
+/**
+ * @brief Find the request in flight that matches a reply
+ * @param src [in] BACNET_ADDRESS of the source of the reply
+ * @param invoke_id [in] the invokeID of the reply
+ * @return the matching request, or NULL if none match
+ */
+static READ_WRITE_REQUEST *
+bacnet_read_write_request_find(BACNET_ADDRESS *src, uint8_t invoke_id)
+{
+    READ_WRITE_REQUEST *request;
+    unsigned i;
+
+    for (i = 0; i < BACNET_READ_WRITE_REQUESTS_MAX; i++) {
+        request = &Read_Write_Request[i];
+        if ((request->state == BACNET_CLIENT_WAITING) &&
+            (request->invoke_id == invoke_id) &&
+            address_match(&request->address, src)) {
+            return request;
+        }
+    }
+
+    return NULL;
+}
+
+/**
+ * @brief Count the requests in flight to a device
+ * @param device_id [in] device instance number
+ * @param state [in] only count requests in this state, or
+ *  BACNET_CLIENT_IDLE to count requests in any state
+ * @return number of requests in flight to the device
+ */
+static unsigned
+bacnet_read_write_device_count(uint32_t device_id, BACNET_CLIENT_STATE state)
+{
+    READ_WRITE_REQUEST *request;
+    unsigned i, count = 0;
+
+    for (i = 0; i < BACNET_READ_WRITE_REQUESTS_MAX; i++) {
+        request = &Read_Write_Request[i];
+        if ((request->state != BACNET_CLIENT_IDLE) &&
+            (request->target.device_id == device_id) &&
+            ((state == BACNET_CLIENT_IDLE) || (request->state == state))) {
+            count++;
+        }
+    }
+
+    return count;
+}
+
+/**
+ * @brief Flag an error for the request in flight that matches a reply
+ * @param src [in] BACNET_ADDRESS of the source of the reply
+ * @param invoke_id [in] the invokeID of the reply
+ * @param error_class [in] the error class
+ * @param error_code [in] the error code
+ */
+static void bacnet_read_write_request_error(
+    BACNET_ADDRESS *src,
+    uint8_t invoke_id,
+    BACNET_ERROR_CLASS error_class,
+    BACNET_ERROR_CODE error_code)
+{
+    READ_WRITE_REQUEST *request;
+
+    request = bacnet_read_write_request_find(src, invoke_id);
+    if (request) {
+        request->error_detected = true;
+        request->error_class = error_class;
+        request->error_code = error_code;
+    }
+}
 
 /**
  * @brief Handler for an Error PDU.
@@ -95,12 +190,7 @@ static void MyErrorHandler(
     BACNET_ERROR_CLASS error_class,
     BACNET_ERROR_CODE error_code)
 {
-    if (address_match(&Target_Address, src) &&
-        (invoke_id == Request_Invoke_ID)) {
-        Error_Detected = true;
-        Error_Class = error_class;
-        Error_Code = error_code;
-    }
+    bacnet_read_write_request_error(src, invoke_id, error_class, error_code);
 }
 
 /**
@@ -114,12 +204,9 @@ static void MyAbortHandler(
     BACNET_ADDRESS *src, uint8_t invoke_id, uint8_t abort_reason, bool server)
 {
     (void)server;
-    if (address_match(&Target_Address, src) &&
-        (invoke_id == Request_Invoke_ID)) {
-        Error_Detected = true;
-        Error_Class = ERROR_CLASS_SERVICES;
-        Error_Code = abort_convert_to_error_code(abort_reason);
-    }
+    bacnet_read_write_request_error(
+        src, invoke_id, ERROR_CLASS_SERVICES,
+        abort_convert_to_error_code(abort_reason));
 }
 
 /**
@@ -131,12 +218,9 @@ static void MyAbortHandler(
 static void
 MyRejectHandler(BACNET_ADDRESS *src, uint8_t invoke_id, uint8_t reject_reason)
 {
-    if (address_match(&Target_Address, src) &&
-        (invoke_id == Request_Invoke_ID)) {
-        Error_Detected = true;
-        Error_Class = ERROR_CLASS_SERVICES;
-        Error_Code = reject_convert_to_error_code(reject_reason);
-    }
+    bacnet_read_write_request_error(
+        src, invoke_id, ERROR_CLASS_SERVICES,
+        reject_convert_to_error_code(reject_reason));
 }
 
 /**
@@ -188,11 +272,9 @@ static void My_I_Am_Bind(
  * @param src [in] BACNET_ADDRESS of the source of the message
  * @param invoke_id [in] the invokeID from the rejected message
  */
-static void
-MyWritePropertySimpleAckHandler(BACNET_ADDRESS *src, uint8_t invoke_id)
+static void MySimpleAckHandler(BACNET_ADDRESS *src, uint8_t invoke_id)
 {
-    if (address_match(&Target_Address, src) &&
-        (invoke_id == Request_Invoke_ID)) {
+    if (bacnet_read_write_request_find(src, invoke_id)) {
         /* nothing to do */
     }
 }
@@ -296,21 +378,21 @@ static void My_Read_Property_Ack_Handler(
 {
     int len = 0;
     BACNET_READ_PROPERTY_DATA rp_data = { 0 };
-    uint32_t device_id = 0;
+    READ_WRITE_REQUEST *request;
 
-    if (address_match(&Target_Address, src) &&
-        (service_data->invoke_id == Request_Invoke_ID)) {
-        address_get_device_id(src, &device_id);
+    request = bacnet_read_write_request_find(src, service_data->invoke_id);
+    if (request) {
         rp_data.error_code = ERROR_CODE_SUCCESS;
         len = rp_ack_decode_service_request(
             service_request, service_len, &rp_data);
         if (len < 0) {
             /* unable to decode value */
-            Error_Detected = true;
-            Error_Class = ERROR_CLASS_SERVICES;
-            Error_Code = ERROR_CODE_INTERNAL_ERROR;
+            request->error_detected = true;
+            request->error_class = ERROR_CLASS_SERVICES;
+            request->error_code = ERROR_CODE_INTERNAL_ERROR;
         } else {
-            bacnet_read_property_ack_process(device_id, &rp_data);
+            bacnet_read_property_ack_process(
+                request->target.device_id, &rp_data);
         }
     }
 }
@@ -331,192 +413,311 @@ static void My_Read_Property_Multiple_Ack_Handler(
     BACNET_CONFIRMED_SERVICE_ACK_DATA *service_data)
 {
     BACNET_READ_PROPERTY_DATA rp_data = { 0 };
-    uint32_t device_id = 0;
+    READ_WRITE_REQUEST *request;
 
-    address_get_device_id(src, &device_id);
-    if (address_match(&Target_Address, src) &&
-        (service_data->invoke_id == Request_Invoke_ID)) {
+    request = bacnet_read_write_request_find(src, service_data->invoke_id);
+    if (request) {
         rp_data.error_code = ERROR_CODE_SUCCESS;
         rpm_ack_object_property_process(
-            apdu, apdu_len, device_id, &rp_data,
+            apdu, apdu_len, request->target.device_id, &rp_data,
             bacnet_read_property_ack_process);
     }
 }
 
 /**
- * @brief Sends a ReadPropertyMultiple service request
- * @param device_id [in] The contents of the service request.
- * @param object_type [in] The contents of the service request.
- * @param object_instance [in] The contents of the service request.
- * @return invoke_id of request
+ * @brief Fill the SubscribeCOV service data from a queued request
+ * @param target [in] queued SubscribeCOV request
+ * @param cov_data [out] SubscribeCOV service data
  */
-static uint8_t Send_RPM_All_Request(
-    uint32_t device_id,
-    BACNET_OBJECT_TYPE object_type,
-    uint32_t object_instance)
+static void bacnet_read_write_subscribe_cov_data(
+    const TARGET_DATA *target, BACNET_SUBSCRIBE_COV_DATA *cov_data)
+{
+    cov_data->subscriberProcessIdentifier = target->process_id;
+    cov_data->monitoredObjectIdentifier.type = target->object_type;
+    cov_data->monitoredObjectIdentifier.instance = target->object_instance;
+    cov_data->cancellationRequest = target->cancel;
+    cov_data->issueConfirmedNotifications = false;
+    cov_data->lifetime = target->lifetime;
+    cov_data->covSubscribeToProperty = false;
+    cov_data->covIncrementPresent = false;
+    cov_data->covIncrement = 0.0f;
+    cov_data->error_class = ERROR_CLASS_SERVICES;
+    cov_data->error_code = ERROR_CODE_SUCCESS;
+    cov_data->next = NULL;
+}
+
+/**
+ * @brief Encode the APDU of a request with its reserved invoke ID
+ * @param request [in] request in flight
+ * @param apdu [out] buffer for the APDU
+ * @param apdu_size [in] size of the APDU buffer
+ * @return number of bytes encoded, or zero if unable to encode
+ */
+static int bacnet_read_write_encode_apdu(
+    const READ_WRITE_REQUEST *request, uint8_t *apdu, size_t apdu_size)
 {
+    const TARGET_DATA *target = &request->target;
+    BACNET_WRITE_PROPERTY_DATA wp_data;
+    BACNET_READ_PROPERTY_DATA rp_data;
+    BACNET_SUBSCRIBE_COV_DATA cov_data;
     BACNET_READ_ACCESS_DATA read_access_data = { 0 };
     BACNET_PROPERTY_REFERENCE property_list = { 0 };
-    uint8_t pdu[MAX_PDU] = { 0 };
+    uint8_t *application_data;
+    int len = 0;
+
+    if (target->write_property) {
+        wp_data.object_type = target->object_type;
+        wp_data.object_instance = target->object_instance;
+        wp_data.object_property = target->object_property;
+        wp_data.array_index = target->array_index;
+        wp_data.priority = target->priority;
+        application_data = &wp_data.application_data[0];
+        switch (target->tag) {
+            case BACNET_APPLICATION_TAG_NULL:
+                len = encode_application_null(application_data);
+                break;
+            case BACNET_APPLICATION_TAG_BOOLEAN:
+                len = encode_application_boolean(
+                    application_data, target->type.Boolean);
+                break;
+            case BACNET_APPLICATION_TAG_REAL:
+                len = encode_application_real(
+                    application_data, target->type.Real);
+                break;
+            case BACNET_APPLICATION_TAG_UNSIGNED_INT:
+                len = encode_application_unsigned(
+                    application_data, target->type.Unsigned_Int);
+                break;
+            case BACNET_APPLICATION_TAG_SIGNED_INT:
+                len = encode_application_signed(
+                    application_data, target->type.Signed_Int);
+                break;
+            case BACNET_APPLICATION_TAG_ENUMERATED:
+                len = encode_application_enumerated(
+                    application_data, target->type.Enumerated);
+                break;
+            default:
+                break;
+        }
+        if (len > 0) {
+            wp_data.application_data_len = len;
+            len = wp_encode_apdu(apdu, request->invoke_id, &wp_data);
+        }
+    } else if (target->subscribe_cov) {
+        bacnet_read_write_subscribe_cov_data(target, &cov_data);
+        len = cov_subscribe_encode_apdu(
+            apdu, apdu_size, request->invoke_id, &cov_data);
+    } else if (target->read_access_data) {
+        len = rpm_encode_apdu(
+            apdu, apdu_size, request->invoke_id, target->read_access_data);
+    } else if (target->object_property == PROP_ALL) {
+        /* configure the property list */
+        property_list.error.error_class = ERROR_CLASS_DEVICE;
+        property_list.error.error_code = ERROR_CODE_OTHER;
+        property_list.value = NULL;
+        property_list.propertyArrayIndex = BACNET_ARRAY_ALL;
+        property_list.propertyIdentifier = PROP_ALL;
+        property_list.next = NULL;
+        /* configure the read access data */
+        read_access_data.listOfProperties = &property_list;
+        read_access_data.object_instance = target->object_instance;
+        read_access_data.object_type = target->object_type;
+        read_access_data.next = NULL;
+        len = rpm_encode_apdu(
+            apdu, apdu_size, request->invoke_id, &read_access_data);
+    } else {
+        rp_data.object_type = target->object_type;
+        rp_data.object_instance = target->object_instance;
+        rp_data.object_property = target->object_property;
+        rp_data.array_index = target->array_index;
+        len = rp_encode_apdu(apdu, request->invoke_id, &rp_data);
+    }
 
-    /* configure the property list */
-    property_list.error.error_class = ERROR_CLASS_DEVICE;
-    property_list.error.error_code = ERROR_CODE_OTHER;
-    property_list.value = NULL;
-    property_list.propertyArrayIndex = BACNET_ARRAY_ALL;
-    property_list.propertyIdentifier = PROP_ALL;
-    property_list.next = NULL;
-    /* configure the read access data */
-    read_access_data.listOfProperties = &property_list;
-    read_access_data.object_instance = object_instance;
-    read_access_data.object_type = object_type;
-    read_access_data.next = NULL;
+    return len;
+}
 
-    return Send_Read_Property_Multiple_Request(
-        pdu, sizeof(pdu), device_id, &read_access_data);
+/**
+ * @brief Send a request to its bound device with its reserved invoke ID
+ * @param request [in] request in flight
+ * @return true if the request was sent, false if it could not be encoded
+ *  or is too long for the device
+ */
+static bool bacnet_read_write_send(READ_WRITE_REQUEST *request)
+{
+    BACNET_ADDRESS my_address;
+    BACNET_NPDU_DATA npdu_data;
+    int pdu_len = 0;
+    int len = 0;
+
+    datalink_get_my_address(&my_address);
+    npdu_encode_npdu_data(&npdu_data, true, MESSAGE_PRIORITY_NORMAL);
+    pdu_len = npdu_encode_pdu(
+        &Read_Write_PDU[0], &request->address, &my_address, &npdu_data);
+    len = bacnet_read_write_encode_apdu(
+        request, &Read_Write_PDU[pdu_len], sizeof(Read_Write_PDU) - pdu_len);
+    if (len <= 0) {
+        return false;
+    }
+    pdu_len += len;
+    /* will it fit in the device? */
+    if ((unsigned)pdu_len >= request->max_apdu) {
+        return false;
+    }
+    tsm_set_confirmed_unsegmented_transaction(
+        request->invoke_id, &request->address, &npdu_data, &Read_Write_PDU[0],
+        (uint16_t)pdu_len);
+    (void)datalink_send_pdu(
+        &request->address, &npdu_data, &Read_Write_PDU[0], pdu_len);
+
+    return true;
 }
 
 /**
- * @brief Handles the ReadProperty process
- * @param service_request [in] The contents of the service request.
+ * @brief Flag an error for a request, and finish it
+ * @param request [in] request in flight
+ * @param error_code [in] the error code
+ */
+static void bacnet_read_write_abandon(
+    READ_WRITE_REQUEST *request, BACNET_ERROR_CODE error_code)
+{
+    request->error_detected = true;
+    request->error_class = ERROR_CLASS_SERVICES;
+    request->error_code = error_code;
+    request->state = BACNET_CLIENT_FINISHED;
+}
+
+/**
+ * @brief Starts a request in flight
+ * @param request [in] request with the target data to start
+ * @param invoke_id [in] invoke ID reserved in the TSM for the request
+ */
+static void
+bacnet_read_write_start(READ_WRITE_REQUEST *request, uint8_t invoke_id)
+{
+    mstimer_set(&request->timer, apdu_timeout());
+    request->invoke_id = invoke_id;
+    request->error_detected = false;
+    if (request->target.device_id < BACNET_MAX_INSTANCE) {
+        request->state = BACNET_CLIENT_BIND;
+    } else {
+        tsm_free_invoke_id(invoke_id);
+        request->state = BACNET_CLIENT_FINISHED;
+    }
+}
+
+/**
+ * @brief Handles the ReadProperty or WriteProperty process of a request
+ * @param request [in] request in flight
  * @return true if the process is finished
  */
-static bool bacnet_read_write_process(const TARGET_DATA *target)
+static bool bacnet_read_write_process(READ_WRITE_REQUEST *request)
 {
+    const TARGET_DATA *target = &request->target;
     bool found = false;
-    unsigned max_apdu = 0;
-    uint8_t application_data[16] = { 0 };
-    int application_data_len = 0;
-    bool valid_tag = false;
-
-    switch (RW_State) {
-        case BACNET_CLIENT_IDLE:
-            mstimer_set(&Read_Write_Timer, apdu_timeout());
-            if (target->device_id < BACNET_MAX_INSTANCE) {
-                Error_Detected = false;
-                RW_State = BACNET_CLIENT_BIND;
-            } else {
-                RW_State = BACNET_CLIENT_FINISHED;
-            }
-            break;
+
+    switch (request->state) {
         case BACNET_CLIENT_BIND:
             /* exclude our device - in case our ID changed */
             address_own_device_id_set(Device_Object_Instance_Number());
             /* try to bind with the device */
             found = address_bind_request(
-                target->device_id, &max_apdu, &Target_Address);
+                target->device_id, &request->max_apdu, &request->address);
             if (found) {
-                Target_Device_ID = target->device_id;
-                RW_State = BACNET_CLIENT_SEND;
+                request->state = BACNET_CLIENT_SEND;
             } else {
-                Send_WhoIs(target->device_id, target->device_id);
-                RW_State = BACNET_CLIENT_BINDING;
+                /* one Who-Is is enough for all requests to this device */
+                if (bacnet_read_write_device_count(
+                        target->device_id, BACNET_CLIENT_BINDING) == 0) {
+                    Send_WhoIs(target->device_id, target->device_id);
+                }
+                request->state = BACNET_CLIENT_BINDING;
             }
             break;
         case BACNET_CLIENT_BINDING:
             found = address_bind_request(
-                target->device_id, &max_apdu, &Target_Address);
+                target->device_id, &request->max_apdu, &request->address);
             if (found) {
-                Target_Device_ID = target->device_id;
-                mstimer_set(&Read_Write_Timer, apdu_timeout());
-                RW_State = BACNET_CLIENT_SEND;
-            } else if (mstimer_expired(&Read_Write_Timer)) {
+                mstimer_set(&request->timer, apdu_timeout());
+                request->state = BACNET_CLIENT_SEND;
+            } else if (mstimer_expired(&request->timer)) {
                 /* unable to bind within APDU timeout */
-                Error_Detected = true;
-                Error_Class = ERROR_CLASS_SERVICES;
-                Error_Code = ERROR_CODE_TIMEOUT;
-                RW_State = BACNET_CLIENT_FINISHED;
+                tsm_free_invoke_id(request->invoke_id);
+                bacnet_read_write_abandon(request, ERROR_CODE_TIMEOUT);
             }
             break;
         case BACNET_CLIENT_SEND:
-            if (target->write_property) {
-                switch (target->tag) {
-                    case BACNET_APPLICATION_TAG_NULL:
-                        application_data_len =
-                            encode_application_null(&application_data[0]);
-                        valid_tag = true;
-                        break;
-                    case BACNET_APPLICATION_TAG_BOOLEAN:
-                        application_data_len = encode_application_boolean(
-                            &application_data[0], target->type.Boolean);
-                        valid_tag = true;
-                        break;
-                    case BACNET_APPLICATION_TAG_REAL:
-                        application_data_len = encode_application_real(
-                            &application_data[0], target->type.Real);
-                        valid_tag = true;
-                        break;
-                    case BACNET_APPLICATION_TAG_UNSIGNED_INT:
-                        application_data_len = encode_application_unsigned(
-                            &application_data[0], target->type.Unsigned_Int);
-                        valid_tag = true;
-                        break;
-                    case BACNET_APPLICATION_TAG_SIGNED_INT:
-                        application_data_len = encode_application_signed(
-                            &application_data[0], target->type.Signed_Int);
-                        valid_tag = true;
-                        break;
-                    case BACNET_APPLICATION_TAG_ENUMERATED:
-                        application_data_len = encode_application_enumerated(
-                            &application_data[0], target->type.Enumerated);
-                        valid_tag = true;
-                        break;
-                    default:
-                        break;
-                }
-                if (valid_tag) {
-                    Request_Invoke_ID = Send_Write_Property_Request_Data(
-                        target->device_id, target->object_type,
-                        target->object_instance, target->object_property,
-                        &application_data[0], application_data_len,
-                        target->priority, target->array_index);
-                }
-            } else {
-                if (target->object_property == PROP_ALL) {
-                    Request_Invoke_ID = Send_RPM_All_Request(
-                        target->device_id, target->object_type,
-                        target->object_instance);
-                } else {
-                    Request_Invoke_ID = Send_Read_Property_Request(
-                        target->device_id, target->object_type,
-                        target->object_instance, target->object_property,
-                        target->array_index);
-                }
-            }
-            if (Request_Invoke_ID == 0) {
-                if (mstimer_expired(&Read_Write_Timer)) {
-                    /* TSM Timeout - no invokeIDs available */
-                    Error_Detected = true;
-                    Error_Class = ERROR_CLASS_SERVICES;
-                    Error_Code = ERROR_CODE_TIMEOUT;
-                    RW_State = BACNET_CLIENT_FINISHED;
+            if (!dcc_communication_enabled()) {
+                if (mstimer_expired(&request->timer)) {
+                    tsm_free_invoke_id(request->invoke_id);
+                    bacnet_read_write_abandon(request, ERROR_CODE_TIMEOUT);
                 }
+            } else if (bacnet_read_write_send(request)) {
+                request->state = BACNET_CLIENT_WAITING;
             } else {
-                RW_State = BACNET_CLIENT_WAITING;
+                tsm_free_invoke_id(request->invoke_id);
+                bacnet_read_write_abandon(
+                    request, ERROR_CODE_ABORT_APDU_TOO_LONG);
             }
             break;
         case BACNET_CLIENT_WAITING:
-            if (Error_Detected) {
-                RW_State = BACNET_CLIENT_FINISHED;
-            } else if (tsm_invoke_id_free(Request_Invoke_ID)) {
-                Error_Detected = false;
-                RW_State = BACNET_CLIENT_FINISHED;
-            } else if (tsm_invoke_id_failed(Request_Invoke_ID)) {
-                Error_Detected = true;
-                Error_Class = ERROR_CLASS_SERVICES;
-                Error_Code = ERROR_CODE_ABORT_TSM_TIMEOUT;
-                RW_State = BACNET_CLIENT_FINISHED;
-                tsm_free_invoke_id(Request_Invoke_ID);
+            if (request->error_detected) {
+                request->state = BACNET_CLIENT_FINISHED;
+            } else if (tsm_invoke_id_free(request->invoke_id)) {
+                request->error_detected = false;
+                request->state = BACNET_CLIENT_FINISHED;
+            } else if (tsm_invoke_id_failed(request->invoke_id)) {
+                tsm_free_invoke_id(request->invoke_id);
+                bacnet_read_write_abandon(
+                    request, ERROR_CODE_ABORT_TSM_TIMEOUT);
             }
             break;
-        case BACNET_CLIENT_FINISHED:
-            RW_State = BACNET_CLIENT_IDLE;
-            break;
         default:
             break;
     }
 
-    return (RW_State == BACNET_CLIENT_FINISHED);
+    return (request->state == BACNET_CLIENT_FINISHED);
+}
+
+/**
+ * @brief Moves queued requests into flight, oldest first, while there
+ *  are free request slots and free TSM transactions.  A queued request
+ *  to a device that already has its limit of requests in flight waits,
+ *  and the following requests to other devices are started instead.
+ *  The invoke ID of each request is reserved in the TSM when it starts,
+ *  so the requests in flight never need more transactions than exist.
+ */
+static void bacnet_read_write_dispatch(void)
+{
+    READ_WRITE_REQUEST *request;
+    TARGET_DATA *target;
+    uint8_t invoke_id;
+    unsigned i;
+
+    for (i = 0; i < BACNET_READ_WRITE_REQUESTS_MAX; i++) {
+        request = &Read_Write_Request[i];
+        if (request->state != BACNET_CLIENT_IDLE) {
+            continue;
+        }
+        target = (TARGET_DATA *)Ringbuf_Peek(&Target_Data_Queue);
+        while (target &&
+               (bacnet_read_write_device_count(
+                    target->device_id, BACNET_CLIENT_IDLE) >=
+                BACNET_READ_WRITE_DEVICE_REQUESTS_MAX)) {
+            target = (TARGET_DATA *)Ringbuf_Peek_Next(
+                &Target_Data_Queue, (uint8_t *)target);
+        }
+        if (!target) {
+            break;
+        }
+        invoke_id = tsm_next_free_invokeID();
+        if (invoke_id == 0) {
+            break;
+        }
+        Ringbuf_Pop_Element(
+            &Target_Data_Queue, (uint8_t *)target,
+            (uint8_t *)&request->target);
+        bacnet_read_write_start(request, invoke_id);
+    }
 }
 
 /**
@@ -542,31 +743,66 @@ void bacnet_read_write_device_callback_set(
 }
 
 /**
- * @brief Handles the ReadProperty repetitive task
+ * @brief Sets the callback for when a SubscribeCOV request is finished
+ *
+ * @param callback - function for callback
  */
-void bacnet_read_write_task(void)
+void bacnet_read_write_cov_callback_set(
+    bacnet_read_write_cov_callback_t callback)
 {
-    TARGET_DATA *target;
-    bool status = false;
+    bacnet_read_write_cov_callback = callback;
+}
+
+/**
+ * @brief Reports the result of a finished request
+ * @param request [in] finished request
+ */
+static void bacnet_read_write_finished(const READ_WRITE_REQUEST *request)
+{
+    const TARGET_DATA *target = &request->target;
     BACNET_READ_PROPERTY_DATA rp_data;
+    BACNET_SUBSCRIBE_COV_DATA cov_data;
 
-    if (!Ringbuf_Empty(&Target_Data_Queue)) {
-        target = (TARGET_DATA *)Ringbuf_Peek(&Target_Data_Queue);
-        status = bacnet_read_write_process(target);
-        if (status) {
-            if (Error_Detected) {
-                if (bacnet_read_write_value_callback) {
-                    rp_data.error_class = Error_Class;
-                    rp_data.error_code = Error_Code;
-                    rp_data.object_type = target->object_type;
-                    rp_data.object_instance = target->object_instance;
-                    rp_data.object_property = target->object_property;
-                    rp_data.array_index = target->array_index;
-                    bacnet_read_write_value_callback(
-                        target->device_id, &rp_data, NULL);
-                }
+    if (target->subscribe_cov) {
+        if (bacnet_read_write_cov_callback) {
+            bacnet_read_write_subscribe_cov_data(target, &cov_data);
+            if (request->error_detected) {
+                cov_data.error_class = request->error_class;
+                cov_data.error_code = request->error_code;
             }
-            Ringbuf_Pop(&Target_Data_Queue, NULL);
+            bacnet_read_write_cov_callback(target->device_id, &cov_data);
+        }
+    } else if (request->error_detected) {
+        if (bacnet_read_write_value_callback) {
+            rp_data.error_class = request->error_class;
+            rp_data.error_code = request->error_code;
+            rp_data.object_type = target->object_type;
+            rp_data.object_instance = target->object_instance;
+            rp_data.object_property = target->object_property;
+            rp_data.array_index = target->array_index;
+            bacnet_read_write_value_callback(
+                target->device_id, &rp_data, NULL);
+        }
+    }
+}
+
+/**
+ * @brief Handles the ReadProperty repetitive task
+ */
+void bacnet_read_write_task(void)
+{
+    READ_WRITE_REQUEST *request;
+    unsigned i;
+
+    bacnet_read_write_dispatch();
+    for (i = 0; i < BACNET_READ_WRITE_REQUESTS_MAX; i++) {
+        request = &Read_Write_Request[i];
+        if (request->state == BACNET_CLIENT_IDLE) {
+            continue;
+        }
+        if (bacnet_read_write_process(request)) {
+            bacnet_read_write_finished(request);
+            request->state = BACNET_CLIENT_IDLE;
         }
     }
     if (mstimer_expired(&Cache_Timer)) {
@@ -596,9 +832,10 @@ bool bacnet_read_property_queue(
     uint32_t array_index)
 {
     bool status = false;
-    TARGET_DATA target;
+    TARGET_DATA target = { 0 };
 
     target.write_property = false;
+    target.read_access_data = NULL;
     target.device_id = device_id;
     target.object_type = object_type;
     target.object_instance = object_instance;
@@ -609,6 +846,76 @@ bool bacnet_read_property_queue(
     return status;
 }
 
+/**
+ * @brief Adds a ReadPropertyMultiple request of a remote device
+ * @param device_id - ID of the destination device
+ * @param read_access_data - list of objects and properties to read.
+ *  The storage is owned by the caller, and must not change until
+ *  bacnet_read_write_device_idle() returns true for this device.
+ *  Errors of the whole request are reported with the first object
+ *  and property of the list.
+ * @return true if added, false if not added
+ */
+bool bacnet_read_property_multiple_queue(
+    uint32_t device_id, BACNET_READ_ACCESS_DATA *read_access_data)
+{
+    bool status = false;
+    TARGET_DATA target = { 0 };
+
+    if (!read_access_data || !read_access_data->listOfProperties) {
+        return false;
+    }
+    target.write_property = false;
+    target.read_access_data = read_access_data;
+    target.device_id = device_id;
+    target.object_type = read_access_data->object_type;
+    target.object_instance = read_access_data->object_instance;
+    target.object_property =
+        read_access_data->listOfProperties->propertyIdentifier;
+    target.array_index = read_access_data->listOfProperties->propertyArrayIndex;
+    status = Ringbuf_Put(&Target_Data_Queue, (uint8_t *)&target);
+
+    return status;
+}
+
+/**
+ * @brief Adds a SubscribeCOV request for a remote object.  The
+ *  subscription asks for unconfirmed notifications, and the result
+ *  is reported to the callback set by bacnet_read_write_cov_callback_set().
+ * @param device_id - ID of the destination device
+ * @param object_type - Type of the monitored object
+ * @param object_instance - Instance # of the monitored object
+ * @param process_id - subscriber process identifier
+ * @param lifetime - lifetime of the subscription in seconds, 0=indefinite
+ * @param cancel - true to cancel the subscription
+ * @return true if added, false if not added
+ */
+bool bacnet_subscribe_cov_queue(
+    uint32_t device_id,
+    BACNET_OBJECT_TYPE object_type,
+    uint32_t object_instance,
+    uint32_t process_id,
+    uint32_t lifetime,
+    bool cancel)
+{
+    bool status = false;
+    TARGET_DATA target = { 0 };
+
+    target.subscribe_cov = true;
+    target.read_access_data = NULL;
+    target.device_id = device_id;
+    target.object_type = object_type;
+    target.object_instance = object_instance;
+    target.object_property = PROP_ALL;
+    target.array_index = BACNET_ARRAY_ALL;
+    target.process_id = process_id;
+    target.lifetime = lifetime;
+    target.cancel = cancel;
+    status = Ringbuf_Put(&Target_Data_Queue, (uint8_t *)&target);
+
+    return status;
+}
+
 /**
  * @brief Adds a WriteProperty request to a remote data point - REAL
  * @param device_id - ID of the destination device
@@ -637,6 +944,7 @@ bool bacnet_write_property_real_queue(
     TARGET_DATA target = { 0 };
 
     target.write_property = true;
+    target.read_access_data = NULL;
     target.device_id = device_id;
     target.object_type = object_type;
     target.object_instance = object_instance;
@@ -677,6 +985,7 @@ bool bacnet_write_property_null_queue(
     TARGET_DATA target = { 0 };
 
     target.write_property = true;
+    target.read_access_data = NULL;
     target.device_id = device_id;
     target.object_type = object_type;
     target.object_instance = object_instance;
@@ -714,9 +1023,10 @@ bool bacnet_write_property_enumerated_queue(
     uint32_t array_index)
 {
     bool status = false;
-    TARGET_DATA target;
+    TARGET_DATA target = { 0 };
 
     target.write_property = true;
+    target.read_access_data = NULL;
     target.device_id = device_id;
     target.object_type = object_type;
     target.object_instance = object_instance;
@@ -755,9 +1065,10 @@ bool bacnet_write_property_unsigned_queue(
     uint32_t array_index)
 {
     bool status = false;
-    TARGET_DATA target;
+    TARGET_DATA target = { 0 };
 
     target.write_property = true;
+    target.read_access_data = NULL;
     target.device_id = device_id;
     target.object_type = object_type;
     target.object_instance = object_instance;
@@ -796,9 +1107,10 @@ bool bacnet_write_property_signed_queue(
     uint32_t array_index)
 {
     bool status = false;
-    TARGET_DATA target;
+    TARGET_DATA target = { 0 };
 
     target.write_property = true;
+    target.read_access_data = NULL;
     target.device_id = device_id;
     target.object_type = object_type;
     target.object_instance = object_instance;
@@ -837,9 +1149,10 @@ bool bacnet_write_property_boolean_queue(
     uint32_t array_index)
 {
     bool status = false;
-    TARGET_DATA target;
+    TARGET_DATA target = { 0 };
 
     target.write_property = true;
+    target.read_access_data = NULL;
     target.device_id = device_id;
     target.object_type = object_type;
     target.object_instance = object_instance;
@@ -855,13 +1168,46 @@ bool bacnet_write_property_boolean_queue(
 
 /**
  * @brief Determines if the BACnet ReadProperty queue is empty
+ *  and no requests are in flight
  * @return true if the parameter queue is empty, and thus, idle
  */
 bool bacnet_read_write_idle(void)
 {
+    unsigned i;
+
+    for (i = 0; i < BACNET_READ_WRITE_REQUESTS_MAX; i++) {
+        if (Read_Write_Request[i].state != BACNET_CLIENT_IDLE) {
+            return false;
+        }
+    }
+
     return Ringbuf_Empty(&Target_Data_Queue);
 }
 
+/**
+ * @brief Determines if no requests are queued or in flight for a device
+ * @param device_id - ID of the destination device
+ * @return true if no requests are queued or in flight for the device
+ */
+bool bacnet_read_write_device_idle(uint32_t device_id)
+{
+    const TARGET_DATA *target;
+
+    if (bacnet_read_write_device_count(device_id, BACNET_CLIENT_IDLE) > 0) {
+        return false;
+    }
+    target = (const TARGET_DATA *)Ringbuf_Peek(&Target_Data_Queue);
+    while (target) {
+        if (target->device_id == device_id) {
+            return false;
+        }
+        target = (const TARGET_DATA *)Ringbuf_Peek_Next(
+            &Target_Data_Queue, (const uint8_t *)target);
+    }
+
+    return true;
+}
+
 /**
  * @brief Determines if the BACnet ReadProperty queue is full
  * @return true if the parameter queue is full, and thus, busy
@@ -896,6 +1242,11 @@ uint16_t bacnet_read_write_vendor_id_filter(void)
  */
 void bacnet_read_write_init(void)
 {
+    unsigned i;
+
+    for (i = 0; i < BACNET_READ_WRITE_REQUESTS_MAX; i++) {
+        Read_Write_Request[i].state = BACNET_CLIENT_IDLE;
+    }
     Ringbuf_Initialize(
         &Target_Data_Queue, (uint8_t *)&Target_Data_Buffer,
         sizeof(Target_Data_Buffer), TARGET_DATA_QUEUE_SIZE,
@@ -910,10 +1261,15 @@ void bacnet_read_write_init(void)
         My_Read_Property_Multiple_Ack_Handler);
     /* handle the Simple ACK coming back */
     apdu_set_confirmed_simple_ack_handler(
-        SERVICE_CONFIRMED_WRITE_PROPERTY, MyWritePropertySimpleAckHandler);
+        SERVICE_CONFIRMED_WRITE_PROPERTY, MySimpleAckHandler);
+    apdu_set_confirmed_simple_ack_handler(
+        SERVICE_CONFIRMED_SUBSCRIBE_COV, MySimpleAckHandler);
     /* handle any errors coming back */
     apdu_set_error_handler(SERVICE_CONFIRMED_READ_PROPERTY, MyErrorHandler);
+    apdu_set_error_handler(
+        SERVICE_CONFIRMED_READ_PROP_MULTIPLE, MyErrorHandler);
     apdu_set_error_handler(SERVICE_CONFIRMED_WRITE_PROPERTY, MyErrorHandler);
+    apdu_set_error_handler(SERVICE_CONFIRMED_SUBSCRIBE_COV, MyErrorHandler);
     apdu_set_abort_handler(MyAbortHandler);
     apdu_set_reject_handler(MyRejectHandler);
     /* configure the address cache */
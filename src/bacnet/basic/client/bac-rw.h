@@ -12,7 +12,22 @@
 #include "bacnet/bacdef.h"
 /* BACnet Stack API */
 #include "bacnet/bacapp.h"
+#include "bacnet/cov.h"
 #include "bacnet/rp.h"
+#include "bacnet/rpm.h"
+
+/* Number of requests that are in flight to any one device.
+   This is a fixed limit rather than one derived from each device: the
+   address cache keeps only the max APDU of a bound device, not its
+   segmentation or window size, and the TSM neither sends nor accepts
+   segmented messages.  Small devices, notably on MS/TP, may serve only
+   one confirmed request at a time and drop or abort the others, so one
+   request per device is the safe default; the requests to other devices
+   are dispatched meanwhile, up to BACNET_READ_WRITE_REQUESTS_MAX and the
+   free TSM transactions. */
+#ifndef BACNET_READ_WRITE_DEVICE_REQUESTS_MAX
+#define BACNET_READ_WRITE_DEVICE_REQUESTS_MAX 1
+#endif
 
 /**
  * Save the requested ReadProperty data to a data store
@@ -42,6 +57,16 @@ typedef void (*bacnet_read_write_device_callback_t)(
     int segmentation,
     uint16_t vendor_id);
 
+/**
+ * Report the result of a SubscribeCOV request
+ *
+ * @param device_instance [in] device instance number of the request
+ * @param cov_data [in] the subscription that was requested, with the
+ *  error class and code set, or ERROR_CODE_SUCCESS if acknowledged
+ */
+typedef void (*bacnet_read_write_cov_callback_t)(
+    uint32_t device_instance, BACNET_SUBSCRIBE_COV_DATA *cov_data);
+
 #ifdef __cplusplus
 extern "C" {
 #endif /* __cplusplus */
@@ -55,6 +80,8 @@ bool bacnet_read_write_idle(void);
 BACNET_STACK_EXPORT
 bool bacnet_read_write_busy(void);
 BACNET_STACK_EXPORT
+bool bacnet_read_write_device_idle(uint32_t device_id);
+BACNET_STACK_EXPORT
 bool bacnet_read_property_queue(
     uint32_t device_id,
     BACNET_OBJECT_TYPE object_type,
@@ -62,6 +89,17 @@ bool bacnet_read_property_queue(
     BACNET_PROPERTY_ID object_property,
     uint32_t array_index);
 BACNET_STACK_EXPORT
+bool bacnet_read_property_multiple_queue(
+    uint32_t device_id, BACNET_READ_ACCESS_DATA *read_access_data);
+BACNET_STACK_EXPORT
+bool bacnet_subscribe_cov_queue(
+    uint32_t device_id,
+    BACNET_OBJECT_TYPE object_type,
+    uint32_t object_instance,
+    uint32_t process_id,
+    uint32_t lifetime,
+    bool cancel);
+BACNET_STACK_EXPORT
 bool bacnet_write_property_real_queue(
     uint32_t device_id,
     BACNET_OBJECT_TYPE object_type,
@@ -121,6 +159,9 @@ BACNET_STACK_EXPORT
 void bacnet_read_write_device_callback_set(
     bacnet_read_write_device_callback_t callback);
 BACNET_STACK_EXPORT
+void bacnet_read_write_cov_callback_set(
+    bacnet_read_write_cov_callback_t callback);
+BACNET_STACK_EXPORT
 void bacnet_read_write_vendor_id_filter_set(uint16_t vendor_id);
 BACNET_STACK_EXPORT
 uint16_t bacnet_read_write_vendor_id_filter(void);
@@ -219,8 +219,8 @@ int Access_Rights_Read_Property(BACNET_READ_PROPERTY_DATA *rpdata)
             break;
         case PROP_OBJECT_NAME:
             Access_Rights_Object_Name(rpdata->object_instance, &char_string);
-            apdu_len =
-                encode_application_character_string(&apdu[0], &char_string);
+            apdu_len = read_property_character_string_encode(
+                rpdata, &apdu[0], &char_string);
             break;
         case PROP_OBJECT_TYPE:
             apdu_len =
@@ -18,6 +18,7 @@
 #include "bacnet/bacerror.h"
 #include "bacnet/wp.h"
 #include "bacnet/rp.h"
+#include "bacnet/rpm.h"
 #if defined(INTRINSIC_REPORTING)
 #include "bacnet/basic/object/nc.h"
 #include "bacnet/alarm_ack.h"
@@ -80,6 +81,9 @@ const char *Analog_Value_Name_ASCII(uint32_t object_instance);
 
 BACNET_STACK_EXPORT
 int Analog_Value_Read_Property(BACNET_READ_PROPERTY_DATA *rpdata);
+BACNET_STACK_EXPORT
+int Analog_Value_Read_Property_Multiple(
+    BACNET_WRITER *writer, BACNET_READ_PROPERTY_DATA *rpdata);
 
 BACNET_STACK_EXPORT
 bool Analog_Value_Write_Property(BACNET_WRITE_PROPERTY_DATA *wp_data);
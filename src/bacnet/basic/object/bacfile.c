@@ -10,6 +10,11 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#if defined(_WIN32) || defined(__unix__) || defined(__APPLE__)
+#include <sys/types.h>
+#include <sys/stat.h>
+#define BACFILE_STAT_ENABLED 1
+#endif
 /* BACnet Stack defines - first */
 #include "bacnet/bacdef.h"
 /* BACnet Stack API */
@@ -32,17 +37,45 @@
 #ifndef FILE_RECORD_SIZE
 #define FILE_RECORD_SIZE MAX_OCTET_STRING_BYTES
 #endif
+/* number of files kept open between AtomicReadFile and AtomicWriteFile
+   requests; the least recently used file is closed to open another */
+#ifndef BACFILE_HANDLES_MAX
+#define BACFILE_HANDLES_MAX 4
+#endif
 struct object_data {
     char *Object_Name;
     char *Pathname;
     char *File_Type;
     BACNET_DATE_TIME Modification_Date;
+    /* open file, and its size while it is open */
+    FILE *File_Handle;
+    long File_Size;
+#if defined(BACFILE_STAT_ENABLED)
+    time_t File_Modified;
+#endif
+    unsigned long File_Handle_Used;
+    bool File_Handle_Update : 1;
+    bool File_Size_Valid : 1;
     bool File_Access_Stream : 1;
     bool Read_Only : 1;
     bool Archive : 1;
 };
+/* ways to open the file of an object */
+enum bacfile_open_mode {
+    /* read only */
+    BACFILE_OPEN_READ,
+    /* read and write an existing file */
+    BACFILE_OPEN_UPDATE,
+    /* read and write, creating the file if it does not exist */
+    BACFILE_OPEN_CREATE,
+    /* read and write a new empty file */
+    BACFILE_OPEN_TRUNCATE
+};
 /* Key List for storing the object data sorted by instance number  */
 static OS_Keylist Object_List;
+/* number of open files, and the use counter of the open files */
+static unsigned File_Handle_Count;
+static unsigned long File_Handle_Sequence;
 /* common object type */
 static const BACNET_OBJECT_TYPE Object_Type = OBJECT_FILE;
 /* These three arrays are used by the ReadPropertyMultiple handler */
@@ -102,6 +135,177 @@ static char *bacfile_strdup(const char *s)
     return p;
 }
 
+/**
+ * @brief Determines the file size for a given file
+ * @param  pFile - file handle
+ * @return  file size in bytes, or 0 if not found
+ */
+static long fsize(FILE *pFile)
+{
+    long size = 0;
+    long origin = 0;
+
+    if (pFile) {
+        origin = ftell(pFile);
+        fseek(pFile, 0L, SEEK_END);
+        size = ftell(pFile);
+        fseek(pFile, origin, SEEK_SET);
+    }
+    return (size);
+}
+
+/**
+ * @brief Close the open file of an object, if any
+ * @param pObject - object data
+ */
+static void bacfile_handle_close(struct object_data *pObject)
+{
+    if (pObject->File_Handle) {
+        fclose(pObject->File_Handle);
+        pObject->File_Handle = NULL;
+        if (File_Handle_Count > 0) {
+            File_Handle_Count--;
+        }
+    }
+    pObject->File_Size_Valid = false;
+}
+
+/**
+ * @brief Close the least recently used open file
+ */
+static void bacfile_handle_close_oldest(void)
+{
+    struct object_data *pObject, *pOldest = NULL;
+    int count, index;
+
+    count = Keylist_Count(Object_List);
+    for (index = 0; index < count; index++) {
+        pObject = Keylist_Data_Index(Object_List, index);
+        if (pObject && pObject->File_Handle) {
+            /* the difference from the counter is safe when it wraps */
+            if (!pOldest ||
+                ((File_Handle_Sequence - pObject->File_Handle_Used) >
+                 (File_Handle_Sequence - pOldest->File_Handle_Used))) {
+                pOldest = pObject;
+            }
+        }
+    }
+    if (pOldest) {
+        bacfile_handle_close(pOldest);
+    }
+}
+
+/**
+ * @brief Get the open file of an object, opening the file if needed.
+ *  The file is kept open for the next request.
+ * @param pObject - object data
+ * @param mode - how the file is to be used
+ * @return file handle, or NULL if the file could not be opened
+ */
+static FILE *
+bacfile_handle(struct object_data *pObject, enum bacfile_open_mode mode)
+{
+    FILE *pFile = NULL;
+
+    if (!pObject->Pathname) {
+        return NULL;
+    }
+    if (pObject->File_Handle &&
+        ((mode == BACFILE_OPEN_READ) ||
+         ((mode != BACFILE_OPEN_TRUNCATE) && pObject->File_Handle_Update))) {
+        pFile = pObject->File_Handle;
+    } else {
+        bacfile_handle_close(pObject);
+        if (File_Handle_Count >= BACFILE_HANDLES_MAX) {
+            bacfile_handle_close_oldest();
+        }
+        switch (mode) {
+            case BACFILE_OPEN_READ:
+                pFile = fopen(pObject->Pathname, "rb");
+                break;
+            case BACFILE_OPEN_UPDATE:
+                pFile = fopen(pObject->Pathname, "rb+");
+                break;
+            case BACFILE_OPEN_CREATE:
+                pFile = fopen(pObject->Pathname, "rb+");
+                if (!pFile) {
+                    pFile = fopen(pObject->Pathname, "wb+");
+                }
+                break;
+            case BACFILE_OPEN_TRUNCATE:
+                pFile = fopen(pObject->Pathname, "wb+");
+                break;
+            default:
+                break;
+        }
+        if (pFile) {
+            pObject->File_Handle = pFile;
+            pObject->File_Handle_Update = (mode != BACFILE_OPEN_READ);
+            if (mode == BACFILE_OPEN_TRUNCATE) {
+                pObject->File_Size = 0;
+                pObject->File_Size_Valid = true;
+            }
+            File_Handle_Count++;
+        }
+    }
+    if (pFile) {
+        File_Handle_Sequence++;
+        pObject->File_Handle_Used = File_Handle_Sequence;
+    }
+
+    return pFile;
+}
+
+/**
+ * @brief Get the size of the open file of an object. Where the file
+ *  system supports fstat(), the size is checked on every call, so that
+ *  a file changed outside of this module is seen. Otherwise, the size
+ *  that is known while the file is open is used.
+ * @param pObject - object data
+ * @param pFile - open file of the object
+ * @return file size in bytes
+ */
+static long bacfile_handle_size(struct object_data *pObject, FILE *pFile)
+{
+#if defined(BACFILE_STAT_ENABLED)
+    struct stat file_stat;
+
+    if (fstat(fileno(pFile), &file_stat) == 0) {
+        if (!pObject->File_Size_Valid ||
+            (file_stat.st_mtime != pObject->File_Modified) ||
+            ((long)file_stat.st_size != pObject->File_Size)) {
+            pObject->File_Size = (long)file_stat.st_size;
+            pObject->File_Modified = file_stat.st_mtime;
+            pObject->File_Size_Valid = true;
+        }
+        return pObject->File_Size;
+    }
+#endif
+    if (!pObject->File_Size_Valid) {
+        pObject->File_Size = fsize(pFile);
+        pObject->File_Size_Valid = true;
+    }
+
+    return pObject->File_Size;
+}
+
+/**
+ * @brief Update the known size of the open file of an object after
+ *  writing, and flush the written data to the file
+ * @param pObject - object data
+ * @param pFile - open file of the object
+ */
+static void bacfile_handle_written(struct object_data *pObject, FILE *pFile)
+{
+    long position;
+
+    position = ftell(pFile);
+    if (pObject->File_Size_Valid && (position > pObject->File_Size)) {
+        pObject->File_Size = position;
+    }
+    fflush(pFile);
+}
+
 /**
  * @brief For a given object instance-number, returns the pathname
  * @param  object_instance - object-instance number of the object
@@ -131,11 +335,28 @@ void bacfile_pathname_set(uint32_t object_instance, const char *pathname)
 
     pObject = Keylist_Data(Object_List, object_instance);
     if (pObject) {
+        bacfile_handle_close(pObject);
         free(pObject->Pathname);
         pObject->Pathname = bacfile_strdup(pathname);
     }
 }
 
+/**
+ * @brief For a given object instance-number, closes the file if it is
+ *  open, so that changes made to the file outside of this module are
+ *  seen by the next request.
+ * @param  object_instance - object-instance number of the object
+ */
+void bacfile_close(uint32_t object_instance)
+{
+    struct object_data *pObject;
+
+    pObject = Keylist_Data(Object_List, object_instance);
+    if (pObject) {
+        bacfile_handle_close(pObject);
+    }
+}
+
 /**
  * @brief For a given pathname, gets the object instance-number
  * @param pathname - internal file system path and name
@@ -279,25 +500,6 @@ uint32_t bacfile_index_to_instance(unsigned find_index)
     return key;
 }
 
-/**
- * @brief Determines the file size for a given file
- * @param  pFile - file handle
- * @return  file size in bytes, or 0 if not found
- */
-static long fsize(FILE *pFile)
-{
-    long size = 0;
-    long origin = 0;
-
-    if (pFile) {
-        origin = ftell(pFile);
-        fseek(pFile, 0L, SEEK_END);
-        size = ftell(pFile);
-        fseek(pFile, origin, SEEK_SET);
-    }
-    return (size);
-}
-
 /**
  * @brief Read the entire file into a buffer
  * @param  object_instance - object-instance number of the object
@@ -308,21 +510,21 @@ static long fsize(FILE *pFile)
 uint32_t
 bacfile_read(uint32_t object_instance, uint8_t *buffer, uint32_t buffer_size)
 {
-    const char *pFilename = NULL;
+    struct object_data *pObject;
     FILE *pFile = NULL;
     long file_size = 0;
 
-    pFilename = bacfile_pathname(object_instance);
-    if (pFilename) {
-        pFile = fopen(pFilename, "rb");
+    pObject = Keylist_Data(Object_List, object_instance);
+    if (pObject) {
+        pFile = bacfile_handle(pObject, BACFILE_OPEN_READ);
         if (pFile) {
-            file_size = fsize(pFile);
+            file_size = bacfile_handle_size(pObject, pFile);
             if (buffer && (buffer_size >= file_size)) {
+                (void)fseek(pFile, 0L, SEEK_SET);
                 if (fread(buffer, file_size, 1, pFile) == 0) {
                     file_size = 0;
                 }
             }
-            fclose(pFile);
         }
     }
 
@@ -339,19 +541,19 @@ bacfile_read(uint32_t object_instance, uint8_t *buffer, uint32_t buffer_size)
 uint32_t bacfile_write(
     uint32_t object_instance, const uint8_t *buffer, uint32_t buffer_size)
 {
-    const char *pFilename = NULL;
+    struct object_data *pObject;
     FILE *pFile = NULL;
     long file_size = 0;
 
-    pFilename = bacfile_pathname(object_instance);
-    if (pFilename) {
+    pObject = Keylist_Data(Object_List, object_instance);
+    if (pObject) {
         /* open the file as a clean slate when starting at 0 */
-        pFile = fopen(pFilename, "wb");
+        pFile = bacfile_handle(pObject, BACFILE_OPEN_TRUNCATE);
         if (pFile) {
             if (fwrite(buffer, buffer_size, 1, pFile) == 1) {
                 file_size = buffer_size;
             }
-            fclose(pFile);
+            bacfile_handle_written(pObject, pFile);
         }
     }
 
@@ -360,25 +562,27 @@ uint32_t bacfile_write(
 
 /**
  * @brief Determines the file size for a given file
- * @param  pFile - file handle
+ * @param  object_instance - object-instance number of the object
  * @return  file size in bytes, or 0 if not found
+ * @note Where fstat() is not available, the size is only determined from
+ *  the file system when the file is opened, and is kept up to date by
+ *  the writes of this module.
  */
 BACNET_UNSIGNED_INTEGER bacfile_file_size(uint32_t object_instance)
 {
-    const char *pFilename = NULL;
+    struct object_data *pObject;
     FILE *pFile = NULL;
     long file_position = 0;
     BACNET_UNSIGNED_INTEGER file_size = 0;
 
-    pFilename = bacfile_pathname(object_instance);
-    if (pFilename) {
-        pFile = fopen(pFilename, "rb");
+    pObject = Keylist_Data(Object_List, object_instance);
+    if (pObject) {
+        pFile = bacfile_handle(pObject, BACFILE_OPEN_READ);
         if (pFile) {
-            file_position = fsize(pFile);
+            file_position = bacfile_handle_size(pObject, pFile);
             if (file_position >= 0) {
                 file_size = (BACNET_UNSIGNED_INTEGER)file_position;
             }
-            fclose(pFile);
         }
     }
 
@@ -612,8 +816,8 @@ int bacfile_read_property(BACNET_READ_PROPERTY_DATA *rpdata)
             break;
         case PROP_OBJECT_NAME:
             bacfile_object_name(rpdata->object_instance, &char_string);
-            apdu_len =
-                encode_application_character_string(&apdu[0], &char_string);
+            apdu_len = read_property_character_string_encode(
+                rpdata, &apdu[0], &char_string);
             break;
         case PROP_OBJECT_TYPE:
             apdu_len = encode_application_enumerated(&apdu[0], Object_Type);
@@ -621,14 +825,14 @@ int bacfile_read_property(BACNET_READ_PROPERTY_DATA *rpdata)
         case PROP_DESCRIPTION:
             characterstring_init_ansi(
                 &char_string, bacfile_pathname(rpdata->object_instance));
-            apdu_len =
-                encode_application_character_string(&apdu[0], &char_string);
+            apdu_len = read_property_character_string_encode(
+                rpdata, &apdu[0], &char_string);
             break;
         case PROP_FILE_TYPE:
             characterstring_init_ansi(
                 &char_string, bacfile_file_type(rpdata->object_instance));
-            apdu_len =
-                encode_application_character_string(&apdu[0], &char_string);
+            apdu_len = read_property_character_string_encode(
+                rpdata, &apdu[0], &char_string);
             break;
         case PROP_FILE_SIZE:
             apdu_len = encode_application_unsigned(
@@ -792,31 +996,28 @@ uint32_t bacfile_instance_from_tsm(uint8_t invokeID)
 
 bool bacfile_read_stream_data(BACNET_ATOMIC_READ_FILE_DATA *data)
 {
-    const char *pFilename = NULL;
+    struct object_data *pObject;
     bool found = false;
     FILE *pFile = NULL;
     size_t len = 0;
 
-    pFilename = bacfile_pathname(data->object_instance);
-    if (pFilename) {
+    pObject = Keylist_Data(Object_List, data->object_instance);
+    if (pObject && pObject->Pathname) {
         found = true;
-        pFile = fopen(pFilename, "rb");
-        if (pFile) {
-            (void)fseek(pFile, data->type.stream.fileStartPosition, SEEK_SET);
-            len = fread(
-                octetstring_value(&data->fileData[0]), 1,
-                data->type.stream.requestedOctetCount, pFile);
-            if (len < data->type.stream.requestedOctetCount) {
-                data->endOfFile = true;
-            } else {
-                data->endOfFile = false;
-            }
-            octetstring_truncate(&data->fileData[0], len);
-            fclose(pFile);
-        } else {
-            octetstring_truncate(&data->fileData[0], 0);
+        pFile = bacfile_handle(pObject, BACFILE_OPEN_READ);
+    }
+    if (pFile) {
+        (void)fseek(pFile, data->type.stream.fileStartPosition, SEEK_SET);
+        /* read straight into the octet string of the reply */
+        len = fread(
+            octetstring_value(&data->fileData[0]), 1,
+            data->type.stream.requestedOctetCount, pFile);
+        if (len < data->type.stream.requestedOctetCount) {
             data->endOfFile = true;
+        } else {
+            data->endOfFile = false;
         }
+        octetstring_truncate(&data->fileData[0], len);
     } else {
         octetstring_truncate(&data->fileData[0], 0);
         data->endOfFile = true;
@@ -827,36 +1028,39 @@ bool bacfile_read_stream_data(BACNET_ATOMIC_READ_FILE_DATA *data)
 
 bool bacfile_write_stream_data(BACNET_ATOMIC_WRITE_FILE_DATA *data)
 {
-    const char *pFilename = NULL;
+    struct object_data *pObject;
     bool found = false;
     FILE *pFile = NULL;
 
-    pFilename = bacfile_pathname(data->object_instance);
-    if (pFilename) {
+    pObject = Keylist_Data(Object_List, data->object_instance);
+    if (pObject && pObject->Pathname) {
         found = true;
         if (data->type.stream.fileStartPosition == 0) {
             /* open the file as a clean slate when starting at 0 */
-            pFile = fopen(pFilename, "wb");
+            pFile = bacfile_handle(pObject, BACFILE_OPEN_TRUNCATE);
         } else if (data->type.stream.fileStartPosition == -1) {
             /* If 'File Start Position' parameter has the special
                value -1, then the write operation shall be treated
                as an append to the current end of file. */
-            pFile = fopen(pFilename, "ab+");
+            pFile = bacfile_handle(pObject, BACFILE_OPEN_CREATE);
+            if (pFile) {
+                (void)fseek(pFile, 0L, SEEK_END);
+            }
         } else {
             /* open for update */
-            pFile = fopen(pFilename, "rb+");
-        }
-        if (pFile) {
-            if (data->type.stream.fileStartPosition != -1) {
+            pFile = bacfile_handle(pObject, BACFILE_OPEN_UPDATE);
+            if (pFile) {
                 (void)fseek(
                     pFile, data->type.stream.fileStartPosition, SEEK_SET);
             }
+        }
+        if (pFile) {
             if (fwrite(
                     octetstring_value(&data->fileData[0]),
                     octetstring_length(&data->fileData[0]), 1, pFile) != 1) {
                 /* do something if it fails? */
             }
-            fclose(pFile);
+            bacfile_handle_written(pObject, pFile);
         }
     }
 
@@ -865,31 +1069,36 @@ bool bacfile_write_stream_data(BACNET_ATOMIC_WRITE_FILE_DATA *data)
 
 bool bacfile_write_record_data(const BACNET_ATOMIC_WRITE_FILE_DATA *data)
 {
-    const char *pFilename = NULL;
+    struct object_data *pObject;
     bool found = false;
     FILE *pFile = NULL;
     uint32_t i = 0;
     char dummy_data[FILE_RECORD_SIZE];
     const char *pData = NULL;
 
-    pFilename = bacfile_pathname(data->object_instance);
-    if (pFilename) {
+    pObject = Keylist_Data(Object_List, data->object_instance);
+    if (pObject && pObject->Pathname) {
         found = true;
         if (data->type.record.fileStartRecord == 0) {
             /* open the file as a clean slate when starting at 0 */
-            pFile = fopen(pFilename, "wb");
+            pFile = bacfile_handle(pObject, BACFILE_OPEN_TRUNCATE);
         } else if (data->type.record.fileStartRecord == -1) {
             /* If 'File Start Record' parameter has the special
                value -1, then the write operation shall be treated
                as an append to the current end of file. */
-            pFile = fopen(pFilename, "ab+");
+            pFile = bacfile_handle(pObject, BACFILE_OPEN_CREATE);
+            if (pFile) {
+                (void)fseek(pFile, 0L, SEEK_END);
+            }
         } else {
             /* open for update */
-            pFile = fopen(pFilename, "rb+");
+            pFile = bacfile_handle(pObject, BACFILE_OPEN_UPDATE);
+            if (pFile) {
+                (void)fseek(pFile, 0L, SEEK_SET);
+            }
         }
         if (pFile) {
-            if ((data->type.record.fileStartRecord != -1) &&
-                (data->type.record.fileStartRecord > 0)) {
+            if (data->type.record.fileStartRecord > 0) {
                 for (i = 0; i < (uint32_t)data->type.record.fileStartRecord;
                      i++) {
                     pData = fgets(&dummy_data[0], sizeof(dummy_data), pFile);
@@ -897,6 +1106,8 @@ bool bacfile_write_record_data(const BACNET_ATOMIC_WRITE_FILE_DATA *data)
                         break;
                     }
                 }
+                /* reading and writing must be separated by a seek */
+                (void)fseek(pFile, 0L, SEEK_CUR);
             }
             for (i = 0; i < data->type.record.returnedRecordCount; i++) {
                 if (fwrite(
@@ -907,7 +1118,7 @@ bool bacfile_write_record_data(const BACNET_ATOMIC_WRITE_FILE_DATA *data)
                     /* do something if it fails? */
                 }
             }
-            fclose(pFile);
+            bacfile_handle_written(pObject, pFile);
         }
     }
 
@@ -917,14 +1128,14 @@ bool bacfile_write_record_data(const BACNET_ATOMIC_WRITE_FILE_DATA *data)
 bool bacfile_read_ack_stream_data(
     uint32_t instance, const BACNET_ATOMIC_READ_FILE_DATA *data)
 {
+    struct object_data *pObject;
     bool found = false;
     FILE *pFile = NULL;
-    const char *pFilename = NULL;
 
-    pFilename = bacfile_pathname(instance);
-    if (pFilename) {
+    pObject = Keylist_Data(Object_List, instance);
+    if (pObject && pObject->Pathname) {
         found = true;
-        pFile = fopen(pFilename, "rb+");
+        pFile = bacfile_handle(pObject, BACFILE_OPEN_UPDATE);
         if (pFile) {
             (void)fseek(pFile, data->type.stream.fileStartPosition, SEEK_SET);
             if (fwrite(
@@ -933,11 +1144,11 @@ bool bacfile_read_ack_stream_data(
                     octetstring_length(&data->fileData[0]), 1, pFile) != 1) {
 #if PRINT_ENABLED
                 fprintf(
-                    stderr, "Failed to write to %s (%lu)!\n", pFilename,
-                    (unsigned long)instance);
+                    stderr, "Failed to write to %s (%lu)!\n",
+                    pObject->Pathname, (unsigned long)instance);
 #endif
             }
-            fclose(pFile);
+            bacfile_handle_written(pObject, pFile);
         }
     }
 
@@ -947,18 +1158,19 @@ bool bacfile_read_ack_stream_data(
 bool bacfile_read_ack_record_data(
     uint32_t instance, const BACNET_ATOMIC_READ_FILE_DATA *data)
 {
+    struct object_data *pObject;
     bool found = false;
     FILE *pFile = NULL;
-    const char *pFilename = NULL;
     uint32_t i = 0;
     char dummy_data[MAX_OCTET_STRING_BYTES] = { 0 };
     char *pData = NULL;
 
-    pFilename = bacfile_pathname(instance);
-    if (pFilename) {
+    pObject = Keylist_Data(Object_List, instance);
+    if (pObject && pObject->Pathname) {
         found = true;
-        pFile = fopen(pFilename, "rb+");
+        pFile = bacfile_handle(pObject, BACFILE_OPEN_UPDATE);
         if (pFile) {
+            (void)fseek(pFile, 0L, SEEK_SET);
             if (data->type.record.fileStartRecord > 0) {
                 for (i = 0; i < (uint32_t)data->type.record.fileStartRecord;
                      i++) {
@@ -967,6 +1179,8 @@ bool bacfile_read_ack_record_data(
                         break;
                     }
                 }
+                /* reading and writing must be separated by a seek */
+                (void)fseek(pFile, 0L, SEEK_CUR);
             }
             for (i = 0; i < data->type.record.RecordCount; i++) {
                 if (fwrite(
@@ -976,12 +1190,12 @@ bool bacfile_read_ack_record_data(
                         pFile) != 1) {
 #if PRINT_ENABLED
                     fprintf(
-                        stderr, "Failed to write to %s (%lu)!\n", pFilename,
-                        (unsigned long)instance);
+                        stderr, "Failed to write to %s (%lu)!\n",
+                        pObject->Pathname, (unsigned long)instance);
 #endif
                 }
             }
-            fclose(pFile);
+            bacfile_handle_written(pObject, pFile);
         }
     }
 
@@ -1047,6 +1261,10 @@ bool bacfile_delete(uint32_t object_instance)
 
     pObject = Keylist_Data_Delete(Object_List, object_instance);
     if (pObject) {
+        bacfile_handle_close(pObject);
+        free(pObject->Pathname);
+        free(pObject->File_Type);
+        free(pObject->Object_Name);
         free(pObject);
         status = true;
     }
@@ -1065,6 +1283,7 @@ void bacfile_cleanup(void)
         do {
             pObject = Keylist_Data_Pop(Object_List);
             if (pObject) {
+                bacfile_handle_close(pObject);
                 free(pObject->Pathname);
                 free(pObject->File_Type);
                 free(pObject->Object_Name);
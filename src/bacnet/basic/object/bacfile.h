@@ -109,6 +109,8 @@ BACNET_STACK_EXPORT
 void bacfile_pathname_set(uint32_t instance, const char *pathname);
 BACNET_STACK_EXPORT
 uint32_t bacfile_pathname_instance(const char *pathname);
+BACNET_STACK_EXPORT
+void bacfile_close(uint32_t object_instance);
 
 BACNET_STACK_EXPORT
 uint32_t
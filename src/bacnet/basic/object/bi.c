@@ -892,8 +892,8 @@ int Binary_Input_Read_Property(BACNET_READ_PROPERTY_DATA *rpdata)
         case PROP_OBJECT_NAME:
             /* note: object name must be unique in our device */
             Binary_Input_Object_Name(rpdata->object_instance, &char_string);
-            apdu_len =
-                encode_application_character_string(&apdu[0], &char_string);
+            apdu_len = read_property_character_string_encode(
+                rpdata, &apdu[0], &char_string);
             break;
         case PROP_OBJECT_TYPE:
             apdu_len = encode_application_enumerated(&apdu[0], Object_Type);
@@ -935,22 +935,22 @@ int Binary_Input_Read_Property(BACNET_READ_PROPERTY_DATA *rpdata)
             characterstring_init_ansi(
                 &char_string,
                 Binary_Input_Description(rpdata->object_instance));
-            apdu_len =
-                encode_application_character_string(&apdu[0], &char_string);
+            apdu_len = read_property_character_string_encode(
+                rpdata, &apdu[0], &char_string);
             break;
         case PROP_ACTIVE_TEXT:
             characterstring_init_ansi(
                 &char_string,
                 Binary_Input_Active_Text(rpdata->object_instance));
-            apdu_len =
-                encode_application_character_string(&apdu[0], &char_string);
+            apdu_len = read_property_character_string_encode(
+                rpdata, &apdu[0], &char_string);
             break;
         case PROP_INACTIVE_TEXT:
             characterstring_init_ansi(
                 &char_string,
                 Binary_Input_Inactive_Text(rpdata->object_instance));
-            apdu_len =
-                encode_application_character_string(&apdu[0], &char_string);
+            apdu_len = read_property_character_string_encode(
+                rpdata, &apdu[0], &char_string);
             break;
 #if defined(INTRINSIC_REPORTING) && (BINARY_INPUT_INTRINSIC_REPORTING)
         case PROP_ALARM_VALUE:
@@ -1040,6 +1040,22 @@ int Binary_Input_Read_Property(BACNET_READ_PROPERTY_DATA *rpdata)
     return apdu_len;
 }
 
+/**
+ * @brief For a given object instance-number, encodes the special property
+ *  ALL, REQUIRED, or OPTIONAL of the ReadPropertyMultiple service directly
+ *  into the reply, without dispatching each property through the device.
+ * @param  writer - bounded writer for the listOfResults of the reply
+ * @param  rpdata - object instance and special property to encode
+ * @return BACNET_STATUS_OK, or BACNET_STATUS_ABORT or BACNET_STATUS_REJECT
+ */
+int Binary_Input_Read_Property_Multiple(
+    BACNET_WRITER *writer, BACNET_READ_PROPERTY_DATA *rpdata)
+{
+    return rpm_ack_property_list_encode(
+        writer, rpdata, Properties_Required, Properties_Optional,
+        Properties_Proprietary, Binary_Input_Read_Property);
+}
+
 /**
  * WriteProperty handler for this object.  For the given WriteProperty
  * data, the application_data is loaded or the error flags are set.
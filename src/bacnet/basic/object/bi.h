@@ -16,6 +16,7 @@
 /* BACnet Stack API */
 #include "bacnet/cov.h"
 #include "bacnet/rp.h"
+#include "bacnet/rpm.h"
 #include "bacnet/wp.h"
 
 #if (INTRINSIC_REPORTING)
@@ -115,6 +116,9 @@ void Binary_Input_Change_Of_Value_Clear(uint32_t instance);
 BACNET_STACK_EXPORT
 int Binary_Input_Read_Property(BACNET_READ_PROPERTY_DATA *rpdata);
 BACNET_STACK_EXPORT
+int Binary_Input_Read_Property_Multiple(
+    BACNET_WRITER *writer, BACNET_READ_PROPERTY_DATA *rpdata);
+BACNET_STACK_EXPORT
 bool Binary_Input_Write_Property(BACNET_WRITE_PROPERTY_DATA *wp_data);
 BACNET_STACK_EXPORT
 void Binary_Input_Write_Present_Value_Callback_Set(
@@ -568,15 +568,16 @@ int BitString_Value_Read_Property(BACNET_READ_PROPERTY_DATA *rpdata)
         case PROP_OBJECT_NAME:
             if (BitString_Value_Object_Name(
                     rpdata->object_instance, &char_string)) {
-                apdu_len =
-                    encode_application_character_string(&apdu[0], &char_string);
+                apdu_len = read_property_character_string_encode(
+                    rpdata, &apdu[0], &char_string);
             }
             break;
         case PROP_DESCRIPTION:
             characterstring_init_ansi(
                 &char_string,
                 BitString_Value_Description(rpdata->object_instance));
-            apdu_len = encode_application_character_string(apdu, &char_string);
+            apdu_len = read_property_character_string_encode(
+                rpdata, apdu, &char_string);
             break;
         case PROP_OBJECT_TYPE:
             apdu_len =
@@ -19,6 +19,7 @@
 #include "bacnet/wp.h"
 #include "bacnet/lighting.h"
 #include "bacnet/basic/services.h"
+#include "bacnet/basic/object/device.h"
 #include "bacnet/basic/sys/keylist.h"
 #include "bacnet/proplist.h"
 /* me! */
@@ -415,6 +416,27 @@ bool Binary_Lighting_Output_Present_Value_Set(
     return status;
 }
 
+/**
+ * @brief Register the object with the Device timer while the egress timer
+ *  is running or a target value is waiting to be handled, and unregister
+ *  it otherwise
+ * @param  object_instance - object-instance number of the object
+ * @param  pObject - object data
+ */
+static void Binary_Lighting_Output_Timer_Update(
+    uint32_t object_instance, const struct object_data *pObject)
+{
+    if ((pObject->Egress_Timer > 0) ||
+        (pObject->Target_Value == BINARY_LIGHTING_PV_OFF) ||
+        (pObject->Target_Value == BINARY_LIGHTING_PV_ON) ||
+        (pObject->Target_Value == BINARY_LIGHTING_PV_WARN)) {
+        (void)Device_Timer_Register(
+            OBJECT_BINARY_LIGHTING_OUTPUT, object_instance);
+    } else {
+        Device_Timer_Unregister(OBJECT_BINARY_LIGHTING_OUTPUT, object_instance);
+    }
+}
+
 /**
  * For a given object instance-number, handles an ON or OFF target value
  *
@@ -624,6 +646,9 @@ void Binary_Lighting_Output_Timer(
             default:
                 break;
         }
+        Binary_Lighting_Output_Timer_Update(object_instance, pObject);
+    } else {
+        Device_Timer_Unregister(OBJECT_BINARY_LIGHTING_OUTPUT, object_instance);
     }
 }
 
@@ -676,6 +701,7 @@ static bool Binary_Lighting_Output_Present_Value_Write(
                 *error_class = ERROR_CLASS_PROPERTY;
                 *error_code = ERROR_CODE_VALUE_OUT_OF_RANGE;
             }
+            Binary_Lighting_Output_Timer_Update(object_instance, pObject);
         } else {
             *error_class = ERROR_CLASS_PROPERTY;
             *error_code = ERROR_CODE_VALUE_OUT_OF_RANGE;
@@ -745,6 +771,7 @@ static bool Binary_Lighting_Output_Present_Value_Relinquish_Write(
             pObject->Target_Value = BINARY_LIGHTING_PV_STOP;
             Present_Value_Relinquish(pObject, priority);
             Present_Value_Relinquish_Handler(object_instance);
+            Binary_Lighting_Output_Timer_Update(object_instance, pObject);
             status = true;
         } else {
             *error_class = ERROR_CLASS_PROPERTY;
@@ -900,6 +927,7 @@ bool Binary_Lighting_Output_Lighting_Command_Set(
     if (pObject) {
         pObject->Target_Priority = priority;
         pObject->Target_Value = value;
+        Binary_Lighting_Output_Timer_Update(object_instance, pObject);
     }
 
     return status;
@@ -1275,8 +1303,8 @@ int Binary_Lighting_Output_Read_Property(BACNET_READ_PROPERTY_DATA *rpdata)
         case PROP_OBJECT_NAME:
             Binary_Lighting_Output_Object_Name(
                 rpdata->object_instance, &char_string);
-            apdu_len =
-                encode_application_character_string(&apdu[0], &char_string);
+            apdu_len = read_property_character_string_encode(
+                rpdata, &apdu[0], &char_string);
             break;
         case PROP_OBJECT_TYPE:
             apdu_len =
@@ -1355,8 +1383,8 @@ int Binary_Lighting_Output_Read_Property(BACNET_READ_PROPERTY_DATA *rpdata)
             characterstring_init_ansi(
                 &char_string,
                 Binary_Lighting_Output_Description(rpdata->object_instance));
-            apdu_len =
-                encode_application_character_string(&apdu[0], &char_string);
+            apdu_len = read_property_character_string_encode(
+                rpdata, &apdu[0], &char_string);
             break;
         case PROP_RELIABILITY:
             unsigned_value =
@@ -1538,6 +1566,8 @@ uint32_t Binary_Lighting_Output_Create(uint32_t object_instance)
             free(pObject);
             return BACNET_MAX_INSTANCE;
         }
+        /* the OFF target value is handled at the first timer */
+        Binary_Lighting_Output_Timer_Update(object_instance, pObject);
     }
 
     return object_instance;
@@ -1555,6 +1585,7 @@ bool Binary_Lighting_Output_Delete(uint32_t object_instance)
 
     pObject = Keylist_Data_Delete(Object_List, object_instance);
     if (pObject) {
+        Device_Timer_Unregister(OBJECT_BINARY_LIGHTING_OUTPUT, object_instance);
         free(pObject);
         status = true;
     }
@@ -16,6 +16,7 @@
 /* BACnet Stack API */
 #include "bacnet/bacerror.h"
 #include "bacnet/rp.h"
+#include "bacnet/rpm.h"
 #include "bacnet/wp.h"
 
 #if (INTRINSIC_REPORTING)
@@ -73,6 +74,9 @@ bool Binary_Value_Reliability_Set(
 
 BACNET_STACK_EXPORT
 int Binary_Value_Read_Property(BACNET_READ_PROPERTY_DATA *rpdata);
+BACNET_STACK_EXPORT
+int Binary_Value_Read_Property_Multiple(
+    BACNET_WRITER *writer, BACNET_READ_PROPERTY_DATA *rpdata);
 
 BACNET_STACK_EXPORT
 bool Binary_Value_Write_Property(BACNET_WRITE_PROPERTY_DATA *wp_data);
@@ -29,6 +29,7 @@
 #include "bacnet/rp.h"
 #include "bacnet/wp.h"
 #include "bacnet/basic/services.h"
+#include "bacnet/basic/sys/days.h"
 #include "bacnet/basic/sys/keylist.h"
 /* me! */
 #include "calendar.h"
@@ -38,11 +39,17 @@ struct object_data {
     bool Write_Enabled : 1;
     bool Present_Value;
     OS_Keylist Date_List;
+    /* bit per day of the Effective_Year that is in the Date_List */
+    uint8_t Effective_Days[(366 + 7) / 8];
+    /* year of the Effective_Days, or zero when they must be computed */
+    uint16_t Effective_Year;
     const char *Object_Name;
     const char *Description;
 };
 /* Key List for storing the object data sorted by instance number  */
 static OS_Keylist Object_List;
+/* number of changes to the Date_List of any Calendar */
+static uint32_t Date_List_Changes;
 /* callback for present value writes */
 static calendar_write_present_value_callback
     Calendar_Write_Present_Value_Callback;
@@ -225,6 +232,9 @@ Calendar_Date_List_Get(uint32_t object_instance, uint8_t index)
     pObject = Keylist_Data(Object_List, object_instance);
     if (pObject) {
         entry = Keylist_Data_Index(pObject->Date_List, index);
+        /* the entry may be modified by the caller */
+        pObject->Effective_Year = 0;
+        Date_List_Changes++;
     }
 
     return entry;
@@ -256,8 +266,15 @@ bool Calendar_Date_List_Add(
     }
 
     *entry = *value;
-    st = Keylist_Data_Add(
-        pObject->Date_List, Keylist_Count(pObject->Date_List), entry);
+    if (Keylist_Data_Add(
+            pObject->Date_List, Keylist_Count(pObject->Date_List), entry) >=
+        0) {
+        st = true;
+    } else {
+        free(entry);
+    }
+    pObject->Effective_Year = 0;
+    Date_List_Changes++;
 
     return st;
 }
@@ -278,6 +295,8 @@ bool Calendar_Date_List_Delete_All(uint32_t object_instance)
     }
 
     Calendar_Date_List_Clean(pObject->Date_List);
+    pObject->Effective_Year = 0;
+    Date_List_Changes++;
 
     return true;
 }
@@ -312,14 +331,19 @@ int Calendar_Date_List_Count(uint32_t object_instance)
 int Calendar_Date_List_Encode(
     uint32_t object_instance, uint8_t *apdu, int max_apdu)
 {
-    BACNET_CALENDAR_ENTRY *entry = NULL;
+    const BACNET_CALENDAR_ENTRY *entry = NULL;
+    struct object_data *pObject;
     int apdu_len = 0;
     unsigned index = 0;
     unsigned size = 0;
 
-    size = Calendar_Date_List_Count(object_instance);
+    pObject = Keylist_Data(Object_List, object_instance);
+    if (!pObject) {
+        return 0;
+    }
+    size = Keylist_Count(pObject->Date_List);
     for (index = 0; index < size; index++) {
-        entry = Calendar_Date_List_Get(object_instance, index);
+        entry = Keylist_Data_Index(pObject->Date_List, index);
         apdu_len += bacnet_calendar_entry_encode(NULL, entry);
     }
     if (apdu_len > max_apdu) {
@@ -327,13 +351,111 @@ int Calendar_Date_List_Encode(
     }
     apdu_len = 0;
     for (index = 0; index < size; index++) {
-        entry = Calendar_Date_List_Get(object_instance, index);
+        entry = Keylist_Data_Index(pObject->Date_List, index);
         apdu_len += bacnet_calendar_entry_encode(&apdu[apdu_len], entry);
     }
 
     return apdu_len;
 }
 
+/**
+ * @brief Determine if a date is included by any entry of a Date_List
+ * @param list - Date_List of BACnetCalendarEntry
+ * @param date - date to check
+ * @return true if the date is included by the Date_List
+ */
+static bool
+Calendar_Date_List_Includes(OS_Keylist list, const BACNET_DATE *date)
+{
+    const BACNET_CALENDAR_ENTRY *entry;
+    int count, index;
+
+    count = Keylist_Count(list);
+    for (index = 0; index < count; index++) {
+        entry = Keylist_Data_Index(list, index);
+        if (bacapp_date_in_calendar_entry(date, entry)) {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+/**
+ * @brief Expand the Date_List of a Calendar into a bit for each day
+ *  of a year, so that the dates, date ranges, and WeekNDay entries are
+ *  evaluated once per year rather than for each date that is checked.
+ * @param pObject - Calendar object data
+ * @param year - year to compute
+ */
+static void
+Calendar_Effective_Days_Update(struct object_data *pObject, uint16_t year)
+{
+    BACNET_DATE date;
+    uint8_t month, day, last_day;
+    unsigned bit = 0;
+
+    memset(pObject->Effective_Days, 0, sizeof(pObject->Effective_Days));
+    if (Keylist_Count(pObject->Date_List) > 0) {
+        datetime_set_date(&date, year, 1, 1);
+        for (month = 1; month <= 12; month++) {
+            date.month = month;
+            last_day = days_per_month(year, month);
+            for (day = 1; day <= last_day; day++) {
+                date.day = day;
+                if (Calendar_Date_List_Includes(pObject->Date_List, &date)) {
+                    pObject->Effective_Days[bit / 8] |= (1 << (bit % 8));
+                }
+                bit++;
+                date.wday = (date.wday % 7) + 1;
+            }
+        }
+    }
+    pObject->Effective_Year = year;
+}
+
+/**
+ * @brief For a given object instance-number, determines if a date is
+ *  included by the Date_List. The Date_List is expanded into a bitmap
+ *  of the days of the year, which is computed again when the Date_List
+ *  is changed or a date of another year is checked.
+ * @param object_instance - object-instance number of the object
+ * @param date - date to check
+ * @return true if the date is included by the Date_List
+ */
+bool Calendar_Date_Effective(uint32_t object_instance, const BACNET_DATE *date)
+{
+    struct object_data *pObject;
+    uint32_t bit;
+
+    pObject = Keylist_Data(Object_List, object_instance);
+    if (!pObject || !date) {
+        return false;
+    }
+    if (!datetime_date_is_valid(date)) {
+        /* dates with wildcards are not in the bitmap */
+        return Calendar_Date_List_Includes(pObject->Date_List, date);
+    }
+    if (pObject->Effective_Year != date->year) {
+        Calendar_Effective_Days_Update(pObject, date->year);
+    }
+    bit = datetime_day_of_year(date) - 1;
+
+    return (pObject->Effective_Days[bit / 8] & (1 << (bit % 8))) != 0;
+}
+
+/**
+ * @brief Get the number of changes to the Date_List of any Calendar,
+ *  including the Calendars that were created or deleted. Users of
+ *  Calendar_Date_Effective() that cache their result, such as the
+ *  Schedule object, compare it to know when to evaluate again.
+ * @return number of changes, which wraps around
+ */
+uint32_t Calendar_Date_List_Changes(void)
+{
+    return Date_List_Changes;
+}
+
 /**
  * For a given object instance-number, determines the present-value
  *
@@ -345,21 +467,10 @@ bool Calendar_Present_Value(uint32_t object_instance)
 {
     BACNET_DATE date;
     BACNET_TIME time;
-    BACNET_CALENDAR_ENTRY *entry = NULL;
-    unsigned size = 0;
-    int index;
 
     datetime_local(&date, &time, NULL, NULL);
 
-    size = Calendar_Date_List_Count(object_instance);
-    for (index = 0; index < size; index++) {
-        entry = Calendar_Date_List_Get(object_instance, index);
-        if (bacapp_date_in_calendar_entry(&date, entry)) {
-            return true;
-        }
-    }
-
-    return false;
+    return Calendar_Date_Effective(object_instance, &date);
 }
 
 /**
@@ -523,8 +634,8 @@ int Calendar_Read_Property(BACNET_READ_PROPERTY_DATA *rpdata)
             break;
         case PROP_OBJECT_NAME:
             Calendar_Object_Name(rpdata->object_instance, &char_string);
-            apdu_len =
-                encode_application_character_string(&apdu[0], &char_string);
+            apdu_len = read_property_character_string_encode(
+                rpdata, &apdu[0], &char_string);
             break;
         case PROP_OBJECT_TYPE:
             apdu_len =
@@ -541,7 +652,8 @@ int Calendar_Read_Property(BACNET_READ_PROPERTY_DATA *rpdata)
         case PROP_DESCRIPTION:
             characterstring_init_ansi(
                 &char_string, Calendar_Description(rpdata->object_instance));
-            apdu_len = encode_application_character_string(apdu, &char_string);
+            apdu_len = read_property_character_string_encode(
+                rpdata, apdu, &char_string);
             break;
         default:
             rpdata->error_class = ERROR_CLASS_PROPERTY;
@@ -722,6 +834,8 @@ uint32_t Calendar_Create(uint32_t object_instance)
         pObject->Description = NULL;
         pObject->Present_Value = false;
         pObject->Date_List = Keylist_Create();
+        pObject->Effective_Year = 0;
+        Date_List_Changes++;
         pObject->Changed = false;
         pObject->Write_Enabled = false;
         /* add to list */
@@ -750,6 +864,7 @@ bool Calendar_Delete(uint32_t object_instance)
         Calendar_Date_List_Clean(pObject->Date_List);
         Keylist_Delete(pObject->Date_List);
         free(pObject);
+        Date_List_Changes++;
         status = true;
     }
 
@@ -774,6 +889,7 @@ void Calendar_Cleanup(void)
         } while (pObject);
         Keylist_Delete(Object_List);
         Object_List = NULL;
+        Date_List_Changes++;
     }
 }
 
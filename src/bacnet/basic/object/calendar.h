@@ -59,6 +59,11 @@ bool Calendar_Write_Property(BACNET_WRITE_PROPERTY_DATA *wp_data);
 
 BACNET_STACK_EXPORT
 bool Calendar_Present_Value(uint32_t object_instance);
+BACNET_STACK_EXPORT
+bool Calendar_Date_Effective(uint32_t object_instance, const BACNET_DATE *date);
+BACNET_STACK_EXPORT
+uint32_t Calendar_Date_List_Changes(void);
+
 BACNET_STACK_EXPORT
 void Calendar_Write_Present_Value_Callback_Set(
     calendar_write_present_value_callback cb);
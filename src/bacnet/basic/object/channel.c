@@ -51,6 +51,11 @@ struct object_data {
 
 /* Key List for storing the object data sorted by instance number  */
 static OS_Keylist Object_List;
+/* Key List of the channels for each control group and channel number,
+   each a Key List of the object data sorted by instance number */
+static OS_Keylist Group_Channel_List;
+#define GROUP_CHANNEL_KEY(group, channel) \
+    ((KEY)(((uint32_t)(group) << 16) | ((uint32_t)(channel))))
 
 static write_property_function Write_Property_Internal_Callback;
 
@@ -112,6 +117,75 @@ struct object_data *Object_Data(uint32_t object_instance)
     return Keylist_Data(Object_List, object_instance);
 }
 
+/**
+ * @brief Add a channel to the group channel index for each of its
+ *  control groups
+ * @param pObject - object data
+ * @param object_instance - object-instance number of the object
+ */
+static void Group_Channel_Index_Add(
+    struct object_data *pObject, uint32_t object_instance)
+{
+    OS_Keylist members;
+    KEY key;
+    unsigned g;
+
+    if (!Group_Channel_List) {
+        Group_Channel_List = Keylist_Create();
+    }
+    for (g = 0; g < CONTROL_GROUPS_MAX; g++) {
+        if (pObject->Control_Groups[g] == 0) {
+            continue;
+        }
+        key = GROUP_CHANNEL_KEY(
+            pObject->Control_Groups[g], pObject->Channel_Number);
+        members = Keylist_Data(Group_Channel_List, key);
+        if (!members) {
+            members = Keylist_Create();
+            if (!members) {
+                continue;
+            }
+            if (Keylist_Data_Add(Group_Channel_List, key, members) < 0) {
+                Keylist_Delete(members);
+                continue;
+            }
+        }
+        if (!Keylist_Data(members, object_instance)) {
+            (void)Keylist_Data_Add(members, object_instance, pObject);
+        }
+    }
+}
+
+/**
+ * @brief Remove a channel from the group channel index for each of its
+ *  control groups
+ * @param pObject - object data
+ * @param object_instance - object-instance number of the object
+ */
+static void Group_Channel_Index_Remove(
+    const struct object_data *pObject, uint32_t object_instance)
+{
+    OS_Keylist members;
+    KEY key;
+    unsigned g;
+
+    for (g = 0; g < CONTROL_GROUPS_MAX; g++) {
+        if (pObject->Control_Groups[g] == 0) {
+            continue;
+        }
+        key = GROUP_CHANNEL_KEY(
+            pObject->Control_Groups[g], pObject->Channel_Number);
+        members = Keylist_Data(Group_Channel_List, key);
+        if (members) {
+            (void)Keylist_Data_Delete(members, object_instance);
+            if (Keylist_Count(members) == 0) {
+                (void)Keylist_Data_Delete(Group_Channel_List, key);
+                Keylist_Delete(members);
+            }
+        }
+    }
+}
+
 /**
  * Determines if a given Channel instance is valid
  *
@@ -266,7 +340,9 @@ bool Channel_Number_Set(uint32_t object_instance, uint16_t value)
 
     pObject = Object_Data(object_instance);
     if (pObject) {
+        Group_Channel_Index_Remove(pObject, object_instance);
         pObject->Channel_Number = value;
+        Group_Channel_Index_Add(pObject, object_instance);
         status = true;
     }
 
@@ -491,20 +567,27 @@ Channel_Control_Groups_Element(uint32_t object_instance, int32_t array_index)
 
 /**
  * @brief Write the object property member value
+ * @param pObject - object data
+ * @param object_instance - object-instance number of the object
  * @param array_index - 1-based array index
  * @param value - control group value 0..65535
  *
  * @return true if parameters are value and control group is set
  */
 static bool Control_Groups_Element_Set(
-    struct object_data *pObject, int32_t array_index, uint16_t value)
+    struct object_data *pObject,
+    uint32_t object_instance,
+    int32_t array_index,
+    uint16_t value)
 {
     bool status = false;
 
     if (pObject) {
         if ((array_index > 0) && (array_index <= CONTROL_GROUPS_MAX)) {
             array_index--;
+            Group_Channel_Index_Remove(pObject, object_instance);
             pObject->Control_Groups[array_index] = value;
+            Group_Channel_Index_Add(pObject, object_instance);
             status = true;
         }
     }
@@ -529,7 +612,8 @@ bool Channel_Control_Groups_Element_Set(
 
     pObject = Object_Data(object_instance);
     if (pObject) {
-        status = Control_Groups_Element_Set(pObject, array_index, value);
+        status = Control_Groups_Element_Set(
+            pObject, object_instance, array_index, value);
     }
 
     return status;
@@ -981,7 +1065,8 @@ int Channel_Read_Property(BACNET_READ_PROPERTY_DATA *rpdata)
             break;
         case PROP_OBJECT_NAME:
             Channel_Object_Name(rpdata->object_instance, &char_string);
-            apdu_len = encode_application_character_string(apdu, &char_string);
+            apdu_len = read_property_character_string_encode(
+                rpdata, apdu, &char_string);
             break;
         case PROP_OBJECT_TYPE:
             apdu_len = encode_application_enumerated(apdu, OBJECT_CHANNEL);
@@ -1202,7 +1287,8 @@ static BACNET_ERROR_CODE Channel_Control_Groups_Write(
                     if (value.type.Unsigned_Int <= UINT16_MAX) {
                         control_group = (uint16_t)value.type.Unsigned_Int;
                         status = Control_Groups_Element_Set(
-                            pObject, array_index, control_group);
+                            pObject, object_instance, array_index,
+                            control_group);
                         if (status) {
                             error_code = ERROR_CODE_SUCCESS;
                         } else {
@@ -1339,48 +1425,46 @@ void Channel_Write_Group(
     BACNET_GROUP_CHANNEL_VALUE *change_list)
 {
     struct object_data *pObject;
-    unsigned count, g, priority;
-    uint32_t instance;
-    int index;
+    OS_Keylist members;
+    unsigned priority;
+    KEY instance;
+    int count, index;
     bool status = false, found = false;
 
     if (!data || !change_list) {
         return;
     }
     (void)change_list_index;
-    /* iterate through all channels to find
-       a) matching group number, and
-       b) matching channel number
-       Then write the value to the channel */
-    count = Keylist_Count(Object_List);
+    /* control groups are 1..65535, and zero is unused */
+    if ((data->group_number > 0) && (data->group_number <= UINT16_MAX)) {
+        members = Keylist_Data(
+            Group_Channel_List,
+            GROUP_CHANNEL_KEY(data->group_number, change_list->channel));
+    } else {
+        members = NULL;
+    }
+    /* write the value to the channels with a matching group number
+       and matching channel number */
+    count = Keylist_Count(members);
     for (index = 0; index < count; index++) {
-        pObject = Keylist_Data_Index(Object_List, index);
-        if (!pObject) {
+        pObject = Keylist_Data_Index(members, index);
+        if (!pObject || !Keylist_Index_Key(members, index, &instance)) {
             continue;
         }
-        instance = Channel_Index_To_Instance(index);
-        for (g = 0; g < CONTROL_GROUPS_MAX; g++) {
-            if (pObject->Control_Groups[g] == 0) {
-                continue;
-            }
-            if ((pObject->Control_Groups[g] == data->group_number) &&
-                (pObject->Channel_Number == change_list->channel)) {
-                priority = change_list->overriding_priority;
-                if ((priority > BACNET_MAX_PRIORITY) ||
-                    (priority < BACNET_MIN_PRIORITY)) {
-                    priority = data->write_priority;
-                }
-                /* note: inhibit delay is ignored because this
-                   implementation does not support the execution-delay
-                   property */
-                status = Channel_Write_Members(
-                    pObject, instance, &change_list->value, priority);
-                if (status) {
-                    pObject->Last_Priority = priority;
-                }
-                found = true;
-            }
+        priority = change_list->overriding_priority;
+        if ((priority > BACNET_MAX_PRIORITY) ||
+            (priority < BACNET_MIN_PRIORITY)) {
+            priority = data->write_priority;
         }
+        /* note: inhibit delay is ignored because this
+           implementation does not support the execution-delay
+           property */
+        status = Channel_Write_Members(
+            pObject, instance, &change_list->value, priority);
+        if (status) {
+            pObject->Last_Priority = priority;
+        }
+        found = true;
     }
     if (!found) {
         debug_printf(
@@ -1463,6 +1547,7 @@ bool Channel_Delete(uint32_t object_instance)
 
     pObject = Keylist_Data_Delete(Object_List, object_instance);
     if (pObject) {
+        Group_Channel_Index_Remove(pObject, object_instance);
         free(pObject);
         status = true;
     }
@@ -1476,6 +1561,7 @@ bool Channel_Delete(uint32_t object_instance)
 void Channel_Cleanup(void)
 {
     struct object_data *pObject;
+    OS_Keylist members;
 
     if (Object_List) {
         do {
@@ -1487,6 +1573,16 @@ void Channel_Cleanup(void)
         Keylist_Delete(Object_List);
         Object_List = NULL;
     }
+    if (Group_Channel_List) {
+        do {
+            members = Keylist_Data_Pop(Group_Channel_List);
+            if (members) {
+                Keylist_Delete(members);
+            }
+        } while (members);
+        Keylist_Delete(Group_Channel_List);
+        Group_Channel_List = NULL;
+    }
 }
 
 /**
@@ -1497,4 +1593,7 @@ void Channel_Init(void)
     if (!Object_List) {
         Object_List = Keylist_Create();
     }
+    if (!Group_Channel_List) {
+        Group_Channel_List = Keylist_Create();
+    }
 }
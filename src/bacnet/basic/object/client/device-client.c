@@ -111,7 +111,8 @@ static object_functions_t Object_Table[] = {
       NULL /* Remove_List_Element */,
       NULL /* Create */,
       NULL /* Delete */,
-      NULL /* Timer */ },
+      NULL /* Timer */,
+      NULL /* Read_Property_Multiple */ },
 #if (BACNET_PROTOCOL_REVISION >= 17)
     { OBJECT_NETWORK_PORT,
       Network_Port_Init,
@@ -132,7 +133,8 @@ static object_functions_t Object_Table[] = {
       NULL /* Remove_List_Element */,
       NULL /* Create */,
       NULL /* Delete */,
-      NULL /* Timer */ },
+      NULL /* Timer */,
+      NULL /* Read_Property_Multiple */ },
 #endif
 #if defined(BACFILE)
     { OBJECT_FILE,
@@ -154,7 +156,8 @@ static object_functions_t Object_Table[] = {
       NULL /* Remove_List_Element */,
       NULL /* Create */,
       NULL /* Delete */,
-      NULL /* Timer */ },
+      NULL /* Timer */,
+      NULL /* Read_Property_Multiple */ },
 #endif
     { MAX_BACNET_OBJECT_TYPE,
       NULL /* Init */,
@@ -175,7 +178,8 @@ static object_functions_t Object_Table[] = {
       NULL /* Remove_List_Element */,
       NULL /* Create */,
       NULL /* Delete */,
-      NULL /* Timer */ },
+      NULL /* Timer */,
+      NULL /* Read_Property_Multiple */ },
 };
 
 /** Glue function to let the Device object, when called by a handler,
@@ -1197,6 +1201,35 @@ int Device_Read_Property(BACNET_READ_PROPERTY_DATA *rpdata)
     return apdu_len;
 }
 
+/**
+ * @brief Looks up the requested Object once, and encodes the values of its
+ *  special property ALL, REQUIRED, or OPTIONAL directly into the
+ *  ReadPropertyMultiple-Ack, using the object fast path when available.
+ * @ingroup ObjIntf
+ * @param writer [in] bounded writer for the listOfResults of the reply
+ * @param rpdata [in,out] Structure with the desired Object and the special
+ *  property on entry, and the error code on abort or reject.
+ * @return BACNET_STATUS_OK, or BACNET_STATUS_ABORT or BACNET_STATUS_REJECT
+ */
+int Device_Read_Property_Multiple(
+    BACNET_WRITER *writer, BACNET_READ_PROPERTY_DATA *rpdata)
+{
+    struct object_functions *pObject = NULL;
+    struct special_property_list_t property_list;
+
+    pObject = Device_Objects_Find_Functions(rpdata->object_type);
+    if (pObject && pObject->Object_Read_Property_Multiple) {
+        return pObject->Object_Read_Property_Multiple(writer, rpdata);
+    }
+    Device_Objects_Property_List(
+        rpdata->object_type, rpdata->object_instance, &property_list);
+
+    return rpm_ack_property_list_encode(
+        writer, rpdata, property_list.Required.pList,
+        property_list.Optional.pList, property_list.Proprietary.pList,
+        Device_Read_Property);
+}
+
 /**
  * @brief Handles the writing of the object name property
  * @param wp_data [in,out] WriteProperty data structure
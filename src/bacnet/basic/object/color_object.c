@@ -240,6 +240,7 @@ static bool Color_Present_Value_Write(
         }
         pObject->Color_Command.operation = BACNET_COLOR_OPERATION_FADE_TO_COLOR;
         xy_color_copy(&pObject->Color_Command.target.color, value);
+        (void)Device_Timer_Register(OBJECT_COLOR, object_instance);
         status = true;
     } else {
         *error_class = ERROR_CLASS_OBJECT;
@@ -330,6 +331,7 @@ bool Color_Command_Set(
     pObject = Keylist_Data(Object_List, object_instance);
     if (pObject && value) {
         color_command_copy(&pObject->Color_Command, value);
+        (void)Device_Timer_Register(OBJECT_COLOR, object_instance);
         status = true;
     }
 
@@ -362,6 +364,7 @@ static bool Color_Command_Write(
         (void)priority;
         if (pObject->Write_Enabled) {
             color_command_copy(&pObject->Color_Command, value);
+            (void)Device_Timer_Register(OBJECT_COLOR, object_instance);
             status = true;
         } else {
             *error_class = ERROR_CLASS_PROPERTY;
@@ -887,6 +890,13 @@ void Color_Timer(uint32_t object_instance, uint16_t milliseconds)
             default:
                 break;
         }
+        if (pObject->Color_Command.operation !=
+            BACNET_COLOR_OPERATION_FADE_TO_COLOR) {
+            /* the operation is complete */
+            Device_Timer_Unregister(OBJECT_COLOR, object_instance);
+        }
+    } else {
+        Device_Timer_Unregister(OBJECT_COLOR, object_instance);
     }
 }
 
@@ -921,8 +931,8 @@ int Color_Read_Property(BACNET_READ_PROPERTY_DATA *rpdata)
             break;
         case PROP_OBJECT_NAME:
             Color_Object_Name(rpdata->object_instance, &char_string);
-            apdu_len =
-                encode_application_character_string(&apdu[0], &char_string);
+            apdu_len = read_property_character_string_encode(
+                rpdata, &apdu[0], &char_string);
             break;
         case PROP_OBJECT_TYPE:
             apdu_len =
@@ -963,7 +973,8 @@ int Color_Read_Property(BACNET_READ_PROPERTY_DATA *rpdata)
         case PROP_DESCRIPTION:
             characterstring_init_ansi(
                 &char_string, Color_Description(rpdata->object_instance));
-            apdu_len = encode_application_character_string(apdu, &char_string);
+            apdu_len = read_property_character_string_encode(
+                rpdata, apdu, &char_string);
             break;
         default:
             rpdata->error_class = ERROR_CLASS_PROPERTY;
@@ -1194,6 +1205,7 @@ uint32_t Color_Create(uint32_t object_instance)
                 free(pObject);
                 return BACNET_MAX_INSTANCE;
             }
+            (void)Device_Timer_Register(OBJECT_COLOR, object_instance);
         } else {
             return BACNET_MAX_INSTANCE;
         }
@@ -1214,6 +1226,7 @@ bool Color_Delete(uint32_t object_instance)
 
     pObject = Keylist_Data_Delete(Object_List, object_instance);
     if (pObject) {
+        Device_Timer_Unregister(OBJECT_COLOR, object_instance);
         free(pObject);
         status = true;
     }
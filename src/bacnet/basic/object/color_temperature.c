@@ -26,6 +26,7 @@
 #include "bacnet/reject.h"
 #include "bacnet/rp.h"
 #include "bacnet/wp.h"
+#include "bacnet/basic/object/device.h"
 #include "bacnet/basic/services.h"
 #include "bacnet/basic/sys/keylist.h"
 #include "bacnet/basic/sys/linear.h"
@@ -251,6 +252,8 @@ static bool Color_Temperature_Present_Value_Write(
                     BACNET_COLOR_OPERATION_FADE_TO_CCT;
             }
             pObject->Color_Command.target.color_temperature = value;
+            (void)Device_Timer_Register(
+                OBJECT_COLOR_TEMPERATURE, object_instance);
             status = true;
         } else {
             *error_class = ERROR_CLASS_PROPERTY;
@@ -429,6 +432,7 @@ bool Color_Temperature_Command_Set(
     pObject = Keylist_Data(Object_List, object_instance);
     if (pObject && value) {
         color_command_copy(&pObject->Color_Command, value);
+        (void)Device_Timer_Register(OBJECT_COLOR_TEMPERATURE, object_instance);
         status = true;
     }
 
@@ -1294,8 +1298,13 @@ void Color_Temperature_Timer(uint32_t object_instance, uint16_t milliseconds)
             case BACNET_COLOR_OPERATION_STOP:
             default:
                 pObject->In_Progress = BACNET_COLOR_OPERATION_IN_PROGRESS_IDLE;
+                /* the operation is complete */
+                Device_Timer_Unregister(
+                    OBJECT_COLOR_TEMPERATURE, object_instance);
                 break;
         }
+    } else {
+        Device_Timer_Unregister(OBJECT_COLOR_TEMPERATURE, object_instance);
     }
 }
 
@@ -1330,8 +1339,8 @@ int Color_Temperature_Read_Property(BACNET_READ_PROPERTY_DATA *rpdata)
         case PROP_OBJECT_NAME:
             Color_Temperature_Object_Name(
                 rpdata->object_instance, &char_string);
-            apdu_len =
-                encode_application_character_string(&apdu[0], &char_string);
+            apdu_len = read_property_character_string_encode(
+                rpdata, &apdu[0], &char_string);
             break;
         case PROP_OBJECT_TYPE:
             apdu_len =
@@ -1396,7 +1405,8 @@ int Color_Temperature_Read_Property(BACNET_READ_PROPERTY_DATA *rpdata)
             characterstring_init_ansi(
                 &char_string,
                 Color_Temperature_Description(rpdata->object_instance));
-            apdu_len = encode_application_character_string(apdu, &char_string);
+            apdu_len = read_property_character_string_encode(
+                rpdata, apdu, &char_string);
             break;
         default:
             rpdata->error_class = ERROR_CLASS_PROPERTY;
@@ -1641,6 +1651,8 @@ uint32_t Color_Temperature_Create(uint32_t object_instance)
                 free(pObject);
                 return BACNET_MAX_INSTANCE;
             }
+            (void)Device_Timer_Register(
+                OBJECT_COLOR_TEMPERATURE, object_instance);
         } else {
             return BACNET_MAX_INSTANCE;
         }
@@ -1661,6 +1673,7 @@ bool Color_Temperature_Delete(uint32_t object_instance)
 
     pObject = Keylist_Data_Delete(Object_List, object_instance);
     if (pObject) {
+        Device_Timer_Unregister(OBJECT_COLOR_TEMPERATURE, object_instance);
         free(pObject);
         status = true;
     }
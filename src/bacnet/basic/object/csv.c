@@ -575,16 +575,16 @@ int CharacterString_Value_Read_Property(BACNET_READ_PROPERTY_DATA *rpdata)
         case PROP_OBJECT_NAME:
             if (CharacterString_Value_Object_Name(
                     rpdata->object_instance, &char_string)) {
-                apdu_len =
-                    encode_application_character_string(&apdu[0], &char_string);
+                apdu_len = read_property_character_string_encode(
+                    rpdata, &apdu[0], &char_string);
             }
             break;
         case PROP_DESCRIPTION:
             characterstring_init_ansi(
                 &char_string,
                 CharacterString_Value_Description(rpdata->object_instance));
-            apdu_len =
-                encode_application_character_string(&apdu[0], &char_string);
+            apdu_len = read_property_character_string_encode(
+                rpdata, &apdu[0], &char_string);
             break;
         case PROP_OBJECT_TYPE:
             apdu_len = encode_application_enumerated(
@@ -593,8 +593,8 @@ int CharacterString_Value_Read_Property(BACNET_READ_PROPERTY_DATA *rpdata)
         case PROP_PRESENT_VALUE:
             CharacterString_Value_Present_Value(
                 rpdata->object_instance, &char_string);
-            apdu_len =
-                encode_application_character_string(&apdu[0], &char_string);
+            apdu_len = read_property_character_string_encode(
+                rpdata, &apdu[0], &char_string);
             break;
         case PROP_STATUS_FLAGS:
             /* note: see the details in the standard on how to use these */
@@ -8,6 +8,7 @@
  */
 #include <stdbool.h>
 #include <stdint.h>
+#include <stdlib.h>
 #include <string.h>
 /* BACnet Stack defines - first */
 #include "bacnet/bacdef.h"
@@ -19,6 +20,7 @@
 #include "bacnet/wp.h" /* WriteProperty handling */
 #include "bacnet/rp.h" /* ReadProperty handling */
 #include "bacnet/dcc.h" /* DeviceCommunicationControl handling */
+#include "bacnet/property.h"
 #include "bacnet/version.h"
 #if defined(BACDL_MSTP)
 #include "bacnet/datalink/dlmstp.h"
@@ -26,6 +28,8 @@
 #include "bacnet/basic/object/device.h" /* me */
 #include "bacnet/basic/services.h"
 #include "bacnet/basic/binding/address.h"
+#include "bacnet/basic/sys/key.h"
+#include "bacnet/basic/sys/keylist.h"
 /* include the device object */
 #include "bacnet/basic/object/device.h"
 #include "bacnet/basic/object/acc.h"
@@ -82,6 +86,13 @@ Routed_Device_Write_Property_Local(BACNET_WRITE_PROPERTY_DATA *wp_data);
 
 /* may be overridden by outside table */
 static object_functions_t *Object_Table;
+/* objects with a timed operation in progress, keyed by type and instance */
+static OS_Keylist Object_Timer_List;
+/* property bitmap of the property lists of each entry of the object table,
+   built by Device_Init(), so that property membership of a standard
+   property is checked in constant time */
+static uint32_t (*Object_Property_Bitmap)[PROPERTY_LIST_BITMAP_WORDS];
+static size_t Object_Property_Bitmap_Count;
 
 /* clang-format off */
 static object_functions_t My_Object_Table[] = {
@@ -93,7 +104,8 @@ static object_functions_t My_Object_Table[] = {
         NULL /* Value_Lists */, NULL /* COV */, NULL /* COV Clear */,
         NULL /* Intrinsic Reporting */, NULL /* Add_List_Element */,
         NULL /* Remove_List_Element */, NULL /* Create */, NULL /* Delete */,
-        NULL /* Timer */ },
+        NULL /* Timer */,
+        NULL /* Read_Property_Multiple */ },
 #if (BACNET_PROTOCOL_REVISION >= 17)
     { OBJECT_NETWORK_PORT, Network_Port_Init, Network_Port_Count,
         Network_Port_Index_To_Instance, Network_Port_Valid_Instance,
@@ -102,7 +114,8 @@ static object_functions_t My_Object_Table[] = {
         NULL /* ReadRangeInfo */, NULL /* Iterator */, NULL /* Value_Lists */,
         NULL /* COV */, NULL /* COV Clear */, NULL /* Intrinsic Reporting */,
         NULL /* Add_List_Element */, NULL /* Remove_List_Element */,
-        NULL /* Create */, NULL /* Delete */, NULL /* Timer */ },
+        NULL /* Create */, NULL /* Delete */, NULL /* Timer */,
+        NULL /* Read_Property_Multiple */ },
 #endif
     { OBJECT_ANALOG_INPUT, Analog_Input_Init, Analog_Input_Count,
         Analog_Input_Index_To_Instance, Analog_Input_Valid_Instance,
@@ -112,7 +125,8 @@ static object_functions_t My_Object_Table[] = {
         Analog_Input_Encode_Value_List, Analog_Input_Change_Of_Value,
         Analog_Input_Change_Of_Value_Clear, Analog_Input_Intrinsic_Reporting,
         NULL /* Add_List_Element */, NULL /* Remove_List_Element */,
-        Analog_Input_Create, Analog_Input_Delete, NULL /* Timer */ },
+        Analog_Input_Create, Analog_Input_Delete, NULL /* Timer */,
+        Analog_Input_Read_Property_Multiple },
     { OBJECT_ANALOG_OUTPUT, Analog_Output_Init, Analog_Output_Count,
         Analog_Output_Index_To_Instance, Analog_Output_Valid_Instance,
         Analog_Output_Object_Name, Analog_Output_Read_Property,
@@ -121,7 +135,8 @@ static object_functions_t My_Object_Table[] = {
         Analog_Output_Encode_Value_List, Analog_Output_Change_Of_Value,
         Analog_Output_Change_Of_Value_Clear, NULL /* Intrinsic Reporting */,
         NULL /* Add_List_Element */, NULL /* Remove_List_Element */,
-        Analog_Output_Create, Analog_Output_Delete, NULL /* Timer */ },
+        Analog_Output_Create, Analog_Output_Delete, NULL /* Timer */,
+        NULL /* Read_Property_Multiple */ },
     { OBJECT_ANALOG_VALUE, Analog_Value_Init, Analog_Value_Count,
         Analog_Value_Index_To_Instance, Analog_Value_Valid_Instance,
         Analog_Value_Object_Name, Analog_Value_Read_Property,
@@ -130,7 +145,8 @@ static object_functions_t My_Object_Table[] = {
         Analog_Value_Encode_Value_List, Analog_Value_Change_Of_Value,
         Analog_Value_Change_Of_Value_Clear, Analog_Value_Intrinsic_Reporting,
         NULL /* Add_List_Element */, NULL /* Remove_List_Element */,
-        Analog_Value_Create, Analog_Value_Delete, NULL /* Timer */ },
+        Analog_Value_Create, Analog_Value_Delete, NULL /* Timer */,
+        Analog_Value_Read_Property_Multiple },
     { OBJECT_BINARY_INPUT, Binary_Input_Init, Binary_Input_Count,
         Binary_Input_Index_To_Instance, Binary_Input_Valid_Instance,
         Binary_Input_Object_Name, Binary_Input_Read_Property,
@@ -139,7 +155,8 @@ static object_functions_t My_Object_Table[] = {
         Binary_Input_Encode_Value_List, Binary_Input_Change_Of_Value,
         Binary_Input_Change_Of_Value_Clear, NULL /* Intrinsic Reporting */,
         NULL /* Add_List_Element */, NULL /* Remove_List_Element */,
-        Binary_Input_Create, Binary_Input_Delete, NULL /* Timer */ },
+        Binary_Input_Create, Binary_Input_Delete, NULL /* Timer */,
+        Binary_Input_Read_Property_Multiple },
     { OBJECT_BINARY_OUTPUT, Binary_Output_Init, Binary_Output_Count,
         Binary_Output_Index_To_Instance, Binary_Output_Valid_Instance,
         Binary_Output_Object_Name, Binary_Output_Read_Property,
@@ -148,7 +165,8 @@ static object_functions_t My_Object_Table[] = {
         Binary_Output_Encode_Value_List, Binary_Output_Change_Of_Value,
         Binary_Output_Change_Of_Value_Clear, NULL /* Intrinsic Reporting */,
         NULL /* Add_List_Element */, NULL /* Remove_List_Element */,
-        Binary_Output_Create, Binary_Output_Delete, NULL /* Timer */ },
+        Binary_Output_Create, Binary_Output_Delete, NULL /* Timer */,
+        NULL /* Read_Property_Multiple */ },
     { OBJECT_BINARY_VALUE, Binary_Value_Init, Binary_Value_Count,
         Binary_Value_Index_To_Instance, Binary_Value_Valid_Instance,
         Binary_Value_Object_Name, Binary_Value_Read_Property,
@@ -157,7 +175,8 @@ static object_functions_t My_Object_Table[] = {
         Binary_Value_Encode_Value_List, Binary_Value_Change_Of_Value,
         Binary_Value_Change_Of_Value_Clear, NULL /* Intrinsic Reporting */,
         NULL /* Add_List_Element */, NULL /* Remove_List_Element */,
-        Binary_Value_Create, Binary_Value_Delete, NULL /* Timer */ },
+        Binary_Value_Create, Binary_Value_Delete, NULL /* Timer */,
+        Binary_Value_Read_Property_Multiple },
     { OBJECT_CALENDAR, Calendar_Init, Calendar_Count,
         Calendar_Index_To_Instance, Calendar_Valid_Instance,
         Calendar_Object_Name, Calendar_Read_Property,
@@ -165,7 +184,8 @@ static object_functions_t My_Object_Table[] = {
         NULL /* ReadRangeInfo */, NULL /* Iterator */, NULL /* Value_Lists */,
         NULL /* COV */, NULL /* COV Clear */, NULL /* Intrinsic Reporting */,
         NULL /* Add_List_Element */, NULL /* Remove_List_Element */,
-        Calendar_Create, Calendar_Delete, NULL /* Timer */ },
+        Calendar_Create, Calendar_Delete, NULL /* Timer */,
+        NULL /* Read_Property_Multiple */ },
 #if (BACNET_PROTOCOL_REVISION >= 10)
     { OBJECT_BITSTRING_VALUE, BitString_Value_Init,
         BitString_Value_Count, BitString_Value_Index_To_Instance,
@@ -176,7 +196,8 @@ static object_functions_t My_Object_Table[] = {
         BitString_Value_Change_Of_Value, BitString_Value_Change_Of_Value_Clear,
         NULL /* Intrinsic Reporting */,  NULL /* Add_List_Element */,
         NULL /* Remove_List_Element */, BitString_Value_Create,
-        BitString_Value_Delete, NULL /* Timer */ },
+        BitString_Value_Delete, NULL /* Timer */,
+        NULL /* Read_Property_Multiple */ },
     { OBJECT_CHARACTERSTRING_VALUE, CharacterString_Value_Init,
         CharacterString_Value_Count, CharacterString_Value_Index_To_Instance,
         CharacterString_Value_Valid_Instance, CharacterString_Value_Object_Name,
@@ -188,7 +209,8 @@ static object_functions_t My_Object_Table[] = {
         CharacterString_Value_Change_Of_Value_Clear,
         NULL /* Intrinsic Reporting */, NULL /* Add_List_Element */,
         NULL /* Remove_List_Element */, NULL /* Create */, NULL /* Delete */,
-        NULL /* Timer */ },
+        NULL /* Timer */,
+        NULL /* Read_Property_Multiple */ },
     { OBJECT_OCTETSTRING_VALUE, OctetString_Value_Init, OctetString_Value_Count,
         OctetString_Value_Index_To_Instance, OctetString_Value_Valid_Instance,
         OctetString_Value_Object_Name, OctetString_Value_Read_Property,
@@ -196,7 +218,8 @@ static object_functions_t My_Object_Table[] = {
         NULL /* ReadRangeInfo */, NULL /* Iterator */, NULL /* Value_Lists */,
         NULL /* COV */, NULL /* COV Clear */, NULL /* Intrinsic Reporting */,
         NULL /* Add_List_Element */, NULL /* Remove_List_Element */,
-        NULL /* Create */, NULL /* Delete */, NULL /* Timer */ },
+        NULL /* Create */, NULL /* Delete */, NULL /* Timer */,
+        NULL /* Read_Property_Multiple */ },
     { OBJECT_POSITIVE_INTEGER_VALUE, PositiveInteger_Value_Init,
         PositiveInteger_Value_Count, PositiveInteger_Value_Index_To_Instance,
         PositiveInteger_Value_Valid_Instance, PositiveInteger_Value_Object_Name,
@@ -206,7 +229,8 @@ static object_functions_t My_Object_Table[] = {
         NULL /* Iterator */, NULL /* Value_Lists */, NULL /* COV */,
         NULL /* COV Clear */, NULL /* Intrinsic Reporting */,
         NULL /* Add_List_Element */, NULL /* Remove_List_Element */,
-        NULL /* Create */, NULL /* Delete */, NULL /* Timer */ },
+        NULL /* Create */, NULL /* Delete */, NULL /* Timer */,
+        NULL /* Read_Property_Multiple */ },
     { OBJECT_TIME_VALUE, Time_Value_Init, Time_Value_Count,
         Time_Value_Index_To_Instance, Time_Value_Valid_Instance,
         Time_Value_Object_Name, Time_Value_Read_Property,
@@ -214,7 +238,8 @@ static object_functions_t My_Object_Table[] = {
         NULL /* ReadRangeInfo */, NULL /* Iterator */, NULL /* Value_Lists */,
         NULL /* COV */, NULL /* COV Clear */, NULL /* Intrinsic Reporting */,
         NULL /* Add_List_Element */, NULL /* Remove_List_Element */,
-        NULL /* Create */, NULL /* Delete */, NULL /* Timer */ },
+        NULL /* Create */, NULL /* Delete */, NULL /* Timer */,
+        NULL /* Read_Property_Multiple */ },
 #endif
     { OBJECT_COMMAND, Command_Init, Command_Count, Command_Index_To_Instance,
         Command_Valid_Instance, Command_Object_Name, Command_Read_Property,
@@ -222,7 +247,8 @@ static object_functions_t My_Object_Table[] = {
         NULL /* ReadRangeInfo */, NULL /* Iterator */, NULL /* Value_Lists */,
         NULL /* COV */, NULL /* COV Clear */, NULL /* Intrinsic Reporting */,
         NULL /* Add_List_Element */, NULL /* Remove_List_Element */,
-        NULL /* Create */, NULL /* Delete */, NULL /* Timer */ },
+        NULL /* Create */, NULL /* Delete */, NULL /* Timer */,
+        NULL /* Read_Property_Multiple */ },
     { OBJECT_INTEGER_VALUE, Integer_Value_Init, Integer_Value_Count,
         Integer_Value_Index_To_Instance, Integer_Value_Valid_Instance,
         Integer_Value_Object_Name, Integer_Value_Read_Property,
@@ -230,7 +256,8 @@ static object_functions_t My_Object_Table[] = {
         NULL /* ReadRangeInfo */, NULL /* Iterator */, NULL /* Value_Lists */,
         NULL /* COV */, NULL /* COV Clear */, NULL /* Intrinsic Reporting */,
         NULL /* Add_List_Element */, NULL /* Remove_List_Element */,
-        NULL /* Create */, NULL /* Delete */, NULL /* Timer */ },
+        NULL /* Create */, NULL /* Delete */, NULL /* Timer */,
+        NULL /* Read_Property_Multiple */ },
 #if defined(INTRINSIC_REPORTING)
     { OBJECT_NOTIFICATION_CLASS, Notification_Class_Init,
         Notification_Class_Count, Notification_Class_Index_To_Instance,
@@ -241,7 +268,8 @@ static object_functions_t My_Object_Table[] = {
         NULL /* COV Clear */, NULL /* Intrinsic Reporting */,
         Notification_Class_Add_List_Element,
         Notification_Class_Remove_List_Element, NULL /* Create */,
-        NULL /* Delete */, NULL /* Timer */ },
+        NULL /* Delete */, NULL /* Timer */,
+        NULL /* Read_Property_Multiple */ },
 #endif
     { OBJECT_LIFE_SAFETY_POINT, Life_Safety_Point_Init, Life_Safety_Point_Count,
         Life_Safety_Point_Index_To_Instance, Life_Safety_Point_Valid_Instance,
@@ -250,7 +278,8 @@ static object_functions_t My_Object_Table[] = {
         NULL /* ReadRangeInfo */, NULL /* Iterator */, NULL /* Value_Lists */,
         NULL /* COV */, NULL /* COV Clear */, NULL /* Intrinsic Reporting */,
         NULL /* Add_List_Element */, NULL /* Remove_List_Element */,
-        Life_Safety_Point_Create, Life_Safety_Point_Delete, NULL /* Timer */ },
+        Life_Safety_Point_Create, Life_Safety_Point_Delete, NULL /* Timer */,
+        NULL /* Read_Property_Multiple */ },
     { OBJECT_LIFE_SAFETY_ZONE, Life_Safety_Zone_Init, Life_Safety_Zone_Count,
         Life_Safety_Zone_Index_To_Instance, Life_Safety_Zone_Valid_Instance,
         Life_Safety_Zone_Object_Name, Life_Safety_Zone_Read_Property,
@@ -258,7 +287,8 @@ static object_functions_t My_Object_Table[] = {
         NULL /* ReadRangeInfo */, NULL /* Iterator */, NULL /* Value_Lists */,
         NULL /* COV */, NULL /* COV Clear */, NULL /* Intrinsic Reporting */,
         NULL /* Add_List_Element */, NULL /* Remove_List_Element */,
-        Life_Safety_Zone_Create, Life_Safety_Zone_Delete, NULL /* Timer */ },
+        Life_Safety_Zone_Create, Life_Safety_Zone_Delete, NULL /* Timer */,
+        NULL /* Read_Property_Multiple */ },
     { OBJECT_LOAD_CONTROL, Load_Control_Init, Load_Control_Count,
         Load_Control_Index_To_Instance, Load_Control_Valid_Instance,
         Load_Control_Object_Name, Load_Control_Read_Property,
@@ -266,7 +296,8 @@ static object_functions_t My_Object_Table[] = {
         NULL /* ReadRangeInfo */, NULL /* Iterator */, NULL /* Value_Lists */,
         NULL /* COV */, NULL /* COV Clear */, NULL /* Intrinsic Reporting */,
         NULL /* Add_List_Element */, NULL /* Remove_List_Element */,
-        Load_Control_Create, Load_Control_Delete, Load_Control_Timer},
+        Load_Control_Create, Load_Control_Delete, Load_Control_Timer,
+        NULL /* Read_Property_Multiple */ },
     { OBJECT_MULTI_STATE_INPUT, Multistate_Input_Init, Multistate_Input_Count,
         Multistate_Input_Index_To_Instance, Multistate_Input_Valid_Instance,
         Multistate_Input_Object_Name, Multistate_Input_Read_Property,
@@ -275,7 +306,8 @@ static object_functions_t My_Object_Table[] = {
         Multistate_Input_Encode_Value_List, Multistate_Input_Change_Of_Value,
         Multistate_Input_Change_Of_Value_Clear, NULL /* Intrinsic Reporting */,
         NULL /* Add_List_Element */, NULL /* Remove_List_Element */,
-        Multistate_Input_Create, Multistate_Input_Delete, NULL /* Timer */ },
+        Multistate_Input_Create, Multistate_Input_Delete, NULL /* Timer */,
+        NULL /* Read_Property_Multiple */ },
     { OBJECT_MULTI_STATE_OUTPUT, Multistate_Output_Init,
         Multistate_Output_Count, Multistate_Output_Index_To_Instance,
         Multistate_Output_Valid_Instance, Multistate_Output_Object_Name,
@@ -285,7 +317,8 @@ static object_functions_t My_Object_Table[] = {
         Multistate_Output_Encode_Value_List, Multistate_Output_Change_Of_Value,
         Multistate_Output_Change_Of_Value_Clear, NULL /* Intrinsic Reporting */,
         NULL /* Add_List_Element */, NULL /* Remove_List_Element */,
-        Multistate_Output_Create, Multistate_Output_Delete, NULL /* Timer */ },
+        Multistate_Output_Create, Multistate_Output_Delete, NULL /* Timer */,
+        NULL /* Read_Property_Multiple */ },
     { OBJECT_MULTI_STATE_VALUE, Multistate_Value_Init, Multistate_Value_Count,
         Multistate_Value_Index_To_Instance, Multistate_Value_Valid_Instance,
         Multistate_Value_Object_Name, Multistate_Value_Read_Property,
@@ -294,7 +327,8 @@ static object_functions_t My_Object_Table[] = {
         Multistate_Value_Encode_Value_List, Multistate_Value_Change_Of_Value,
         Multistate_Value_Change_Of_Value_Clear, NULL /* Intrinsic Reporting */,
         NULL /* Add_List_Element */, NULL /* Remove_List_Element */,
-        Multistate_Value_Create, Multistate_Value_Delete, NULL /* Timer */ },
+        Multistate_Value_Create, Multistate_Value_Delete, NULL /* Timer */,
+        Multistate_Value_Read_Property_Multiple },
     { OBJECT_TRENDLOG, Trend_Log_Init, Trend_Log_Count,
         Trend_Log_Index_To_Instance, Trend_Log_Valid_Instance,
         Trend_Log_Object_Name, Trend_Log_Read_Property,
@@ -302,7 +336,8 @@ static object_functions_t My_Object_Table[] = {
         NULL /* Iterator */, NULL /* Value_Lists */, NULL /* COV */,
         NULL /* COV Clear */, NULL /* Intrinsic Reporting */,
         NULL /* Add_List_Element */, NULL /* Remove_List_Element */,
-        NULL /* Create */, NULL /* Delete */, NULL /* Timer */ },
+        NULL /* Create */, NULL /* Delete */, NULL /* Timer */,
+        NULL /* Read_Property_Multiple */ },
 #if (BACNET_PROTOCOL_REVISION >= 14)
     { OBJECT_LIGHTING_OUTPUT, Lighting_Output_Init, Lighting_Output_Count,
         Lighting_Output_Index_To_Instance, Lighting_Output_Valid_Instance,
@@ -311,14 +346,16 @@ static object_functions_t My_Object_Table[] = {
         NULL /* ReadRangeInfo */, NULL /* Iterator */, NULL /* Value_Lists */,
         NULL /* COV */, NULL /* COV Clear */, NULL /* Intrinsic Reporting */,
         NULL /* Add_List_Element */, NULL /* Remove_List_Element */,
-        Lighting_Output_Create, Lighting_Output_Delete, Lighting_Output_Timer },
+        Lighting_Output_Create, Lighting_Output_Delete, Lighting_Output_Timer,
+        NULL /* Read_Property_Multiple */ },
     { OBJECT_CHANNEL, Channel_Init, Channel_Count, Channel_Index_To_Instance,
         Channel_Valid_Instance, Channel_Object_Name, Channel_Read_Property,
         Channel_Write_Property, Channel_Property_Lists,
         NULL /* ReadRangeInfo */, NULL /* Iterator */, NULL /* Value_Lists */,
         NULL /* COV */, NULL /* COV Clear */, NULL /* Intrinsic Reporting */,
         NULL /* Add_List_Element */, NULL /* Remove_List_Element */,
-        Channel_Create, Channel_Delete, NULL /* Timer */ },
+        Channel_Create, Channel_Delete, NULL /* Timer */,
+        NULL /* Read_Property_Multiple */ },
 #endif
 #if (BACNET_PROTOCOL_REVISION >= 16)
     { OBJECT_BINARY_LIGHTING_OUTPUT, Binary_Lighting_Output_Init,
@@ -332,7 +369,8 @@ static object_functions_t My_Object_Table[] = {
         NULL /* COV Clear */, NULL /* Intrinsic Reporting */,
         NULL /* Add_List_Element */, NULL /* Remove_List_Element */,
         Binary_Lighting_Output_Create, Binary_Lighting_Output_Delete,
-        Binary_Lighting_Output_Timer },
+        Binary_Lighting_Output_Timer,
+        NULL /* Read_Property_Multiple */ },
 #endif
 #if (BACNET_PROTOCOL_REVISION >= 24)
     { OBJECT_COLOR, Color_Init, Color_Count, Color_Index_To_Instance,
@@ -341,7 +379,8 @@ static object_functions_t My_Object_Table[] = {
         NULL /* Iterator */, NULL /* Value_Lists */, NULL /* COV */,
         NULL /* COV Clear */, NULL /* Intrinsic Reporting */,
         NULL /* Add_List_Element */, NULL /* Remove_List_Element */,
-        Color_Create, Color_Delete, Color_Timer },
+        Color_Create, Color_Delete, Color_Timer,
+        NULL /* Read_Property_Multiple */ },
     { OBJECT_COLOR_TEMPERATURE, Color_Temperature_Init, Color_Temperature_Count,
         Color_Temperature_Index_To_Instance, Color_Temperature_Valid_Instance,
         Color_Temperature_Object_Name, Color_Temperature_Read_Property,
@@ -350,7 +389,8 @@ static object_functions_t My_Object_Table[] = {
         NULL /* COV */, NULL /* COV Clear */, NULL /* Intrinsic Reporting */,
         NULL /* Add_List_Element */, NULL /* Remove_List_Element */,
         Color_Temperature_Create, Color_Temperature_Delete,
-        Color_Temperature_Timer },
+        Color_Temperature_Timer,
+        NULL /* Read_Property_Multiple */ },
 #endif
 #if defined(BACFILE)
     { OBJECT_FILE, bacfile_init, bacfile_count, bacfile_index_to_instance,
@@ -359,7 +399,8 @@ static object_functions_t My_Object_Table[] = {
         NULL /* ReadRangeInfo */, NULL /* Iterator */, NULL /* Value_Lists */,
         NULL /* COV */, NULL /* COV Clear */, NULL /* Intrinsic Reporting */,
         NULL /* Add_List_Element */, NULL /* Remove_List_Element */,
-        bacfile_create, bacfile_delete, NULL /* Timer */ },
+        bacfile_create, bacfile_delete, NULL /* Timer */,
+        NULL /* Read_Property_Multiple */ },
 #endif
     { OBJECT_SCHEDULE, Schedule_Init, Schedule_Count,
         Schedule_Index_To_Instance, Schedule_Valid_Instance,
@@ -368,7 +409,8 @@ static object_functions_t My_Object_Table[] = {
         NULL /* Value_Lists */, NULL /* COV */, NULL /* COV Clear */,
         NULL /* Intrinsic Reporting */, NULL /* Add_List_Element */,
         NULL /* Remove_List_Element */, NULL /* Create */, NULL /* Delete */,
-        NULL /* Timer */ },
+        NULL /* Timer */,
+        NULL /* Read_Property_Multiple */ },
     { OBJECT_STRUCTURED_VIEW, Structured_View_Init, Structured_View_Count,
         Structured_View_Index_To_Instance, Structured_View_Valid_Instance,
         Structured_View_Object_Name, Structured_View_Read_Property,
@@ -376,7 +418,8 @@ static object_functions_t My_Object_Table[] = {
         NULL /* ReadRangeInfo */, NULL /* Iterator */, NULL /* Value_Lists */,
         NULL /* COV */, NULL /* COV Clear */,  NULL /* Intrinsic Reporting */,
         NULL /* Add_List_Element */, NULL /* Remove_List_Element */,
-        Structured_View_Create, Structured_View_Delete, NULL /* Timer */ },
+        Structured_View_Create, Structured_View_Delete, NULL /* Timer */,
+        NULL /* Read_Property_Multiple */ },
     { OBJECT_ACCUMULATOR, Accumulator_Init, Accumulator_Count,
         Accumulator_Index_To_Instance, Accumulator_Valid_Instance,
         Accumulator_Object_Name, Accumulator_Read_Property,
@@ -384,7 +427,8 @@ static object_functions_t My_Object_Table[] = {
         NULL /* ReadRangeInfo */, NULL /* Iterator */, NULL /* Value_Lists */,
         NULL /* COV */, NULL /* COV Clear */, NULL /* Intrinsic Reporting */,
         NULL /* Add_List_Element */, NULL /* Remove_List_Element */,
-        NULL /* Create */, NULL /* Delete */, NULL /* Timer */ },
+        NULL /* Create */, NULL /* Delete */, NULL /* Timer */,
+        NULL /* Read_Property_Multiple */ },
     { MAX_BACNET_OBJECT_TYPE, NULL /* Init */, NULL /* Count */,
         NULL /* Index_To_Instance */, NULL /* Valid_Instance */,
         NULL /* Object_Name */, NULL /* Read_Property */,
@@ -392,10 +436,35 @@ static object_functions_t My_Object_Table[] = {
         NULL /* ReadRangeInfo */, NULL /* Iterator */, NULL /* Value_Lists */,
         NULL /* COV */, NULL /* COV Clear */, NULL /* Intrinsic Reporting */,
         NULL /* Add_List_Element */, NULL /* Remove_List_Element */,
-        NULL /* Create */, NULL /* Delete */, NULL /* Timer */ },
+        NULL /* Create */, NULL /* Delete */, NULL /* Timer */,
+        NULL /* Read_Property_Multiple */ },
 };
 /* clang-format on */
 
+#ifdef BAC_ROUTING
+static bool Device_Router_Mode = false;
+#endif
+
+/**
+ * @brief Get the object table of the Device that is being addressed,
+ *  which is a routed Device with its own objects in a gateway
+ * @return the table of object functions
+ */
+static object_functions_t *Device_Objects_Table(void)
+{
+#ifdef BAC_ROUTING
+    object_functions_t *object_table;
+
+    if (Device_Router_Mode) {
+        object_table = Routed_Device_Object_Table();
+        if (object_table) {
+            return object_table;
+        }
+    }
+#endif
+    return Object_Table;
+}
+
 /** Glue function to let the Device object, when called by a handler,
  * lookup which Object type needs to be invoked.
  * @ingroup ObjHelpers
@@ -409,7 +478,7 @@ Device_Objects_Find_Functions(BACNET_OBJECT_TYPE Object_Type)
 {
     struct object_functions *pObject = NULL;
 
-    pObject = Object_Table;
+    pObject = Device_Objects_Table();
     while (pObject->Object_Type < MAX_BACNET_OBJECT_TYPE) {
         /* handle each object type */
         if (pObject->Object_Type == Object_Type) {
@@ -540,8 +609,82 @@ void Device_Property_Lists(
     return;
 }
 
+/**
+ * @brief Build the property bitmap of the property lists of each entry
+ *  of the object table.  When the bitmaps cannot be allocated, the property
+ *  lists are searched instead.
+ */
+static void Device_Objects_Property_Bitmap_Init(void)
+{
+    struct object_functions *pObject = NULL;
+    const int *pRequired = NULL, *pOptional = NULL, *pProprietary = NULL;
+    size_t count = 0, i;
+
+    free(Object_Property_Bitmap);
+    Object_Property_Bitmap = NULL;
+    Object_Property_Bitmap_Count = 0;
+    pObject = Object_Table;
+    while (pObject[count].Object_Type < MAX_BACNET_OBJECT_TYPE) {
+        count++;
+    }
+    if (count == 0) {
+        return;
+    }
+    Object_Property_Bitmap = calloc(count, sizeof(*Object_Property_Bitmap));
+    if (!Object_Property_Bitmap) {
+        return;
+    }
+    for (i = 0; i < count; i++) {
+        if (pObject[i].Object_RPM_List) {
+            pRequired = NULL;
+            pOptional = NULL;
+            pProprietary = NULL;
+            pObject[i].Object_RPM_List(&pRequired, &pOptional, &pProprietary);
+            property_list_bitmap_add(Object_Property_Bitmap[i], pRequired);
+            property_list_bitmap_add(Object_Property_Bitmap[i], pOptional);
+            property_list_bitmap_add(Object_Property_Bitmap[i], pProprietary);
+        }
+    }
+    Object_Property_Bitmap_Count = count;
+}
+
+/**
+ * @brief Determine if the object property is a member of the property lists
+ *  of an object table entry
+ * @param pObject - entry of the object table in use
+ * @param object_property - object-property to be checked
+ * @return true if the property is a member of the property lists
+ */
+static bool Device_Objects_Property_Member(
+    const struct object_functions *pObject, BACNET_PROPERTY_ID object_property)
+{
+    const int *pRequired = NULL, *pOptional = NULL, *pProprietary = NULL;
+    size_t index;
+
+    if ((pObject == NULL) || (pObject->Object_RPM_List == NULL)) {
+        return false;
+    }
+    /* a routed device has its own object table, without bitmaps */
+    if (Object_Property_Bitmap && (Device_Objects_Table() == Object_Table) &&
+        (object_property < PROPERTY_LIST_BITMAP_BITS)) {
+        index = (size_t)(pObject - Object_Table);
+        if (index < Object_Property_Bitmap_Count) {
+            return property_list_bitmap_member(
+                Object_Property_Bitmap[index], object_property);
+        }
+    }
+    pObject->Object_RPM_List(&pRequired, &pOptional, &pProprietary);
+
+    return property_lists_member(
+        pRequired, pOptional, pProprietary, object_property);
+}
+
 /**
  * @brief Determine if the object property is a member of this object instance
+ * @note The property lists of each entry of the object table are kept
+ *  as property bitmaps, so that the check of a standard property is done
+ *  in constant time.  Properties beyond the bitmap are searched for in the
+ *  property lists.
  * @param object_type - object type of the object
  * @param object_instance - object-instance number of the object
  * @param object_property - object-property to be checked
@@ -552,21 +695,10 @@ bool Device_Objects_Property_List_Member(
     uint32_t object_instance,
     BACNET_PROPERTY_ID object_property)
 {
-    bool found = false;
-    struct special_property_list_t property_list = { 0 };
-
-    Device_Objects_Property_List(object_type, object_instance, &property_list);
-    found = property_list_member(property_list.Required.pList, object_property);
-    if (!found) {
-        found =
-            property_list_member(property_list.Optional.pList, object_property);
-    }
-    if (!found) {
-        found = property_list_member(
-            property_list.Proprietary.pList, object_property);
-    }
+    (void)object_instance;
 
-    return found;
+    return Device_Objects_Property_Member(
+        Device_Objects_Find_Functions(object_type), object_property);
 }
 
 /* note: you really only need to define variables for
@@ -627,10 +759,8 @@ static uint32_t Database_Revision = 0;
 static BACNET_REINITIALIZED_STATE Reinitialize_State = BACNET_REINIT_IDLE;
 static const char *Reinit_Password = "filister";
 static write_property_function Device_Write_Property_Store_Callback;
-
-#ifdef BAC_ROUTING
-static bool Device_Router_Mode = false;
-#endif
+static object_store_function Device_Create_Object_Store_Callback;
+static object_store_function Device_Delete_Object_Store_Callback;
 
 /**
  * @brief Sets the ReinitializeDevice password
@@ -1071,7 +1201,7 @@ unsigned Device_Object_List_Count(void)
     struct object_functions *pObject = NULL;
 
     /* initialize the default return values */
-    pObject = Object_Table;
+    pObject = Device_Objects_Table();
     while (pObject->Object_Type < MAX_BACNET_OBJECT_TYPE) {
         if (pObject->Object_Count) {
             count += pObject->Object_Count();
@@ -1107,7 +1237,7 @@ bool Device_Object_List_Identifier(
     }
     object_index = array_index - 1;
     /* initialize the default return values */
-    pObject = Object_Table;
+    pObject = Device_Objects_Table();
     while (pObject->Object_Type < MAX_BACNET_OBJECT_TYPE) {
         if (pObject->Object_Count) {
             object_index -= count;
@@ -1390,48 +1520,48 @@ int Device_Read_Property_Local(BACNET_READ_PROPERTY_DATA *rpdata)
                 &apdu[0], OBJECT_DEVICE, Object_Instance_Number);
             break;
         case PROP_OBJECT_NAME:
-            apdu_len =
-                encode_application_character_string(&apdu[0], &My_Object_Name);
+            apdu_len = read_property_character_string_encode(
+                rpdata, &apdu[0], &My_Object_Name);
             break;
         case PROP_OBJECT_TYPE:
             apdu_len = encode_application_enumerated(&apdu[0], OBJECT_DEVICE);
             break;
         case PROP_DESCRIPTION:
             characterstring_init_ansi(&char_string, Description);
-            apdu_len =
-                encode_application_character_string(&apdu[0], &char_string);
+            apdu_len = read_property_character_string_encode(
+                rpdata, &apdu[0], &char_string);
             break;
         case PROP_SYSTEM_STATUS:
             apdu_len = encode_application_enumerated(&apdu[0], System_Status);
             break;
         case PROP_VENDOR_NAME:
             characterstring_init_ansi(&char_string, Vendor_Name);
-            apdu_len =
-                encode_application_character_string(&apdu[0], &char_string);
+            apdu_len = read_property_character_string_encode(
+                rpdata, &apdu[0], &char_string);
             break;
         case PROP_VENDOR_IDENTIFIER:
             apdu_len = encode_application_unsigned(&apdu[0], Vendor_Identifier);
             break;
         case PROP_MODEL_NAME:
             characterstring_init_ansi(&char_string, Model_Name);
-            apdu_len =
-                encode_application_character_string(&apdu[0], &char_string);
+            apdu_len = read_property_character_string_encode(
+                rpdata, &apdu[0], &char_string);
             break;
         case PROP_FIRMWARE_REVISION:
             characterstring_init_ansi(&char_string, BACnet_Version);
-            apdu_len =
-                encode_application_character_string(&apdu[0], &char_string);
+            apdu_len = read_property_character_string_encode(
+                rpdata, &apdu[0], &char_string);
             break;
         case PROP_APPLICATION_SOFTWARE_VERSION:
             characterstring_init_ansi(
                 &char_string, Application_Software_Version);
-            apdu_len =
-                encode_application_character_string(&apdu[0], &char_string);
+            apdu_len = read_property_character_string_encode(
+                rpdata, &apdu[0], &char_string);
             break;
         case PROP_LOCATION:
             characterstring_init_ansi(&char_string, Location);
-            apdu_len =
-                encode_application_character_string(&apdu[0], &char_string);
+            apdu_len = read_property_character_string_encode(
+                rpdata, &apdu[0], &char_string);
             break;
         case PROP_LOCAL_TIME:
             Update_Current_Time();
@@ -1479,7 +1609,7 @@ int Device_Read_Property_Local(BACNET_READ_PROPERTY_DATA *rpdata)
             }
             /* set the object types with objects to supported */
 
-            pObject = Object_Table;
+            pObject = Device_Objects_Table();
             while (pObject->Object_Type < MAX_BACNET_OBJECT_TYPE) {
                 if ((pObject->Object_Count) && (pObject->Object_Count() > 0)) {
                     bitstring_set_bit(
@@ -1563,8 +1693,8 @@ int Device_Read_Property_Local(BACNET_READ_PROPERTY_DATA *rpdata)
             break;
         case PROP_SERIAL_NUMBER:
             characterstring_init_ansi(&char_string, Serial_Number);
-            apdu_len =
-                encode_application_character_string(&apdu[0], &char_string);
+            apdu_len = read_property_character_string_encode(
+                rpdata, &apdu[0], &char_string);
             break;
         case PROP_TIME_OF_DEVICE_RESTART:
             apdu_len =
@@ -1601,7 +1731,7 @@ static int Read_Property_Common(
     BACNET_CHARACTER_STRING char_string;
     uint8_t *apdu = NULL;
 #if (BACNET_PROTOCOL_REVISION >= 14)
-    struct special_property_list_t property_list;
+    const int *pRequired = NULL, *pOptional = NULL, *pProprietary = NULL;
 #endif
 
     if ((rpdata->application_data == NULL) ||
@@ -1623,17 +1753,23 @@ static int Read_Property_Common(
                 (void)pObject->Object_Name(
                     rpdata->object_instance, &char_string);
             }
-            apdu_len =
-                encode_application_character_string(&apdu[0], &char_string);
+            apdu_len = read_property_character_string_encode(
+                rpdata, &apdu[0], &char_string);
         }
 #if (BACNET_PROTOCOL_REVISION >= 14)
     } else if (rpdata->object_property == PROP_PROPERTY_LIST) {
-        Device_Objects_Property_List(
-            rpdata->object_type, rpdata->object_instance, &property_list);
-        apdu_len = property_list_encode(
-            rpdata, property_list.Required.pList, property_list.Optional.pList,
-            property_list.Proprietary.pList);
+        if (pObject->Object_RPM_List) {
+            pObject->Object_RPM_List(&pRequired, &pOptional, &pProprietary);
+        }
+        apdu_len =
+            property_list_encode(rpdata, pRequired, pOptional, pProprietary);
 #endif
+    } else if (
+        pObject->Object_RPM_List &&
+        !Device_Objects_Property_Member(pObject, rpdata->object_property)) {
+        rpdata->error_class = ERROR_CLASS_PROPERTY;
+        rpdata->error_code = ERROR_CODE_UNKNOWN_PROPERTY;
+        apdu_len = BACNET_STATUS_ERROR;
     } else if (pObject->Object_Read_Property) {
         apdu_len = pObject->Object_Read_Property(rpdata);
     }
@@ -1675,6 +1811,37 @@ int Device_Read_Property(BACNET_READ_PROPERTY_DATA *rpdata)
     return apdu_len;
 }
 
+/**
+ * @brief Looks up the requested Object once, and encodes the values of its
+ *  special property ALL, REQUIRED, or OPTIONAL directly into the
+ *  ReadPropertyMultiple-Ack, using the object fast path when available.
+ * @ingroup ObjIntf
+ * @param writer [in] bounded writer for the listOfResults of the reply
+ * @param rpdata [in,out] Structure with the desired Object and the special
+ *  property on entry, and the error code on abort or reject.
+ * @return BACNET_STATUS_OK, or BACNET_STATUS_ABORT or BACNET_STATUS_REJECT
+ */
+int Device_Read_Property_Multiple(
+    BACNET_WRITER *writer, BACNET_READ_PROPERTY_DATA *rpdata)
+{
+    struct object_functions *pObject = NULL;
+    const int *pRequired = NULL, *pOptional = NULL, *pProprietary = NULL;
+
+    pObject = Device_Objects_Find_Functions(rpdata->object_type);
+    if (pObject && pObject->Object_Read_Property_Multiple) {
+        return pObject->Object_Read_Property_Multiple(writer, rpdata);
+    }
+    /* the properties are encoded in the order of the lists, which are
+       walked once, without counting them first */
+    if (pObject && pObject->Object_RPM_List) {
+        pObject->Object_RPM_List(&pRequired, &pOptional, &pProprietary);
+    }
+
+    return rpm_ack_property_list_encode(
+        writer, rpdata, pRequired, pOptional, pProprietary,
+        Device_Read_Property);
+}
+
 /* returns true if successful */
 bool Device_Write_Property_Local(BACNET_WRITE_PROPERTY_DATA *wp_data)
 {
@@ -2007,6 +2174,24 @@ static void Device_Write_Property_Store(BACNET_WRITE_PROPERTY_DATA *wp_data)
     }
 }
 
+/**
+ * @brief Set the callback for a CreateObject successful operation
+ * @param cb [in] The function to be called, or NULL to disable
+ */
+void Device_Create_Object_Store_Callback_Set(object_store_function cb)
+{
+    Device_Create_Object_Store_Callback = cb;
+}
+
+/**
+ * @brief Set the callback for a DeleteObject successful operation
+ * @param cb [in] The function to be called, or NULL to disable
+ */
+void Device_Delete_Object_Store_Callback_Set(object_store_function cb)
+{
+    Device_Delete_Object_Store_Callback = cb;
+}
+
 /** Looks up the requested Object and Property, and set the new Value in it,
  *  if allowed.
  * If the Object or Property can't be found, sets the error class and code.
@@ -2036,6 +2221,13 @@ bool Device_Write_Property(BACNET_WRITE_PROPERTY_DATA *wp_data)
                     return status;
                 }
 #endif
+                if (pObject->Object_RPM_List &&
+                    !Device_Objects_Property_Member(
+                        pObject, wp_data->object_property)) {
+                    wp_data->error_class = ERROR_CLASS_PROPERTY;
+                    wp_data->error_code = ERROR_CODE_UNKNOWN_PROPERTY;
+                    return status;
+                }
                 if (wp_data->object_property == PROP_OBJECT_NAME) {
                     status = Device_Write_Property_Object_Name(
                         wp_data, pObject->Object_Write_Property);
@@ -2250,6 +2442,10 @@ bool Device_Create_Object(BACNET_CREATE_OBJECT_DATA *data)
                     /* required by ACK */
                     data->object_instance = object_instance;
                     Device_Inc_Database_Revision();
+                    if (Device_Create_Object_Store_Callback) {
+                        Device_Create_Object_Store_Callback(
+                            data->object_type, object_instance);
+                    }
                     status = true;
                 }
             }
@@ -2289,6 +2485,10 @@ bool Device_Delete_Object(BACNET_DELETE_OBJECT_DATA *data)
             status = pObject->Object_Delete(data->object_instance);
             if (status) {
                 Device_Inc_Database_Revision();
+                if (Device_Delete_Object_Store_Callback) {
+                    Device_Delete_Object_Store_Callback(
+                        data->object_type, data->object_instance);
+                }
             } else {
                 /* The object exists but cannot be deleted. */
                 data->error_class = ERROR_CLASS_OBJECT;
@@ -2374,6 +2574,11 @@ void Device_Init(object_functions_t *object_table)
     } else {
         Object_Table = &My_Object_Table[0];
     }
+    if (Object_Timer_List) {
+        /* the timers belong to the previous object table */
+        while (Keylist_Data_Pop(Object_Timer_List)) {
+        }
+    }
     pObject = Object_Table;
     while (pObject->Object_Type < MAX_BACNET_OBJECT_TYPE) {
         if (pObject->Object_Init) {
@@ -2381,9 +2586,11 @@ void Device_Init(object_functions_t *object_table)
         }
         pObject++;
     }
+    Device_Objects_Property_Bitmap_Init();
 #if (BACNET_PROTOCOL_REVISION >= 14)
     Channel_Write_Property_Internal_Callback_Set(Device_Write_Property);
 #endif
+    Schedule_Write_Property_Internal_Callback_Set(Device_Write_Property);
 }
 
 bool DeviceGetRRInfo(
@@ -2439,30 +2646,111 @@ bool DeviceGetRRInfo(
 }
 
 /**
- * @brief Updates all the object timers with elapsed milliseconds
+ * @brief Find the index of the first registered timer after a key
+ * @param key - the key of a registered timer, which may have been removed
+ * @return index of the next registered timer
+ */
+static int Device_Timer_Index_After(KEY key)
+{
+    int left = 0;
+    int right = Keylist_Count(Object_Timer_List);
+    int middle;
+    KEY middle_key = 0;
+
+    while (left < right) {
+        middle = left + ((right - left) / 2);
+        (void)Keylist_Index_Key(Object_Timer_List, middle, &middle_key);
+        if (middle_key <= key) {
+            left = middle + 1;
+        } else {
+            right = middle;
+        }
+    }
+
+    return left;
+}
+
+/**
+ * @brief Updates the object timers with elapsed milliseconds.
+ *  Only the objects that registered a timed operation in progress
+ *  are called, so the cost is proportional to the active operations
+ *  rather than to the number of objects in the device.
  * @param milliseconds - number of milliseconds elapsed
  */
 void Device_Timer(uint16_t milliseconds)
 {
     struct object_functions *pObject;
-    unsigned count = 0;
-    uint32_t instance;
+    KEY key = 0;
+    int index = 0;
+
+    while (Keylist_Index_Key(Object_Timer_List, index, &key)) {
+        pObject = Keylist_Data_Index(Object_Timer_List, index);
+        if (pObject && pObject->Object_Timer) {
+            pObject->Object_Timer(
+                (uint32_t)KEY_DECODE_ID(key), milliseconds);
+        }
+        /* the timer may register or unregister objects */
+        index = Device_Timer_Index_After(key);
+    }
+}
+
+/**
+ * @brief Registers an object with a timed operation in progress, such as
+ *  a fade, ramp, step, blink-warn, or load shed, so that Device_Timer()
+ *  calls the timer of the object until the object is unregistered.
+ * @param object_type - BACnet object type of the object
+ * @param object_instance - object-instance number of the object
+ * @return true if the object is registered, or was already registered
+ */
+bool Device_Timer_Register(
+    BACNET_OBJECT_TYPE object_type, uint32_t object_instance)
+{
+    struct object_functions *pObject;
+    KEY key;
 
+    if ((object_instance > BACNET_MAX_INSTANCE) || (!Object_Table)) {
+        return false;
+    }
+    key = KEY_ENCODE(object_type, object_instance);
+    if (Keylist_Index(Object_Timer_List, key) >= 0) {
+        return true;
+    }
     pObject = Object_Table;
     while (pObject->Object_Type < MAX_BACNET_OBJECT_TYPE) {
-        if (pObject->Object_Count) {
-            count = pObject->Object_Count();
-        }
-        while (count) {
-            count--;
-            if ((pObject->Object_Timer) &&
-                (pObject->Object_Index_To_Instance)) {
-                instance = pObject->Object_Index_To_Instance(count);
-                pObject->Object_Timer(instance, milliseconds);
-            }
+        if (pObject->Object_Type == object_type) {
+            break;
         }
         pObject++;
     }
+    if ((pObject->Object_Type != object_type) || (!pObject->Object_Timer)) {
+        return false;
+    }
+    if (!Object_Timer_List) {
+        Object_Timer_List = Keylist_Create();
+    }
+
+    return Keylist_Data_Add(Object_Timer_List, key, pObject) >= 0;
+}
+
+/**
+ * @brief Unregisters an object when its timed operation has ended
+ * @param object_type - BACnet object type of the object
+ * @param object_instance - object-instance number of the object
+ */
+void Device_Timer_Unregister(
+    BACNET_OBJECT_TYPE object_type, uint32_t object_instance)
+{
+    (void)Keylist_Data_Delete(
+        Object_Timer_List, KEY_ENCODE(object_type, object_instance));
+}
+
+/**
+ * @brief Get the number of objects registered with the Device timer
+ * @return number of objects with a timed operation in progress
+ */
+unsigned Device_Timer_Count(void)
+{
+    return (unsigned)Keylist_Count(Object_Timer_List);
 }
 
 #ifdef BAC_ROUTING
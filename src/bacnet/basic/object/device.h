@@ -110,6 +110,14 @@ typedef void (*object_intrinsic_reporting_function)(uint32_t object_instance);
 typedef void (*object_timer_function)(
     uint32_t object_instance, uint16_t milliseconds);
 
+/**
+ * @brief Stores an object that was created or deleted
+ * @param object_type - object type of the object
+ * @param object_instance - object-instance number of the object
+ */
+typedef void (*object_store_function)(
+    BACNET_OBJECT_TYPE object_type, uint32_t object_instance);
+
 /** Defines the group of object helper functions for any supported Object.
  * @ingroup ObjHelpers
  * Each Object must provide some implementation of each of these helpers
@@ -140,6 +148,7 @@ typedef struct object_functions {
     create_object_function Object_Create;
     delete_object_function Object_Delete;
     object_timer_function Object_Timer;
+    read_property_multiple_function Object_Read_Property_Multiple;
 } object_functions_t;
 
 /* String Lengths - excluding any nul terminator */
@@ -189,6 +198,10 @@ typedef struct devObj_s {
     /** The upcounter that shows if the Device ID or object structure has
      * changed. */
     uint32_t Database_Revision;
+
+    /** The objects of this Device, or NULL for the objects of the gateway
+     * Device. */
+    object_functions_t *Object_Table;
 } DEVICE_OBJECT_DATA;
 
 #ifdef __cplusplus
@@ -200,6 +213,14 @@ void Device_Init(object_functions_t *object_table);
 
 BACNET_STACK_EXPORT
 void Device_Timer(uint16_t milliseconds);
+BACNET_STACK_EXPORT
+bool Device_Timer_Register(
+    BACNET_OBJECT_TYPE object_type, uint32_t object_instance);
+BACNET_STACK_EXPORT
+void Device_Timer_Unregister(
+    BACNET_OBJECT_TYPE object_type, uint32_t object_instance);
+BACNET_STACK_EXPORT
+unsigned Device_Timer_Count(void);
 
 BACNET_STACK_EXPORT
 bool Device_Reinitialize(BACNET_REINITIALIZE_DEVICE_DATA *rd_data);
@@ -378,6 +399,9 @@ bool Device_Valid_Object_Id(
 BACNET_STACK_EXPORT
 int Device_Read_Property(BACNET_READ_PROPERTY_DATA *rpdata);
 BACNET_STACK_EXPORT
+int Device_Read_Property_Multiple(
+    BACNET_WRITER *writer, BACNET_READ_PROPERTY_DATA *rpdata);
+BACNET_STACK_EXPORT
 bool Device_Write_Property(BACNET_WRITE_PROPERTY_DATA *wp_data);
 
 BACNET_STACK_EXPORT
@@ -397,6 +421,10 @@ BACNET_STACK_EXPORT
 bool Device_Write_Property_Local(BACNET_WRITE_PROPERTY_DATA *wp_data);
 BACNET_STACK_EXPORT
 void Device_Write_Property_Store_Callback_Set(write_property_function cb);
+BACNET_STACK_EXPORT
+void Device_Create_Object_Store_Callback_Set(object_store_function cb);
+BACNET_STACK_EXPORT
+void Device_Delete_Object_Store_Callback_Set(object_store_function cb);
 
 #if defined(INTRINSIC_REPORTING)
 BACNET_STACK_EXPORT
@@ -416,9 +444,30 @@ uint16_t Add_Routed_Device(
     const BACNET_CHARACTER_STRING *Object_Name,
     const char *Description);
 BACNET_STACK_EXPORT
+void Routed_Device_Max_Set(uint16_t count);
+BACNET_STACK_EXPORT
+uint16_t Routed_Device_Max(void);
+BACNET_STACK_EXPORT
+uint16_t Routed_Device_Count(void);
+BACNET_STACK_EXPORT
+int Routed_Device_MAC_Index(uint8_t mac_len, const uint8_t *mac);
+BACNET_STACK_EXPORT
+int Routed_Device_Instance_Index(uint32_t object_instance);
+BACNET_STACK_EXPORT
+bool Routed_Device_Context_Set(int idx);
+BACNET_STACK_EXPORT
+int Routed_Device_Context(void);
+BACNET_STACK_EXPORT
+bool Routed_Device_Object_Table_Set(
+    int idx, object_functions_t *object_table);
+BACNET_STACK_EXPORT
+object_functions_t *Routed_Device_Object_Table(void);
+BACNET_STACK_EXPORT
 DEVICE_OBJECT_DATA *Get_Routed_Device_Object(int idx);
 BACNET_STACK_EXPORT
 BACNET_ADDRESS *Get_Routed_Device_Address(int idx);
+BACNET_STACK_EXPORT
+bool Routed_Device_Address_Set(int idx, const BACNET_ADDRESS *address);
 
 BACNET_STACK_EXPORT
 bool Routed_Device_Address_Lookup(
@@ -9,6 +9,7 @@
  */
 #include <stdbool.h>
 #include <stdint.h>
+#include <stdlib.h>
 #include <string.h>
 /* BACnet Stack defines - first */
 #include "bacnet/bacdef.h"
@@ -63,23 +64,370 @@ bool Routed_Device_Write_Property_Local(BACNET_WRITE_PROPERTY_DATA *wp_data);
  * and extending the regular Device Object functionality.
  ****************************************************************************/
 
-/** Model the gateway as the main Device, with (two) remote
- * Devices that are reached via its routing capabilities.
+/* number of Devices[] entries allocated when the table first grows */
+#ifndef ROUTED_DEVICE_TABLE_SIZE_MIN
+#define ROUTED_DEVICE_TABLE_SIZE_MIN 16
+#endif
+/* end of a hash chain, or no device */
+#define ROUTED_DEVICE_NONE UINT16_MAX
+
+/* links of a Device in the MAC address and instance hash chains */
+typedef struct routed_device_link {
+    uint16_t MAC_Next;
+    uint16_t Instance_Next;
+} ROUTED_DEVICE_LINK;
+
+/** Model the gateway as the main Device, with remote Devices that are
+ * reached via its routing capabilities.  The table grows on demand up
+ * to Routed_Device_Max() entries.
  */
-DEVICE_OBJECT_DATA Devices[MAX_NUM_DEVICES];
+static DEVICE_OBJECT_DATA *Devices;
+static ROUTED_DEVICE_LINK *Device_Links;
+/** Number of Devices[] entries allocated */
+static uint16_t Devices_Size;
+/** Most Devices that may be managed, including the gateway */
+static uint16_t Devices_Max = MAX_NUM_DEVICES;
 /** Keep track of the number of managed devices, including the gateway */
-uint16_t Num_Managed_Devices = 0;
+static uint16_t Num_Managed_Devices = 0;
 /** Which Device entry are we currently managing.
- * Since we are not using actual class objects here, the best we can do is
- * keep this local variable which notes which of the Devices the current
- * request is addressing.  Should default to 0, the main gateway Device.
+ * The service handlers find the Device that a request is addressing
+ * through this index, which is selected with Routed_Device_Context_Set()
+ * before the request is handled.  Defaults to 0, the main gateway Device.
  */
-uint16_t iCurrent_Device_Idx = 0;
+static uint16_t iCurrent_Device_Idx = 0;
+/* hash tables of the routed Devices by virtual MAC address and by
+   Device instance, each with a power of two number of buckets */
+static uint16_t *MAC_Hash;
+static uint16_t *Instance_Hash;
+static uint16_t Hash_Size;
+/* the hash tables are rebuilt before the next lookup */
+static bool Hash_Stale = true;
 
 /* void Routing_Device_Init(uint32_t first_object_instance) is
  * found in device.c
  */
 
+/**
+ * @brief Hash a MAC address
+ * @param mac_len [in] number of bytes in the MAC address
+ * @param mac [in] the MAC address
+ * @return hash of the MAC address
+ */
+static uint32_t Routed_Device_MAC_Hash(uint8_t mac_len, const uint8_t *mac)
+{
+    uint32_t hash = 2166136261UL;
+    uint8_t i;
+
+    for (i = 0; i < mac_len; i++) {
+        hash ^= mac[i];
+        hash *= 16777619UL;
+    }
+
+    return hash;
+}
+
+/**
+ * @brief Hash a Device object instance
+ * @param instance [in] Device object instance
+ * @return hash of the instance
+ */
+static uint32_t Routed_Device_Instance_Hash(uint32_t instance)
+{
+    uint32_t hash = instance;
+
+    hash ^= hash >> 16;
+    hash *= 0x85EBCA6BUL;
+    hash ^= hash >> 13;
+    hash *= 0xC2B2AE35UL;
+    hash ^= hash >> 16;
+
+    return hash;
+}
+
+/**
+ * @brief Rebuild the MAC address and instance hash tables when a Device
+ *  was added, or may have been changed through a returned pointer
+ */
+static void Routed_Device_Hash_Update(void)
+{
+    DEVICE_OBJECT_DATA *pDev;
+    uint32_t bucket;
+    uint16_t i;
+
+    if (!Hash_Stale) {
+        return;
+    }
+    for (i = 0; i < Hash_Size; i++) {
+        MAC_Hash[i] = ROUTED_DEVICE_NONE;
+        Instance_Hash[i] = ROUTED_DEVICE_NONE;
+    }
+    for (i = 0; i < Num_Managed_Devices; i++) {
+        pDev = &Devices[i];
+        bucket = Routed_Device_Instance_Hash(
+                     pDev->bacObj.Object_Instance_Number) &
+            (Hash_Size - 1);
+        Device_Links[i].Instance_Next = Instance_Hash[bucket];
+        Instance_Hash[bucket] = i;
+        /* only the routed Devices are reached by virtual MAC address */
+        Device_Links[i].MAC_Next = ROUTED_DEVICE_NONE;
+        if (i > 0) {
+            bucket = Routed_Device_MAC_Hash(
+                         pDev->bacDevAddr.len, pDev->bacDevAddr.adr) &
+                (Hash_Size - 1);
+            Device_Links[i].MAC_Next = MAC_Hash[bucket];
+            MAC_Hash[bucket] = i;
+        }
+    }
+    Hash_Stale = false;
+}
+
+/**
+ * @brief Grow the Devices[] table and its hash tables to hold one more
+ *  Device
+ * @return true if there is room for another Device
+ */
+static bool Routed_Device_Table_Grow(void)
+{
+    DEVICE_OBJECT_DATA *devices;
+    ROUTED_DEVICE_LINK *links;
+    uint16_t *mac_hash;
+    uint16_t *instance_hash;
+    uint32_t size;
+    uint32_t hash_size;
+
+    if (Num_Managed_Devices < Devices_Size) {
+        return true;
+    }
+    if (Num_Managed_Devices >= Devices_Max) {
+        return false;
+    }
+    size = Devices_Size ? (uint32_t)Devices_Size * 2
+                        : ROUTED_DEVICE_TABLE_SIZE_MIN;
+    if (size > Devices_Max) {
+        size = Devices_Max;
+    }
+    hash_size = 1;
+    while ((hash_size < size) && (hash_size < 32768UL)) {
+        hash_size <<= 1;
+    }
+    mac_hash = malloc(hash_size * sizeof(uint16_t));
+    instance_hash = malloc(hash_size * sizeof(uint16_t));
+    links = malloc(size * sizeof(ROUTED_DEVICE_LINK));
+    devices = realloc(Devices, size * sizeof(DEVICE_OBJECT_DATA));
+    if (!mac_hash || !instance_hash || !links || !devices) {
+        free(mac_hash);
+        free(instance_hash);
+        free(links);
+        if (devices) {
+            Devices = devices;
+        }
+        return false;
+    }
+    memset(
+        &devices[Devices_Size], 0,
+        (size - Devices_Size) * sizeof(DEVICE_OBJECT_DATA));
+    Devices = devices;
+    free(Device_Links);
+    Device_Links = links;
+    free(MAC_Hash);
+    MAC_Hash = mac_hash;
+    free(Instance_Hash);
+    Instance_Hash = instance_hash;
+    Devices_Size = (uint16_t)size;
+    Hash_Size = (uint16_t)hash_size;
+    Hash_Stale = true;
+
+    return true;
+}
+
+/** Set the most Devices that may be managed, including the gateway.
+ * The Devices[] table grows on demand up to this number of entries.
+ * @param count [in] most Devices, 1 to UINT16_MAX-1; a count below the
+ *  number of Devices already added is raised to that number.
+ */
+void Routed_Device_Max_Set(uint16_t count)
+{
+    if (count == ROUTED_DEVICE_NONE) {
+        count = ROUTED_DEVICE_NONE - 1;
+    }
+    if (count < Num_Managed_Devices) {
+        count = Num_Managed_Devices;
+    }
+    if (count == 0) {
+        count = 1;
+    }
+    Devices_Max = count;
+}
+
+/** Get the most Devices that may be managed, including the gateway.
+ * @return the most Devices that may be managed
+ */
+uint16_t Routed_Device_Max(void)
+{
+    return Devices_Max;
+}
+
+/** Get the number of managed Devices, including the gateway.
+ * @return the number of Devices added with Add_Routed_Device()
+ */
+uint16_t Routed_Device_Count(void)
+{
+    return Num_Managed_Devices;
+}
+
+/** Find a routed Device by its virtual MAC address.
+ * The lookup does not change the Device that is currently managed.
+ * @param mac_len [in] number of bytes in the MAC address
+ * @param mac [in] the virtual MAC address
+ * @return index of the routed Device in Devices[], or -1 if not found
+ */
+int Routed_Device_MAC_Index(uint8_t mac_len, const uint8_t *mac)
+{
+    DEVICE_OBJECT_DATA *pDev;
+    uint16_t i;
+
+    if ((Num_Managed_Devices == 0) || (mac == NULL)) {
+        return -1;
+    }
+    Routed_Device_Hash_Update();
+    i = MAC_Hash[Routed_Device_MAC_Hash(mac_len, mac) & (Hash_Size - 1)];
+    while (i != ROUTED_DEVICE_NONE) {
+        pDev = &Devices[i];
+        if ((pDev->bacDevAddr.len == mac_len) &&
+            (memcmp(pDev->bacDevAddr.adr, mac, mac_len) == 0)) {
+            return i;
+        }
+        i = Device_Links[i].MAC_Next;
+    }
+
+    return -1;
+}
+
+/** Find a Device by its object instance.
+ * The lookup does not change the Device that is currently managed.
+ * @param object_instance [in] Device object instance
+ * @return index of the Device in Devices[], or -1 if not found
+ */
+int Routed_Device_Instance_Index(uint32_t object_instance)
+{
+    uint16_t i;
+
+    if (Num_Managed_Devices == 0) {
+        return -1;
+    }
+    Routed_Device_Hash_Update();
+    i = Instance_Hash
+        [Routed_Device_Instance_Hash(object_instance) & (Hash_Size - 1)];
+    while (i != ROUTED_DEVICE_NONE) {
+        if (Devices[i].bacObj.Object_Instance_Number == object_instance) {
+            return i;
+        }
+        i = Device_Links[i].Instance_Next;
+    }
+
+    return -1;
+}
+
+/** Select the Device that the following service handling addresses.
+ * @param idx [in] Index into Devices[]; 0 is the main gateway Device.
+ * @return true if the index is a managed Device and was selected
+ */
+bool Routed_Device_Context_Set(int idx)
+{
+    if ((idx >= 0) && (idx < Num_Managed_Devices)) {
+        iCurrent_Device_Idx = (uint16_t)idx;
+        return true;
+    }
+
+    return false;
+}
+
+/** Get the Device that the service handling currently addresses.
+ * @return index into Devices[]; 0 is the main gateway Device.
+ */
+int Routed_Device_Context(void)
+{
+    return iCurrent_Device_Idx;
+}
+
+/** Determine if a table of object functions is used by any Device
+ * @param object_table [in] table of object functions
+ * @return true if the table is used by a Device
+ */
+static bool Routed_Device_Object_Table_Used(
+    const object_functions_t *object_table)
+{
+    uint16_t i;
+
+    for (i = 0; i < Num_Managed_Devices; i++) {
+        if (Devices[i].Object_Table == object_table) {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+/** Use a separate table of object functions for a Device, so that each
+ * routed Device may present its own objects.  The Device object entry
+ * of the table is set to the routed Device functions.  The Object_Init
+ * function of the other object types is called when the table is first
+ * used, so a table may be shared by several Devices.
+ * @param idx [in] Index into Devices[]; 0 is the main gateway Device.
+ * @param object_table [in] table of object functions, terminated by
+ *  MAX_BACNET_OBJECT_TYPE, with the Device object first; or NULL to use
+ *  the object table of the gateway.
+ * @return true if the object table was set
+ */
+bool Routed_Device_Object_Table_Set(
+    int idx, object_functions_t *object_table)
+{
+    object_functions_t *pObject;
+
+    if ((idx < 0) || (idx >= Num_Managed_Devices)) {
+        return false;
+    }
+    if (object_table) {
+        if (object_table->Object_Type != OBJECT_DEVICE) {
+            return false;
+        }
+        if (!Routed_Device_Object_Table_Used(object_table)) {
+            pObject = object_table + 1;
+            while (pObject->Object_Type < MAX_BACNET_OBJECT_TYPE) {
+                if (pObject->Object_Init) {
+                    pObject->Object_Init();
+                }
+                pObject++;
+            }
+        }
+        object_table->Object_Index_To_Instance =
+            Routed_Device_Index_To_Instance;
+        object_table->Object_Valid_Instance =
+            Routed_Device_Valid_Object_Instance_Number;
+        object_table->Object_Name = Routed_Device_Name;
+        object_table->Object_Read_Property =
+            Routed_Device_Read_Property_Local;
+        object_table->Object_Write_Property =
+            Routed_Device_Write_Property_Local;
+    }
+    Devices[idx].Object_Table = object_table;
+
+    return true;
+}
+
+/** Get the table of object functions of the currently managed Device.
+ * @return the object table of the Device, or NULL when the Device uses
+ *  the object table of the gateway
+ */
+object_functions_t *Routed_Device_Object_Table(void)
+{
+    if (iCurrent_Device_Idx < Num_Managed_Devices) {
+        return Devices[iCurrent_Device_Idx].Object_Table;
+    }
+
+    return NULL;
+}
+
 /** Add a Device to our table of Devices[].
  * The first entry must be the gateway device.
  * @param Object_Instance [in] Set the new Device to this instance number.
@@ -94,10 +442,16 @@ uint16_t Add_Routed_Device(
     const char *sDescription)
 {
     int i = Num_Managed_Devices;
-    if (i < MAX_NUM_DEVICES) {
+    int current;
+    if (Routed_Device_Table_Grow()) {
         DEVICE_OBJECT_DATA *pDev = &Devices[i];
+        memset(pDev, 0, sizeof(DEVICE_OBJECT_DATA));
         Num_Managed_Devices++;
-        iCurrent_Device_Idx = i;
+        Hash_Stale = true;
+        /* the name and description are set in the new Device, which
+           is selected only while they are set */
+        current = Routed_Device_Context();
+        Routed_Device_Context_Set(i);
         pDev->bacObj.mObject_Type = OBJECT_DEVICE;
         pDev->bacObj.Object_Instance_Number = Object_Instance;
         if (sObject_Name != NULL) {
@@ -114,6 +468,7 @@ uint16_t Add_Routed_Device(
             Routed_Device_Set_Description("No Descr", strlen("No Descr"));
         }
         pDev->Database_Revision = 0; /* Reset/Initialize now */
+        Routed_Device_Context_Set(current);
         return i;
     } else {
         return UINT16_MAX;
@@ -121,20 +476,25 @@ uint16_t Add_Routed_Device(
 }
 
 /** Return the Device Object descriptive data for the indicated entry.
+ * The lookup does not change the Device that is currently managed.
+ * Change the address or the instance of a Device with
+ * Routed_Device_Address_Set() or Routed_Device_Set_Object_Instance_Number(),
+ * so that the Device can still be found by them.
  * @param idx [in] Index into Devices[] array being requested.
  *                 0 is for the main, gateway Device entry.
  *                 -1 is a special case meaning "whichever iCurrent_Device_Idx
  *                 is currently set to"
- *                 If valid idx, will set iCurrent_Device_Idx with the idx
  * @return Pointer to the requested Device Object data, or NULL if the idx
  *         is for an invalid row entry (eg, after the last good Device).
  */
 DEVICE_OBJECT_DATA *Get_Routed_Device_Object(int idx)
 {
+    if (Num_Managed_Devices == 0) {
+        return NULL;
+    }
     if (idx == -1) {
         return &Devices[iCurrent_Device_Idx];
-    } else if ((idx >= 0) && (idx < MAX_NUM_DEVICES)) {
-        iCurrent_Device_Idx = idx;
+    } else if ((idx >= 0) && (idx < Num_Managed_Devices)) {
         return &Devices[idx];
     } else {
         return NULL;
@@ -142,26 +502,48 @@ DEVICE_OBJECT_DATA *Get_Routed_Device_Object(int idx)
 }
 
 /** Return the BACnet address for the indicated entry.
+ * The lookup does not change the Device that is currently managed.
+ * Change the address with Routed_Device_Address_Set().
  * @param idx [in] Index into Devices[] array being requested.
  *                 0 is for the main, gateway Device entry.
  *                 -1 is a special case meaning "whichever iCurrent_Device_Idx
  *                 is currently set to"
- *                 If valid idx, will set iCurrent_Device_Idx with the idx
  * @return Pointer to the requested Device Object BACnet address, or NULL if the
  * idx is for an invalid row entry (eg, after the last good Device).
  */
 BACNET_ADDRESS *Get_Routed_Device_Address(int idx)
 {
+    if (Num_Managed_Devices == 0) {
+        return NULL;
+    }
     if (idx == -1) {
         return &Devices[iCurrent_Device_Idx].bacDevAddr;
-    } else if ((idx >= 0) && (idx < MAX_NUM_DEVICES)) {
-        iCurrent_Device_Idx = idx;
+    } else if ((idx >= 0) && (idx < Num_Managed_Devices)) {
         return &Devices[idx].bacDevAddr;
     } else {
         return NULL;
     }
 }
 
+/** Set the BACnet address of the indicated entry. A routed Device is
+ * found by the MAC address of its BACnet address.
+ * @param idx [in] Index into Devices[]; 0 is the main gateway Device.
+ * @param address [in] BACnet address of the Device
+ * @return true if the address was set
+ */
+bool Routed_Device_Address_Set(int idx, const BACNET_ADDRESS *address)
+{
+    if ((idx < 0) || (idx >= Num_Managed_Devices) || !address) {
+        return false;
+    }
+    if (!bacnet_address_same(&Devices[idx].bacDevAddr, address)) {
+        bacnet_address_copy(&Devices[idx].bacDevAddr, address);
+        Hash_Stale = true;
+    }
+
+    return true;
+}
+
 /** Get the currently active BACnet address.
  * This is an implementation of the datalink_get_my_address() template for
  * devices with routing.
@@ -171,7 +553,7 @@ BACNET_ADDRESS *Get_Routed_Device_Address(int idx)
  */
 void routed_get_my_address(BACNET_ADDRESS *my_address)
 {
-    if (my_address) {
+    if (my_address && Devices) {
         memcpy(
             my_address, &Devices[iCurrent_Device_Idx].bacDevAddr,
             sizeof(BACNET_ADDRESS));
@@ -201,12 +583,11 @@ bool Routed_Device_Address_Lookup(int idx, uint8_t dlen, const uint8_t *dadr)
     DEVICE_OBJECT_DATA *pDev;
     int i;
 
-    if ((idx >= 0) && (idx < MAX_NUM_DEVICES)) {
+    if ((idx >= 0) && (idx < Num_Managed_Devices)) {
         pDev = &Devices[idx];
         if (dlen == 0) {
             /* Automatic match */
-            iCurrent_Device_Idx = idx;
-            result = true;
+            result = Routed_Device_Context_Set(idx);
         } else if (dadr != NULL) {
             for (i = 0; i < dlen; i++) {
                 if (pDev->bacDevAddr.adr[i] != dadr[i]) {
@@ -214,8 +595,7 @@ bool Routed_Device_Address_Lookup(int idx, uint8_t dlen, const uint8_t *dadr)
                 }
             }
             if (i == dlen) { /* Success! */
-                iCurrent_Device_Idx = idx;
-                result = true;
+                result = Routed_Device_Context_Set(idx);
             }
         }
     }
@@ -258,7 +638,7 @@ bool Routed_Device_GetNext(
     /* First, see if the index is out of range.
      * Eg, last call to GetNext may have been the last successful one.
      */
-    if ((idx < 0) || (idx >= MAX_NUM_DEVICES)) {
+    if ((idx < 0) || (idx >= Num_Managed_Devices)) {
         idx = -1;
 
         /* Next, see if it's a BACnet broadcast.
@@ -279,27 +659,30 @@ bool Routed_Device_GetNext(
         /* Next step: no more matches: */
         idx = -1;
     }
-    /* Or if is our virtual DNET, check
-     * against each of our virtually routed Devices.
+    /* Or if is our virtual DNET, find the virtually routed Device
+     * by its MAC address in the hash table.
      * If we get a match, have it handle the APDU.
-     * For broadcasts, all Devices get a chance at it.
+     * For broadcasts, all routed Devices get a chance at it.
      */
     else if (dest->net == dnet) {
-        if (idx == 0) { /* Step over this case (starting point) */
-            idx = 1;
-        }
-        while (idx < MAX_NUM_DEVICES) {
-            bSuccess =
-                Routed_Device_Address_Lookup(idx++, dest->len, dest->adr);
-            if (bSuccess) {
-                break; /* We don't need to keep looking */
+        if (dest->len == 0) {
+            if (idx == 0) { /* Step over this case (starting point) */
+                idx = 1;
+            }
+            if (idx < Num_Managed_Devices) {
+                bSuccess = Routed_Device_Context_Set(idx++);
             }
+        } else {
+            bSuccess = Routed_Device_Context_Set(
+                Routed_Device_MAC_Index(dest->len, dest->adr));
+            /* Next step: no more matches: */
+            idx = -1;
         }
     }
 
     if (!bSuccess) {
         *cursor = -1;
-    } else if (idx == MAX_NUM_DEVICES) { /* No more to GetNext */
+    } else if (idx >= Num_Managed_Devices) { /* No more to GetNext */
         *cursor = -1;
     } else {
         *cursor = idx;
@@ -349,30 +732,8 @@ uint32_t Routed_Device_Index_To_Instance(unsigned index)
 }
 
 /**
- * For a given object instance-number, determines a 1..N-1 index
- * of Device objects where N is MAX_NUM_DEVICES
- *
- * @param  object_instance - object-instance number of the object
- * @return  index for the given instance-number, or 0 if not valid.
- */
-static uint32_t Routed_Device_Instance_To_Index(uint32_t Instance_Number)
-{
-    int i;
-
-    for (i = 0; i < MAX_NUM_DEVICES; i++) {
-        if (Devices[i].bacObj.Object_Instance_Number == Instance_Number) {
-            /* Found Instance, so return the Device Index Number */
-            return i;
-        }
-    }
-
-    /* We did not find instance... so simply return an Index of 0
-       All gateways will have at least a single root Device Object */
-    return 0;
-}
-
-/**
- * Determines if a given Device instance is valid
+ * Determines if a given Device instance is the currently managed Device.
+ * The lookup does not change the Device that is currently managed.
  *
  * @param  object_id - object-instance number of the object
  * @return  true if the instance is valid, and false if not
@@ -380,11 +741,10 @@ static uint32_t Routed_Device_Instance_To_Index(uint32_t Instance_Number)
 bool Routed_Device_Valid_Object_Instance_Number(uint32_t object_id)
 {
     bool valid = false;
-    DEVICE_OBJECT_DATA *pDev = NULL;
 
-    iCurrent_Device_Idx = Routed_Device_Instance_To_Index(object_id);
-    pDev = &Devices[iCurrent_Device_Idx];
-    if (pDev->bacObj.Object_Instance_Number == object_id) {
+    if ((iCurrent_Device_Idx < Num_Managed_Devices) &&
+        (Devices[iCurrent_Device_Idx].bacObj.Object_Instance_Number ==
+         object_id)) {
         valid = true;
     }
 
@@ -523,7 +883,12 @@ bool Routed_Device_Set_Object_Instance_Number(uint32_t object_id)
 
     if (object_id <= BACNET_MAX_INSTANCE) {
         /* Make the change and update the database revision */
-        Devices[iCurrent_Device_Idx].bacObj.Object_Instance_Number = object_id;
+        if (Devices[iCurrent_Device_Idx].bacObj.Object_Instance_Number !=
+            object_id) {
+            Devices[iCurrent_Device_Idx].bacObj.Object_Instance_Number =
+                object_id;
+            Hash_Stale = true;
+        }
         Routed_Device_Inc_Database_Revision();
     } else {
         status = false;
@@ -18,6 +18,7 @@
 #include "bacnet/datetime.h"
 #include "bacnet/basic/object/lc.h"
 #include "bacnet/basic/object/ao.h"
+#include "bacnet/basic/object/device.h"
 #include "bacnet/wp.h"
 #include "bacnet/basic/services.h"
 #include "bacnet/basic/sys/debug.h"
@@ -703,7 +704,14 @@ void Load_Control_Timer(uint32_t object_instance, uint16_t milliseconds)
                     bactext_shed_state_name(pObject->Present_Value));
                 pObject->Previous_Value = pObject->Present_Value;
             }
+            if ((pObject->Present_Value == BACNET_SHED_INACTIVE) &&
+                (!pObject->Start_Time_Property_Written)) {
+                /* nothing to do until the Start_Time is written */
+                Device_Timer_Unregister(OBJECT_LOAD_CONTROL, object_instance);
+            }
         }
+    } else {
+        Device_Timer_Unregister(OBJECT_LOAD_CONTROL, object_instance);
     }
 }
 
@@ -974,8 +982,8 @@ int Load_Control_Read_Property(BACNET_READ_PROPERTY_DATA *rpdata)
         case PROP_OBJECT_NAME:
         case PROP_DESCRIPTION:
             Load_Control_Object_Name(rpdata->object_instance, &char_string);
-            apdu_len =
-                encode_application_character_string(&apdu[0], &char_string);
+            apdu_len = read_property_character_string_encode(
+                rpdata, &apdu[0], &char_string);
             break;
         case PROP_OBJECT_TYPE:
             apdu_len =
@@ -1210,6 +1218,8 @@ static bool Load_Control_Start_Time_Write(
     datetime_copy_date(&pObject->Start_Time.date, &value->date);
     datetime_copy_time(&pObject->Start_Time.time, &value->time);
     pObject->Start_Time_Property_Written = true;
+    /* the state machine runs until the shed request is finished */
+    (void)Device_Timer_Register(OBJECT_LOAD_CONTROL, object_instance);
     status = true;
 
     return status;
@@ -1764,6 +1774,7 @@ bool Load_Control_Delete(uint32_t object_instance)
 
     pObject = Keylist_Data_Delete(Object_List, object_instance);
     if (pObject) {
+        Device_Timer_Unregister(OBJECT_LOAD_CONTROL, object_instance);
         free(pObject);
         status = true;
     }
@@ -20,6 +20,7 @@
 #include "bacnet/wp.h"
 #include "bacnet/lighting.h"
 #include "bacnet/basic/services.h"
+#include "bacnet/basic/object/device.h"
 #include "bacnet/basic/sys/keylist.h"
 #include "bacnet/basic/sys/linear.h"
 #include "bacnet/basic/sys/debug.h"
@@ -429,6 +430,17 @@ bool Lighting_Output_Present_Value_Set(
     return status;
 }
 
+/**
+ * @brief Register the object with the Device timer while a lighting
+ *  operation is in progress
+ * @param pObject [in] object data
+ */
+static void Lighting_Command_Timer_Start(const struct object_data *pObject)
+{
+    (void)Device_Timer_Register(
+        OBJECT_LIGHTING_OUTPUT, pObject->Lighting_Command.Key);
+}
+
 /**
  * @brief Set the lighting command if the priority is active
  * @param object [in] BACnet object instance
@@ -455,6 +467,7 @@ Lighting_Command_Warn(struct object_data *pObject, unsigned priority)
         lighting_command_blink_warn(
             &pObject->Lighting_Command, BACNET_LIGHTS_WARN,
             &pObject->Lighting_Command.Blink);
+        Lighting_Command_Timer_Start(pObject);
     }
 }
 
@@ -487,6 +500,7 @@ Lighting_Command_Warn_Off(struct object_data *pObject, unsigned priority)
         lighting_command_blink_warn(
             &pObject->Lighting_Command, BACNET_LIGHTS_WARN_OFF,
             &pObject->Lighting_Command.Blink);
+        Lighting_Command_Timer_Start(pObject);
     } else {
         Present_Value_Set(pObject, 0.0, priority);
     }
@@ -525,6 +539,7 @@ Lighting_Command_Warn_Relinquish(struct object_data *pObject, unsigned priority)
         lighting_command_blink_warn(
             &pObject->Lighting_Command, BACNET_LIGHTS_WARN_RELINQUISH,
             &pObject->Lighting_Command.Blink);
+        Lighting_Command_Timer_Start(pObject);
     } else {
         Present_Value_Relinquish(pObject, priority);
     }
@@ -553,6 +568,7 @@ static void Lighting_Command_Fade_To(
     if (priority <= current_priority) {
         /* we have priority - configure the Lighting Command */
         lighting_command_fade_to(&pObject->Lighting_Command, value, fade_time);
+        Lighting_Command_Timer_Start(pObject);
     }
 }
 
@@ -579,6 +595,7 @@ static void Lighting_Command_Ramp_To(
     if (priority <= current_priority) {
         /* we have priority - configure the Lighting Command */
         lighting_command_ramp_to(&pObject->Lighting_Command, value, ramp_rate);
+        Lighting_Command_Timer_Start(pObject);
     }
 }
 
@@ -605,6 +622,7 @@ static void Lighting_Command_Step(
         /* we have priority - configure the Lighting Command */
         lighting_command_step(
             &pObject->Lighting_Command, operation, step_increment);
+        Lighting_Command_Timer_Start(pObject);
     }
 }
 
@@ -927,6 +945,7 @@ Lighting_Command_Stop(struct object_data *pObject, unsigned priority)
     if (priority <= current_priority) {
         /* we have priority - configure the Lighting Command */
         lighting_command_stop(&pObject->Lighting_Command);
+        Lighting_Command_Timer_Start(pObject);
     }
 }
 
@@ -2026,8 +2045,8 @@ int Lighting_Output_Read_Property(BACNET_READ_PROPERTY_DATA *rpdata)
             break;
         case PROP_OBJECT_NAME:
             Lighting_Output_Object_Name(rpdata->object_instance, &char_string);
-            apdu_len =
-                encode_application_character_string(&apdu[0], &char_string);
+            apdu_len = read_property_character_string_encode(
+                rpdata, &apdu[0], &char_string);
             break;
         case PROP_OBJECT_TYPE:
             apdu_len =
@@ -2153,8 +2172,8 @@ int Lighting_Output_Read_Property(BACNET_READ_PROPERTY_DATA *rpdata)
             characterstring_init_ansi(
                 &char_string,
                 Lighting_Output_Description(rpdata->object_instance));
-            apdu_len =
-                encode_application_character_string(&apdu[0], &char_string);
+            apdu_len = read_property_character_string_encode(
+                rpdata, &apdu[0], &char_string);
             break;
         default:
             rpdata->error_class = ERROR_CLASS_PROPERTY;
@@ -2334,6 +2353,16 @@ void Lighting_Output_Timer(uint32_t object_instance, uint16_t milliseconds)
     pObject = Keylist_Data(Object_List, object_instance);
     if (pObject) {
         lighting_command_timer(&pObject->Lighting_Command, milliseconds);
+        if (((pObject->Lighting_Command.Lighting_Operation ==
+              BACNET_LIGHTS_NONE) ||
+             (pObject->Lighting_Command.Lighting_Operation ==
+              BACNET_LIGHTS_STOP)) &&
+            (pObject->Lighting_Command.In_Progress == BACNET_LIGHTING_IDLE)) {
+            /* the operation is complete */
+            Device_Timer_Unregister(OBJECT_LIGHTING_OUTPUT, object_instance);
+        }
+    } else {
+        Device_Timer_Unregister(OBJECT_LIGHTING_OUTPUT, object_instance);
     }
 }
 
@@ -2446,6 +2475,7 @@ bool Lighting_Output_Delete(uint32_t object_instance)
 
     pObject = Keylist_Data_Delete(Object_List, object_instance);
     if (pObject) {
+        Device_Timer_Unregister(OBJECT_LIGHTING_OUTPUT, object_instance);
         free(pObject);
         status = true;
     }
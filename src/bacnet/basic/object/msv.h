@@ -15,6 +15,7 @@
 /* BACnet Stack API */
 #include "bacnet/bacerror.h"
 #include "bacnet/rp.h"
+#include "bacnet/rpm.h"
 #include "bacnet/wp.h"
 
 /**
@@ -45,6 +46,9 @@ unsigned Multistate_Value_Instance_To_Index(uint32_t instance);
 
 BACNET_STACK_EXPORT
 int Multistate_Value_Read_Property(BACNET_READ_PROPERTY_DATA *rpdata);
+BACNET_STACK_EXPORT
+int Multistate_Value_Read_Property_Multiple(
+    BACNET_WRITER *writer, BACNET_READ_PROPERTY_DATA *rpdata);
 
 BACNET_STACK_EXPORT
 bool Multistate_Value_Write_Property(BACNET_WRITE_PROPERTY_DATA *wp_data);
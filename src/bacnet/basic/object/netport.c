@@ -3331,8 +3331,8 @@ int Network_Port_Read_Property(BACNET_READ_PROPERTY_DATA *rpdata)
             break;
         case PROP_OBJECT_NAME:
             Network_Port_Object_Name(rpdata->object_instance, &char_string);
-            apdu_len =
-                encode_application_character_string(&apdu[0], &char_string);
+            apdu_len = read_property_character_string_encode(
+                rpdata, &apdu[0], &char_string);
             break;
         case PROP_OBJECT_TYPE:
             apdu_len =
@@ -3385,12 +3385,13 @@ int Network_Port_Read_Property(BACNET_READ_PROPERTY_DATA *rpdata)
             characterstring_init_ansi(
                 &char_string,
                 Network_Port_Description(rpdata->object_instance));
-            apdu_len =
-                encode_application_character_string(&apdu[0], &char_string);
+            apdu_len = read_property_character_string_encode(
+                rpdata, &apdu[0], &char_string);
             break;
         case PROP_MAC_ADDRESS:
             Network_Port_MAC_Address(rpdata->object_instance, &octet_string);
-            apdu_len = encode_application_octet_string(&apdu[0], &octet_string);
+            apdu_len = read_property_octet_string_encode(
+                rpdata, &apdu[0], &octet_string);
             break;
         case PROP_LINK_SPEED:
             apdu_len = encode_application_real(
@@ -3421,7 +3422,8 @@ int Network_Port_Read_Property(BACNET_READ_PROPERTY_DATA *rpdata)
             break;
         case PROP_IP_ADDRESS:
             Network_Port_IP_Address(rpdata->object_instance, &octet_string);
-            apdu_len = encode_application_octet_string(&apdu[0], &octet_string);
+            apdu_len = read_property_octet_string_encode(
+                rpdata, &apdu[0], &octet_string);
             break;
         case PROP_BACNET_IP_UDP_PORT:
             apdu_len = encode_application_unsigned(
@@ -3429,11 +3431,13 @@ int Network_Port_Read_Property(BACNET_READ_PROPERTY_DATA *rpdata)
             break;
         case PROP_IP_SUBNET_MASK:
             Network_Port_IP_Subnet(rpdata->object_instance, &octet_string);
-            apdu_len = encode_application_octet_string(&apdu[0], &octet_string);
+            apdu_len = read_property_octet_string_encode(
+                rpdata, &apdu[0], &octet_string);
             break;
         case PROP_IP_DEFAULT_GATEWAY:
             Network_Port_IP_Gateway(rpdata->object_instance, &octet_string);
-            apdu_len = encode_application_octet_string(&apdu[0], &octet_string);
+            apdu_len = read_property_octet_string_encode(
+                rpdata, &apdu[0], &octet_string);
             break;
 #if defined(BACDL_BIP) && (BACNET_NETWORK_PORT_IP_DHCP_ENABLED)
         case PROP_IP_DHCP_ENABLE:
@@ -3572,7 +3576,8 @@ int Network_Port_Read_Property(BACNET_READ_PROPERTY_DATA *rpdata)
             break;
         case PROP_IPV6_ADDRESS:
             Network_Port_IPv6_Address(rpdata->object_instance, &octet_string);
-            apdu_len = encode_application_octet_string(&apdu[0], &octet_string);
+            apdu_len = read_property_octet_string_encode(
+                rpdata, &apdu[0], &octet_string);
             break;
         case PROP_IPV6_PREFIX_LENGTH:
             apdu_len = encode_application_unsigned(
@@ -3585,12 +3590,14 @@ int Network_Port_Read_Property(BACNET_READ_PROPERTY_DATA *rpdata)
             break;
         case PROP_IPV6_DEFAULT_GATEWAY:
             Network_Port_IPv6_Gateway(rpdata->object_instance, &octet_string);
-            apdu_len = encode_application_octet_string(&apdu[0], &octet_string);
+            apdu_len = read_property_octet_string_encode(
+                rpdata, &apdu[0], &octet_string);
             break;
         case PROP_BACNET_IPV6_MULTICAST_ADDRESS:
             Network_Port_IPv6_Multicast_Address(
                 rpdata->object_instance, &octet_string);
-            apdu_len = encode_application_octet_string(&apdu[0], &octet_string);
+            apdu_len = read_property_octet_string_encode(
+                rpdata, &apdu[0], &octet_string);
             break;
         case PROP_IPV6_DNS_SERVER:
             apdu_len = bacnet_array_encode(
@@ -3621,12 +3628,13 @@ int Network_Port_Read_Property(BACNET_READ_PROPERTY_DATA *rpdata)
         case PROP_IPV6_DHCP_SERVER:
             Network_Port_IPv6_DHCP_Server(
                 rpdata->object_instance, &octet_string);
-            apdu_len = encode_application_octet_string(&apdu[0], &octet_string);
+            apdu_len = read_property_octet_string_encode(
+                rpdata, &apdu[0], &octet_string);
             break;
         case PROP_IPV6_ZONE_INDEX:
             Network_Port_IPv6_Zone_Index(rpdata->object_instance, &char_string);
-            apdu_len =
-                encode_application_character_string(&apdu[0], &char_string);
+            apdu_len = read_property_character_string_encode(
+                rpdata, &apdu[0], &char_string);
             break;
 #ifdef BACDL_BSC
         case PROP_MAX_BVLC_LENGTH_ACCEPTED:
@@ -3642,14 +3650,14 @@ int Network_Port_Read_Property(BACNET_READ_PROPERTY_DATA *rpdata)
         case PROP_SC_PRIMARY_HUB_URI:
             Network_Port_SC_Primary_Hub_URI(
                 rpdata->object_instance, &char_string);
-            apdu_len =
-                encode_application_character_string(&apdu[0], &char_string);
+            apdu_len = read_property_character_string_encode(
+                rpdata, &apdu[0], &char_string);
             break;
         case PROP_SC_FAILOVER_HUB_URI:
             Network_Port_SC_Failover_Hub_URI(
                 rpdata->object_instance, &char_string);
-            apdu_len =
-                encode_application_character_string(&apdu[0], &char_string);
+            apdu_len = read_property_character_string_encode(
+                rpdata, &apdu[0], &char_string);
             break;
         case PROP_SC_MINIMUM_RECONNECT_TIME:
             apdu_len = encode_application_unsigned(
@@ -3750,8 +3758,8 @@ int Network_Port_Read_Property(BACNET_READ_PROPERTY_DATA *rpdata)
         case PROP_SC_HUB_FUNCTION_BINDING:
             Network_Port_SC_Hub_Function_Binding(
                 rpdata->object_instance, &char_string);
-            apdu_len =
-                encode_application_character_string(&apdu[0], &char_string);
+            apdu_len = read_property_character_string_encode(
+                rpdata, &apdu[0], &char_string);
             break;
         case PROP_SC_HUB_FUNCTION_CONNECTION_STATUS:
             apdu_len = Network_Port_SC_Hub_Function_Connection_Status_Encode(
@@ -3787,8 +3795,8 @@ int Network_Port_Read_Property(BACNET_READ_PROPERTY_DATA *rpdata)
         case PROP_SC_DIRECT_CONNECT_BINDING:
             Network_Port_SC_Direct_Connect_Binding(
                 rpdata->object_instance, &char_string);
-            apdu_len =
-                encode_application_character_string(&apdu[0], &char_string);
+            apdu_len = read_property_character_string_encode(
+                rpdata, &apdu[0], &char_string);
             break;
         case PROP_SC_DIRECT_CONNECT_CONNECTION_STATUS:
             apdu_len = Network_Port_SC_Direct_Connect_Connection_Status_Encode(
@@ -0,0 +1,733 @@
+/**
+ * @file
+ * @brief A persistent store of the objects created, deleted, and written
+ *  in this device.
+ * @details Each successful CreateObject, DeleteObject, and WriteProperty
+ * is appended as a record to a journal file.  The latest record of each
+ * object, property, array index, and priority is also kept in memory, and
+ * is written as a compacted snapshot file when the journal grows past
+ * OBJECT_STORE_JOURNAL_SIZE_MAX, after which the journal is emptied.
+ *
+ * At startup, the snapshot and the journal are read sequentially and
+ * compacted, and the objects are restored in one pass that creates and
+ * deletes the objects, followed by one pass that writes their properties,
+ * so the restore time depends on the size of the store rather than on
+ * replaying the history of each object.
+ *
+ * Each record is encoded as: tag (1 octet), object-type (2 octets),
+ * object-instance (4 octets), property-identifier (4 octets),
+ * array-index (4 octets), priority (1 octet), and the length (2 octets)
+ * of the encoded property value that follows, and a CRC-16 (2 octets)
+ * of the record.  A record that was not completely written, such as
+ * during a power failure, or that fails its CRC, ends the file.
+ *
+ * A new snapshot is flushed to the storage device before it replaces the
+ * previous snapshot, and the journal is emptied only after that.
+ * @author Steve Karg <skarg@users.sourceforge.net>
+ * @date 2024
+ * @copyright SPDX-License-Identifier: MIT
+ */
+#include <stdbool.h>
+#include <stdint.h>
+#include <stddef.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#if defined(_WIN32)
+#include <io.h>
+#elif defined(__unix__) || defined(__APPLE__)
+#include <unistd.h>
+#endif
+/* BACnet Stack defines - first */
+#include "bacnet/bacdef.h"
+/* BACnet Stack API */
+#include "bacnet/bacint.h"
+#include "bacnet/basic/sys/key.h"
+#include "bacnet/basic/sys/keylist.h"
+/* me! */
+#include "bacnet/basic/object/objstore.h"
+
+/* record tags */
+#define OBJECT_STORE_RECORD_CREATE 1
+#define OBJECT_STORE_RECORD_DELETE 2
+#define OBJECT_STORE_RECORD_WRITE 3
+#define OBJECT_STORE_RECORD_HEADER_SIZE 18
+#define OBJECT_STORE_RECORD_CRC_SIZE 2
+#define OBJECT_STORE_RECORD_SIZE_MAX \
+    (OBJECT_STORE_RECORD_HEADER_SIZE + MAX_APDU + OBJECT_STORE_RECORD_CRC_SIZE)
+
+/* object state */
+#define OBJECT_STORE_WRITTEN 0
+#define OBJECT_STORE_CREATED 1
+#define OBJECT_STORE_DELETED 2
+
+/* latest value written to a property of an object */
+struct object_store_property {
+    struct object_store_property *next;
+    BACNET_PROPERTY_ID object_property;
+    BACNET_ARRAY_INDEX array_index;
+    uint8_t priority;
+    uint16_t application_data_len;
+    uint8_t *application_data;
+};
+
+struct object_store_object {
+    uint8_t state;
+    /* properties in the order they were last written */
+    struct object_store_property *properties;
+};
+
+/* a record of the snapshot or journal file */
+struct object_store_record {
+    uint8_t tag;
+    BACNET_OBJECT_TYPE object_type;
+    uint32_t object_instance;
+    BACNET_PROPERTY_ID object_property;
+    BACNET_ARRAY_INDEX array_index;
+    uint8_t priority;
+    uint16_t application_data_len;
+    const uint8_t *application_data;
+};
+
+/* Key List of the stored objects sorted by object type and instance */
+static OS_Keylist Object_Store_List;
+static char *Snapshot_Pathname;
+static char *Snapshot_Temp_Pathname;
+static char *Journal_Pathname;
+static FILE *Journal_File;
+static long Journal_Size;
+/* the store ignores the changes made while it is being restored */
+static bool Object_Store_Restoring;
+
+/**
+ * @brief Free the properties of a stored object
+ * @param pObject - stored object
+ */
+static void Object_Store_Properties_Free(struct object_store_object *pObject)
+{
+    struct object_store_property *property;
+
+    while (pObject->properties) {
+        property = pObject->properties;
+        pObject->properties = property->next;
+        free(property);
+    }
+}
+
+/**
+ * @brief Apply a record to the stored objects in memory
+ * @param record - record to apply
+ * @return true if the record was applied
+ */
+static bool Object_Store_Record_Apply(const struct object_store_record *record)
+{
+    struct object_store_object *pObject;
+    struct object_store_property *property;
+    struct object_store_property **link;
+    KEY key;
+
+    key = KEY_ENCODE(record->object_type, record->object_instance);
+    pObject = Keylist_Data(Object_Store_List, key);
+    if (!pObject) {
+        pObject = calloc(1, sizeof(struct object_store_object));
+        if (!pObject) {
+            return false;
+        }
+        pObject->state = OBJECT_STORE_WRITTEN;
+        if (Keylist_Data_Add(Object_Store_List, key, pObject) < 0) {
+            free(pObject);
+            return false;
+        }
+    }
+    switch (record->tag) {
+        case OBJECT_STORE_RECORD_CREATE:
+            Object_Store_Properties_Free(pObject);
+            pObject->state = OBJECT_STORE_CREATED;
+            break;
+        case OBJECT_STORE_RECORD_DELETE:
+            Object_Store_Properties_Free(pObject);
+            pObject->state = OBJECT_STORE_DELETED;
+            break;
+        case OBJECT_STORE_RECORD_WRITE:
+            /* remove the previous value, and add the latest to the end */
+            link = &pObject->properties;
+            while (*link) {
+                property = *link;
+                if ((property->object_property == record->object_property) &&
+                    (property->array_index == record->array_index) &&
+                    (property->priority == record->priority)) {
+                    *link = property->next;
+                    free(property);
+                } else {
+                    link = &property->next;
+                }
+            }
+            property = malloc(
+                sizeof(struct object_store_property) +
+                record->application_data_len);
+            if (!property) {
+                return false;
+            }
+            property->next = NULL;
+            property->object_property = record->object_property;
+            property->array_index = record->array_index;
+            property->priority = record->priority;
+            property->application_data_len = record->application_data_len;
+            property->application_data = (uint8_t *)(property + 1);
+            memcpy(
+                property->application_data, record->application_data,
+                record->application_data_len);
+            *link = property;
+            break;
+        default:
+            return false;
+    }
+
+    return true;
+}
+
+/**
+ * @brief Calculate the CRC-16 of a record, using the same polynomial
+ *  as the BACnet MS/TP data CRC
+ * @param buffer - encoded record
+ * @param len - number of octets in the encoded record
+ * @return the CRC of the record
+ */
+static uint16_t Object_Store_Record_CRC(const uint8_t *buffer, size_t len)
+{
+    uint16_t crc = 0xFFFF;
+    uint16_t crc_low;
+    size_t i;
+
+    for (i = 0; i < len; i++) {
+        crc_low = (crc & 0xff) ^ buffer[i];
+        crc = (crc >> 8) ^ (crc_low << 8) ^ (crc_low << 3) ^
+            (crc_low << 12) ^ (crc_low >> 4) ^ (crc_low & 0x0f) ^
+            ((crc_low & 0x0f) << 7);
+    }
+
+    return (uint16_t)~crc;
+}
+
+/**
+ * @brief Encode a record
+ * @param buffer - buffer of OBJECT_STORE_RECORD_SIZE_MAX octets
+ * @param record - record to encode
+ * @return number of octets encoded
+ */
+static int Object_Store_Record_Encode(
+    uint8_t *buffer, const struct object_store_record *record)
+{
+    int len = 0;
+
+    buffer[len++] = record->tag;
+    len += encode_unsigned16(&buffer[len], (uint16_t)record->object_type);
+    len += encode_unsigned32(&buffer[len], record->object_instance);
+    len += encode_unsigned32(&buffer[len], (uint32_t)record->object_property);
+    len += encode_unsigned32(&buffer[len], record->array_index);
+    buffer[len++] = record->priority;
+    len += encode_unsigned16(&buffer[len], record->application_data_len);
+    if (record->application_data_len > 0) {
+        memcpy(
+            &buffer[len], record->application_data,
+            record->application_data_len);
+        len += record->application_data_len;
+    }
+    len += encode_unsigned16(
+        &buffer[len], Object_Store_Record_CRC(buffer, (size_t)len));
+
+    return len;
+}
+
+/**
+ * @brief Decode a record
+ * @param buffer - buffer of octets to decode
+ * @param size - number of octets in the buffer
+ * @param record - record that is decoded, which refers to the buffer
+ * @return number of octets decoded, or zero if the record is incomplete,
+ *  not valid, or fails its CRC
+ */
+static size_t Object_Store_Record_Decode(
+    const uint8_t *buffer, size_t size, struct object_store_record *record)
+{
+    uint16_t object_type = 0;
+    uint32_t object_property = 0;
+    uint16_t crc = 0;
+    size_t len = 0;
+
+    if (size <
+        (OBJECT_STORE_RECORD_HEADER_SIZE + OBJECT_STORE_RECORD_CRC_SIZE)) {
+        return 0;
+    }
+    record->tag = buffer[len++];
+    len += decode_unsigned16(&buffer[len], &object_type);
+    record->object_type = (BACNET_OBJECT_TYPE)object_type;
+    len += decode_unsigned32(&buffer[len], &record->object_instance);
+    len += decode_unsigned32(&buffer[len], &object_property);
+    record->object_property = (BACNET_PROPERTY_ID)object_property;
+    len += decode_unsigned32(&buffer[len], &record->array_index);
+    record->priority = buffer[len++];
+    len += decode_unsigned16(&buffer[len], &record->application_data_len);
+    if ((record->tag < OBJECT_STORE_RECORD_CREATE) ||
+        (record->tag > OBJECT_STORE_RECORD_WRITE) ||
+        (record->application_data_len > MAX_APDU) ||
+        (record->application_data_len >
+         (size - len - OBJECT_STORE_RECORD_CRC_SIZE))) {
+        return 0;
+    }
+    record->application_data = &buffer[len];
+    len += record->application_data_len;
+    (void)decode_unsigned16(&buffer[len], &crc);
+    if (crc != Object_Store_Record_CRC(buffer, len)) {
+        return 0;
+    }
+    len += OBJECT_STORE_RECORD_CRC_SIZE;
+
+    return len;
+}
+
+/**
+ * @brief Read a snapshot or journal file into the stored objects
+ * @param pathname - name of the file
+ * @return number of records read from the file
+ */
+static unsigned Object_Store_File_Load(const char *pathname)
+{
+    struct object_store_record record = { 0 };
+    FILE *pFile;
+    uint8_t *buffer = NULL;
+    long size = 0;
+    size_t offset = 0, len = 0;
+    unsigned count = 0;
+
+    pFile = fopen(pathname, "rb");
+    if (!pFile) {
+        return 0;
+    }
+    if (fseek(pFile, 0L, SEEK_END) == 0) {
+        size = ftell(pFile);
+    }
+    if ((size > 0) && (fseek(pFile, 0L, SEEK_SET) == 0)) {
+        buffer = malloc((size_t)size);
+    }
+    if (buffer) {
+        size = (long)fread(buffer, 1, (size_t)size, pFile);
+        while (offset < (size_t)size) {
+            len = Object_Store_Record_Decode(
+                &buffer[offset], (size_t)size - offset, &record);
+            if (len == 0) {
+                break;
+            }
+            if (Object_Store_Record_Apply(&record)) {
+                count++;
+            }
+            offset += len;
+        }
+        free(buffer);
+    }
+    fclose(pFile);
+
+    return count;
+}
+
+/**
+ * @brief Append a record to a file
+ * @param pFile - file to append
+ * @param record - record to append
+ * @return number of octets written, or zero on error
+ */
+static long
+Object_Store_File_Append(FILE *pFile, const struct object_store_record *record)
+{
+    uint8_t buffer[OBJECT_STORE_RECORD_SIZE_MAX];
+    size_t len;
+
+    len = (size_t)Object_Store_Record_Encode(buffer, record);
+    if (fwrite(buffer, 1, len, pFile) != len) {
+        return 0;
+    }
+
+    return (long)len;
+}
+
+/**
+ * @brief Flush a file to the storage device
+ * @param pFile - file to flush
+ * @return true if the file was flushed
+ */
+static bool Object_Store_File_Sync(FILE *pFile)
+{
+    if (fflush(pFile) != 0) {
+        return false;
+    }
+#if defined(_WIN32)
+    if (_commit(_fileno(pFile)) != 0) {
+        return false;
+    }
+#elif defined(__unix__) || defined(__APPLE__)
+    if (fsync(fileno(pFile)) != 0) {
+        return false;
+    }
+#endif
+
+    return true;
+}
+
+/**
+ * @brief Add a record to the stored objects and to the journal, and
+ *  write a new snapshot when the journal is full
+ * @param record - record to add
+ * @return true if the record was added
+ */
+static bool Object_Store_Record_Add(const struct object_store_record *record)
+{
+    long len;
+
+    if (Object_Store_Restoring || !Object_Store_List) {
+        return false;
+    }
+    if (!Object_Store_Record_Apply(record)) {
+        return false;
+    }
+    if (!Journal_File) {
+        return false;
+    }
+    len = Object_Store_File_Append(Journal_File, record);
+    if (len == 0) {
+        return false;
+    }
+    fflush(Journal_File);
+    Journal_Size += len;
+    if (Journal_Size > OBJECT_STORE_JOURNAL_SIZE_MAX) {
+        (void)Object_Store_Compact();
+    }
+
+    return true;
+}
+
+/**
+ * @brief Write the stored objects to a new snapshot file, and empty
+ *  the journal file
+ * @return true if the snapshot was written
+ */
+bool Object_Store_Compact(void)
+{
+    struct object_store_record record = { 0 };
+    struct object_store_object *pObject;
+    struct object_store_property *property;
+    FILE *pFile;
+    KEY key;
+    int count, index;
+    bool status = true;
+
+    if (!Snapshot_Pathname || !Object_Store_List) {
+        return false;
+    }
+    pFile = fopen(Snapshot_Temp_Pathname, "wb");
+    if (!pFile) {
+        return false;
+    }
+    count = Keylist_Count(Object_Store_List);
+    for (index = 0; (index < count) && status; index++) {
+        pObject = Keylist_Data_Index(Object_Store_List, index);
+        if (!pObject || !Keylist_Index_Key(Object_Store_List, index, &key)) {
+            continue;
+        }
+        record.object_type = (BACNET_OBJECT_TYPE)KEY_DECODE_TYPE(key);
+        record.object_instance = (uint32_t)KEY_DECODE_ID(key);
+        record.object_property = PROP_ALL;
+        record.array_index = BACNET_ARRAY_ALL;
+        record.priority = BACNET_NO_PRIORITY;
+        record.application_data_len = 0;
+        record.application_data = NULL;
+        if (pObject->state == OBJECT_STORE_CREATED) {
+            record.tag = OBJECT_STORE_RECORD_CREATE;
+            status = Object_Store_File_Append(pFile, &record) > 0;
+        } else if (pObject->state == OBJECT_STORE_DELETED) {
+            record.tag = OBJECT_STORE_RECORD_DELETE;
+            status = Object_Store_File_Append(pFile, &record) > 0;
+        }
+        record.tag = OBJECT_STORE_RECORD_WRITE;
+        property = pObject->properties;
+        while (property && status) {
+            record.object_property = property->object_property;
+            record.array_index = property->array_index;
+            record.priority = property->priority;
+            record.application_data_len = property->application_data_len;
+            record.application_data = property->application_data;
+            status = Object_Store_File_Append(pFile, &record) > 0;
+            property = property->next;
+        }
+    }
+    /* the new snapshot must be on the storage device before it replaces
+       the previous snapshot and the journal is emptied */
+    if (status && !Object_Store_File_Sync(pFile)) {
+        status = false;
+    }
+    if (fclose(pFile) != 0) {
+        status = false;
+    }
+    if (!status) {
+        (void)remove(Snapshot_Temp_Pathname);
+        return false;
+    }
+#if defined(_WIN32)
+    /* rename does not replace an existing file */
+    (void)remove(Snapshot_Pathname);
+#endif
+    if (rename(Snapshot_Temp_Pathname, Snapshot_Pathname) != 0) {
+        return false;
+    }
+    /* the snapshot holds every record, so start an empty journal */
+    if (Journal_File) {
+        fclose(Journal_File);
+    }
+    Journal_File = fopen(Journal_Pathname, "wb");
+    Journal_Size = 0;
+
+    return true;
+}
+
+/**
+ * @brief Copy a pathname with a suffix
+ * @param pathname - pathname to copy
+ * @param suffix - suffix to append
+ * @return the allocated pathname, or NULL if out of memory
+ */
+static char *Object_Store_Pathname(const char *pathname, const char *suffix)
+{
+    char *name;
+
+    name = malloc(strlen(pathname) + strlen(suffix) + 1);
+    if (name) {
+        strcpy(name, pathname);
+        strcat(name, suffix);
+    }
+
+    return name;
+}
+
+/**
+ * @brief Open the store, and read the snapshot and journal files into
+ *  memory. The journal is compacted into a new snapshot, so that the
+ *  next startup reads only the snapshot.
+ * @param pathname - name of the snapshot file. The journal file has the
+ *  same name with ".journal" appended.
+ * @return true if the store is ready to record changes
+ */
+bool Object_Store_Init(const char *pathname)
+{
+    Object_Store_Cleanup();
+    if (!pathname) {
+        return false;
+    }
+    Object_Store_List = Keylist_Create();
+    Snapshot_Pathname = Object_Store_Pathname(pathname, "");
+    Snapshot_Temp_Pathname = Object_Store_Pathname(pathname, ".tmp");
+    Journal_Pathname = Object_Store_Pathname(pathname, ".journal");
+    if (!Object_Store_List || !Snapshot_Pathname || !Snapshot_Temp_Pathname ||
+        !Journal_Pathname) {
+        Object_Store_Cleanup();
+        return false;
+    }
+    (void)Object_Store_File_Load(Snapshot_Pathname);
+    (void)Object_Store_File_Load(Journal_Pathname);
+    if (!Object_Store_Compact()) {
+        /* keep the existing files, and append to the journal */
+        Journal_File = fopen(Journal_Pathname, "ab");
+        if (Journal_File && (fseek(Journal_File, 0L, SEEK_END) == 0)) {
+            Journal_Size = ftell(Journal_File);
+        }
+    }
+
+    return Journal_File != NULL;
+}
+
+/**
+ * @brief Restore the stored objects into the device. The objects are
+ *  created or deleted first, and then their properties are written in
+ *  the order they were last written.
+ * @param create_object - function to create an object, or NULL
+ * @param delete_object - function to delete an object, or NULL
+ * @param write_property - function to write a property, or NULL
+ * @return number of objects and properties that were restored
+ */
+unsigned Object_Store_Restore(
+    object_store_create_function create_object,
+    object_store_delete_function delete_object,
+    write_property_function write_property)
+{
+    static BACNET_WRITE_PROPERTY_DATA wp_data;
+    BACNET_CREATE_OBJECT_DATA create_data = { 0 };
+    BACNET_DELETE_OBJECT_DATA delete_data = { 0 };
+    struct object_store_object *pObject;
+    struct object_store_property *property;
+    unsigned restored = 0;
+    KEY key;
+    int count, index;
+
+    Object_Store_Restoring = true;
+    count = Keylist_Count(Object_Store_List);
+    for (index = 0; index < count; index++) {
+        pObject = Keylist_Data_Index(Object_Store_List, index);
+        if (!pObject || !Keylist_Index_Key(Object_Store_List, index, &key)) {
+            continue;
+        }
+        if ((pObject->state == OBJECT_STORE_CREATED) && create_object) {
+            create_data.object_type = (BACNET_OBJECT_TYPE)KEY_DECODE_TYPE(key);
+            create_data.object_instance = (uint32_t)KEY_DECODE_ID(key);
+            create_data.list_of_initial_values = NULL;
+            if (create_object(&create_data)) {
+                restored++;
+            }
+        } else if ((pObject->state == OBJECT_STORE_DELETED) && delete_object) {
+            delete_data.object_type = (BACNET_OBJECT_TYPE)KEY_DECODE_TYPE(key);
+            delete_data.object_instance = (uint32_t)KEY_DECODE_ID(key);
+            if (delete_object(&delete_data)) {
+                restored++;
+            }
+        }
+    }
+    for (index = 0; (index < count) && write_property; index++) {
+        pObject = Keylist_Data_Index(Object_Store_List, index);
+        if (!pObject || !Keylist_Index_Key(Object_Store_List, index, &key)) {
+            continue;
+        }
+        property = pObject->properties;
+        while (property) {
+            wp_data.object_type = (BACNET_OBJECT_TYPE)KEY_DECODE_TYPE(key);
+            wp_data.object_instance = (uint32_t)KEY_DECODE_ID(key);
+            wp_data.object_property = property->object_property;
+            wp_data.array_index = property->array_index;
+            wp_data.priority = property->priority;
+            memcpy(
+                wp_data.application_data, property->application_data,
+                property->application_data_len);
+            wp_data.application_data_len = property->application_data_len;
+            wp_data.error_class = ERROR_CLASS_PROPERTY;
+            wp_data.error_code = ERROR_CODE_SUCCESS;
+            if (write_property(&wp_data)) {
+                restored++;
+            }
+            property = property->next;
+        }
+    }
+    Object_Store_Restoring = false;
+
+    return restored;
+}
+
+/**
+ * @brief Record a successful WriteProperty in the store. This function
+ *  is the callback for Device_Write_Property_Store_Callback_Set().
+ * @param wp_data - WriteProperty data that was written
+ * @return true if the write was recorded
+ */
+bool Object_Store_Write_Property(BACNET_WRITE_PROPERTY_DATA *wp_data)
+{
+    struct object_store_record record = { 0 };
+
+    if (!wp_data || (wp_data->application_data_len < 0) ||
+        (wp_data->application_data_len > MAX_APDU)) {
+        return false;
+    }
+    record.tag = OBJECT_STORE_RECORD_WRITE;
+    record.object_type = wp_data->object_type;
+    record.object_instance = wp_data->object_instance;
+    record.object_property = wp_data->object_property;
+    record.array_index = wp_data->array_index;
+    record.priority = wp_data->priority;
+    record.application_data_len = (uint16_t)wp_data->application_data_len;
+    record.application_data = wp_data->application_data;
+
+    return Object_Store_Record_Add(&record);
+}
+
+/**
+ * @brief Record a created object in the store. The properties previously
+ *  stored for the object are discarded.
+ * @param object_type - type of the object that was created
+ * @param object_instance - instance number of the object that was created
+ */
+void Object_Store_Create_Object(
+    BACNET_OBJECT_TYPE object_type, uint32_t object_instance)
+{
+    struct object_store_record record = { 0 };
+
+    record.tag = OBJECT_STORE_RECORD_CREATE;
+    record.object_type = object_type;
+    record.object_instance = object_instance;
+    record.object_property = PROP_ALL;
+    record.array_index = BACNET_ARRAY_ALL;
+    record.priority = BACNET_NO_PRIORITY;
+    (void)Object_Store_Record_Add(&record);
+}
+
+/**
+ * @brief Record a deleted object in the store. The properties previously
+ *  stored for the object are discarded.
+ * @param object_type - type of the object that was deleted
+ * @param object_instance - instance number of the object that was deleted
+ */
+void Object_Store_Delete_Object(
+    BACNET_OBJECT_TYPE object_type, uint32_t object_instance)
+{
+    struct object_store_record record = { 0 };
+
+    record.tag = OBJECT_STORE_RECORD_DELETE;
+    record.object_type = object_type;
+    record.object_instance = object_instance;
+    record.object_property = PROP_ALL;
+    record.array_index = BACNET_ARRAY_ALL;
+    record.priority = BACNET_NO_PRIORITY;
+    (void)Object_Store_Record_Add(&record);
+}
+
+/**
+ * @brief Get the number of objects in the store
+ * @return number of objects that were created, deleted, or written
+ */
+unsigned Object_Store_Count(void)
+{
+    return (unsigned)Keylist_Count(Object_Store_List);
+}
+
+/**
+ * @brief Get the size of the journal file
+ * @return number of octets in the journal since the last snapshot
+ */
+long Object_Store_Journal_Size(void)
+{
+    return Journal_Size;
+}
+
+/**
+ * @brief Close the store files, and free the stored objects in memory
+ */
+void Object_Store_Cleanup(void)
+{
+    struct object_store_object *pObject;
+
+    if (Journal_File) {
+        fclose(Journal_File);
+        Journal_File = NULL;
+    }
+    Journal_Size = 0;
+    if (Object_Store_List) {
+        do {
+            pObject = Keylist_Data_Pop(Object_Store_List);
+            if (pObject) {
+                Object_Store_Properties_Free(pObject);
+                free(pObject);
+            }
+        } while (pObject);
+        Keylist_Delete(Object_Store_List);
+        Object_Store_List = NULL;
+    }
+    free(Snapshot_Pathname);
+    Snapshot_Pathname = NULL;
+    free(Snapshot_Temp_Pathname);
+    Snapshot_Temp_Pathname = NULL;
+    free(Journal_Pathname);
+    Journal_Pathname = NULL;
+}
@@ -0,0 +1,72 @@
+/**
+ * @file
+ * @brief API for a persistent store of the objects created, deleted,
+ *  and written in this device, kept as a compacted snapshot file
+ *  and an append-only journal file.
+ * @author Steve Karg <skarg@users.sourceforge.net>
+ * @date 2024
+ * @copyright SPDX-License-Identifier: MIT
+ */
+#ifndef BACNET_BASIC_OBJECT_OBJSTORE_H
+#define BACNET_BASIC_OBJECT_OBJSTORE_H
+#include <stdbool.h>
+#include <stdint.h>
+#include <stddef.h>
+/* BACnet Stack defines - first */
+#include "bacnet/bacdef.h"
+/* BACnet Stack API */
+#include "bacnet/create_object.h"
+#include "bacnet/delete_object.h"
+#include "bacnet/wp.h"
+
+/* size of the journal file that causes a new snapshot to be written */
+#ifndef OBJECT_STORE_JOURNAL_SIZE_MAX
+#define OBJECT_STORE_JOURNAL_SIZE_MAX (1024L * 1024L)
+#endif
+
+/**
+ * @brief Create an object when the store is restored
+ * @param data - CreateObject data, such as for Device_Create_Object()
+ * @return true if the object is created
+ */
+typedef bool (*object_store_create_function)(BACNET_CREATE_OBJECT_DATA *data);
+
+/**
+ * @brief Delete an object when the store is restored
+ * @param data - DeleteObject data, such as for Device_Delete_Object()
+ * @return true if the object is deleted
+ */
+typedef bool (*object_store_delete_function)(BACNET_DELETE_OBJECT_DATA *data);
+
+#ifdef __cplusplus
+extern "C" {
+#endif /* __cplusplus */
+
+BACNET_STACK_EXPORT
+bool Object_Store_Init(const char *pathname);
+BACNET_STACK_EXPORT
+unsigned Object_Store_Restore(
+    object_store_create_function create_object,
+    object_store_delete_function delete_object,
+    write_property_function write_property);
+BACNET_STACK_EXPORT
+bool Object_Store_Write_Property(BACNET_WRITE_PROPERTY_DATA *wp_data);
+BACNET_STACK_EXPORT
+void Object_Store_Create_Object(
+    BACNET_OBJECT_TYPE object_type, uint32_t object_instance);
+BACNET_STACK_EXPORT
+void Object_Store_Delete_Object(
+    BACNET_OBJECT_TYPE object_type, uint32_t object_instance);
+BACNET_STACK_EXPORT
+bool Object_Store_Compact(void);
+BACNET_STACK_EXPORT
+unsigned Object_Store_Count(void);
+BACNET_STACK_EXPORT
+long Object_Store_Journal_Size(void);
+BACNET_STACK_EXPORT
+void Object_Store_Cleanup(void);
+
+#ifdef __cplusplus
+}
+#endif /* __cplusplus */
+#endif
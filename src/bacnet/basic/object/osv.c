@@ -197,8 +197,8 @@ int OctetString_Value_Read_Property(BACNET_READ_PROPERTY_DATA *rpdata)
         case PROP_DESCRIPTION:
             OctetString_Value_Object_Name(
                 rpdata->object_instance, &char_string);
-            apdu_len =
-                encode_application_character_string(&apdu[0], &char_string);
+            apdu_len = read_property_character_string_encode(
+                rpdata, &apdu[0], &char_string);
             break;
 
         case PROP_OBJECT_TYPE:
@@ -209,7 +209,8 @@ int OctetString_Value_Read_Property(BACNET_READ_PROPERTY_DATA *rpdata)
         case PROP_PRESENT_VALUE:
             real_value =
                 OctetString_Value_Present_Value(rpdata->object_instance);
-            apdu_len = encode_application_octet_string(&apdu[0], real_value);
+            apdu_len = read_property_octet_string_encode(
+                rpdata, &apdu[0], real_value);
             break;
 
         case PROP_STATUS_FLAGS:
@@ -15,6 +15,7 @@
 #include "bacnet/proplist.h"
 #include "bacnet/timestamp.h"
 #include "bacnet/basic/services.h"
+#include "bacnet/basic/object/calendar.h"
 #include "bacnet/basic/object/device.h"
 #include "bacnet/basic/object/schedule.h"
 
@@ -23,6 +24,18 @@
 #endif
 
 static SCHEDULE_DESCR Schedule_Descr[MAX_SCHEDULES];
+static write_property_function Write_Property_Internal_Callback;
+/* date and time of the last Schedule_Task() pass, and the earliest
+   transition */
+static BACNET_DATE Task_Date;
+static BACNET_TIME Task_Time;
+static BACNET_TIME Task_Next_Time;
+static bool Task_Next_Valid;
+static bool Task_Evaluated;
+/* Calendar Date_List changes seen by the last evaluation */
+static uint32_t Task_Calendar_Changes;
+/* evaluate every schedule with the next Schedule_Task() pass */
+static bool Task_Refresh;
 
 static const int Schedule_Properties_Required[] = {
     PROP_OBJECT_IDENTIFIER,
@@ -66,7 +79,7 @@ void Schedule_Property_Lists(
  * @param  object_instance - object-instance number of the object
  * @return object found in the list, or NULL if not found
  */
-static SCHEDULE_DESCR *Schedule_Object(uint32_t object_instance)
+SCHEDULE_DESCR *Schedule_Object(uint32_t object_instance)
 {
     unsigned int object_index;
     SCHEDULE_DESCR *pObject = NULL;
@@ -106,12 +119,14 @@ void Schedule_Init(void)
         for (j = 0; j < 7; j++) {
             psched->Weekly_Schedule[j].TV_Count = 0;
         }
-        memcpy(
-            &psched->Present_Value, &psched->Schedule_Default,
-            sizeof(psched->Present_Value));
         psched->Schedule_Default.context_specific = false;
         psched->Schedule_Default.tag = BACNET_APPLICATION_TAG_REAL;
         psched->Schedule_Default.type.Real = 21.0f; /* 21 C, room temperature */
+        memcpy(
+            &psched->Present_Value, &psched->Schedule_Default,
+            sizeof(psched->Present_Value));
+        psched->Evaluated = false;
+        psched->Next_Transition_Valid = false;
         psched->obj_prop_ref_cnt = 0; /* no references, add as needed */
         psched->Priority_For_Writing = 16; /* lowest priority */
         psched->Out_Of_Service = false;
@@ -131,6 +146,7 @@ void Schedule_Init(void)
         }
 #endif
     }
+    Task_Evaluated = false;
 }
 
 /**
@@ -219,6 +235,11 @@ void Schedule_Out_Of_Service_Set(uint32_t object_instance, bool value)
 
     index = Schedule_Instance_To_Index(object_instance);
     if (index < MAX_SCHEDULES) {
+        if (Schedule_Descr[index].Out_Of_Service && !value) {
+            /* resume from the current date and time */
+            Schedule_Descr[index].Evaluated = false;
+            Task_Evaluated = false;
+        }
         Schedule_Descr[index].Out_Of_Service = value;
     }
 }
@@ -328,8 +349,8 @@ int Schedule_Read_Property(BACNET_READ_PROPERTY_DATA *rpdata)
             break;
         case PROP_OBJECT_NAME:
             Schedule_Object_Name(rpdata->object_instance, &char_string);
-            apdu_len =
-                encode_application_character_string(&apdu[0], &char_string);
+            apdu_len = read_property_character_string_encode(
+                rpdata, &apdu[0], &char_string);
             break;
         case PROP_OBJECT_TYPE:
             apdu_len = encode_application_enumerated(&apdu[0], OBJECT_SCHEDULE);
@@ -496,7 +517,370 @@ bool Schedule_In_Effective_Period(
 }
 
 /**
- * @brief Recalculate the Present Value of the Schedule object
+ * @brief Find the time value in effect at a given time of the day, and
+ *  the earliest time value that takes effect later in the day.
+ * @param tv - list of time values, in any order
+ * @param tv_count - number of time values in the list
+ * @param time - time of the day
+ * @param next_time - [in,out] earliest later transition found so far
+ * @param next_valid - [in,out] true if next_time holds a transition
+ * @return the time value in effect, or NULL if none has started yet
+ */
+static const BACNET_TIME_VALUE *Schedule_Time_Value_Active(
+    const BACNET_TIME_VALUE *tv,
+    unsigned tv_count,
+    const BACNET_TIME *time,
+    BACNET_TIME *next_time,
+    bool *next_valid)
+{
+    const BACNET_TIME_VALUE *active = NULL;
+    unsigned i;
+
+    for (i = 0; i < tv_count; i++) {
+        if (datetime_wildcard_compare_time(&tv[i].Time, time) <= 0) {
+            if (!active ||
+                (datetime_wildcard_compare_time(&active->Time, &tv[i].Time) <
+                 0)) {
+                active = &tv[i];
+            }
+        } else if (
+            !(*next_valid) ||
+            (datetime_wildcard_compare_time(&tv[i].Time, next_time) < 0)) {
+            datetime_copy_time(next_time, &tv[i].Time);
+            *next_valid = true;
+        }
+    }
+
+    return active;
+}
+
+#if BACNET_EXCEPTION_SCHEDULE_SIZE
+/**
+ * @brief Determine if a special event applies to the given date
+ * @param event - special event of the exception schedule
+ * @param date - date to check
+ * @return true if the special event period includes the date
+ */
+static bool Schedule_Special_Event_Active(
+    const BACNET_SPECIAL_EVENT *event, const BACNET_DATE *date)
+{
+    uint32_t instance;
+
+    if (event->timeValues.TV_Count == 0) {
+        return false;
+    }
+    if (event->periodTag == BACNET_SPECIAL_EVENT_PERIOD_CALENDAR_ENTRY) {
+        return bacapp_date_in_calendar_entry(
+            date, &event->period.calendarEntry);
+    }
+    if (event->period.calendarReference.type != OBJECT_CALENDAR) {
+        return false;
+    }
+    instance = event->period.calendarReference.instance;
+
+    return Calendar_Date_Effective(instance, date);
+}
+#endif
+
+/**
+ * @brief Compute the value of the schedule at a given date and time,
+ *  and the time of the next transition within the same day.
+ *
+ *  The Exception_Schedule takes precedence over the Weekly_Schedule:
+ *  the non-NULL value of the active special event with the highest
+ *  priority (lowest number, then lowest array index) is used. A NULL
+ *  value relinquishes to the next special event or Weekly_Schedule.
+ *  Outside of the Effective_Period, or when no value is in effect,
+ *  the Schedule_Default is used.
+ *
+ * @param desc - schedule descriptor
+ * @param date - date to evaluate
+ * @param time - time of the day to evaluate
+ * @param value - [out] value in effect, NULL for Schedule_Default
+ * @param next_time - [out] time of the next transition today
+ * @return true if another transition occurs later today
+ */
+static bool Schedule_Value_At(
+    const SCHEDULE_DESCR *desc,
+    const BACNET_DATE *date,
+    const BACNET_TIME *time,
+    const BACNET_TIME_VALUE **value,
+    BACNET_TIME *next_time)
+{
+    const BACNET_TIME_VALUE *tv;
+    bool next_valid = false;
+#if BACNET_EXCEPTION_SCHEDULE_SIZE
+    const BACNET_SPECIAL_EVENT *event;
+    uint8_t priority = 0;
+    unsigned e;
+#endif
+
+    *value = NULL;
+    if (!Schedule_In_Effective_Period(desc, date)) {
+        return false;
+    }
+#if BACNET_EXCEPTION_SCHEDULE_SIZE
+    for (e = 0; e < BACNET_EXCEPTION_SCHEDULE_SIZE; e++) {
+        event = &desc->Exception_Schedule[e];
+        if (!Schedule_Special_Event_Active(event, date)) {
+            continue;
+        }
+        tv = Schedule_Time_Value_Active(
+            event->timeValues.Time_Values, event->timeValues.TV_Count, time,
+            next_time, &next_valid);
+        if (tv && (tv->Value.tag != BACNET_APPLICATION_TAG_NULL) &&
+            (!(*value) || (event->priority < priority))) {
+            *value = tv;
+            priority = event->priority;
+        }
+    }
+#endif
+    if ((date->wday >= BACNET_WEEKDAY_MONDAY) &&
+        (date->wday <= BACNET_WEEKDAY_SUNDAY)) {
+        tv = Schedule_Time_Value_Active(
+            desc->Weekly_Schedule[date->wday - 1].Time_Values,
+            desc->Weekly_Schedule[date->wday - 1].TV_Count, time, next_time,
+            &next_valid);
+        if (!(*value) && tv &&
+            (tv->Value.tag != BACNET_APPLICATION_TAG_NULL)) {
+            *value = tv;
+        }
+    }
+
+    return next_valid;
+}
+
+/**
+ * @brief Determine the time of the next transition of the schedule
+ *  within the given date, i.e. the time at which the Present_Value
+ *  may change without any change to the schedule configuration.
+ * @param desc - schedule descriptor
+ * @param date - date to evaluate
+ * @param time - time of the day to evaluate
+ * @param next_time - [out] time of the next transition today
+ * @return true if another transition occurs later today, false if the
+ *  Present_Value holds until the end of the day
+ */
+bool Schedule_Next_Transition(
+    const SCHEDULE_DESCR *desc,
+    const BACNET_DATE *date,
+    const BACNET_TIME *time,
+    BACNET_TIME *next_time)
+{
+    const BACNET_TIME_VALUE *value;
+    BACNET_TIME next = { 0 };
+    bool status = false;
+
+    if (desc && date && time) {
+        status = Schedule_Value_At(desc, date, time, &value, &next);
+        if (status && next_time) {
+            datetime_copy_time(next_time, &next);
+        }
+    }
+
+    return status;
+}
+
+/**
+ * @brief Evaluate the Present_Value of the Schedule object from its
+ *  Effective_Period, Exception_Schedule, Weekly_Schedule and
+ *  Schedule_Default, and cache the time of the next transition.
+ * @param desc - schedule descriptor
+ * @param date - current date
+ * @param time - current time of the day
+ * @return true if the Present_Value changed
+ */
+bool Schedule_Evaluate(
+    SCHEDULE_DESCR *desc, const BACNET_DATE *date, const BACNET_TIME *time)
+{
+    const BACNET_TIME_VALUE *tv = NULL;
+    BACNET_APPLICATION_DATA_VALUE value = { 0 };
+    bool changed = false;
+
+    if (!desc || !date || !time) {
+        return false;
+    }
+    desc->Next_Transition_Valid =
+        Schedule_Value_At(desc, date, time, &tv, &desc->Next_Transition);
+    if (tv) {
+        bacnet_primitive_to_application_data_value(&value, &tv->Value);
+    } else {
+        memcpy(&value, &desc->Schedule_Default, sizeof(value));
+    }
+    if (!bacapp_same_value(&value, &desc->Present_Value)) {
+        memcpy(&desc->Present_Value, &value, sizeof(desc->Present_Value));
+        changed = true;
+    }
+    datetime_copy_date(&desc->Evaluated_Date, date);
+    desc->Evaluated = true;
+
+    return changed;
+}
+
+/**
+ * @brief Determine if the schedule needs to be evaluated again
+ * @param desc - schedule descriptor
+ * @param date - current date
+ * @param time - current time of the day
+ * @return true if the date changed or the next transition is due
+ */
+static bool Schedule_Evaluation_Due(
+    const SCHEDULE_DESCR *desc,
+    const BACNET_DATE *date,
+    const BACNET_TIME *time)
+{
+    if (!desc->Evaluated) {
+        return true;
+    }
+    if (datetime_compare_date(&desc->Evaluated_Date, date) != 0) {
+        return true;
+    }
+    if (desc->Next_Transition_Valid &&
+        (datetime_wildcard_compare_time(&desc->Next_Transition, time) <= 0)) {
+        return true;
+    }
+
+    return false;
+}
+
+/**
+ * @brief Write the Present_Value to each member of the
+ *  List_Of_Object_Property_References at the Priority_For_Writing.
+ *  Only objects within this device are written.
+ * @param desc - schedule descriptor
+ */
+static void Schedule_Write_References(const SCHEDULE_DESCR *desc)
+{
+    BACNET_WRITE_PROPERTY_DATA wp_data = { 0 };
+    const BACNET_DEVICE_OBJECT_PROPERTY_REFERENCE *member;
+    int apdu_len;
+    unsigned i;
+
+    if (!Write_Property_Internal_Callback) {
+        return;
+    }
+    apdu_len = bacapp_encode_application_data(
+        wp_data.application_data, &desc->Present_Value);
+    if (apdu_len <= 0) {
+        return;
+    }
+    for (i = 0; i < desc->obj_prop_ref_cnt; i++) {
+        member = &desc->Object_Property_References[i];
+        if ((member->deviceIdentifier.type == OBJECT_DEVICE) &&
+            (member->deviceIdentifier.instance != BACNET_MAX_INSTANCE) &&
+            (member->deviceIdentifier.instance !=
+             Device_Object_Instance_Number())) {
+            /* our implementation is for internal objects only */
+            continue;
+        }
+        wp_data.object_type = member->objectIdentifier.type;
+        wp_data.object_instance = member->objectIdentifier.instance;
+        wp_data.object_property = member->propertyIdentifier;
+        wp_data.array_index = member->arrayIndex;
+        wp_data.priority = desc->Priority_For_Writing;
+        wp_data.application_data_len = apdu_len;
+        wp_data.error_class = ERROR_CLASS_PROPERTY;
+        wp_data.error_code = ERROR_CODE_SUCCESS;
+        (void)Write_Property_Internal_Callback(&wp_data);
+    }
+}
+
+/**
+ * @brief Run the schedules. Each schedule is evaluated only when the
+ *  date changes or its next transition is due, so between transitions
+ *  this is a single comparison regardless of the number of schedules.
+ *  Every schedule is evaluated when the Date_List of a Calendar changed,
+ *  when the clock moved backwards, or after Schedule_Task_Refresh().
+ *  The List_Of_Object_Property_References is written only when the
+ *  Present_Value changes, or on the first evaluation.
+ * @param bdatetime - current local date and time
+ */
+void Schedule_Task(const BACNET_DATE_TIME *bdatetime)
+{
+    SCHEDULE_DESCR *desc;
+    bool first, changed, same_date;
+    bool next_valid = false;
+    BACNET_TIME next_time = { 0 };
+    uint32_t calendar_changes;
+    unsigned i;
+
+    if (!bdatetime) {
+        return;
+    }
+    same_date = datetime_compare_date(&Task_Date, &bdatetime->date) == 0;
+    calendar_changes = Calendar_Date_List_Changes();
+    if (calendar_changes != Task_Calendar_Changes) {
+        Task_Refresh = true;
+    }
+    if (Task_Evaluated && same_date &&
+        (datetime_wildcard_compare_time(&bdatetime->time, &Task_Time) < 0)) {
+        /* the clock moved backwards within the same day */
+        Task_Refresh = true;
+    }
+    datetime_copy_time(&Task_Time, &bdatetime->time);
+    if (Task_Evaluated && !Task_Refresh && same_date &&
+        (!Task_Next_Valid ||
+         (datetime_wildcard_compare_time(&bdatetime->time, &Task_Next_Time) <
+          0))) {
+        return;
+    }
+    for (i = 0; i < MAX_SCHEDULES; i++) {
+        desc = &Schedule_Descr[i];
+        if (desc->Out_Of_Service) {
+            continue;
+        }
+        if (Task_Refresh ||
+            Schedule_Evaluation_Due(
+                desc, &bdatetime->date, &bdatetime->time)) {
+            first = !desc->Evaluated;
+            changed =
+                Schedule_Evaluate(desc, &bdatetime->date, &bdatetime->time);
+            if (changed || first) {
+                Schedule_Write_References(desc);
+            }
+        }
+        if (desc->Next_Transition_Valid &&
+            (!next_valid ||
+             (datetime_wildcard_compare_time(
+                  &desc->Next_Transition, &next_time) < 0))) {
+            datetime_copy_time(&next_time, &desc->Next_Transition);
+            next_valid = true;
+        }
+    }
+    datetime_copy_date(&Task_Date, &bdatetime->date);
+    datetime_copy_time(&Task_Next_Time, &next_time);
+    Task_Next_Valid = next_valid;
+    Task_Evaluated = true;
+    Task_Calendar_Changes = calendar_changes;
+    Task_Refresh = false;
+}
+
+/**
+ * @brief Force every schedule to be evaluated by the next Schedule_Task(),
+ *  for example after a change that the schedule cannot detect, such as
+ *  a new time zone. The references are still only written when the
+ *  Present_Value changes.
+ */
+void Schedule_Task_Refresh(void)
+{
+    Task_Refresh = true;
+}
+
+/**
+ * @brief Set the callback used to write the Present_Value to the
+ *  List_Of_Object_Property_References within this device
+ * @param cb - write property function, typically Device_Write_Property
+ */
+void Schedule_Write_Property_Internal_Callback_Set(write_property_function cb)
+{
+    Write_Property_Internal_Callback = cb;
+}
+
+/**
+ * @brief Recalculate the Present Value of the Schedule object from the
+ *  Weekly_Schedule and Schedule_Default only.
+ * @note Use Schedule_Evaluate() to include the Effective_Period and the
+ *  Exception_Schedule.
  * @param desc - schedule descriptor
  * @param wday - day of the week
  * @param time - time of the day
@@ -504,28 +888,20 @@ bool Schedule_In_Effective_Period(
 void Schedule_Recalculate_PV(
     SCHEDULE_DESCR *desc, BACNET_WEEKDAY wday, const BACNET_TIME *time)
 {
-    int i;
-    desc->Present_Value.tag = BACNET_APPLICATION_TAG_NULL;
-
-    /* for future development, here should be the loop for Exception Schedule */
-
-    /*  Note to developers: please ping Edward at info@connect-ex.com
-        for a more complete schedule object implementation. */
-    for (i = 0; i < desc->Weekly_Schedule[wday - 1].TV_Count &&
-         desc->Present_Value.tag == BACNET_APPLICATION_TAG_NULL;
-         i++) {
-        int diff = datetime_wildcard_compare_time(
-            time, &desc->Weekly_Schedule[wday - 1].Time_Values[i].Time);
-        if (diff >= 0 &&
-            desc->Weekly_Schedule[wday - 1].Time_Values[i].Value.tag !=
-                BACNET_APPLICATION_TAG_NULL) {
-            bacnet_primitive_to_application_data_value(
-                &desc->Present_Value,
-                &desc->Weekly_Schedule[wday - 1].Time_Values[i].Value);
-        }
+    const BACNET_TIME_VALUE *tv = NULL;
+    BACNET_TIME next_time = { 0 };
+    bool next_valid = false;
+
+    if ((wday >= BACNET_WEEKDAY_MONDAY) && (wday <= BACNET_WEEKDAY_SUNDAY)) {
+        tv = Schedule_Time_Value_Active(
+            desc->Weekly_Schedule[wday - 1].Time_Values,
+            desc->Weekly_Schedule[wday - 1].TV_Count, time, &next_time,
+            &next_valid);
     }
-
-    if (desc->Present_Value.tag == BACNET_APPLICATION_TAG_NULL) {
+    if (tv && (tv->Value.tag != BACNET_APPLICATION_TAG_NULL)) {
+        bacnet_primitive_to_application_data_value(
+            &desc->Present_Value, &tv->Value);
+    } else {
         memcpy(
             &desc->Present_Value, &desc->Schedule_Default,
             sizeof(desc->Present_Value));
@@ -72,6 +72,11 @@ typedef struct schedule {
     uint8_t obj_prop_ref_cnt; /* actual number of obj_prop references */
     uint8_t Priority_For_Writing; /* (1..16) */
     bool Out_Of_Service;
+    /* date of the last evaluation, and next transition within that date */
+    BACNET_DATE Evaluated_Date;
+    BACNET_TIME Next_Transition;
+    bool Next_Transition_Valid;
+    bool Evaluated;
 } SCHEDULE_DESCR;
 
 BACNET_STACK_EXPORT
@@ -88,6 +93,8 @@ BACNET_STACK_EXPORT
 unsigned Schedule_Instance_To_Index(uint32_t instance);
 BACNET_STACK_EXPORT
 void Schedule_Init(void);
+BACNET_STACK_EXPORT
+SCHEDULE_DESCR *Schedule_Object(uint32_t object_instance);
 
 BACNET_STACK_EXPORT
 void Schedule_Out_Of_Service_Set(uint32_t object_instance, bool value);
@@ -103,13 +110,27 @@ int Schedule_Read_Property(BACNET_READ_PROPERTY_DATA *rpdata);
 BACNET_STACK_EXPORT
 bool Schedule_Write_Property(BACNET_WRITE_PROPERTY_DATA *wp_data);
 
-/* utility functions for calculating current Present Value
- * if Exception Schedule is to be added, these functions must take that into
- * account */
+BACNET_STACK_EXPORT
+void Schedule_Task(const BACNET_DATE_TIME *bdatetime);
+BACNET_STACK_EXPORT
+void Schedule_Task_Refresh(void);
+BACNET_STACK_EXPORT
+void Schedule_Write_Property_Internal_Callback_Set(write_property_function cb);
+
+/* utility functions for calculating current Present Value */
 BACNET_STACK_EXPORT
 bool Schedule_In_Effective_Period(
     const SCHEDULE_DESCR *desc, const BACNET_DATE *date);
 BACNET_STACK_EXPORT
+bool Schedule_Evaluate(
+    SCHEDULE_DESCR *desc, const BACNET_DATE *date, const BACNET_TIME *time);
+BACNET_STACK_EXPORT
+bool Schedule_Next_Transition(
+    const SCHEDULE_DESCR *desc,
+    const BACNET_DATE *date,
+    const BACNET_TIME *time,
+    BACNET_TIME *next_time);
+BACNET_STACK_EXPORT
 void Schedule_Recalculate_PV(
     SCHEDULE_DESCR *desc, BACNET_WEEKDAY wday, const BACNET_TIME *time);
 
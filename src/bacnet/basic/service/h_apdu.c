@@ -394,6 +394,16 @@ void apdu_set_abort_handler(abort_function pFunction)
     Abort_Function = pFunction;
 }
 
+/**
+ * @brief Get the handler function called for an aborted service, so that
+ *  a handler that is set later can pass the aborts on to it.
+ * @return the abort handler, or NULL if none is set
+ */
+abort_function apdu_abort_handler(void)
+{
+    return Abort_Function;
+}
+
 static reject_function Reject_Function;
 
 /**
@@ -407,6 +417,16 @@ void apdu_set_reject_handler(reject_function pFunction)
     Reject_Function = pFunction;
 }
 
+/**
+ * @brief Get the handler function called for a rejected service, so that
+ *  a handler that is set later can pass the rejects on to it.
+ * @return the reject handler, or NULL if none is set
+ */
+reject_function apdu_reject_handler(void)
+{
+    return Reject_Function;
+}
+
 /**
  * @brief Decode the given confirmed service request from the received data.
  *
@@ -134,9 +134,13 @@ void apdu_set_complex_error_handler(
 
 BACNET_STACK_EXPORT
 void apdu_set_abort_handler(abort_function pFunction);
+BACNET_STACK_EXPORT
+abort_function apdu_abort_handler(void);
 
 BACNET_STACK_EXPORT
 void apdu_set_reject_handler(reject_function pFunction);
+BACNET_STACK_EXPORT
+reject_function apdu_reject_handler(void);
 
 BACNET_STACK_EXPORT
 uint16_t apdu_decode_confirmed_service_request(
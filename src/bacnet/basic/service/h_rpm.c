@@ -15,7 +15,6 @@
 /* BACnet Stack defines - first */
 #include "bacnet/bacdef.h"
 /* BACnet Stack API */
-#include "bacnet/memcopy.h"
 #include "bacnet/bacdcode.h"
 #include "bacnet/apdu.h"
 #include "bacnet/npdu.h"
@@ -33,152 +32,110 @@
 #include "bacnet/basic/sys/debug.h"
 #include "bacnet/datalink/datalink.h"
 
-static uint8_t Temp_Buf[MAX_APDU] = { 0 };
-
 /**
- * @brief Fetches the lists of properties (array of BACNET_PROPERTY_ID's) for
- * this object type and the special properties ALL or REQUIRED or OPTIONAL.
- * @param pPropertyList reference for the list of ALL, REQUIRED, and OPTIONAL
- * properties.
- * @param special_property The special property ALL, REQUIRED, or OPTIONAL
- * to fetch.
- * @param index The index of the property to fetch.
- * @return The property ID or -1 if not found.
+ * @brief Read the value of a property for the reply. The special
+ * properties ALL, REQUIRED, and OPTIONAL are only allowed as the property
+ * of an object, and get an ERROR encoding when read on their own.
+ * @param rpdata [in,out] property to read into the application data
+ * @return length of the value, or BACNET_STATUS_ERROR,
+ * BACNET_STATUS_ABORT, or BACNET_STATUS_REJECT
  */
-static BACNET_PROPERTY_ID RPM_Object_Property(
-    struct special_property_list_t *pPropertyList,
-    BACNET_PROPERTY_ID special_property,
-    unsigned index)
+static int RPM_Read_Property(BACNET_READ_PROPERTY_DATA *rpdata)
 {
-    int property = -1; /* return value */
-    unsigned required, optional, proprietary;
-
-    required = pPropertyList->Required.count;
-    optional = pPropertyList->Optional.count;
-    proprietary = pPropertyList->Proprietary.count;
-    if (special_property == PROP_ALL) {
-        if (index < required) {
-            property = pPropertyList->Required.pList[index];
-        } else if (index < (required + optional)) {
-            index -= required;
-            property = pPropertyList->Optional.pList[index];
-        } else if (index < (required + optional + proprietary)) {
-            index -= (required + optional);
-            property = pPropertyList->Proprietary.pList[index];
-        }
-    } else if (special_property == PROP_REQUIRED) {
-        if (index < required) {
-            property = pPropertyList->Required.pList[index];
-        }
-    } else if (special_property == PROP_OPTIONAL) {
-        if (index < optional) {
-            property = pPropertyList->Optional.pList[index];
-        }
+    if ((rpdata->object_property == PROP_ALL) ||
+        (rpdata->object_property == PROP_REQUIRED) ||
+        (rpdata->object_property == PROP_OPTIONAL)) {
+        return BACNET_STATUS_ERROR;
     }
 
-    return (BACNET_PROPERTY_ID)property;
+    return Device_Read_Property(rpdata);
 }
 
 /**
- * @brief Fetches the number of properties (array of BACNET_PROPERTY_ID's) for
- * this object type belonging to the special properties ALL or REQUIRED or
- * OPTIONAL.
- * @param pPropertyList reference for the list of ALL, REQUIRED, and OPTIONAL
- * properties.
- * @param special_property The special property ALL, REQUIRED, or OPTIONAL
- * to fetch.
- * @return The number of properties.
+ * @brief Encode the RPM property reference and its value or error directly
+ * into the reply. The value is read by the object straight into the reply,
+ * so it is encoded once and never copied.
+ * @param writer [in] The bounded writer for the reply APDU.
+ * @param rpmdata [in] The RPM data to encode.
+ * @return BACNET_STATUS_OK, or BACNET_STATUS_ABORT or BACNET_STATUS_REJECT
+ * if there is no room to fit the encoding.
  */
-static unsigned RPM_Object_Property_Count(
-    struct special_property_list_t *pPropertyList,
-    BACNET_PROPERTY_ID special_property)
+static int RPM_Encode_Property(BACNET_WRITER *writer, BACNET_RPM_DATA *rpmdata)
 {
-    unsigned count = 0; /* return value */
+    int len = 0;
+    BACNET_READ_PROPERTY_DATA rpdata;
 
-    if (special_property == PROP_ALL) {
-        count = pPropertyList->Required.count + pPropertyList->Optional.count +
-            pPropertyList->Proprietary.count;
-    } else if (special_property == PROP_REQUIRED) {
-        count = pPropertyList->Required.count;
-    } else if (special_property == PROP_OPTIONAL) {
-        count = pPropertyList->Optional.count;
+    rpdata.object_type = rpmdata->object_type;
+    rpdata.object_instance = rpmdata->object_instance;
+    rpdata.object_property = rpmdata->object_property;
+    rpdata.array_index = rpmdata->array_index;
+    len = rpm_ack_property_encode(writer, &rpdata, RPM_Read_Property);
+    if (len < 0) {
+        /* pass along aborts and rejects for now */
+        rpmdata->error_code = rpdata.error_code;
     }
 
-    return count;
+    return len;
 }
 
 /**
- * @brief Encode the RPM property returning the length of the encoding,
- * or 0 if there is no room to fit the encoding.
- * @param apdu [out] The buffer to encode the property into.
- * @param offset [in] The offset into the buffer to start encoding.
- * @param max_apdu [in] The maximum length of the buffer.
+ * @brief Encode the special property ALL, REQUIRED, or OPTIONAL of an
+ * object directly into the reply. The object is looked up once for all of
+ * its properties.
+ * @param writer [in] The bounded writer for the reply APDU.
  * @param rpmdata [in] The RPM data to encode.
- * @return The length of the encoding, or 0 if there is no room to fit the
- * encoding.
+ * @return BACNET_STATUS_OK, or BACNET_STATUS_ABORT or BACNET_STATUS_REJECT
+ * if there is no room to fit the encoding.
  */
-static int RPM_Encode_Property(
-    uint8_t *apdu, uint16_t offset, uint16_t max_apdu, BACNET_RPM_DATA *rpmdata)
+static int
+RPM_Encode_Special_Property(BACNET_WRITER *writer, BACNET_RPM_DATA *rpmdata)
 {
     int len = 0;
-    size_t copy_len = 0;
-    int apdu_len = 0;
     BACNET_READ_PROPERTY_DATA rpdata;
 
-    len = rpm_ack_encode_apdu_object_property(
-        &Temp_Buf[0], rpmdata->object_property, rpmdata->array_index);
-    copy_len = memcopy(&apdu[0], &Temp_Buf[0], offset, len, max_apdu);
-    if (copy_len == 0) {
-        rpmdata->error_code = ERROR_CODE_ABORT_SEGMENTATION_NOT_SUPPORTED;
-        return BACNET_STATUS_ABORT;
-    }
-    apdu_len += len;
-    rpdata.error_class = ERROR_CLASS_OBJECT;
-    rpdata.error_code = ERROR_CODE_UNKNOWN_OBJECT;
     rpdata.object_type = rpmdata->object_type;
     rpdata.object_instance = rpmdata->object_instance;
     rpdata.object_property = rpmdata->object_property;
-    rpdata.array_index = rpmdata->array_index;
-    rpdata.application_data = &Temp_Buf[0];
-    rpdata.application_data_len = sizeof(Temp_Buf);
-
-    if ((rpmdata->object_property == PROP_ALL) ||
-        (rpmdata->object_property == PROP_REQUIRED) ||
-        (rpmdata->object_property == PROP_OPTIONAL)) {
-        /* special properties only get ERROR encoding */
-        len = BACNET_STATUS_ERROR;
-    } else {
-        len = Device_Read_Property(&rpdata);
+    rpdata.array_index = BACNET_ARRAY_ALL;
+    rpdata.error_class = ERROR_CLASS_OBJECT;
+    rpdata.error_code = ERROR_CODE_UNKNOWN_OBJECT;
+    len = Device_Read_Property_Multiple(writer, &rpdata);
+    if (len < 0) {
+        rpmdata->error_code = rpdata.error_code;
     }
 
-    if (len < 0) {
-        if ((len == BACNET_STATUS_ABORT) || (len == BACNET_STATUS_REJECT)) {
-            rpmdata->error_code = rpdata.error_code;
-            /* pass along aborts and rejects for now */
-            return len; /* Ie, Abort */
-        }
-        /* error was returned - encode that for the response */
-        len = rpm_ack_encode_apdu_object_property_error(
-            &Temp_Buf[0], rpdata.error_class, rpdata.error_code);
-        copy_len =
-            memcopy(&apdu[0], &Temp_Buf[0], offset + apdu_len, len, max_apdu);
+    return len;
+}
 
-        if (copy_len == 0) {
-            rpmdata->error_code = ERROR_CODE_ABORT_SEGMENTATION_NOT_SUPPORTED;
-            return BACNET_STATUS_ABORT;
-        }
-    } else if ((offset + apdu_len + 1 + len + 1) < max_apdu) {
-        /* enough room to fit the property value and tags */
-        len = rpm_ack_encode_apdu_object_property_value(
-            &apdu[offset + apdu_len], &Temp_Buf[0], len);
-    } else {
-        /* not enough room - abort! */
-        rpmdata->error_code = ERROR_CODE_ABORT_SEGMENTATION_NOT_SUPPORTED;
-        return BACNET_STATUS_ABORT;
+/**
+ * @brief Encode the special property ALL, REQUIRED, or OPTIONAL of an
+ *  object directly into the reply, for the Device_Read_Property_Multiple()
+ *  of a device.  The object fast path is used when given, otherwise each
+ *  property of the object lists from Device_Objects_Property_List() is
+ *  read with Device_Read_Property().
+ * @param writer [in] The bounded writer for the reply APDU.
+ * @param rpdata [in,out] object and special property to encode
+ * @param read_property_multiple [in] fast path of the object, or NULL
+ * @return BACNET_STATUS_OK, or BACNET_STATUS_ABORT or BACNET_STATUS_REJECT
+ *  with the error code set in rpdata
+ */
+int handler_read_property_multiple_object_encode(
+    BACNET_WRITER *writer,
+    BACNET_READ_PROPERTY_DATA *rpdata,
+    read_property_multiple_function read_property_multiple)
+{
+    struct special_property_list_t property_list;
+
+    if (read_property_multiple) {
+        return read_property_multiple(writer, rpdata);
     }
-    apdu_len += len;
+    Device_Objects_Property_List(
+        rpdata->object_type, rpdata->object_instance, &property_list);
 
-    return apdu_len;
+    return rpm_ack_property_list_encode(
+        writer, rpdata, property_list.Required.pList,
+        property_list.Optional.pList, property_list.Proprietary.pList,
+        Device_Read_Property);
 }
 
 /** Handler for a ReadPropertyMultiple Service request.
@@ -208,13 +165,13 @@ void handler_read_property_multiple(
 {
     bool berror = false;
     int len = 0;
-    uint16_t copy_len = 0;
     uint16_t decode_len = 0;
     int pdu_len = 0;
     BACNET_NPDU_DATA npdu_data;
     int bytes_sent;
     BACNET_ADDRESS my_address;
     BACNET_RPM_DATA rpmdata;
+    BACNET_WRITER writer;
     int apdu_len = 0;
     int npdu_len = 0;
     int error = 0;
@@ -235,9 +192,13 @@ void handler_read_property_multiple(
         } else {
             /* decode apdu request & encode apdu reply
                encode complex ack, invoke id, service choice */
-            apdu_len = rpm_ack_encode_apdu_init(
-                &Handler_Transmit_Buffer[npdu_len], service_data->invoke_id);
-
+            bacnet_writer_init(
+                &writer, &Handler_Transmit_Buffer[npdu_len], MAX_APDU);
+            len = rpm_ack_encode_apdu_init(NULL, service_data->invoke_id);
+            (void)rpm_ack_encode_apdu_init(
+                bacnet_writer_reserve(&writer, (size_t)len),
+                service_data->invoke_id);
+            bacnet_writer_commit(&writer, (size_t)len);
             for (;;) {
                 /* Start by looking for an object ID */
                 len = rpm_decode_object_id(
@@ -277,11 +238,12 @@ void handler_read_property_multiple(
                 }
 #endif
                 /* Stick this object id into the reply - if it will fit */
-                len = rpm_ack_encode_apdu_object_begin(&Temp_Buf[0], &rpmdata);
-                copy_len = memcopy(
-                    &Handler_Transmit_Buffer[npdu_len], &Temp_Buf[0], apdu_len,
-                    len, MAX_APDU);
-                if (copy_len == 0) {
+                /* Tag 0: objectIdentifier */
+                bacnet_writer_context_object_id(
+                    &writer, 0, rpmdata.object_type, rpmdata.object_instance);
+                /* Tag 1: listOfResults */
+                bacnet_writer_opening_tag(&writer, 1);
+                if (bacnet_writer_overflow(&writer)) {
                     debug_print("RPM: Response too big!\n");
                     rpmdata.error_code =
                         ERROR_CODE_ABORT_SEGMENTATION_NOT_SUPPORTED;
@@ -289,7 +251,6 @@ void handler_read_property_multiple(
                     berror = true;
                     break;
                 }
-                apdu_len += copy_len;
                 /* do each property of this object of the RPM request */
                 for (;;) {
                     /* Fetch a property */
@@ -310,19 +271,10 @@ void handler_read_property_multiple(
                     if ((rpmdata.object_property == PROP_ALL) ||
                         (rpmdata.object_property == PROP_REQUIRED) ||
                         (rpmdata.object_property == PROP_OPTIONAL)) {
-                        struct special_property_list_t property_list;
-                        unsigned property_count = 0;
-                        unsigned index = 0;
-                        BACNET_PROPERTY_ID special_object_property;
-
                         if (!Device_Valid_Object_Id(
                                 rpmdata.object_type, rpmdata.object_instance)) {
-                            len = RPM_Encode_Property(
-                                &Handler_Transmit_Buffer[npdu_len],
-                                (uint16_t)apdu_len, MAX_APDU, &rpmdata);
-                            if (len > 0) {
-                                apdu_len += len;
-                            } else {
+                            len = RPM_Encode_Property(&writer, &rpmdata);
+                            if (len < 0) {
                                 debug_print("RPM: Too full for property!\n");
                                 error = len;
                                 /* The berror flag ensures that
@@ -333,17 +285,21 @@ void handler_read_property_multiple(
                         } else if (rpmdata.array_index != BACNET_ARRAY_ALL) {
                             /* No array index options for this special property.
                                Encode error for this object property response */
-                            len = rpm_ack_encode_apdu_object_property(
-                                &Temp_Buf[0], rpmdata.object_property,
-                                rpmdata.array_index);
-
-                            copy_len = memcopy(
-                                &Handler_Transmit_Buffer[npdu_len],
-                                &Temp_Buf[0], apdu_len, len, MAX_APDU);
-
-                            if (copy_len == 0) {
-                                debug_print(
-                                    "RPM: Too full to encode property!\n");
+                            /* Tag 2: propertyIdentifier */
+                            bacnet_writer_context_enumerated(
+                                &writer, 2, rpmdata.object_property);
+                            /* Tag 3: optional propertyArrayIndex */
+                            bacnet_writer_context_unsigned(
+                                &writer, 3, rpmdata.array_index);
+                            /* Tag 5: propertyAccessError */
+                            bacnet_writer_opening_tag(&writer, 5);
+                            bacnet_writer_application_enumerated(
+                                &writer, ERROR_CLASS_PROPERTY);
+                            bacnet_writer_application_enumerated(
+                                &writer, ERROR_CODE_PROPERTY_IS_NOT_AN_ARRAY);
+                            bacnet_writer_closing_tag(&writer, 5);
+                            if (bacnet_writer_overflow(&writer)) {
+                                debug_print("RPM: Too full to encode error!\n");
                                 rpmdata.error_code =
                                     ERROR_CODE_ABORT_SEGMENTATION_NOT_SUPPORTED;
                                 error = BACNET_STATUS_ABORT;
@@ -352,93 +308,28 @@ void handler_read_property_multiple(
                                 berror = true;
                                 break;
                             }
-
-                            apdu_len += len;
-                            len = rpm_ack_encode_apdu_object_property_error(
-                                &Temp_Buf[0], ERROR_CLASS_PROPERTY,
-                                ERROR_CODE_PROPERTY_IS_NOT_AN_ARRAY);
-
-                            copy_len = memcopy(
-                                &Handler_Transmit_Buffer[npdu_len],
-                                &Temp_Buf[0], apdu_len, len, MAX_APDU);
-
-                            if (copy_len == 0) {
-                                debug_print("RPM: Too full to encode error!\n");
-                                rpmdata.error_code =
-                                    ERROR_CODE_ABORT_SEGMENTATION_NOT_SUPPORTED;
-                                error = BACNET_STATUS_ABORT;
+                        } else {
+                            /* 135-2016bl-2. Clarify ReadPropertyMultiple
+                               response on OPTIONAL when empty. */
+                            /* If no optional properties are supported then
+                               an empty 'List of Results' shall be returned
+                               for the specified property, except if the
+                               object does not exist. */
+                            len =
+                                RPM_Encode_Special_Property(&writer, &rpmdata);
+                            if (len < 0) {
+                                debug_print("RPM: Too full for property!\n");
+                                error = len;
                                 /* The berror flag ensures that
                                    both loops will be broken! */
                                 berror = true;
                                 break;
                             }
-                            apdu_len += len;
-                        } else {
-                            special_object_property = rpmdata.object_property;
-                            Device_Objects_Property_List(
-                                rpmdata.object_type, rpmdata.object_instance,
-                                &property_list);
-                            property_count = RPM_Object_Property_Count(
-                                &property_list, special_object_property);
-
-                            if (property_count == 0) {
-                                /* Only happens with the OPTIONAL property */
-                                /* 135-2016bl-2. Clarify ReadPropertyMultiple
-                                   response on OPTIONAL when empty. */
-                                /* If no optional properties are supported then
-                                   an empty 'List of Results' shall be returned
-                                   for the specified property, except if the
-                                   object does not exist. */
-                                if (!Device_Valid_Object_Id(
-                                        rpmdata.object_type,
-                                        rpmdata.object_instance)) {
-                                    len = RPM_Encode_Property(
-                                        &Handler_Transmit_Buffer[npdu_len],
-                                        (uint16_t)apdu_len, MAX_APDU, &rpmdata);
-                                    if (len > 0) {
-                                        apdu_len += len;
-                                    } else {
-                                        debug_print(
-                                            "RPM: Too full for property!\n");
-                                        error = len;
-                                        /* The berror flag ensures that
-                                           both loops will be broken! */
-                                        berror = true;
-                                        break;
-                                    }
-                                }
-                            } else {
-                                for (index = 0; index < property_count;
-                                     index++) {
-                                    rpmdata.object_property =
-                                        RPM_Object_Property(
-                                            &property_list,
-                                            special_object_property, index);
-                                    len = RPM_Encode_Property(
-                                        &Handler_Transmit_Buffer[npdu_len],
-                                        (uint16_t)apdu_len, MAX_APDU, &rpmdata);
-                                    if (len > 0) {
-                                        apdu_len += len;
-                                    } else {
-                                        debug_print(
-                                            "RPM: Too full for property!\n");
-                                        error = len;
-                                        /* The berror flag ensures that
-                                           both loops will be broken! */
-                                        berror = true;
-                                        break;
-                                    }
-                                }
-                            }
                         }
                     } else {
                         /* handle an individual property */
-                        len = RPM_Encode_Property(
-                            &Handler_Transmit_Buffer[npdu_len],
-                            (uint16_t)apdu_len, MAX_APDU, &rpmdata);
-                        if (len > 0) {
-                            apdu_len += len;
-                        } else {
+                        len = RPM_Encode_Property(&writer, &rpmdata);
+                        if (len < 0) {
                             debug_print(
                                 "RPM: Too full for individual property!\n");
                             error = len;
@@ -454,11 +345,7 @@ void handler_read_property_multiple(
                         /* Reached end of property list so cap the result list
                          */
                         decode_len++;
-                        len = rpm_ack_encode_apdu_object_end(&Temp_Buf[0]);
-                        copy_len = memcopy(
-                            &Handler_Transmit_Buffer[npdu_len], &Temp_Buf[0],
-                            apdu_len, len, MAX_APDU);
-                        if (copy_len == 0) {
+                        if (bacnet_writer_closing_tag(&writer, 1) == 0) {
                             debug_print(
                                 "RPM: Too full to encode object end!\n");
                             rpmdata.error_code =
@@ -468,8 +355,6 @@ void handler_read_property_multiple(
                                both loops will be broken! */
                             berror = true;
                             break;
-                        } else {
-                            apdu_len += copy_len;
                         }
                         /* finished with this property list */
                         break;
@@ -483,6 +368,7 @@ void handler_read_property_multiple(
                     break;
                 }
             }
+            apdu_len = (int)bacnet_writer_length(&writer);
             /* If not having an error so far, check the remaining space. */
             if (!berror) {
                 if (apdu_len > service_data->max_resp) {
@@ -19,6 +19,7 @@
 #include "bacnet/bacdef.h"
 /* BACnet Stack API */
 #include "bacnet/apdu.h"
+#include "bacnet/rpm.h"
 
 #ifdef __cplusplus
 extern "C" {
@@ -31,6 +32,12 @@ void handler_read_property_multiple(
     BACNET_ADDRESS *src,
     BACNET_CONFIRMED_SERVICE_DATA *service_data);
 
+BACNET_STACK_EXPORT
+int handler_read_property_multiple_object_encode(
+    BACNET_WRITER *writer,
+    BACNET_READ_PROPERTY_DATA *rpdata,
+    read_property_multiple_function read_property_multiple);
+
 #ifdef __cplusplus
 }
 #endif /* __cplusplus */
@@ -8,19 +8,95 @@
 #include <stddef.h>
 #include <stdint.h>
 #include <stdio.h>
+#include <stdlib.h>
 #include <string.h>
 /* BACnet Stack defines - first */
 #include "bacnet/bacdef.h"
 /* BACnet Stack API */
+#include "bacnet/bacaddr.h"
 #include "bacnet/bacdcode.h"
+#include "bacnet/npdu.h"
 #include "bacnet/whois.h"
 #include "bacnet/iam.h"
 #include "bacnet/basic/object/device.h"
 #include "bacnet/basic/services.h"
+#include "bacnet/basic/sys/debug.h"
 #include "bacnet/basic/tsm/tsm.h"
+#include "bacnet/datalink/datalink.h"
 
 /** @file h_whois.c  Handles Who-Is requests. */
 
+/* number of I-Am responses that are waiting, or held off, in addition to
+   one for each device; the queue starts with this size and grows */
+#ifndef BACNET_WHO_IS_RESPONSES_EXTRA
+#define BACNET_WHO_IS_RESPONSES_EXTRA 7
+#endif
+/* number of Who-Is sources that are rate limited */
+#ifndef BACNET_WHO_IS_SOURCES_MAX
+#define BACNET_WHO_IS_SOURCES_MAX 8
+#endif
+/* number of encoded I-Am kept, one per device */
+#ifndef BACNET_WHO_IS_IAM_CACHE_MAX
+#define BACNET_WHO_IS_IAM_CACHE_MAX MAX_NUM_DEVICES
+#endif
+/* longest random delay of an I-Am response in milliseconds */
+#ifndef BACNET_WHO_IS_JITTER_MS
+#define BACNET_WHO_IS_JITTER_MS 250
+#endif
+/* milliseconds that a repeated Who-Is from a source is not answered
+   again, and the window of the rate limit of each source */
+#ifndef BACNET_WHO_IS_HOLDOFF_MS
+#define BACNET_WHO_IS_HOLDOFF_MS 1000
+#endif
+/* number of I-Am responses to one source in each holdoff window,
+   for each device */
+#ifndef BACNET_WHO_IS_SOURCE_LIMIT_PER_DEVICE
+#define BACNET_WHO_IS_SOURCE_LIMIT_PER_DEVICE 4
+#endif
+/* largest encoding of the I-Am APDU */
+#define BACNET_WHO_IS_IAM_APDU_MAX 24
+
+/* I-Am APDU encoded once for a device */
+struct who_is_iam_cache {
+    uint32_t device_id;
+    uint16_t vendor_id;
+    uint8_t apdu_len;
+    uint8_t apdu[BACNET_WHO_IS_IAM_APDU_MAX];
+};
+/* I-Am response that is waiting for its delay, or is held off so that
+   a repeated Who-Is from the same source is not answered again */
+struct who_is_response {
+    /* the I-Am is sent when the timer expires */
+    bool pending : 1;
+    uint32_t device_id;
+    /* milliseconds until sent when pending, else until the entry is free */
+    uint16_t timer;
+    BACNET_ADDRESS dest;
+    /* source of the Who-Is that scheduled the I-Am */
+    BACNET_ADDRESS src;
+    /* source address of the device, which is routed in a gateway */
+    BACNET_ADDRESS my_address;
+};
+/* Who-Is source with the count of I-Am responses in the window */
+struct who_is_source {
+    BACNET_ADDRESS src;
+    uint16_t count;
+    /* milliseconds left in the window, 0=free */
+    uint16_t timer;
+};
+static struct who_is_iam_cache IAm_Cache[BACNET_WHO_IS_IAM_CACHE_MAX];
+/* queue of the I-Am responses, grown on demand */
+static struct who_is_response *Who_Is_Response;
+static unsigned Who_Is_Response_Size;
+static struct who_is_source Who_Is_Source[BACNET_WHO_IS_SOURCES_MAX];
+static uint16_t Who_Is_Jitter_Milliseconds = BACNET_WHO_IS_JITTER_MS;
+/* number of devices that answer, such as the routed devices of a gateway */
+static uint16_t Who_Is_Device_Count = MAX_NUM_DEVICES;
+/* state of the random delay, 0=not seeded */
+static uint32_t Who_Is_Random_State;
+/* number of I-Am responses that did not fit in the queue */
+static uint32_t Who_Is_Overflow_Count;
+
 /** Handler for Who-Is requests, with broadcast I-Am response.
  * @ingroup DMDDB
  * @param service_request [in] The received message to be handled.
@@ -81,6 +157,370 @@ void handler_who_is_unicast(
     return;
 }
 
+/**
+ * @brief Get the I-Am APDU of a device, encoding it only when it is not
+ *  cached, or the vendor has changed since it was cached
+ * @param device_id [in] Device Instance 0 - 4194303
+ * @return the cached I-Am of the device
+ */
+static const struct who_is_iam_cache *who_is_iam_cache(uint32_t device_id)
+{
+    struct who_is_iam_cache *iam;
+    uint16_t vendor_id;
+
+    vendor_id = Device_Vendor_Identifier();
+    iam = &IAm_Cache[device_id % BACNET_WHO_IS_IAM_CACHE_MAX];
+    if ((iam->apdu_len == 0) || (iam->device_id != device_id) ||
+        (iam->vendor_id != vendor_id)) {
+        iam->device_id = device_id;
+        iam->vendor_id = vendor_id;
+        iam->apdu_len = (uint8_t)iam_encode_apdu(
+            iam->apdu, device_id, MAX_APDU, SEGMENTATION_NONE, vendor_id);
+    }
+
+    return iam;
+}
+
+/**
+ * @brief Count an I-Am response to the source of a Who-Is
+ * @param src [in] The BACNET_ADDRESS of the Who-Is source
+ * @return 0 if the source is within its rate limit, else the milliseconds
+ *  until its window ends and the I-Am may be sent
+ */
+static uint16_t who_is_source_delay(const BACNET_ADDRESS *src)
+{
+    struct who_is_source *source;
+    struct who_is_source *oldest = NULL;
+    uint32_t limit;
+    unsigned i;
+
+    limit = (uint32_t)Who_Is_Device_Count *
+        BACNET_WHO_IS_SOURCE_LIMIT_PER_DEVICE;
+    for (i = 0; i < BACNET_WHO_IS_SOURCES_MAX; i++) {
+        source = &Who_Is_Source[i];
+        if ((source->timer > 0) && bacnet_address_same(&source->src, src)) {
+            if (source->count >= limit) {
+                return source->timer;
+            }
+            source->count++;
+            return 0;
+        }
+        if (!oldest || (source->timer < oldest->timer)) {
+            oldest = source;
+        }
+    }
+    /* a new source takes a free entry, or the one closest to free */
+    bacnet_address_copy(&oldest->src, src);
+    oldest->count = 1;
+    oldest->timer = BACNET_WHO_IS_HOLDOFF_MS;
+
+    return 0;
+}
+
+/**
+ * @brief Get a random delay of an I-Am response
+ * @return milliseconds from 0 to the longest random delay
+ */
+static uint16_t who_is_random_delay(void)
+{
+    uint32_t x;
+
+    if (Who_Is_Jitter_Milliseconds == 0) {
+        return 0;
+    }
+    if (Who_Is_Random_State == 0) {
+        /* not seeded by handler_who_is_scheduled_init() */
+        Who_Is_Random_State = Device_Object_Instance_Number() | 0x80000000UL;
+    }
+    /* xorshift32 */
+    x = Who_Is_Random_State;
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    Who_Is_Random_State = x;
+
+    return (uint16_t)(x % ((uint32_t)Who_Is_Jitter_Milliseconds + 1));
+}
+
+/**
+ * @brief Get an entry of the I-Am response queue, growing the queue when
+ *  every entry is waiting to be sent
+ * @return a free entry, or NULL if the queue cannot grow
+ */
+static struct who_is_response *who_is_response_grow(void)
+{
+    struct who_is_response *queue;
+    unsigned index;
+    unsigned size;
+    unsigned size_max;
+
+    /* one I-Am of each device to each rate limited source */
+    size_max = ((unsigned)Who_Is_Device_Count * BACNET_WHO_IS_SOURCES_MAX) +
+        BACNET_WHO_IS_RESPONSES_EXTRA;
+    if (Who_Is_Response_Size >= size_max) {
+        return NULL;
+    }
+    if (Who_Is_Response_Size == 0) {
+        size = (unsigned)Who_Is_Device_Count + BACNET_WHO_IS_RESPONSES_EXTRA;
+    } else {
+        size = Who_Is_Response_Size * 2;
+    }
+    if (size > size_max) {
+        size = size_max;
+    }
+    queue = realloc(Who_Is_Response, size * sizeof(*queue));
+    if (!queue) {
+        return NULL;
+    }
+    memset(
+        &queue[Who_Is_Response_Size], 0,
+        (size - Who_Is_Response_Size) * sizeof(*queue));
+    Who_Is_Response = queue;
+    index = Who_Is_Response_Size;
+    Who_Is_Response_Size = size;
+
+    return &Who_Is_Response[index];
+}
+
+/**
+ * @brief Send a scheduled I-Am response using its cached encoding
+ * @param response [in] The I-Am response to send
+ */
+static void who_is_response_send(struct who_is_response *response)
+{
+    uint8_t *pdu = &Handler_Transmit_Buffer[0];
+    const struct who_is_iam_cache *iam;
+    BACNET_NPDU_DATA npdu_data;
+    int pdu_len = 0;
+    int bytes_sent = 0;
+
+    npdu_encode_npdu_data(&npdu_data, false, MESSAGE_PRIORITY_NORMAL);
+    pdu_len = npdu_encode_pdu(
+        pdu, &response->dest, &response->my_address, &npdu_data);
+    iam = who_is_iam_cache(response->device_id);
+    memcpy(&pdu[pdu_len], iam->apdu, iam->apdu_len);
+    pdu_len += iam->apdu_len;
+    bytes_sent =
+        datalink_send_pdu(&response->dest, &npdu_data, pdu, pdu_len);
+    if (bytes_sent <= 0) {
+        debug_perror("Failed to Send I-Am Reply");
+    }
+}
+
+/**
+ * @brief Schedule an I-Am response from the current device after a
+ *  random delay.  A duplicate Who-Is is answered by the I-Am that is
+ *  already scheduled, and a Who-Is repeated by a source within the
+ *  holdoff window after its I-Am was sent is ignored.  The I-Am
+ *  responses to a source beyond its limit in that window are deferred
+ *  until the window ends.
+ * @param src [in] The BACNET_ADDRESS of the Who-Is source
+ * @param unicast [in] true if the I-Am is sent back to the source,
+ *  false if it is broadcast
+ */
+static void who_is_response_schedule(const BACNET_ADDRESS *src, bool unicast)
+{
+    struct who_is_response *response;
+    struct who_is_response *free_slot = NULL;
+    struct who_is_response *held_slot = NULL;
+    struct who_is_response *slot;
+    BACNET_ADDRESS dest;
+    uint32_t device_id;
+    uint16_t delay;
+    unsigned i;
+
+    if (unicast) {
+        bacnet_address_copy(&dest, src);
+    } else {
+        datalink_get_broadcast_address(&dest);
+    }
+    device_id = Device_Object_Instance_Number();
+    for (i = 0; i < Who_Is_Response_Size; i++) {
+        response = &Who_Is_Response[i];
+        if (!response->pending && (response->timer == 0)) {
+            if (!free_slot) {
+                free_slot = response;
+            }
+        } else if (
+            (response->device_id == device_id) &&
+            bacnet_address_same(&response->dest, &dest) &&
+            (response->pending ||
+             bacnet_address_same(&response->src, src))) {
+            /* coalesce the duplicate Who-Is */
+            return;
+        } else if (
+            !response->pending &&
+            (!held_slot || (response->timer < held_slot->timer))) {
+            held_slot = response;
+        }
+    }
+    /* a held off entry is reused when none are free */
+    slot = free_slot ? free_slot : held_slot;
+    if (!slot) {
+        /* every entry is waiting to be sent: the queue grows */
+        slot = who_is_response_grow();
+    }
+    if (!slot) {
+        Who_Is_Overflow_Count++;
+        debug_printf(
+            "Who-Is: I-Am queue of %u is full\n", Who_Is_Response_Size);
+        return;
+    }
+    delay = who_is_source_delay(src);
+    slot->pending = true;
+    slot->device_id = device_id;
+    bacnet_address_copy(&slot->dest, &dest);
+    bacnet_address_copy(&slot->src, src);
+    datalink_get_my_address(&slot->my_address);
+    slot->timer = delay + who_is_random_delay();
+}
+
+/**
+ * @brief Determine if the current device answers a Who-Is request
+ * @param service_request [in] The received message to be handled.
+ * @param service_len [in] Length of the service_request message.
+ * @return true if the device instance is within the Who-Is limits
+ */
+static bool who_is_match(const uint8_t *service_request, uint16_t service_len)
+{
+    int len = 0;
+    int32_t low_limit = 0;
+    int32_t high_limit = 0;
+    uint32_t device_id;
+
+    len = whois_decode_service_request(
+        service_request, service_len, &low_limit, &high_limit);
+    if (len == 0) {
+        return true;
+    } else if (len != BACNET_STATUS_ERROR) {
+        device_id = Device_Object_Instance_Number();
+        if ((device_id >= (uint32_t)low_limit) &&
+            (device_id <= (uint32_t)high_limit)) {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+/** Handler for Who-Is requests, with a scheduled broadcast I-Am response.
+ *  The I-Am is sent by handler_who_is_timer() after a random delay,
+ *  so that the devices on a segment, or routed by a gateway, do not
+ *  all answer a global Who-Is at the same moment.
+ * @ingroup DMDDB
+ * @param service_request [in] The received message to be handled.
+ * @param service_len [in] Length of the service_request message.
+ * @param src [in] The BACNET_ADDRESS of the message's source, which is
+ *                 used for the rate limit and duplicate detection.
+ */
+void handler_who_is_scheduled(
+    uint8_t *service_request, uint16_t service_len, BACNET_ADDRESS *src)
+{
+    if (src && who_is_match(service_request, service_len)) {
+        who_is_response_schedule(src, false);
+    }
+}
+
+/** Handler for Who-Is requests, with a scheduled unicast I-Am response
+ *  returned to the src after a random delay.
+ * @ingroup DMDDB
+ * @param service_request [in] The received message to be handled.
+ * @param service_len [in] Length of the service_request message.
+ * @param src [in] The BACNET_ADDRESS of the message's source that the
+ *                 response will be sent back to.
+ */
+void handler_who_is_unicast_scheduled(
+    uint8_t *service_request, uint16_t service_len, BACNET_ADDRESS *src)
+{
+    if (src && who_is_match(service_request, service_len)) {
+        who_is_response_schedule(src, true);
+    }
+}
+
+/**
+ * @brief Send the scheduled I-Am responses that are due, and expire
+ *  the holdoff and rate limit windows
+ * @param elapsed_milliseconds [in] milliseconds since the last call
+ */
+void handler_who_is_timer(uint16_t elapsed_milliseconds)
+{
+    struct who_is_response *response;
+    struct who_is_source *source;
+    unsigned i;
+
+    for (i = 0; i < BACNET_WHO_IS_SOURCES_MAX; i++) {
+        source = &Who_Is_Source[i];
+        if (source->timer > elapsed_milliseconds) {
+            source->timer -= elapsed_milliseconds;
+        } else {
+            source->timer = 0;
+        }
+    }
+    for (i = 0; i < Who_Is_Response_Size; i++) {
+        response = &Who_Is_Response[i];
+        if (response->timer > elapsed_milliseconds) {
+            response->timer -= elapsed_milliseconds;
+        } else {
+            response->timer = 0;
+            if (response->pending) {
+                who_is_response_send(response);
+                response->pending = false;
+                response->timer = BACNET_WHO_IS_HOLDOFF_MS;
+            }
+        }
+    }
+}
+
+/**
+ * @brief Set the longest random delay of the scheduled I-Am responses
+ * @param milliseconds [in] longest delay, 0=send at the next timer call
+ */
+void handler_who_is_jitter_set(uint16_t milliseconds)
+{
+    Who_Is_Jitter_Milliseconds = milliseconds;
+}
+
+/**
+ * @brief Get the number of I-Am responses that did not fit in the queue
+ * @return number of I-Am responses that were not scheduled
+ */
+uint32_t handler_who_is_overflow_count(void)
+{
+    return Who_Is_Overflow_Count;
+}
+
+/**
+ * @brief Initialize the scheduled I-Am responses for a number of devices,
+ *  which sizes the response queue and the rate limit of each source,
+ *  and seed the random delay from the device instance and MAC address
+ *  so that devices do not pick the same delays.  Any scheduled I-Am
+ *  responses are discarded.
+ * @param device_count [in] number of devices that answer, such as
+ *  Routed_Device_Max() of a gateway, or 1.
+ */
+void handler_who_is_scheduled_init(uint16_t device_count)
+{
+    BACNET_ADDRESS my_address = { 0 };
+    uint32_t seed;
+    unsigned i;
+
+    Who_Is_Device_Count = device_count ? device_count : 1;
+    free(Who_Is_Response);
+    Who_Is_Response = NULL;
+    Who_Is_Response_Size = 0;
+    memset(Who_Is_Source, 0, sizeof(Who_Is_Source));
+    Who_Is_Overflow_Count = 0;
+    /* FNV-1a of the device instance and the MAC address */
+    seed = 2166136261UL ^ Device_Object_Instance_Number();
+    seed *= 16777619UL;
+    datalink_get_my_address(&my_address);
+    for (i = 0; (i < my_address.mac_len) && (i < MAX_MAC_LEN); i++) {
+        seed ^= my_address.mac[i];
+        seed *= 16777619UL;
+    }
+    Who_Is_Random_State = seed ? seed : 1;
+}
+
 #ifdef BAC_ROUTING /* was for BAC_ROUTING - delete in 2/2012 if still unused \
                     */
 /* EKH: I restored this to BAC_ROUTING (from DEPRECATED) because I found that
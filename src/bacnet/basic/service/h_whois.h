@@ -32,6 +32,26 @@ BACNET_STACK_EXPORT
 void handler_who_is_unicast(
     uint8_t *service_request, uint16_t service_len, BACNET_ADDRESS *src);
 
+BACNET_STACK_EXPORT
+void handler_who_is_scheduled(
+    uint8_t *service_request, uint16_t service_len, BACNET_ADDRESS *src);
+
+BACNET_STACK_EXPORT
+void handler_who_is_unicast_scheduled(
+    uint8_t *service_request, uint16_t service_len, BACNET_ADDRESS *src);
+
+BACNET_STACK_EXPORT
+void handler_who_is_timer(uint16_t elapsed_milliseconds);
+
+BACNET_STACK_EXPORT
+void handler_who_is_jitter_set(uint16_t milliseconds);
+
+BACNET_STACK_EXPORT
+uint32_t handler_who_is_overflow_count(void);
+
+BACNET_STACK_EXPORT
+void handler_who_is_scheduled_init(uint16_t device_count);
+
 BACNET_STACK_EXPORT
 void handler_who_is_bcast_for_routing(
     uint8_t *service_request, uint16_t service_len, BACNET_ADDRESS *src);
@@ -0,0 +1,304 @@
+/**
+ * @file
+ * @brief Hash table of entries in a table that grows on demand
+ * @details The entries are kept in one table, which doubles in size when
+ *  it is full, up to a limit.  The number of hash buckets is the power
+ *  of 2 at or above the size of the table, so the chains stay short, and
+ *  the buckets are rebuilt when the table grows.  The hash of a key is
+ *  32-bit FNV-1a of its words, with a final mix of the upper bits into
+ *  the lower bits that select the bucket.
+ * @author Steve Karg <skarg@users.sourceforge.net>
+ * @date 2024
+ * @copyright SPDX-License-Identifier: MIT
+ */
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include "bacnet/basic/sys/hash_table.h"
+
+/**
+ * @brief Start the hash of a key
+ * @return the hash of an empty key
+ */
+uint32_t hash_table_key_init(void)
+{
+    return 2166136261UL;
+}
+
+/**
+ * @brief Add a word of a key to its hash
+ * @param hash - hash of the key so far
+ * @param value - next word of the key
+ * @return hash of the key so far
+ */
+uint32_t hash_table_key_add(uint32_t hash, uint32_t value)
+{
+    return (hash ^ value) * 16777619UL;
+}
+
+/**
+ * @brief Complete the hash of a key
+ * @param hash - hash of the key
+ * @return hash of the key, with the upper bits mixed into the bucket bits
+ */
+uint32_t hash_table_key_final(uint32_t hash)
+{
+    hash ^= hash >> 16;
+    hash *= 0x85EBCA6BUL;
+    hash ^= hash >> 13;
+
+    return hash;
+}
+
+/**
+ * @brief Get the link to the next entry within an entry
+ * @param table - hash table
+ * @param index - index of the entry
+ * @return the link of the entry
+ */
+static uint32_t *hash_table_link(const HASH_TABLE *table, uint32_t index)
+{
+    return (uint32_t *)(table->entries + (index * table->entry_size) +
+                        table->link_offset);
+}
+
+/**
+ * @brief Initialize an empty hash table, which allocates nothing
+ *  until the first entry is added
+ * @param table - hash table
+ * @param entry_size - size of an entry
+ * @param link_offset - offset of the uint32_t link to the next entry
+ *  within an entry
+ * @param size_max - largest number of entries
+ * @param entry_hash - function that returns the hash of an entry, which
+ *  must be the hash given when the entry was added
+ */
+void hash_table_init(
+    HASH_TABLE *table,
+    size_t entry_size,
+    size_t link_offset,
+    uint32_t size_max,
+    hash_table_entry_hash_function entry_hash)
+{
+    if (!table) {
+        return;
+    }
+    table->entries = NULL;
+    table->entry_size = entry_size;
+    table->link_offset = link_offset;
+    table->size = 0;
+    table->size_max = size_max;
+    table->used = 0;
+    table->count = 0;
+    table->free = HASH_TABLE_NONE;
+    table->bucket = NULL;
+    table->bucket_count = 0;
+    table->entry_hash = entry_hash;
+}
+
+/**
+ * @brief Free the entries and hash buckets of a hash table, leaving it
+ *  empty and ready for use
+ * @param table - hash table
+ */
+void hash_table_cleanup(HASH_TABLE *table)
+{
+    if (!table) {
+        return;
+    }
+    free(table->entries);
+    free(table->bucket);
+    hash_table_init(
+        table, table->entry_size, table->link_offset, table->size_max,
+        table->entry_hash);
+}
+
+/**
+ * @brief Get an entry of a hash table
+ * @param table - hash table
+ * @param index - index of the entry
+ * @return the entry, or NULL if the index was never handed out
+ */
+void *hash_table_entry(const HASH_TABLE *table, uint32_t index)
+{
+    if (!table || (index >= table->used)) {
+        return NULL;
+    }
+
+    return table->entries + (index * table->entry_size);
+}
+
+/**
+ * @brief Get the first entry in the hash bucket of a hash
+ * @param table - hash table
+ * @param hash - hash of the key sought
+ * @return index of the first entry, or HASH_TABLE_NONE
+ */
+uint32_t hash_table_first(const HASH_TABLE *table, uint32_t hash)
+{
+    if (!table || !table->bucket) {
+        return HASH_TABLE_NONE;
+    }
+
+    return table->bucket[hash & (table->bucket_count - 1)];
+}
+
+/**
+ * @brief Get the next entry in the same hash bucket as an entry
+ * @param table - hash table
+ * @param index - index of an entry in a hash bucket
+ * @return index of the next entry, or HASH_TABLE_NONE
+ */
+uint32_t hash_table_next(const HASH_TABLE *table, uint32_t index)
+{
+    if (!table || (index >= table->used)) {
+        return HASH_TABLE_NONE;
+    }
+
+    return *hash_table_link(table, index);
+}
+
+/**
+ * @brief Grow the table of entries, and rebuild the hash buckets
+ * @param table - hash table
+ * @return true if the table has room for another entry
+ */
+static bool hash_table_grow(HASH_TABLE *table)
+{
+    uint8_t *entries;
+    uint32_t *bucket, *link;
+    uint32_t size, bucket_count, index, next, hash, i;
+
+    if (table->size >= table->size_max) {
+        return false;
+    }
+    size = table->size ? (table->size * 2) : HASH_TABLE_SIZE_MIN;
+    if ((size < table->size) || (size > table->size_max)) {
+        size = table->size_max;
+    }
+    bucket_count = HASH_TABLE_SIZE_MIN;
+    while ((bucket_count < size) && (bucket_count < 0x80000000UL)) {
+        bucket_count *= 2;
+    }
+    bucket = NULL;
+    if (bucket_count != table->bucket_count) {
+        bucket = malloc(bucket_count * sizeof(uint32_t));
+        if (!bucket) {
+            return false;
+        }
+    }
+    entries = realloc(table->entries, size * table->entry_size);
+    if (!entries) {
+        free(bucket);
+        return false;
+    }
+    table->entries = entries;
+    table->size = size;
+    if (bucket) {
+        for (i = 0; i < bucket_count; i++) {
+            bucket[i] = HASH_TABLE_NONE;
+        }
+        for (i = 0; i < table->bucket_count; i++) {
+            index = table->bucket[i];
+            while (index != HASH_TABLE_NONE) {
+                link = hash_table_link(table, index);
+                next = *link;
+                hash = table->entry_hash(hash_table_entry(table, index));
+                *link = bucket[hash & (bucket_count - 1)];
+                bucket[hash & (bucket_count - 1)] = index;
+                index = next;
+            }
+        }
+        free(table->bucket);
+        table->bucket = bucket;
+        table->bucket_count = bucket_count;
+    }
+
+    return true;
+}
+
+/**
+ * @brief Add an entry to a hash table, reusing a removed entry or
+ *  growing the table when it is full.  The caller fills in the key of
+ *  the new entry, which must have the hash given.
+ * @param table - hash table
+ * @param hash - hash of the key of the new entry
+ * @return index of the new entry, or HASH_TABLE_NONE if the table is
+ *  at its limit or cannot grow
+ */
+uint32_t hash_table_add(HASH_TABLE *table, uint32_t hash)
+{
+    uint32_t index, *bucket;
+
+    if (!table || !table->entry_hash) {
+        return HASH_TABLE_NONE;
+    }
+    if (table->free != HASH_TABLE_NONE) {
+        index = table->free;
+        table->free = *hash_table_link(table, index);
+    } else if ((table->used < table->size) || hash_table_grow(table)) {
+        index = table->used;
+        table->used++;
+    } else {
+        return HASH_TABLE_NONE;
+    }
+    bucket = &table->bucket[hash & (table->bucket_count - 1)];
+    *hash_table_link(table, index) = *bucket;
+    *bucket = index;
+    table->count++;
+
+    return index;
+}
+
+/**
+ * @brief Remove an entry from its hash bucket, and keep it for reuse.
+ *  The entry stays in the table, so the caller marks it as unused when
+ *  it walks the table by index.
+ * @param table - hash table
+ * @param hash - hash of the key of the entry
+ * @param index - index of the entry
+ * @return true if the entry was found in its hash bucket and removed
+ */
+bool hash_table_remove(HASH_TABLE *table, uint32_t hash, uint32_t index)
+{
+    uint32_t *link;
+
+    if (!table || !table->bucket || (index >= table->used)) {
+        return false;
+    }
+    link = &table->bucket[hash & (table->bucket_count - 1)];
+    while (*link != index) {
+        if (*link == HASH_TABLE_NONE) {
+            return false;
+        }
+        link = hash_table_link(table, *link);
+    }
+    *link = *hash_table_link(table, index);
+    *hash_table_link(table, index) = table->free;
+    table->free = index;
+    table->count--;
+
+    return true;
+}
+
+/**
+ * @brief Get the number of entries handed out, which is the limit of
+ *  the index when walking the table, including the removed entries
+ * @param table - hash table
+ * @return number of entries handed out
+ */
+uint32_t hash_table_used(const HASH_TABLE *table)
+{
+    return table ? table->used : 0;
+}
+
+/**
+ * @brief Get the number of entries in the hash table
+ * @param table - hash table
+ * @return number of entries, not counting the removed entries
+ */
+uint32_t hash_table_count(const HASH_TABLE *table)
+{
+    return table ? table->count : 0;
+}
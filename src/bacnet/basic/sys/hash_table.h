@@ -0,0 +1,93 @@
+/**
+ * @file
+ * @brief API for a hash table of entries in a table that grows on demand
+ * @author Steve Karg <skarg@users.sourceforge.net>
+ * @date 2024
+ * @copyright SPDX-License-Identifier: MIT
+ */
+#ifndef BACNET_SYS_HASH_TABLE_H
+#define BACNET_SYS_HASH_TABLE_H
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+/* BACnet Stack defines - first */
+#include "bacnet/bacdef.h"
+
+/* index of no entry */
+#define HASH_TABLE_NONE UINT32_MAX
+/* number of entries and hash buckets of a table that is first grown */
+#ifndef HASH_TABLE_SIZE_MIN
+#define HASH_TABLE_SIZE_MIN 16
+#endif
+
+/* function that returns the hash of the key of an entry */
+typedef uint32_t (*hash_table_entry_hash_function)(const void *entry);
+
+/**
+ * A table of entries that grows on demand, with the entries found by
+ * the hash of their key in a power of 2 number of hash buckets.
+ *
+ * Each entry is a structure of the caller that holds its key and a
+ * uint32_t link to the next entry in the same hash bucket, which is also
+ * used to keep the removed entries on a free list for reuse.  Entries
+ * are referred to by their index, since the table moves when it grows.
+ */
+typedef struct hash_table {
+    /* table of entries */
+    uint8_t *entries;
+    size_t entry_size;
+    /* offset of the uint32_t link to the next entry within an entry */
+    size_t link_offset;
+    /* number of entries allocated, and the limit to grow to */
+    uint32_t size;
+    uint32_t size_max;
+    /* number of entries handed out, including the removed entries */
+    uint32_t used;
+    /* number of entries in the hash buckets */
+    uint32_t count;
+    /* list of the removed entries */
+    uint32_t free;
+    uint32_t *bucket;
+    uint32_t bucket_count;
+    hash_table_entry_hash_function entry_hash;
+} HASH_TABLE;
+
+#ifdef __cplusplus
+extern "C" {
+#endif /* __cplusplus */
+
+BACNET_STACK_EXPORT
+uint32_t hash_table_key_init(void);
+BACNET_STACK_EXPORT
+uint32_t hash_table_key_add(uint32_t hash, uint32_t value);
+BACNET_STACK_EXPORT
+uint32_t hash_table_key_final(uint32_t hash);
+
+BACNET_STACK_EXPORT
+void hash_table_init(
+    HASH_TABLE *table,
+    size_t entry_size,
+    size_t link_offset,
+    uint32_t size_max,
+    hash_table_entry_hash_function entry_hash);
+BACNET_STACK_EXPORT
+void hash_table_cleanup(HASH_TABLE *table);
+BACNET_STACK_EXPORT
+void *hash_table_entry(const HASH_TABLE *table, uint32_t index);
+BACNET_STACK_EXPORT
+uint32_t hash_table_first(const HASH_TABLE *table, uint32_t hash);
+BACNET_STACK_EXPORT
+uint32_t hash_table_next(const HASH_TABLE *table, uint32_t index);
+BACNET_STACK_EXPORT
+uint32_t hash_table_add(HASH_TABLE *table, uint32_t hash);
+BACNET_STACK_EXPORT
+bool hash_table_remove(HASH_TABLE *table, uint32_t hash, uint32_t index);
+BACNET_STACK_EXPORT
+uint32_t hash_table_used(const HASH_TABLE *table);
+BACNET_STACK_EXPORT
+uint32_t hash_table_count(const HASH_TABLE *table);
+
+#ifdef __cplusplus
+}
+#endif /* __cplusplus */
+#endif
@@ -20,30 +20,39 @@
 #include <stdint.h>
 #include "bacnet/basic/sys/mstimer.h"
 
-/* callback data head of list */
-static struct mstimer_callback_data_t *Callback_Head;
+/* callback timers, by the millisecond at which they expire */
+static struct timer_wheel Callback_Wheel;
 
 /**
- * Handles an interrupt from a hardware millisecond timer
+ * @brief Calls the callback function of an expired timer and
+ *  schedules the next interval of the timer
+ * @param context - pointer to #mstimer_callback_data_t
  */
-void mstimer_callback_handler(void)
+static void mstimer_callback_expired(void *context)
 {
-    struct mstimer_callback_data_t *cb;
+    struct mstimer_callback_data_t *cb = context;
 
-    cb = (struct mstimer_callback_data_t *)Callback_Head;
-    while (cb) {
-        if (mstimer_expired(&cb->timer)) {
-            cb->callback();
-            if (mstimer_interval(&cb->timer) > 0) {
-                mstimer_reset(&cb->timer);
-            }
-        }
-        cb = cb->next;
+    if (cb->callback) {
+        cb->callback();
     }
+    mstimer_reset(&cb->timer);
+    timer_wheel_set(
+        &Callback_Wheel, &cb->node, cb->timer.start + cb->timer.interval);
+}
+
+/**
+ * Handles an interrupt from a hardware millisecond timer
+ * @note Only the callbacks that have expired are visited
+ */
+void mstimer_callback_handler(void)
+{
+    timer_wheel_advance(&Callback_Wheel, mstimer_now());
 }
 
 /**
- * Configures and enables a repeating callback function
+ * Configures and enables a repeating callback function.
+ * Configuring the same callback data again changes the callback
+ * and the interval, and an interval of zero disables the callback.
  *
  * @param new_cb - pointer to #mstimer_callback_data_t
  * @param callback - pointer to a #timer_callback_function function
@@ -54,24 +63,24 @@ void mstimer_callback(
     mstimer_callback_function callback,
     unsigned long milliseconds)
 {
-    struct mstimer_callback_data_t *cb;
-
-    if (new_cb) {
-        new_cb->callback = callback;
-        mstimer_set(&new_cb->timer, milliseconds);
+    if (!new_cb) {
+        return;
+    }
+    if (timer_wheel_count(&Callback_Wheel) == 0) {
+        /* start the wheel at the current time */
+        timer_wheel_init(&Callback_Wheel, mstimer_now());
+    }
+    if (!timer_wheel_pending(&new_cb->node)) {
+        timer_wheel_node_init(&new_cb->node, mstimer_callback_expired, new_cb);
     }
-    if (Callback_Head) {
-        cb = (struct mstimer_callback_data_t *)Callback_Head;
-        while (cb) {
-            if (!cb->next) {
-                cb->next = new_cb;
-                break;
-            } else {
-                cb = cb->next;
-            }
-        }
+    new_cb->callback = callback;
+    mstimer_set(&new_cb->timer, milliseconds);
+    if (milliseconds > 0) {
+        timer_wheel_set(
+            &Callback_Wheel, &new_cb->node,
+            new_cb->timer.start + milliseconds);
     } else {
-        Callback_Head = new_cb;
+        timer_wheel_cancel(&Callback_Wheel, &new_cb->node);
     }
 }
 
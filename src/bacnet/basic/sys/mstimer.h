@@ -10,6 +10,8 @@
 
 /* BACnet Stack defines - first */
 #include "bacnet/bacdef.h"
+/* BACnet Stack API */
+#include "bacnet/basic/sys/timer_wheel.h"
 
 /**
  * A timer.
@@ -26,12 +28,12 @@ struct mstimer {
 
 /* optional callback function form */
 typedef void (*mstimer_callback_function)(void);
-/* optional callback data structure */
+/* optional callback data structure - zero initialize before first use */
 struct mstimer_callback_data_t;
 struct mstimer_callback_data_t {
     struct mstimer timer;
     mstimer_callback_function callback;
-    struct mstimer_callback_data_t *next;
+    struct timer_wheel_node node;
 };
 
 #ifdef __cplusplus
@@ -0,0 +1,295 @@
+/**
+ * @file
+ * @brief Hierarchical timer wheel library
+ * @details Timers are kept in slots by the tick at which they expire.
+ * Level 0 has a slot per tick for the next TIMER_WHEEL_SLOTS ticks.
+ * Each higher level has TIMER_WHEEL_SLOTS slots that span all the slots
+ * of the level below.  When the lower levels wrap around, the timers in
+ * the next slot of the higher level are cascaded down, so a timer moves
+ * at most TIMER_WHEEL_LEVELS times before it expires.
+ *
+ * The tick is any unsigned long time base chosen by the caller, such
+ * as mstimer_now() milliseconds or an accumulated count of seconds.
+ * The tick may wrap around.
+ * @author Steve Karg <skarg@users.sourceforge.net>
+ * @date 2024
+ * @copyright SPDX-License-Identifier: MIT
+ */
+#include <stdbool.h>
+#include <stdint.h>
+#include <stddef.h>
+#include "bacnet/basic/sys/timer_wheel.h"
+
+#if ((TIMER_WHEEL_BITS * TIMER_WHEEL_LEVELS) > 30)
+#error "TIMER_WHEEL_BITS * TIMER_WHEEL_LEVELS must fit in an unsigned long"
+#endif
+
+#define TIMER_WHEEL_MASK (TIMER_WHEEL_SLOTS - 1UL)
+/* the longest delay that fits in the wheel */
+#define TIMER_WHEEL_SPAN \
+    ((1UL << (TIMER_WHEEL_BITS * TIMER_WHEEL_LEVELS)) - 1UL)
+
+/**
+ * @brief Determine if a tick is before another tick, allowing for wrap
+ * @param a - the tick to compare
+ * @param b - the tick to compare against
+ * @return true if tick a is before tick b
+ */
+static bool timer_wheel_before(unsigned long a, unsigned long b)
+{
+    return (
+        (unsigned long)(a - b) > ((unsigned long)(~((unsigned long)0)) >> 1));
+}
+
+/**
+ * @brief Link a timer into the slot for its expiration tick
+ * @param wheel - timer wheel
+ * @param node - timer that is not pending
+ */
+static void timer_wheel_link(
+    struct timer_wheel *wheel, struct timer_wheel_node *node)
+{
+    unsigned long expires = node->expires;
+    unsigned long delta;
+    struct timer_wheel_node **head;
+    unsigned level = 0;
+
+    if (timer_wheel_before(expires, wheel->tick)) {
+        /* already expired - run with the next tick */
+        expires = wheel->tick;
+    }
+    delta = expires - wheel->tick;
+    if (delta > TIMER_WHEEL_SPAN) {
+        /* park in the last slot; it is placed again when cascaded */
+        delta = TIMER_WHEEL_SPAN;
+        expires = wheel->tick + delta;
+    }
+    while ((level < (TIMER_WHEEL_LEVELS - 1)) &&
+           (delta >= (1UL << (TIMER_WHEEL_BITS * (level + 1))))) {
+        level++;
+    }
+    head = &wheel->slot[level]
+                       [(expires >> (TIMER_WHEEL_BITS * level)) &
+                        TIMER_WHEEL_MASK];
+    node->next = *head;
+    if (node->next) {
+        node->next->prev = &node->next;
+    }
+    node->prev = head;
+    *head = node;
+}
+
+/**
+ * @brief Unlink a pending timer from its slot
+ * @param node - timer that is pending
+ */
+static void timer_wheel_unlink(struct timer_wheel_node *node)
+{
+    *node->prev = node->next;
+    if (node->next) {
+        node->next->prev = node->prev;
+    }
+    node->next = NULL;
+    node->prev = NULL;
+}
+
+/**
+ * @brief Move the timers of a higher level slot into the lower levels
+ * @param wheel - timer wheel
+ * @param level - level of the slot, 1 or more
+ * @return the index of the slot that was cascaded
+ */
+static unsigned long
+timer_wheel_cascade(struct timer_wheel *wheel, unsigned level)
+{
+    struct timer_wheel_node *node;
+    unsigned long index;
+
+    index = (wheel->tick >> (TIMER_WHEEL_BITS * level)) & TIMER_WHEEL_MASK;
+    while ((node = wheel->slot[level][index]) != NULL) {
+        timer_wheel_unlink(node);
+        timer_wheel_link(wheel, node);
+    }
+
+    return index;
+}
+
+/**
+ * @brief Initialize the timer wheel, cancelling any pending timers
+ * @param wheel - timer wheel
+ * @param now - the current tick
+ */
+void timer_wheel_init(struct timer_wheel *wheel, unsigned long now)
+{
+    struct timer_wheel_node *node;
+    unsigned level, index;
+
+    if (!wheel) {
+        return;
+    }
+    for (level = 0; level < TIMER_WHEEL_LEVELS; level++) {
+        for (index = 0; index < TIMER_WHEEL_SLOTS; index++) {
+            while ((node = wheel->slot[level][index]) != NULL) {
+                timer_wheel_unlink(node);
+            }
+        }
+    }
+    wheel->tick = now;
+    wheel->count = 0;
+}
+
+/**
+ * @brief Initialize a timer that is not pending
+ * @param node - timer
+ * @param callback - function called when the timer expires
+ * @param context - data passed to the callback function
+ */
+void timer_wheel_node_init(
+    struct timer_wheel_node *node,
+    timer_wheel_callback_function callback,
+    void *context)
+{
+    if (node) {
+        node->next = NULL;
+        node->prev = NULL;
+        node->expires = 0;
+        node->callback = callback;
+        node->context = context;
+    }
+}
+
+/**
+ * @brief Start or restart a timer to expire at a tick. A tick that
+ *  has already passed expires with the next call to timer_wheel_advance().
+ * @param wheel - timer wheel
+ * @param node - timer
+ * @param expires - tick at which the timer expires
+ */
+void timer_wheel_set(
+    struct timer_wheel *wheel,
+    struct timer_wheel_node *node,
+    unsigned long expires)
+{
+    if (!wheel || !node) {
+        return;
+    }
+    if (node->prev) {
+        timer_wheel_unlink(node);
+    } else {
+        wheel->count++;
+    }
+    node->expires = expires;
+    timer_wheel_link(wheel, node);
+}
+
+/**
+ * @brief Stop a timer. Cancelling a timer that is not pending is harmless.
+ * @param wheel - timer wheel
+ * @param node - timer
+ */
+void timer_wheel_cancel(
+    struct timer_wheel *wheel, struct timer_wheel_node *node)
+{
+    if (!wheel || !node) {
+        return;
+    }
+    if (node->prev) {
+        timer_wheel_unlink(node);
+        wheel->count--;
+    }
+}
+
+/**
+ * @brief Determine if a timer is waiting to expire
+ * @param node - timer
+ * @return true if the timer is pending
+ */
+bool timer_wheel_pending(const struct timer_wheel_node *node)
+{
+    return node && node->prev;
+}
+
+/**
+ * @brief Get the tick at which a timer expires
+ * @param node - timer
+ * @return the tick given to timer_wheel_set()
+ */
+unsigned long timer_wheel_expires(const struct timer_wheel_node *node)
+{
+    return node ? node->expires : 0;
+}
+
+/**
+ * @brief Get the number of pending timers
+ * @param wheel - timer wheel
+ * @return number of pending timers
+ */
+unsigned timer_wheel_count(const struct timer_wheel *wheel)
+{
+    return wheel ? wheel->count : 0;
+}
+
+/**
+ * @brief Turn the wheel up to and including the current tick, calling
+ *  the callback of each timer that expires.  The wheel skips from one
+ *  non-empty level 0 slot or cascade boundary to the next, rather than
+ *  stepping through every tick.  The timer is no longer
+ *  pending when its callback is called, so the callback may set the
+ *  timer again, or set or cancel any other timer.
+ * @param wheel - timer wheel
+ * @param now - the current tick
+ */
+void timer_wheel_advance(struct timer_wheel *wheel, unsigned long now)
+{
+    struct timer_wheel_node *node;
+    struct timer_wheel_node *expired;
+    unsigned long index, next;
+    unsigned level;
+
+    if (!wheel) {
+        return;
+    }
+    while (!timer_wheel_before(now, wheel->tick)) {
+        if (wheel->count == 0) {
+            /* nothing to expire */
+            wheel->tick = now + 1UL;
+            break;
+        }
+        index = wheel->tick & TIMER_WHEEL_MASK;
+        level = 1;
+        while ((index == 0) && (level < TIMER_WHEEL_LEVELS)) {
+            index = timer_wheel_cascade(wheel, level);
+            level++;
+        }
+        index = wheel->tick & TIMER_WHEEL_MASK;
+        if (!wheel->slot[0][index]) {
+            /* skip the empty slots, up to the next timer in level 0 or
+               the next cascade boundary, but not past the current tick */
+            next = index + 1UL;
+            while ((next < TIMER_WHEEL_SLOTS) && !wheel->slot[0][next]) {
+                next++;
+            }
+            if ((unsigned long)(now - wheel->tick) < (next - index)) {
+                wheel->tick = now + 1UL;
+                break;
+            }
+            wheel->tick += next - index;
+            continue;
+        }
+        /* take the expired timers out of the slot, since the callbacks
+           may set timers for the following ticks into the same slot */
+        expired = wheel->slot[0][index];
+        wheel->slot[0][index] = NULL;
+        if (expired) {
+            expired->prev = &expired;
+        }
+        wheel->tick++;
+        while ((node = expired) != NULL) {
+            timer_wheel_unlink(node);
+            wheel->count--;
+            if (node->callback) {
+                node->callback(node->context);
+            }
+        }
+    }
+}
@@ -0,0 +1,94 @@
+/**
+ * @file
+ * @brief API for a hierarchical timer wheel library
+ * @author Steve Karg <skarg@users.sourceforge.net>
+ * @date 2024
+ * @copyright SPDX-License-Identifier: MIT
+ */
+#ifndef BACNET_SYS_TIMER_WHEEL_H
+#define BACNET_SYS_TIMER_WHEEL_H
+#include <stdbool.h>
+#include <stdint.h>
+/* BACnet Stack defines - first */
+#include "bacnet/bacdef.h"
+
+/* number of bits of the tick used to select a slot in each level */
+#ifndef TIMER_WHEEL_BITS
+#define TIMER_WHEEL_BITS 6
+#endif
+/* number of levels - the wheel spans 2^(BITS*LEVELS) ticks */
+#ifndef TIMER_WHEEL_LEVELS
+#define TIMER_WHEEL_LEVELS 4
+#endif
+#define TIMER_WHEEL_SLOTS (1UL << TIMER_WHEEL_BITS)
+
+/* function called when a timer expires */
+typedef void (*timer_wheel_callback_function)(void *context);
+
+/**
+ * A timer in the wheel.
+ *
+ * The node is owned by the caller, so the wheel never allocates memory.
+ * Initialize the node with timer_wheel_node_init() before it is used.
+ */
+struct timer_wheel_node;
+struct timer_wheel_node {
+    /* next timer in the same slot */
+    struct timer_wheel_node *next;
+    /* link that points to this timer, or NULL when not pending */
+    struct timer_wheel_node **prev;
+    /* tick at which the timer expires */
+    unsigned long expires;
+    timer_wheel_callback_function callback;
+    void *context;
+};
+
+/**
+ * A hierarchical timer wheel.
+ *
+ * Level 0 has a slot for each of the next TIMER_WHEEL_SLOTS ticks, and
+ * each higher level has slots that are TIMER_WHEEL_SLOTS times wider.
+ * Timers in a higher level are cascaded into the lower levels as the
+ * wheel turns, so inserting or cancelling a timer takes constant time
+ * and each tick only touches the timers that expire or cascade.
+ */
+struct timer_wheel {
+    struct timer_wheel_node *slot[TIMER_WHEEL_LEVELS][TIMER_WHEEL_SLOTS];
+    /* the next tick to be processed */
+    unsigned long tick;
+    /* number of pending timers */
+    unsigned count;
+};
+
+#ifdef __cplusplus
+extern "C" {
+#endif /* __cplusplus */
+
+BACNET_STACK_EXPORT
+void timer_wheel_init(struct timer_wheel *wheel, unsigned long now);
+BACNET_STACK_EXPORT
+void timer_wheel_node_init(
+    struct timer_wheel_node *node,
+    timer_wheel_callback_function callback,
+    void *context);
+BACNET_STACK_EXPORT
+void timer_wheel_set(
+    struct timer_wheel *wheel,
+    struct timer_wheel_node *node,
+    unsigned long expires);
+BACNET_STACK_EXPORT
+void timer_wheel_cancel(
+    struct timer_wheel *wheel, struct timer_wheel_node *node);
+BACNET_STACK_EXPORT
+bool timer_wheel_pending(const struct timer_wheel_node *node);
+BACNET_STACK_EXPORT
+unsigned long timer_wheel_expires(const struct timer_wheel_node *node);
+BACNET_STACK_EXPORT
+unsigned timer_wheel_count(const struct timer_wheel *wheel);
+BACNET_STACK_EXPORT
+void timer_wheel_advance(struct timer_wheel *wheel, unsigned long now);
+
+#ifdef __cplusplus
+}
+#endif /* __cplusplus */
+#endif
@@ -19,6 +19,7 @@
 #include "bacnet/datalink/datalink.h"
 #include "bacnet/basic/services.h"
 #include "bacnet/basic/binding/address.h"
+#include "bacnet/basic/sys/timer_wheel.h"
 
 /** @file tsm.c  BACnet Transaction State Machine operations  */
 /* FIXME: modify basic service handlers to use TSM rather than this buffer! */
@@ -41,6 +42,14 @@ static uint8_t Current_Invoke_ID = 1;
 
 static tsm_timeout_function Timeout_Function;
 
+/* request timers of the transactions that await confirmation */
+static struct timer_wheel TSM_Timer_Wheel;
+static struct timer_wheel_node TSM_Request_Timer[MAX_TSM_TRANSACTIONS];
+/* milliseconds counted by tsm_timer_milliseconds() */
+static unsigned long TSM_Milliseconds;
+
+static void tsm_request_timer_start(unsigned index);
+
 void tsm_set_timeout_handler(tsm_timeout_function pFunction)
 {
     Timeout_Function = pFunction;
@@ -175,7 +184,6 @@ uint8_t tsm_next_free_invokeID(void)
                     plist = &TSM_List[index];
                     plist->InvokeID = invokeID = Current_Invoke_ID;
                     plist->state = TSM_STATE_IDLE;
-                    plist->RequestTimer = apdu_timeout();
                     /* update for the next call or check */
                     Current_Invoke_ID++;
                     /* skip zero - we treat that internally as invalid or no
@@ -227,7 +235,7 @@ void tsm_set_confirmed_unsegmented_transaction(
             plist->state = TSM_STATE_AWAIT_CONFIRMATION;
             plist->RetryCount = 0;
             /* start the timer */
-            plist->RequestTimer = apdu_timeout();
+            tsm_request_timer_start(index);
             /* copy the data */
             for (j = 0; j < apdu_len; j++) {
                 plist->apdu[j] = apdu[j];
@@ -289,47 +297,64 @@ bool tsm_get_transaction_pdu(
     return found;
 }
 
+/** Handles the expired request timer of a transaction,
+ *  by sending the request again or by failing the transaction.
+ *
+ * @param context - pointer to the BACNET_TSM_DATA of the transaction
+ */
+static void tsm_request_timeout(void *context)
+{
+    BACNET_TSM_DATA *plist = context;
+
+    /* AWAIT_CONFIRMATION */
+    if (plist->state != TSM_STATE_AWAIT_CONFIRMATION) {
+        return;
+    }
+    if (plist->RetryCount < apdu_retries()) {
+        plist->RetryCount++;
+        tsm_request_timer_start((unsigned)(plist - TSM_List));
+        datalink_send_pdu(
+            &plist->dest, &plist->npdu_data, &plist->apdu[0],
+            plist->apdu_len);
+    } else {
+        /* note: the invoke id has not been cleared yet
+           and this indicates a failed message:
+           IDLE and a valid invoke id */
+        plist->state = TSM_STATE_IDLE;
+        if (plist->InvokeID != 0) {
+            if (Timeout_Function) {
+                Timeout_Function(plist->InvokeID);
+            }
+        }
+    }
+}
+
+/** Starts the request timer of a transaction for the APDU timeout
+ *
+ * @param index - index of the transaction in the TSM table
+ */
+static void tsm_request_timer_start(unsigned index)
+{
+    struct timer_wheel_node *node = &TSM_Request_Timer[index];
+
+    if (!timer_wheel_pending(node)) {
+        timer_wheel_node_init(node, tsm_request_timeout, &TSM_List[index]);
+    }
+    timer_wheel_set(
+        &TSM_Timer_Wheel, node, TSM_Milliseconds + apdu_timeout());
+}
+
 /** Called once a millisecond or slower.
  *  This function calls the handler for a
  *  timeout 'Timeout_Function', if necessary.
+ *  Only the transactions with an expired request timer are visited.
  *
  * @param milliseconds - Count of milliseconds passed, since the last call.
  */
 void tsm_timer_milliseconds(uint16_t milliseconds)
 {
-    unsigned i = 0; /* counter */
-
-    BACNET_TSM_DATA *plist = &TSM_List[0];
-
-    for (i = 0; i < MAX_TSM_TRANSACTIONS; i++, plist++) {
-        if (plist->state == TSM_STATE_AWAIT_CONFIRMATION) {
-            if (plist->RequestTimer > milliseconds) {
-                plist->RequestTimer -= milliseconds;
-            } else {
-                plist->RequestTimer = 0;
-            }
-            /* AWAIT_CONFIRMATION */
-            if (plist->RequestTimer == 0) {
-                if (plist->RetryCount < apdu_retries()) {
-                    plist->RequestTimer = apdu_timeout();
-                    plist->RetryCount++;
-                    datalink_send_pdu(
-                        &plist->dest, &plist->npdu_data, &plist->apdu[0],
-                        plist->apdu_len);
-                } else {
-                    /* note: the invoke id has not been cleared yet
-                       and this indicates a failed message:
-                       IDLE and a valid invoke id */
-                    plist->state = TSM_STATE_IDLE;
-                    if (plist->InvokeID != 0) {
-                        if (Timeout_Function) {
-                            Timeout_Function(plist->InvokeID);
-                        }
-                    }
-                }
-            }
-        }
-    }
+    TSM_Milliseconds += milliseconds;
+    timer_wheel_advance(&TSM_Timer_Wheel, TSM_Milliseconds);
 }
 
 /** Frees the invokeID and sets its state to IDLE
@@ -346,6 +371,7 @@ void tsm_free_invoke_id(uint8_t invokeID)
         plist = &TSM_List[index];
         plist->state = TSM_STATE_IDLE;
         plist->InvokeID = 0;
+        timer_wheel_cancel(&TSM_Timer_Wheel, &TSM_Request_Timer[index]);
     }
 }
 
@@ -62,9 +62,6 @@ typedef struct BACnet_TSM_Data {
     /*uint8_t ProposedWindowSize;  */
     /*  used to perform timeout on PDU segments */
     /*uint8_t SegmentTimer; */
-    /* used to perform timeout on Confirmed Requests */
-    /* in milliseconds */
-    uint16_t RequestTimer;
     /* unique id */
     uint8_t InvokeID;
     /* state that the TSM is in */
@@ -27,6 +27,10 @@
 #if BACNET_PORT == bsd || BACNET_PORT == linux || BACNET_PORT == win32
 #include <libwebsockets.h>
 #define BSC_CONF_TX_PRE LWS_PRE
+/* hosted ports can afford deeper transmit queues */
+#ifndef BSC_CONF_SOCKET_TX_BUFFERED_PACKET_NUM
+#define BSC_CONF_SOCKET_TX_BUFFERED_PACKET_NUM 8
+#endif
 #else
 #define BSC_CONF_TX_PRE 0
 #endif
@@ -89,9 +93,23 @@
     (BSC_CONF_NODE_SWITCH_CONNECTIONS_NUM * BSC_CONF_NODE_SWITCHES_NUM)
 #endif
 
+#ifndef BSC_CONF_SOCKET_TX_BUFFERED_PACKET_NUM
 #define BSC_CONF_SOCKET_TX_BUFFERED_PACKET_NUM 2
+#endif
 #define BSC_CONF_DATALINK_BUFFERED_PACKET_NUM 10
 
+/* High and low watermarks of the TX buffer of a socket, in percent of
+   its size. Once a PDU fills the buffer above the high watermark,
+   bsc_send() refuses further PDUs with BSC_SC_WOULD_BLOCK until the
+   buffer is drained down to the low watermark. */
+#ifndef BSC_CONF_SOCK_TX_HIGH_WATERMARK
+#define BSC_CONF_SOCK_TX_HIGH_WATERMARK 75
+#endif
+
+#ifndef BSC_CONF_SOCK_TX_LOW_WATERMARK
+#define BSC_CONF_SOCK_TX_LOW_WATERMARK 25
+#endif
+
 #define BSC_CONF_SOCK_RX_BUFFER_SIZE BVLC_SC_NPDU_SIZE_CONF
 
 /* 2 bytes is a prefix containing BVLC message length.
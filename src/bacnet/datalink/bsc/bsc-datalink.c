@@ -229,7 +229,9 @@ void bsc_cleanup(void)
  * @param npdu_data - network layer data
  * @param pdu - PDU to send
  * @param pdu_len - length of the PDU
- * @return number of bytes sent on success, negative number on failure
+ * @return number of bytes sent on success, zero if the connection to the
+ *  destination is congested and the PDU can be sent again later, or
+ *  negative number on failure
  */
 int bsc_send_pdu(
     BACNET_ADDRESS *dest,
@@ -267,7 +269,10 @@ int bsc_send_pdu(
         ret = bsc_node_send(bsc_node, buf, len);
         len = pdu_len;
 
-        if (ret != BSC_SC_SUCCESS) {
+        if (ret == BSC_SC_WOULD_BLOCK) {
+            /* the TX buffer of the socket is above its high watermark */
+            len = 0;
+        } else if (ret != BSC_SC_SUCCESS) {
             len = -1;
         }
     }
@@ -71,7 +71,9 @@ bool bsc_cert_files_check(void);
  *                       compatibility.
  * @param pdu [in] protocol data unit to be sent.
  * @param pdu_len [in] - number of bytes to send.
- * @return Number of bytes sent on success, negative number on failure.
+ * @return Number of bytes sent on success, zero if the transmit buffer
+ *         of the connection is above its high watermark and the pdu
+ *         can be sent again later, negative number on failure.
  */
 
 BACNET_STACK_EXPORT
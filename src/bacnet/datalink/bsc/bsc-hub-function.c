@@ -56,6 +56,13 @@ typedef enum {
     BSC_HUB_FUNCTION_STATE_STOPPING = 3
 } BSC_HUB_FUNCTION_STATE;
 
+/* number of buckets in the VMAC and UUID hash indexes */
+#ifndef BSC_HUB_FUNCTION_HASH_SIZE
+#define BSC_HUB_FUNCTION_HASH_SIZE (BSC_CONF_HUB_FUNCTION_CONNECTIONS_NUM * 2)
+#endif
+/* end of a hash chain */
+#define BSC_HUB_FUNCTION_HASH_NONE 0xFFFF
+
 typedef struct BSC_Hub_Connector {
     bool used;
     BSC_SOCKET_CTX ctx;
@@ -64,6 +71,19 @@ typedef struct BSC_Hub_Connector {
     BSC_HUB_FUNCTION_STATE state;
     BSC_HUB_EVENT_FUNC event_func;
     void *user_arg;
+    /* hash indexes of the connected sockets by VMAC and by UUID,
+       maintained on the connect and disconnect events */
+    uint16_t vmac_hash[BSC_HUB_FUNCTION_HASH_SIZE];
+    uint16_t uuid_hash[BSC_HUB_FUNCTION_HASH_SIZE];
+    uint16_t vmac_next[BSC_CONF_HUB_FUNCTION_CONNECTIONS_NUM];
+    uint16_t uuid_next[BSC_CONF_HUB_FUNCTION_CONNECTIONS_NUM];
+    uint16_t vmac_bucket[BSC_CONF_HUB_FUNCTION_CONNECTIONS_NUM];
+    uint16_t uuid_bucket[BSC_CONF_HUB_FUNCTION_CONNECTIONS_NUM];
+    bool indexed[BSC_CONF_HUB_FUNCTION_CONNECTIONS_NUM];
+    /* status of each socket for the last relayed broadcast, and the
+       number of PDUs dropped for a full transmit buffer since connecting */
+    BSC_SC_RET tx_result[BSC_CONF_HUB_FUNCTION_CONNECTIONS_NUM];
+    uint32_t tx_dropped[BSC_CONF_HUB_FUNCTION_CONNECTIONS_NUM];
 } BSC_HUB_FUNCTION;
 
 #if BSC_CONF_HUB_FUNCTIONS_NUM > 0
@@ -103,6 +123,106 @@ static void hub_function_free(BSC_HUB_FUNCTION *p)
     p->used = false;
 }
 
+/**
+ * @brief Hash a VMAC address or UUID to a bucket of the hash indexes
+ * @param data - pointer to the bytes of the VMAC address or UUID
+ * @param size - number of bytes
+ * @return bucket of the hash indexes
+ */
+static uint16_t hub_function_hash(const uint8_t *data, size_t size)
+{
+    uint32_t hash = 2166136261UL;
+    size_t i;
+
+    for (i = 0; i < size; i++) {
+        hash ^= data[i];
+        hash *= 16777619UL;
+    }
+
+    return (uint16_t)(hash % BSC_HUB_FUNCTION_HASH_SIZE);
+}
+
+/**
+ * @brief Empty the VMAC and UUID hash indexes of a hub function
+ * @param f - pointer to the hub function
+ */
+static void hub_function_index_clear(BSC_HUB_FUNCTION *f)
+{
+    size_t i;
+
+    for (i = 0; i < BSC_HUB_FUNCTION_HASH_SIZE; i++) {
+        f->vmac_hash[i] = BSC_HUB_FUNCTION_HASH_NONE;
+        f->uuid_hash[i] = BSC_HUB_FUNCTION_HASH_NONE;
+    }
+    for (i = 0; i < BSC_CONF_HUB_FUNCTION_CONNECTIONS_NUM; i++) {
+        f->indexed[i] = false;
+    }
+}
+
+/**
+ * @brief Unlink a socket from a hash chain
+ * @param head - pointer to the head of the chain
+ * @param next - array of the chain links of the sockets
+ * @param index - index of the socket
+ */
+static void
+hub_function_chain_remove(uint16_t *head, uint16_t *next, uint16_t index)
+{
+    while (*head != BSC_HUB_FUNCTION_HASH_NONE) {
+        if (*head == index) {
+            *head = next[index];
+            break;
+        }
+        head = &next[*head];
+    }
+}
+
+/**
+ * @brief Remove a socket from the VMAC and UUID hash indexes
+ * @param f - pointer to the hub function
+ * @param c - pointer to the socket
+ */
+static void hub_function_index_remove(BSC_HUB_FUNCTION *f, BSC_SOCKET *c)
+{
+    uint16_t index = (uint16_t)(c - &f->sock[0]);
+
+    if (index >= BSC_CONF_HUB_FUNCTION_CONNECTIONS_NUM || !f->indexed[index]) {
+        return;
+    }
+    hub_function_chain_remove(
+        &f->vmac_hash[f->vmac_bucket[index]], f->vmac_next, index);
+    hub_function_chain_remove(
+        &f->uuid_hash[f->uuid_bucket[index]], f->uuid_next, index);
+    f->indexed[index] = false;
+}
+
+/**
+ * @brief Add a connected socket to the VMAC and UUID hash indexes.
+ *  A socket that replaces a connection with the same UUID is found
+ *  first, since it is added to the head of the chains.
+ * @param f - pointer to the hub function
+ * @param c - pointer to the socket
+ */
+static void hub_function_index_add(BSC_HUB_FUNCTION *f, BSC_SOCKET *c)
+{
+    uint16_t index = (uint16_t)(c - &f->sock[0]);
+    uint16_t bucket;
+
+    if (index >= BSC_CONF_HUB_FUNCTION_CONNECTIONS_NUM) {
+        return;
+    }
+    hub_function_index_remove(f, c);
+    bucket = hub_function_hash(&c->vmac.address[0], sizeof(c->vmac.address));
+    f->vmac_bucket[index] = bucket;
+    f->vmac_next[index] = f->vmac_hash[bucket];
+    f->vmac_hash[bucket] = index;
+    bucket = hub_function_hash(&c->uuid.uuid[0], sizeof(c->uuid.uuid));
+    f->uuid_bucket[index] = bucket;
+    f->uuid_next[index] = f->uuid_hash[bucket];
+    f->uuid_hash[bucket] = index;
+    f->indexed[index] = true;
+}
+
 /**
  * @brief find a hub function connection for a specific VMAC address
  * @param vmac - pointer to the VMAC address
@@ -112,7 +232,7 @@ static void hub_function_free(BSC_HUB_FUNCTION *p)
 static BSC_SOCKET *hub_function_find_connection_for_vmac(
     BACNET_SC_VMAC_ADDRESS *vmac, void *user_arg)
 {
-    int i;
+    uint16_t i;
     BSC_HUB_FUNCTION *f;
 
     bws_dispatch_lock();
@@ -120,7 +240,9 @@ static BSC_SOCKET *hub_function_find_connection_for_vmac(
     DEBUG_PRINTF(
         "hubf = %p local_vmac = %s\n", f,
         bsc_vmac_to_string(&f->cfg.local_vmac));
-    for (i = 0; i < sizeof(f->sock) / sizeof(BSC_SOCKET); i++) {
+    i = f->vmac_hash[hub_function_hash(
+        &vmac->address[0], sizeof(vmac->address))];
+    while (i != BSC_HUB_FUNCTION_HASH_NONE) {
         DEBUG_PRINTF(
             "hubf = %p, sock %p, state = %d, vmac = %s\n", f, &f->sock[i],
             f->sock[i].state, bsc_vmac_to_string(&f->sock[i].vmac));
@@ -131,6 +253,7 @@ static BSC_SOCKET *hub_function_find_connection_for_vmac(
             bws_dispatch_unlock();
             return &f->sock[i];
         }
+        i = f->vmac_next[i];
     }
     bws_dispatch_unlock();
     return NULL;
@@ -145,12 +268,13 @@ static BSC_SOCKET *hub_function_find_connection_for_vmac(
 static BSC_SOCKET *
 hub_function_find_connection_for_uuid(BACNET_SC_UUID *uuid, void *user_arg)
 {
-    int i;
+    uint16_t i;
     BSC_HUB_FUNCTION *f;
 
     bws_dispatch_lock();
     f = (BSC_HUB_FUNCTION *)user_arg;
-    for (i = 0; i < sizeof(f->sock) / sizeof(BSC_SOCKET); i++) {
+    i = f->uuid_hash[hub_function_hash(&uuid->uuid[0], sizeof(uuid->uuid))];
+    while (i != BSC_HUB_FUNCTION_HASH_NONE) {
         DEBUG_PRINTF(
             "hubf = %p, sock %p, state = %d, uuid = %s\n", f, &f->sock[i],
             f->sock[i].state, bsc_uuid_to_string(&f->sock[i].uuid));
@@ -161,6 +285,7 @@ hub_function_find_connection_for_uuid(BACNET_SC_UUID *uuid, void *user_arg)
             DEBUG_PRINTF("found socket\n");
             return &f->sock[i];
         }
+        i = f->uuid_next[i];
     }
     bws_dispatch_unlock();
     return NULL;
@@ -280,6 +405,7 @@ static void hub_function_socket_event(
     uint8_t *p_pdu;
     BSC_HUB_FUNCTION *f;
     size_t len;
+    size_t count;
 
     DEBUG_PRINTF(
         "hub_function_socket_event() >>> c = %p, ev = %d, reason = "
@@ -295,30 +421,30 @@ static void hub_function_socket_event(
         if (!decoded_pdu->hdr.origin && decoded_pdu->hdr.dest) {
             if (bvlc_sc_is_vmac_broadcast(decoded_pdu->hdr.dest)) {
                 if (bsc_socket_get_global_buf_size() >= pdu_len) {
+                    /* add the origin address once, and queue the same
+                       encoded pdu on every other connected socket */
                     p_pdu = bsc_socket_get_global_buf();
-                    len = pdu_len;
-                    memcpy(p_pdu, pdu, len);
-
-                    for (i = 0; i < sizeof(f->sock) / sizeof(BSC_SOCKET); i++) {
-                        if (&f->sock[i] != c &&
-                            f->sock[i].state == BSC_SOCK_STATE_CONNECTED) {
-                            /* change origin address if presented or add origin
-                             */
-                            /* address into pdu by extending of it's header */
-                            len = (uint16_t)bvlc_sc_set_orig(
-                                &p_pdu, len, &c->vmac);
-                            ret = bsc_send(&f->sock[i], p_pdu, len);
-                            (void)ret;
-#if DEBUG_ENABLED == 1
-                            if (ret != BSC_SC_SUCCESS) {
-                                DEBUG_PRINTF(
-                                    "sending of reconstructed pdu failed, "
-                                    "err = %d\n",
-                                    ret);
-                            }
-#endif
+                    memcpy(p_pdu, pdu, pdu_len);
+                    len = bvlc_sc_set_orig(&p_pdu, pdu_len, &c->vmac);
+                    count = bsc_send_broadcast(
+                        f->sock, BSC_CONF_HUB_FUNCTION_CONNECTIONS_NUM, c,
+                        p_pdu, len, f->tx_result);
+                    (void)count;
+                    for (i = 0; i < BSC_CONF_HUB_FUNCTION_CONNECTIONS_NUM;
+                         i++) {
+                        if (f->tx_result[i] == BSC_SC_WOULD_BLOCK ||
+                            f->tx_result[i] == BSC_SC_NO_RESOURCES) {
+                            f->tx_dropped[i]++;
+                            DEBUG_PRINTF(
+                                "broadcast pdu dropped for sock %p, "
+                                "vmac = %s\n",
+                                &f->sock[i],
+                                bsc_vmac_to_string(&f->sock[i].vmac));
                         }
                     }
+                    DEBUG_PRINTF(
+                        "broadcast pdu of %lu bytes queued on %lu sockets\n",
+                        (unsigned long)len, (unsigned long)count);
                 }
 #if DEBUG_ENABLED == 1
                 else {
@@ -336,7 +462,10 @@ static void hub_function_socket_event(
                 } else {
                     bvlc_sc_remove_dest_set_orig(pdu, pdu_len, &c->vmac);
                     ret = bsc_send(dst, pdu, pdu_len);
-                    (void)ret;
+                    if (ret == BSC_SC_WOULD_BLOCK ||
+                        ret == BSC_SC_NO_RESOURCES) {
+                        f->tx_dropped[dst - &f->sock[0]]++;
+                    }
 #if DEBUG_ENABLED == 1
                     if (ret != BSC_SC_SUCCESS) {
                         DEBUG_PRINTF(
@@ -348,6 +477,7 @@ static void hub_function_socket_event(
             }
         }
     } else if (ev == BSC_SOCKET_EVENT_DISCONNECTED) {
+        hub_function_index_remove(f, c);
         hub_function_update_status(f, c, ev, reason, reason_desc);
         if (reason == ERROR_CODE_NODE_DUPLICATE_VMAC) {
             f->event_func(
@@ -355,6 +485,8 @@ static void hub_function_socket_event(
                 (BSC_HUB_FUNCTION_HANDLE)f, f->user_arg);
         }
     } else if (ev == BSC_SOCKET_EVENT_CONNECTED) {
+        f->tx_dropped[c - &f->sock[0]] = 0;
+        hub_function_index_add(f, c);
         hub_function_update_status(f, c, ev, reason, reason_desc);
     }
     bws_dispatch_unlock();
@@ -377,6 +509,7 @@ static void hub_function_context_event(BSC_SOCKET_CTX *ctx, BSC_CTX_EVENT ev)
             BSC_HUBF_EVENT_STARTED, (BSC_HUB_FUNCTION_HANDLE)f, f->user_arg);
     } else if (ev == BSC_CTX_DEINITIALIZED) {
         f->state = BSC_HUB_FUNCTION_STATE_IDLE;
+        hub_function_index_clear(f);
         hub_function_free(f);
         f->event_func(
             BSC_HUBF_EVENT_STOPPED, (BSC_HUB_FUNCTION_HANDLE)f, f->user_arg);
@@ -453,6 +586,7 @@ BSC_SC_RET bsc_hub_function_start(
 
     f->user_arg = user_arg;
     f->event_func = event_func;
+    hub_function_index_clear(f);
 
     bsc_init_ctx_cfg(
         BSC_SOCKET_CTX_ACCEPTOR, &f->cfg, BSC_WEBSOCKET_HUB_PROTOCOL, port,
@@ -533,3 +667,31 @@ bool bsc_hub_function_started(BSC_HUB_FUNCTION_HANDLE h)
     DEBUG_PRINTF("bsc_hub_function_started() <<< ret = %d\n", ret);
     return ret;
 }
+
+/**
+ * @brief Get the number of PDUs the hub function dropped for a connection
+ *  because its transmit buffer was full, since the connection was made.
+ *  A growing count shows a peer that is not keeping up with the relayed
+ *  broadcast and unicast traffic.
+ * @param h - pointer to the hub function handle
+ * @param vmac - pointer to the VMAC address of the connection
+ * @return number of dropped PDUs, or 0 if the connection is not found
+ */
+uint32_t bsc_hub_function_tx_dropped(
+    BSC_HUB_FUNCTION_HANDLE h, BACNET_SC_VMAC_ADDRESS *vmac)
+{
+    BSC_HUB_FUNCTION *f = (BSC_HUB_FUNCTION *)h;
+    BSC_SOCKET *c;
+    uint32_t ret = 0;
+
+    if (f && vmac) {
+        bws_dispatch_lock();
+        c = hub_function_find_connection_for_vmac(vmac, f);
+        if (c) {
+            ret = f->tx_dropped[c - &f->sock[0]];
+        }
+        bws_dispatch_unlock();
+    }
+
+    return ret;
+}
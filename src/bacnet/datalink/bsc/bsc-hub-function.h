@@ -59,4 +59,8 @@ bool bsc_hub_function_stopped(BSC_HUB_FUNCTION_HANDLE h);
 BACNET_STACK_EXPORT
 bool bsc_hub_function_started(BSC_HUB_FUNCTION_HANDLE h);
 
+BACNET_STACK_EXPORT
+uint32_t bsc_hub_function_tx_dropped(
+    BSC_HUB_FUNCTION_HANDLE h, BACNET_SC_VMAC_ADDRESS *vmac);
+
 #endif
@@ -14,7 +14,10 @@ typedef enum {
     BSC_SC_SUCCESS = 0,
     BSC_SC_NO_RESOURCES = 1,
     BSC_SC_BAD_PARAM = 2,
-    BSC_SC_INVALID_OPERATION = 3
+    BSC_SC_INVALID_OPERATION = 3,
+    /* the TX buffer of the socket is above its high watermark,
+       the PDU can be sent again later */
+    BSC_SC_WOULD_BLOCK = 4
 } BSC_SC_RET;
 
 #endif
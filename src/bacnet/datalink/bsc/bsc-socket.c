@@ -50,6 +50,12 @@ static BVLC_SC_DECODED_MESSAGE bsc_dm = { 0 };
             BSC_CONF_TX_PRE)                                        \
          : 0)
 
+#define TX_BUF_HIGH_WATERMARK \
+    ((BSC_TX_BUFFER_SIZE / 100) * BSC_CONF_SOCK_TX_HIGH_WATERMARK)
+
+#define TX_BUF_LOW_WATERMARK \
+    ((BSC_TX_BUFFER_SIZE / 100) * BSC_CONF_SOCK_TX_LOW_WATERMARK)
+
 /**
  * @brief Add the socket context to the list
  * @param ctx - pointer to the socket context
@@ -91,6 +97,7 @@ static void bsc_reset_socket(BSC_SOCKET *c)
     memset(&c->vmac, 0, sizeof(c->vmac));
     memset(&c->uuid, 0, sizeof(c->uuid));
     c->tx_buf_size = 0;
+    c->tx_blocked = false;
 }
 
 /**
@@ -1206,6 +1213,9 @@ static void bsc_dispatch_srv_func(
             }
         }
 
+        if (c->tx_buf_size <= TX_BUF_LOW_WATERMARK) {
+            c->tx_blocked = false;
+        }
         if (!failed) {
             if (c->state == BSC_SOCK_STATE_ERROR_FLUSH_TX) {
                 bsc_srv_process_error(c, c->reason);
@@ -1469,6 +1479,9 @@ static void bsc_dispatch_cli_func(
                 p += pdu_len + sizeof(pdu_len) + BSC_CONF_TX_PRE;
             }
         }
+        if (c->tx_buf_size <= TX_BUF_LOW_WATERMARK) {
+            c->tx_blocked = false;
+        }
         if (!failed) {
             if (c->state == BSC_SOCK_STATE_ERROR_FLUSH_TX) {
                 bsc_cli_process_error(c, c->reason);
@@ -1653,6 +1666,7 @@ BSC_SC_RET bsc_connect(BSC_SOCKET_CTX *ctx, BSC_SOCKET *c, char *url)
             c->ctx = ctx;
             c->state = BSC_SOCK_STATE_AWAITING_WEBSOCKET;
             c->tx_buf_size = 0;
+            c->tx_blocked = false;
 
             wret = bws_cli_connect(
                 ctx->cfg->proto, url, ctx->cfg->ca_cert_chain,
@@ -1728,6 +1742,38 @@ void bsc_disconnect(BSC_SOCKET *c)
     DEBUG_PRINTF("bsc_disconnect() <<<\n");
 }
 
+/**
+ * @brief Queue a PDU in the TX buffer of a connected socket and wake up
+ *  the websocket layer to send it.
+ * @param c - pointer to the socket
+ * @param pdu - pointer to the PDU
+ * @param pdu_len - PDU length
+ * @return BSC_SC_SUCCESS if the PDU was queued, BSC_SC_NO_RESOURCES if the
+ *  PDU is larger than a packet of the TX buffer, or BSC_SC_WOULD_BLOCK if
+ *  the TX buffer is above its high watermark or has no room for the PDU
+ */
+static BSC_SC_RET bsc_tx_queue(BSC_SOCKET *c, uint8_t *pdu, size_t pdu_len)
+{
+    if (pdu_len > BVLC_SC_NPDU_SIZE_CONF) {
+        return BSC_SC_NO_RESOURCES;
+    }
+    if (c->tx_blocked || TX_BUF_BYTES_AVAIL(c) < pdu_len) {
+        return BSC_SC_WOULD_BLOCK;
+    }
+    memcpy(TX_BUF_PTR(c), pdu, pdu_len);
+    TX_BUF_UPDATE(c, pdu_len);
+    if (c->tx_buf_size > TX_BUF_HIGH_WATERMARK) {
+        c->tx_blocked = true;
+    }
+    if (c->ctx->cfg->type == BSC_SOCKET_CTX_INITIATOR) {
+        bws_cli_send(c->wh);
+    } else {
+        bws_srv_send(c->ctx->sh, c->wh);
+    }
+
+    return BSC_SC_SUCCESS;
+}
+
 /**
  * @brief Send the BACnet Secure Connect PDU
  * @param c - pointer to the socket
@@ -1751,17 +1797,7 @@ BSC_SC_RET bsc_send(BSC_SOCKET *c, uint8_t *pdu, size_t pdu_len)
             c->state != BSC_SOCK_STATE_CONNECTED) {
             ret = BSC_SC_INVALID_OPERATION;
         } else {
-            if (TX_BUF_BYTES_AVAIL(c) < pdu_len) {
-                ret = BSC_SC_NO_RESOURCES;
-            } else {
-                memcpy(TX_BUF_PTR(c), pdu, pdu_len);
-                TX_BUF_UPDATE(c, pdu_len);
-                if (c->ctx->cfg->type == BSC_SOCKET_CTX_INITIATOR) {
-                    bws_cli_send(c->wh);
-                } else {
-                    bws_srv_send(c->ctx->sh, c->wh);
-                }
-            }
+            ret = bsc_tx_queue(c, pdu, pdu_len);
         }
 
         bws_dispatch_unlock();
@@ -1771,6 +1807,87 @@ BSC_SC_RET bsc_send(BSC_SOCKET *c, uint8_t *pdu, size_t pdu_len)
     return ret;
 }
 
+/**
+ * @brief Queue one encoded PDU for sending on each connected socket of
+ *  a set. The PDU is validated and the dispatch lock is taken once for
+ *  the whole set, and a socket without space in its transmit buffer is
+ *  skipped without affecting the others.
+ * @param sock - array of sockets
+ * @param sock_num - number of sockets in the array
+ * @param exclude - socket to skip, usually the originator, or NULL
+ * @param pdu - pointer to the data to send
+ * @param pdu_len - size in bytes of the data to send
+ * @param result - optional array of sock_num entries which receives the
+ *  status of each socket: BSC_SC_SUCCESS if the PDU was queued,
+ *  BSC_SC_WOULD_BLOCK if the socket has a full transmit buffer,
+ *  BSC_SC_NO_RESOURCES if the PDU is too large, or
+ *  BSC_SC_INVALID_OPERATION if the socket was skipped or not connected
+ * @return number of sockets the PDU was queued on
+ */
+size_t bsc_send_broadcast(
+    BSC_SOCKET *sock,
+    size_t sock_num,
+    BSC_SOCKET *exclude,
+    uint8_t *pdu,
+    size_t pdu_len,
+    BSC_SC_RET *result)
+{
+    size_t i;
+    size_t count = 0;
+    BSC_SOCKET *c;
+    BSC_SC_RET ret;
+
+    DEBUG_PRINTF(
+        "bsc_send_broadcast() >>> sock = %p, sock_num = %lu, pdu = %p, "
+        "pdu_len = %lu\n",
+        sock, (unsigned long)sock_num, pdu, (unsigned long)pdu_len);
+
+    if (!sock || !pdu || !pdu_len) {
+        DEBUG_PRINTF("bsc_send_broadcast() <<< count = 0\n");
+        return 0;
+    }
+    bws_dispatch_lock();
+    for (i = 0; i < sock_num; i++) {
+        c = &sock[i];
+        if (c == exclude || c->state != BSC_SOCK_STATE_CONNECTED ||
+            c->ctx->state != BSC_CTX_STATE_INITIALIZED) {
+            ret = BSC_SC_INVALID_OPERATION;
+        } else {
+            ret = bsc_tx_queue(c, pdu, pdu_len);
+            if (ret == BSC_SC_SUCCESS) {
+                count++;
+            }
+        }
+        if (result) {
+            result[i] = ret;
+        }
+    }
+    bws_dispatch_unlock();
+
+    DEBUG_PRINTF(
+        "bsc_send_broadcast() <<< count = %lu\n", (unsigned long)count);
+    return count;
+}
+
+/**
+ * @brief Check if a socket refuses PDUs because its TX buffer was filled
+ *  above the high watermark and has not yet drained to the low watermark
+ * @param c - pointer to the socket
+ * @return true if bsc_send() would return BSC_SC_WOULD_BLOCK
+ */
+bool bsc_socket_tx_blocked(BSC_SOCKET *c)
+{
+    bool ret = false;
+
+    if (c) {
+        bws_dispatch_lock();
+        ret = c->tx_blocked;
+        bws_dispatch_unlock();
+    }
+
+    return ret;
+}
+
 /**
  * @brief Get the next message ID
  * @return uint16_t - message ID
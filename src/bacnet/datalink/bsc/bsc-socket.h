@@ -104,6 +104,9 @@ struct BSC_Socket {
 
     uint8_t tx_buf[BSC_TX_BUFFER_SIZE];
     size_t tx_buf_size;
+    /* set when tx_buf is filled above the high watermark, and cleared
+       when it is drained down to the low watermark */
+    bool tx_blocked;
 };
 
 struct BSC_ContextCFG {
@@ -271,13 +274,50 @@ void bsc_disconnect(BSC_SOCKET *c);
              or disconnect operation is in progress using
              bsc_disconnect() or bsc_deinit_ctx().
  *    BSC_SC_SUCCESS - operation has succeeded.
- *    BSC_SC_NO_RESOURCES - there are not resources (memory, etc.. )
- *                          to send data
+ *    BSC_SC_NO_RESOURCES - the data is larger than a packet of the
+ *                          transmit buffer and can never be sent.
+ *    BSC_SC_WOULD_BLOCK - the transmit buffer is above its high watermark
+ *                          or has no room for the data, the data can be
+ *                          sent again once the peer has caught up.
  */
 
 BACNET_STACK_EXPORT
 BSC_SC_RET bsc_send(BSC_SOCKET *c, uint8_t *pdu, size_t pdu_len);
 
+BACNET_STACK_EXPORT
+bool bsc_socket_tx_blocked(BSC_SOCKET *c);
+
+/**
+ * @brief  bsc_send_broadcast() function queues one already encoded PDU
+ *         on every connected socket of an array except one, taking the
+ *         dispatch lock once for the whole array. A socket whose transmit
+ *         buffer is full is reported in result[] and does not stop the
+ *         PDU from being queued on the other sockets.
+ *
+ * @param sock - array of BACNet socket descriptors.
+ * @param sock_num - number of sockets in the array.
+ * @param exclude - socket to skip (usually the originator), or NULL.
+ * @param pdu - pointer to a data to send.
+ * @param pdu_len - size in bytes of data to send.
+ * @param result - optional array of sock_num status codes:
+ *    BSC_SC_SUCCESS - the data was queued on the socket.
+ *    BSC_SC_NO_RESOURCES - the data is too large for the socket.
+ *    BSC_SC_WOULD_BLOCK - the transmit buffer of the socket is full.
+ *    BSC_SC_INVALID_OPERATION - the socket was excluded or is not
+ *                          in opened state.
+ *
+ * @return number of sockets the data was queued on.
+ */
+
+BACNET_STACK_EXPORT
+size_t bsc_send_broadcast(
+    BSC_SOCKET *sock,
+    size_t sock_num,
+    BSC_SOCKET *exclude,
+    uint8_t *pdu,
+    size_t pdu_len,
+    BSC_SC_RET *result);
+
 BACNET_STACK_EXPORT
 uint16_t bsc_get_next_message_id(void);
 
@@ -36,6 +36,25 @@
 
 /** @} */
 
+/**
+ * Largest number of service threads of each websocket server instance.
+ *  With more than one thread the connections of a server are shared between
+ *  the threads, so TLS decryption and websocket framing of the data received
+ *  on different connections run in parallel. Only the receive side runs in
+ *  parallel: the BACnet/SC handling and the sends of all connections are
+ *  serialized by the dispatch lock. libwebsockets must be built with
+ *  LWS_MAX_SMP greater than or equal to that value, otherwise the number of
+ *  threads is reduced to LWS_MAX_SMP. The number of threads of the servers
+ *  started next can be lowered by bws_srv_set_threads_num().
+ * @{
+ */
+
+#ifndef BSC_CONF_WEBSOCKET_SERVER_THREADS_NUM
+#define BSC_CONF_WEBSOCKET_SERVER_THREADS_NUM 1
+#endif
+
+/** @} */
+
 /** @} */
 
 /**
@@ -250,6 +269,17 @@ void bws_cli_send(BSC_WEBSOCKET_HANDLE h);
 BSC_WEBSOCKET_RET bws_cli_dispatch_send(
     BSC_WEBSOCKET_HANDLE h, uint8_t *payload, size_t payload_size);
 
+/**
+ * @brief bws_srv_set_threads_num() function sets the number of service
+ * threads of the websocket servers which are started afterwards. A port
+ * which services its servers from one thread ignores the value.
+ *
+ * @param threads_num - number of service threads, from 1 to
+ *                      BSC_CONF_WEBSOCKET_SERVER_THREADS_NUM.
+ */
+
+void bws_srv_set_threads_num(int threads_num);
+
 /**
  * @brief Asynchronous bws_srv_start() function triggers process of
  * starting of a websocket server on a specified port for specified
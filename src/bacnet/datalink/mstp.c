@@ -559,10 +559,11 @@ void MSTP_Receive_Frame_FSM(struct mstp_port_struct_t *mstp_port)
                     if (((mstp_port->Index + 1) < mstp_port->InputBufferSize) &&
                         (mstp_port->FrameType >= Nmin_COBS_type) &&
                         (mstp_port->FrameType <= Nmax_COBS_type)) {
+                        /* decode in place, so the client data starts
+                           at the beginning of the InputBuffer */
                         mstp_port->DataLength = cobs_frame_decode(
-                            &mstp_port->InputBuffer[mstp_port->Index + 1],
-                            mstp_port->InputBufferSize, mstp_port->InputBuffer,
-                            mstp_port->Index + 1);
+                            mstp_port->InputBuffer, mstp_port->InputBufferSize,
+                            mstp_port->InputBuffer, mstp_port->Index + 1);
                         if ((mstp_port->DataLength > 0) &&
                             (mstp_port->receive_state ==
                              MSTP_RECEIVE_STATE_DATA)) {
@@ -803,6 +804,7 @@ bool MSTP_Master_Node_FSM(struct mstp_port_struct_t *mstp_port)
                 mstp_port->FrameCount++;
                 switch (frame_type) {
                     case FRAME_TYPE_BACNET_DATA_EXPECTING_REPLY:
+                    case FRAME_TYPE_BACNET_EXTENDED_DATA_EXPECTING_REPLY:
                         if (destination == MSTP_BROADCAST_ADDRESS) {
                             /* SendNoWait */
                             mstp_port->master_state =
@@ -865,6 +867,7 @@ bool MSTP_Master_Node_FSM(struct mstp_port_struct_t *mstp_port)
                                     MSTP_MASTER_STATE_DONE_WITH_TOKEN;
                                 break;
                             case FRAME_TYPE_BACNET_DATA_NOT_EXPECTING_REPLY:
+                            case FRAME_TYPE_BACNET_EXTENDED_DATA_NOT_EXPECTING_REPLY:
                                 /* ReceivedReply */
                                 /* or a proprietary type that indicates a reply
                                  */
@@ -190,3 +190,138 @@ unsigned indtext_count(INDTEXT_DATA *data_list)
     }
     return count;
 }
+
+/**
+ * @brief Build the sorted views of an index and text pairs list.
+ *  Both views are sorted with a stable insertion sort, so that entries
+ *  with duplicate text or duplicate index stay in list order, and a
+ *  lookup returns the same first match as the linear search.
+ * @param index_data - sorted views of a list of strings and indices
+ */
+void indtext_index_init(INDTEXT_INDEX *index_data)
+{
+    INDTEXT_DATA *data_list;
+    unsigned count, i, j;
+    uint16_t position;
+
+    if (!index_data || !index_data->data_list || !index_data->name_order ||
+        !index_data->index_order) {
+        return;
+    }
+    data_list = index_data->data_list;
+    count = indtext_count(data_list);
+    if (count > UINT16_MAX) {
+        count = UINT16_MAX;
+    }
+    for (i = 0; i < count; i++) {
+        position = (uint16_t)i;
+        j = i;
+        while ((j > 0) &&
+               (bacnet_stricmp(
+                    data_list[index_data->name_order[j - 1]].pString,
+                    data_list[position].pString) > 0)) {
+            index_data->name_order[j] = index_data->name_order[j - 1];
+            j--;
+        }
+        index_data->name_order[j] = position;
+        j = i;
+        while ((j > 0) &&
+               (data_list[index_data->index_order[j - 1]].index >
+                data_list[position].index)) {
+            index_data->index_order[j] = index_data->index_order[j - 1];
+            j--;
+        }
+        index_data->index_order[j] = position;
+    }
+    index_data->count = (uint16_t)count;
+    index_data->valid = true;
+}
+
+/**
+ * @brief Search a list of strings to find a matching string, case
+ *  insensitive, using a binary search of its sorted views, or a linear
+ *  search of the list until the views are built
+ * @param index_data - sorted views of a list of strings and indices
+ * @param search_name - string to search for
+ * @param found_index - index of the string found
+ * @return true if the string is found
+ */
+bool indtext_index_by_istring(
+    INDTEXT_INDEX *index_data, const char *search_name, unsigned *found_index)
+{
+    INDTEXT_DATA *data;
+    unsigned low = 0, high, middle;
+
+    if (!index_data || !search_name) {
+        return false;
+    }
+    if (!index_data->valid) {
+        return indtext_by_istring(
+            index_data->data_list, search_name, found_index);
+    }
+    /* lower bound, to find the first of any duplicates */
+    high = index_data->count;
+    while (low < high) {
+        middle = low + (high - low) / 2;
+        data = &index_data->data_list[index_data->name_order[middle]];
+        if (bacnet_stricmp(data->pString, search_name) < 0) {
+            low = middle + 1;
+        } else {
+            high = middle;
+        }
+    }
+    if (low < index_data->count) {
+        data = &index_data->data_list[index_data->name_order[low]];
+        if (bacnet_stricmp(data->pString, search_name) == 0) {
+            if (found_index) {
+                *found_index = data->index;
+            }
+            return true;
+        }
+    }
+
+    return false;
+}
+
+/**
+ * @brief Return the string for a given index, or a default string,
+ *  using a binary search of its sorted views, or a linear search of
+ *  the list until the views are built
+ * @param index_data - sorted views of a list of strings and indices
+ * @param index - index to search for
+ * @param default_name - string to return if the index is not found
+ * @return the string found, or the default string
+ */
+const char *indtext_index_by_index_default(
+    INDTEXT_INDEX *index_data, unsigned index, const char *default_name)
+{
+    INDTEXT_DATA *data;
+    unsigned low = 0, high, middle;
+
+    if (!index_data) {
+        return default_name;
+    }
+    if (!index_data->valid) {
+        return indtext_by_index_default(
+            index_data->data_list, index, default_name);
+    }
+    /* lower bound, to find the first of any duplicates */
+    high = index_data->count;
+    while (low < high) {
+        middle = low + (high - low) / 2;
+        data = &index_data->data_list[index_data->index_order[middle]];
+        if (data->index < index) {
+            low = middle + 1;
+        } else {
+            high = middle;
+        }
+    }
+    if (low < index_data->count) {
+        data = &index_data->data_list[index_data->index_order[low]];
+        if (data->index == index) {
+            return data->pString;
+        }
+    }
+
+    return default_name;
+}
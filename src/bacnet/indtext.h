@@ -20,6 +20,18 @@ typedef const struct {
     const char *pString; /* text pair - use NULL to end the list */
 } INDTEXT_DATA;
 
+/* sorted views of an index and text pairs list, for binary search.
+   The order arrays are provided by the caller, and must hold at least
+   as many elements as the list.  The views are built by
+   indtext_index_init(), and lookups use a linear search until then. */
+typedef struct indtext_index {
+    INDTEXT_DATA *data_list; /* index and text pairs list */
+    uint16_t *name_order; /* list positions sorted by case insensitive text */
+    uint16_t *index_order; /* list positions sorted by index */
+    uint16_t count; /* number of elements in the list */
+    bool valid; /* true when the sorted views are built */
+} INDTEXT_INDEX;
+
 #ifdef __cplusplus
 extern "C" {
 #endif /* __cplusplus */
@@ -70,6 +82,16 @@ const char *indtext_by_index_split_default(
 BACNET_STACK_EXPORT
 unsigned indtext_count(INDTEXT_DATA *data_list);
 
+/* sorted lookups - same results as the linear versions above */
+BACNET_STACK_EXPORT
+void indtext_index_init(INDTEXT_INDEX *index_data);
+BACNET_STACK_EXPORT
+bool indtext_index_by_istring(
+    INDTEXT_INDEX *index_data, const char *search_name, unsigned *found_index);
+BACNET_STACK_EXPORT
+const char *indtext_index_by_index_default(
+    INDTEXT_INDEX *index_data, unsigned index, const char *default_name);
+
 #ifdef __cplusplus
 }
 #endif /* __cplusplus */
@@ -3190,17 +3190,116 @@ unsigned property_list_special_count(
 }
 #endif
 
+/* These lists are the properties required to be writable,
+   Property Conformance Code of W */
+static const int Default_Properties_Writable[] = {
+    /* unordered list of properties */
+    -1
+};
+
+static const int Commandable_Properties_Writable[] = {
+    /* unordered list of properties */
+    PROP_PRESENT_VALUE, -1
+};
+
+static const int Averaging_Properties_Writable[] = {
+    /* unordered list of properties */
+    PROP_ATTEMPTED_SAMPLES, PROP_WINDOW_INTERVAL, PROP_WINDOW_SAMPLES, -1
+};
+
+static const int File_Properties_Writable[] = {
+    /* unordered list of properties */
+    PROP_ARCHIVE, -1
+};
+
+static const int Life_Safety_Properties_Writable[] = {
+    /* unordered list of properties */
+    PROP_MODE, -1
+};
+
+static const int Program_Properties_Writable[] = {
+    /* unordered list of properties */
+    PROP_PROGRAM_CHANGE, -1
+};
+
+static const int Pulse_Converter_Properties_Writable[] = {
+    /* unordered list of properties */
+    PROP_ADJUST_VALUE, -1
+};
+
+static const int Log_Properties_Writable[] = {
+    /* unordered list of properties */
+    PROP_ENABLE, PROP_RECORD_COUNT, -1
+};
+
+static const int Load_Control_Properties_Writable[] = {
+    /* unordered list of properties */
+    PROP_REQUESTED_SHED_LEVEL,
+    PROP_START_TIME,
+    PROP_SHED_DURATION,
+    PROP_DUTY_WINDOW,
+    PROP_SHED_LEVELS,
+    -1
+};
+
+static const int Access_Properties_Writable[] = {
+    /* unordered list of properties */
+    PROP_GLOBAL_IDENTIFIER, -1
+};
+
+static const int Network_Security_Properties_Writable[] = {
+    /* unordered list of properties */
+    PROP_BASE_DEVICE_SECURITY_POLICY,
+    PROP_NETWORK_ACCESS_SECURITY_POLICIES,
+    PROP_SECURITY_TIME_WINDOW,
+    PROP_PACKET_REORDER_TIME,
+    PROP_LAST_KEY_SERVER,
+    PROP_SECURITY_PDU_TIMEOUT,
+    PROP_DO_NOT_HIDE,
+    -1
+};
+
+static const int Notification_Forwarder_Properties_Writable[] = {
+    /* unordered list of properties */
+    PROP_SUBSCRIBED_RECIPIENTS, -1
+};
+
+static const int Channel_Properties_Writable[] = {
+    /* unordered list of properties */
+    PROP_PRESENT_VALUE,
+    PROP_LIST_OF_OBJECT_PROPERTY_REFERENCES,
+    PROP_CHANNEL_NUMBER,
+    PROP_CONTROL_GROUPS,
+    -1
+};
+
+static const int Lighting_Output_Properties_Writable[] = {
+    /* unordered list of properties */
+    PROP_PRESENT_VALUE, PROP_LIGHTING_COMMAND, -1
+};
+
+static const int Audit_Log_Properties_Writable[] = {
+    /* unordered list of properties */
+    PROP_ENABLE, -1
+};
+
+static const int Color_Properties_Writable[] = {
+    /* unordered list of properties */
+    PROP_PRESENT_VALUE, PROP_COLOR_COMMAND, -1
+};
+
 /**
- * @brief Determine if this property is required to be writable
- * @note Property Conformance Code of W means writable
- * @param object_type - object-type to be checked
- * @param object_property - object-property to be checked
- * @return true if the property is a required writable property
+ * Function that returns the list of properties that are required
+ * to be writable in known standard objects.
+ *
+ * @param object_type - enumerated BACNET_OBJECT_TYPE
+ * @return returns a pointer to a '-1' terminated array of
+ * type 'int' that contain BACnet object properties for the given object
+ * type.
  */
-bool property_list_writable_member(
-    BACNET_OBJECT_TYPE object_type, BACNET_PROPERTY_ID object_property)
+const int *property_list_writable(BACNET_OBJECT_TYPE object_type)
 {
-    bool writable = false;
+    const int *pList = NULL;
 
     switch (object_type) {
         case OBJECT_ANALOG_OUTPUT:
@@ -3210,110 +3309,1306 @@ bool property_list_writable_member(
         case OBJECT_ACCESS_DOOR:
         case OBJECT_COMMAND:
         case OBJECT_STAGING:
-            if (object_property == PROP_PRESENT_VALUE) {
-                writable = true;
-            }
+            pList = Commandable_Properties_Writable;
             break;
         case OBJECT_AVERAGING:
-            if ((object_property == PROP_ATTEMPTED_SAMPLES) ||
-                (object_property == PROP_WINDOW_INTERVAL) ||
-                (object_property == PROP_WINDOW_SAMPLES)) {
-                writable = true;
-            }
+            pList = Averaging_Properties_Writable;
             break;
         case OBJECT_FILE:
-            if (object_property == PROP_ARCHIVE) {
-                writable = true;
-            }
+            pList = File_Properties_Writable;
             break;
         case OBJECT_LIFE_SAFETY_POINT:
         case OBJECT_LIFE_SAFETY_ZONE:
-            if (object_property == PROP_MODE) {
-                writable = true;
-            }
+            pList = Life_Safety_Properties_Writable;
             break;
         case OBJECT_PROGRAM:
-            if (object_property == PROP_PROGRAM_CHANGE) {
-                writable = true;
-            }
+            pList = Program_Properties_Writable;
             break;
         case OBJECT_PULSE_CONVERTER:
-            if (object_property == PROP_ADJUST_VALUE) {
-                writable = true;
-            }
+            pList = Pulse_Converter_Properties_Writable;
             break;
         case OBJECT_EVENT_LOG:
         case OBJECT_TRENDLOG:
         case OBJECT_TREND_LOG_MULTIPLE:
-            if ((object_property == PROP_ENABLE) ||
-                (object_property == PROP_RECORD_COUNT)) {
-                writable = true;
-            }
+            pList = Log_Properties_Writable;
             break;
         case OBJECT_LOAD_CONTROL:
-            if ((object_property == PROP_REQUESTED_SHED_LEVEL) ||
-                (object_property == PROP_START_TIME) ||
-                (object_property == PROP_SHED_DURATION) ||
-                (object_property == PROP_DUTY_WINDOW) ||
-                (object_property == PROP_SHED_LEVELS)) {
-                writable = true;
-            }
+            pList = Load_Control_Properties_Writable;
             break;
         case OBJECT_ACCESS_CREDENTIAL:
         case OBJECT_ACCESS_RIGHTS:
         case OBJECT_ACCESS_USER:
         case OBJECT_ACCESS_ZONE:
-            if (object_property == PROP_GLOBAL_IDENTIFIER) {
-                writable = true;
-            }
+            pList = Access_Properties_Writable;
             break;
         case OBJECT_NETWORK_SECURITY:
-            if ((object_property == PROP_BASE_DEVICE_SECURITY_POLICY) ||
-                (object_property == PROP_NETWORK_ACCESS_SECURITY_POLICIES) ||
-                (object_property == PROP_SECURITY_TIME_WINDOW) ||
-                (object_property == PROP_PACKET_REORDER_TIME) ||
-                (object_property == PROP_LAST_KEY_SERVER) ||
-                (object_property == PROP_SECURITY_PDU_TIMEOUT) ||
-                (object_property == PROP_LAST_KEY_SERVER) ||
-                (object_property == PROP_SECURITY_PDU_TIMEOUT) ||
-                (object_property == PROP_DO_NOT_HIDE)) {
-                writable = true;
-            }
+            pList = Network_Security_Properties_Writable;
             break;
         case OBJECT_NOTIFICATION_FORWARDER:
-            if (object_property == PROP_SUBSCRIBED_RECIPIENTS) {
-                writable = true;
-            }
+            pList = Notification_Forwarder_Properties_Writable;
             break;
         case OBJECT_CHANNEL:
-            if ((object_property == PROP_PRESENT_VALUE) ||
-                (object_property == PROP_LIST_OF_OBJECT_PROPERTY_REFERENCES) ||
-                (object_property == PROP_CHANNEL_NUMBER) ||
-                (object_property == PROP_CONTROL_GROUPS)) {
-                writable = true;
-            }
+            pList = Channel_Properties_Writable;
             break;
         case OBJECT_LIGHTING_OUTPUT:
-            if ((object_property == PROP_PRESENT_VALUE) ||
-                (object_property == PROP_LIGHTING_COMMAND)) {
-                writable = true;
-            }
+            pList = Lighting_Output_Properties_Writable;
             break;
         case OBJECT_AUDIT_LOG:
-            if (object_property == PROP_ENABLE) {
-                writable = true;
-            }
+            pList = Audit_Log_Properties_Writable;
             break;
         case OBJECT_COLOR:
         case OBJECT_COLOR_TEMPERATURE:
-            if ((object_property == PROP_PRESENT_VALUE) ||
-                (object_property == PROP_COLOR_COMMAND)) {
-                writable = true;
-            }
+            pList = Color_Properties_Writable;
             break;
         default:
+            pList = Default_Properties_Writable;
             break;
     }
 
-    return writable;
+    return pList;
+}
+
+/* GENERATED PROPERTY BITMAPS BEGIN */
+/* Do not edit: generated from the property lists above by
+   tools/property-bitmap/property_bitmap.py */
+/* clang-format off */
+#define PROPERTY_BITMAP_BITS 512
+#define PROPERTY_BITMAP_WORDS (PROPERTY_BITMAP_BITS / 32)
+
+#if BACNET_PROPERTY_LISTS
+static const uint32_t Property_List_Bitmap[][PROPERTY_BITMAP_WORDS] = {
+    /* 0: Default_Properties_Required */
+    {
+        0x00000000UL, 0x00000000UL, 0x0000A800UL, 0x00000000UL,
+        0x00000000UL, 0x00000000UL, 0x00000000UL, 0x00000000UL,
+        0x00000000UL, 0x00000000UL, 0x00000000UL, 0x00000000UL,
+        0x00000000UL, 0x00000000UL, 0x00000000UL, 0x00000000UL,
+    },
+    /* 1: Analog_Input_Properties_Required, Analog_Value_Properties_Required */
+    {
+        0x00000000UL, 0x00000010UL, 0x0022A800UL, 0x00208000UL,
+        0x00000000UL, 0x00000000UL, 0x00000000UL, 0x00000000UL,
+        0x00000000UL, 0x00000000UL, 0x00000000UL, 0x00000000UL,
+        0x00000000UL, 0x00000000UL, 0x00000000UL, 0x00000000UL,
+    },
+    /* 2: Analog_Output_Properties_Required */
+    {
+        0x00000000UL, 0x00000010UL, 0x00A2A800UL, 0x00208100UL,
+        0x00000000UL, 0x00000000UL, 0x00000000UL, 0x00000000UL,
+        0x00000000UL, 0x00000000UL, 0x00000000UL, 0x00000000UL,
+        0x00000000UL,
+#if (BACNET_PROTOCOL_REVISION >= 17)
+        0x00008000UL,
+#else
+        0x00000000UL,
+#endif
+        0x00000000UL, 0x00000000UL,
+    },
+    /* 3: Binary_Input_Properties_Required */
+    {
+        0x00000000UL, 0x00000010UL, 0x0032A800UL, 0x00008000UL,
+        0x00000000UL, 0x00000000UL, 0x00000000UL, 0x00000000UL,
+        0x00000000UL, 0x00000000UL, 0x00000000UL, 0x00000000UL,
+        0x00000000UL, 0x00000000UL, 0x00000000UL, 0x00000000UL,
+    },
+    /* 4: Binary_Output_Properties_Required */
+    {
+        0x00000000UL, 0x00000010UL, 0x00B2A800UL, 0x00008100UL,
+        0x00000000UL, 0x00000000UL, 0x00000000UL, 0x00000000UL,
+        0x00000000UL, 0x00000000UL, 0x00000000UL, 0x00000000UL,
+        0x00000000UL,
+#if (BACNET_PROTOCOL_REVISION >= 17)
+        0x00008000UL,
+#else
+        0x00000000UL,
+#endif
+        0x00000000UL, 0x00000000UL,
+    },
+    /* 5: Binary_Value_Properties_Required */
+    {
+        0x00000000UL, 0x00000010UL, 0x0022A800UL, 0x00008000UL,
+        0x00000000UL, 0x00000000UL, 0x00000000UL, 0x00000000UL,
+        0x00000000UL, 0x00000000UL, 0x00000000UL, 0x00000000UL,
+        0x00000000UL, 0x00000000UL, 0x00000000UL, 0x00000000UL,
+    },
+    /* 6: Calendar_Properties_Required */
+    {
+        0x00800000UL, 0x00000000UL, 0x0020A800UL, 0x00000000UL,
+        0x00000000UL, 0x00000000UL, 0x00000000UL, 0x00000000UL,
+        0x00000000UL, 0x00000000UL, 0x00000000UL, 0x00000000UL,
+        0x00000000UL, 0x00000000UL, 0x00000000UL, 0x00000000UL,
+    },
+    /* 7: Command_Properties_Required */
+    {
+        0x00000204UL, 0x00008000UL, 0x0020A800UL, 0x00000000UL,
+        0x00000000UL, 0x00000000UL, 0x00000000UL, 0x00000000UL,
+        0x00000000UL, 0x00000000UL, 0x00000000UL, 0x00000000UL,
+        0x00000000UL, 0x00000000UL, 0x00000000UL, 0x00000000UL,
+    },
+    /* 8: Device_Properties_Required */
+    {
+        0x40001800UL, 0x40001000UL, 0x0000BA40UL, 0x03010807UL,
+        0x08000800UL, 0x00000000UL, 0x00000000UL, 0x00000000UL,
+        0x00000000UL, 0x00000000UL, 0x00000000UL, 0x00000000UL,
+        0x00000000UL, 0x00000000UL, 0x00000000UL, 0x00000000UL,
+    },
+    /* 9: Event_Enrollment_Properties_Required */
+    {
+        0x00020001UL, 0x00000038UL, 0x0008E900UL, 0x00008080UL,
+        0x00000004UL, 0x00000000UL, 0x00000000UL, 0x00000000UL,
+        0x00000000UL, 0x00000000UL, 0x00000000UL, 0x00000002UL,
+        0x00000000UL, 0x00000000UL, 0x00000000UL, 0x00000000UL,
+    },
+    /* 10: File_Properties_Required */
+    {
+        0x00002000UL, 0x00000E00UL, 0x0000A880UL, 0x00000008UL,
+        0x00000000UL, 0x00000000UL, 0x00000000UL, 0x00000000UL,
+        0x00000000UL, 0x00000000UL, 0x00000000UL, 0x00000000UL,
+        0x00000000UL, 0x00000000UL, 0x00000000UL, 0x00000000UL,
+    },
+    /* 11: Group_Properties_Required */
+    {
+        0x00000000UL, 0x00200000UL, 0x0020A800UL, 0x00000000UL,
+        0x00000000UL, 0x00000000UL, 0x00000000UL, 0x00000000UL,
+        0x00000000UL, 0x00000000UL, 0x00000000UL, 0x00000000UL,
+        0x00000000UL, 0x00000000UL, 0x00000000UL, 0x00000000UL,
+    },
+    /* 12: Loop_Properties_Required */
+    {
+        0x00380004UL, 0x10000010UL, 0x0126A800UL, 0x0000B000UL,
+        0x00000000UL, 0x00000000UL, 0x00000000UL, 0x00000000UL,
+        0x00000000UL, 0x00000000UL, 0x00000000UL, 0x00000000UL,
+        0x00000000UL, 0x00000000UL, 0x00000000UL, 0x00000000UL,
+    },
+    /* 13: Multistate_Input_Properties_Required,
+       Multistate_Value_Properties_Required */
+    {
+        0x00000000UL, 0x00000010UL, 0x0022AC00UL, 0x00008000UL,
+        0x00000000UL, 0x00000000UL, 0x00000000UL, 0x00000000UL,
+        0x00000000UL, 0x00000000UL, 0x00000000UL, 0x00000000UL,
+        0x00000000UL, 0x00000000UL, 0x00000000UL, 0x00000000UL,
+    },
+    /* 14: Multistate_Output_Properties_Required */
+    {
+        0x00000000UL, 0x00000010UL, 0x00A2AC00UL, 0x00008100UL,
+        0x00000000UL, 0x00000000UL, 0x00000000UL, 0x00000000UL,
+        0x00000000UL, 0x00000000UL, 0x00000000UL, 0x00000000UL,
+        0x00000000UL,
+#if (BACNET_PROTOCOL_REVISION >= 17)
+        0x00008000UL,
+#else
+        0x00000000UL,
+#endif
+        0x00000000UL, 0x00000000UL,
+    },
+    /* 15: Notification_Class_Properties_Required */
+    {
+        0x00020002UL, 0x00000000UL, 0x0040A800UL, 0x00000040UL,
+        0x00000000UL, 0x00000000UL, 0x00000000UL, 0x00000000UL,
+        0x00000000UL, 0x00000000UL, 0x00000000UL, 0x00000000UL,
+        0x00000000UL, 0x00000000UL, 0x00000000UL, 0x00000000UL,
+    },
+    /* 16: Program_Properties_Required */
+    {
+        0x00000000UL, 0x00000000UL, 0x1402A800UL, 0x00008000UL,
+        0x00000000UL, 0x00000000UL, 0x00000000UL, 0x00000000UL,
+        0x00000000UL, 0x00000000UL, 0x00000000UL, 0x00000000UL,
+        0x00000000UL, 0x00000000UL, 0x00000000UL, 0x00000000UL,
+    },
+    /* 17: Schedule_Properties_Required */
+    {
+        0x00000000UL, 0x00400001UL, 0x0122A800UL, 0x00008080UL,
+        0x00000000UL, 0x00004000UL, 0x00000000UL, 0x00000000UL,
+        0x00000000UL, 0x00000000UL, 0x00000000UL, 0x00000000UL,
+        0x00000000UL, 0x00000000UL, 0x00000000UL, 0x00000000UL,
+    },
+    /* 18: Averaging_Properties_Required */
+    {
+        0x00000000UL, 0x00000000UL, 0x0000E800UL, 0x30000000UL,
+        0x001C0180UL, 0x00000000UL, 0x00000000UL, 0x00000000UL,
+        0x00000000UL, 0x00000000UL, 0x00000000UL, 0x00000000UL,
+        0x00000000UL, 0x00000000UL, 0x00000000UL, 0x00000000UL,
+    },
+    /* 19: Trend_Log_Properties_Required */
+    {
+        0x00000000UL, 0x00000010UL, 0x0000A800UL, 0x40008000UL,
+        0x00032028UL, 0x00000000UL, 0x00000020UL, 0x00000000UL,
+        0x00000000UL, 0x00000000UL, 0x00000000UL, 0x00000000UL,
+        0x00000000UL, 0x00000000UL, 0x00000000UL, 0x00000000UL,
+    },
+    /* 20: Life_Safety_Point_Properties_Required */
+    {
+        0x00000000UL, 0x00000010UL, 0x0022A800UL, 0x00008080UL,
+        0x00000000UL, 0x0000801BUL, 0x00000000UL, 0x00000000UL,
+        0x00000000UL, 0x00000000UL, 0x00000000UL, 0x00000000UL,
+        0x00000000UL, 0x00000000UL, 0x00000000UL, 0x00000000UL,
+    },
+    /* 21: Life_Safety_Zone_Properties_Required */
+    {
+        0x00000000UL, 0x00000010UL, 0x0022A800UL, 0x00008080UL,
+        0x00000000UL, 0x0000803BUL, 0x00000000UL, 0x00000000UL,
+        0x00000000UL, 0x00000000UL, 0x00000000UL, 0x00000000UL,
+        0x00000000UL, 0x00000000UL, 0x00000000UL, 0x00000000UL,
+    },
+    /* 22: Accumulator_Properties_Required */
+    {
+        0x00000000UL, 0x00000010UL, 0x0022A802UL, 0x00208000UL,
+        0x00000000UL, 0x08000000UL, 0x00000000UL, 0x00000000UL,
+        0x00000000UL, 0x00000000UL, 0x00000000UL, 0x00000000UL,
+        0x00000000UL, 0x00000000UL, 0x00000000UL, 0x00000000UL,
+    },
+    /* 23: Pulse_Converter_Properties_Required */
+    {
+        0x00000000UL, 0x00000010UL, 0x0022A800UL, 0x00208000UL,
+        0x00000000UL, 0x300F0000UL, 0x00000000UL, 0x00000000UL,
+        0x00000000UL, 0x00000000UL, 0x00000000UL, 0x00000000UL,
+        0x00000000UL, 0x00000000UL, 0x00000000UL, 0x00000000UL,
+    },
+    /* 24: Event_Log_Properties_Required */
+    {
+        0x00000000UL, 0x00000010UL, 0x0000A800UL, 0x40008000UL,
+        0x00032028UL, 0x00000000UL, 0x00000000UL, 0x00000000UL,
+        0x00000000UL, 0x00000000UL, 0x00000000UL, 0x00000000UL,
+        0x00000000UL, 0x00000000UL, 0x00000000UL, 0x00000000UL,
+    },
+    /* 25: Global_Group_Properties_Required */
+    {
+        0x00000000UL, 0x00000010UL, 0x0022A800UL, 0x00008000UL,
+        0x00000000UL, 0x00000000UL, 0x00000000UL, 0x00000000UL,
+        0x00000000UL, 0x00000000UL, 0x0A000000UL, 0x00000000UL,
+        0x00000000UL, 0x00000000UL, 0x00000000UL, 0x00000000UL,
+    },
+    /* 26: Trend_Log_Multiple_Properties_Required */
+    {
+        0x00000000UL, 0x00000010UL, 0x0000A800UL, 0x40008000UL,
+        0x00032078UL, 0x00000000UL, 0x00000020UL, 0x00000000UL,
+        0x00000000UL, 0x00000000UL, 0x00000000UL, 0x00000000UL,
+        0x00000000UL, 0x00000000UL, 0x00000000UL, 0x00000000UL,
+    },
+    /* 27: Load_Control_Properties_Required */
+    {
+        0x00000000UL, 0x00000010UL, 0x0020A800UL, 0x00008000UL,
+        0x00004020UL, 0x00000000UL, 0x3C700000UL, 0x00000000UL,
+        0x00000000UL, 0x00000000UL, 0x00000000UL, 0x00000000UL,
+        0x00000000UL, 0x00000000UL, 0x00000000UL, 0x00000000UL,
+    },
+    /* 28: Structured_View_Properties_Required */
+    {
+        0x00000000UL, 0x00000000UL, 0x0000A800UL, 0x00000000UL,
+        0x00000000UL, 0x00000000UL, 0x00090000UL, 0x00000000UL,
+        0x00000000UL, 0x00000000UL, 0x00000000UL, 0x00000000UL,
+        0x00000000UL, 0x00000000UL, 0x00000000UL, 0x00000000UL,
+    },
+    /* 29: Access_Door_Properties_Required */
+    {
+        0x00000000UL, 0x00000010UL, 0x00A2A800UL, 0x00008180UL,
+        0x00000000UL, 0x00000000UL, 0x00000000UL, 0x00000068UL,
+        0x00000000UL, 0x00000000UL, 0x00000000UL, 0x00000000UL,
+        0x00000000UL, 0x00008000UL, 0x00000000UL, 0x00000000UL,
+    },
+    /* 30: Timer_Properties_Required */
+    {
+        0x00000000UL, 0x00000000UL, 0x0020A800UL, 0x00008000UL,
+        0x00000000UL, 0x00000000UL, 0x00000000UL, 0x00000000UL,
+        0x00000000UL, 0x00000000UL, 0x00000000UL, 0x00000000UL,
+        0x00006000UL, 0x00000000UL, 0x00000000UL, 0x00000000UL,
+    },
+    /* 31: Access_Credential_Properties_Required */
+    {
+        0x00000000UL, 0x00000000UL, 0x0000A800UL, 0x00008080UL,
+        0x00000000UL, 0x00000000UL, 0x00000000UL, 0x40000000UL,
+        0x00004183UL, 0x00008000UL, 0x00000008UL, 0x00000000UL,
+        0x00000000UL, 0x00000000UL, 0x00000000UL, 0x00000000UL,
+    },
+    /* 32: Access_Point_Properties_Required */
+    {
+        0x00000000UL, 0x00000010UL, 0x0102A800UL, 0x00008080UL,
+        0x00000000UL, 0x00000000UL, 0x00000000UL, 0x86C00000UL,
+        0x00000030UL, 0x00000002UL, 0x00000004UL, 0x00000000UL,
+        0x00000000UL, 0x00000000UL, 0x00000000UL, 0x00000000UL,
+    },
+    /* 33: Access_Rights_Properties_Required */
+    {
+        0x00000000UL, 0x00000000UL, 0x0000A800UL, 0x00008080UL,
+        0x00000020UL, 0x00000000UL, 0x00000000UL, 0x00000000UL,
+        0x00000000UL, 0x00004001UL, 0x00000008UL, 0x00000000UL,
+        0x00000000UL, 0x00000000UL, 0x00000000UL, 0x00000000UL,
+    },
+    /* 34: Access_User_Properties_Required */
+    {
+        0x00000000UL, 0x00000000UL, 0x0000A800UL, 0x00008080UL,
+        0x00000000UL, 0x00000000UL, 0x00000000UL, 0x00000000UL,
+        0x00000200UL, 0x40000000UL, 0x00000008UL, 0x00000000UL,
+        0x00000000UL, 0x00000000UL, 0x00000000UL, 0x00000000UL,
+    },
+    /* 35: Access_Zone_Properties_Required */
+    {
+        0x00000000UL, 0x00000010UL, 0x0002A800UL, 0x00008080UL,
+        0x00000000UL, 0x00000000UL, 0x00000000UL, 0x00000000UL,
+        0x00003000UL, 0x00000100UL, 0x00000008UL, 0x00000000UL,
+        0x00000000UL, 0x00000000UL, 0x00000000UL, 0x00000000UL,
+    },
+    /* 36: Credential_Data_Input_Properties_Required */
+    {
+        0x00000000UL, 0x00000000UL, 0x0022A800UL, 0x00008080UL,
+        0x00000000UL, 0x20000000UL, 0x00000000UL, 0x00000000UL,
+        0x00000000UL, 0x00010000UL, 0x00000000UL, 0x00000000UL,
+        0x00000000UL, 0x00000000UL, 0x00000000UL, 0x00000000UL,
+    },
+    /* 37: Network_Security_Properties_Required */
+    {
+        0x00000000UL, 0x00000000UL, 0x0000A800UL, 0x00000000UL,
+        0x00000000UL, 0x00000000UL, 0x00000000UL, 0x00000000UL,
+        0x00000000UL, 0x00000000UL, 0x0003FF80UL, 0x00000000UL,
+        0x00000000UL, 0x00000000UL, 0x00000000UL, 0x00000000UL,
+    },
+    /* 38: BitString_Value_Properties_Required,
+       CharacterString_Value_Properties_Required,
+       Date_Pattern_Value_Properties_Required,
+       Date_Value_Properties_Required,
+       DateTime_Pattern_Value_Properties_Required,
+       DateTime_Value_Properties_Required,
+       OctetString_Value_Properties_Required,
+       Time_Pattern_Value_Properties_Required, Time_Value_Properties_Required */
+    {
+        0x00000000UL, 0x00000000UL, 0x0020A800UL, 0x00008000UL,
+        0x00000000UL, 0x00000000UL, 0x00000000UL, 0x00000000UL,
+        0x00000000UL, 0x00000000UL, 0x00000000UL, 0x00000000UL,
+        0x00000000UL, 0x00000000UL, 0x00000000UL, 0x00000000UL,
+    },
+    /* 39: Integer_Value_Properties_Required,
+       Large_Analog_Value_Properties_Required,
+       Positive_Integer_Value_Properties_Required */
+    {
+        0x00000000UL, 0x00000000UL, 0x0020A800UL, 0x00208000UL,
+        0x00000000UL, 0x00000000UL, 0x00000000UL, 0x00000000UL,
+        0x00000000UL, 0x00000000UL, 0x00000000UL, 0x00000000UL,
+        0x00000000UL, 0x00000000UL, 0x00000000UL, 0x00000000UL,
+    },
+    /* 40: Notification_Forwarder_Properties_Required */
+    {
+        0x00000000UL, 0x00000000UL, 0x0002A800UL, 0x000080C0UL,
+        0x00000000UL, 0x00000000UL, 0x00000000UL, 0x00000000UL,
+        0x00000000UL, 0x00000000UL, 0x00000000UL, 0x00000700UL,
+        0x00000000UL, 0x00000000UL, 0x00000000UL, 0x00000000UL,
+    },
+    /* 41: Alert_Enrollment_Properties_Required */
+    {
+        0x00020001UL, 0x00000018UL, 0x0020A900UL, 0x00000000UL,
+        0x00000004UL, 0x00000000UL, 0x00000000UL, 0x00000000UL,
+        0x00000000UL, 0x00000000UL, 0x00000000UL, 0x00000002UL,
+        0x00000000UL, 0x00000000UL, 0x00000000UL, 0x00000000UL,
+    },
+    /* 42: Channel_Properties_Required */
+    {
+        0x00000000UL, 0x00400000UL, 0x0022A800UL, 0x00008000UL,
+        0x00000000UL, 0x00000000UL, 0x00000000UL, 0x00000000UL,
+        0x00000000UL, 0x00000000UL, 0x00000000UL, 0x0006C000UL,
+        0x00000000UL, 0x00000000UL, 0x00000000UL, 0x00000000UL,
+    },
+    /* 43: Lighting_Output_Properties_Required */
+    {
+        0x00000000UL, 0x00000000UL, 0x00A2A800UL, 0x00008100UL,
+        0x00000000UL, 0x00000010UL, 0x00000000UL, 0x00000000UL,
+        0x00000000UL, 0x00000000UL, 0x00000000UL, 0x37E00000UL,
+        0x00000004UL, 0x00008000UL, 0x00000000UL, 0x00000000UL,
+    },
+    /* 44: Binary_Lighting_Output_Properties_Required */
+    {
+        0x00000000UL, 0x00000000UL, 0x00A2A800UL, 0x00008100UL,
+        0x00000000UL, 0x00000000UL, 0x00000000UL, 0x00000000UL,
+        0x00000000UL, 0x00000000UL, 0x00000000UL, 0x02200000UL,
+        0x00000004UL, 0x00008000UL, 0x00000000UL, 0x00000000UL,
+    },
+    /* 45: Network_Port_Properties_Required */
+    {
+        0x00000000UL, 0x00000000UL, 0x0002A800UL, 0x00008080UL,
+        0x00000000UL, 0x00000000UL, 0x00000000UL, 0x00000000UL,
+        0x00000000UL, 0x00000000UL, 0x00000000UL, 0x00000000UL,
+        0x00008000UL, 0x00000E11UL, 0x00000000UL, 0x00000004UL,
+    },
+    /* 46: Elevator_Group_Properties_Required */
+    {
+        0x00000000UL, 0x00000000UL, 0x0000A800UL, 0x00000000UL,
+        0x00000000UL, 0x00000000UL, 0x00000000UL, 0x00000000UL,
+        0x00000000UL, 0x00000000UL, 0x02000000UL, 0x00000000UL,
+        0x00000000UL, 0x00000000UL, 0x04020000UL, 0x00000000UL,
+    },
+    /* 47: Escalator_Properties_Required */
+    {
+        0x00000000UL, 0x00000000UL, 0x0002A800UL, 0x00008000UL,
+        0x00000000UL, 0x00000000UL, 0x00000000UL, 0x00000000UL,
+        0x00000000UL, 0x00000000UL, 0x00000000UL, 0x00000000UL,
+        0x00000000UL, 0x00000000UL, 0x60220800UL, 0x00000000UL,
+    },
+    /* 48: Lift_Properties_Required */
+    {
+        0x00000000UL, 0x00000000UL, 0x0002A800UL, 0x00008000UL,
+        0x00000000UL, 0x00000000UL, 0x00000000UL, 0x00000000UL,
+        0x00000000UL, 0x00000000UL, 0x00000000UL, 0x00000000UL,
+        0x00000000UL, 0x00000000UL, 0x40228E04UL, 0x00000000UL,
+    },
+    /* 49: Staging_Properties_Required */
+    {
+        0x00000000UL, 0x00000010UL, 0x0122A822UL, 0x00208080UL,
+        0x00000000UL, 0x00000000UL, 0x00000000UL, 0x00000000UL,
+        0x00000000UL, 0x00000000UL, 0x00000000UL, 0x00000000UL,
+        0x00000000UL, 0x00000000UL, 0x00000000UL, 0x00016000UL,
+    },
+    /* 50: Color_Properties_Required */
+    {
+        0x00000000UL, 0x00000000UL, 0x0020A800UL, 0x00000000UL,
+        0x00000000UL, 0x00000010UL, 0x00000000UL, 0x00000000UL,
+        0x00000000UL, 0x00000000UL, 0x00000000UL, 0x04400000UL,
+        0x00000000UL, 0x00000000UL, 0x00000000UL, 0x00000000UL,
+    },
+    /* 51: Color_Temperature_Properties_Required */
+    {
+        0x00000000UL, 0x00000000UL, 0x0020A800UL, 0x00000000UL,
+        0x00000000UL, 0x00000010UL, 0x00000000UL, 0x00000000UL,
+        0x00000000UL, 0x00000000UL, 0x00000000UL, 0x05C00000UL,
+        0x00000000UL, 0x00000000UL, 0x00000000UL, 0x00000000UL,
+    },
+    /* 52: Default_Properties_Optional */
+    {
+        0x00000000UL, 0x00000000UL, 0x00000000UL, 0x00000000UL,
+        0x00000000UL, 0x00000000UL, 0x00000000UL, 0x00000000UL,
+        0x00000000UL, 0x00000000UL, 0x00000000UL, 0x00000000UL,
+        0x00000000UL, 0x00000000UL, 0x00000000UL, 0x00000000UL,
+    },
+    /* 53: Analog_Input_Properties_Optional */
+    {
+        0x92420001UL, 0x08102008UL, 0x00000122UL, 0x00420480UL,
+        0x00000004UL, 0x00000100UL, 0x00000000UL, 0x00000000UL,
+        0x00000000UL, 0x00000000UL, 0x80000000UL, 0x0000003FUL,
+        0x00000038UL, 0x00000000UL, 0x00000000UL, 0x00240060UL,
+    },
+    /* 54: Analog_Output_Properties_Optional */
+    {
+        0x92420001UL, 0x08102008UL, 0x00000122UL, 0x00020480UL,
+        0x00000004UL, 0x00000100UL, 0x00000000UL, 0x00000000UL,
+        0x00000000UL, 0x00000000UL, 0x80000000UL, 0x0000003FUL,
+        0x00000008UL, 0x00074000UL, 0x00000000UL, 0x00340060UL,
+    },
+    /* 55: Analog_Value_Properties_Optional */
+    {
+        0x12420001UL, 0x08102008UL, 0x00800122UL, 0x00020580UL,
+        0x00000004UL, 0x00000100UL, 0x00000000UL, 0x00000000UL,
+        0x00000000UL, 0x00000000UL, 0x80000000UL, 0x0000003FUL,
+        0x00000030UL, 0x0007C000UL, 0x00000000UL, 0x00340060UL,
+    },
+    /* 56: Binary_Input_Properties_Optional */
+    {
+        0x90038051UL, 0x0000400AUL, 0x00000100UL, 0x000E0080UL,
+        0x00000004UL, 0x00000100UL, 0x00000000UL, 0x00000000UL,
+        0x00000000UL, 0x00000000UL, 0x80000000UL, 0x0000003FUL,
+        0x00000008UL, 0x00000000UL, 0x00000000UL, 0x00240060UL,
+    },
+    /* 57: Binary_Output_Properties_Optional */
+    {
+        0x90038011UL, 0x0000410AUL, 0x0000010CUL, 0x000E0080UL,
+        0x00000004UL, 0x00000100UL, 0x00000000UL, 0x00000000UL,
+        0x00000000UL, 0x00000000UL, 0x80000000UL, 0x0000003FUL,
+        0x00000008UL, 0x00074000UL, 0x00000000UL, 0x00340060UL,
+    },
+    /* 58: Binary_Value_Properties_Optional */
+    {
+        0x10038051UL, 0x0000400AUL, 0x0080010CUL, 0x000E0180UL,
+        0x00000004UL, 0x00000100UL, 0x00000000UL, 0x00000000UL,
+        0x00000000UL, 0x00000000UL, 0x80000000UL, 0x0000003FUL,
+        0x00000000UL, 0x0007C000UL, 0x00000000UL, 0x00340060UL,
+    },
+    /* 59: Calendar_Properties_Optional, Group_Properties_Optional,
+       Network_Security_Properties_Optional */
+    {
+        0x10000000UL, 0x00000000UL, 0x00000000UL, 0x00000000UL,
+        0x00000000UL, 0x00000100UL, 0x00000000UL, 0x00000000UL,
+        0x00000000UL, 0x00000000UL, 0x00000000UL, 0x00000000UL,
+        0x00000000UL, 0x00000000UL, 0x00000000UL, 0x00240060UL,
+    },
+    /* 60: Command_Properties_Optional */
+    {
+        0x10020009UL, 0x00000018UL, 0x00000100UL, 0x00008080UL,
+        0x00000004UL, 0x00000100UL, 0x00000000UL, 0x00000000UL,
+        0x00000000UL, 0x00000000UL, 0x80000000UL, 0x00000023UL,
+        0x00000000UL, 0x00020000UL, 0x00000000UL, 0x00240060UL,
+    },
+    /* 61: Device_Properties_Optional */
+    {
+        0x11020421UL, 0x87000018UL, 0x00000101UL, 0x04908080UL,
+        0x27000004UL, 0x00000180UL, 0x00025C1AUL, 0x00000000UL,
+        0x00000000UL, 0x00000000UL, 0x803C0000UL, 0x00100023UL,
+        0x00000000UL, 0x00000000UL, 0x00000000UL, 0x082C0062UL,
+    },
+    /* 62: Event_Enrollment_Properties_Optional */
+    {
+        0x10000000UL, 0x00000000UL, 0x00000000UL, 0x00000000UL,
+        0x00000000UL, 0x00000100UL, 0x00000000UL, 0x00000000UL,
+        0x00000000UL, 0x00000000UL, 0x80000000UL, 0x000000DDUL,
+        0x00000000UL, 0x00000000UL, 0x00000000UL, 0x00240060UL,
+    },
+    /* 63: File_Properties_Optional */
+    {
+        0x10000000UL, 0x00000000UL, 0x00000000UL, 0x00000000UL,
+        0x00002000UL, 0x00000100UL, 0x00000000UL, 0x00000000UL,
+        0x00000000UL, 0x00000000UL, 0x00000000UL, 0x00000000UL,
+        0x00000000UL, 0x00000000UL, 0x00000000UL, 0x00240060UL,
+    },
+    /* 64: Loop_Properties_Optional */
+    {
+        0x1E424001UL, 0x2006000CUL, 0x60000110UL, 0x00020080UL,
+        0x00000004UL, 0x00000100UL, 0x00000000UL, 0x00000000UL,
+        0x00000000UL, 0x00000000UL, 0x80000000UL, 0x0000003FUL,
+        0x00000040UL, 0x00000000UL, 0x00000000UL, 0x00240060UL,
+    },
+    /* 65: Multistate_Input_Properties_Optional */
+    {
+        0x90020081UL, 0x00000088UL, 0x00000100UL, 0x00024080UL,
+        0x00000004UL, 0x00000100UL, 0x00000000UL, 0x00000000UL,
+        0x00000000UL, 0x00000000UL, 0x80000000UL, 0x0000003FUL,
+        0x00000008UL, 0x00000000UL, 0x00000000UL, 0x00240060UL,
+    },
+    /* 66: Multistate_Output_Properties_Optional */
+    {
+        0x90020001UL, 0x00000108UL, 0x00000100UL, 0x00024080UL,
+        0x00000004UL, 0x00000100UL, 0x00000000UL, 0x00000000UL,
+        0x00000000UL, 0x00000000UL, 0x80000000UL, 0x0000003FUL,
+        0x00000008UL, 0x00074000UL, 0x00000000UL, 0x00340060UL,
+    },
+    /* 67: Notification_Class_Properties_Optional */
+    {
+        0x10000001UL, 0x00000018UL, 0x00000100UL, 0x00008080UL,
+        0x00000004UL, 0x00000100UL, 0x00000000UL, 0x00000000UL,
+        0x00000000UL, 0x00000000UL, 0x80000000UL, 0x00000023UL,
+        0x00000000UL, 0x00000000UL, 0x00000000UL, 0x00240060UL,
+    },
+    /* 68: Program_Properties_Optional */
+    {
+        0x30020001UL, 0x00010018UL, 0x08000100UL, 0x00000090UL,
+        0x00000004UL, 0x00000100UL, 0x00000000UL, 0x00000000UL,
+        0x00000000UL, 0x00000000UL, 0x80000000UL, 0x00000023UL,
+        0x00000000UL, 0x00000000UL, 0x00000000UL, 0x00240060UL,
+    },
+    /* 69: Schedule_Properties_Optional */
+    {
+        0x10020001UL, 0x00000058UL, 0x00000100UL, 0x08000000UL,
+        0x00000004UL, 0x00000100UL, 0x00000000UL, 0x00000000UL,
+        0x00000000UL, 0x00000000UL, 0x80000000UL, 0x00000023UL,
+        0x00000000UL, 0x00000000UL, 0x00000000UL, 0x00240060UL,
+    },
+    /* 70: Averaging_Properties_Optional */
+    {
+        0x10000000UL, 0x00000000UL, 0x00000000UL, 0x00000000UL,
+        0x00E00000UL, 0x00000100UL, 0x00000000UL, 0x00000000UL,
+        0x00000000UL, 0x00000000UL, 0x00000000UL, 0x00000000UL,
+        0x00000000UL, 0x00000000UL, 0x00000000UL, 0x00240060UL,
+    },
+    /* 71: Multistate_Value_Properties_Optional */
+    {
+        0x10020081UL, 0x00000088UL, 0x00800100UL, 0x00024180UL,
+        0x00000004UL, 0x00000100UL, 0x00000000UL, 0x00000000UL,
+        0x00000000UL, 0x00000000UL, 0x80000000UL, 0x0000003FUL,
+        0x00000000UL, 0x0007C000UL, 0x00000000UL, 0x00340060UL,
+    },
+    /* 72: Trend_Log_Properties_Optional */
+    {
+        0x10020001UL, 0x00000008UL, 0x00000100UL, 0x80000080UL,
+        0x0000D255UL, 0x00002100UL, 0x0000200AUL, 0x00000000UL,
+        0x00000000UL, 0x00000000UL, 0x80000000UL, 0x0000002FUL,
+        0x00000000UL, 0x00000000UL, 0x00000000UL, 0x00240060UL,
+    },
+    /* 73: Life_Safety_Point_Properties_Optional */
+    {
+        0x90020081UL, 0x00000088UL, 0x00000100UL, 0x00220000UL,
+        0xD0000004UL, 0x00000144UL, 0x00000000UL, 0x00000000UL,
+        0x00000000UL, 0x00000000UL, 0x80000000UL, 0x0000003FUL,
+        0x00000000UL, 0x00020000UL, 0x00000000UL, 0x00240060UL,
+    },
+    /* 74: Life_Safety_Zone_Properties_Optional */
+    {
+        0x90020081UL, 0x00000088UL, 0x00000100UL, 0x00020000UL,
+        0xC0000004UL, 0x00000140UL, 0x00000000UL, 0x00000000UL,
+        0x00000000UL, 0x00000000UL, 0x80000000UL, 0x0000001FUL,
+        0x00000000UL, 0x00020000UL, 0x00000000UL, 0x00240060UL,
+    },
+    /* 75: Accumulator_Properties_Optional */
+    {
+        0x90020001UL, 0x08102008UL, 0x00000100UL, 0x00020080UL,
+        0x00000004UL, 0xC7C00100UL, 0x00000001UL, 0x00000000UL,
+        0x00000000UL, 0x00000000UL, 0x80000000UL, 0x0000003FUL,
+        0x00000030UL, 0x00000000UL, 0x00000000UL, 0x00240060UL,
+    },
+    /* 76: Pulse_Converter_Properties_Optional */
+    {
+        0x12420001UL, 0x08102008UL, 0x00000100UL, 0x00020080UL,
+        0x00000004UL, 0x00300100UL, 0x00000000UL, 0x00000000UL,
+        0x00000000UL, 0x00000000UL, 0x80000000UL, 0x0000003FUL,
+        0x00000000UL, 0x00000000UL, 0x00000000UL, 0x00240060UL,
+    },
+    /* 77: Event_Log_Properties_Optional */
+    {
+        0x10020001UL, 0x00000008UL, 0x00000100UL, 0x00000080UL,
+        0x0000D204UL, 0x00002100UL, 0x00000000UL, 0x00000000UL,
+        0x00000000UL, 0x00000000UL, 0x80000000UL, 0x0000002FUL,
+        0x00000000UL, 0x00000000UL, 0x00000000UL, 0x00240060UL,
+    },
+    /* 78: Global_Group_Properties_Optional */
+    {
+        0x10020001UL, 0x00000008UL, 0x00000100UL, 0x80420080UL,
+        0x00000005UL, 0x00000100UL, 0x00000000UL, 0x00000000UL,
+        0x00000000UL, 0x00000000UL, 0xF4000000UL, 0x0000003FUL,
+        0x00000000UL, 0x00000000UL, 0x00000000UL, 0x00240060UL,
+    },
+    /* 79: Trend_Log_Multiple_Properties_Optional */
+    {
+        0x10020001UL, 0x00000008UL, 0x00000100UL, 0x00000080UL,
+        0x0000D204UL, 0x00002100UL, 0x0000200AUL, 0x00000000UL,
+        0x00000000UL, 0x00000000UL, 0x80000000UL, 0x0000002FUL,
+        0x00000000UL, 0x00000000UL, 0x00000000UL, 0x00240060UL,
+    },
+    /* 80: Load_Control_Properties_Optional */
+    {
+        0x10020001UL, 0x00000008UL, 0x00000100UL, 0x00020080UL,
+        0x00000004UL, 0x00000100UL, 0x40800000UL, 0x00000000UL,
+        0x00000000UL, 0x00000000UL, 0x80000000UL, 0x0000003FUL,
+        0x00000000UL, 0x00020000UL, 0x00000000UL, 0x00240060UL,
+    },
+    /* 81: Structured_View_Properties_Optional */
+    {
+        0x10000000UL, 0x00000000UL, 0x00000000UL, 0x00000000UL,
+        0x00000000UL, 0x00000100UL, 0x00048000UL, 0x00000000UL,
+        0x00000000UL, 0x00000000UL, 0x00000000UL, 0x00000000UL,
+        0x00000000UL, 0x00000000UL, 0x00000000UL, 0x00240FE0UL,
+    },
+    /* 82: Access_Door_Properties_Optional */
+    {
+        0x10020081UL, 0x00000088UL, 0x00000100UL, 0x00020000UL,
+        0x40000004UL, 0x00000100UL, 0x00000000UL, 0x00000F94UL,
+        0x00000000UL, 0x00000000UL, 0x80000000UL, 0x0000003FUL,
+        0x00000000UL, 0x00074000UL, 0x00000000UL, 0x00340060UL,
+    },
+    /* 83: Timer_Properties_Optional */
+    {
+        0x10020081UL, 0x00400018UL, 0x01020122UL, 0x00020480UL,
+        0x00000004UL, 0x20000100UL, 0x00000000UL, 0x00000000UL,
+        0x00004000UL, 0x00000000UL, 0x80000000UL, 0x0000003FUL,
+        0x00001E00UL, 0x00000000UL, 0x00000000UL, 0x00240060UL,
+    },
+    /* 84: Access_Credential_Properties_Optional */
+    {
+        0x10000000UL, 0x00000000UL, 0x00000000UL, 0x00000000UL,
+        0x00000000UL, 0x00000100UL, 0x00000000UL, 0x00100000UL,
+        0x02188840UL, 0x80140000UL, 0x00000000UL, 0x00001020UL,
+        0x00000000UL, 0x00000000UL, 0x00000000UL, 0x00240060UL,
+    },
+    /* 85: Access_Point_Properties_Optional */
+    {
+        0x10020001UL, 0x00000008UL, 0x00000100UL, 0x00000000UL,
+        0x00000004UL, 0x00000100UL, 0x00000000UL, 0x29200000UL,
+        0xAC07000CUL, 0x00280488UL, 0x80000043UL, 0x0000002FUL,
+        0x00000000UL, 0x00000000UL, 0x00000000UL, 0x00240060UL,
+    },
+    /* 86: Access_Rights_Properties_Optional */
+    {
+        0x10000000UL, 0x00000000UL, 0x00000000UL, 0x00000000UL,
+        0x00000000UL, 0x00000100UL, 0x00000000UL, 0x10000000UL,
+        0x00000000UL, 0x00000000UL, 0x00000000UL, 0x00000020UL,
+        0x00000000UL, 0x00000000UL, 0x00000000UL, 0x00240060UL,
+    },
+    /* 87: Access_User_Properties_Optional */
+    {
+        0x10000000UL, 0x00000000UL, 0x00000000UL, 0x00000000UL,
+        0x80000000UL, 0x00000100UL, 0x00000000UL, 0x00000000UL,
+        0x40000000UL, 0x20C00000UL, 0x00000000UL, 0x00000020UL,
+        0x00000000UL, 0x00000000UL, 0x00000000UL, 0x00240060UL,
+    },
+    /* 88: Access_Zone_Properties_Optional */
+    {
+        0x10020081UL, 0x00000008UL, 0x00000100UL, 0x00020000UL,
+        0x00000004UL, 0x00010100UL, 0x00000000UL, 0x00000000UL,
+        0x01E00400UL, 0x00003254UL, 0x80000000UL, 0x0000003FUL,
+        0x00000000UL, 0x00000000UL, 0x00000000UL, 0x00240060UL,
+    },
+    /* 89: Credential_Data_Input_Properties_Optional */
+    {
+        0x10020001UL, 0x00000018UL, 0x00000100UL, 0x00000000UL,
+        0x00000004UL, 0x00000100UL, 0x00000000UL, 0x00000000UL,
+        0x00000000UL, 0x00020000UL, 0x80000000UL, 0x00000023UL,
+        0x00000000UL, 0x00000000UL, 0x00000000UL, 0x00240060UL,
+    },
+    /* 90: BitString_Value_Properties_Optional */
+    {
+        0x10020081UL, 0x00000018UL, 0x00820100UL, 0x00020180UL,
+        0x00000004UL, 0x00000100UL, 0x00000000UL, 0x00000000UL,
+        0x00000000UL, 0x00000000UL, 0x80400000UL, 0x0000003FUL,
+        0x00000000UL, 0x0007C000UL, 0x00000000UL, 0x00240060UL,
+    },
+    /* 91: CharacterString_Value_Properties_Optional */
+    {
+        0x10020081UL, 0x00000098UL, 0x00820100UL, 0x00020180UL,
+        0x00000004UL, 0x00000100UL, 0x00000000UL, 0x00000000UL,
+        0x00000000UL, 0x00000000UL, 0x80000000UL, 0x0000003FUL,
+        0x00000000UL, 0x0007C000UL, 0x00000000UL, 0x00240060UL,
+    },
+    /* 92: Date_Pattern_Value_Properties_Optional */
+    {
+        0x10020001UL, 0x00000018UL, 0x00820100UL, 0x00000180UL,
+        0x00000004UL, 0x00000100UL, 0x00000000UL, 0x00000000UL,
+        0x00000000UL, 0x00000000UL, 0x80000000UL, 0x00000023UL,
+        0x00000000UL, 0x0007C000UL, 0x00000000UL, 0x00240060UL,
+    },
+    /* 93: Date_Value_Properties_Optional,
+       Time_Pattern_Value_Properties_Optional, Time_Value_Properties_Optional */
+    {
+        0x10020001UL, 0x00000018UL, 0x00820100UL, 0x00000180UL,
+        0x00000004UL, 0x00000100UL, 0x00000000UL, 0x00000000UL,
+        0x00000000UL, 0x00000000UL, 0x80000000UL, 0x00000023UL,
+        0x00000000UL, 0x0007C000UL, 0x00000000UL, 0x00340060UL,
+    },
+    /* 94: DateTime_Pattern_Value_Properties_Optional,
+       DateTime_Value_Properties_Optional */
+    {
+        0x10020001UL, 0x00000018UL, 0x00820100UL, 0x00000180UL,
+        0x00000004UL, 0x00000100UL, 0x00000000UL, 0x00000000UL,
+        0x00000000UL, 0x00000000UL, 0x81000000UL, 0x00000023UL,
+        0x00000000UL, 0x0007C000UL, 0x00000000UL, 0x00340060UL,
+    },
+    /* 95: Integer_Value_Properties_Optional,
+       Large_Analog_Value_Properties_Optional,
+       Positive_Integer_Value_Properties_Optional */
+    {
+        0x12420001UL, 0x08102018UL, 0x00820122UL, 0x00020580UL,
+        0x00000004UL, 0x00000100UL, 0x00000000UL, 0x00000000UL,
+        0x00000000UL, 0x00000000UL, 0x80000000UL, 0x0000003FUL,
+        0x00000030UL, 0x0007C000UL, 0x00000000UL, 0x00340060UL,
+    },
+    /* 96: OctetString_Value_Properties_Optional */
+    {
+        0x10000000UL, 0x00000010UL, 0x00820000UL, 0x00000180UL,
+        0x00000000UL, 0x00000100UL, 0x00000000UL, 0x00000000UL,
+        0x00000000UL, 0x00000000UL, 0x00000000UL, 0x00000020UL,
+        0x00000000UL, 0x0007C000UL, 0x00000000UL, 0x00340060UL,
+    },
+    /* 97: Notification_Forwarder_Properties_Optional */
+    {
+        0x10000000UL, 0x00000000UL, 0x00000000UL, 0x00000000UL,
+        0x00000000UL, 0x00000100UL, 0x00000000UL, 0x00000000UL,
+        0x00000000UL, 0x00000000UL, 0x00000000UL, 0x00000820UL,
+        0x00000000UL, 0x00000000UL, 0x00000000UL, 0x00240060UL,
+    },
+    /* 98: Alert_Enrollment_Properties_Optional */
+    {
+        0x10000000UL, 0x00000000UL, 0x00000000UL, 0x00000000UL,
+        0x00000000UL, 0x00000100UL, 0x00000000UL, 0x00000000UL,
+        0x00000000UL, 0x00000000UL, 0x80000000UL, 0x0000000DUL,
+        0x00000000UL, 0x00000000UL, 0x00000000UL, 0x00240060UL,
+    },
+    /* 99: Channel_Properties_Optional */
+    {
+        0x10020001UL, 0x00000018UL, 0x00000100UL, 0x00000080UL,
+        0x00000004UL, 0x00000100UL, 0x00000000UL, 0x00000000UL,
+        0x00000000UL, 0x00000000UL, 0x80000000UL, 0x00012023UL,
+        0x00000000UL, 0x00020000UL, 0x00000000UL, 0x00240060UL,
+    },
+    /* 100: Lighting_Output_Properties_Optional */
+    {
+        0x10400000UL, 0x00000100UL, 0x00000000UL, 0x00000080UL,
+        0x00000000UL, 0x00000100UL, 0x00000000UL, 0x00000000UL,
+        0x00000000UL, 0x00000000UL, 0x00000000UL, 0xC8000020UL,
+        0x00000003UL, 0x00074000UL, 0x00000000UL, 0x00340060UL,
+    },
+    /* 101: Binary_Lighting_Output_Properties_Optional */
+    {
+        0x10020001UL, 0x0000010AUL, 0x00100100UL, 0x00040080UL,
+        0x00000004UL, 0x00000100UL, 0x00000000UL, 0x00000000UL,
+        0x00000000UL, 0x00000000UL, 0x80000000UL, 0x00000023UL,
+        0x00000181UL, 0x00074000UL, 0x00000000UL, 0x00340060UL,
+    },
+    /* 102: Network_Port_Properties_Optional */
+    {
+        0x10020001UL, 0x80000018UL, 0x00000101UL, 0x00000000UL,
+        0x00000004UL, 0x00001F00UL, 0x00000000UL, 0x00000000UL,
+        0x00000000UL, 0x00000000UL, 0x80000000UL, 0x00000023UL,
+        0xFFFF0000UL, 0x7FF831EEUL, 0x00000000UL, 0x00240068UL,
+    },
+    /* 103: Elevator_Group_Properties_Optional */
+    {
+        0x10000000UL, 0x00000000UL, 0x00000000UL, 0x00000000UL,
+        0x00000000UL, 0x00000100UL, 0x00000000UL, 0x00000000UL,
+        0x00000000UL, 0x00000000UL, 0x00000000UL, 0x00000000UL,
+        0x00000000UL, 0x00000000UL, 0x00C80000UL, 0x00240060UL,
+    },
+    /* 104: Escalator_Properties_Optional */
+    {
+        0x10020001UL, 0x00000018UL, 0x00000100UL, 0x00020080UL,
+        0x00000004UL, 0x00000100UL, 0x00000000UL, 0x00000000UL,
+        0x00000000UL, 0x00000000UL, 0x80000000UL, 0x0000003FUL,
+        0x00000000UL, 0x00000000UL, 0x8000F000UL, 0x00240060UL,
+    },
+    /* 105: Lift_Properties_Optional */
+    {
+        0x10020001UL, 0x00000018UL, 0x00000100UL, 0x00020080UL,
+        0x00000004UL, 0x00000100UL, 0x00000000UL, 0x00000000UL,
+        0x00000000UL, 0x00000000UL, 0x80000000UL, 0x0000003FUL,
+        0x00000000UL, 0x80000000UL, 0x1B1131FBUL, 0x00240061UL,
+    },
+    /* 106: Staging_Properties_Optional */
+    {
+        0x10420001UL, 0x00000008UL, 0x00000100UL, 0x00000000UL,
+        0x00000004UL, 0x00000100UL, 0x00000000UL, 0x00000000UL,
+        0x00000000UL, 0x00000000UL, 0x80000000UL, 0x00000023UL,
+        0x00000000UL, 0x00020000UL, 0x00000000UL, 0x00249060UL,
+    },
+    /* 107: Color_Properties_Optional */
+    {
+        0x10000000UL, 0x00000000UL, 0x00000000UL, 0x00000080UL,
+        0x00000000UL, 0x00000100UL, 0x00000000UL, 0x00000000UL,
+        0x00000000UL, 0x00000000UL, 0x00000000UL, 0x00000000UL,
+        0x00000002UL, 0x00020000UL, 0x00000000UL, 0x00240060UL,
+    },
+    /* 108: Color_Temperature_Properties_Optional */
+    {
+        0x10000000UL, 0x00000000UL, 0x00000022UL, 0x00000000UL,
+        0x00000000UL, 0x00000100UL, 0x00000000UL, 0x00000000UL,
+        0x00000000UL, 0x00000000UL, 0x00000000UL, 0x00000000UL,
+        0x00000002UL, 0x00020000UL, 0x00000000UL, 0x00240060UL,
+    },
+};
+
+static const uint8_t
+    Property_Required_Bitmap_Index[BACNET_OBJECT_TYPE_LAST + 1] = {
+    1, /* OBJECT_ANALOG_INPUT */
+    2, /* OBJECT_ANALOG_OUTPUT */
+    1, /* OBJECT_ANALOG_VALUE */
+    3, /* OBJECT_BINARY_INPUT */
+    4, /* OBJECT_BINARY_OUTPUT */
+    5, /* OBJECT_BINARY_VALUE */
+    6, /* OBJECT_CALENDAR */
+    7, /* OBJECT_COMMAND */
+    8, /* OBJECT_DEVICE */
+    9, /* OBJECT_EVENT_ENROLLMENT */
+    10, /* OBJECT_FILE */
+    11, /* OBJECT_GROUP */
+    12, /* OBJECT_LOOP */
+    13, /* OBJECT_MULTI_STATE_INPUT */
+    14, /* OBJECT_MULTI_STATE_OUTPUT */
+    15, /* OBJECT_NOTIFICATION_CLASS */
+    16, /* OBJECT_PROGRAM */
+    17, /* OBJECT_SCHEDULE */
+    18, /* OBJECT_AVERAGING */
+    13, /* OBJECT_MULTI_STATE_VALUE */
+    19, /* OBJECT_TRENDLOG */
+    20, /* OBJECT_LIFE_SAFETY_POINT */
+    21, /* OBJECT_LIFE_SAFETY_ZONE */
+    22, /* OBJECT_ACCUMULATOR */
+    23, /* OBJECT_PULSE_CONVERTER */
+    24, /* OBJECT_EVENT_LOG */
+    25, /* OBJECT_GLOBAL_GROUP */
+    26, /* OBJECT_TREND_LOG_MULTIPLE */
+    27, /* OBJECT_LOAD_CONTROL */
+    28, /* OBJECT_STRUCTURED_VIEW */
+    29, /* OBJECT_ACCESS_DOOR */
+    30, /* OBJECT_TIMER */
+    31, /* OBJECT_ACCESS_CREDENTIAL */
+    32, /* OBJECT_ACCESS_POINT */
+    33, /* OBJECT_ACCESS_RIGHTS */
+    34, /* OBJECT_ACCESS_USER */
+    35, /* OBJECT_ACCESS_ZONE */
+    36, /* OBJECT_CREDENTIAL_DATA_INPUT */
+    37, /* OBJECT_NETWORK_SECURITY */
+    38, /* OBJECT_BITSTRING_VALUE */
+    38, /* OBJECT_CHARACTERSTRING_VALUE */
+    38, /* OBJECT_DATE_PATTERN_VALUE */
+    38, /* OBJECT_DATE_VALUE */
+    38, /* OBJECT_DATETIME_PATTERN_VALUE */
+    38, /* OBJECT_DATETIME_VALUE */
+    39, /* OBJECT_INTEGER_VALUE */
+    39, /* OBJECT_LARGE_ANALOG_VALUE */
+    38, /* OBJECT_OCTETSTRING_VALUE */
+    39, /* OBJECT_POSITIVE_INTEGER_VALUE */
+    38, /* OBJECT_TIME_PATTERN_VALUE */
+    38, /* OBJECT_TIME_VALUE */
+    40, /* OBJECT_NOTIFICATION_FORWARDER */
+    41, /* OBJECT_ALERT_ENROLLMENT */
+    42, /* OBJECT_CHANNEL */
+    43, /* OBJECT_LIGHTING_OUTPUT */
+    44, /* OBJECT_BINARY_LIGHTING_OUTPUT */
+    45, /* OBJECT_NETWORK_PORT */
+    46, /* OBJECT_ELEVATOR_GROUP */
+    47, /* OBJECT_ESCALATOR */
+    48, /* OBJECT_LIFT */
+    49, /* OBJECT_STAGING */
+    0, /* OBJECT_AUDIT_LOG */
+    0, /* OBJECT_AUDIT_REPORTER */
+    50, /* OBJECT_COLOR */
+    51, /* OBJECT_COLOR_TEMPERATURE */
+};
+
+static const uint8_t
+    Property_Optional_Bitmap_Index[BACNET_OBJECT_TYPE_LAST + 1] = {
+    53, /* OBJECT_ANALOG_INPUT */
+    54, /* OBJECT_ANALOG_OUTPUT */
+    55, /* OBJECT_ANALOG_VALUE */
+    56, /* OBJECT_BINARY_INPUT */
+    57, /* OBJECT_BINARY_OUTPUT */
+    58, /* OBJECT_BINARY_VALUE */
+    59, /* OBJECT_CALENDAR */
+    60, /* OBJECT_COMMAND */
+    61, /* OBJECT_DEVICE */
+    62, /* OBJECT_EVENT_ENROLLMENT */
+    63, /* OBJECT_FILE */
+    59, /* OBJECT_GROUP */
+    64, /* OBJECT_LOOP */
+    65, /* OBJECT_MULTI_STATE_INPUT */
+    66, /* OBJECT_MULTI_STATE_OUTPUT */
+    67, /* OBJECT_NOTIFICATION_CLASS */
+    68, /* OBJECT_PROGRAM */
+    69, /* OBJECT_SCHEDULE */
+    70, /* OBJECT_AVERAGING */
+    71, /* OBJECT_MULTI_STATE_VALUE */
+    72, /* OBJECT_TRENDLOG */
+    73, /* OBJECT_LIFE_SAFETY_POINT */
+    74, /* OBJECT_LIFE_SAFETY_ZONE */
+    75, /* OBJECT_ACCUMULATOR */
+    76, /* OBJECT_PULSE_CONVERTER */
+    77, /* OBJECT_EVENT_LOG */
+    78, /* OBJECT_GLOBAL_GROUP */
+    79, /* OBJECT_TREND_LOG_MULTIPLE */
+    80, /* OBJECT_LOAD_CONTROL */
+    81, /* OBJECT_STRUCTURED_VIEW */
+    82, /* OBJECT_ACCESS_DOOR */
+    83, /* OBJECT_TIMER */
+    84, /* OBJECT_ACCESS_CREDENTIAL */
+    85, /* OBJECT_ACCESS_POINT */
+    86, /* OBJECT_ACCESS_RIGHTS */
+    87, /* OBJECT_ACCESS_USER */
+    88, /* OBJECT_ACCESS_ZONE */
+    89, /* OBJECT_CREDENTIAL_DATA_INPUT */
+    59, /* OBJECT_NETWORK_SECURITY */
+    90, /* OBJECT_BITSTRING_VALUE */
+    91, /* OBJECT_CHARACTERSTRING_VALUE */
+    92, /* OBJECT_DATE_PATTERN_VALUE */
+    93, /* OBJECT_DATE_VALUE */
+    94, /* OBJECT_DATETIME_PATTERN_VALUE */
+    94, /* OBJECT_DATETIME_VALUE */
+    95, /* OBJECT_INTEGER_VALUE */
+    95, /* OBJECT_LARGE_ANALOG_VALUE */
+    96, /* OBJECT_OCTETSTRING_VALUE */
+    95, /* OBJECT_POSITIVE_INTEGER_VALUE */
+    93, /* OBJECT_TIME_PATTERN_VALUE */
+    93, /* OBJECT_TIME_VALUE */
+    97, /* OBJECT_NOTIFICATION_FORWARDER */
+    98, /* OBJECT_ALERT_ENROLLMENT */
+    99, /* OBJECT_CHANNEL */
+    100, /* OBJECT_LIGHTING_OUTPUT */
+    101, /* OBJECT_BINARY_LIGHTING_OUTPUT */
+    102, /* OBJECT_NETWORK_PORT */
+    103, /* OBJECT_ELEVATOR_GROUP */
+    104, /* OBJECT_ESCALATOR */
+    105, /* OBJECT_LIFT */
+    106, /* OBJECT_STAGING */
+    52, /* OBJECT_AUDIT_LOG */
+    52, /* OBJECT_AUDIT_REPORTER */
+    107, /* OBJECT_COLOR */
+    108, /* OBJECT_COLOR_TEMPERATURE */
+};
+#endif
+
+static const uint32_t Property_Writable_Bitmap[][PROPERTY_BITMAP_WORDS] = {
+    /* 0: Default_Properties_Writable */
+    {
+        0x00000000UL, 0x00000000UL, 0x00000000UL, 0x00000000UL,
+        0x00000000UL, 0x00000000UL, 0x00000000UL, 0x00000000UL,
+        0x00000000UL, 0x00000000UL, 0x00000000UL, 0x00000000UL,
+        0x00000000UL, 0x00000000UL, 0x00000000UL, 0x00000000UL,
+    },
+    /* 1: Commandable_Properties_Writable, Color_Properties_Writable */
+    {
+        0x00000000UL, 0x00000000UL, 0x00200000UL, 0x00000000UL,
+        0x00000000UL, 0x00000000UL, 0x00000000UL, 0x00000000UL,
+        0x00000000UL, 0x00000000UL, 0x00000000UL, 0x00000000UL,
+        0x00000000UL, 0x00000000UL, 0x00000000UL, 0x00000000UL,
+    },
+    /* 2: File_Properties_Writable */
+    {
+        0x00002000UL, 0x00000000UL, 0x00000000UL, 0x00000000UL,
+        0x00000000UL, 0x00000000UL, 0x00000000UL, 0x00000000UL,
+        0x00000000UL, 0x00000000UL, 0x00000000UL, 0x00000000UL,
+        0x00000000UL, 0x00000000UL, 0x00000000UL, 0x00000000UL,
+    },
+    /* 3: Program_Properties_Writable */
+    {
+        0x00000000UL, 0x00000000UL, 0x04000000UL, 0x00000000UL,
+        0x00000000UL, 0x00000000UL, 0x00000000UL, 0x00000000UL,
+        0x00000000UL, 0x00000000UL, 0x00000000UL, 0x00000000UL,
+        0x00000000UL, 0x00000000UL, 0x00000000UL, 0x00000000UL,
+    },
+    /* 4: Averaging_Properties_Writable */
+    {
+        0x00000000UL, 0x00000000UL, 0x00000000UL, 0x10000000UL,
+        0x00180000UL, 0x00000000UL, 0x00000000UL, 0x00000000UL,
+        0x00000000UL, 0x00000000UL, 0x00000000UL, 0x00000000UL,
+        0x00000000UL, 0x00000000UL, 0x00000000UL, 0x00000000UL,
+    },
+    /* 5: Log_Properties_Writable */
+    {
+        0x00000000UL, 0x00000000UL, 0x00000000UL, 0x00000000UL,
+        0x00002020UL, 0x00000000UL, 0x00000000UL, 0x00000000UL,
+        0x00000000UL, 0x00000000UL, 0x00000000UL, 0x00000000UL,
+        0x00000000UL, 0x00000000UL, 0x00000000UL, 0x00000000UL,
+    },
+    /* 6: Life_Safety_Properties_Writable */
+    {
+        0x00000000UL, 0x00000000UL, 0x00000000UL, 0x00000000UL,
+        0x00000000UL, 0x00000001UL, 0x00000000UL, 0x00000000UL,
+        0x00000000UL, 0x00000000UL, 0x00000000UL, 0x00000000UL,
+        0x00000000UL, 0x00000000UL, 0x00000000UL, 0x00000000UL,
+    },
+    /* 7: Pulse_Converter_Properties_Writable */
+    {
+        0x00000000UL, 0x00000000UL, 0x00000000UL, 0x00000000UL,
+        0x00000000UL, 0x00010000UL, 0x00000000UL, 0x00000000UL,
+        0x00000000UL, 0x00000000UL, 0x00000000UL, 0x00000000UL,
+        0x00000000UL, 0x00000000UL, 0x00000000UL, 0x00000000UL,
+    },
+    /* 8: Load_Control_Properties_Writable */
+    {
+        0x00000000UL, 0x00000000UL, 0x00000000UL, 0x00000000UL,
+        0x00004000UL, 0x00000000UL, 0x2C200000UL, 0x00000000UL,
+        0x00000000UL, 0x00000000UL, 0x00000000UL, 0x00000000UL,
+        0x00000000UL, 0x00000000UL, 0x00000000UL, 0x00000000UL,
+    },
+    /* 9: Access_Properties_Writable */
+    {
+        0x00000000UL, 0x00000000UL, 0x00000000UL, 0x00000000UL,
+        0x00000000UL, 0x00000000UL, 0x00000000UL, 0x00000000UL,
+        0x00000000UL, 0x00000000UL, 0x00000008UL, 0x00000000UL,
+        0x00000000UL, 0x00000000UL, 0x00000000UL, 0x00000000UL,
+    },
+    /* 10: Network_Security_Properties_Writable */
+    {
+        0x00000000UL, 0x00000000UL, 0x00000000UL, 0x00000000UL,
+        0x00000000UL, 0x00000000UL, 0x00000000UL, 0x00000000UL,
+        0x00000000UL, 0x00000000UL, 0x0000FA80UL, 0x00000000UL,
+        0x00000000UL, 0x00000000UL, 0x00000000UL, 0x00000000UL,
+    },
+    /* 11: Notification_Forwarder_Properties_Writable */
+    {
+        0x00000000UL, 0x00000000UL, 0x00000000UL, 0x00000000UL,
+        0x00000000UL, 0x00000000UL, 0x00000000UL, 0x00000000UL,
+        0x00000000UL, 0x00000000UL, 0x00000000UL, 0x00000400UL,
+        0x00000000UL, 0x00000000UL, 0x00000000UL, 0x00000000UL,
+    },
+    /* 12: Channel_Properties_Writable */
+    {
+        0x00000000UL, 0x00400000UL, 0x00200000UL, 0x00000000UL,
+        0x00000000UL, 0x00000000UL, 0x00000000UL, 0x00000000UL,
+        0x00000000UL, 0x00000000UL, 0x00000000UL, 0x0000C000UL,
+        0x00000000UL, 0x00000000UL, 0x00000000UL, 0x00000000UL,
+    },
+    /* 13: Lighting_Output_Properties_Writable */
+    {
+        0x00000000UL, 0x00000000UL, 0x00200000UL, 0x00000000UL,
+        0x00000000UL, 0x00000000UL, 0x00000000UL, 0x00000000UL,
+        0x00000000UL, 0x00000000UL, 0x00000000UL, 0x10000000UL,
+        0x00000000UL, 0x00000000UL, 0x00000000UL, 0x00000000UL,
+    },
+    /* 14: Audit_Log_Properties_Writable */
+    {
+        0x00000000UL, 0x00000000UL, 0x00000000UL, 0x00000000UL,
+        0x00000020UL, 0x00000000UL, 0x00000000UL, 0x00000000UL,
+        0x00000000UL, 0x00000000UL, 0x00000000UL, 0x00000000UL,
+        0x00000000UL, 0x00000000UL, 0x00000000UL, 0x00000000UL,
+    },
+};
+
+static const uint8_t
+    Property_Writable_Bitmap_Index[BACNET_OBJECT_TYPE_LAST + 1] = {
+    0, /* OBJECT_ANALOG_INPUT */
+    1, /* OBJECT_ANALOG_OUTPUT */
+    0, /* OBJECT_ANALOG_VALUE */
+    0, /* OBJECT_BINARY_INPUT */
+    1, /* OBJECT_BINARY_OUTPUT */
+    0, /* OBJECT_BINARY_VALUE */
+    0, /* OBJECT_CALENDAR */
+    1, /* OBJECT_COMMAND */
+    0, /* OBJECT_DEVICE */
+    0, /* OBJECT_EVENT_ENROLLMENT */
+    2, /* OBJECT_FILE */
+    0, /* OBJECT_GROUP */
+    0, /* OBJECT_LOOP */
+    0, /* OBJECT_MULTI_STATE_INPUT */
+    1, /* OBJECT_MULTI_STATE_OUTPUT */
+    0, /* OBJECT_NOTIFICATION_CLASS */
+    3, /* OBJECT_PROGRAM */
+    0, /* OBJECT_SCHEDULE */
+    4, /* OBJECT_AVERAGING */
+    0, /* OBJECT_MULTI_STATE_VALUE */
+    5, /* OBJECT_TRENDLOG */
+    6, /* OBJECT_LIFE_SAFETY_POINT */
+    6, /* OBJECT_LIFE_SAFETY_ZONE */
+    0, /* OBJECT_ACCUMULATOR */
+    7, /* OBJECT_PULSE_CONVERTER */
+    5, /* OBJECT_EVENT_LOG */
+    0, /* OBJECT_GLOBAL_GROUP */
+    5, /* OBJECT_TREND_LOG_MULTIPLE */
+    8, /* OBJECT_LOAD_CONTROL */
+    0, /* OBJECT_STRUCTURED_VIEW */
+    1, /* OBJECT_ACCESS_DOOR */
+    0, /* OBJECT_TIMER */
+    9, /* OBJECT_ACCESS_CREDENTIAL */
+    0, /* OBJECT_ACCESS_POINT */
+    9, /* OBJECT_ACCESS_RIGHTS */
+    9, /* OBJECT_ACCESS_USER */
+    9, /* OBJECT_ACCESS_ZONE */
+    0, /* OBJECT_CREDENTIAL_DATA_INPUT */
+    10, /* OBJECT_NETWORK_SECURITY */
+    0, /* OBJECT_BITSTRING_VALUE */
+    0, /* OBJECT_CHARACTERSTRING_VALUE */
+    0, /* OBJECT_DATE_PATTERN_VALUE */
+    0, /* OBJECT_DATE_VALUE */
+    0, /* OBJECT_DATETIME_PATTERN_VALUE */
+    0, /* OBJECT_DATETIME_VALUE */
+    0, /* OBJECT_INTEGER_VALUE */
+    0, /* OBJECT_LARGE_ANALOG_VALUE */
+    0, /* OBJECT_OCTETSTRING_VALUE */
+    0, /* OBJECT_POSITIVE_INTEGER_VALUE */
+    0, /* OBJECT_TIME_PATTERN_VALUE */
+    0, /* OBJECT_TIME_VALUE */
+    11, /* OBJECT_NOTIFICATION_FORWARDER */
+    0, /* OBJECT_ALERT_ENROLLMENT */
+    12, /* OBJECT_CHANNEL */
+    13, /* OBJECT_LIGHTING_OUTPUT */
+    1, /* OBJECT_BINARY_LIGHTING_OUTPUT */
+    0, /* OBJECT_NETWORK_PORT */
+    0, /* OBJECT_ELEVATOR_GROUP */
+    0, /* OBJECT_ESCALATOR */
+    0, /* OBJECT_LIFT */
+    1, /* OBJECT_STAGING */
+    14, /* OBJECT_AUDIT_LOG */
+    0, /* OBJECT_AUDIT_REPORTER */
+    1, /* OBJECT_COLOR */
+    1, /* OBJECT_COLOR_TEMPERATURE */
+};
+/* clang-format on */
+/* GENERATED PROPERTY BITMAPS END */
+
+/**
+ * @brief Determine if a property is a member of a property bitmap
+ * @param bitmap - property bitmap of PROPERTY_BITMAP_WORDS words
+ * @param object_property - object-property to be checked
+ * @return true if the property is a member of the bitmap
+ */
+static bool property_bitmap_member(
+    const uint32_t *bitmap, BACNET_PROPERTY_ID object_property)
+{
+    return (bitmap[object_property / 32] &
+            ((uint32_t)1 << (object_property % 32))) != 0;
+}
+
+#if (PROPERTY_BITMAP_BITS != PROPERTY_LIST_BITMAP_BITS)
+#error "PROPERTY_BITMAP_BITS must match PROPERTY_LIST_BITMAP_BITS"
+#endif
+
+/**
+ * @brief Add the properties of a list to a property bitmap, such as one
+ *  that caches the property lists of an object implementation
+ * @param bitmap - property bitmap of PROPERTY_LIST_BITMAP_WORDS words
+ * @param pList - '-1' terminated array of properties, or NULL.
+ *  Properties beyond the range of the bitmap are not added.
+ */
+void property_list_bitmap_add(uint32_t *bitmap, const int *pList)
+{
+    if (!bitmap || !pList) {
+        return;
+    }
+    while (*pList != -1) {
+        if ((*pList >= 0) && (*pList < PROPERTY_LIST_BITMAP_BITS)) {
+            bitmap[*pList / 32] |= ((uint32_t)1 << (*pList % 32));
+        }
+        pList++;
+    }
+}
+
+/**
+ * @brief Determine if a property is a member of a property bitmap
+ * @param bitmap - property bitmap of PROPERTY_LIST_BITMAP_WORDS words
+ * @param object_property - object-property to be checked
+ * @return true if the property is a member of the bitmap, false if not,
+ *  or if it is beyond the range of the bitmap
+ */
+bool property_list_bitmap_member(
+    const uint32_t *bitmap, BACNET_PROPERTY_ID object_property)
+{
+    if (!bitmap || (object_property >= PROPERTY_LIST_BITMAP_BITS)) {
+        return false;
+    }
+
+    return property_bitmap_member(bitmap, object_property);
+}
+
+#if BACNET_PROPERTY_LISTS
+/**
+ * @brief Determine if this property is a required property of a known
+ *  standard object, in constant time for standard properties.
+ * @param object_type - object-type to be checked
+ * @param object_property - object-property to be checked
+ * @return true if the property is a required property
+ */
+bool property_list_required_member(
+    BACNET_OBJECT_TYPE object_type, BACNET_PROPERTY_ID object_property)
+{
+    if ((object_type <= BACNET_OBJECT_TYPE_LAST) &&
+        (object_property < PROPERTY_BITMAP_BITS)) {
+        return property_bitmap_member(
+            Property_List_Bitmap[Property_Required_Bitmap_Index[object_type]],
+            object_property);
+    }
+
+    return property_list_member(
+        property_list_required(object_type), object_property);
+}
+
+/**
+ * @brief Determine if this property is an optional property of a known
+ *  standard object, in constant time for standard properties.
+ * @param object_type - object-type to be checked
+ * @param object_property - object-property to be checked
+ * @return true if the property is an optional property
+ */
+bool property_list_optional_member(
+    BACNET_OBJECT_TYPE object_type, BACNET_PROPERTY_ID object_property)
+{
+    if ((object_type <= BACNET_OBJECT_TYPE_LAST) &&
+        (object_property < PROPERTY_BITMAP_BITS)) {
+        return property_bitmap_member(
+            Property_List_Bitmap[Property_Optional_Bitmap_Index[object_type]],
+            object_property);
+    }
+
+    return property_list_member(
+        property_list_optional(object_type), object_property);
+}
+#endif
+
+/**
+ * @brief Determine if this property is required to be writable
+ * @note Property Conformance Code of W means writable
+ * @param object_type - object-type to be checked
+ * @param object_property - object-property to be checked
+ * @return true if the property is a required writable property
+ */
+bool property_list_writable_member(
+    BACNET_OBJECT_TYPE object_type, BACNET_PROPERTY_ID object_property)
+{
+    if ((object_type <= BACNET_OBJECT_TYPE_LAST) &&
+        (object_property < PROPERTY_BITMAP_BITS)) {
+        return property_bitmap_member(
+            Property_Writable_Bitmap[Property_Writable_Bitmap_Index
+                                         [object_type]],
+            object_property);
+    }
+
+    return property_list_member(
+        property_list_writable(object_type), object_property);
 }
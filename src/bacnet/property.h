@@ -16,6 +16,11 @@
 #include "bacnet/rp.h"
 #include "bacnet/proplist.h"
 
+/* properties 0 to PROPERTY_LIST_BITMAP_BITS-1 are kept in a property bitmap
+   of PROPERTY_LIST_BITMAP_WORDS words, which covers the standard properties */
+#define PROPERTY_LIST_BITMAP_BITS 512
+#define PROPERTY_LIST_BITMAP_WORDS (PROPERTY_LIST_BITMAP_BITS / 32)
+
 #ifdef __cplusplus
 extern "C" {
 #endif /* __cplusplus */
@@ -37,8 +42,21 @@ BACNET_STACK_EXPORT
 unsigned property_list_special_count(
     BACNET_OBJECT_TYPE object_type, BACNET_PROPERTY_ID special_property);
 BACNET_STACK_EXPORT
+bool property_list_required_member(
+    BACNET_OBJECT_TYPE object_type, BACNET_PROPERTY_ID object_property);
+BACNET_STACK_EXPORT
+bool property_list_optional_member(
+    BACNET_OBJECT_TYPE object_type, BACNET_PROPERTY_ID object_property);
+BACNET_STACK_EXPORT
+const int *property_list_writable(BACNET_OBJECT_TYPE object_type);
+BACNET_STACK_EXPORT
 bool property_list_writable_member(
     BACNET_OBJECT_TYPE object_type, BACNET_PROPERTY_ID object_property);
+BACNET_STACK_EXPORT
+void property_list_bitmap_add(uint32_t *bitmap, const int *pList);
+BACNET_STACK_EXPORT
+bool property_list_bitmap_member(
+    const uint32_t *bitmap, BACNET_PROPERTY_ID object_property);
 
 #ifdef __cplusplus
 }
@@ -6,6 +6,7 @@
  * @date 2005
  * @copyright SPDX-License-Identifier: GPL-2.0-or-later WITH GCC-exception-2.0
  */
+#include <stddef.h>
 #include <stdint.h>
 /* BACnet Stack defines - first */
 #include "bacnet/bacdef.h"
@@ -360,6 +361,95 @@ int rp_ack_encode_apdu_object_property_end(uint8_t *apdu)
     return apdu_len;
 }
 
+/**
+ * @brief Get the space left in the application data of a ReadProperty
+ *  at a position in the application data
+ * @param rpdata [in] property being read
+ * @param apdu [in] position in the application data
+ * @return number of bytes that may be encoded at the position
+ */
+static size_t read_property_apdu_size(
+    const BACNET_READ_PROPERTY_DATA *rpdata, const uint8_t *apdu)
+{
+    size_t offset;
+
+    if (!rpdata || !rpdata->application_data || !apdu ||
+        (apdu < rpdata->application_data) ||
+        (rpdata->application_data_len <= 0)) {
+        return 0;
+    }
+    offset = (size_t)(apdu - rpdata->application_data);
+    if (offset >= (size_t)rpdata->application_data_len) {
+        return 0;
+    }
+
+    return (size_t)rpdata->application_data_len - offset;
+}
+
+/**
+ * @brief Encode a character string property value, checking its length
+ *  against the space left in the application data before encoding it
+ * @param rpdata [in,out] property being read; the error code is set
+ *  when the value does not fit
+ * @param apdu [out] position in the application data, or NULL for length
+ * @param value [in] character string to encode
+ * @return number of bytes encoded, or BACNET_STATUS_ABORT if the value
+ *  does not fit
+ */
+int read_property_character_string_encode(
+    BACNET_READ_PROPERTY_DATA *rpdata,
+    uint8_t *apdu,
+    const BACNET_CHARACTER_STRING *value)
+{
+    int len;
+
+    len = encode_application_character_string(NULL, value);
+    if (apdu) {
+        if ((size_t)len > read_property_apdu_size(rpdata, apdu)) {
+            if (rpdata) {
+                rpdata->error_code =
+                    ERROR_CODE_ABORT_SEGMENTATION_NOT_SUPPORTED;
+            }
+            return BACNET_STATUS_ABORT;
+        }
+        len = encode_application_character_string(apdu, value);
+    }
+
+    return len;
+}
+
+/**
+ * @brief Encode an octet string property value, checking its length
+ *  against the space left in the application data before encoding it
+ * @param rpdata [in,out] property being read; the error code is set
+ *  when the value does not fit
+ * @param apdu [out] position in the application data, or NULL for length
+ * @param value [in] octet string to encode
+ * @return number of bytes encoded, or BACNET_STATUS_ABORT if the value
+ *  does not fit
+ */
+int read_property_octet_string_encode(
+    BACNET_READ_PROPERTY_DATA *rpdata,
+    uint8_t *apdu,
+    const BACNET_OCTET_STRING *value)
+{
+    int len;
+
+    len = encode_application_octet_string(NULL, value);
+    if (apdu) {
+        if ((size_t)len > read_property_apdu_size(rpdata, apdu)) {
+            if (rpdata) {
+                rpdata->error_code =
+                    ERROR_CODE_ABORT_SEGMENTATION_NOT_SUPPORTED;
+            }
+            return BACNET_STATUS_ABORT;
+        }
+        len = encode_application_octet_string(apdu, value);
+    }
+
+    return len;
+}
+
 /** Encode the acknowledge.
  *
  * @param apdu  Pointer to the buffer for encoding, or NULL for length
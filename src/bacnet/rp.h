@@ -12,6 +12,8 @@
 #include <stdbool.h>
 /* BACnet Stack defines - first */
 #include "bacnet/bacdef.h"
+/* BACnet Stack API */
+#include "bacnet/bacstr.h"
 
 typedef struct BACnet_Read_Property_Data {
     BACNET_OBJECT_TYPE object_type;
@@ -83,6 +85,17 @@ int rp_ack_encode_apdu_init(
 BACNET_STACK_EXPORT
 int rp_ack_encode_apdu_object_property_end(uint8_t *apdu);
 
+BACNET_STACK_EXPORT
+int read_property_character_string_encode(
+    BACNET_READ_PROPERTY_DATA *rpdata,
+    uint8_t *apdu,
+    const BACNET_CHARACTER_STRING *value);
+BACNET_STACK_EXPORT
+int read_property_octet_string_encode(
+    BACNET_READ_PROPERTY_DATA *rpdata,
+    uint8_t *apdu,
+    const BACNET_OCTET_STRING *value);
+
 /* method to encode the ack using extra buffer */
 BACNET_STACK_EXPORT
 int rp_ack_encode_apdu(
@@ -512,6 +512,166 @@ int rpm_ack_encode_apdu_object_end(uint8_t *apdu)
     return encode_closing_tag(apdu, 1);
 }
 
+/**
+ * @brief Encode an element of the listOfResults in place: the property
+ *  reference, and the property value read by the object directly into the
+ *  reply, or the propertyAccessError when the read fails.
+ *
+ *  The object is given the remaining capacity of the writer in the
+ *  application data length. When less than RPM_ACK_VALUE_BUFFER_SIZE
+ *  remains, the value is read into a buffer of that size on the stack
+ *  and appended, so that a fixed-size value encoded without checking the
+ *  application data length cannot be written past the reply.
+ * @param writer [in] bounded writer for the reply
+ * @param rpdata [in,out] property to read, and the error class and error
+ *  code when the read fails
+ * @param read_property [in] function to read the property value
+ * @return BACNET_STATUS_OK, BACNET_STATUS_ABORT if the element did not fit,
+ *  or the abort or reject returned by read_property
+ */
+int rpm_ack_property_encode(
+    BACNET_WRITER *writer,
+    BACNET_READ_PROPERTY_DATA *rpdata,
+    read_property_function read_property)
+{
+    uint8_t value[RPM_ACK_VALUE_BUFFER_SIZE];
+    size_t value_offset;
+    size_t remaining;
+    int len;
+
+    if (!writer || !rpdata || !read_property) {
+        return BACNET_STATUS_REJECT;
+    }
+    /* Tag 2: propertyIdentifier */
+    bacnet_writer_context_enumerated(writer, 2, rpdata->object_property);
+    /* Tag 3: optional propertyArrayIndex */
+    if (rpdata->array_index != BACNET_ARRAY_ALL) {
+        bacnet_writer_context_unsigned(writer, 3, rpdata->array_index);
+    }
+    value_offset = bacnet_writer_length(writer);
+    /* Tag 4: propertyValue */
+    bacnet_writer_opening_tag(writer, 4);
+    if (bacnet_writer_overflow(writer)) {
+        rpdata->error_code = ERROR_CODE_ABORT_SEGMENTATION_NOT_SUPPORTED;
+        return BACNET_STATUS_ABORT;
+    }
+    remaining = bacnet_writer_remaining(writer);
+    if (remaining >= sizeof(value)) {
+        rpdata->application_data = bacnet_writer_position(writer);
+    } else {
+        rpdata->application_data = value;
+    }
+    rpdata->application_data_len = (int)remaining;
+    rpdata->error_class = ERROR_CLASS_OBJECT;
+    rpdata->error_code = ERROR_CODE_UNKNOWN_OBJECT;
+    len = read_property(rpdata);
+    if ((len == BACNET_STATUS_ABORT) || (len == BACNET_STATUS_REJECT)) {
+        return len;
+    }
+    if (len < 0) {
+        /* replace the value and its opening tag with the error */
+        bacnet_writer_rewind(writer, value_offset);
+        /* Tag 5: propertyAccessError */
+        bacnet_writer_opening_tag(writer, 5);
+        bacnet_writer_application_enumerated(writer, rpdata->error_class);
+        bacnet_writer_application_enumerated(writer, rpdata->error_code);
+        bacnet_writer_closing_tag(writer, 5);
+    } else if (rpdata->application_data == value) {
+        if (bacnet_writer_append(writer, value, (size_t)len)) {
+            bacnet_writer_closing_tag(writer, 4);
+        }
+    } else if (bacnet_writer_commit(writer, (size_t)len)) {
+        bacnet_writer_closing_tag(writer, 4);
+    }
+    if (bacnet_writer_overflow(writer)) {
+        rpdata->error_code = ERROR_CODE_ABORT_SEGMENTATION_NOT_SUPPORTED;
+        return BACNET_STATUS_ABORT;
+    }
+
+    return BACNET_STATUS_OK;
+}
+
+/**
+ * @brief Encode one property of a property list as an element of the
+ *  listOfResults, reading the value directly into the reply.
+ * @param writer [in] bounded writer for the reply
+ * @param rpdata [in,out] object to read
+ * @param pList [in] list of properties terminated by -1, or NULL
+ * @param read_property [in] function to read the property value
+ * @return BACNET_STATUS_OK, or BACNET_STATUS_ABORT or BACNET_STATUS_REJECT
+ */
+static int rpm_ack_property_list_element_encode(
+    BACNET_WRITER *writer,
+    BACNET_READ_PROPERTY_DATA *rpdata,
+    const int *pList,
+    read_property_function read_property)
+{
+    int len = BACNET_STATUS_OK;
+
+    if (!pList) {
+        return BACNET_STATUS_OK;
+    }
+    while (*pList != -1) {
+        rpdata->object_property = (BACNET_PROPERTY_ID)*pList;
+        rpdata->array_index = BACNET_ARRAY_ALL;
+        len = rpm_ack_property_encode(writer, rpdata, read_property);
+        if (len < 0) {
+            return len;
+        }
+        pList++;
+    }
+
+    return BACNET_STATUS_OK;
+}
+
+/**
+ * @brief Encode the special property ALL, REQUIRED, or OPTIONAL of an
+ *  object as elements of the listOfResults, reading each property value
+ *  directly into the reply.
+ * @param writer [in] bounded writer for the reply
+ * @param rpdata [in,out] object and special property to encode
+ * @param pRequired [in] list of required properties terminated by -1
+ * @param pOptional [in] list of optional properties terminated by -1
+ * @param pProprietary [in] list of proprietary properties terminated by -1
+ * @param read_property [in] function to read each property value
+ * @return BACNET_STATUS_OK, or BACNET_STATUS_ABORT or BACNET_STATUS_REJECT
+ *  with the error code set in rpdata
+ */
+int rpm_ack_property_list_encode(
+    BACNET_WRITER *writer,
+    BACNET_READ_PROPERTY_DATA *rpdata,
+    const int *pRequired,
+    const int *pOptional,
+    const int *pProprietary,
+    read_property_function read_property)
+{
+    int len = BACNET_STATUS_OK;
+    BACNET_PROPERTY_ID special_property;
+
+    if (!writer || !rpdata || !read_property) {
+        return BACNET_STATUS_REJECT;
+    }
+    special_property = rpdata->object_property;
+    if ((special_property == PROP_ALL) ||
+        (special_property == PROP_REQUIRED)) {
+        len = rpm_ack_property_list_element_encode(
+            writer, rpdata, pRequired, read_property);
+    }
+    if ((len == BACNET_STATUS_OK) &&
+        ((special_property == PROP_ALL) ||
+         (special_property == PROP_OPTIONAL))) {
+        len = rpm_ack_property_list_element_encode(
+            writer, rpdata, pOptional, read_property);
+    }
+    if ((len == BACNET_STATUS_OK) && (special_property == PROP_ALL)) {
+        len = rpm_ack_property_list_element_encode(
+            writer, rpdata, pProprietary, read_property);
+    }
+    rpdata->object_property = special_property;
+
+    return len;
+}
+
 #if BACNET_SVC_RPM_A
 /**
  * @brief Decode the ReadPropertyMultiple-Ack object-identifier
@@ -690,17 +850,10 @@ void rpm_ack_object_property_process(
         apdu += len;
         while (apdu_len) {
             if (bacnet_is_closing_tag_number(apdu, apdu_len, 1, &len)) {
-                /*  end of list-of-results [1] SEQUENCE OF SEQUENCE */
+                /*  end of list-of-results [1] SEQUENCE OF SEQUENCE,
+                    followed by the results of the next object, if any */
                 apdu_len -= len;
-                if (apdu_len > 0) {
-                    /* malformed */
-                    rp_data->error_class = ERROR_CLASS_SERVICES;
-                    rp_data->error_code = ERROR_CODE_INVALID_TAG;
-                    if (callback) {
-                        callback(device_id, rp_data);
-                    }
-                    return;
-                }
+                apdu += len;
                 break;
             }
             len = rpm_ack_decode_object_property(
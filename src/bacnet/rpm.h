@@ -17,6 +17,15 @@
 #include "bacnet/bacapp.h"
 #include "bacnet/proplist.h"
 #include "bacnet/rp.h"
+
+/* Property values of the ReadPropertyMultiple-ACK are read in place. Near
+   the end of the reply they are read into a stack buffer of this size, which
+   must hold the largest fixed-size value an object may encode without
+   checking the application data length. */
+#ifndef RPM_ACK_VALUE_BUFFER_SIZE
+#define RPM_ACK_VALUE_BUFFER_SIZE 64
+#endif
+
 /*
  * Bundle together commonly used data items for convenience when calling
  * rpm helper functions.
@@ -57,6 +66,19 @@ typedef void (*rpm_object_property_lists_function)(
     BACNET_OBJECT_TYPE object_type,
     struct special_property_list_t *pPropertyList);
 
+/** Encodes the special property ALL, REQUIRED, or OPTIONAL of an object
+ *  directly into a ReadPropertyMultiple-Ack.
+ * A function template; @see device.c for assignment to object types.
+ * @ingroup ObjHelpers
+ *
+ * @param writer [in] bounded writer for the listOfResults of the reply
+ * @param rpdata [in,out] object instance and special property to encode
+ * @return BACNET_STATUS_OK, or BACNET_STATUS_ABORT or BACNET_STATUS_REJECT
+ *  with the error code set in rpdata
+ */
+typedef int (*read_property_multiple_function)(
+    BACNET_WRITER *writer, BACNET_READ_PROPERTY_DATA *rpdata);
+
 #ifdef __cplusplus
 extern "C" {
 #endif /* __cplusplus */
@@ -141,6 +163,20 @@ int rpm_ack_encode_apdu_object_property_error(
 BACNET_STACK_EXPORT
 int rpm_ack_encode_apdu_object_end(uint8_t *apdu);
 
+BACNET_STACK_EXPORT
+int rpm_ack_property_encode(
+    BACNET_WRITER *writer,
+    BACNET_READ_PROPERTY_DATA *rpdata,
+    read_property_function read_property);
+BACNET_STACK_EXPORT
+int rpm_ack_property_list_encode(
+    BACNET_WRITER *writer,
+    BACNET_READ_PROPERTY_DATA *rpdata,
+    const int *pRequired,
+    const int *pOptional,
+    const int *pProprietary,
+    read_property_function read_property);
+
 BACNET_STACK_EXPORT
 int rpm_ack_decode_object_id(
     const uint8_t *apdu,
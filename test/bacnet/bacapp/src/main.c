@@ -1330,6 +1330,44 @@ static void test_bacapp_sprintf_data(void)
     }
 }
 
+#if defined(CONFIG_ZTEST_NEW_API)
+ZTEST(bacapp_tests, test_bacapp_encode_application_data_writer)
+#else
+static void test_bacapp_encode_application_data_writer(void)
+#endif
+{
+    uint8_t apdu[MAX_APDU] = { 0 };
+    uint8_t test_apdu[MAX_APDU] = { 0 };
+    BACNET_APPLICATION_DATA_VALUE value = { 0 };
+    BACNET_WRITER writer = { 0 };
+    int len = 0, test_len = 0;
+    unsigned i = 0;
+
+    for (i = 0; i < ARRAY_SIZE(tag_list); i++) {
+        memset(&value, 0, sizeof(value));
+        value.tag = tag_list[i];
+        test_len = bacapp_encode_application_data(test_apdu, &value);
+        bacnet_writer_init(&writer, apdu, sizeof(apdu));
+        len = bacapp_encode_application_data_writer(&writer, &value);
+        zassert_equal(len, test_len, "tag=%u", value.tag);
+        zassert_equal(
+            bacnet_writer_length(&writer), test_len, "tag=%u", value.tag);
+        zassert_equal(memcmp(apdu, test_apdu, test_len), 0, NULL);
+        if (test_len > 0) {
+            /* one octet short does not fit and is not written */
+            bacnet_writer_init(&writer, apdu, test_len - 1);
+            len = bacapp_encode_application_data_writer(&writer, &value);
+            zassert_equal(len, 0, "tag=%u", value.tag);
+            zassert_true(bacnet_writer_overflow(&writer), NULL);
+            zassert_equal(bacnet_writer_length(&writer), 0, NULL);
+        }
+    }
+    len = bacapp_encode_application_data_writer(NULL, &value);
+    zassert_equal(len, 0, NULL);
+    len = bacapp_encode_application_data_writer(&writer, NULL);
+    zassert_equal(len, 0, NULL);
+}
+
 /**
  * @}
  */
@@ -1350,7 +1388,8 @@ void test_main(void)
         ztest_unit_test(testBACnetApplicationDataLength),
         ztest_unit_test(testBACnetApplicationData_Safe),
         ztest_unit_test(test_bacapp_data),
-        ztest_unit_test(test_bacapp_sprintf_data));
+        ztest_unit_test(test_bacapp_sprintf_data),
+        ztest_unit_test(test_bacapp_encode_application_data_writer));
 
     ztest_run_test_suite(bacapp_tests);
 }
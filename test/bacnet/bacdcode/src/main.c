@@ -1998,6 +1998,89 @@ static void test_bacnet_array_encode(void)
     zassert_true(apdu_len == BACNET_STATUS_ABORT, NULL);
 }
 
+#if defined(CONFIG_ZTEST_NEW_API)
+ZTEST(bacdcode_tests, test_bacnet_writer)
+#else
+static void test_bacnet_writer(void)
+#endif
+{
+    uint8_t apdu[MAX_APDU] = { 0 };
+    uint8_t test_apdu[MAX_APDU] = { 0 };
+    BACNET_WRITER writer = { 0 };
+    BACNET_CHARACTER_STRING char_string = { 0 };
+    BACNET_DATE bdate = { 0 };
+    int len = 0, test_len = 0;
+    size_t mark = 0;
+    bool status = false;
+
+    /* each encoding matches the unbounded encoder */
+    bacnet_writer_init(&writer, apdu, sizeof(apdu));
+    zassert_equal(bacnet_writer_remaining(&writer), sizeof(apdu), NULL);
+    len = bacnet_writer_opening_tag(&writer, 4);
+    test_len = encode_opening_tag(&test_apdu[test_len], 4);
+    zassert_equal(len, test_len, NULL);
+    len = bacnet_writer_application_unsigned(&writer, 0x12345678);
+    test_len += encode_application_unsigned(&test_apdu[test_len], 0x12345678);
+    zassert_true(len > 0, NULL);
+    len = bacnet_writer_context_enumerated(&writer, 2, PROP_PRESENT_VALUE);
+    test_len += encode_context_enumerated(
+        &test_apdu[test_len], 2, PROP_PRESENT_VALUE);
+    zassert_true(len > 0, NULL);
+    len = bacnet_writer_application_real(&writer, 3.14159f);
+    test_len += encode_application_real(&test_apdu[test_len], 3.14159f);
+    zassert_true(len > 0, NULL);
+    len = bacnet_writer_context_object_id(&writer, 0, OBJECT_DEVICE, 1234);
+    test_len += encode_context_object_id(
+        &test_apdu[test_len], 0, OBJECT_DEVICE, 1234);
+    zassert_true(len > 0, NULL);
+    datetime_set_date(&bdate, 2024, 2, 29);
+    len = bacnet_writer_application_date(&writer, &bdate);
+    test_len += encode_application_date(&test_apdu[test_len], &bdate);
+    zassert_true(len > 0, NULL);
+    characterstring_init_ansi(&char_string, "BACnet");
+    len = bacnet_writer_application_character_string(&writer, &char_string);
+    test_len += encode_application_character_string(
+        &test_apdu[test_len], &char_string);
+    zassert_true(len > 0, NULL);
+    len = bacnet_writer_closing_tag(&writer, 4);
+    test_len += encode_closing_tag(&test_apdu[test_len], 4);
+    zassert_true(len > 0, NULL);
+    zassert_false(bacnet_writer_overflow(&writer), NULL);
+    zassert_equal(bacnet_writer_length(&writer), test_len, NULL);
+    zassert_equal(memcmp(apdu, test_apdu, test_len), 0, NULL);
+    /* an encoding that does not fit is not written, and is sticky */
+    bacnet_writer_init(&writer, apdu, 6);
+    len = bacnet_writer_application_unsigned(&writer, 1);
+    zassert_equal(len, 2, NULL);
+    mark = bacnet_writer_length(&writer);
+    len = bacnet_writer_application_character_string(&writer, &char_string);
+    zassert_equal(len, 0, NULL);
+    zassert_true(bacnet_writer_overflow(&writer), NULL);
+    zassert_equal(bacnet_writer_length(&writer), mark, NULL);
+    len = bacnet_writer_application_null(&writer);
+    zassert_equal(len, 0, NULL);
+    zassert_equal(bacnet_writer_remaining(&writer), 0, NULL);
+    /* rewind clears the overflow so a shorter encoding can be tried */
+    bacnet_writer_rewind(&writer, mark);
+    zassert_false(bacnet_writer_overflow(&writer), NULL);
+    len = bacnet_writer_application_enumerated(&writer, 1);
+    zassert_equal(len, 2, NULL);
+    status = bacnet_writer_append(&writer, test_apdu, 2);
+    zassert_true(status, NULL);
+    zassert_equal(bacnet_writer_remaining(&writer), 0, NULL);
+    status = bacnet_writer_append(&writer, test_apdu, 1);
+    zassert_false(status, NULL);
+    /* primitives near the end of the buffer are sized exactly */
+    bacnet_writer_init(&writer, apdu, 5);
+    len = bacnet_writer_application_real(&writer, 1.0f);
+    zassert_equal(len, 5, NULL);
+    zassert_false(bacnet_writer_overflow(&writer), NULL);
+    /* NULL writer */
+    len = bacnet_writer_application_null(NULL);
+    zassert_equal(len, 0, NULL);
+    zassert_true(bacnet_writer_overflow(NULL), NULL);
+}
+
 /**
  * @}
  */
@@ -2037,7 +2120,8 @@ void test_main(void)
         ztest_unit_test(testDateRangeContextDecodes),
         ztest_unit_test(testOctetStringContextDecodes),
         ztest_unit_test(testBACDCodeDouble),
-        ztest_unit_test(test_bacnet_array_encode));
+        ztest_unit_test(test_bacnet_array_encode),
+        ztest_unit_test(test_bacnet_writer));
 
     ztest_run_test_suite(bacdcode_tests);
 }
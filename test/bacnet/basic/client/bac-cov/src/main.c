@@ -0,0 +1,440 @@
+/**
+ * @file
+ * @brief Unit test for the client COV subscription manager
+ * @author Steve Karg <skarg@users.sourceforge.net>
+ * @date 2024
+ * @copyright SPDX-License-Identifier: MIT
+ */
+#include <zephyr/ztest.h>
+#include <bacnet/cov.h>
+#include <bacnet/basic/client/bac-cov.h>
+#include <bacnet/basic/client/bac-rw.h>
+#include <bacnet/basic/service/h_apdu.h>
+#include <bacnet/basic/service/h_ccov.h>
+#include <bacnet/basic/service/h_ucov.h>
+
+/**
+ * @addtogroup bacnet_tests
+ * @{
+ */
+
+#define TEST_LIFETIME 300
+#define TEST_OBJECTS 100
+#define TEST_STEP_MS 100UL
+
+static unsigned long Test_Milliseconds;
+/* the SubscribeCOV requests queued */
+static bool Test_Queue_Status;
+static unsigned Test_Queue_Count;
+/* the requests of each object of device 1 */
+static unsigned Test_Request_Count[TEST_OBJECTS];
+static unsigned long Test_Request_Time[TEST_OBJECTS];
+static uint32_t Test_Process_ID;
+static uint32_t Test_Lifetime;
+static bool Test_Cancel;
+/* the handlers that the manager sets */
+static bacnet_read_write_cov_callback_t Test_COV_Result;
+static BACNET_COV_NOTIFICATION *Test_COV_Notification;
+/* the notifications delivered to the consumers */
+static uint32_t Test_Notified_Instance;
+
+unsigned long mstimer_now(void)
+{
+    return Test_Milliseconds;
+}
+
+void apdu_set_unconfirmed_handler(
+    BACNET_UNCONFIRMED_SERVICE service_choice, unconfirmed_function pFunction)
+{
+    (void)service_choice;
+    (void)pFunction;
+}
+
+void handler_ucov_notification(
+    uint8_t *service_request, uint16_t service_len, BACNET_ADDRESS *src)
+{
+    (void)service_request;
+    (void)service_len;
+    (void)src;
+}
+
+void handler_ucov_notification_add(BACNET_COV_NOTIFICATION *callback)
+{
+    Test_COV_Notification = callback;
+}
+
+void handler_ccov_notification_add(BACNET_COV_NOTIFICATION *callback)
+{
+    (void)callback;
+}
+
+void bacnet_read_write_cov_callback_set(
+    bacnet_read_write_cov_callback_t callback)
+{
+    Test_COV_Result = callback;
+}
+
+bool bacnet_subscribe_cov_queue(
+    uint32_t device_id,
+    BACNET_OBJECT_TYPE object_type,
+    uint32_t object_instance,
+    uint32_t process_id,
+    uint32_t lifetime,
+    bool cancel)
+{
+    (void)object_type;
+    if (!Test_Queue_Status) {
+        return false;
+    }
+    Test_Queue_Count++;
+    if ((device_id == 1) && (object_instance < TEST_OBJECTS)) {
+        Test_Request_Count[object_instance]++;
+        Test_Request_Time[object_instance] = Test_Milliseconds;
+    }
+    Test_Process_ID = process_id;
+    Test_Lifetime = lifetime;
+    Test_Cancel = cancel;
+
+    return true;
+}
+
+/**
+ * @brief Consumer of the COV notifications, counting them in its context
+ */
+static void test_cov_callback(BACNET_COV_DATA *cov_data, void *context)
+{
+    unsigned *count = context;
+
+    Test_Notified_Instance = cov_data->monitoredObjectIdentifier.instance;
+    (*count)++;
+}
+
+/**
+ * @brief Initialize the module under test, and the test stubs
+ */
+static void test_cov_init(void)
+{
+    unsigned i;
+
+    Test_Milliseconds = 0;
+    Test_Queue_Status = true;
+    Test_Queue_Count = 0;
+    for (i = 0; i < TEST_OBJECTS; i++) {
+        Test_Request_Count[i] = 0;
+        Test_Request_Time[i] = 0;
+    }
+    bacnet_cov_init();
+    bacnet_cov_lifetime_set(TEST_LIFETIME);
+    zassert_not_null(Test_COV_Result, NULL);
+    zassert_not_null(Test_COV_Notification, NULL);
+}
+
+/**
+ * @brief Answer a SubscribeCOV request
+ */
+static void test_cov_result(
+    uint32_t device_id,
+    uint32_t object_instance,
+    uint32_t lifetime,
+    BACNET_ERROR_CODE error_code)
+{
+    BACNET_SUBSCRIBE_COV_DATA cov_data = { 0 };
+
+    cov_data.subscriberProcessIdentifier = Test_Process_ID;
+    cov_data.monitoredObjectIdentifier.type = OBJECT_ANALOG_INPUT;
+    cov_data.monitoredObjectIdentifier.instance = object_instance;
+    cov_data.lifetime = lifetime;
+    cov_data.error_class = ERROR_CLASS_SERVICES;
+    cov_data.error_code = error_code;
+    Test_COV_Result(device_id, &cov_data);
+}
+
+/**
+ * @brief Deliver a COV notification
+ */
+static void test_cov_notify(
+    uint32_t process_id,
+    uint32_t device_id,
+    uint32_t object_instance,
+    uint32_t time_remaining)
+{
+    BACNET_COV_DATA cov_data = { 0 };
+
+    cov_data.subscriberProcessIdentifier = process_id;
+    cov_data.initiatingDeviceIdentifier = device_id;
+    cov_data.monitoredObjectIdentifier.type = OBJECT_ANALOG_INPUT;
+    cov_data.monitoredObjectIdentifier.instance = object_instance;
+    cov_data.timeRemaining = time_remaining;
+    Test_COV_Notification->callback(&cov_data);
+}
+
+/**
+ * @brief Run the task until a time
+ */
+static void test_cov_run(unsigned long milliseconds)
+{
+    while (Test_Milliseconds < milliseconds) {
+        Test_Milliseconds += TEST_STEP_MS;
+        bacnet_cov_task();
+    }
+}
+
+/**
+ * @brief Test the consumers that share a subscription, and the routing
+ *  of the notifications to them
+ */
+#if defined(CONFIG_ZTEST_NEW_API)
+ZTEST(bac_cov_tests, testCOVSubscribe)
+#else
+static void testCOVSubscribe(void)
+#endif
+{
+    unsigned count[2] = { 0 };
+    unsigned many_count = 0;
+    uint32_t instance;
+
+    test_cov_init();
+    zassert_true(
+        bacnet_cov_subscribe(
+            1, OBJECT_ANALOG_INPUT, 1, test_cov_callback, &count[0]),
+        NULL);
+    zassert_true(
+        bacnet_cov_subscribe(
+            1, OBJECT_ANALOG_INPUT, 1, test_cov_callback, &count[0]),
+        NULL);
+    zassert_true(
+        bacnet_cov_subscribe(
+            1, OBJECT_ANALOG_INPUT, 1, test_cov_callback, &count[1]),
+        NULL);
+    zassert_equal(bacnet_cov_subscription_count(), 1, NULL);
+    zassert_true(
+        bacnet_cov_subscribe(
+            1, OBJECT_ANALOG_INPUT, 2, test_cov_callback, &count[0]),
+        NULL);
+    zassert_true(
+        bacnet_cov_subscribe(
+            2, OBJECT_ANALOG_INPUT, 1, test_cov_callback, &count[0]),
+        NULL);
+    zassert_equal(bacnet_cov_subscription_count(), 3, NULL);
+    zassert_false(
+        bacnet_cov_subscribe(1, OBJECT_ANALOG_INPUT, 1, NULL, NULL), NULL);
+    zassert_false(
+        bacnet_cov_subscribe(
+            BACNET_MAX_INSTANCE, OBJECT_ANALOG_INPUT, 1, test_cov_callback,
+            NULL),
+        NULL);
+    zassert_equal(
+        bacnet_cov_status(1, OBJECT_ANALOG_INPUT, 1),
+        BACNET_COV_STATUS_PENDING, NULL);
+    zassert_equal(
+        bacnet_cov_status(1, OBJECT_ANALOG_INPUT, 3), BACNET_COV_STATUS_NONE,
+        NULL);
+    /* one request for each subscription */
+    test_cov_run(TEST_STEP_MS);
+    zassert_equal(Test_Queue_Count, 3, NULL);
+    zassert_equal(Test_Lifetime, TEST_LIFETIME, NULL);
+    zassert_false(Test_Cancel, NULL);
+    /* each consumer of the object is notified once */
+    test_cov_notify(Test_Process_ID, 1, 1, 0);
+    zassert_equal(count[0], 1, NULL);
+    zassert_equal(count[1], 1, NULL);
+    test_cov_notify(Test_Process_ID, 1, 2, 0);
+    zassert_equal(count[0], 2, NULL);
+    zassert_equal(count[1], 1, NULL);
+    zassert_equal(Test_Notified_Instance, 2, NULL);
+    /* notifications of other subscribers and objects are ignored */
+    test_cov_notify(Test_Process_ID + 1, 1, 1, 0);
+    test_cov_notify(Test_Process_ID, 3, 1, 0);
+    test_cov_notify(Test_Process_ID, 1, 3, 0);
+    zassert_equal(count[0], 2, NULL);
+    zassert_equal(count[1], 1, NULL);
+    /* many subscriptions are routed by their device and object */
+    for (instance = 0; instance < 1000; instance++) {
+        zassert_true(
+            bacnet_cov_subscribe(
+                10, OBJECT_ANALOG_INPUT, instance, test_cov_callback,
+                &many_count),
+            NULL);
+    }
+    zassert_equal(bacnet_cov_subscription_count(), 1003, NULL);
+    for (instance = 0; instance < 1000; instance++) {
+        test_cov_notify(Test_Process_ID, 10, instance, 0);
+        zassert_equal(many_count, instance + 1, NULL);
+        zassert_equal(Test_Notified_Instance, instance, NULL);
+    }
+    /* the notification extends an active subscription */
+    test_cov_result(1, 2, 60, ERROR_CODE_SUCCESS);
+    zassert_equal(
+        bacnet_cov_status(1, OBJECT_ANALOG_INPUT, 2), BACNET_COV_STATUS_ACTIVE,
+        NULL);
+    Test_Milliseconds = 50000;
+    test_cov_notify(Test_Process_ID, 1, 2, 120);
+    Test_Milliseconds = 61000;
+    zassert_equal(
+        bacnet_cov_status(1, OBJECT_ANALOG_INPUT, 2), BACNET_COV_STATUS_ACTIVE,
+        NULL);
+    Test_Milliseconds = 171000;
+    zassert_equal(
+        bacnet_cov_status(1, OBJECT_ANALOG_INPUT, 2),
+        BACNET_COV_STATUS_PENDING, NULL);
+    /* the subscription is cancelled with its last consumer */
+    zassert_true(
+        bacnet_cov_unsubscribe(
+            1, OBJECT_ANALOG_INPUT, 1, test_cov_callback, &count[0]),
+        NULL);
+    zassert_false(
+        bacnet_cov_unsubscribe(
+            1, OBJECT_ANALOG_INPUT, 1, test_cov_callback, &count[0]),
+        NULL);
+    zassert_equal(bacnet_cov_subscription_count(), 1003, NULL);
+    test_cov_notify(Test_Process_ID, 1, 1, 0);
+    zassert_equal(count[0], 3, NULL);
+    zassert_equal(count[1], 2, NULL);
+    zassert_true(
+        bacnet_cov_unsubscribe(
+            1, OBJECT_ANALOG_INPUT, 1, test_cov_callback, &count[1]),
+        NULL);
+    zassert_equal(bacnet_cov_subscription_count(), 1002, NULL);
+    zassert_true(Test_Cancel, NULL);
+    zassert_equal(Test_Lifetime, 0, NULL);
+    zassert_equal(
+        bacnet_cov_status(1, OBJECT_ANALOG_INPUT, 1), BACNET_COV_STATUS_NONE,
+        NULL);
+    /* the free subscription is used again */
+    zassert_true(
+        bacnet_cov_subscribe(
+            1, OBJECT_ANALOG_INPUT, 1, test_cov_callback, &count[1]),
+        NULL);
+    zassert_equal(bacnet_cov_subscription_count(), 1003, NULL);
+    test_cov_notify(Test_Process_ID, 1, 1, 0);
+    zassert_equal(count[1], 3, NULL);
+    bacnet_cov_init();
+    zassert_equal(bacnet_cov_subscription_count(), 0, NULL);
+}
+
+/**
+ * @brief Test the renewal of the subscriptions before their lifetime
+ *  lapses, and the spread of the renewals
+ */
+#if defined(CONFIG_ZTEST_NEW_API)
+ZTEST(bac_cov_tests, testCOVRenew)
+#else
+static void testCOVRenew(void)
+#endif
+{
+    unsigned long renew_min, renew_max, retry;
+    unsigned seconds[TEST_OBJECTS] = { 0 };
+    unsigned count = 0, distinct = 0;
+    uint32_t instance;
+    unsigned i;
+
+    test_cov_init();
+    for (instance = 0; instance < TEST_OBJECTS; instance++) {
+        zassert_true(
+            bacnet_cov_subscribe(
+                1, OBJECT_ANALOG_INPUT, instance, test_cov_callback, &count),
+            NULL);
+    }
+    zassert_true(
+        bacnet_cov_subscribe(
+            2, OBJECT_ANALOG_INPUT, 0, test_cov_callback, &count),
+        NULL);
+    /* a full queue continues the scan at the next task */
+    Test_Queue_Status = false;
+    test_cov_run(TEST_STEP_MS);
+    zassert_equal(Test_Queue_Count, 0, NULL);
+    Test_Queue_Status = true;
+    bacnet_cov_task();
+    zassert_equal(Test_Queue_Count, TEST_OBJECTS + 1, NULL);
+    /* a request in flight is not sent again */
+    test_cov_run(10000);
+    zassert_equal(Test_Queue_Count, TEST_OBJECTS + 1, NULL);
+    renew_min = Test_Milliseconds + (TEST_LIFETIME * 1000UL / 2);
+    renew_max = Test_Milliseconds + (TEST_LIFETIME * 1000UL * 3 / 4);
+    for (instance = 0; instance < TEST_OBJECTS; instance++) {
+        test_cov_result(1, instance, TEST_LIFETIME, ERROR_CODE_SUCCESS);
+        zassert_equal(
+            bacnet_cov_status(1, OBJECT_ANALOG_INPUT, instance),
+            BACNET_COV_STATUS_ACTIVE, NULL);
+    }
+    /* renewed between one half and three quarters of the lifetime */
+    test_cov_run(renew_min - TEST_STEP_MS);
+    zassert_equal(Test_Queue_Count, TEST_OBJECTS + 1, NULL);
+    test_cov_run(renew_max + TEST_STEP_MS);
+    zassert_equal(Test_Queue_Count, (2 * TEST_OBJECTS) + 1, NULL);
+    for (instance = 0; instance < TEST_OBJECTS; instance++) {
+        zassert_equal(Test_Request_Count[instance], 2, NULL);
+        zassert_true(Test_Request_Time[instance] >= renew_min, NULL);
+        zassert_true(
+            Test_Request_Time[instance] <= (renew_max + TEST_STEP_MS), NULL);
+        seconds[(Test_Request_Time[instance] - renew_min) / 1000UL]++;
+    }
+    /* the renewals are spread, and not sent in a burst */
+    for (i = 0; i < TEST_OBJECTS; i++) {
+        if (seconds[i] > 0) {
+            distinct++;
+        }
+        zassert_true(seconds[i] <= 8, "second=%u renewals=%u", i, seconds[i]);
+    }
+    zassert_true(distinct >= 25, "distinct=%u", distinct);
+    /* active until the lifetime lapses while the renewal is outstanding */
+    zassert_equal(
+        bacnet_cov_status(1, OBJECT_ANALOG_INPUT, 0), BACNET_COV_STATUS_ACTIVE,
+        NULL);
+    test_cov_run(renew_min + (TEST_LIFETIME * 1000UL / 2));
+    zassert_equal(
+        bacnet_cov_status(1, OBJECT_ANALOG_INPUT, 0),
+        BACNET_COV_STATUS_PENDING, NULL);
+    /* a renewal that timed out is retried after 10 to 20 seconds */
+    retry = Test_Milliseconds;
+    test_cov_result(1, 0, 0, ERROR_CODE_ABORT_TSM_TIMEOUT);
+    test_cov_run(retry + 10000UL - TEST_STEP_MS);
+    zassert_equal(Test_Request_Count[0], 2, NULL);
+    test_cov_run(retry + 20000UL + TEST_STEP_MS);
+    zassert_equal(Test_Request_Count[0], 3, NULL);
+    test_cov_result(1, 0, TEST_LIFETIME, ERROR_CODE_SUCCESS);
+    zassert_equal(
+        bacnet_cov_status(1, OBJECT_ANALOG_INPUT, 0), BACNET_COV_STATUS_ACTIVE,
+        NULL);
+    /* a refused subscription is tried again after a lifetime */
+    retry = Test_Milliseconds;
+    test_cov_result(1, 1, TEST_LIFETIME, ERROR_CODE_UNKNOWN_OBJECT);
+    zassert_equal(
+        bacnet_cov_status(1, OBJECT_ANALOG_INPUT, 1), BACNET_COV_STATUS_FAILED,
+        NULL);
+    test_cov_run(retry + (TEST_LIFETIME * 1000UL) - TEST_STEP_MS);
+    zassert_equal(Test_Request_Count[1], 2, NULL);
+    test_cov_run(retry + (2 * TEST_LIFETIME * 1000UL) + TEST_STEP_MS);
+    zassert_equal(Test_Request_Count[1], 3, NULL);
+    /* a device without SubscribeCOV is not asked again */
+    test_cov_result(1, 2, 0, ERROR_CODE_REJECT_UNRECOGNIZED_SERVICE);
+    for (instance = 0; instance < TEST_OBJECTS; instance++) {
+        zassert_equal(
+            bacnet_cov_status(1, OBJECT_ANALOG_INPUT, instance),
+            BACNET_COV_STATUS_UNSUPPORTED, NULL);
+        Test_Request_Count[instance] = 0;
+    }
+    zassert_equal(
+        bacnet_cov_status(2, OBJECT_ANALOG_INPUT, 0),
+        BACNET_COV_STATUS_PENDING, NULL);
+    test_cov_run(Test_Milliseconds + (2 * TEST_LIFETIME * 1000UL));
+    for (instance = 0; instance < TEST_OBJECTS; instance++) {
+        zassert_equal(Test_Request_Count[instance], 0, NULL);
+    }
+}
+/**
+ * @}
+ */
+
+#if defined(CONFIG_ZTEST_NEW_API)
+ZTEST_SUITE(bac_cov_tests, NULL, NULL, NULL, NULL, NULL);
+#else
+void test_main(void)
+{
+    ztest_test_suite(
+        bac_cov_tests, ztest_unit_test(testCOVSubscribe),
+        ztest_unit_test(testCOVRenew));
+
+    ztest_run_test_suite(bac_cov_tests);
+}
+#endif
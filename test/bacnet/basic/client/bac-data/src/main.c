@@ -0,0 +1,601 @@
+/**
+ * @file
+ * @brief Unit test for the remote point cache of the BACnet data client
+ * @author Steve Karg <skarg@users.sourceforge.net>
+ * @date 2024
+ * @copyright SPDX-License-Identifier: MIT
+ */
+#include <math.h>
+#include <string.h>
+#include <zephyr/ztest.h>
+#include <bacnet/bacapp.h>
+#include <bacnet/cov.h>
+#include <bacnet/rp.h>
+#include <bacnet/rpm.h>
+#include <bacnet/basic/binding/address.h>
+#include <bacnet/basic/client/bac-cov.h>
+#include <bacnet/basic/client/bac-data.h>
+#include <bacnet/basic/client/bac-rw.h>
+
+/**
+ * @addtogroup bacnet_tests
+ * @{
+ */
+
+#define TEST_POLL_MS (60UL * 1000UL)
+#define TEST_DEVICES 10
+#define TEST_OBJECTS 200
+
+static unsigned long Test_Milliseconds;
+/* the max APDU of the bound devices, or 0 when not bound */
+static unsigned Test_Max_APDU;
+static bool Test_Device_Idle;
+/* the ReadPropertyMultiple and ReadProperty requests queued */
+static bool Test_RPM_Status;
+static unsigned Test_RPM_Count;
+static uint32_t Test_RPM_Device_ID;
+static unsigned Test_RPM_Objects;
+static unsigned Test_RPM_Properties;
+static unsigned Test_RP_Count;
+/* the COV subscriptions */
+static BACNET_COV_STATUS Test_COV_Status;
+static unsigned Test_Subscribe_Count;
+static unsigned Test_Unsubscribe_Count;
+static bacnet_cov_callback_t Test_COV_Callback;
+
+unsigned long mstimer_now(void)
+{
+    return Test_Milliseconds;
+}
+
+bool address_get_by_device(
+    uint32_t device_id, unsigned *max_apdu, BACNET_ADDRESS *src)
+{
+    (void)device_id;
+    (void)src;
+    if (Test_Max_APDU == 0) {
+        return false;
+    }
+    *max_apdu = Test_Max_APDU;
+
+    return true;
+}
+
+void bacnet_read_write_init(void)
+{
+}
+
+void bacnet_read_write_task(void)
+{
+}
+
+void bacnet_read_write_value_callback_set(
+    bacnet_read_write_value_callback_t callback)
+{
+    (void)callback;
+}
+
+bool bacnet_read_write_busy(void)
+{
+    return false;
+}
+
+bool bacnet_read_write_device_idle(uint32_t device_id)
+{
+    (void)device_id;
+
+    return Test_Device_Idle;
+}
+
+bool bacnet_read_property_queue(
+    uint32_t device_id,
+    BACNET_OBJECT_TYPE object_type,
+    uint32_t object_instance,
+    BACNET_PROPERTY_ID object_property,
+    uint32_t array_index)
+{
+    (void)device_id;
+    (void)object_type;
+    (void)object_instance;
+    (void)object_property;
+    (void)array_index;
+    Test_RP_Count++;
+
+    return true;
+}
+
+bool bacnet_read_property_multiple_queue(
+    uint32_t device_id, BACNET_READ_ACCESS_DATA *read_access_data)
+{
+    const BACNET_READ_ACCESS_DATA *rad;
+    const BACNET_PROPERTY_REFERENCE *reference;
+
+    if (!Test_RPM_Status) {
+        return false;
+    }
+    Test_RPM_Count++;
+    Test_RPM_Device_ID = device_id;
+    Test_RPM_Objects = 0;
+    Test_RPM_Properties = 0;
+    for (rad = read_access_data; rad; rad = rad->next) {
+        Test_RPM_Objects++;
+        for (reference = rad->listOfProperties; reference;
+             reference = reference->next) {
+            Test_RPM_Properties++;
+        }
+    }
+
+    return true;
+}
+
+void bacnet_cov_init(void)
+{
+}
+
+void bacnet_cov_task(void)
+{
+}
+
+void bacnet_cov_lifetime_set(uint32_t seconds)
+{
+    (void)seconds;
+}
+
+bool bacnet_cov_subscribe(
+    uint32_t device_id,
+    BACNET_OBJECT_TYPE object_type,
+    uint32_t object_instance,
+    bacnet_cov_callback_t callback,
+    void *context)
+{
+    (void)device_id;
+    (void)object_type;
+    (void)object_instance;
+    (void)context;
+    Test_COV_Callback = callback;
+    Test_Subscribe_Count++;
+
+    return true;
+}
+
+bool bacnet_cov_unsubscribe(
+    uint32_t device_id,
+    BACNET_OBJECT_TYPE object_type,
+    uint32_t object_instance,
+    bacnet_cov_callback_t callback,
+    void *context)
+{
+    (void)device_id;
+    (void)object_type;
+    (void)object_instance;
+    (void)callback;
+    (void)context;
+    Test_Unsubscribe_Count++;
+
+    return true;
+}
+
+BACNET_COV_STATUS bacnet_cov_status(
+    uint32_t device_id,
+    BACNET_OBJECT_TYPE object_type,
+    uint32_t object_instance)
+{
+    (void)device_id;
+    (void)object_type;
+    (void)object_instance;
+
+    return Test_COV_Status;
+}
+
+/**
+ * @brief Initialize the module under test, and the test stubs
+ */
+static void test_data_init(uint32_t cov_lifetime)
+{
+    Test_Milliseconds = 0;
+    Test_Max_APDU = MAX_APDU;
+    Test_Device_Idle = true;
+    Test_RPM_Status = true;
+    Test_RPM_Count = 0;
+    Test_RP_Count = 0;
+    Test_COV_Status = BACNET_COV_STATUS_NONE;
+    Test_Subscribe_Count = 0;
+    Test_Unsubscribe_Count = 0;
+    Test_COV_Callback = NULL;
+    bacnet_data_init();
+    bacnet_data_cov_lifetime_set(cov_lifetime);
+}
+
+/**
+ * @brief Store a REAL value in a point, as a ReadProperty-ACK would
+ */
+static void test_value_save(
+    uint32_t device_id,
+    BACNET_OBJECT_TYPE object_type,
+    uint32_t object_instance,
+    BACNET_PROPERTY_ID object_property,
+    float real_value)
+{
+    BACNET_READ_PROPERTY_DATA rp_data = { 0 };
+    BACNET_APPLICATION_DATA_VALUE value = { 0 };
+
+    rp_data.object_type = object_type;
+    rp_data.object_instance = object_instance;
+    rp_data.object_property = object_property;
+    rp_data.array_index = BACNET_ARRAY_ALL;
+    rp_data.error_code = ERROR_CODE_SUCCESS;
+    value.tag = BACNET_APPLICATION_TAG_REAL;
+    value.type.Real = real_value;
+    bacnet_data_value_save(device_id, &rp_data, &value);
+}
+
+/**
+ * @brief Report a service error of a device, as a Reject or Abort would
+ */
+static void
+test_service_error(uint32_t device_id, BACNET_ERROR_CODE error_code)
+{
+    BACNET_READ_PROPERTY_DATA rp_data = { 0 };
+
+    rp_data.object_type = OBJECT_ANALOG_INPUT;
+    rp_data.error_class = ERROR_CLASS_SERVICES;
+    rp_data.error_code = error_code;
+    bacnet_data_value_save(device_id, &rp_data, NULL);
+}
+
+/**
+ * @brief Run the task after the poll interval, so every point is due
+ */
+static void test_poll_interval(void)
+{
+    Test_Milliseconds += TEST_POLL_MS;
+    bacnet_data_task();
+}
+
+/**
+ * @brief Check the value of a point
+ */
+static void test_point_check(
+    uint32_t device_id,
+    BACNET_OBJECT_TYPE object_type,
+    uint32_t object_instance,
+    BACNET_PROPERTY_ID object_property,
+    float real_value)
+{
+    BACNET_APPLICATION_DATA_VALUE value = { 0 };
+    bool status;
+
+    status = bacnet_data_point_value(
+        device_id, object_type, object_instance, object_property, &value);
+    zassert_true(status, "device=%u instance=%u", device_id, object_instance);
+    zassert_equal(value.tag, BACNET_APPLICATION_TAG_REAL, NULL);
+    zassert_false(islessgreater(value.type.Real, real_value), NULL);
+}
+
+/**
+ * @brief Test the hashed lookup of many points while they are added
+ *  and removed, and the table grows
+ */
+#if defined(CONFIG_ZTEST_NEW_API)
+ZTEST(bac_data_tests, testDataPointHash)
+#else
+static void testDataPointHash(void)
+#endif
+{
+    BACNET_APPLICATION_DATA_VALUE value = { 0 };
+    uint32_t device_id, instance;
+    unsigned long count = 0;
+    float real_value;
+
+    test_data_init(0);
+    zassert_equal(bacnet_data_point_count(), 0, NULL);
+    /* the same object instance in each device, and two properties */
+    for (device_id = 1; device_id <= TEST_DEVICES; device_id++) {
+        for (instance = 0; instance < TEST_OBJECTS; instance++) {
+            zassert_true(
+                bacnet_data_point_add(
+                    device_id, OBJECT_ANALOG_INPUT, instance,
+                    PROP_PRESENT_VALUE),
+                NULL);
+            zassert_true(
+                bacnet_data_point_add(
+                    device_id, OBJECT_ANALOG_INPUT, instance,
+                    PROP_COV_INCREMENT),
+                NULL);
+            count += 2;
+        }
+    }
+    zassert_equal(bacnet_data_point_count(), count, NULL);
+    /* an existing point is not added again */
+    zassert_true(
+        bacnet_data_point_add(1, OBJECT_ANALOG_INPUT, 0, PROP_PRESENT_VALUE),
+        NULL);
+    zassert_equal(bacnet_data_point_count(), count, NULL);
+    zassert_false(
+        bacnet_data_point_add(
+            BACNET_MAX_INSTANCE, OBJECT_ANALOG_INPUT, 0, PROP_PRESENT_VALUE),
+        NULL);
+    zassert_false(
+        bacnet_data_point_add(1, OBJECT_ANALOG_INPUT, 0, PROP_ALL), NULL);
+    /* a point has no value until one is stored */
+    zassert_false(
+        bacnet_data_point_value(
+            1, OBJECT_ANALOG_INPUT, 0, PROP_PRESENT_VALUE, &value),
+        NULL);
+    zassert_true(
+        bacnet_data_point_stale(1, OBJECT_ANALOG_INPUT, 0, PROP_PRESENT_VALUE),
+        NULL);
+    /* each point keeps its own value */
+    for (device_id = 1; device_id <= TEST_DEVICES; device_id++) {
+        for (instance = 0; instance < TEST_OBJECTS; instance++) {
+            real_value = (float)((device_id * 1000) + instance);
+            test_value_save(
+                device_id, OBJECT_ANALOG_INPUT, instance, PROP_PRESENT_VALUE,
+                real_value);
+            test_value_save(
+                device_id, OBJECT_ANALOG_INPUT, instance, PROP_COV_INCREMENT,
+                -real_value);
+        }
+    }
+    for (device_id = 1; device_id <= TEST_DEVICES; device_id++) {
+        for (instance = 0; instance < TEST_OBJECTS; instance++) {
+            real_value = (float)((device_id * 1000) + instance);
+            test_point_check(
+                device_id, OBJECT_ANALOG_INPUT, instance, PROP_PRESENT_VALUE,
+                real_value);
+            test_point_check(
+                device_id, OBJECT_ANALOG_INPUT, instance, PROP_COV_INCREMENT,
+                -real_value);
+        }
+    }
+    zassert_false(
+        bacnet_data_point_stale(1, OBJECT_ANALOG_INPUT, 0, PROP_PRESENT_VALUE),
+        NULL);
+    /* a value of a point that is not stored is ignored */
+    test_value_save(1, OBJECT_ANALOG_VALUE, 0, PROP_PRESENT_VALUE, 1.0f);
+    zassert_false(
+        bacnet_data_point_value(
+            1, OBJECT_ANALOG_VALUE, 0, PROP_PRESENT_VALUE, &value),
+        NULL);
+    zassert_equal(bacnet_data_point_count(), count, NULL);
+    /* remove every other object, and the others are still found */
+    for (device_id = 1; device_id <= TEST_DEVICES; device_id++) {
+        for (instance = 0; instance < TEST_OBJECTS; instance += 2) {
+            zassert_true(
+                bacnet_data_point_remove(
+                    device_id, OBJECT_ANALOG_INPUT, instance,
+                    PROP_PRESENT_VALUE),
+                NULL);
+            count--;
+        }
+    }
+    zassert_equal(bacnet_data_point_count(), count, NULL);
+    zassert_false(
+        bacnet_data_point_remove(1, OBJECT_ANALOG_INPUT, 0, PROP_PRESENT_VALUE),
+        NULL);
+    for (device_id = 1; device_id <= TEST_DEVICES; device_id++) {
+        for (instance = 0; instance < TEST_OBJECTS; instance++) {
+            real_value = (float)((device_id * 1000) + instance);
+            if (instance & 1) {
+                test_point_check(
+                    device_id, OBJECT_ANALOG_INPUT, instance,
+                    PROP_PRESENT_VALUE, real_value);
+            } else {
+                zassert_false(
+                    bacnet_data_point_value(
+                        device_id, OBJECT_ANALOG_INPUT, instance,
+                        PROP_PRESENT_VALUE, &value),
+                    NULL);
+            }
+            test_point_check(
+                device_id, OBJECT_ANALOG_INPUT, instance, PROP_COV_INCREMENT,
+                -real_value);
+        }
+    }
+    /* a removed point is added again without a value */
+    zassert_true(
+        bacnet_data_point_add(1, OBJECT_ANALOG_INPUT, 0, PROP_PRESENT_VALUE),
+        NULL);
+    count++;
+    zassert_equal(bacnet_data_point_count(), count, NULL);
+    zassert_false(
+        bacnet_data_point_value(
+            1, OBJECT_ANALOG_INPUT, 0, PROP_PRESENT_VALUE, &value),
+        NULL);
+    /* initialization empties the cache */
+    bacnet_data_init();
+    zassert_equal(bacnet_data_point_count(), 0, NULL);
+    zassert_false(
+        bacnet_data_point_value(
+            1, OBJECT_ANALOG_INPUT, 1, PROP_PRESENT_VALUE, &value),
+        NULL);
+}
+
+/**
+ * @brief Test the points polled in each ReadPropertyMultiple batch
+ */
+#if defined(CONFIG_ZTEST_NEW_API)
+ZTEST(bac_data_tests, testDataPointBatch)
+#else
+static void testDataPointBatch(void)
+#endif
+{
+    uint32_t device_id, instance;
+    unsigned i;
+
+    test_data_init(0);
+    /* 10 objects of 2 properties - the points of an object are batched
+       together, and a batch is limited to 16 points */
+    for (instance = 0; instance < 10; instance++) {
+        zassert_true(
+            bacnet_data_point_add(
+                1, OBJECT_ANALOG_INPUT, instance, PROP_PRESENT_VALUE),
+            NULL);
+        zassert_true(
+            bacnet_data_point_add(
+                1, OBJECT_ANALOG_INPUT, instance, PROP_STATUS_FLAGS),
+            NULL);
+    }
+    bacnet_data_task();
+    zassert_equal(Test_RPM_Count, 1, NULL);
+    zassert_equal(Test_RPM_Device_ID, 1, NULL);
+    zassert_equal(Test_RPM_Objects, 8, NULL);
+    zassert_equal(Test_RPM_Properties, 16, NULL);
+    bacnet_data_task();
+    zassert_equal(Test_RPM_Count, 2, NULL);
+    zassert_equal(Test_RPM_Objects, 2, NULL);
+    zassert_equal(Test_RPM_Properties, 4, NULL);
+    /* every point was polled in this interval */
+    bacnet_data_task();
+    zassert_equal(Test_RPM_Count, 2, NULL);
+    /* a batch that is not queued is tried again */
+    Test_RPM_Status = false;
+    test_poll_interval();
+    zassert_equal(Test_RPM_Count, 2, NULL);
+    Test_RPM_Status = true;
+    bacnet_data_task();
+    zassert_equal(Test_RPM_Count, 3, NULL);
+    zassert_equal(Test_RPM_Properties, 16, NULL);
+    bacnet_data_task();
+    zassert_equal(Test_RPM_Count, 4, NULL);
+    zassert_equal(Test_RPM_Properties, 4, NULL);
+    /* a reply that does not fit halves the batch */
+    test_service_error(1, ERROR_CODE_ABORT_APDU_TOO_LONG);
+    test_poll_interval();
+    zassert_equal(Test_RPM_Count, 5, NULL);
+    zassert_equal(Test_RPM_Objects, 4, NULL);
+    zassert_equal(Test_RPM_Properties, 8, NULL);
+    /* a device without ReadPropertyMultiple is polled with ReadProperty */
+    test_service_error(1, ERROR_CODE_REJECT_UNRECOGNIZED_SERVICE);
+    test_poll_interval();
+    zassert_equal(Test_RPM_Count, 5, NULL);
+    zassert_equal(Test_RP_Count, 1, NULL);
+    for (i = 0; i < 20; i++) {
+        bacnet_data_task();
+    }
+    zassert_equal(Test_RP_Count, 20, NULL);
+    zassert_equal(Test_RPM_Count, 5, NULL);
+    /* a device that is not bound is polled with small batches */
+    test_data_init(0);
+    Test_Max_APDU = 0;
+    for (instance = 0; instance < 4; instance++) {
+        zassert_true(
+            bacnet_data_point_add(
+                2, OBJECT_ANALOG_INPUT, instance, PROP_PRESENT_VALUE),
+            NULL);
+    }
+    bacnet_data_task();
+    zassert_equal(Test_RPM_Count, 1, NULL);
+    zassert_equal(Test_RPM_Properties, 2, NULL);
+    /* the batch is sized again once the device is bound */
+    Test_Max_APDU = MAX_APDU;
+    bacnet_data_task();
+    zassert_equal(Test_RPM_Count, 2, NULL);
+    zassert_equal(Test_RPM_Properties, 2, NULL);
+    test_poll_interval();
+    zassert_equal(Test_RPM_Count, 3, NULL);
+    zassert_equal(Test_RPM_Properties, 4, NULL);
+    /* each device is a batch, and batches wait for a free storage */
+    test_data_init(0);
+    Test_Device_Idle = false;
+    for (device_id = 1; device_id <= TEST_DEVICES; device_id++) {
+        zassert_true(
+            bacnet_data_point_add(
+                device_id, OBJECT_ANALOG_INPUT, 1, PROP_PRESENT_VALUE),
+            NULL);
+    }
+    bacnet_data_task();
+    zassert_equal(Test_RPM_Count, 8, NULL);
+    bacnet_data_task();
+    zassert_equal(Test_RPM_Count, 8, NULL);
+    Test_Device_Idle = true;
+    bacnet_data_task();
+    zassert_equal(Test_RPM_Count, TEST_DEVICES, NULL);
+    zassert_equal(Test_RPM_Properties, 1, NULL);
+}
+
+/**
+ * @brief Test that the points of a COV subscription are not polled
+ *  while the subscription is active
+ */
+#if defined(CONFIG_ZTEST_NEW_API)
+ZTEST(bac_data_tests, testDataPointCOV)
+#else
+static void testDataPointCOV(void)
+#endif
+{
+    BACNET_COV_DATA cov_data = { 0 };
+    BACNET_PROPERTY_VALUE property_value = { 0 };
+
+    test_data_init(300);
+    zassert_equal(bacnet_data_cov_lifetime(), 300, NULL);
+    zassert_true(
+        bacnet_data_point_add(1, OBJECT_ANALOG_INPUT, 1, PROP_STATUS_FLAGS),
+        NULL);
+    zassert_true(
+        bacnet_data_point_add(1, OBJECT_ANALOG_INPUT, 1, PROP_PRESENT_VALUE),
+        NULL);
+    zassert_true(
+        bacnet_data_point_add(1, OBJECT_ANALOG_INPUT, 1, PROP_OBJECT_NAME),
+        NULL);
+    /* only the Present_Value is subscribed, and the Status_Flags
+       follow its subscription */
+    Test_COV_Status = BACNET_COV_STATUS_ACTIVE;
+    bacnet_data_task();
+    zassert_equal(Test_Subscribe_Count, 1, NULL);
+    zassert_not_null(Test_COV_Callback, NULL);
+    zassert_equal(Test_RPM_Count, 1, NULL);
+    zassert_equal(Test_RPM_Properties, 1, NULL);
+    /* the notification stores the value */
+    cov_data.initiatingDeviceIdentifier = 1;
+    cov_data.monitoredObjectIdentifier.type = OBJECT_ANALOG_INPUT;
+    cov_data.monitoredObjectIdentifier.instance = 1;
+    cov_data.listOfValues = &property_value;
+    property_value.propertyIdentifier = PROP_PRESENT_VALUE;
+    property_value.propertyArrayIndex = BACNET_ARRAY_ALL;
+    property_value.value.tag = BACNET_APPLICATION_TAG_REAL;
+    property_value.value.type.Real = 42.0f;
+    Test_COV_Callback(&cov_data, NULL);
+    test_point_check(1, OBJECT_ANALOG_INPUT, 1, PROP_PRESENT_VALUE, 42.0f);
+    /* an active subscription is never stale */
+    Test_Milliseconds += 3 * TEST_POLL_MS;
+    zassert_false(
+        bacnet_data_point_stale(1, OBJECT_ANALOG_INPUT, 1, PROP_PRESENT_VALUE),
+        NULL);
+    /* without an active subscription, the points are polled */
+    Test_COV_Status = BACNET_COV_STATUS_FAILED;
+    zassert_true(
+        bacnet_data_point_stale(1, OBJECT_ANALOG_INPUT, 1, PROP_PRESENT_VALUE),
+        NULL);
+    bacnet_data_task();
+    zassert_equal(Test_Subscribe_Count, 1, NULL);
+    zassert_equal(Test_RPM_Count, 2, NULL);
+    zassert_equal(Test_RPM_Objects, 1, NULL);
+    zassert_equal(Test_RPM_Properties, 3, NULL);
+    /* a removed point ends its subscription */
+    zassert_true(
+        bacnet_data_point_remove(1, OBJECT_ANALOG_INPUT, 1, PROP_PRESENT_VALUE),
+        NULL);
+    zassert_equal(Test_Unsubscribe_Count, 1, NULL);
+    zassert_true(
+        bacnet_data_point_remove(1, OBJECT_ANALOG_INPUT, 1, PROP_OBJECT_NAME),
+        NULL);
+    zassert_equal(Test_Unsubscribe_Count, 1, NULL);
+    zassert_equal(bacnet_data_point_count(), 1, NULL);
+}
+/**
+ * @}
+ */
+
+#if defined(CONFIG_ZTEST_NEW_API)
+ZTEST_SUITE(bac_data_tests, NULL, NULL, NULL, NULL, NULL);
+#else
+void test_main(void)
+{
+    ztest_test_suite(
+        bac_data_tests, ztest_unit_test(testDataPointHash),
+        ztest_unit_test(testDataPointBatch), ztest_unit_test(testDataPointCOV));
+
+    ztest_run_test_suite(bac_data_tests);
+}
+#endif
@@ -0,0 +1,587 @@
+/**
+ * @file
+ * @brief Unit test for the chunks in flight of the file transfer client
+ * @author Steve Karg <skarg@users.sourceforge.net>
+ * @date 2024
+ * @copyright SPDX-License-Identifier: MIT
+ */
+#include <stdio.h>
+#include <string.h>
+#include <zephyr/ztest.h>
+#include <bacnet/abort.h>
+#include <bacnet/arf.h>
+#include <bacnet/awf.h>
+#include <bacnet/bacstr.h>
+#include <bacnet/reject.h>
+#include <bacnet/basic/binding/address.h>
+#include <bacnet/basic/client/bac-file.h>
+#include <bacnet/basic/service/h_apdu.h>
+#include <bacnet/basic/service/s_arfs.h>
+#include <bacnet/basic/service/s_awfs.h>
+#include <bacnet/basic/tsm/tsm.h>
+
+/**
+ * @addtogroup bacnet_tests
+ * @{
+ */
+
+#define TEST_APDU_TIMEOUT 3000
+#define TEST_APDU_RETRIES 1
+#define TEST_DEVICE_ID 1234
+#define TEST_FILE_INSTANCE 7
+#define TEST_SENT_MAX 32
+#define TEST_PATHNAME "bac-file-test.bin"
+
+static unsigned long Test_Milliseconds;
+/* the chunk requests that were sent */
+struct test_sent_request {
+    int32_t position;
+    unsigned octets;
+    uint8_t invoke_id;
+    uint8_t data[16];
+};
+static struct test_sent_request Test_Sent[TEST_SENT_MAX];
+static unsigned Test_Sent_Count;
+static uint8_t Test_Invoke_ID;
+/* state of each invoke ID in the TSM */
+enum test_invoke_state {
+    TEST_INVOKE_ACTIVE,
+    TEST_INVOKE_FREE,
+    TEST_INVOKE_FAILED
+};
+static uint8_t Test_Invoke_State[256];
+static unsigned Test_Free_Invoke_ID_Count;
+/* the handlers that the client sets */
+static confirmed_ack_function Test_Read_Ack;
+static confirmed_ack_function Test_Write_Ack;
+static error_function Test_Error;
+static abort_function Test_Abort;
+static reject_function Test_Reject;
+/* the handlers that were set before the client */
+static unsigned Test_Abort_Previous_Count;
+static unsigned Test_Reject_Previous_Count;
+
+unsigned long mstimer_now(void)
+{
+    return Test_Milliseconds;
+}
+
+uint16_t apdu_timeout(void)
+{
+    return TEST_APDU_TIMEOUT;
+}
+
+uint8_t apdu_retries(void)
+{
+    return TEST_APDU_RETRIES;
+}
+
+void apdu_set_confirmed_ack_handler(
+    BACNET_CONFIRMED_SERVICE service_choice, confirmed_ack_function pFunction)
+{
+    if (service_choice == SERVICE_CONFIRMED_ATOMIC_READ_FILE) {
+        Test_Read_Ack = pFunction;
+    } else if (service_choice == SERVICE_CONFIRMED_ATOMIC_WRITE_FILE) {
+        Test_Write_Ack = pFunction;
+    }
+}
+
+void apdu_set_error_handler(
+    BACNET_CONFIRMED_SERVICE service_choice, error_function pFunction)
+{
+    (void)service_choice;
+    Test_Error = pFunction;
+}
+
+void apdu_set_abort_handler(abort_function pFunction)
+{
+    Test_Abort = pFunction;
+}
+
+abort_function apdu_abort_handler(void)
+{
+    return Test_Abort;
+}
+
+void apdu_set_reject_handler(reject_function pFunction)
+{
+    Test_Reject = pFunction;
+}
+
+reject_function apdu_reject_handler(void)
+{
+    return Test_Reject;
+}
+
+bool address_get_by_device(
+    uint32_t device_id, unsigned *max_apdu, BACNET_ADDRESS *src)
+{
+    if (device_id != TEST_DEVICE_ID) {
+        return false;
+    }
+    *max_apdu = 480;
+    memset(src, 0, sizeof(BACNET_ADDRESS));
+    src->mac_len = 1;
+    src->mac[0] = 42;
+
+    return true;
+}
+
+bool tsm_transaction_available(void)
+{
+    return true;
+}
+
+bool tsm_invoke_id_free(uint8_t invokeID)
+{
+    return Test_Invoke_State[invokeID] == TEST_INVOKE_FREE;
+}
+
+bool tsm_invoke_id_failed(uint8_t invokeID)
+{
+    return Test_Invoke_State[invokeID] == TEST_INVOKE_FAILED;
+}
+
+void tsm_free_invoke_id(uint8_t invokeID)
+{
+    Test_Invoke_State[invokeID] = TEST_INVOKE_FREE;
+    Test_Free_Invoke_ID_Count++;
+}
+
+/**
+ * @brief Keep a chunk request that was sent
+ * @return invoke ID of the request
+ */
+static uint8_t test_sent_add(int32_t position, unsigned octets)
+{
+    struct test_sent_request *sent;
+
+    zassert_true(Test_Sent_Count < TEST_SENT_MAX, NULL);
+    sent = &Test_Sent[Test_Sent_Count % TEST_SENT_MAX];
+    Test_Sent_Count++;
+    Test_Invoke_ID++;
+    if (Test_Invoke_ID == 0) {
+        Test_Invoke_ID = 1;
+    }
+    sent->position = position;
+    sent->octets = octets;
+    sent->invoke_id = Test_Invoke_ID;
+    Test_Invoke_State[Test_Invoke_ID] = TEST_INVOKE_ACTIVE;
+
+    return Test_Invoke_ID;
+}
+
+uint8_t Send_Atomic_Read_File_Stream(
+    uint32_t device_id,
+    uint32_t file_instance,
+    int fileStartPosition,
+    unsigned requestedOctetCount)
+{
+    zassert_equal(device_id, TEST_DEVICE_ID, NULL);
+    zassert_equal(file_instance, TEST_FILE_INSTANCE, NULL);
+
+    return test_sent_add(fileStartPosition, requestedOctetCount);
+}
+
+uint8_t Send_Atomic_Write_File_Stream(
+    uint32_t device_id,
+    uint32_t file_instance,
+    int fileStartPosition,
+    const BACNET_OCTET_STRING *fileData)
+{
+    uint8_t invoke_id;
+    size_t len;
+
+    zassert_equal(device_id, TEST_DEVICE_ID, NULL);
+    zassert_equal(file_instance, TEST_FILE_INSTANCE, NULL);
+    len = octetstring_length(fileData);
+    invoke_id = test_sent_add(fileStartPosition, (unsigned)len);
+    if (len > sizeof(Test_Sent[0].data)) {
+        len = sizeof(Test_Sent[0].data);
+    }
+    memcpy(Test_Sent[Test_Sent_Count - 1].data, fileData->value, len);
+
+    return invoke_id;
+}
+
+static void test_abort_previous(
+    BACNET_ADDRESS *src, uint8_t invoke_id, uint8_t abort_reason, bool server)
+{
+    (void)src;
+    (void)invoke_id;
+    (void)abort_reason;
+    (void)server;
+    Test_Abort_Previous_Count++;
+}
+
+static void test_reject_previous(
+    BACNET_ADDRESS *src, uint8_t invoke_id, uint8_t reject_reason)
+{
+    (void)src;
+    (void)invoke_id;
+    (void)reject_reason;
+    Test_Reject_Previous_Count++;
+}
+
+/**
+ * @brief Reset the stubs, and initialize the client with the Abort and
+ *  Reject handlers of the application already set
+ */
+static void test_setup(unsigned window, unsigned octets)
+{
+    Test_Milliseconds = 0;
+    Test_Sent_Count = 0;
+    Test_Free_Invoke_ID_Count = 0;
+    Test_Abort_Previous_Count = 0;
+    Test_Reject_Previous_Count = 0;
+    memset(Test_Invoke_State, 0, sizeof(Test_Invoke_State));
+    Test_Abort = test_abort_previous;
+    Test_Reject = test_reject_previous;
+    bacnet_file_transfer_init();
+    bacnet_file_transfer_window_set(window);
+    bacnet_file_transfer_chunk_size_set(octets);
+    bacnet_file_transfer_pad_set(false, 0);
+}
+
+/**
+ * @brief Find the chunk request that was last sent for a file position
+ * @return the sent request
+ */
+static struct test_sent_request *test_sent_find(int32_t position)
+{
+    unsigned i;
+
+    for (i = Test_Sent_Count; i > 0; i--) {
+        if (Test_Sent[i - 1].position == position) {
+            return &Test_Sent[i - 1];
+        }
+    }
+    zassert_unreachable("no request for the file position");
+
+    return &Test_Sent[0];
+}
+
+/**
+ * @brief Make the address of the device
+ */
+static void test_device_address(BACNET_ADDRESS *src)
+{
+    unsigned max_apdu = 0;
+
+    (void)address_get_by_device(TEST_DEVICE_ID, &max_apdu, src);
+}
+
+/**
+ * @brief Deliver the AtomicReadFile-ACK of the request for a position
+ */
+static void test_read_ack(int32_t position, const char *text, bool end_of_file)
+{
+    BACNET_ATOMIC_READ_FILE_DATA data = { 0 };
+    BACNET_CONFIRMED_SERVICE_ACK_DATA ack_data = { 0 };
+    BACNET_ADDRESS src;
+    uint8_t apdu[MAX_APDU];
+    int len;
+
+    data.access = FILE_STREAM_ACCESS;
+    data.type.stream.fileStartPosition = position;
+    data.endOfFile = end_of_file;
+    octetstring_init(&data.fileData[0], (const uint8_t *)text, strlen(text));
+    len = arf_ack_service_encode_apdu(apdu, &data);
+    zassert_true(len > 0, NULL);
+    ack_data.invoke_id = test_sent_find(position)->invoke_id;
+    test_device_address(&src);
+    Test_Read_Ack(apdu, (uint16_t)len, &src, &ack_data);
+}
+
+/**
+ * @brief Deliver the AtomicWriteFile-ACK of the request for a position
+ */
+static void test_write_ack(int32_t position)
+{
+    BACNET_ATOMIC_WRITE_FILE_DATA data = { 0 };
+    BACNET_CONFIRMED_SERVICE_ACK_DATA ack_data = { 0 };
+    BACNET_ADDRESS src;
+    uint8_t apdu[MAX_APDU];
+    int len;
+
+    data.access = FILE_STREAM_ACCESS;
+    data.type.stream.fileStartPosition = position;
+    len = awf_ack_service_encode_apdu(apdu, &data);
+    zassert_true(len > 0, NULL);
+    ack_data.invoke_id = test_sent_find(position)->invoke_id;
+    test_device_address(&src);
+    Test_Write_Ack(apdu, (uint16_t)len, &src, &ack_data);
+}
+
+/**
+ * @brief Deliver an Error of the request for a position
+ */
+static void test_error(int32_t position, BACNET_ERROR_CODE error_code)
+{
+    BACNET_ADDRESS src;
+
+    test_device_address(&src);
+    Test_Error(
+        &src, test_sent_find(position)->invoke_id, ERROR_CLASS_SERVICES,
+        error_code);
+}
+
+/**
+ * @brief Check the contents of the local file
+ */
+static void test_file_contents(const char *text)
+{
+    char buffer[64] = { 0 };
+    FILE *file;
+    size_t len;
+
+    file = fopen(TEST_PATHNAME, "rb");
+    zassert_not_null(file, NULL);
+    len = fread(buffer, 1, sizeof(buffer) - 1, file);
+    fclose(file);
+    zassert_equal(len, strlen(text), NULL);
+    zassert_mem_equal(buffer, text, len, NULL);
+}
+
+/**
+ * @brief Test a read with the acks out of order, and a short read
+ *  whose rest is requested again
+ */
+#if defined(CONFIG_ZTEST_NEW_API)
+ZTEST(bac_file_tests, testFileReadReordered)
+#else
+static void testFileReadReordered(void)
+#endif
+{
+    const struct test_sent_request *sent;
+
+    test_setup(4, 8);
+    zassert_true(
+        bacnet_file_read_start(
+            TEST_DEVICE_ID, TEST_FILE_INSTANCE, TEST_PATHNAME),
+        NULL);
+    bacnet_file_transfer_task();
+    zassert_equal(Test_Sent_Count, 4, NULL);
+    zassert_equal(test_sent_find(24)->octets, 8, NULL);
+    /* the acks are written at the position of their chunk */
+    test_read_ack(16, "CCCCCCCC", false);
+    test_read_ack(0, "AAAAAAAA", false);
+    zassert_equal(bacnet_file_transfer_octets(), 16, NULL);
+    /* a short read requests the rest of its chunk */
+    test_read_ack(8, "BBBB", false);
+    zassert_equal(bacnet_file_transfer_octets(), 20, NULL);
+    bacnet_file_transfer_task();
+    zassert_equal(Test_Sent_Count, 7, NULL);
+    sent = test_sent_find(12);
+    zassert_equal(sent->octets, 4, NULL);
+    zassert_equal(test_sent_find(32)->octets, 8, NULL);
+    zassert_equal(test_sent_find(40)->octets, 8, NULL);
+    test_read_ack(12, "bbbb", false);
+    /* the end of the file frees the chunks past it */
+    test_read_ack(24, "DDDDDDDD", true);
+    zassert_equal(
+        bacnet_file_transfer_status(), BACNET_FILE_TRANSFER_BUSY, NULL);
+    bacnet_file_transfer_task();
+    zassert_equal(
+        bacnet_file_transfer_status(), BACNET_FILE_TRANSFER_COMPLETE, NULL);
+    zassert_equal(bacnet_file_transfer_octets(), 32, NULL);
+    test_file_contents("AAAAAAAABBBBbbbbCCCCCCCCDDDDDDDD");
+    (void)remove(TEST_PATHNAME);
+}
+
+/**
+ * @brief Test the end of a read found from an Error, and from an ack
+ *  with zero octets
+ */
+#if defined(CONFIG_ZTEST_NEW_API)
+ZTEST(bac_file_tests, testFileReadEnd)
+#else
+static void testFileReadEnd(void)
+#endif
+{
+    BACNET_ERROR_CLASS error_class;
+    BACNET_ERROR_CODE error_code;
+
+    /* past the end of the file */
+    test_setup(4, 8);
+    zassert_true(
+        bacnet_file_read_start(
+            TEST_DEVICE_ID, TEST_FILE_INSTANCE, TEST_PATHNAME),
+        NULL);
+    bacnet_file_transfer_task();
+    zassert_equal(Test_Sent_Count, 4, NULL);
+    test_read_ack(0, "AAAAAAAA", false);
+    test_error(16, ERROR_CODE_INVALID_FILE_START_POSITION);
+    test_read_ack(8, "BBBBBBBB", false);
+    Test_Sent_Count = 0;
+    bacnet_file_transfer_task();
+    zassert_equal(Test_Sent_Count, 0, NULL);
+    zassert_equal(
+        bacnet_file_transfer_status(), BACNET_FILE_TRANSFER_COMPLETE, NULL);
+    test_file_contents("AAAAAAAABBBBBBBB");
+    /* zero octets */
+    test_setup(2, 8);
+    zassert_true(
+        bacnet_file_read_start(
+            TEST_DEVICE_ID, TEST_FILE_INSTANCE, TEST_PATHNAME),
+        NULL);
+    bacnet_file_transfer_task();
+    zassert_equal(Test_Sent_Count, 2, NULL);
+    test_read_ack(8, "", false);
+    test_read_ack(0, "AAAAAAAA", false);
+    Test_Sent_Count = 0;
+    bacnet_file_transfer_task();
+    zassert_equal(Test_Sent_Count, 0, NULL);
+    zassert_equal(
+        bacnet_file_transfer_status(), BACNET_FILE_TRANSFER_COMPLETE, NULL);
+    zassert_equal(bacnet_file_transfer_octets(), 8, NULL);
+    test_file_contents("AAAAAAAA");
+    /* any other Error stops the transfer */
+    test_setup(2, 8);
+    zassert_true(
+        bacnet_file_read_start(
+            TEST_DEVICE_ID, TEST_FILE_INSTANCE, TEST_PATHNAME),
+        NULL);
+    bacnet_file_transfer_task();
+    test_error(8, ERROR_CODE_FILE_ACCESS_DENIED);
+    zassert_equal(
+        bacnet_file_transfer_status(), BACNET_FILE_TRANSFER_FAILED, NULL);
+    bacnet_file_transfer_error(&error_class, &error_code);
+    zassert_equal(error_class, ERROR_CLASS_SERVICES, NULL);
+    zassert_equal(error_code, ERROR_CODE_FILE_ACCESS_DENIED, NULL);
+    (void)remove(TEST_PATHNAME);
+}
+
+/**
+ * @brief Test the retries of a chunk after an Abort, a timeout, a TSM
+ *  failure, and a Reject, and the handlers of the application that are
+ *  called with every Abort and Reject
+ */
+#if defined(CONFIG_ZTEST_NEW_API)
+ZTEST(bac_file_tests, testFileChunkRetry)
+#else
+static void testFileChunkRetry(void)
+#endif
+{
+    BACNET_ERROR_CLASS error_class;
+    BACNET_ERROR_CODE error_code;
+    BACNET_ADDRESS src;
+    uint8_t invoke_id;
+
+    test_setup(1, 8);
+    /* initialized twice, the handlers that were set before are kept */
+    bacnet_file_transfer_init();
+    test_device_address(&src);
+    zassert_true(
+        bacnet_file_read_start(
+            TEST_DEVICE_ID, TEST_FILE_INSTANCE, TEST_PATHNAME),
+        NULL);
+    bacnet_file_transfer_task();
+    zassert_equal(Test_Sent_Count, 1, NULL);
+    /* an Abort, and the TSM frees the invoke ID */
+    invoke_id = test_sent_find(0)->invoke_id;
+    Test_Abort(&src, invoke_id, ABORT_REASON_OUT_OF_RESOURCES, true);
+    zassert_equal(Test_Abort_Previous_Count, 1, NULL);
+    Test_Invoke_State[invoke_id] = TEST_INVOKE_FREE;
+    bacnet_file_transfer_task();
+    zassert_equal(Test_Sent_Count, 2, NULL);
+    zassert_not_equal(test_sent_find(0)->invoke_id, invoke_id, NULL);
+    /* the timeout of the chunk */
+    Test_Milliseconds += TEST_APDU_TIMEOUT * (TEST_APDU_RETRIES + 1) - 1;
+    bacnet_file_transfer_task();
+    zassert_equal(Test_Sent_Count, 2, NULL);
+    Test_Milliseconds += 1;
+    bacnet_file_transfer_task();
+    zassert_equal(Test_Free_Invoke_ID_Count, 1, NULL);
+    zassert_equal(Test_Sent_Count, 3, NULL);
+    /* the TSM failed the request */
+    Test_Invoke_State[test_sent_find(0)->invoke_id] = TEST_INVOKE_FAILED;
+    bacnet_file_transfer_task();
+    zassert_equal(Test_Free_Invoke_ID_Count, 2, NULL);
+    zassert_equal(Test_Sent_Count, 4, NULL);
+    zassert_equal(
+        bacnet_file_transfer_status(), BACNET_FILE_TRANSFER_BUSY, NULL);
+    /* retries used up, the transfer fails with the last reason */
+    invoke_id = test_sent_find(0)->invoke_id;
+    Test_Reject(&src, invoke_id, REJECT_REASON_INVALID_TAG);
+    zassert_equal(Test_Reject_Previous_Count, 1, NULL);
+    Test_Invoke_State[invoke_id] = TEST_INVOKE_FREE;
+    bacnet_file_transfer_task();
+    zassert_equal(Test_Sent_Count, 4, NULL);
+    zassert_equal(
+        bacnet_file_transfer_status(), BACNET_FILE_TRANSFER_FAILED, NULL);
+    bacnet_file_transfer_error(&error_class, &error_code);
+    zassert_equal(error_class, ERROR_CLASS_SERVICES, NULL);
+    zassert_equal(
+        error_code, reject_convert_to_error_code(REJECT_REASON_INVALID_TAG),
+        NULL);
+    /* an Abort that is not for the transfer is passed on */
+    Test_Abort(&src, invoke_id, ABORT_REASON_OTHER, false);
+    zassert_equal(Test_Abort_Previous_Count, 2, NULL);
+    (void)remove(TEST_PATHNAME);
+}
+
+/**
+ * @brief Test a write, which waits for the write at position 0 that
+ *  truncates the file before writing the other chunks
+ */
+#if defined(CONFIG_ZTEST_NEW_API)
+ZTEST(bac_file_tests, testFileWriteFirstChunk)
+#else
+static void testFileWriteFirstChunk(void)
+#endif
+{
+    const char *text = "AAAAAAAABBBBBBBBCCCC";
+    const struct test_sent_request *sent;
+    FILE *file;
+
+    file = fopen(TEST_PATHNAME, "wb");
+    zassert_not_null(file, NULL);
+    zassert_equal(fwrite(text, 1, strlen(text), file), strlen(text), NULL);
+    fclose(file);
+    test_setup(4, 8);
+    zassert_true(
+        bacnet_file_write_start(
+            TEST_DEVICE_ID, TEST_FILE_INSTANCE, TEST_PATHNAME),
+        NULL);
+    bacnet_file_transfer_task();
+    zassert_equal(Test_Sent_Count, 1, NULL);
+    bacnet_file_transfer_task();
+    zassert_equal(Test_Sent_Count, 1, NULL);
+    sent = test_sent_find(0);
+    zassert_equal(sent->octets, 8, NULL);
+    zassert_mem_equal(sent->data, "AAAAAAAA", 8, NULL);
+    test_write_ack(0);
+    bacnet_file_transfer_task();
+    zassert_equal(Test_Sent_Count, 3, NULL);
+    sent = test_sent_find(8);
+    zassert_equal(sent->octets, 8, NULL);
+    zassert_mem_equal(sent->data, "BBBBBBBB", 8, NULL);
+    sent = test_sent_find(16);
+    zassert_equal(sent->octets, 4, NULL);
+    zassert_mem_equal(sent->data, "CCCC", 4, NULL);
+    test_write_ack(16);
+    test_write_ack(8);
+    bacnet_file_transfer_task();
+    zassert_equal(
+        bacnet_file_transfer_status(), BACNET_FILE_TRANSFER_COMPLETE, NULL);
+    zassert_equal(bacnet_file_transfer_octets(), strlen(text), NULL);
+    (void)remove(TEST_PATHNAME);
+}
+/**
+ * @}
+ */
+
+#if defined(CONFIG_ZTEST_NEW_API)
+ZTEST_SUITE(bac_file_tests, NULL, NULL, NULL, NULL, NULL);
+#else
+void test_main(void)
+{
+    ztest_test_suite(
+        bac_file_tests, ztest_unit_test(testFileReadReordered),
+        ztest_unit_test(testFileReadEnd), ztest_unit_test(testFileChunkRetry),
+        ztest_unit_test(testFileWriteFirstChunk));
+
+    ztest_run_test_suite(bac_file_tests);
+}
+#endif
@@ -0,0 +1,411 @@
+/**
+ * @file
+ * @brief Unit test for the requests in flight of the read-write client
+ * @author Steve Karg <skarg@users.sourceforge.net>
+ * @date 2024
+ * @copyright SPDX-License-Identifier: MIT
+ */
+#include <string.h>
+#include <zephyr/ztest.h>
+#include <bacnet/bacaddr.h>
+#include <bacnet/bacdcode.h>
+#include <bacnet/npdu.h>
+#include <bacnet/rp.h>
+#include <bacnet/basic/binding/address.h>
+#include <bacnet/basic/client/bac-rw.h>
+#include <bacnet/basic/service/h_apdu.h>
+#include <bacnet/basic/tsm/tsm.h>
+#include <bacnet/datalink/datalink.h>
+
+/**
+ * @addtogroup bacnet_tests
+ * @{
+ */
+
+#define TEST_APDU_TIMEOUT 3000
+#define TEST_SENT_MAX 16
+
+static unsigned long Test_Milliseconds;
+static unsigned Test_Who_Is_Count;
+/* the confirmed requests that were sent */
+struct test_sent_request {
+    uint8_t mac;
+    uint8_t invoke_id;
+    uint8_t service;
+};
+static struct test_sent_request Test_Sent[TEST_SENT_MAX];
+static unsigned Test_Sent_Count;
+/* the results reported to the callbacks */
+static unsigned Test_Value_Count;
+static uint32_t Test_Value_Device_ID;
+static BACNET_ERROR_CODE Test_Value_Error_Code;
+static bool Test_Value_Present;
+static unsigned Test_COV_Count;
+/* the handlers that the client sets */
+static confirmed_ack_function Test_Read_Property_Ack;
+static confirmed_simple_ack_function Test_Simple_Ack;
+static error_function Test_Error;
+
+unsigned long mstimer_now(void)
+{
+    return Test_Milliseconds;
+}
+
+uint16_t apdu_timeout(void)
+{
+    return TEST_APDU_TIMEOUT;
+}
+
+uint8_t apdu_retries(void)
+{
+    return 0;
+}
+
+void apdu_set_unconfirmed_handler(
+    BACNET_UNCONFIRMED_SERVICE service_choice, unconfirmed_function pFunction)
+{
+    (void)service_choice;
+    (void)pFunction;
+}
+
+void apdu_set_confirmed_ack_handler(
+    BACNET_CONFIRMED_SERVICE service_choice, confirmed_ack_function pFunction)
+{
+    if (service_choice == SERVICE_CONFIRMED_READ_PROPERTY) {
+        Test_Read_Property_Ack = pFunction;
+    }
+}
+
+void apdu_set_confirmed_simple_ack_handler(
+    BACNET_CONFIRMED_SERVICE service_choice,
+    confirmed_simple_ack_function pFunction)
+{
+    (void)service_choice;
+    Test_Simple_Ack = pFunction;
+}
+
+void apdu_set_error_handler(
+    BACNET_CONFIRMED_SERVICE service_choice, error_function pFunction)
+{
+    (void)service_choice;
+    Test_Error = pFunction;
+}
+
+void apdu_set_abort_handler(abort_function pFunction)
+{
+    (void)pFunction;
+}
+
+void apdu_set_reject_handler(reject_function pFunction)
+{
+    (void)pFunction;
+}
+
+bool dcc_communication_enabled(void)
+{
+    return true;
+}
+
+uint32_t Device_Object_Instance_Number(void)
+{
+    return 1234;
+}
+
+void Send_WhoIs(int32_t low_limit, int32_t high_limit)
+{
+    (void)low_limit;
+    (void)high_limit;
+    Test_Who_Is_Count++;
+}
+
+int datalink_send_pdu(
+    BACNET_ADDRESS *dest,
+    BACNET_NPDU_DATA *npdu_data,
+    uint8_t *pdu,
+    unsigned pdu_len)
+{
+    BACNET_ADDRESS npdu_dest = { 0 }, npdu_src = { 0 };
+    BACNET_NPDU_DATA npdu = { 0 };
+    int offset;
+
+    (void)npdu_data;
+    offset = bacnet_npdu_decode(pdu, pdu_len, &npdu_dest, &npdu_src, &npdu);
+    zassert_true(offset > 0, NULL);
+    zassert_true(Test_Sent_Count < TEST_SENT_MAX, NULL);
+    if ((offset > 0) && (Test_Sent_Count < TEST_SENT_MAX)) {
+        zassert_equal(
+            pdu[offset] & 0xF0, PDU_TYPE_CONFIRMED_SERVICE_REQUEST, NULL);
+        Test_Sent[Test_Sent_Count].mac = dest->mac[0];
+        Test_Sent[Test_Sent_Count].invoke_id = pdu[offset + 2];
+        Test_Sent[Test_Sent_Count].service = pdu[offset + 3];
+        Test_Sent_Count++;
+    }
+
+    return (int)pdu_len;
+}
+
+void datalink_get_my_address(BACNET_ADDRESS *my_address)
+{
+    memset(my_address, 0, sizeof(BACNET_ADDRESS));
+    my_address->mac_len = 1;
+    my_address->mac[0] = 1;
+}
+
+static void test_value_callback(
+    uint32_t device_instance,
+    BACNET_READ_PROPERTY_DATA *rp_data,
+    BACNET_APPLICATION_DATA_VALUE *value)
+{
+    Test_Value_Count++;
+    Test_Value_Device_ID = device_instance;
+    Test_Value_Error_Code = rp_data->error_code;
+    Test_Value_Present = (value != NULL);
+}
+
+static void
+test_cov_callback(uint32_t device_instance, BACNET_SUBSCRIBE_COV_DATA *cov_data)
+{
+    (void)device_instance;
+    (void)cov_data;
+    Test_COV_Count++;
+}
+
+/**
+ * @brief Make the address of a device, using the instance as MAC
+ */
+static void test_device_address(BACNET_ADDRESS *src, uint32_t device_id)
+{
+    memset(src, 0, sizeof(BACNET_ADDRESS));
+    src->mac_len = 1;
+    src->mac[0] = (uint8_t)device_id;
+}
+
+/**
+ * @brief Find the request that was sent to a device
+ * @return index of the sent request, or TEST_SENT_MAX if not sent
+ */
+static unsigned test_sent_index(uint32_t device_id)
+{
+    unsigned i;
+
+    for (i = 0; i < Test_Sent_Count; i++) {
+        if (Test_Sent[i].mac == (uint8_t)device_id) {
+            return i;
+        }
+    }
+
+    return TEST_SENT_MAX;
+}
+
+/**
+ * @brief Run the client tasks, without any time passing
+ */
+static void test_task(unsigned count)
+{
+    while (count) {
+        bacnet_read_write_task();
+        count--;
+    }
+}
+
+static void test_init(void)
+{
+    Test_Milliseconds = 0;
+    Test_Who_Is_Count = 0;
+    Test_Sent_Count = 0;
+    Test_Value_Count = 0;
+    Test_COV_Count = 0;
+    bacnet_read_write_init();
+    bacnet_read_write_value_callback_set(test_value_callback);
+    bacnet_read_write_cov_callback_set(test_cov_callback);
+}
+
+/**
+ * @brief Test the requests in flight to many devices, limited by the
+ *  TSM transactions and by the requests in flight to each device
+ */
+#if defined(CONFIG_ZTEST_NEW_API)
+ZTEST(bac_rw_tests, testReadWriteBatch)
+#else
+static void testReadWriteBatch(void)
+#endif
+{
+    BACNET_ADDRESS src = { 0 };
+    BACNET_CONFIRMED_SERVICE_ACK_DATA service_data = { 0 };
+    BACNET_READ_PROPERTY_DATA rp_data = { 0 };
+    uint8_t application_data[8] = { 0 };
+    uint8_t service_request[32] = { 0 };
+    uint8_t invoke_id;
+    unsigned i, j;
+    int len;
+
+    test_init();
+    for (i = 1; i <= 5; i++) {
+        test_device_address(&src, i);
+        address_add(i, MAX_APDU, &src);
+    }
+    /* two requests to device 1, and one request to each other device */
+    zassert_true(
+        bacnet_read_property_queue(
+            1, OBJECT_ANALOG_INPUT, 1, PROP_PRESENT_VALUE, BACNET_ARRAY_ALL),
+        NULL);
+    zassert_true(
+        bacnet_read_property_queue(
+            1, OBJECT_ANALOG_INPUT, 2, PROP_PRESENT_VALUE, BACNET_ARRAY_ALL),
+        NULL);
+    zassert_true(
+        bacnet_read_property_queue(
+            2, OBJECT_ANALOG_INPUT, 1, PROP_PRESENT_VALUE, BACNET_ARRAY_ALL),
+        NULL);
+    zassert_true(
+        bacnet_write_property_real_queue(
+            3, OBJECT_ANALOG_VALUE, 1, PROP_PRESENT_VALUE, 1.0f, 8,
+            BACNET_ARRAY_ALL),
+        NULL);
+    zassert_true(
+        bacnet_subscribe_cov_queue(4, OBJECT_ANALOG_INPUT, 1, 1, 60, false),
+        NULL);
+    zassert_true(
+        bacnet_read_property_queue(
+            5, OBJECT_ANALOG_INPUT, 1, PROP_PRESENT_VALUE, BACNET_ARRAY_ALL),
+        NULL);
+    /* one request to each device is sent, until the TSM is full */
+    test_task(2);
+    zassert_equal(Test_Sent_Count, MAX_TSM_TRANSACTIONS, NULL);
+    zassert_false(tsm_transaction_available(), NULL);
+    zassert_equal(Test_Sent[0].mac, 1, NULL);
+    zassert_equal(Test_Sent[1].mac, 2, NULL);
+    zassert_equal(Test_Sent[2].mac, 3, NULL);
+    zassert_equal(Test_Sent[3].mac, 4, NULL);
+    zassert_equal(Test_Sent[0].service, SERVICE_CONFIRMED_READ_PROPERTY, NULL);
+    zassert_equal(Test_Sent[2].service, SERVICE_CONFIRMED_WRITE_PROPERTY, NULL);
+    zassert_equal(Test_Sent[3].service, SERVICE_CONFIRMED_SUBSCRIBE_COV, NULL);
+    for (i = 0; i < Test_Sent_Count; i++) {
+        zassert_false(tsm_invoke_id_free(Test_Sent[i].invoke_id), NULL);
+        for (j = i + 1; j < Test_Sent_Count; j++) {
+            zassert_not_equal(
+                Test_Sent[i].invoke_id, Test_Sent[j].invoke_id, NULL);
+        }
+    }
+    zassert_false(bacnet_read_write_idle(), NULL);
+    zassert_false(bacnet_read_write_device_idle(5), NULL);
+    /* the WriteProperty is acknowledged, which frees its transaction */
+    i = test_sent_index(3);
+    invoke_id = Test_Sent[i].invoke_id;
+    test_device_address(&src, 3);
+    zassert_not_null(Test_Simple_Ack, NULL);
+    Test_Simple_Ack(&src, invoke_id);
+    tsm_free_invoke_id(invoke_id);
+    test_task(3);
+    zassert_true(bacnet_read_write_device_idle(3), NULL);
+    zassert_equal(Test_Value_Count, 0, NULL);
+    /* and the request to device 5 is sent in its place */
+    zassert_equal(Test_Sent_Count, MAX_TSM_TRANSACTIONS + 1, NULL);
+    zassert_equal(Test_Sent[MAX_TSM_TRANSACTIONS].mac, 5, NULL);
+    /* a reply from another device with the same invoke ID is ignored */
+    i = test_sent_index(2);
+    invoke_id = Test_Sent[i].invoke_id;
+    test_device_address(&src, 4);
+    zassert_not_null(Test_Error, NULL);
+    Test_Error(&src, invoke_id, ERROR_CLASS_OBJECT, ERROR_CODE_UNKNOWN_OBJECT);
+    test_task(1);
+    zassert_equal(Test_Value_Count, 0, NULL);
+    /* the ReadProperty of device 2 is acknowledged with its value */
+    test_device_address(&src, 2);
+    rp_data.object_type = OBJECT_ANALOG_INPUT;
+    rp_data.object_instance = 1;
+    rp_data.object_property = PROP_PRESENT_VALUE;
+    rp_data.array_index = BACNET_ARRAY_ALL;
+    len = encode_application_real(&application_data[0], 42.0f);
+    rp_data.application_data = &application_data[0];
+    rp_data.application_data_len = len;
+    len = read_property_ack_encode(&service_request[0], &rp_data);
+    zassert_true(len > 0, NULL);
+    service_data.invoke_id = invoke_id;
+    zassert_not_null(Test_Read_Property_Ack, NULL);
+    Test_Read_Property_Ack(
+        &service_request[0], (uint16_t)len, &src, &service_data);
+    tsm_free_invoke_id(invoke_id);
+    zassert_equal(Test_Value_Count, 1, NULL);
+    zassert_equal(Test_Value_Device_ID, 2, NULL);
+    zassert_equal(Test_Value_Error_Code, ERROR_CODE_SUCCESS, NULL);
+    zassert_true(Test_Value_Present, NULL);
+    test_task(1);
+    zassert_true(bacnet_read_write_device_idle(2), NULL);
+    /* the first ReadProperty of device 1 fails, and then the second
+       request to device 1 is sent */
+    i = test_sent_index(1);
+    invoke_id = Test_Sent[i].invoke_id;
+    test_device_address(&src, 1);
+    Test_Error(&src, invoke_id, ERROR_CLASS_OBJECT, ERROR_CODE_UNKNOWN_OBJECT);
+    tsm_free_invoke_id(invoke_id);
+    test_task(3);
+    zassert_equal(Test_Value_Count, 2, NULL);
+    zassert_equal(Test_Value_Device_ID, 1, NULL);
+    zassert_equal(Test_Value_Error_Code, ERROR_CODE_UNKNOWN_OBJECT, NULL);
+    zassert_false(Test_Value_Present, NULL);
+    zassert_equal(Test_Sent_Count, MAX_TSM_TRANSACTIONS + 2, NULL);
+    zassert_equal(Test_Sent[MAX_TSM_TRANSACTIONS + 1].mac, 1, NULL);
+    /* the remaining requests time out in the TSM */
+    tsm_timer_milliseconds(TEST_APDU_TIMEOUT);
+    test_task(1);
+    zassert_equal(Test_COV_Count, 1, NULL);
+    zassert_true(bacnet_read_write_idle(), NULL);
+    zassert_equal(tsm_transaction_idle_count(), MAX_TSM_TRANSACTIONS, NULL);
+    zassert_equal(Test_Who_Is_Count, 0, NULL);
+}
+
+/**
+ * @brief Test the requests to devices that are not bound
+ */
+#if defined(CONFIG_ZTEST_NEW_API)
+ZTEST(bac_rw_tests, testReadWriteBinding)
+#else
+static void testReadWriteBinding(void)
+#endif
+{
+    unsigned i;
+
+    test_init();
+    /* each request in flight holds a TSM transaction while binding */
+    for (i = 0; i < (MAX_TSM_TRANSACTIONS + 1); i++) {
+        zassert_true(
+            bacnet_read_property_queue(
+                100 + i, OBJECT_ANALOG_INPUT, 1, PROP_PRESENT_VALUE,
+                BACNET_ARRAY_ALL),
+            NULL);
+    }
+    test_task(2);
+    zassert_equal(Test_Who_Is_Count, MAX_TSM_TRANSACTIONS, NULL);
+    zassert_equal(tsm_transaction_idle_count(), 0, NULL);
+    zassert_false(
+        bacnet_read_write_device_idle(100 + MAX_TSM_TRANSACTIONS), NULL);
+    /* the binding times out, and the transactions are free again */
+    Test_Milliseconds += TEST_APDU_TIMEOUT + 1;
+    test_task(1);
+    zassert_equal(Test_Value_Count, MAX_TSM_TRANSACTIONS, NULL);
+    zassert_equal(Test_Value_Error_Code, ERROR_CODE_TIMEOUT, NULL);
+    zassert_equal(Test_Sent_Count, 0, NULL);
+    test_task(1);
+    zassert_equal(Test_Who_Is_Count, MAX_TSM_TRANSACTIONS + 1, NULL);
+    Test_Milliseconds += TEST_APDU_TIMEOUT + 1;
+    test_task(1);
+    zassert_true(bacnet_read_write_idle(), NULL);
+    zassert_equal(tsm_transaction_idle_count(), MAX_TSM_TRANSACTIONS, NULL);
+}
+/**
+ * @}
+ */
+
+#if defined(CONFIG_ZTEST_NEW_API)
+ZTEST_SUITE(bac_rw_tests, NULL, NULL, NULL, NULL, NULL);
+#else
+void test_main(void)
+{
+    ztest_test_suite(
+        bac_rw_tests, ztest_unit_test(testReadWriteBatch),
+        ztest_unit_test(testReadWriteBinding));
+
+    ztest_run_test_suite(bac_rw_tests);
+}
+#endif
@@ -9,6 +9,8 @@
  *
  * SPDX-License-Identifier: MIT
  */
+#include <stdio.h>
+#include <string.h>
 #include <zephyr/ztest.h>
 #include <bacnet/basic/object/bacfile.h>
 
@@ -69,6 +71,97 @@ static void test_BACnet_File_Object(void)
 
     return;
 }
+/**
+ * @brief Test the stream access of File objects whose files are kept
+ *  open between requests, with more files than open file handles
+ */
+#if defined(CONFIG_ZTEST_NEW_API)
+ZTEST(bacfile_tests, test_BACnet_File_Stream)
+#else
+static void test_BACnet_File_Stream(void)
+#endif
+{
+    BACNET_ATOMIC_WRITE_FILE_DATA write_data = { 0 };
+    BACNET_ATOMIC_READ_FILE_DATA read_data = { 0 };
+    uint8_t buffer[64] = { 0 };
+    uint8_t test_buffer[64] = { 0 };
+    char pathname[32] = "";
+    const unsigned file_count = 6;
+    unsigned i, n;
+    uint32_t len;
+    FILE *pFile;
+
+    bacfile_init();
+    for (i = 0; i < sizeof(buffer); i++) {
+        buffer[i] = (uint8_t)(i + 1);
+    }
+    for (n = 0; n < file_count; n++) {
+        snprintf(pathname, sizeof(pathname), "bacfile-test-%u.bin", n);
+        zassert_equal(bacfile_create(n), n, NULL);
+        bacfile_pathname_set(n, pathname);
+        /* new file, and two chunks written at a position and appended */
+        write_data.object_type = OBJECT_FILE;
+        write_data.object_instance = n;
+        write_data.access = FILE_STREAM_ACCESS;
+        write_data.type.stream.fileStartPosition = 0;
+        octetstring_init(&write_data.fileData[0], buffer, 16);
+        zassert_true(bacfile_write_stream_data(&write_data), NULL);
+        write_data.type.stream.fileStartPosition = 16;
+        octetstring_init(&write_data.fileData[0], &buffer[16], 16);
+        zassert_true(bacfile_write_stream_data(&write_data), NULL);
+        write_data.type.stream.fileStartPosition = -1;
+        octetstring_init(&write_data.fileData[0], &buffer[32], n + 1);
+        zassert_true(bacfile_write_stream_data(&write_data), NULL);
+        zassert_equal(bacfile_file_size(n), 32 + n + 1, NULL);
+    }
+    for (n = 0; n < file_count; n++) {
+        /* each file is read back after the others were opened */
+        read_data.object_type = OBJECT_FILE;
+        read_data.object_instance = n;
+        read_data.access = FILE_STREAM_ACCESS;
+        read_data.type.stream.fileStartPosition = 8;
+        read_data.type.stream.requestedOctetCount = 16;
+        zassert_true(bacfile_read_stream_data(&read_data), NULL);
+        zassert_false(read_data.endOfFile, NULL);
+        zassert_equal(octetstring_length(&read_data.fileData[0]), 16, NULL);
+        zassert_mem_equal(
+            octetstring_value(&read_data.fileData[0]), &buffer[8], 16, NULL);
+        read_data.type.stream.fileStartPosition = 24;
+        read_data.type.stream.requestedOctetCount = 32;
+        zassert_true(bacfile_read_stream_data(&read_data), NULL);
+        zassert_true(read_data.endOfFile, NULL);
+        zassert_equal(
+            octetstring_length(&read_data.fileData[0]), 8 + n + 1, NULL);
+        len = bacfile_read(n, test_buffer, sizeof(test_buffer));
+        zassert_equal(len, 32 + n + 1, NULL);
+        zassert_mem_equal(test_buffer, buffer, len, NULL);
+    }
+    /* a change made outside of the object is seen after closing */
+    pFile = fopen(bacfile_pathname(0), "ab");
+    zassert_not_null(pFile, NULL);
+    zassert_equal(fwrite(buffer, 4, 1, pFile), 1, NULL);
+    fclose(pFile);
+    bacfile_close(0);
+    zassert_equal(bacfile_file_size(0), 32 + 1 + 4, NULL);
+#if defined(__unix__) || defined(__APPLE__) || defined(_WIN32)
+    /* a file that grows outside of the object is seen while it is open */
+    pFile = fopen(bacfile_pathname(0), "ab");
+    zassert_not_null(pFile, NULL);
+    zassert_equal(fwrite(buffer, 4, 1, pFile), 1, NULL);
+    fclose(pFile);
+    zassert_equal(bacfile_file_size(0), 32 + 1 + 8, NULL);
+#endif
+    /* the whole file is replaced */
+    len = bacfile_write(1, buffer, 8);
+    zassert_equal(len, 8, NULL);
+    zassert_equal(bacfile_file_size(1), 8, NULL);
+    for (n = 0; n < file_count; n++) {
+        snprintf(pathname, sizeof(pathname), "%s", bacfile_pathname(n));
+        zassert_true(bacfile_delete(n), NULL);
+        zassert_equal(remove(pathname), 0, NULL);
+    }
+    bacfile_cleanup();
+}
 /**
  * @}
  */
@@ -78,7 +171,9 @@ ZTEST_SUITE(bacfile_tests, NULL, NULL, NULL, NULL, NULL);
 #else
 void test_main(void)
 {
-    ztest_test_suite(bacfile_tests, ztest_unit_test(test_BACnet_File_Object));
+    ztest_test_suite(
+        bacfile_tests, ztest_unit_test(test_BACnet_File_Object),
+        ztest_unit_test(test_BACnet_File_Stream));
 
     ztest_run_test_suite(bacfile_tests);
 }
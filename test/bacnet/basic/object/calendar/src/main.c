@@ -178,6 +178,8 @@ static void testPresentValue(void)
     zassert_equal(2, Calendar_Date_List_Count(instance), NULL);
     zassert_true(Calendar_Present_Value(instance), NULL);
 
+    /* an entry modified in place is evaluated again once it is
+       retrieved, since the Date_List is cached as a bitmap of days */
     value = Calendar_Date_List_Get(instance, 1);
     value->type.Date.day += 2;
     zassert_equal(2, Calendar_Date_List_Count(instance), NULL);
@@ -198,11 +200,13 @@ static void testPresentValue(void)
     zassert_true(Calendar_Present_Value(instance), NULL);
 
     if (date.day > 1) {
+        value = Calendar_Date_List_Get(instance, 2);
         value->type.DateRange.startdate.day--;
         value->type.DateRange.enddate.day = date.day;
         zassert_true(Calendar_Present_Value(instance), NULL);
     }
 
+    value = Calendar_Date_List_Get(instance, 2);
     value->type.DateRange.startdate.day = date.day + 2;
     value->type.DateRange.enddate.day = date.day + 2;
     zassert_false(Calendar_Present_Value(instance), NULL);
@@ -217,27 +221,35 @@ static void testPresentValue(void)
     value = Calendar_Date_List_Get(instance, 3);
     zassert_true(Calendar_Present_Value(instance), NULL);
 
+    value = Calendar_Date_List_Get(instance, 3);
     value->type.WeekNDay.month = date.month;
     zassert_true(Calendar_Present_Value(instance), NULL);
+    value = Calendar_Date_List_Get(instance, 3);
     value->type.WeekNDay.month++;
     zassert_false(Calendar_Present_Value(instance), NULL);
+    value = Calendar_Date_List_Get(instance, 3);
     value->type.WeekNDay.month = (date.month % 2) ? 13 : 14;
     zassert_true(Calendar_Present_Value(instance), NULL);
+    value = Calendar_Date_List_Get(instance, 3);
     value->type.WeekNDay.month = (date.month % 2) ? 14 : 13;
     zassert_false(Calendar_Present_Value(instance), NULL);
+    value = Calendar_Date_List_Get(instance, 3);
     value->type.WeekNDay.month = 0xff;
 
     value->type.WeekNDay.weekofmonth = (date.day - 1) % 7 + 1;
     zassert_true(Calendar_Present_Value(instance), NULL);
+    value = Calendar_Date_List_Get(instance, 3);
     value->type.WeekNDay.weekofmonth++;
     if (value->type.WeekNDay.weekofmonth > 5) {
         value->type.WeekNDay.weekofmonth = 1;
     }
     zassert_false(Calendar_Present_Value(instance), NULL);
+    value = Calendar_Date_List_Get(instance, 3);
     value->type.WeekNDay.weekofmonth = 0xff;
 
     value->type.WeekNDay.dayofweek = date.wday;
     zassert_true(Calendar_Present_Value(instance), NULL);
+    value = Calendar_Date_List_Get(instance, 3);
     value->type.WeekNDay.dayofweek++;
     if (value->type.WeekNDay.dayofweek > 7) {
         value->type.WeekNDay.dayofweek = 1;
@@ -247,6 +259,41 @@ static void testPresentValue(void)
     Calendar_Date_List_Delete_All(instance);
     zassert_equal(0, Calendar_Date_List_Count(instance), NULL);
 
+    /* test dates of other years, and a range across the new year */
+    entry.tag = BACNET_CALENDAR_DATE_RANGE;
+    datetime_set_date(&entry.type.DateRange.startdate, 2023, 12, 30);
+    datetime_set_date(&entry.type.DateRange.enddate, 2024, 1, 2);
+    Calendar_Date_List_Add(instance, &entry);
+    datetime_set_date(&date, 2023, 12, 29);
+    zassert_false(Calendar_Date_Effective(instance, &date), NULL);
+    datetime_set_date(&date, 2023, 12, 31);
+    zassert_true(Calendar_Date_Effective(instance, &date), NULL);
+    datetime_set_date(&date, 2024, 1, 1);
+    zassert_true(Calendar_Date_Effective(instance, &date), NULL);
+    datetime_set_date(&date, 2024, 1, 3);
+    zassert_false(Calendar_Date_Effective(instance, &date), NULL);
+    /* Thursdays of February, including the leap day */
+    entry.tag = BACNET_CALENDAR_WEEK_N_DAY;
+    entry.type.WeekNDay.month = 2;
+    entry.type.WeekNDay.weekofmonth = 0xff;
+    entry.type.WeekNDay.dayofweek = 4;
+    Calendar_Date_List_Add(instance, &entry);
+    datetime_set_date(&date, 2024, 2, 29);
+    zassert_true(Calendar_Date_Effective(instance, &date), NULL);
+    datetime_set_date(&date, 2024, 2, 28);
+    zassert_false(Calendar_Date_Effective(instance, &date), NULL);
+    datetime_set_date(&date, 2024, 3, 7);
+    zassert_false(Calendar_Date_Effective(instance, &date), NULL);
+    datetime_set_date(&date, 2023, 2, 23);
+    zassert_true(Calendar_Date_Effective(instance, &date), NULL);
+    /* a date with a wildcard is compared to each entry */
+    datetime_set_date(&date, 2024, 1, 1);
+    date.year = 0xffff;
+    zassert_false(Calendar_Date_Effective(instance, &date), NULL);
+    Calendar_Date_List_Delete_All(instance);
+    datetime_set_date(&date, 2024, 1, 1);
+    zassert_false(Calendar_Date_Effective(instance, &date), NULL);
+
     zassert_true(Calendar_Delete(instance), NULL);
 }
 
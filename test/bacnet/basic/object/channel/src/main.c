@@ -240,6 +240,94 @@ static void test_Channel_Property_Read_Write(void)
     zassert_true(status, NULL);
     Channel_Cleanup();
 }
+static unsigned Test_Member_Writes[4];
+
+/**
+ * @brief Count the member writes for each analog output instance
+ * @param wp_data - member write
+ * @return true
+ */
+static bool test_write_property_internal(BACNET_WRITE_PROPERTY_DATA *wp_data)
+{
+    if (wp_data->object_instance < ARRAY_SIZE(Test_Member_Writes)) {
+        Test_Member_Writes[wp_data->object_instance]++;
+    }
+
+    return true;
+}
+
+/**
+ * @brief Test the WriteGroup dispatch to the channels with a matching
+ *  control group and channel number
+ */
+static void test_Channel_Write_Group(void)
+{
+    BACNET_WRITE_GROUP_DATA data = { 0 };
+    BACNET_DEVICE_OBJECT_PROPERTY_REFERENCE member = { 0 };
+    uint32_t instance;
+
+    Channel_Init();
+    Channel_Write_Property_Internal_Callback_Set(test_write_property_internal);
+    /* channel N writes to analog output N */
+    member.deviceIdentifier.type = OBJECT_DEVICE;
+    member.deviceIdentifier.instance = 0;
+    member.objectIdentifier.type = OBJECT_ANALOG_OUTPUT;
+    member.propertyIdentifier = PROP_PRESENT_VALUE;
+    member.arrayIndex = BACNET_ARRAY_ALL;
+    for (instance = 1; instance <= 3; instance++) {
+        zassert_equal(Channel_Create(instance), instance, NULL);
+        member.objectIdentifier.instance = instance;
+        zassert_not_equal(
+            Channel_Reference_List_Member_Element_Add(instance, &member), 0,
+            NULL);
+    }
+    /* channels 1 and 2 are channel number 10 in group 5,
+       and channel 3 is channel number 11 in groups 5 and 6 */
+    zassert_true(Channel_Number_Set(1, 10), NULL);
+    zassert_true(Channel_Number_Set(2, 10), NULL);
+    zassert_true(Channel_Number_Set(3, 11), NULL);
+    zassert_true(Channel_Control_Groups_Element_Set(1, 1, 5), NULL);
+    zassert_true(Channel_Control_Groups_Element_Set(2, 3, 5), NULL);
+    zassert_true(Channel_Control_Groups_Element_Set(3, 1, 5), NULL);
+    zassert_true(Channel_Control_Groups_Element_Set(3, 2, 6), NULL);
+    data.group_number = 5;
+    data.write_priority = 8;
+    data.change_list.channel = 10;
+    data.change_list.overriding_priority = 0;
+    data.change_list.value.tag = BACNET_APPLICATION_TAG_REAL;
+    data.change_list.value.type.Real = 50.0f;
+    Channel_Write_Group(&data, 0, &data.change_list);
+    zassert_equal(Test_Member_Writes[1], 1, NULL);
+    zassert_equal(Test_Member_Writes[2], 1, NULL);
+    zassert_equal(Test_Member_Writes[3], 0, NULL);
+    zassert_equal(Channel_Last_Priority(1), 8, NULL);
+    /* moving a channel to another channel number or group */
+    zassert_true(Channel_Number_Set(2, 11), NULL);
+    data.change_list.overriding_priority = 4;
+    Channel_Write_Group(&data, 0, &data.change_list);
+    zassert_equal(Test_Member_Writes[1], 2, NULL);
+    zassert_equal(Test_Member_Writes[2], 1, NULL);
+    zassert_equal(Channel_Last_Priority(1), 4, NULL);
+    data.group_number = 6;
+    data.change_list.channel = 11;
+    Channel_Write_Group(&data, 0, &data.change_list);
+    zassert_equal(Test_Member_Writes[2], 1, NULL);
+    zassert_equal(Test_Member_Writes[3], 1, NULL);
+    zassert_true(Channel_Control_Groups_Element_Set(3, 2, 0), NULL);
+    Channel_Write_Group(&data, 0, &data.change_list);
+    zassert_equal(Test_Member_Writes[3], 1, NULL);
+    /* group zero and deleted channels are never written */
+    data.group_number = 0;
+    data.change_list.channel = 10;
+    Channel_Write_Group(&data, 0, &data.change_list);
+    zassert_equal(Test_Member_Writes[1], 2, NULL);
+    zassert_true(Channel_Delete(1), NULL);
+    data.group_number = 5;
+    Channel_Write_Group(&data, 0, &data.change_list);
+    zassert_equal(Test_Member_Writes[1], 2, NULL);
+    Channel_Write_Property_Internal_Callback_Set(NULL);
+    Channel_Cleanup();
+}
 /**
  * @}
  */
@@ -247,7 +335,8 @@ static void test_Channel_Property_Read_Write(void)
 void test_main(void)
 {
     ztest_test_suite(
-        channel_tests, ztest_unit_test(test_Channel_Property_Read_Write));
+        channel_tests, ztest_unit_test(test_Channel_Property_Read_Write),
+        ztest_unit_test(test_Channel_Write_Group));
 
     ztest_run_test_suite(channel_tests);
 }
@@ -10,6 +10,7 @@
 
 #include <zephyr/ztest.h>
 #include <bacnet/basic/object/device.h>
+#include <bacnet/basic/object/lo.h>
 #include <bacnet/bactext.h>
 
 /**
@@ -220,6 +221,132 @@ static void testDevice(void)
 
     return;
 }
+
+/**
+ * @brief Test the property membership of the objects against their lists
+ */
+#if defined(CONFIG_ZTEST_NEW_API)
+ZTEST(device_tests, testDevice_Property_List_Member)
+#else
+static void testDevice_Property_List_Member(void)
+#endif
+{
+    struct special_property_list_t property_list = { 0 };
+    BACNET_READ_PROPERTY_DATA rpdata = { 0 };
+    BACNET_WRITE_PROPERTY_DATA wpdata = { 0 };
+    uint8_t apdu[MAX_APDU] = { 0 };
+    int len = 0;
+    BACNET_OBJECT_TYPE object_type;
+    BACNET_PROPERTY_ID property;
+    unsigned pass, i, j;
+
+    Device_Init(NULL);
+    /* the second pass checks the bitmaps again after they were used */
+    for (pass = 0; pass < 2; pass++) {
+        for (i = 0; i < OBJECT_PROPRIETARY_MIN; i++) {
+            object_type = (BACNET_OBJECT_TYPE)i;
+            Device_Objects_Property_List(object_type, 0, &property_list);
+            for (j = 0; j <= PROP_RESERVED_RANGE_MAX; j++) {
+                property = (BACNET_PROPERTY_ID)j;
+                zassert_equal(
+                    Device_Objects_Property_List_Member(
+                        object_type, 0, property),
+                    property_lists_member(
+                        property_list.Required.pList,
+                        property_list.Optional.pList,
+                        property_list.Proprietary.pList, property),
+                    "%s: %s", bactext_object_type_name(object_type),
+                    bactext_property_name(property));
+            }
+        }
+    }
+    zassert_true(
+        Device_Objects_Property_List_Member(
+            OBJECT_DEVICE, 0, PROP_SYSTEM_STATUS),
+        NULL);
+    zassert_false(
+        Device_Objects_Property_List_Member(
+            OBJECT_DEVICE, 0, PROP_PRESENT_VALUE),
+        NULL);
+    zassert_false(
+        Device_Objects_Property_List_Member(
+            OBJECT_DEVICE, 0, PROP_PROPRIETARY_RANGE_MIN),
+        NULL);
+    /* the read and write paths reject a property that is not a member */
+    rpdata.object_type = OBJECT_DEVICE;
+    rpdata.object_instance = Device_Object_Instance_Number();
+    rpdata.object_property = PROP_PRESENT_VALUE;
+    rpdata.array_index = BACNET_ARRAY_ALL;
+    rpdata.application_data = apdu;
+    rpdata.application_data_len = sizeof(apdu);
+    len = Device_Read_Property(&rpdata);
+    zassert_equal(len, BACNET_STATUS_ERROR, NULL);
+    zassert_equal(rpdata.error_class, ERROR_CLASS_PROPERTY, NULL);
+    zassert_equal(rpdata.error_code, ERROR_CODE_UNKNOWN_PROPERTY, NULL);
+    rpdata.object_property = PROP_SYSTEM_STATUS;
+    len = Device_Read_Property(&rpdata);
+    zassert_true(len > 0, NULL);
+    wpdata.object_type = OBJECT_DEVICE;
+    wpdata.object_instance = Device_Object_Instance_Number();
+    wpdata.object_property = PROP_PRESENT_VALUE;
+    wpdata.array_index = BACNET_ARRAY_ALL;
+    wpdata.application_data_len =
+        encode_application_real(wpdata.application_data, 1.0f);
+    zassert_false(Device_Write_Property(&wpdata), NULL);
+    zassert_equal(wpdata.error_class, ERROR_CLASS_PROPERTY, NULL);
+    zassert_equal(wpdata.error_code, ERROR_CODE_UNKNOWN_PROPERTY, NULL);
+}
+
+/**
+ * @brief Test the registry of objects with timed operations in progress
+ */
+#if defined(CONFIG_ZTEST_NEW_API)
+ZTEST(device_tests, testDevice_Timer)
+#else
+static void testDevice_Timer(void)
+#endif
+{
+    const uint32_t instance = 123;
+    BACNET_LIGHTING_COMMAND command = { 0 };
+    bool status = false;
+
+    Device_Init(NULL);
+    zassert_equal(Device_Timer_Count(), 0, NULL);
+    zassert_equal(Lighting_Output_Create(instance), instance, NULL);
+    /* objects without a timer are not registered */
+    status = Device_Timer_Register(OBJECT_DEVICE, instance);
+    zassert_false(status, NULL);
+    status = Device_Timer_Register(
+        OBJECT_LIGHTING_OUTPUT, BACNET_MAX_INSTANCE + 1);
+    zassert_false(status, NULL);
+    zassert_equal(Device_Timer_Count(), 0, NULL);
+    /* a fade registers the object until the fade is complete */
+    command.operation = BACNET_LIGHTS_FADE_TO;
+    command.target_level = 50.0f;
+    command.fade_time = 1000;
+    command.priority = 8;
+    status = Lighting_Output_Lighting_Command_Set(instance, &command);
+    zassert_true(status, NULL);
+    zassert_equal(Device_Timer_Count(), 1, NULL);
+    /* registering again is harmless */
+    status = Device_Timer_Register(OBJECT_LIGHTING_OUTPUT, instance);
+    zassert_true(status, NULL);
+    zassert_equal(Device_Timer_Count(), 1, NULL);
+    Device_Timer(500);
+    zassert_equal(Device_Timer_Count(), 1, NULL);
+    Device_Timer(1000);
+    zassert_equal(Device_Timer_Count(), 0, NULL);
+    zassert_false(
+        islessgreater(Lighting_Output_Tracking_Value(instance), 50.0f), NULL);
+    /* deleting the object removes it from the registry */
+    command.target_level = 0.0f;
+    status = Lighting_Output_Lighting_Command_Set(instance, &command);
+    zassert_true(status, NULL);
+    zassert_equal(Device_Timer_Count(), 1, NULL);
+    zassert_true(Lighting_Output_Delete(instance), NULL);
+    zassert_equal(Device_Timer_Count(), 0, NULL);
+    Device_Timer(1000);
+}
 /**
  * @}
  */
@@ -231,7 +358,9 @@ void test_main(void)
 {
     ztest_test_suite(
         device_tests, ztest_unit_test(testDevice),
-        ztest_unit_test(test_Device_Data_Sharing));
+        ztest_unit_test(test_Device_Data_Sharing),
+        ztest_unit_test(testDevice_Property_List_Member),
+        ztest_unit_test(testDevice_Timer));
 
     ztest_run_test_suite(device_tests);
 }
@@ -0,0 +1,136 @@
+/**
+ * @file
+ * @brief Unit test for the routed Devices of a gateway
+ * @author Steve Karg <skarg@users.sourceforge.net>
+ * @date 2024
+ * @copyright SPDX-License-Identifier: MIT
+ */
+#include <zephyr/ztest.h>
+#include <bacnet/bacdcode.h>
+#include <bacnet/basic/object/device.h>
+
+/**
+ * @addtogroup bacnet_tests
+ * @{
+ */
+
+#define TEST_GATEWAY_INSTANCE 1000
+#define TEST_GATEWAY_NET 4000
+/* more routed Devices than the compile time limit */
+#define TEST_ROUTED_DEVICES (MAX_NUM_DEVICES * 4)
+
+/**
+ * @brief Encode the virtual address of a routed Device
+ */
+static void test_routed_address(BACNET_ADDRESS *address, uint32_t instance)
+{
+    memset(address, 0, sizeof(BACNET_ADDRESS));
+    address->net = TEST_GATEWAY_NET;
+    address->len = encode_unsigned24(&address->adr[0], instance);
+}
+
+/**
+ * @brief Test the lookup of many routed Devices by MAC address and instance
+ */
+#if defined(CONFIG_ZTEST_NEW_API)
+ZTEST(gateway_tests, testRoutedDeviceLookup)
+#else
+static void testRoutedDeviceLookup(void)
+#endif
+{
+    BACNET_ADDRESS address = { 0 };
+    DEVICE_OBJECT_DATA *pDev;
+    uint32_t instance;
+    uint8_t mac[3];
+    uint16_t idx;
+    int i;
+
+    Device_Init(NULL);
+    Routed_Device_Max_Set(TEST_ROUTED_DEVICES + 1);
+    zassert_equal(Routed_Device_Max(), TEST_ROUTED_DEVICES + 1, NULL);
+    Routing_Device_Init(TEST_GATEWAY_INSTANCE);
+    zassert_equal(Routed_Device_Count(), 1, NULL);
+    for (i = 1; i <= TEST_ROUTED_DEVICES; i++) {
+        instance = TEST_GATEWAY_INSTANCE + i;
+        idx = Add_Routed_Device(instance, NULL, NULL);
+        zassert_equal(idx, i, NULL);
+        test_routed_address(&address, instance);
+        zassert_true(Routed_Device_Address_Set(idx, &address), NULL);
+        /* adding a Device does not change the managed Device */
+        zassert_equal(Routed_Device_Context(), 0, NULL);
+    }
+    zassert_equal(Routed_Device_Count(), TEST_ROUTED_DEVICES + 1, NULL);
+    /* the limit is reached */
+    idx = Add_Routed_Device(TEST_GATEWAY_INSTANCE, NULL, NULL);
+    zassert_equal(idx, UINT16_MAX, NULL);
+    zassert_equal(Routed_Device_Count(), TEST_ROUTED_DEVICES + 1, NULL);
+    for (i = 0; i <= TEST_ROUTED_DEVICES; i++) {
+        instance = TEST_GATEWAY_INSTANCE + i;
+        zassert_equal(Routed_Device_Instance_Index(instance), i, NULL);
+        if (i > 0) {
+            encode_unsigned24(&mac[0], instance);
+            zassert_equal(Routed_Device_MAC_Index(3, mac), i, NULL);
+        }
+    }
+    zassert_equal(
+        Routed_Device_Instance_Index(
+            TEST_GATEWAY_INSTANCE + TEST_ROUTED_DEVICES + 1),
+        -1, NULL);
+    encode_unsigned24(&mac[0], TEST_GATEWAY_INSTANCE + TEST_ROUTED_DEVICES + 1);
+    zassert_equal(Routed_Device_MAC_Index(3, mac), -1, NULL);
+    /* lookups do not change the managed Device */
+    pDev = Get_Routed_Device_Object(TEST_ROUTED_DEVICES);
+    zassert_not_null(pDev, NULL);
+    zassert_equal(
+        pDev->bacObj.Object_Instance_Number,
+        TEST_GATEWAY_INSTANCE + TEST_ROUTED_DEVICES, NULL);
+    zassert_not_null(Get_Routed_Device_Address(TEST_ROUTED_DEVICES), NULL);
+    zassert_false(
+        Routed_Device_Valid_Object_Instance_Number(TEST_GATEWAY_INSTANCE + 1),
+        NULL);
+    zassert_equal(Routed_Device_Context(), 0, NULL);
+    zassert_true(
+        Routed_Device_Valid_Object_Instance_Number(TEST_GATEWAY_INSTANCE),
+        NULL);
+    /* only the context selects the managed Device */
+    zassert_true(Routed_Device_Context_Set(TEST_ROUTED_DEVICES), NULL);
+    zassert_equal(
+        Routed_Device_Object_Instance_Number(),
+        TEST_GATEWAY_INSTANCE + TEST_ROUTED_DEVICES, NULL);
+    zassert_false(Routed_Device_Context_Set(TEST_ROUTED_DEVICES + 1), NULL);
+    zassert_equal(Routed_Device_Context(), TEST_ROUTED_DEVICES, NULL);
+    /* a new instance is found after it is changed */
+    instance = TEST_GATEWAY_INSTANCE + TEST_ROUTED_DEVICES + 100;
+    zassert_true(Routed_Device_Set_Object_Instance_Number(instance), NULL);
+    zassert_equal(
+        Routed_Device_Instance_Index(instance), TEST_ROUTED_DEVICES, NULL);
+    zassert_equal(
+        Routed_Device_Instance_Index(
+            TEST_GATEWAY_INSTANCE + TEST_ROUTED_DEVICES),
+        -1, NULL);
+    /* a new MAC address is found after it is changed */
+    test_routed_address(&address, instance);
+    zassert_true(
+        Routed_Device_Address_Set(TEST_ROUTED_DEVICES, &address), NULL);
+    encode_unsigned24(&mac[0], instance);
+    zassert_equal(Routed_Device_MAC_Index(3, mac), TEST_ROUTED_DEVICES, NULL);
+    encode_unsigned24(&mac[0], TEST_GATEWAY_INSTANCE + TEST_ROUTED_DEVICES);
+    zassert_equal(Routed_Device_MAC_Index(3, mac), -1, NULL);
+    zassert_false(
+        Routed_Device_Address_Set(TEST_ROUTED_DEVICES + 1, &address), NULL);
+    zassert_true(Routed_Device_Context_Set(0), NULL);
+}
+/**
+ * @}
+ */
+
+#if defined(CONFIG_ZTEST_NEW_API)
+ZTEST_SUITE(gateway_tests, NULL, NULL, NULL, NULL, NULL);
+#else
+void test_main(void)
+{
+    ztest_test_suite(gateway_tests, ztest_unit_test(testRoutedDeviceLookup));
+
+    ztest_run_test_suite(gateway_tests);
+}
+#endif
@@ -0,0 +1,266 @@
+/**
+ * @file
+ * @brief Unit test for the persistent object store
+ * @author Steve Karg <skarg@users.sourceforge.net>
+ * @date 2024
+ * @copyright SPDX-License-Identifier: MIT
+ */
+#include <stdio.h>
+#include <string.h>
+#include <zephyr/ztest.h>
+#include <bacnet/basic/object/objstore.h>
+
+/**
+ * @addtogroup bacnet_tests
+ * @{
+ */
+
+#define TEST_STORE_PATHNAME "objstore_test.db"
+
+/* log of the calls made when the store is restored */
+struct test_restore_call {
+    char service;
+    BACNET_OBJECT_TYPE object_type;
+    uint32_t object_instance;
+    BACNET_PROPERTY_ID object_property;
+    uint8_t priority;
+    uint8_t value;
+};
+static struct test_restore_call Test_Calls[10];
+static unsigned Test_Call_Count;
+
+/**
+ * @brief Log a call made when the store is restored
+ */
+static void test_call_add(
+    char service,
+    BACNET_OBJECT_TYPE object_type,
+    uint32_t object_instance,
+    BACNET_PROPERTY_ID object_property,
+    uint8_t priority,
+    uint8_t value)
+{
+    struct test_restore_call *call;
+
+    if (Test_Call_Count < ARRAY_SIZE(Test_Calls)) {
+        call = &Test_Calls[Test_Call_Count];
+        call->service = service;
+        call->object_type = object_type;
+        call->object_instance = object_instance;
+        call->object_property = object_property;
+        call->priority = priority;
+        call->value = value;
+    }
+    Test_Call_Count++;
+}
+
+static bool test_create_object(BACNET_CREATE_OBJECT_DATA *data)
+{
+    test_call_add(
+        'C', data->object_type, data->object_instance, PROP_ALL, 0, 0);
+    /* changes while restoring are not stored again */
+    Object_Store_Create_Object(data->object_type, data->object_instance);
+
+    return true;
+}
+
+static bool test_delete_object(BACNET_DELETE_OBJECT_DATA *data)
+{
+    test_call_add(
+        'D', data->object_type, data->object_instance, PROP_ALL, 0, 0);
+
+    return true;
+}
+
+static bool test_write_property(BACNET_WRITE_PROPERTY_DATA *wp_data)
+{
+    zassert_equal(wp_data->application_data_len, 2, NULL);
+    test_call_add(
+        'W', wp_data->object_type, wp_data->object_instance,
+        wp_data->object_property, wp_data->priority,
+        wp_data->application_data[1]);
+    zassert_false(Object_Store_Write_Property(wp_data), NULL);
+
+    return true;
+}
+
+/**
+ * @brief Store a WriteProperty with a value of two octets
+ */
+static bool test_write(
+    BACNET_OBJECT_TYPE object_type,
+    uint32_t object_instance,
+    BACNET_PROPERTY_ID object_property,
+    uint8_t priority,
+    uint8_t value)
+{
+    BACNET_WRITE_PROPERTY_DATA wp_data = { 0 };
+
+    wp_data.object_type = object_type;
+    wp_data.object_instance = object_instance;
+    wp_data.object_property = object_property;
+    wp_data.array_index = BACNET_ARRAY_ALL;
+    wp_data.priority = priority;
+    wp_data.application_data[0] = 0x21;
+    wp_data.application_data[1] = value;
+    wp_data.application_data_len = 2;
+
+    return Object_Store_Write_Property(&wp_data);
+}
+
+/**
+ * @brief Check a call made when the store was restored
+ */
+static void test_call_check(
+    unsigned index,
+    char service,
+    BACNET_OBJECT_TYPE object_type,
+    uint32_t object_instance,
+    BACNET_PROPERTY_ID object_property,
+    uint8_t value)
+{
+    const struct test_restore_call *call = &Test_Calls[index];
+
+    zassert_equal(call->service, service, "call[%u]", index);
+    zassert_equal(call->object_type, object_type, "call[%u]", index);
+    zassert_equal(call->object_instance, object_instance, "call[%u]", index);
+    zassert_equal(call->object_property, object_property, "call[%u]", index);
+    zassert_equal(call->value, value, "call[%u]", index);
+}
+
+/**
+ * @brief Restore the store, logging the calls
+ * @return number of objects and properties restored
+ */
+static unsigned test_restore(void)
+{
+    Test_Call_Count = 0;
+
+    return Object_Store_Restore(
+        test_create_object, test_delete_object, test_write_property);
+}
+
+static void test_files_remove(void)
+{
+    (void)remove(TEST_STORE_PATHNAME);
+    (void)remove(TEST_STORE_PATHNAME ".journal");
+    (void)remove(TEST_STORE_PATHNAME ".tmp");
+}
+
+/**
+ * @brief Test the journal, snapshot, and restore of the object store
+ */
+#if defined(CONFIG_ZTEST_NEW_API)
+ZTEST(objstore_tests, testObjectStore)
+#else
+static void testObjectStore(void)
+#endif
+{
+    FILE *pFile;
+    long size;
+    unsigned restored;
+
+    test_files_remove();
+    zassert_true(Object_Store_Init(TEST_STORE_PATHNAME), NULL);
+    zassert_equal(Object_Store_Count(), 0, NULL);
+    zassert_equal(Object_Store_Journal_Size(), 0, NULL);
+    /* journal some changes */
+    Object_Store_Create_Object(OBJECT_ANALOG_VALUE, 1);
+    zassert_true(
+        test_write(OBJECT_ANALOG_VALUE, 1, PROP_PRESENT_VALUE, 8, 10), NULL);
+    zassert_true(
+        test_write(OBJECT_ANALOG_VALUE, 1, PROP_OUT_OF_SERVICE, 0, 1), NULL);
+    zassert_true(
+        test_write(OBJECT_ANALOG_VALUE, 1, PROP_PRESENT_VALUE, 8, 20), NULL);
+    zassert_true(
+        test_write(OBJECT_ANALOG_VALUE, 1, PROP_PRESENT_VALUE, 16, 30), NULL);
+    zassert_true(
+        test_write(OBJECT_BINARY_VALUE, 2, PROP_PRESENT_VALUE, 16, 1), NULL);
+    zassert_true(
+        test_write(OBJECT_ANALOG_OUTPUT, 3, PROP_PRESENT_VALUE, 16, 5), NULL);
+    Object_Store_Delete_Object(OBJECT_ANALOG_OUTPUT, 3);
+    zassert_equal(Object_Store_Count(), 3, NULL);
+    size = Object_Store_Journal_Size();
+    zassert_true(size > 0, NULL);
+    /* restart, and restore from the compacted snapshot */
+    Object_Store_Cleanup();
+    zassert_true(Object_Store_Init(TEST_STORE_PATHNAME), NULL);
+    zassert_equal(Object_Store_Journal_Size(), 0, NULL);
+    zassert_equal(Object_Store_Count(), 3, NULL);
+    restored = test_restore();
+    zassert_equal(restored, 6, NULL);
+    zassert_equal(Test_Call_Count, 6, NULL);
+    /* objects are created and deleted before any property is written */
+    test_call_check(0, 'D', OBJECT_ANALOG_OUTPUT, 3, PROP_ALL, 0);
+    test_call_check(1, 'C', OBJECT_ANALOG_VALUE, 1, PROP_ALL, 0);
+    /* the latest value of each property and priority, in write order */
+    test_call_check(2, 'W', OBJECT_ANALOG_VALUE, 1, PROP_OUT_OF_SERVICE, 1);
+    test_call_check(3, 'W', OBJECT_ANALOG_VALUE, 1, PROP_PRESENT_VALUE, 20);
+    zassert_equal(Test_Calls[3].priority, 8, NULL);
+    test_call_check(4, 'W', OBJECT_ANALOG_VALUE, 1, PROP_PRESENT_VALUE, 30);
+    zassert_equal(Test_Calls[4].priority, 16, NULL);
+    test_call_check(5, 'W', OBJECT_BINARY_VALUE, 2, PROP_PRESENT_VALUE, 1);
+    /* the restore itself is not journaled */
+    zassert_equal(Object_Store_Journal_Size(), 0, NULL);
+    /* creating an object again discards its properties */
+    Object_Store_Create_Object(OBJECT_ANALOG_VALUE, 1);
+    zassert_true(
+        test_write(OBJECT_ANALOG_VALUE, 1, PROP_PRESENT_VALUE, 8, 40), NULL);
+    Object_Store_Cleanup();
+    /* a record that was not completely written is ignored */
+    pFile = fopen(TEST_STORE_PATHNAME ".journal", "ab");
+    zassert_not_null(pFile, NULL);
+    fwrite("\x03\x00\x02", 1, 3, pFile);
+    fclose(pFile);
+    zassert_true(Object_Store_Init(TEST_STORE_PATHNAME), NULL);
+    restored = test_restore();
+    zassert_equal(restored, 4, NULL);
+    test_call_check(0, 'D', OBJECT_ANALOG_OUTPUT, 3, PROP_ALL, 0);
+    test_call_check(1, 'C', OBJECT_ANALOG_VALUE, 1, PROP_ALL, 0);
+    test_call_check(2, 'W', OBJECT_ANALOG_VALUE, 1, PROP_PRESENT_VALUE, 40);
+    test_call_check(3, 'W', OBJECT_BINARY_VALUE, 2, PROP_PRESENT_VALUE, 1);
+    /* a snapshot empties the journal */
+    zassert_true(
+        test_write(OBJECT_BINARY_VALUE, 2, PROP_PRESENT_VALUE, 16, 0), NULL);
+    zassert_true(Object_Store_Journal_Size() > 0, NULL);
+    zassert_true(Object_Store_Compact(), NULL);
+    zassert_equal(Object_Store_Journal_Size(), 0, NULL);
+    /* a record that fails its CRC ends the journal */
+    zassert_true(
+        test_write(OBJECT_BINARY_VALUE, 2, PROP_PRESENT_VALUE, 16, 2), NULL);
+    size = Object_Store_Journal_Size();
+    zassert_true(
+        test_write(OBJECT_ANALOG_VALUE, 1, PROP_PRESENT_VALUE, 8, 50), NULL);
+    Object_Store_Cleanup();
+    pFile = fopen(TEST_STORE_PATHNAME ".journal", "r+b");
+    zassert_not_null(pFile, NULL);
+    /* the value octet of the first record */
+    zassert_equal(fseek(pFile, size - 3, SEEK_SET), 0, NULL);
+    fputc(3, pFile);
+    fclose(pFile);
+    zassert_true(Object_Store_Init(TEST_STORE_PATHNAME), NULL);
+    restored = test_restore();
+    zassert_equal(restored, 4, NULL);
+    test_call_check(2, 'W', OBJECT_ANALOG_VALUE, 1, PROP_PRESENT_VALUE, 40);
+    test_call_check(3, 'W', OBJECT_BINARY_VALUE, 2, PROP_PRESENT_VALUE, 0);
+    Object_Store_Cleanup();
+    /* without a store, nothing is recorded */
+    zassert_false(
+        test_write(OBJECT_BINARY_VALUE, 2, PROP_PRESENT_VALUE, 16, 0), NULL);
+    zassert_false(Object_Store_Compact(), NULL);
+    test_files_remove();
+}
+/**
+ * @}
+ */
+
+#if defined(CONFIG_ZTEST_NEW_API)
+ZTEST_SUITE(objstore_tests, NULL, NULL, NULL, NULL, NULL);
+#else
+void test_main(void)
+{
+    ztest_test_suite(objstore_tests, ztest_unit_test(testObjectStore));
+
+    ztest_run_test_suite(objstore_tests);
+}
+#endif
@@ -7,7 +7,9 @@
  * SPDX-License-Identifier: MIT
  */
 
+#include <math.h>
 #include <zephyr/ztest.h>
+#include <bacnet/basic/object/calendar.h>
 #include <bacnet/basic/object/schedule.h>
 #include <property_test.h>
 
@@ -38,6 +40,270 @@ static void testSchedule(void)
         Schedule_Read_Property, Schedule_Write_Property,
         skip_fail_property_list);
 }
+/**
+ * @brief Set a time value with a REAL value, or NULL when value is negative
+ */
+static void
+time_value_set(BACNET_TIME_VALUE *tv, uint8_t hour, uint8_t minute, float value)
+{
+    datetime_set_time(&tv->Time, hour, minute, 0, 0);
+    if (value < 0.0f) {
+        tv->Value.tag = BACNET_APPLICATION_TAG_NULL;
+    } else {
+        tv->Value.tag = BACNET_APPLICATION_TAG_REAL;
+        tv->Value.type.Real = value;
+    }
+}
+
+/**
+ * @brief Evaluate a schedule and check the value and the next transition
+ */
+static void schedule_evaluate_check(
+    SCHEDULE_DESCR *desc,
+    const BACNET_DATE *date,
+    uint8_t hour,
+    uint8_t minute,
+    float value,
+    bool next_valid,
+    uint8_t next_hour,
+    uint8_t next_minute)
+{
+    BACNET_TIME time = { 0 }, next_time = { 0 };
+
+    datetime_set_time(&time, hour, minute, 0, 0);
+    Schedule_Evaluate(desc, date, &time);
+    zassert_equal(desc->Present_Value.tag, BACNET_APPLICATION_TAG_REAL, NULL);
+    zassert_false(
+        islessgreater(desc->Present_Value.type.Real, value), "%02u:%02u",
+        hour, minute);
+    zassert_equal(
+        Schedule_Next_Transition(desc, date, &time, &next_time), next_valid,
+        "%02u:%02u", hour, minute);
+    zassert_equal(desc->Next_Transition_Valid, next_valid, NULL);
+    if (next_valid) {
+        zassert_equal(next_time.hour, next_hour, NULL);
+        zassert_equal(next_time.min, next_minute, NULL);
+    }
+}
+
+/**
+ * @brief Test the evaluation of the Present_Value
+ */
+#if defined(CONFIG_ZTEST_NEW_API)
+ZTEST(schedule_tests, testScheduleEvaluate)
+#else
+static void testScheduleEvaluate(void)
+#endif
+{
+    static SCHEDULE_DESCR desc;
+    BACNET_CALENDAR_ENTRY entry = { 0 };
+    BACNET_SPECIAL_EVENT *event;
+    BACNET_DATE monday = { 0 }, tuesday = { 0 }, next_year = { 0 };
+    BACNET_TIME time = { 0 };
+    uint32_t calendar_instance;
+
+    datetime_set_date(&monday, 2026, 10, 19);
+    datetime_set_date(&tuesday, 2026, 10, 20);
+    datetime_set_date(&next_year, 2027, 10, 18);
+    zassert_equal(monday.wday, BACNET_WEEKDAY_MONDAY, NULL);
+    memset(&desc, 0, sizeof(desc));
+    datetime_set_date(&desc.Start_Date, 2026, 1, 1);
+    datetime_set_date(&desc.End_Date, 2026, 12, 31);
+    desc.Schedule_Default.tag = BACNET_APPLICATION_TAG_REAL;
+    desc.Schedule_Default.type.Real = 18.0f;
+    /* time values are not required to be in order */
+    time_value_set(&desc.Weekly_Schedule[0].Time_Values[0], 17, 0, -1.0f);
+    time_value_set(&desc.Weekly_Schedule[0].Time_Values[1], 8, 0, 22.0f);
+    desc.Weekly_Schedule[0].TV_Count = 2;
+    datetime_set_time(&time, 7, 0, 0, 0);
+    zassert_true(Schedule_Evaluate(&desc, &monday, &time), NULL);
+    zassert_false(Schedule_Evaluate(&desc, &monday, &time), NULL);
+    schedule_evaluate_check(&desc, &monday, 7, 0, 18.0f, true, 8, 0);
+    schedule_evaluate_check(&desc, &monday, 8, 0, 22.0f, true, 17, 0);
+    schedule_evaluate_check(&desc, &monday, 17, 30, 18.0f, false, 0, 0);
+    schedule_evaluate_check(&desc, &tuesday, 9, 0, 18.0f, false, 0, 0);
+    /* outside of the effective period */
+    schedule_evaluate_check(&desc, &next_year, 9, 0, 18.0f, false, 0, 0);
+    /* special event by calendar entry */
+    event = &desc.Exception_Schedule[0];
+    event->periodTag = BACNET_SPECIAL_EVENT_PERIOD_CALENDAR_ENTRY;
+    event->period.calendarEntry.tag = BACNET_CALENDAR_DATE;
+    datetime_copy_date(&event->period.calendarEntry.type.Date, &monday);
+    time_value_set(&event->timeValues.Time_Values[0], 12, 0, 30.0f);
+    time_value_set(&event->timeValues.Time_Values[1], 13, 0, -1.0f);
+    event->timeValues.TV_Count = 2;
+    event->priority = 10;
+    /* special event by calendar reference, with a higher priority */
+    Calendar_Init();
+    calendar_instance = Calendar_Create(1);
+    zassert_equal(calendar_instance, 1, NULL);
+    event = &desc.Exception_Schedule[1];
+    event->periodTag = BACNET_SPECIAL_EVENT_PERIOD_CALENDAR_REFERENCE;
+    event->period.calendarReference.type = OBJECT_CALENDAR;
+    event->period.calendarReference.instance = calendar_instance;
+    time_value_set(&event->timeValues.Time_Values[0], 12, 30, 40.0f);
+    event->timeValues.TV_Count = 1;
+    event->priority = 5;
+    /* calendar does not include the date yet */
+    schedule_evaluate_check(&desc, &monday, 12, 45, 30.0f, true, 13, 0);
+    entry.tag = BACNET_CALENDAR_DATE;
+    datetime_copy_date(&entry.type.Date, &monday);
+    Calendar_Date_List_Add(calendar_instance, &entry);
+    zassert_equal(Calendar_Date_List_Count(calendar_instance), 1, NULL);
+    schedule_evaluate_check(&desc, &monday, 11, 0, 22.0f, true, 12, 0);
+    schedule_evaluate_check(&desc, &monday, 12, 15, 30.0f, true, 12, 30);
+    schedule_evaluate_check(&desc, &monday, 12, 45, 40.0f, true, 13, 0);
+    /* the calendar reference event has no NULL to relinquish */
+    schedule_evaluate_check(&desc, &monday, 13, 30, 40.0f, true, 17, 0);
+    event->priority = 15;
+    schedule_evaluate_check(&desc, &monday, 12, 45, 30.0f, true, 13, 0);
+    schedule_evaluate_check(&desc, &monday, 13, 30, 40.0f, true, 17, 0);
+    schedule_evaluate_check(&desc, &tuesday, 13, 30, 18.0f, false, 0, 0);
+    Calendar_Cleanup();
+}
+
+/* WriteProperty calls made by the Schedule task */
+static unsigned Test_Write_Count;
+static BACNET_WRITE_PROPERTY_DATA Test_Write_Data;
+
+static bool test_write_property(BACNET_WRITE_PROPERTY_DATA *wp_data)
+{
+    memcpy(&Test_Write_Data, wp_data, sizeof(Test_Write_Data));
+    Test_Write_Count++;
+
+    return true;
+}
+
+/**
+ * @brief Run the Schedule task, and check the number of writes and the
+ *  Present_Value
+ */
+static void schedule_task_check(
+    uint32_t object_instance,
+    uint8_t hour,
+    uint8_t minute,
+    unsigned write_count,
+    float value)
+{
+    BACNET_DATE_TIME bdatetime = { 0 };
+    BACNET_READ_PROPERTY_DATA rpdata = { 0 };
+    BACNET_APPLICATION_DATA_VALUE pv = { 0 };
+    uint8_t apdu[MAX_APDU] = { 0 };
+    int len;
+
+    /* Monday */
+    datetime_set_values(&bdatetime, 2026, 10, 19, hour, minute, 0, 0);
+    Schedule_Task(&bdatetime);
+    zassert_equal(
+        Test_Write_Count, write_count, "%02u:%02u", hour, minute);
+    rpdata.application_data = apdu;
+    rpdata.application_data_len = sizeof(apdu);
+    rpdata.object_type = OBJECT_SCHEDULE;
+    rpdata.object_instance = object_instance;
+    rpdata.object_property = PROP_PRESENT_VALUE;
+    rpdata.array_index = BACNET_ARRAY_ALL;
+    len = Schedule_Read_Property(&rpdata);
+    zassert_true(len > 0, NULL);
+    len = bacapp_decode_application_data(apdu, len, &pv);
+    zassert_true(len > 0, NULL);
+    zassert_equal(pv.tag, BACNET_APPLICATION_TAG_REAL, NULL);
+    zassert_false(
+        islessgreater(pv.type.Real, value), "%02u:%02u", hour, minute);
+}
+
+/**
+ * @brief Test the Schedule task writes the references on a change only,
+ *  and evaluates the schedules again when a Calendar changes or the
+ *  clock moves backwards
+ */
+#if defined(CONFIG_ZTEST_NEW_API)
+ZTEST(schedule_tests, testScheduleTask)
+#else
+static void testScheduleTask(void)
+#endif
+{
+    BACNET_DATE_TIME bdatetime = { 0 };
+    BACNET_CALENDAR_ENTRY entry = { 0 };
+    BACNET_APPLICATION_DATA_VALUE value = { 0 };
+    BACNET_DEVICE_OBJECT_PROPERTY_REFERENCE *member;
+    BACNET_SPECIAL_EVENT *event;
+    SCHEDULE_DESCR *desc;
+    uint32_t object_instance, calendar_instance;
+    int len;
+
+    Schedule_Init();
+    Calendar_Init();
+    calendar_instance = Calendar_Create(1);
+    object_instance = Schedule_Index_To_Instance(0);
+    desc = Schedule_Object(object_instance);
+    zassert_not_null(desc, NULL);
+    zassert_is_null(Schedule_Object(BACNET_MAX_INSTANCE), NULL);
+    member = &desc->Object_Property_References[0];
+    member->deviceIdentifier.type = OBJECT_DEVICE;
+    member->deviceIdentifier.instance = BACNET_MAX_INSTANCE;
+    member->objectIdentifier.type = OBJECT_ANALOG_VALUE;
+    member->objectIdentifier.instance = 1;
+    member->propertyIdentifier = PROP_PRESENT_VALUE;
+    member->arrayIndex = BACNET_ARRAY_ALL;
+    desc->obj_prop_ref_cnt = 1;
+    time_value_set(&desc->Weekly_Schedule[0].Time_Values[0], 8, 0, 22.0f);
+    time_value_set(&desc->Weekly_Schedule[0].Time_Values[1], 17, 0, -1.0f);
+    desc->Weekly_Schedule[0].TV_Count = 2;
+    event = &desc->Exception_Schedule[0];
+    event->periodTag = BACNET_SPECIAL_EVENT_PERIOD_CALENDAR_REFERENCE;
+    event->period.calendarReference.type = OBJECT_CALENDAR;
+    event->period.calendarReference.instance = calendar_instance;
+    time_value_set(&event->timeValues.Time_Values[0], 12, 0, 30.0f);
+    event->timeValues.TV_Count = 1;
+    event->priority = 5;
+    Test_Write_Count = 0;
+    Schedule_Write_Property_Internal_Callback_Set(test_write_property);
+    /* the first evaluation writes the references */
+    schedule_task_check(object_instance, 7, 0, 1, 21.0f);
+    zassert_equal(Test_Write_Data.object_type, OBJECT_ANALOG_VALUE, NULL);
+    zassert_equal(Test_Write_Data.object_instance, 1, NULL);
+    zassert_equal(Test_Write_Data.object_property, PROP_PRESENT_VALUE, NULL);
+    zassert_equal(Test_Write_Data.priority, 16, NULL);
+    len = bacapp_decode_application_data(
+        Test_Write_Data.application_data,
+        Test_Write_Data.application_data_len, &value);
+    zassert_true(len > 0, NULL);
+    zassert_false(islessgreater(value.type.Real, 21.0f), NULL);
+    /* before the next transition, the schedule is not evaluated again */
+    desc->Schedule_Default.type.Real = 19.0f;
+    schedule_task_check(object_instance, 7, 30, 1, 21.0f);
+    /* the transition is written once */
+    schedule_task_check(object_instance, 8, 0, 2, 22.0f);
+    len = bacapp_decode_application_data(
+        Test_Write_Data.application_data,
+        Test_Write_Data.application_data_len, &value);
+    zassert_true(len > 0, NULL);
+    zassert_false(islessgreater(value.type.Real, 22.0f), NULL);
+    schedule_task_check(object_instance, 8, 30, 2, 22.0f);
+    /* a change to the Date_List of the Calendar is seen at once */
+    entry.tag = BACNET_CALENDAR_DATE;
+    datetime_set_date(&entry.type.Date, 2026, 10, 19);
+    zassert_true(Calendar_Date_List_Add(calendar_instance, &entry), NULL);
+    schedule_task_check(object_instance, 12, 5, 3, 30.0f);
+    zassert_true(Calendar_Date_List_Delete_All(calendar_instance), NULL);
+    schedule_task_check(object_instance, 12, 10, 4, 22.0f);
+    /* the clock moves backwards within the same day */
+    schedule_task_check(object_instance, 7, 0, 5, 19.0f);
+    /* a refresh without a change does not write */
+    Schedule_Task_Refresh();
+    schedule_task_check(object_instance, 7, 5, 5, 19.0f);
+    /* out of service does not evaluate, and resumes when in service */
+    Schedule_Out_Of_Service_Set(object_instance, true);
+    schedule_task_check(object_instance, 9, 0, 5, 19.0f);
+    Schedule_Out_Of_Service_Set(object_instance, false);
+    schedule_task_check(object_instance, 9, 0, 6, 22.0f);
+    /* a new day */
+    datetime_set_values(&bdatetime, 2026, 10, 20, 9, 0, 0, 0);
+    Schedule_Task(&bdatetime);
+    zassert_equal(Test_Write_Count, 7, NULL);
+    Schedule_Write_Property_Internal_Callback_Set(NULL);
+    Calendar_Cleanup();
+}
 /**
  * @}
  */
@@ -47,7 +313,10 @@ ZTEST_SUITE(schedule_tests, NULL, NULL, NULL, NULL, NULL);
 #else
 void test_main(void)
 {
-    ztest_test_suite(schedule_tests, ztest_unit_test(testSchedule));
+    ztest_test_suite(
+        schedule_tests, ztest_unit_test(testSchedule),
+        ztest_unit_test(testScheduleEvaluate),
+        ztest_unit_test(testScheduleTask));
 
     ztest_run_test_suite(schedule_tests);
 }
@@ -0,0 +1,251 @@
+/**
+ * @file
+ * @brief Unit test for the scheduled I-Am responses of the Who-Is handler
+ * @author Steve Karg <skarg@users.sourceforge.net>
+ * @date 2024
+ * @copyright SPDX-License-Identifier: MIT
+ */
+#include <string.h>
+#include <zephyr/ztest.h>
+#include <bacnet/bacaddr.h>
+#include <bacnet/basic/object/device.h>
+#include <bacnet/basic/service/h_whois.h>
+#include <bacnet/basic/service/s_iam.h>
+#include <bacnet/basic/tsm/tsm.h>
+#include <bacnet/datalink/datalink.h>
+#include <bacnet/whois.h>
+
+/**
+ * @addtogroup bacnet_tests
+ * @{
+ */
+
+#define TEST_JITTER_MS 250
+#define TEST_HOLDOFF_MS 1000
+
+uint8_t Handler_Transmit_Buffer[MAX_PDU];
+static uint32_t Test_Device_ID = 1234;
+static unsigned Test_Send_Count;
+static BACNET_ADDRESS Test_Send_Dest;
+
+uint32_t Device_Object_Instance_Number(void)
+{
+    return Test_Device_ID;
+}
+
+uint16_t Device_Vendor_Identifier(void)
+{
+    return BACNET_VENDOR_ID;
+}
+
+void Send_I_Am(uint8_t *buffer)
+{
+    (void)buffer;
+}
+
+void Send_I_Am_Unicast(uint8_t *buffer, const BACNET_ADDRESS *src)
+{
+    (void)buffer;
+    (void)src;
+}
+
+int datalink_send_pdu(
+    BACNET_ADDRESS *dest,
+    BACNET_NPDU_DATA *npdu_data,
+    uint8_t *pdu,
+    unsigned pdu_len)
+{
+    (void)npdu_data;
+    (void)pdu;
+    bacnet_address_copy(&Test_Send_Dest, dest);
+    Test_Send_Count++;
+
+    return (int)pdu_len;
+}
+
+void datalink_get_broadcast_address(BACNET_ADDRESS *dest)
+{
+    memset(dest, 0, sizeof(BACNET_ADDRESS));
+    dest->net = BACNET_BROADCAST_NETWORK;
+}
+
+void datalink_get_my_address(BACNET_ADDRESS *my_address)
+{
+    memset(my_address, 0, sizeof(BACNET_ADDRESS));
+    my_address->mac_len = 1;
+    my_address->mac[0] = 1;
+}
+
+/**
+ * @brief Make the address of a Who-Is source
+ */
+static void test_source(BACNET_ADDRESS *src, uint8_t mac)
+{
+    memset(src, 0, sizeof(BACNET_ADDRESS));
+    src->mac_len = 1;
+    src->mac[0] = mac;
+}
+
+/**
+ * @brief Run the timer until an I-Am is sent
+ * @return milliseconds until the I-Am was sent
+ */
+static unsigned test_send_delay(void)
+{
+    unsigned count = Test_Send_Count;
+    unsigned elapsed = 0;
+
+    handler_who_is_timer(0);
+    while ((Test_Send_Count == count) && (elapsed < (2 * TEST_HOLDOFF_MS))) {
+        handler_who_is_timer(1);
+        elapsed++;
+    }
+
+    return elapsed;
+}
+
+/**
+ * @brief Test the random delay and the holdoff of the I-Am responses
+ */
+#if defined(CONFIG_ZTEST_NEW_API)
+ZTEST(h_whois_tests, testWhoIsScheduled)
+#else
+static void testWhoIsScheduled(void)
+#endif
+{
+    BACNET_ADDRESS src = { 0 };
+    uint8_t service[16] = { 0 };
+    unsigned delay[3] = { 0 };
+    unsigned elapsed;
+    int len;
+
+    Test_Device_ID = 1234;
+    handler_who_is_scheduled_init(1);
+    handler_who_is_jitter_set(TEST_JITTER_MS);
+    test_source(&src, 10);
+    Test_Send_Count = 0;
+    /* the global Who-Is is answered after a random delay */
+    handler_who_is_scheduled(NULL, 0, &src);
+    delay[0] = test_send_delay();
+    zassert_equal(Test_Send_Count, 1, NULL);
+    zassert_true(delay[0] <= TEST_JITTER_MS, "delay=%u", delay[0]);
+    zassert_equal(Test_Send_Dest.net, BACNET_BROADCAST_NETWORK, NULL);
+    /* a repeated Who-Is within the holdoff is not answered again */
+    handler_who_is_scheduled(NULL, 0, &src);
+    handler_who_is_timer(TEST_JITTER_MS);
+    zassert_equal(Test_Send_Count, 1, NULL);
+    handler_who_is_timer(TEST_HOLDOFF_MS);
+    /* a duplicate Who-Is is answered by the pending I-Am */
+    handler_who_is_unicast_scheduled(NULL, 0, &src);
+    handler_who_is_unicast_scheduled(NULL, 0, &src);
+    delay[1] = test_send_delay();
+    zassert_equal(Test_Send_Count, 2, NULL);
+    zassert_true(delay[1] <= TEST_JITTER_MS, "delay=%u", delay[1]);
+    zassert_true(bacnet_address_same(&Test_Send_Dest, &src), NULL);
+    handler_who_is_timer(TEST_HOLDOFF_MS);
+    handler_who_is_unicast_scheduled(NULL, 0, &src);
+    delay[2] = test_send_delay();
+    zassert_equal(Test_Send_Count, 3, NULL);
+    handler_who_is_timer(TEST_HOLDOFF_MS);
+    /* another device instance picks other delays */
+    Test_Device_ID = 4321;
+    handler_who_is_scheduled_init(1);
+    handler_who_is_unicast_scheduled(NULL, 0, &src);
+    elapsed = test_send_delay();
+    handler_who_is_timer(TEST_HOLDOFF_MS);
+    handler_who_is_unicast_scheduled(NULL, 0, &src);
+    elapsed += test_send_delay() * 1000;
+    handler_who_is_timer(TEST_HOLDOFF_MS);
+    handler_who_is_unicast_scheduled(NULL, 0, &src);
+    elapsed += test_send_delay() * 1000000;
+    zassert_not_equal(
+        elapsed, delay[0] + (delay[1] * 1000) + (delay[2] * 1000000), NULL);
+    handler_who_is_timer(TEST_HOLDOFF_MS);
+    /* a device outside of the limits does not answer */
+    len = whois_encode_apdu(service, 1, 100);
+    zassert_true(len > 2, NULL);
+    Test_Send_Count = 0;
+    handler_who_is_scheduled(&service[2], (uint16_t)(len - 2), &src);
+    handler_who_is_timer(TEST_HOLDOFF_MS);
+    zassert_equal(Test_Send_Count, 0, NULL);
+    len = whois_encode_apdu(service, 4000, 5000);
+    handler_who_is_scheduled(&service[2], (uint16_t)(len - 2), &src);
+    handler_who_is_timer(TEST_JITTER_MS);
+    zassert_equal(Test_Send_Count, 1, NULL);
+    handler_who_is_timer(TEST_HOLDOFF_MS);
+}
+
+/**
+ * @brief Test the rate limit of a source, and the queue overflow
+ */
+#if defined(CONFIG_ZTEST_NEW_API)
+ZTEST(h_whois_tests, testWhoIsOverflow)
+#else
+static void testWhoIsOverflow(void)
+#endif
+{
+    BACNET_ADDRESS src = { 0 };
+    unsigned devices;
+    unsigned queue_max;
+    unsigned i;
+
+    /* each source is limited to 4 I-Am for each device in a window */
+    handler_who_is_scheduled_init(1);
+    handler_who_is_jitter_set(0);
+    test_source(&src, 10);
+    Test_Send_Count = 0;
+    for (i = 0; i < 5; i++) {
+        Test_Device_ID = 100 + i;
+        handler_who_is_unicast_scheduled(NULL, 0, &src);
+    }
+    handler_who_is_timer(0);
+    zassert_equal(Test_Send_Count, 4, NULL);
+    /* the I-Am beyond the limit is deferred until the window ends */
+    handler_who_is_timer(TEST_HOLDOFF_MS - 1);
+    zassert_equal(Test_Send_Count, 4, NULL);
+    handler_who_is_timer(1);
+    zassert_equal(Test_Send_Count, 5, NULL);
+    zassert_equal(Test_Send_Dest.mac[0], 10, NULL);
+    zassert_equal(handler_who_is_overflow_count(), 0, NULL);
+    /* the queue grows to one I-Am of each device to each rate limited
+       source and 7 more, which is sized by the number of devices */
+    handler_who_is_jitter_set(TEST_JITTER_MS);
+    Test_Device_ID = 1234;
+    for (devices = 1; devices <= 4; devices++) {
+        handler_who_is_scheduled_init(devices);
+        queue_max = (devices * 8) + 7;
+        Test_Send_Count = 0;
+        for (i = 0; i < queue_max; i++) {
+            test_source(&src, (uint8_t)(i + 1));
+            handler_who_is_unicast_scheduled(NULL, 0, &src);
+        }
+        zassert_equal(handler_who_is_overflow_count(), 0, NULL);
+        test_source(&src, (uint8_t)(queue_max + 1));
+        handler_who_is_unicast_scheduled(NULL, 0, &src);
+        zassert_equal(handler_who_is_overflow_count(), 1, NULL);
+        zassert_equal(Test_Send_Count, 0, NULL);
+        handler_who_is_timer(TEST_JITTER_MS);
+        zassert_equal(Test_Send_Count, queue_max, NULL);
+        /* a held off entry is reused when the queue is full */
+        handler_who_is_unicast_scheduled(NULL, 0, &src);
+        handler_who_is_timer(TEST_JITTER_MS);
+        zassert_equal(Test_Send_Count, queue_max + 1, NULL);
+        zassert_equal(handler_who_is_overflow_count(), 1, NULL);
+    }
+}
+/**
+ * @}
+ */
+
+#if defined(CONFIG_ZTEST_NEW_API)
+ZTEST_SUITE(h_whois_tests, NULL, NULL, NULL, NULL, NULL);
+#else
+void test_main(void)
+{
+    ztest_test_suite(
+        h_whois_tests, ztest_unit_test(testWhoIsScheduled),
+        ztest_unit_test(testWhoIsOverflow));
+
+    ztest_run_test_suite(h_whois_tests);
+}
+#endif
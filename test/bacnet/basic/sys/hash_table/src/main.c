@@ -0,0 +1,177 @@
+/**
+ * @file
+ * @brief Unit test for the hash table library
+ * @author Steve Karg <skarg@users.sourceforge.net>
+ * @date 2024
+ * @copyright SPDX-License-Identifier: MIT
+ */
+#include <stddef.h>
+#include <zephyr/ztest.h>
+#include <bacnet/basic/sys/hash_table.h>
+
+/**
+ * @addtogroup bacnet_tests
+ * @{
+ */
+
+struct test_entry {
+    uint32_t key;
+    uint32_t next;
+    bool in_use;
+};
+
+/**
+ * @brief Hash of a test key
+ * @param key - the key
+ * @return hash of the key
+ */
+static uint32_t test_key_hash(uint32_t key)
+{
+    return hash_table_key_final(hash_table_key_add(hash_table_key_init(), key));
+}
+
+/**
+ * @brief Hash of the key of a test entry
+ * @param entry - the test entry
+ * @return hash of the key
+ */
+static uint32_t test_entry_hash(const void *entry)
+{
+    const struct test_entry *test = entry;
+
+    return test_key_hash(test->key);
+}
+
+/**
+ * @brief Find a test entry by its key
+ * @param table - hash table
+ * @param key - the key
+ * @return index of the entry, or HASH_TABLE_NONE
+ */
+static uint32_t test_find(const HASH_TABLE *table, uint32_t key)
+{
+    const struct test_entry *entry;
+    uint32_t index;
+
+    index = hash_table_first(table, test_key_hash(key));
+    while (index != HASH_TABLE_NONE) {
+        entry = hash_table_entry(table, index);
+        if (entry->key == key) {
+            return index;
+        }
+        index = hash_table_next(table, index);
+    }
+
+    return HASH_TABLE_NONE;
+}
+
+/**
+ * @brief Add a test entry
+ * @param table - hash table
+ * @param key - the key
+ * @return index of the entry, or HASH_TABLE_NONE
+ */
+static uint32_t test_add(HASH_TABLE *table, uint32_t key)
+{
+    struct test_entry *entry;
+    uint32_t index;
+
+    index = hash_table_add(table, test_key_hash(key));
+    if (index != HASH_TABLE_NONE) {
+        entry = hash_table_entry(table, index);
+        entry->key = key;
+        entry->in_use = true;
+    }
+
+    return index;
+}
+
+/**
+ * @brief Test the hash table through growth, removal, and reuse
+ */
+#if defined(CONFIG_ZTEST_NEW_API)
+ZTEST(hash_table_tests, testHashTable)
+#else
+static void testHashTable(void)
+#endif
+{
+    HASH_TABLE table = { 0 };
+    struct test_entry *entry;
+    const unsigned count = 1000;
+    uint32_t index, key;
+    unsigned i;
+
+    hash_table_init(
+        &table, sizeof(struct test_entry), offsetof(struct test_entry, next),
+        count, test_entry_hash);
+    zassert_equal(hash_table_count(&table), 0, NULL);
+    zassert_equal(test_find(&table, 1), HASH_TABLE_NONE, NULL);
+    zassert_is_null(hash_table_entry(&table, 0), NULL);
+    /* the table grows, and keeps every entry found */
+    for (i = 0; i < count; i++) {
+        key = i * 7919;
+        index = test_add(&table, key);
+        zassert_equal(index, i, NULL);
+        zassert_equal(test_find(&table, key), i, NULL);
+    }
+    zassert_equal(hash_table_count(&table), count, NULL);
+    zassert_equal(hash_table_used(&table), count, NULL);
+    for (i = 0; i < count; i++) {
+        zassert_equal(test_find(&table, i * 7919), i, NULL);
+    }
+    /* at its limit */
+    zassert_equal(test_add(&table, 1), HASH_TABLE_NONE, NULL);
+    /* remove every other entry */
+    for (i = 0; i < count; i += 2) {
+        key = i * 7919;
+        entry = hash_table_entry(&table, i);
+        zassert_true(hash_table_remove(&table, test_key_hash(key), i), NULL);
+        entry->in_use = false;
+        zassert_false(hash_table_remove(&table, test_key_hash(key), i), NULL);
+    }
+    zassert_equal(hash_table_count(&table), count / 2, NULL);
+    for (i = 0; i < count; i++) {
+        index = test_find(&table, i * 7919);
+        if (i % 2) {
+            zassert_equal(index, i, NULL);
+        } else {
+            zassert_equal(index, HASH_TABLE_NONE, NULL);
+        }
+    }
+    /* the removed entries are reused before the table grows */
+    for (i = 0; i < count / 2; i++) {
+        index = test_add(&table, 1 + (i * 2));
+        zassert_not_equal(index, HASH_TABLE_NONE, NULL);
+        zassert_equal(index % 2, 0, NULL);
+    }
+    zassert_equal(hash_table_used(&table), count, NULL);
+    zassert_equal(hash_table_count(&table), count, NULL);
+    for (i = 0; i < count / 2; i++) {
+        index = test_find(&table, 1 + (i * 2));
+        zassert_not_equal(index, HASH_TABLE_NONE, NULL);
+        entry = hash_table_entry(&table, index);
+        zassert_true(entry->in_use, NULL);
+    }
+    hash_table_cleanup(&table);
+    zassert_equal(hash_table_count(&table), 0, NULL);
+    zassert_equal(hash_table_used(&table), 0, NULL);
+    zassert_equal(test_find(&table, 1), HASH_TABLE_NONE, NULL);
+    /* usable again after cleanup */
+    zassert_equal(test_add(&table, 1), 0, NULL);
+    zassert_equal(test_find(&table, 1), 0, NULL);
+    hash_table_cleanup(&table);
+}
+/**
+ * @}
+ */
+
+#if defined(CONFIG_ZTEST_NEW_API)
+ZTEST_SUITE(hash_table_tests, NULL, NULL, NULL, NULL, NULL);
+#else
+void test_main(void)
+{
+    ztest_test_suite(hash_table_tests, ztest_unit_test(testHashTable));
+
+    ztest_run_test_suite(hash_table_tests);
+}
+#endif
@@ -0,0 +1,222 @@
+/**
+ * @file
+ * @brief Unit test for the hierarchical timer wheel library
+ * @author Steve Karg <skarg@users.sourceforge.net>
+ * @date 2024
+ * @copyright SPDX-License-Identifier: MIT
+ */
+#include <zephyr/ztest.h>
+#include <bacnet/basic/sys/timer_wheel.h>
+
+/**
+ * @addtogroup bacnet_tests
+ * @{
+ */
+
+struct test_timer {
+    struct timer_wheel_node node;
+    unsigned long fired_tick;
+    unsigned fired;
+    unsigned long period;
+};
+
+static struct timer_wheel Test_Wheel;
+static struct test_timer Test_Timers[300];
+static unsigned long Test_Random = 12345;
+
+/**
+ * @brief Simple pseudo random number generator, to repeat the test
+ * @return pseudo random number 0..32767
+ */
+static unsigned long test_random(void)
+{
+    Test_Random = (Test_Random * 1103515245UL) + 12345UL;
+
+    return (Test_Random >> 16) & 0x7FFFUL;
+}
+
+/**
+ * @brief Record the tick at which a timer expires, and repeat it if
+ *  the timer is periodic
+ * @param context - test timer
+ */
+static void test_callback(void *context)
+{
+    struct test_timer *timer = context;
+
+    /* the wheel has moved on to the next tick */
+    timer->fired_tick = Test_Wheel.tick - 1UL;
+    timer->fired++;
+    if (timer->period) {
+        timer_wheel_set(
+            &Test_Wheel, &timer->node, timer->fired_tick + timer->period);
+    }
+}
+
+/**
+ * @brief Test the timers expire once and at their tick
+ */
+#if defined(CONFIG_ZTEST_NEW_API)
+ZTEST(timer_wheel_tests, testTimerWheelExpire)
+#else
+static void testTimerWheelExpire(void)
+#endif
+{
+    /* start near the end of the tick range to test the wrap */
+    unsigned long now = ~0UL - 100000UL;
+    unsigned long delay, step;
+    unsigned i, count;
+    struct test_timer *timer;
+
+    timer_wheel_init(&Test_Wheel, now);
+    zassert_equal(timer_wheel_count(&Test_Wheel), 0, NULL);
+    for (i = 0; i < ARRAY_SIZE(Test_Timers); i++) {
+        timer = &Test_Timers[i];
+        timer_wheel_node_init(&timer->node, test_callback, timer);
+        timer->fired = 0;
+        timer->period = 0;
+        /* delays from a tick to beyond the span of the wheel */
+        switch (i % 4) {
+            case 0:
+                delay = test_random() % TIMER_WHEEL_SLOTS;
+                break;
+            case 1:
+                delay = test_random();
+                break;
+            case 2:
+                delay = test_random() * 512UL;
+                break;
+            default:
+                delay = (1UL << 25) + test_random();
+                break;
+        }
+        timer_wheel_set(&Test_Wheel, &timer->node, now + delay);
+        zassert_true(timer_wheel_pending(&timer->node), NULL);
+        zassert_equal(timer_wheel_expires(&timer->node), now + delay, NULL);
+    }
+    zassert_equal(
+        timer_wheel_count(&Test_Wheel), ARRAY_SIZE(Test_Timers), NULL);
+    /* cancel some of them */
+    for (i = 0; i < ARRAY_SIZE(Test_Timers); i += 10) {
+        timer_wheel_cancel(&Test_Wheel, &Test_Timers[i].node);
+        zassert_false(timer_wheel_pending(&Test_Timers[i].node), NULL);
+        /* cancelling again is harmless */
+        timer_wheel_cancel(&Test_Wheel, &Test_Timers[i].node);
+    }
+    count = ARRAY_SIZE(Test_Timers) - (ARRAY_SIZE(Test_Timers) / 10);
+    zassert_equal(timer_wheel_count(&Test_Wheel), count, NULL);
+    /* turn the wheel in uneven steps */
+    while (timer_wheel_count(&Test_Wheel) > 0) {
+        step = 1 + (test_random() % 5000UL);
+        now += step;
+        timer_wheel_advance(&Test_Wheel, now);
+        for (i = 0; i < ARRAY_SIZE(Test_Timers); i++) {
+            timer = &Test_Timers[i];
+            if (timer_wheel_pending(&timer->node)) {
+                /* not yet expired */
+                zassert_equal(timer->fired, 0, NULL);
+                zassert_true(
+                    (long)(timer_wheel_expires(&timer->node) - now) > 0, NULL);
+            }
+        }
+    }
+    for (i = 0; i < ARRAY_SIZE(Test_Timers); i++) {
+        timer = &Test_Timers[i];
+        if ((i % 10) == 0) {
+            zassert_equal(timer->fired, 0, NULL);
+        } else {
+            zassert_equal(timer->fired, 1, "timer[%u]", i);
+            zassert_equal(
+                timer->fired_tick, timer_wheel_expires(&timer->node),
+                "timer[%u]", i);
+        }
+    }
+}
+
+/**
+ * @brief Test the timers that are set again from their callback,
+ *  and the timers that are set to a tick that has passed
+ */
+#if defined(CONFIG_ZTEST_NEW_API)
+ZTEST(timer_wheel_tests, testTimerWheelPeriodic)
+#else
+static void testTimerWheelPeriodic(void)
+#endif
+{
+    unsigned long now = 1000;
+    unsigned long start = now;
+    const unsigned long periods[] = { 1, 7, TIMER_WHEEL_SLOTS,
+                                      TIMER_WHEEL_SLOTS * TIMER_WHEEL_SLOTS };
+    unsigned i;
+    struct test_timer *timer;
+
+    timer_wheel_init(&Test_Wheel, now);
+    for (i = 0; i < ARRAY_SIZE(periods); i++) {
+        timer = &Test_Timers[i];
+        timer_wheel_node_init(&timer->node, test_callback, timer);
+        timer->fired = 0;
+        timer->period = periods[i];
+        timer_wheel_set(&Test_Wheel, &timer->node, now + timer->period);
+    }
+    for (i = 0; i < 20000; i++) {
+        now++;
+        timer_wheel_advance(&Test_Wheel, now);
+    }
+    /* advancing to the same tick again does nothing */
+    timer_wheel_advance(&Test_Wheel, now);
+    for (i = 0; i < ARRAY_SIZE(periods); i++) {
+        timer = &Test_Timers[i];
+        zassert_equal(timer->fired, (now - start) / periods[i], NULL);
+        zassert_true(timer_wheel_pending(&timer->node), NULL);
+    }
+    /* re-initialize cancels every timer */
+    timer_wheel_init(&Test_Wheel, now);
+    zassert_equal(timer_wheel_count(&Test_Wheel), 0, NULL);
+    for (i = 0; i < ARRAY_SIZE(periods); i++) {
+        zassert_false(timer_wheel_pending(&Test_Timers[i].node), NULL);
+    }
+    /* a tick that has passed expires on the next turn */
+    timer = &Test_Timers[0];
+    timer->fired = 0;
+    timer->period = 0;
+    timer_wheel_set(&Test_Wheel, &timer->node, now - 50);
+    zassert_equal(timer_wheel_count(&Test_Wheel), 1, NULL);
+    timer_wheel_advance(&Test_Wheel, now);
+    zassert_equal(timer->fired, 1, NULL);
+    zassert_equal(timer->fired_tick, now, NULL);
+    zassert_equal(timer_wheel_count(&Test_Wheel), 0, NULL);
+    /* an empty wheel catches up to the current tick */
+    now += 1000000UL;
+    timer_wheel_advance(&Test_Wheel, now);
+    zassert_equal(Test_Wheel.tick, now + 1, NULL);
+    /* restarting a pending timer keeps a single timer */
+    timer_wheel_set(&Test_Wheel, &timer->node, now + 100);
+    timer_wheel_set(&Test_Wheel, &timer->node, now + 10);
+    zassert_equal(timer_wheel_count(&Test_Wheel), 1, NULL);
+    timer_wheel_advance(&Test_Wheel, now + 100);
+    zassert_equal(timer->fired, 2, NULL);
+    zassert_equal(timer->fired_tick, now + 10, NULL);
+    /* a single turn over a long span skips to the timer and beyond */
+    now += 100;
+    timer_wheel_set(&Test_Wheel, &timer->node, now + 300000UL);
+    timer_wheel_advance(&Test_Wheel, now + 1000000UL);
+    zassert_equal(timer->fired, 3, NULL);
+    zassert_equal(timer->fired_tick, now + 300000UL, NULL);
+    zassert_equal(Test_Wheel.tick, now + 1000001UL, NULL);
+}
+/**
+ * @}
+ */
+
+#if defined(CONFIG_ZTEST_NEW_API)
+ZTEST_SUITE(timer_wheel_tests, NULL, NULL, NULL, NULL, NULL);
+#else
+void test_main(void)
+{
+    ztest_test_suite(
+        timer_wheel_tests, ztest_unit_test(testTimerWheelExpire),
+        ztest_unit_test(testTimerWheelPeriodic));
+
+    ztest_run_test_suite(timer_wheel_tests);
+}
+#endif
@@ -0,0 +1,433 @@
+/**
+ * @file
+ * @brief Unit test for the VMAC and UUID indexes of the BACnet/SC hub
+ *  function, without websockets
+ * @author Steve Karg <skarg@users.sourceforge.net>
+ * @date 2024
+ * @copyright SPDX-License-Identifier: MIT
+ */
+#include <string.h>
+#include <zephyr/ztest.h>
+#include <bacnet/datalink/bsc/bsc-hub-function.h>
+#include <bacnet/datalink/bsc/bsc-node.h>
+#include <bacnet/datalink/bsc/bsc-socket.h>
+#include <bacnet/datalink/bsc/bsc-util.h>
+#include <bacnet/datalink/bsc/bvlc-sc.h>
+#include <bacnet/datalink/bsc/websocket.h>
+
+/**
+ * @addtogroup bacnet_tests
+ * @{
+ */
+
+#define TEST_CONNECTIONS BSC_CONF_HUB_FUNCTION_CONNECTIONS_NUM
+
+/* the socket context of the hub function */
+static BSC_SOCKET_CTX *Test_Ctx;
+static BSC_HUB_FUNCTION_EVENT Test_Event;
+
+void bws_dispatch_lock(void)
+{
+}
+
+void bws_dispatch_unlock(void)
+{
+}
+
+void bsc_init_ctx_cfg(
+    BSC_SOCKET_CTX_TYPE type,
+    BSC_CONTEXT_CFG *cfg,
+    BSC_WEBSOCKET_PROTOCOL proto,
+    uint16_t port,
+    char *iface,
+    uint8_t *ca_cert_chain,
+    size_t ca_cert_chain_size,
+    uint8_t *cert_chain,
+    size_t cert_chain_size,
+    uint8_t *key,
+    size_t key_size,
+    BACNET_SC_UUID *local_uuid,
+    BACNET_SC_VMAC_ADDRESS *local_vmac,
+    uint16_t max_local_bvlc_len,
+    uint16_t max_local_ndpu_len,
+    unsigned int connect_timeout_s,
+    unsigned int heartbeat_timeout_s,
+    unsigned int disconnect_timeout_s)
+{
+    (void)proto;
+    (void)port;
+    (void)iface;
+    (void)ca_cert_chain;
+    (void)ca_cert_chain_size;
+    (void)cert_chain;
+    (void)cert_chain_size;
+    (void)key;
+    (void)key_size;
+    (void)max_local_bvlc_len;
+    (void)max_local_ndpu_len;
+    (void)connect_timeout_s;
+    (void)heartbeat_timeout_s;
+    (void)disconnect_timeout_s;
+    memset(cfg, 0, sizeof(*cfg));
+    cfg->type = type;
+    memcpy(&cfg->local_uuid, local_uuid, sizeof(cfg->local_uuid));
+    memcpy(&cfg->local_vmac, local_vmac, sizeof(cfg->local_vmac));
+}
+
+BSC_SC_RET bsc_init_ctx(
+    BSC_SOCKET_CTX *ctx,
+    BSC_CONTEXT_CFG *cfg,
+    BSC_SOCKET_CTX_FUNCS *funcs,
+    BSC_SOCKET *sockets,
+    size_t sockets_num,
+    void *user_arg)
+{
+    size_t i;
+
+    memset(ctx, 0, sizeof(*ctx));
+    ctx->cfg = cfg;
+    ctx->funcs = funcs;
+    ctx->sock = sockets;
+    ctx->sock_num = sockets_num;
+    ctx->user_arg = user_arg;
+    for (i = 0; i < sockets_num; i++) {
+        memset(&sockets[i], 0, sizeof(BSC_SOCKET));
+        sockets[i].ctx = ctx;
+        sockets[i].state = BSC_SOCK_STATE_IDLE;
+    }
+    Test_Ctx = ctx;
+
+    return BSC_SC_SUCCESS;
+}
+
+void bsc_deinit_ctx(BSC_SOCKET_CTX *ctx)
+{
+    ctx->funcs->context_event(ctx, BSC_CTX_DEINITIALIZED);
+}
+
+BSC_SC_RET bsc_send(BSC_SOCKET *c, uint8_t *pdu, size_t pdu_len)
+{
+    (void)c;
+    (void)pdu;
+    (void)pdu_len;
+
+    return BSC_SC_SUCCESS;
+}
+
+size_t bsc_send_broadcast(
+    BSC_SOCKET *sock,
+    size_t sock_num,
+    BSC_SOCKET *exclude,
+    uint8_t *pdu,
+    size_t pdu_len,
+    BSC_SC_RET *result)
+{
+    (void)sock;
+    (void)sock_num;
+    (void)exclude;
+    (void)pdu;
+    (void)pdu_len;
+    (void)result;
+
+    return 0;
+}
+
+size_t bsc_socket_get_global_buf_size(void)
+{
+    return 0;
+}
+
+uint8_t *bsc_socket_get_global_buf(void)
+{
+    return NULL;
+}
+
+bool bsc_socket_get_peer_addr(BSC_SOCKET *c, BACNET_HOST_N_PORT_DATA *data)
+{
+    (void)c;
+    (void)data;
+
+    return false;
+}
+
+BACNET_SC_HUB_FUNCTION_CONNECTION_STATUS *
+bsc_node_find_hub_status_for_vmac(BSC_NODE *node, BACNET_SC_VMAC_ADDRESS *vmac)
+{
+    (void)node;
+    (void)vmac;
+
+    return NULL;
+}
+
+void bsc_node_store_failed_request_info(
+    BSC_NODE *node,
+    BACNET_HOST_N_PORT_DATA *peer,
+    BACNET_SC_VMAC_ADDRESS *vmac,
+    BACNET_SC_UUID *uuid,
+    BACNET_ERROR_CODE error,
+    const char *error_desc)
+{
+    (void)node;
+    (void)peer;
+    (void)vmac;
+    (void)uuid;
+    (void)error;
+    (void)error_desc;
+}
+
+char *bsc_vmac_to_string(BACNET_SC_VMAC_ADDRESS *vmac)
+{
+    (void)vmac;
+
+    return "";
+}
+
+char *bsc_uuid_to_string(BACNET_SC_UUID *uuid)
+{
+    (void)uuid;
+
+    return "";
+}
+
+void bsc_copy_str(char *dst, const char *src, size_t dst_len)
+{
+    (void)dst;
+    (void)src;
+    (void)dst_len;
+}
+
+void bsc_set_timestamp(BACNET_DATE_TIME *timestamp)
+{
+    (void)timestamp;
+}
+
+bool bvlc_sc_is_vmac_broadcast(BACNET_SC_VMAC_ADDRESS *vmac)
+{
+    (void)vmac;
+
+    return false;
+}
+
+size_t
+bvlc_sc_set_orig(uint8_t **ppdu, size_t pdu_len, BACNET_SC_VMAC_ADDRESS *orig)
+{
+    (void)ppdu;
+    (void)orig;
+
+    return pdu_len;
+}
+
+void bvlc_sc_remove_dest_set_orig(
+    uint8_t *pdu, size_t pdu_len, BACNET_SC_VMAC_ADDRESS *orig)
+{
+    (void)pdu;
+    (void)pdu_len;
+    (void)orig;
+}
+
+static void test_hub_event(
+    BSC_HUB_FUNCTION_EVENT ev, BSC_HUB_FUNCTION_HANDLE h, void *user_arg)
+{
+    (void)h;
+    (void)user_arg;
+    Test_Event = ev;
+}
+
+/**
+ * @brief Make a VMAC address from a number
+ */
+static void test_vmac(BACNET_SC_VMAC_ADDRESS *vmac, unsigned number)
+{
+    memset(vmac, 0, sizeof(*vmac));
+    vmac->address[0] = 0x02;
+    vmac->address[4] = (uint8_t)(number >> 8);
+    vmac->address[5] = (uint8_t)number;
+}
+
+/**
+ * @brief Make a UUID from a number
+ */
+static void test_uuid(BACNET_SC_UUID *uuid, unsigned number)
+{
+    memset(uuid, 0, sizeof(*uuid));
+    uuid->uuid[0] = 0x55;
+    uuid->uuid[14] = (uint8_t)(number >> 8);
+    uuid->uuid[15] = (uint8_t)number;
+}
+
+/**
+ * @brief Start the hub function, and initialize its socket context
+ * @return handle of the hub function
+ */
+static BSC_HUB_FUNCTION_HANDLE test_hub_start(void)
+{
+    static uint8_t cert[1] = { 0 };
+    BACNET_SC_UUID uuid = { 0 };
+    BACNET_SC_VMAC_ADDRESS vmac = { 0 };
+    BSC_HUB_FUNCTION_HANDLE h = NULL;
+    BSC_SC_RET ret;
+
+    test_uuid(&uuid, 0xFFFF);
+    test_vmac(&vmac, 0xFFFF);
+    Test_Ctx = NULL;
+    ret = bsc_hub_function_start(
+        cert, sizeof(cert), cert, sizeof(cert), cert, sizeof(cert), 4443, NULL,
+        &uuid, &vmac, 1500, 1500, 10, 300, 10, test_hub_event, NULL, &h);
+    zassert_equal(ret, BSC_SC_SUCCESS, NULL);
+    zassert_not_null(h, NULL);
+    zassert_not_null(Test_Ctx, NULL);
+    Test_Ctx->funcs->context_event(Test_Ctx, BSC_CTX_INITIALIZED);
+    zassert_equal(Test_Event, BSC_HUBF_EVENT_STARTED, NULL);
+    zassert_true(bsc_hub_function_started(h), NULL);
+
+    return h;
+}
+
+/**
+ * @brief Connect a socket of the hub function
+ */
+static void test_connect(unsigned index, unsigned vmac, unsigned uuid)
+{
+    BSC_SOCKET *c = &Test_Ctx->sock[index];
+
+    c->state = BSC_SOCK_STATE_CONNECTED;
+    test_vmac(&c->vmac, vmac);
+    test_uuid(&c->uuid, uuid);
+    Test_Ctx->funcs->socket_event(
+        c, BSC_SOCKET_EVENT_CONNECTED, ERROR_CODE_SUCCESS, NULL, NULL, 0,
+        NULL);
+}
+
+/**
+ * @brief Disconnect a socket of the hub function
+ */
+static void test_disconnect(unsigned index)
+{
+    BSC_SOCKET *c = &Test_Ctx->sock[index];
+
+    c->state = BSC_SOCK_STATE_IDLE;
+    Test_Ctx->funcs->socket_event(
+        c, BSC_SOCKET_EVENT_DISCONNECTED, ERROR_CODE_SUCCESS, NULL, NULL, 0,
+        NULL);
+}
+
+/**
+ * @brief Find the socket connected with a VMAC address
+ */
+static BSC_SOCKET *test_find_vmac(unsigned number)
+{
+    BACNET_SC_VMAC_ADDRESS vmac = { 0 };
+
+    test_vmac(&vmac, number);
+
+    return Test_Ctx->funcs->find_connection_for_vmac(
+        &vmac, Test_Ctx->user_arg);
+}
+
+/**
+ * @brief Find the socket connected with a UUID
+ */
+static BSC_SOCKET *test_find_uuid(unsigned number)
+{
+    BACNET_SC_UUID uuid = { 0 };
+
+    test_uuid(&uuid, number);
+
+    return Test_Ctx->funcs->find_connection_for_uuid(
+        &uuid, Test_Ctx->user_arg);
+}
+
+/**
+ * @brief Test the lookup of the connections by VMAC and UUID, with more
+ *  connections than hash buckets, as they connect and disconnect
+ */
+#if defined(CONFIG_ZTEST_NEW_API)
+ZTEST(bsc_hub_function_tests, testHubFunctionIndex)
+#else
+static void testHubFunctionIndex(void)
+#endif
+{
+    BSC_HUB_FUNCTION_HANDLE h;
+    BSC_SOCKET *sock;
+    unsigned i;
+
+    h = test_hub_start();
+    sock = Test_Ctx->sock;
+    zassert_equal(Test_Ctx->sock_num, TEST_CONNECTIONS, NULL);
+    zassert_is_null(test_find_vmac(1), NULL);
+    zassert_is_null(test_find_uuid(101), NULL);
+    for (i = 0; i < TEST_CONNECTIONS; i++) {
+        test_connect(i, i + 1, i + 101);
+    }
+    for (i = 0; i < TEST_CONNECTIONS; i++) {
+        zassert_equal(test_find_vmac(i + 1), &sock[i], "i=%u", i);
+        zassert_equal(test_find_uuid(i + 101), &sock[i], "i=%u", i);
+    }
+    zassert_is_null(test_find_vmac(TEST_CONNECTIONS + 1), NULL);
+    zassert_is_null(test_find_uuid(TEST_CONNECTIONS + 101), NULL);
+    /* disconnected sockets are removed from the middle of the chains */
+    for (i = 0; i < TEST_CONNECTIONS; i += 2) {
+        test_disconnect(i);
+    }
+    for (i = 0; i < TEST_CONNECTIONS; i++) {
+        if (i & 1) {
+            zassert_equal(test_find_vmac(i + 1), &sock[i], "i=%u", i);
+            zassert_equal(test_find_uuid(i + 101), &sock[i], "i=%u", i);
+        } else {
+            zassert_is_null(test_find_vmac(i + 1), "i=%u", i);
+            zassert_is_null(test_find_uuid(i + 101), "i=%u", i);
+        }
+    }
+    /* a socket slot is used again with another VMAC and UUID */
+    test_connect(0, 50, 150);
+    zassert_equal(test_find_vmac(50), &sock[0], NULL);
+    zassert_equal(test_find_uuid(150), &sock[0], NULL);
+    zassert_is_null(test_find_vmac(1), NULL);
+    zassert_is_null(test_find_uuid(101), NULL);
+    /* a connection that replaces another with the same UUID is found
+       first, and the other is found again once it disconnects */
+    test_connect(2, 60, 102);
+    zassert_equal(test_find_uuid(102), &sock[2], NULL);
+    zassert_equal(test_find_vmac(60), &sock[2], NULL);
+    zassert_equal(test_find_vmac(2), &sock[1], NULL);
+    test_disconnect(2);
+    zassert_equal(test_find_uuid(102), &sock[1], NULL);
+    /* a socket that connects again without a disconnect is moved */
+    test_connect(1, 70, 170);
+    zassert_equal(test_find_vmac(70), &sock[1], NULL);
+    zassert_equal(test_find_uuid(170), &sock[1], NULL);
+    zassert_is_null(test_find_vmac(2), NULL);
+    zassert_is_null(test_find_uuid(102), NULL);
+    for (i = 3; i < TEST_CONNECTIONS; i += 2) {
+        zassert_equal(test_find_vmac(i + 1), &sock[i], "i=%u", i);
+    }
+    zassert_equal(bsc_hub_function_tx_dropped(h, &sock[3].vmac), 0, NULL);
+    /* the indexes are emptied when the hub function stops */
+    bsc_hub_function_stop(h);
+    zassert_equal(Test_Event, BSC_HUBF_EVENT_STOPPED, NULL);
+    zassert_true(bsc_hub_function_stopped(h), NULL);
+    for (i = 0; i < TEST_CONNECTIONS; i++) {
+        zassert_is_null(test_find_vmac(i + 1), "i=%u", i);
+    }
+    h = test_hub_start();
+    zassert_is_null(test_find_vmac(70), NULL);
+    test_connect(5, 70, 170);
+    zassert_equal(test_find_vmac(70), &Test_Ctx->sock[5], NULL);
+    zassert_equal(test_find_uuid(170), &Test_Ctx->sock[5], NULL);
+    bsc_hub_function_stop(h);
+}
+/**
+ * @}
+ */
+
+#if defined(CONFIG_ZTEST_NEW_API)
+ZTEST_SUITE(bsc_hub_function_tests, NULL, NULL, NULL, NULL, NULL);
+#else
+void test_main(void)
+{
+    ztest_test_suite(
+        bsc_hub_function_tests, ztest_unit_test(testHubFunctionIndex));
+
+    ztest_run_test_suite(bsc_hub_function_tests);
+}
+#endif
@@ -11,6 +11,7 @@
 #include <zephyr/ztest.h>
 #include <stdlib.h>
 #include <bacnet/datalink/cobs.h>
+#include <bacnet/datalink/mstpdef.h>
 #include <bacnet/basic/sys/bytes.h>
 
 /**
@@ -18,6 +19,144 @@
  * @{
  */
 
+/**
+ * @brief Reference bit-wise CRC-32K copied directly from Clause G.3.1
+ * @param dataValue new data value equivalent to one octet.
+ * @param crc32kValue accumulated value equivalent to four octets.
+ * @return value is updated CRC.
+ */
+static uint32_t reference_crc32k(uint8_t dataValue, uint32_t crc32kValue)
+{
+    uint8_t data, b;
+    uint32_t crc;
+
+    data = dataValue;
+    crc = crc32kValue;
+    for (b = 0; b < 8; b++) {
+        if ((data & 1) ^ (crc & 1)) {
+            crc >>= 1;
+            /* CRC-32K polynomial, 1 + x**1 + ... + x**30 (+ x**32) */
+            crc ^= 0xEB31D82E;
+        } else {
+            crc >>= 1;
+        }
+        data >>= 1;
+    }
+
+    return crc;
+}
+
+/**
+ * @brief Test the table-driven CRC-32K against the bit-wise reference
+ */
+#if defined(CONFIG_ZTEST_NEW_API)
+ZTEST(cobs_tests, test_COBS_CRC32K)
+#else
+static void test_COBS_CRC32K(void)
+#endif
+{
+    static const uint32_t crc_values[] = { 0x00000000, 0xFFFFFFFF,
+                                           0x0843323B, 0x12345678,
+                                           0x80000001 };
+    uint8_t buffer[64 + 7] = { 0 };
+    uint32_t crc, test_crc;
+    unsigned i, j, offset, length;
+
+    /* every octet value from a number of accumulated values */
+    for (i = 0; i < (sizeof(crc_values) / sizeof(crc_values[0])); i++) {
+        for (j = 0; j < 256; j++) {
+            crc = reference_crc32k((uint8_t)j, crc_values[i]);
+            test_crc = cobs_crc32k((uint8_t)j, crc_values[i]);
+            zassert_equal(crc, test_crc, NULL);
+        }
+    }
+    /* buffers of every length and alignment up to several slices */
+    for (i = 0; i < sizeof(buffer); i++) {
+        buffer[i] = (uint8_t)((i * 37) + 0x55);
+    }
+    for (offset = 0; offset < 8; offset++) {
+        for (length = 0; length <= 64; length++) {
+            crc = CRC32K_INITIAL_VALUE;
+            for (i = 0; i < length; i++) {
+                crc = reference_crc32k(buffer[offset + i], crc);
+            }
+            test_crc = cobs_crc32k_buffer(
+                &buffer[offset], length, CRC32K_INITIAL_VALUE);
+            zassert_equal(crc, test_crc, NULL);
+        }
+    }
+}
+
+/**
+ * @brief Test the single pass encode against COBS encoding followed by
+ * the bit-wise reference CRC-32K, and the in-place decode
+ */
+#if defined(CONFIG_ZTEST_NEW_API)
+ZTEST(cobs_tests, test_COBS_Frame_In_Place)
+#else
+static void test_COBS_Frame_In_Place(void)
+#endif
+{
+    static const size_t lengths[] = { 1, 2, 253, 254, 255, 508, 509, 1476 };
+    uint8_t buffer[MAX_APDU] = { 0 };
+    uint8_t
+        encoded_buffer[COBS_ENCODED_SIZE(MAX_APDU) + COBS_ENCODED_CRC_SIZE] = {
+            0
+        };
+    uint8_t reference_buffer[sizeof(encoded_buffer)] = { 0 };
+    uint8_t crc_buffer[4] = { 0 };
+    size_t encoded_length, reference_length, decoded_length, length;
+    uint32_t crc;
+    unsigned i, n, pattern;
+
+    for (pattern = 0; pattern < 3; pattern++) {
+        for (n = 0; n < (sizeof(lengths) / sizeof(lengths[0])); n++) {
+            length = lengths[n];
+            for (i = 0; i < length; i++) {
+                if (pattern == 0) {
+                    /* no zero octets */
+                    buffer[i] = (uint8_t)((i % 255) + 1);
+                } else if (pattern == 1) {
+                    /* zero and preamble octets */
+                    buffer[i] = (i % 3) ? 0x55 : 0;
+                } else {
+                    buffer[i] = (uint8_t)(i % 0xff);
+                }
+            }
+            reference_length = cobs_encode(
+                reference_buffer, sizeof(reference_buffer), buffer, length,
+                MSTP_PREAMBLE_X55);
+            zassert_true(reference_length > 0, NULL);
+            crc = CRC32K_INITIAL_VALUE;
+            for (i = 0; i < reference_length; i++) {
+                crc = reference_crc32k(reference_buffer[i], crc);
+            }
+            (void)cobs_crc32k_encode(crc_buffer, sizeof(crc_buffer), ~crc);
+            reference_length += cobs_encode(
+                &reference_buffer[reference_length],
+                sizeof(reference_buffer) - reference_length, crc_buffer,
+                sizeof(crc_buffer), MSTP_PREAMBLE_X55);
+            encoded_length = cobs_frame_encode(
+                encoded_buffer, sizeof(encoded_buffer), buffer, length);
+            zassert_equal(encoded_length, reference_length, NULL);
+            zassert_mem_equal(
+                encoded_buffer, reference_buffer, encoded_length, NULL);
+            /* decode in place */
+            decoded_length = cobs_frame_decode(
+                encoded_buffer, sizeof(encoded_buffer), encoded_buffer,
+                encoded_length);
+            zassert_equal(decoded_length, length, NULL);
+            zassert_mem_equal(encoded_buffer, buffer, length, NULL);
+            /* a corrupted octet fails the CRC-32K */
+            reference_buffer[reference_length / 2] ^= 0x01;
+            decoded_length = cobs_frame_decode(
+                reference_buffer, sizeof(reference_buffer), reference_buffer,
+                reference_length);
+            zassert_equal(decoded_length, 0, NULL);
+        }
+    }
+}
+
 /**
  * @brief Test CRC8 from Annex G 1.0 of BACnet Standard
  */
@@ -61,7 +200,10 @@ ZTEST_SUITE(cobs_tests, NULL, NULL, NULL, NULL, NULL);
 #else
 void test_main(void)
 {
-    ztest_test_suite(cobs_tests, ztest_unit_test(test_COBS_Encode_Decode));
+    ztest_test_suite(
+        cobs_tests, ztest_unit_test(test_COBS_Encode_Decode),
+        ztest_unit_test(test_COBS_CRC32K),
+        ztest_unit_test(test_COBS_Frame_In_Place));
 
     ztest_run_test_suite(cobs_tests);
 }
@@ -21,6 +21,7 @@
 #include <bacnet/datalink/bsc/websocket.h>
 #include <bacnet/datalink/bsc/bsc-hub-connector.h>
 #include <bacnet/datalink/bsc/bsc-hub-function.h>
+#include <bacnet/basic/sys/mstimer.h>
 
 unsigned char ca_key[] = {
     0x2d, 0x2d, 0x2d, 0x2d, 0x2d, 0x42, 0x45, 0x47, 0x49, 0x4e, 0x20, 0x52,
@@ -9038,6 +9039,236 @@ static void test_hub_function_duplicated_uuid(void)
     deinit_hubf_ev(&hubf);
 }
 
+/* benchmark of the hub function with several hub connectors in pairs,
+   the first connector of a pair sends an NPDU through the hub to the
+   second, which sends it back, for a number of round trips.  The round
+   trips per second are reported for a hub function with 1 service thread
+   and with BSC_CONF_WEBSOCKET_SERVER_THREADS_NUM service threads. */
+#define BENCH_CONNECTORS BSC_CONF_HUB_CONNECTORS_NUM
+#define BENCH_ROUNDS 200
+#define BENCH_NPDU_SIZE 1000
+/* longest time to connect, or to complete the round trips */
+#define BENCH_TIMEOUT_MS 60000UL
+
+typedef struct {
+    BSC_HUB_CONNECTOR_HANDLE h;
+    BACNET_SC_UUID uuid;
+    BACNET_SC_VMAC_ADDRESS vmac;
+    /* the connector of the pair which receives the NPDU first */
+    BACNET_SC_VMAC_ADDRESS *peer;
+    bool echo;
+    volatile bool connected;
+    volatile bool stopped;
+    volatile unsigned rounds;
+    /* failures seen by the callbacks, which are checked by the test */
+    volatile unsigned errors;
+    uint8_t npdu[BENCH_NPDU_SIZE];
+    uint8_t pdu[MAX_BVLC_LEN];
+} bench_hubc_t;
+
+static bench_hubc_t bench_hubc[BENCH_CONNECTORS];
+static volatile int bench_hubf_event;
+
+/* milliseconds of a monotonic clock */
+static unsigned long bench_now_ms(void)
+{
+#ifdef ZEPHYR_TEST
+    return (unsigned long)k_uptime_get();
+#else
+    return mstimer_now();
+#endif
+}
+
+/* wait, and run the maintenance timers once a second */
+static void bench_wait_ms(int ms)
+{
+    bsc_wait_ms(ms);
+    call_maintenance_timer(false, ms);
+}
+
+static void bench_send(bench_hubc_t *c, BACNET_SC_VMAC_ADDRESS *dest)
+{
+    size_t len;
+
+    bws_dispatch_lock();
+    len = bvlc_sc_encode_encapsulated_npdu(
+        c->pdu, sizeof(c->pdu), 0, NULL, dest, c->npdu, sizeof(c->npdu));
+    if (!len || (bsc_hub_connector_send(c->h, c->pdu, len) != BSC_SC_SUCCESS)) {
+        c->errors++;
+    }
+    bws_dispatch_unlock();
+}
+
+static void bench_hub_connector_event(
+    BSC_HUB_CONNECTOR_EVENT ev,
+    BSC_HUB_CONNECTOR_HANDLE h,
+    void *user_arg,
+    uint8_t *pdu,
+    size_t pdu_len,
+    BVLC_SC_DECODED_MESSAGE *decoded_pdu)
+{
+    bench_hubc_t *c = (bench_hubc_t *)user_arg;
+    BVLC_SC_DECODED_ENCAPSULATED_NPDU *npdu;
+    (void)h;
+    (void)pdu;
+    (void)pdu_len;
+
+    if (ev == BSC_HUBC_EVENT_CONNECTED_PRIMARY) {
+        c->connected = true;
+    } else if (ev == BSC_HUBC_EVENT_STOPPED) {
+        c->stopped = true;
+    } else if (ev == BSC_HUBC_EVENT_RECEIVED) {
+        npdu = &decoded_pdu->payload.encapsulated_npdu;
+        if ((decoded_pdu->hdr.bvlc_function != BVLC_SC_ENCAPSULATED_NPDU) ||
+            !decoded_pdu->hdr.origin || (npdu->npdu_len != BENCH_NPDU_SIZE) ||
+            (memcmp(npdu->npdu, c->npdu, BENCH_NPDU_SIZE) != 0)) {
+            c->errors++;
+        } else if (c->echo) {
+            bench_send(c, decoded_pdu->hdr.origin);
+        } else {
+            c->rounds++;
+            if (c->rounds < BENCH_ROUNDS) {
+                bench_send(c, c->peer);
+            }
+        }
+    }
+}
+
+static void bench_hub_function_event(
+    BSC_HUB_FUNCTION_EVENT ev, BSC_HUB_FUNCTION_HANDLE h, void *user_arg)
+{
+    (void)h;
+    (void)user_arg;
+    bench_hubf_event = ev;
+}
+
+/* run the round trips with a number of hub function service threads,
+   and return the number of round trips per second */
+static unsigned long bench_run(int threads_num)
+{
+    BSC_SC_RET ret;
+    BACNET_SC_UUID hubf_uuid;
+    BACNET_SC_VMAC_ADDRESS hubf_vmac;
+    BSC_HUB_FUNCTION_HANDLE hubf_h;
+    bench_hubc_t *c;
+    char url[128];
+    unsigned long start_ms;
+    unsigned long elapsed_ms = 0;
+    unsigned rounds = 0;
+    bool done;
+    int i;
+
+    memset(&hubf_uuid, 0x1, sizeof(hubf_uuid));
+    memset(&hubf_vmac, 0x2, sizeof(hubf_vmac));
+    memset(bench_hubc, 0, sizeof(bench_hubc));
+    bench_hubf_event = -1;
+    sprintf(
+        url, "wss://%s:%d", BACNET_WEBSOCKET_SERVER_ADDR,
+        BACNET_WEBSOCKET_SERVER_PORT);
+
+    bws_srv_set_threads_num(threads_num);
+    ret = bsc_hub_function_start(
+        ca_cert, sizeof(ca_cert), server_cert, sizeof(server_cert), server_key,
+        sizeof(server_key), BACNET_WEBSOCKET_SERVER_PORT, BSC_NETWORK_IFACE,
+        &hubf_uuid, &hubf_vmac, MAX_BVLC_LEN, MAX_NDPU_LEN,
+        BACNET_TIMEOUT, // connect timeout
+        BACNET_TIMEOUT, // heartbeat timeout
+        BACNET_TIMEOUT, // disconnect timeout
+        bench_hub_function_event, NULL, &hubf_h);
+    zassert_equal(ret, BSC_SC_SUCCESS, NULL);
+    call_maintenance_timer(true, 0);
+    while (bench_hubf_event != BSC_HUBF_EVENT_STARTED) {
+        bench_wait_ms(10);
+    }
+
+    for (i = 0; i < BENCH_CONNECTORS; i++) {
+        c = &bench_hubc[i];
+        memset(&c->uuid, 0x10 + i, sizeof(c->uuid));
+        memset(&c->vmac, 0x10 + i, sizeof(c->vmac));
+        memset(c->npdu, i / 2, sizeof(c->npdu));
+        c->echo = (i % 2) != 0;
+        ret = bsc_hub_connector_start(
+            ca_cert, sizeof(ca_cert), client_cert, sizeof(client_cert),
+            CLIENT_KEY, sizeof(CLIENT_KEY), &c->uuid, &c->vmac, MAX_BVLC_LEN,
+            MAX_NDPU_LEN,
+            BACNET_TIMEOUT, // connect timeout
+            BACNET_TIMEOUT, // heartbeat timeout
+            BACNET_TIMEOUT, // disconnect timeout
+            url, NULL,
+            BACNET_TIMEOUT, // reconnect timeout
+            bench_hub_connector_event, c, &c->h);
+        zassert_equal(ret, BSC_SC_SUCCESS, NULL);
+    }
+    for (i = 0; i + 1 < BENCH_CONNECTORS; i += 2) {
+        bench_hubc[i].peer = &bench_hubc[i + 1].vmac;
+    }
+    start_ms = bench_now_ms();
+    for (i = 0; i < BENCH_CONNECTORS; i++) {
+        while (!bench_hubc[i].connected &&
+               ((bench_now_ms() - start_ms) < BENCH_TIMEOUT_MS)) {
+            bench_wait_ms(10);
+        }
+        zassert_true(bench_hubc[i].connected, "connector %d", i);
+    }
+
+    start_ms = bench_now_ms();
+    for (i = 0; i + 1 < BENCH_CONNECTORS; i += 2) {
+        bench_send(&bench_hubc[i], bench_hubc[i].peer);
+    }
+    do {
+        bench_wait_ms(1);
+        elapsed_ms = bench_now_ms() - start_ms;
+        done = true;
+        for (i = 0; i + 1 < BENCH_CONNECTORS; i += 2) {
+            if (bench_hubc[i].rounds < BENCH_ROUNDS) {
+                done = false;
+            }
+        }
+    } while (!done && (elapsed_ms < BENCH_TIMEOUT_MS));
+    zassert_true(done, "round trips not done in %lu ms", elapsed_ms);
+    for (i = 0; i < BENCH_CONNECTORS; i++) {
+        zassert_equal(bench_hubc[i].errors, 0, "connector %d", i);
+        rounds += bench_hubc[i].rounds;
+    }
+
+    for (i = 0; i < BENCH_CONNECTORS; i++) {
+        bsc_hub_connector_stop(bench_hubc[i].h);
+    }
+    for (i = 0; i < BENCH_CONNECTORS; i++) {
+        while (!bench_hubc[i].stopped) {
+            bench_wait_ms(10);
+        }
+    }
+    bsc_hub_function_stop(hubf_h);
+    while (bench_hubf_event != BSC_HUBF_EVENT_STOPPED) {
+        bench_wait_ms(10);
+    }
+    if (elapsed_ms == 0) {
+        elapsed_ms = 1;
+    }
+
+    return (rounds * 1000UL) / elapsed_ms;
+}
+
+#if defined(CONFIG_ZTEST_NEW_API)
+ZTEST(hub_test_9, test_hub_benchmark)
+#else
+static void test_hub_benchmark(void)
+#endif
+{
+    unsigned long rate;
+
+    rate = bench_run(1);
+    TC_PRINT(
+        "hub function, %d connectors, 1 thread: %lu round trips/s\n",
+        BENCH_CONNECTORS, rate);
+    rate = bench_run(BSC_CONF_WEBSOCKET_SERVER_THREADS_NUM);
+    TC_PRINT(
+        "hub function, %d connectors, %d threads: %lu round trips/s\n",
+        BENCH_CONNECTORS, BSC_CONF_WEBSOCKET_SERVER_THREADS_NUM, rate);
+    bws_srv_set_threads_num(BSC_CONF_WEBSOCKET_SERVER_THREADS_NUM);
+}
+
 #if defined(CONFIG_ZTEST_NEW_API)
 static void *suite_setup(void)
 {
@@ -9053,6 +9284,7 @@ ZTEST_SUITE(hub_test_5, NULL, suite_setup, NULL, NULL, NULL);
 ZTEST_SUITE(hub_test_6, NULL, suite_setup, NULL, NULL, NULL);
 ZTEST_SUITE(hub_test_7, NULL, suite_setup, NULL, NULL, NULL);
 ZTEST_SUITE(hub_test_8, NULL, suite_setup, NULL, NULL, NULL);
+ZTEST_SUITE(hub_test_9, NULL, suite_setup, NULL, NULL, NULL);
 #else
 void test_main(void)
 {
@@ -9072,6 +9304,7 @@ void test_main(void)
     ztest_test_suite(hub_test_7, ztest_unit_test(test_hub_function_bad_params));
     ztest_test_suite(
         hub_test_8, ztest_unit_test(test_hub_function_duplicated_uuid));
+    ztest_test_suite(hub_test_9, ztest_unit_test(test_hub_benchmark));
 
     ztest_run_test_suite(hub_test_1);
     ztest_run_test_suite(hub_test_2);
@@ -9081,5 +9314,6 @@ void test_main(void)
     ztest_run_test_suite(hub_test_6);
     ztest_run_test_suite(hub_test_7);
     ztest_run_test_suite(hub_test_8);
+    ztest_run_test_suite(hub_test_9);
 }
 #endif
@@ -14,6 +14,7 @@
 #include <zephyr/ztest.h>
 #include <bacnet/datalink/bsc/websocket.h>
 #include <bacnet/datalink/bsc/bsc-event.h>
+#include <bacnet/basic/sys/mstimer.h>
 
 #define TEST_THREAD_NUM 10
 
@@ -8233,9 +8234,237 @@ static void test_onoff(void)
     wait_for_event(&cli_ctx, BSC_WEBSOCKET_DISCONNECTED);
 }
 
+/* benchmark of the hub server with several clients, each client sends a
+   PDU which the server echoes back, for a number of round trips.  The
+   round trips per second are reported for a server with 1 service thread
+   and with BSC_CONF_WEBSOCKET_SERVER_THREADS_NUM service threads. */
+#define BENCH_CLIENTS BSC_SERVER_HUB_WEBSOCKETS_MAX_NUM
+#define BENCH_ROUNDS 500
+#define BENCH_PDU_SIZE 1497
+/* longest time to connect, or to complete the round trips */
+#define BENCH_TIMEOUT_MS 60000UL
+
+typedef struct {
+    BSC_WEBSOCKET_HANDLE h;
+    volatile bool connected;
+    volatile bool disconnected;
+    volatile unsigned rounds;
+    /* failures seen by the callbacks, which are checked by the test */
+    volatile unsigned errors;
+    uint8_t buf[BSC_CONF_TX_PRE + BENCH_PDU_SIZE];
+} bench_cli_t;
+
+typedef struct {
+    BSC_WEBSOCKET_SRV_HANDLE sh;
+    volatile int ev;
+    volatile unsigned errors;
+    uint8_t buf[BENCH_CLIENTS][BSC_CONF_TX_PRE + BENCH_PDU_SIZE];
+    size_t len[BENCH_CLIENTS];
+} bench_srv_t;
+
+static void bench_cli_event(
+    BSC_WEBSOCKET_HANDLE h,
+    BSC_WEBSOCKET_EVENT ev,
+    BACNET_ERROR_CODE ws_reason,
+    char *ws_reason_desc,
+    uint8_t *buf,
+    size_t bufsize,
+    void *user_param)
+{
+    bench_cli_t *cli = (bench_cli_t *)user_param;
+    BSC_WEBSOCKET_RET ret;
+    (void)ws_reason;
+    (void)ws_reason_desc;
+
+    if (ev == BSC_WEBSOCKET_CONNECTED) {
+        cli->connected = true;
+    } else if (ev == BSC_WEBSOCKET_SENDABLE) {
+        ret = bws_cli_dispatch_send(
+            h, &cli->buf[BSC_CONF_TX_PRE], BENCH_PDU_SIZE);
+        if (ret != BSC_WEBSOCKET_SUCCESS) {
+            cli->errors++;
+        }
+    } else if (ev == BSC_WEBSOCKET_RECEIVED) {
+        if ((bufsize != BENCH_PDU_SIZE) ||
+            (memcmp(buf, &cli->buf[BSC_CONF_TX_PRE], bufsize) != 0)) {
+            cli->errors++;
+        }
+        cli->rounds++;
+        if (cli->rounds < BENCH_ROUNDS) {
+            bws_cli_send(h);
+        }
+    } else if (ev == BSC_WEBSOCKET_DISCONNECTED) {
+        cli->disconnected = true;
+    }
+}
+
+static void bench_srv_event(
+    BSC_WEBSOCKET_SRV_HANDLE sh,
+    BSC_WEBSOCKET_HANDLE h,
+    BSC_WEBSOCKET_EVENT ev,
+    BACNET_ERROR_CODE ws_reason,
+    char *ws_reason_desc,
+    uint8_t *buf,
+    size_t bufsize,
+    void *user_param)
+{
+    bench_srv_t *srv = (bench_srv_t *)user_param;
+    BSC_WEBSOCKET_RET ret;
+    (void)ws_reason;
+    (void)ws_reason_desc;
+
+    if (ev == BSC_WEBSOCKET_SERVER_STARTED ||
+        ev == BSC_WEBSOCKET_SERVER_STOPPED) {
+        srv->ev = ev;
+    } else if (ev == BSC_WEBSOCKET_RECEIVED) {
+        /* a connection is serviced by one thread, so the echo buffer of
+           a handle is used by one thread at a time */
+        if ((h < 0) || (h >= BENCH_CLIENTS) || (bufsize > BENCH_PDU_SIZE)) {
+            srv->errors++;
+            return;
+        }
+        memcpy(&srv->buf[h][BSC_CONF_TX_PRE], buf, bufsize);
+        srv->len[h] = bufsize;
+        bws_srv_send(sh, h);
+    } else if (ev == BSC_WEBSOCKET_SENDABLE) {
+        ret = bws_srv_dispatch_send(
+            sh, h, &srv->buf[h][BSC_CONF_TX_PRE], srv->len[h]);
+        if (ret != BSC_WEBSOCKET_SUCCESS) {
+            srv->errors++;
+        }
+    }
+}
+
+static void bench_wait_ms(int ms)
+{
+#ifdef ZEPHYR_TEST
+    k_msleep(ms);
+#else
+    bsc_wait_ms(ms);
+#endif
+}
+
+/* milliseconds of a monotonic clock */
+static unsigned long bench_now_ms(void)
+{
+#ifdef ZEPHYR_TEST
+    return (unsigned long)k_uptime_get();
+#else
+    return mstimer_now();
+#endif
+}
+
+/* run the round trips with a number of server service threads, and
+   return the number of round trips per second */
+static unsigned long bench_run(int threads_num)
+{
+    BSC_WEBSOCKET_RET ret;
+    static bench_cli_t cli[BENCH_CLIENTS];
+    static bench_srv_t srv;
+    char url[128];
+    unsigned long start_ms;
+    unsigned long elapsed_ms = 0;
+    bool done;
+    int i;
+
+    memset(cli, 0, sizeof(cli));
+    memset(&srv, 0, sizeof(srv));
+    srv.ev = -1;
+    sprintf(
+        url, "wss://%s:%d", BACNET_WEBSOCKET_SERVER_ADDR,
+        BACNET_WEBSOCKET_SERVER_PORT);
+
+    bws_srv_set_threads_num(threads_num);
+    ret = bws_srv_start(
+        BSC_WEBSOCKET_HUB_PROTOCOL, BACNET_WEBSOCKET_SERVER_PORT,
+        BSC_NETWORK_IFACE, ca_cert, sizeof(ca_cert), server_cert,
+        sizeof(server_cert), server_key, sizeof(server_key), DEFAULT_TIMEOUT,
+        bench_srv_event, &srv, &srv.sh);
+    zassert_equal(ret, BSC_WEBSOCKET_SUCCESS, NULL);
+    while (srv.ev != BSC_WEBSOCKET_SERVER_STARTED) {
+        bench_wait_ms(DEFAULT_WAIT_TIMEOUT_MS);
+    }
+
+    for (i = 0; i < BENCH_CLIENTS; i++) {
+        fill_buf(&cli[i].buf[BSC_CONF_TX_PRE], BENCH_PDU_SIZE, (uint8_t)i);
+        ret = bws_cli_connect(
+            BSC_WEBSOCKET_HUB_PROTOCOL, url, ca_cert, sizeof(ca_cert),
+            client_cert, sizeof(client_cert), CLIENT_KEY, sizeof(CLIENT_KEY),
+            DEFAULT_TIMEOUT, bench_cli_event, &cli[i], &cli[i].h);
+        zassert_equal(ret, BSC_WEBSOCKET_SUCCESS, NULL);
+    }
+    start_ms = bench_now_ms();
+    for (i = 0; i < BENCH_CLIENTS; i++) {
+        while (!cli[i].connected &&
+               ((bench_now_ms() - start_ms) < BENCH_TIMEOUT_MS)) {
+            bench_wait_ms(DEFAULT_WAIT_TIMEOUT_MS);
+        }
+        zassert_true(cli[i].connected, "client %d did not connect", i);
+    }
+
+    start_ms = bench_now_ms();
+    for (i = 0; i < BENCH_CLIENTS; i++) {
+        bws_cli_send(cli[i].h);
+    }
+    do {
+        bench_wait_ms(1);
+        elapsed_ms = bench_now_ms() - start_ms;
+        done = true;
+        for (i = 0; i < BENCH_CLIENTS; i++) {
+            if (cli[i].rounds < BENCH_ROUNDS) {
+                done = false;
+            }
+        }
+    } while (!done && (elapsed_ms < BENCH_TIMEOUT_MS));
+    zassert_true(done, "round trips not done in %lu ms", elapsed_ms);
+    zassert_equal(srv.errors, 0, NULL);
+    for (i = 0; i < BENCH_CLIENTS; i++) {
+        zassert_equal(cli[i].errors, 0, "client %d", i);
+    }
+
+    for (i = 0; i < BENCH_CLIENTS; i++) {
+        bws_cli_disconnect(cli[i].h);
+    }
+    for (i = 0; i < BENCH_CLIENTS; i++) {
+        while (!cli[i].disconnected) {
+            bench_wait_ms(DEFAULT_WAIT_TIMEOUT_MS);
+        }
+    }
+    ret = bws_srv_stop(srv.sh);
+    zassert_equal(ret, BSC_WEBSOCKET_SUCCESS, NULL);
+    while (srv.ev != BSC_WEBSOCKET_SERVER_STOPPED) {
+        bench_wait_ms(DEFAULT_WAIT_TIMEOUT_MS);
+    }
+    if (elapsed_ms == 0) {
+        elapsed_ms = 1;
+    }
+
+    return (BENCH_CLIENTS * BENCH_ROUNDS * 1000UL) / elapsed_ms;
+}
+
+#if defined(CONFIG_ZTEST_NEW_API)
+ZTEST(websocket_srv_test_3, test_benchmark)
+#else
+static void test_benchmark(void)
+#endif
+{
+    unsigned long rate;
+
+    rate = bench_run(1);
+    TC_PRINT(
+        "websocket server, %d clients, 1 thread: %lu round trips/s\n",
+        BENCH_CLIENTS, rate);
+    rate = bench_run(BSC_CONF_WEBSOCKET_SERVER_THREADS_NUM);
+    TC_PRINT(
+        "websocket server, %d clients, %d threads: %lu round trips/s\n",
+        BENCH_CLIENTS, BSC_CONF_WEBSOCKET_SERVER_THREADS_NUM, rate);
+    bws_srv_set_threads_num(BSC_CONF_WEBSOCKET_SERVER_THREADS_NUM);
+}
+
 #if defined(CONFIG_ZTEST_NEW_API)
 ZTEST_SUITE(websocket_srv_test_1, NULL, NULL, NULL, NULL, NULL);
 ZTEST_SUITE(websocket_srv_test_2, NULL, NULL, NULL, NULL, NULL);
+ZTEST_SUITE(websocket_srv_test_3, NULL, NULL, NULL, NULL, NULL);
 #else
 void test_main(void)
 {
@@ -8244,7 +8473,9 @@ void test_main(void)
 
     ztest_test_suite(websocket_srv_test_1, ztest_unit_test(test_simple));
     ztest_test_suite(websocket_srv_test_2, ztest_unit_test(test_onoff));
+    ztest_test_suite(websocket_srv_test_3, ztest_unit_test(test_benchmark));
     ztest_run_test_suite(websocket_srv_test_1);
     ztest_run_test_suite(websocket_srv_test_2);
+    ztest_run_test_suite(websocket_srv_test_3);
 }
 #endif
@@ -10,6 +10,7 @@
 
 #include <zephyr/ztest.h>
 #include <bacnet/indtext.h>
+#include <bacnet/bactext.h>
 
 /**
  * @addtogroup bacnet_tests
@@ -61,6 +62,156 @@ static void testIndexText(void)
     zassert_equal(
         index, indtext_by_istring_default(data_list, "ANNA", index), NULL);
 }
+
+/* text lists with duplicate text and duplicate index */
+static INDTEXT_DATA duplicate_list[] = { { 7, "Zed" },   { 3, "anna" },
+                                         { 9, "ANNA" },  { 3, "Bert" },
+                                         { 0, "Carl" },  { 5, "zed" },
+                                         { 0, NULL } };
+
+/**
+ * @brief Test that the sorted lookups match the linear lookups
+ */
+static void testIndexTextIndexList(INDTEXT_DATA *list, INDTEXT_INDEX *index)
+{
+    unsigned i, count, found = 0, expected = 0;
+    bool status;
+
+    count = indtext_count(list);
+    for (i = 0; i < count; i++) {
+        status = indtext_index_by_istring(index, list[i].pString, &found);
+        zassert_true(status, NULL);
+        indtext_by_istring(list, list[i].pString, &expected);
+        zassert_equal(found, expected, "%s", list[i].pString);
+        zassert_equal(
+            indtext_index_by_index_default(index, list[i].index, NULL),
+            indtext_by_index(list, list[i].index), NULL);
+    }
+    zassert_true(index->valid, NULL);
+    zassert_equal(index->count, count, NULL);
+}
+
+#if defined(CONFIG_ZTEST_NEW_API)
+ZTEST(indtext_tests, testIndexTextIndex)
+#else
+static void testIndexTextIndex(void)
+#endif
+{
+    uint16_t name_order[sizeof(duplicate_list) / sizeof(duplicate_list[0])];
+    uint16_t index_order[sizeof(duplicate_list) / sizeof(duplicate_list[0])];
+    INDTEXT_INDEX index = { NULL, NULL, NULL, 0, false };
+    unsigned found = 0;
+
+    zassert_false(indtext_index_by_istring(&index, "Zed", &found), NULL);
+    zassert_equal(
+        indtext_index_by_index_default(&index, 7, "none"), "none", NULL);
+    zassert_false(indtext_index_by_istring(NULL, "Zed", &found), NULL);
+    index.data_list = duplicate_list;
+    index.name_order = name_order;
+    index.index_order = index_order;
+    /* until the views are built, the lookups search the list */
+    zassert_true(indtext_index_by_istring(&index, "ZED", &found), NULL);
+    zassert_equal(found, 7, NULL);
+    zassert_equal(
+        strcmp(indtext_index_by_index_default(&index, 3, NULL), "anna"), 0,
+        NULL);
+    zassert_false(index.valid, NULL);
+    indtext_index_init(&index);
+    testIndexTextIndexList(duplicate_list, &index);
+    /* first of any duplicates is found */
+    zassert_true(indtext_index_by_istring(&index, "ZED", &found), NULL);
+    zassert_equal(found, 7, NULL);
+    zassert_true(indtext_index_by_istring(&index, "Anna", &found), NULL);
+    zassert_equal(found, 3, NULL);
+    zassert_equal(
+        strcmp(indtext_index_by_index_default(&index, 3, NULL), "anna"), 0,
+        NULL);
+    zassert_false(indtext_index_by_istring(&index, "Harry", NULL), NULL);
+    zassert_false(indtext_index_by_istring(&index, "", NULL), NULL);
+    zassert_false(indtext_index_by_istring(&index, NULL, NULL), NULL);
+    zassert_equal(
+        indtext_index_by_index_default(&index, 4, "none"), "none", NULL);
+    zassert_equal(
+        indtext_index_by_index_default(&index, 10, "none"), "none", NULL);
+    /* an empty list */
+    index.data_list = &duplicate_list[6];
+    index.valid = false;
+    indtext_index_init(&index);
+    zassert_true(index.valid, NULL);
+    zassert_false(indtext_index_by_istring(&index, "Zed", NULL), NULL);
+}
+
+extern INDTEXT_DATA bacnet_object_type_names[];
+extern INDTEXT_DATA bacnet_property_names[];
+extern INDTEXT_DATA bacnet_engineering_unit_names[];
+extern INDTEXT_DATA bacnet_error_code_names[];
+
+/**
+ * @brief Test that the indexed BACnet text lookups match the text lists
+ */
+#if defined(CONFIG_ZTEST_NEW_API)
+ZTEST(indtext_tests, testIndexTextBACnet)
+#else
+static void testIndexTextBACnet(void)
+#endif
+{
+    INDTEXT_DATA *list;
+    unsigned i = 0, found = 0, expected = 0;
+
+    bactext_init();
+    for (list = bacnet_object_type_names; list->pString; list++) {
+        zassert_true(bactext_object_type_index(list->pString, &found), NULL);
+        indtext_by_istring(bacnet_object_type_names, list->pString, &expected);
+        zassert_equal(found, expected, NULL);
+        zassert_true(bactext_object_type_strtol(list->pString, &found), NULL);
+        zassert_equal(found, expected, NULL);
+    }
+    for (list = bacnet_property_names; list->pString; list++) {
+        zassert_true(bactext_property_index(list->pString, &found), NULL);
+        indtext_by_istring(bacnet_property_names, list->pString, &expected);
+        zassert_equal(found, expected, NULL);
+        zassert_equal(bactext_property_id(list->pString), expected, NULL);
+        zassert_true(bactext_property_strtol(list->pString, &found), NULL);
+        zassert_equal(found, expected, NULL);
+    }
+    for (list = bacnet_engineering_unit_names; list->pString; list++) {
+        zassert_true(
+            bactext_engineering_unit_index(list->pString, &found), NULL);
+        indtext_by_istring(
+            bacnet_engineering_unit_names, list->pString, &expected);
+        zassert_equal(found, expected, NULL);
+    }
+    for (i = 0; i < 1100; i++) {
+        zassert_equal(
+            strcmp(
+                bactext_object_type_name(i),
+                indtext_by_index_split_default(
+                    bacnet_object_type_names, i, OBJECT_PROPRIETARY_MIN,
+                    "Reserved for Use by ASHRAE",
+                    "Vendor Proprietary Value")),
+            0, NULL);
+        zassert_equal(
+            strcmp(
+                bactext_property_name_default(i, ""),
+                indtext_by_index_default(bacnet_property_names, i, "")),
+            0, NULL);
+        zassert_equal(
+            strcmp(
+                bactext_error_code_name(i),
+                indtext_by_index_split_default(
+                    bacnet_error_code_names, i, ERROR_CODE_PROPRIETARY_FIRST,
+                    "Reserved for Use by ASHRAE",
+                    "Vendor Proprietary Value")),
+            0, NULL);
+    }
+    zassert_equal(bactext_property_id("no-such-property"), 0, NULL);
+    zassert_false(bactext_property_index("no-such-property", NULL), NULL);
+    zassert_true(bactext_property_strtol("85", &found), NULL);
+    zassert_equal(found, 85, NULL);
+    zassert_true(bactext_object_type_strtol("0x10", &found), NULL);
+    zassert_equal(found, 16, NULL);
+    zassert_false(bactext_object_type_strtol("8z", &found), NULL);
+}
 /**
  * @}
  */
@@ -70,7 +221,10 @@ ZTEST_SUITE(indtext_tests, NULL, NULL, NULL, NULL, NULL);
 #else
 void test_main(void)
 {
-    ztest_test_suite(indtext_tests, ztest_unit_test(testIndexText));
+    ztest_test_suite(
+        indtext_tests, ztest_unit_test(testIndexText),
+        ztest_unit_test(testIndexTextIndex),
+        ztest_unit_test(testIndexTextBACnet));
 
     ztest_run_test_suite(indtext_tests);
 }
@@ -7,6 +7,7 @@
  * SPDX-License-Identifier: MIT
  */
 #include <zephyr/ztest.h>
+#include <string.h>
 #include <bacnet/property.h>
 #include <bacnet/bactext.h>
 
@@ -88,6 +89,90 @@ static void testPropList(void)
     zassert_true(count > 0, NULL);
 }
 
+/**
+ * @brief Test the property membership bitmaps against the property lists
+ */
+#if defined(CONFIG_ZTEST_NEW_API)
+ZTEST(property_tests, testPropListMember)
+#else
+static void testPropListMember(void)
+#endif
+{
+    unsigned i = 0, j = 0;
+    BACNET_OBJECT_TYPE object_type;
+    BACNET_PROPERTY_ID property;
+    uint32_t bitmap[PROPERTY_LIST_BITMAP_WORDS];
+    const BACNET_PROPERTY_ID extended_properties[] = {
+        PROP_RESERVED_RANGE_MAX, PROP_RESERVED_RANGE_MIN2,
+        PROP_LOW_END_TRIM, PROP_TRIM_FADE_TIME
+    };
+
+    for (i = 0; i < OBJECT_PROPRIETARY_MIN; i++) {
+        object_type = (BACNET_OBJECT_TYPE)i;
+        for (j = 0; j <= PROP_RESERVED_RANGE_MAX; j++) {
+            property = (BACNET_PROPERTY_ID)j;
+            zassert_equal(
+                property_list_required_member(object_type, property),
+                property_list_member(
+                    property_list_required(object_type), property),
+                "%s: %s", bactext_object_type_name(object_type),
+                bactext_property_name(property));
+            zassert_equal(
+                property_list_optional_member(object_type, property),
+                property_list_member(
+                    property_list_optional(object_type), property),
+                "%s: %s", bactext_object_type_name(object_type),
+                bactext_property_name(property));
+            zassert_equal(
+                property_list_writable_member(object_type, property),
+                property_list_member(
+                    property_list_writable(object_type), property),
+                "%s: %s", bactext_object_type_name(object_type),
+                bactext_property_name(property));
+        }
+        for (j = 0; j < ARRAY_SIZE(extended_properties); j++) {
+            property = extended_properties[j];
+            zassert_equal(
+                property_list_required_member(object_type, property),
+                property_list_member(
+                    property_list_required(object_type), property),
+                NULL);
+            zassert_equal(
+                property_list_optional_member(object_type, property),
+                property_list_member(
+                    property_list_optional(object_type), property),
+                NULL);
+        }
+    }
+    zassert_true(
+        property_list_required_member(OBJECT_ANALOG_OUTPUT, PROP_UNITS), NULL);
+    zassert_false(
+        property_list_optional_member(OBJECT_ANALOG_OUTPUT, PROP_UNITS), NULL);
+    zassert_true(
+        property_list_writable_member(
+            OBJECT_ANALOG_OUTPUT, PROP_PRESENT_VALUE),
+        NULL);
+    zassert_false(
+        property_list_writable_member(OBJECT_ANALOG_INPUT, PROP_PRESENT_VALUE),
+        NULL);
+    /* a property bitmap built from the lists of an object */
+    memset(bitmap, 0, sizeof(bitmap));
+    property_list_bitmap_add(bitmap, property_list_required(OBJECT_CHANNEL));
+    property_list_bitmap_add(bitmap, property_list_optional(OBJECT_CHANNEL));
+    property_list_bitmap_add(bitmap, NULL);
+    for (j = 0; j < PROPERTY_LIST_BITMAP_BITS; j++) {
+        property = (BACNET_PROPERTY_ID)j;
+        zassert_equal(
+            property_list_bitmap_member(bitmap, property),
+            property_list_required_member(OBJECT_CHANNEL, property) ||
+                property_list_optional_member(OBJECT_CHANNEL, property),
+            "%s", bactext_property_name(property));
+    }
+    zassert_false(
+        property_list_bitmap_member(bitmap, PROPERTY_LIST_BITMAP_BITS), NULL);
+    zassert_false(property_list_bitmap_member(NULL, PROP_OBJECT_NAME), NULL);
+}
+
 /**
  * @}
  */
@@ -97,7 +182,9 @@ ZTEST_SUITE(property_tests, NULL, NULL, NULL, NULL, NULL);
 #else
 void test_main(void)
 {
-    ztest_test_suite(property_tests, ztest_unit_test(testPropList));
+    ztest_test_suite(
+        property_tests, ztest_unit_test(testPropList),
+        ztest_unit_test(testPropListMember));
 
     ztest_run_test_suite(property_tests);
 }
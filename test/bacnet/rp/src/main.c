@@ -202,6 +202,59 @@ static void testReadProperty(void)
 
     return;
 }
+
+#if defined(CONFIG_ZTEST_NEW_API)
+ZTEST(rp_tests, testReadPropertyStringEncode)
+#else
+static void testReadPropertyStringEncode(void)
+#endif
+{
+    uint8_t apdu[32] = { 0 };
+    uint8_t test_apdu[32] = { 0 };
+    BACNET_READ_PROPERTY_DATA rpdata = { 0 };
+    BACNET_CHARACTER_STRING char_string = { 0 };
+    BACNET_OCTET_STRING octet_string = { 0 };
+    int len = 0, test_len = 0;
+
+    characterstring_init_ansi(&char_string, "Nineteen characters");
+    octetstring_init(&octet_string, (uint8_t *)"0123456789", 10);
+    rpdata.application_data = apdu;
+    rpdata.application_data_len = sizeof(apdu);
+    /* the value fits */
+    test_len = encode_application_character_string(test_apdu, &char_string);
+    len = read_property_character_string_encode(&rpdata, NULL, &char_string);
+    zassert_equal(len, test_len, NULL);
+    len = read_property_character_string_encode(&rpdata, apdu, &char_string);
+    zassert_equal(len, test_len, NULL);
+    zassert_mem_equal(apdu, test_apdu, test_len, NULL);
+    test_len = encode_application_octet_string(test_apdu, &octet_string);
+    len = read_property_octet_string_encode(&rpdata, NULL, &octet_string);
+    zassert_equal(len, test_len, NULL);
+    len = read_property_octet_string_encode(&rpdata, apdu, &octet_string);
+    zassert_equal(len, test_len, NULL);
+    zassert_mem_equal(apdu, test_apdu, test_len, NULL);
+    /* the value does not fit after the octets already encoded */
+    rpdata.error_code = ERROR_CODE_SUCCESS;
+    len = read_property_character_string_encode(
+        &rpdata, &apdu[sizeof(apdu) - 20], &char_string);
+    zassert_equal(len, BACNET_STATUS_ABORT, NULL);
+    zassert_equal(
+        rpdata.error_code, ERROR_CODE_ABORT_SEGMENTATION_NOT_SUPPORTED, NULL);
+    rpdata.error_code = ERROR_CODE_SUCCESS;
+    len = read_property_octet_string_encode(
+        &rpdata, &apdu[sizeof(apdu) - 11], &octet_string);
+    zassert_equal(len, BACNET_STATUS_ABORT, NULL);
+    zassert_equal(
+        rpdata.error_code, ERROR_CODE_ABORT_SEGMENTATION_NOT_SUPPORTED, NULL);
+    /* exactly fits at the end */
+    len = read_property_octet_string_encode(
+        &rpdata, &apdu[sizeof(apdu) - 12], &octet_string);
+    zassert_equal(len, 12, NULL);
+    /* no application data to encode into */
+    rpdata.application_data = NULL;
+    len = read_property_character_string_encode(&rpdata, apdu, &char_string);
+    zassert_equal(len, BACNET_STATUS_ABORT, NULL);
+}
 /**
  * @}
  */
@@ -213,7 +266,8 @@ void test_main(void)
 {
     ztest_test_suite(
         rp_tests, ztest_unit_test(testReadProperty),
-        ztest_unit_test(testReadPropertyAck));
+        ztest_unit_test(testReadPropertyAck),
+        ztest_unit_test(testReadPropertyStringEncode));
 
     ztest_run_test_suite(rp_tests);
 }
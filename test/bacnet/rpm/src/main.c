@@ -204,6 +204,21 @@ static void testReadPropertyMultiple(void)
     zassert_equal(len, service_request_len, NULL);
 }
 
+static unsigned Test_Ack_Process_Count;
+static unsigned Test_Ack_Process_Errors;
+
+static void
+test_ack_process(uint32_t device_id, BACNET_READ_PROPERTY_DATA *rp_data)
+{
+    zassert_equal(device_id, 123, NULL);
+    Test_Ack_Process_Count++;
+    if (rp_data->error_code != ERROR_CODE_SUCCESS) {
+        zassert_equal(rp_data->error_class, ERROR_CLASS_PROPERTY, NULL);
+        zassert_equal(rp_data->error_code, ERROR_CODE_UNKNOWN_PROPERTY, NULL);
+        Test_Ack_Process_Errors++;
+    }
+}
+
 #if defined(CONFIG_ZTEST_NEW_API)
 ZTEST(rpm_tests, testReadPropertyMultipleAck)
 #else
@@ -229,6 +244,7 @@ static void testReadPropertyMultipleAck(void)
     BACNET_ERROR_CLASS error_class;
     BACNET_ERROR_CODE error_code;
     BACNET_RPM_DATA rpmdata;
+    BACNET_READ_PROPERTY_DATA rp_data = { 0 };
 
     /* build the RPM - try to make it easy for the
        Application Layer development */
@@ -431,6 +447,195 @@ static void testReadPropertyMultipleAck(void)
         &object_instance);
     zassert_equal(test_len, 0, NULL);
     zassert_equal(len, service_request_len, NULL);
+    /* process every property of every object */
+    Test_Ack_Process_Count = 0;
+    Test_Ack_Process_Errors = 0;
+    rp_data.error_code = ERROR_CODE_SUCCESS;
+    rpm_ack_object_property_process(
+        service_request, service_request_len, 123, &rp_data,
+        test_ack_process);
+    zassert_equal(Test_Ack_Process_Count, 4, NULL);
+    zassert_equal(Test_Ack_Process_Errors, 1, NULL);
+    zassert_equal(rp_data.object_type, OBJECT_ANALOG_INPUT, NULL);
+    zassert_equal(rp_data.object_instance, 33, NULL);
+    zassert_equal(rp_data.object_property, PROP_DEADBAND, NULL);
+}
+
+static const int Test_Properties_Required[] = { PROP_OBJECT_IDENTIFIER,
+                                                PROP_PRESENT_VALUE, -1 };
+static const int Test_Properties_Optional[] = { PROP_DESCRIPTION, -1 };
+static const int Test_Properties_Proprietary[] = { -1 };
+
+static int test_read_property(BACNET_READ_PROPERTY_DATA *rpdata)
+{
+    int apdu_len = BACNET_STATUS_ERROR;
+
+    switch (rpdata->object_property) {
+        case PROP_OBJECT_IDENTIFIER:
+            apdu_len = encode_application_object_id(
+                rpdata->application_data, rpdata->object_type,
+                rpdata->object_instance);
+            break;
+        case PROP_PRESENT_VALUE:
+            apdu_len = encode_application_real(rpdata->application_data, 1.0f);
+            break;
+        default:
+            rpdata->error_class = ERROR_CLASS_PROPERTY;
+            rpdata->error_code = ERROR_CODE_UNKNOWN_PROPERTY;
+            break;
+    }
+
+    return apdu_len;
+}
+
+static int test_property_list_expected(
+    uint8_t *apdu, BACNET_PROPERTY_ID special_property)
+{
+    int apdu_len = 0;
+    uint8_t value[MAX_APDU] = { 0 };
+    int value_len = 0;
+
+    if ((special_property == PROP_ALL) ||
+        (special_property == PROP_REQUIRED)) {
+        apdu_len += rpm_ack_encode_apdu_object_property(
+            &apdu[apdu_len], PROP_OBJECT_IDENTIFIER, BACNET_ARRAY_ALL);
+        value_len =
+            encode_application_object_id(value, OBJECT_ANALOG_INPUT, 1);
+        apdu_len += rpm_ack_encode_apdu_object_property_value(
+            &apdu[apdu_len], value, value_len);
+        apdu_len += rpm_ack_encode_apdu_object_property(
+            &apdu[apdu_len], PROP_PRESENT_VALUE, BACNET_ARRAY_ALL);
+        value_len = encode_application_real(value, 1.0f);
+        apdu_len += rpm_ack_encode_apdu_object_property_value(
+            &apdu[apdu_len], value, value_len);
+    }
+    if ((special_property == PROP_ALL) ||
+        (special_property == PROP_OPTIONAL)) {
+        apdu_len += rpm_ack_encode_apdu_object_property(
+            &apdu[apdu_len], PROP_DESCRIPTION, BACNET_ARRAY_ALL);
+        apdu_len += rpm_ack_encode_apdu_object_property_error(
+            &apdu[apdu_len], ERROR_CLASS_PROPERTY,
+            ERROR_CODE_UNKNOWN_PROPERTY);
+    }
+
+    return apdu_len;
+}
+
+#if defined(CONFIG_ZTEST_NEW_API)
+ZTEST(rpm_tests, testReadPropertyMultipleAckPropertyList)
+#else
+static void testReadPropertyMultipleAckPropertyList(void)
+#endif
+{
+    uint8_t apdu[MAX_APDU] = { 0 };
+    uint8_t test_apdu[MAX_APDU] = { 0 };
+    const BACNET_PROPERTY_ID special_properties[] = { PROP_ALL,
+                                                      PROP_REQUIRED,
+                                                      PROP_OPTIONAL };
+    BACNET_READ_PROPERTY_DATA rpdata = { 0 };
+    BACNET_WRITER writer = { 0 };
+    int len = 0, test_len = 0;
+    unsigned i;
+
+    for (i = 0; i < ARRAY_SIZE(special_properties); i++) {
+        rpdata.object_type = OBJECT_ANALOG_INPUT;
+        rpdata.object_instance = 1;
+        rpdata.object_property = special_properties[i];
+        rpdata.array_index = BACNET_ARRAY_ALL;
+        bacnet_writer_init(&writer, apdu, sizeof(apdu));
+        len = rpm_ack_property_list_encode(
+            &writer, &rpdata, Test_Properties_Required,
+            Test_Properties_Optional, Test_Properties_Proprietary,
+            test_read_property);
+        zassert_equal(len, BACNET_STATUS_OK, NULL);
+        zassert_equal(rpdata.object_property, special_properties[i], NULL);
+        test_len = test_property_list_expected(
+            test_apdu, special_properties[i]);
+        zassert_equal((int)bacnet_writer_length(&writer), test_len, NULL);
+        zassert_mem_equal(apdu, test_apdu, test_len, NULL);
+        /* one octet short of the encoding aborts */
+        bacnet_writer_init(&writer, apdu, test_len - 1);
+        len = rpm_ack_property_list_encode(
+            &writer, &rpdata, Test_Properties_Required,
+            Test_Properties_Optional, Test_Properties_Proprietary,
+            test_read_property);
+        zassert_equal(len, BACNET_STATUS_ABORT, NULL);
+        zassert_equal(
+            rpdata.error_code, ERROR_CODE_ABORT_SEGMENTATION_NOT_SUPPORTED,
+            NULL);
+    }
+    len = rpm_ack_property_list_encode(
+        &writer, &rpdata, Test_Properties_Required, Test_Properties_Optional,
+        Test_Properties_Proprietary, NULL);
+    zassert_equal(len, BACNET_STATUS_REJECT, NULL);
+}
+
+#if defined(CONFIG_ZTEST_NEW_API)
+ZTEST(rpm_tests, testReadPropertyMultipleAckPropertyEncode)
+#else
+static void testReadPropertyMultipleAckPropertyEncode(void)
+#endif
+{
+    uint8_t apdu[MAX_APDU] = { 0 };
+    uint8_t test_apdu[MAX_APDU] = { 0 };
+    uint8_t value[MAX_APDU] = { 0 };
+    BACNET_READ_PROPERTY_DATA rpdata = { 0 };
+    BACNET_WRITER writer = { 0 };
+    int len = 0, test_len = 0, value_len = 0;
+
+    rpdata.object_type = OBJECT_ANALOG_INPUT;
+    rpdata.object_instance = 1;
+    rpdata.object_property = PROP_PRESENT_VALUE;
+    rpdata.array_index = BACNET_ARRAY_ALL;
+    test_len = rpm_ack_encode_apdu_object_property(
+        test_apdu, PROP_PRESENT_VALUE, BACNET_ARRAY_ALL);
+    value_len = encode_application_real(value, 1.0f);
+    test_len += rpm_ack_encode_apdu_object_property_value(
+        &test_apdu[test_len], value, value_len);
+    /* less than the value buffer remains, so the value is bounced */
+    zassert_true(test_len < RPM_ACK_VALUE_BUFFER_SIZE, NULL);
+    bacnet_writer_init(&writer, apdu, test_len);
+    len = rpm_ack_property_encode(&writer, &rpdata, test_read_property);
+    zassert_equal(len, BACNET_STATUS_OK, NULL);
+    zassert_false(
+        (rpdata.application_data >= apdu) &&
+            (rpdata.application_data < &apdu[sizeof(apdu)]),
+        NULL);
+    zassert_equal((int)bacnet_writer_length(&writer), test_len, NULL);
+    zassert_mem_equal(apdu, test_apdu, test_len, NULL);
+    /* enough remains, so the value is read in place */
+    bacnet_writer_init(&writer, apdu, sizeof(apdu));
+    len = rpm_ack_property_encode(&writer, &rpdata, test_read_property);
+    zassert_equal(len, BACNET_STATUS_OK, NULL);
+    zassert_true(
+        (rpdata.application_data >= apdu) &&
+            (rpdata.application_data < &apdu[sizeof(apdu)]),
+        NULL);
+    zassert_equal((int)bacnet_writer_length(&writer), test_len, NULL);
+    zassert_mem_equal(apdu, test_apdu, test_len, NULL);
+    /* an error replaces the value */
+    rpdata.object_property = PROP_DESCRIPTION;
+    rpdata.array_index = 1;
+    test_len = rpm_ack_encode_apdu_object_property(
+        test_apdu, PROP_DESCRIPTION, 1);
+    test_len += rpm_ack_encode_apdu_object_property_error(
+        &test_apdu[test_len], ERROR_CLASS_PROPERTY,
+        ERROR_CODE_UNKNOWN_PROPERTY);
+    bacnet_writer_init(&writer, apdu, sizeof(apdu));
+    len = rpm_ack_property_encode(&writer, &rpdata, test_read_property);
+    zassert_equal(len, BACNET_STATUS_OK, NULL);
+    zassert_equal((int)bacnet_writer_length(&writer), test_len, NULL);
+    zassert_mem_equal(apdu, test_apdu, test_len, NULL);
+    /* no room for the value aborts */
+    rpdata.object_property = PROP_PRESENT_VALUE;
+    rpdata.array_index = BACNET_ARRAY_ALL;
+    bacnet_writer_init(&writer, apdu, 4);
+    len = rpm_ack_property_encode(&writer, &rpdata, test_read_property);
+    zassert_equal(len, BACNET_STATUS_ABORT, NULL);
+    zassert_equal(
+        rpdata.error_code, ERROR_CODE_ABORT_SEGMENTATION_NOT_SUPPORTED, NULL);
+    len = rpm_ack_property_encode(&writer, &rpdata, NULL);
+    zassert_equal(len, BACNET_STATUS_REJECT, NULL);
 }
 /**
  * @}
@@ -443,7 +648,9 @@ void test_main(void)
 {
     ztest_test_suite(
         rpm_tests, ztest_unit_test(testReadPropertyMultiple),
-        ztest_unit_test(testReadPropertyMultipleAck));
+        ztest_unit_test(testReadPropertyMultipleAck),
+        ztest_unit_test(testReadPropertyMultipleAckPropertyList),
+        ztest_unit_test(testReadPropertyMultipleAckPropertyEncode));
 
     ztest_run_test_suite(rpm_tests);
 }
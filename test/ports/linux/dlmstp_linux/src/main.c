@@ -0,0 +1,390 @@
+/**
+ * @file
+ * @brief Unit test for the receive queue and the reply index of the
+ *  Linux MS/TP datalink
+ * @author Steve Karg <skarg@users.sourceforge.net>
+ * @date 2024
+ * @copyright SPDX-License-Identifier: MIT
+ */
+#include <string.h>
+#include <unistd.h>
+#include <zephyr/ztest.h>
+#include <bacnet/bacenum.h>
+#include <bacnet/npdu.h>
+#include <bacnet/datalink/dlmstp.h>
+#include <bacnet/datalink/mstp.h>
+#include <bacnet/datalink/mstpdef.h>
+#include "rs485.h"
+
+/**
+ * @addtogroup bacnet_tests
+ * @{
+ */
+
+#define TEST_RECEIVE_PACKET_COUNT 8
+#define TEST_PDU_PACKET_COUNT 8
+#define TEST_STATION 5
+
+extern uint16_t MSTP_Dropped_Packets;
+
+static bool Test_Initialized;
+static uint8_t Test_Frame_Type;
+static uint8_t Test_Frame_Destination;
+static uint8_t Test_Frame_Data[DLMSTP_MPDU_MAX];
+static uint16_t Test_Frame_Length;
+
+void RS485_Set_Interface(char *ifname)
+{
+    (void)ifname;
+}
+
+void RS485_Initialize(void)
+{
+}
+
+uint32_t RS485_Get_Baud_Rate(void)
+{
+    return 38400;
+}
+
+bool RS485_Set_Baud_Rate(uint32_t baud)
+{
+    (void)baud;
+
+    return true;
+}
+
+void RS485_Send_Frame(
+    struct mstp_port_struct_t *mstp_port,
+    const uint8_t *buffer,
+    uint16_t nbytes)
+{
+    (void)mstp_port;
+    (void)buffer;
+    (void)nbytes;
+}
+
+void RS485_Check_UART_Data(struct mstp_port_struct_t *mstp_port)
+{
+    (void)mstp_port;
+    usleep(1000);
+}
+
+void MSTP_Init(struct mstp_port_struct_t *mstp_port)
+{
+    /* the node FSM does not run, so the queues are left to the test */
+    mstp_port->This_Station = 255;
+}
+
+void MSTP_Receive_Frame_FSM(struct mstp_port_struct_t *mstp_port)
+{
+    (void)mstp_port;
+}
+
+bool MSTP_Master_Node_FSM(struct mstp_port_struct_t *mstp_port)
+{
+    (void)mstp_port;
+
+    return false;
+}
+
+void MSTP_Slave_Node_FSM(struct mstp_port_struct_t *mstp_port)
+{
+    (void)mstp_port;
+}
+
+uint16_t MSTP_Create_Frame(
+    uint8_t *buffer,
+    uint16_t buffer_len,
+    uint8_t frame_type,
+    uint8_t destination,
+    uint8_t source,
+    const uint8_t *data,
+    uint16_t data_len)
+{
+    (void)buffer;
+    (void)buffer_len;
+    (void)source;
+    Test_Frame_Type = frame_type;
+    Test_Frame_Destination = destination;
+    memcpy(Test_Frame_Data, data, data_len);
+    Test_Frame_Length = data_len;
+
+    return data_len;
+}
+
+/**
+ * @brief Start the datalink once for all of the tests
+ */
+static void test_dlmstp_init(void)
+{
+    if (!Test_Initialized) {
+        zassert_true(dlmstp_init(NULL), NULL);
+        Test_Initialized = true;
+    }
+}
+
+/**
+ * @brief Hand a received frame to the datalink as the FSM would
+ * @param source - MS/TP address of the sender
+ * @param pdu - NPDU of the frame
+ * @param pdu_len - number of bytes in the NPDU
+ * @return number of bytes queued
+ */
+static uint16_t
+test_put_receive(uint8_t source, uint8_t *pdu, uint16_t pdu_len)
+{
+    struct mstp_port_struct_t port = { 0 };
+
+    port.InputBuffer = pdu;
+    port.InputBufferSize = pdu_len;
+    port.DataLength = pdu_len;
+    port.SourceAddress = source;
+
+    return MSTP_Put_Receive(&port);
+}
+
+/**
+ * @brief Encode an NPDU with a confirmed request or a reply APDU
+ * @param pdu - buffer for the NPDU
+ * @param pdu_type - APDU type
+ * @param invoke_id - invoke ID of the APDU
+ * @param service - service choice of the APDU
+ * @return number of bytes encoded
+ */
+static uint16_t test_encode_pdu(
+    uint8_t *pdu, uint8_t pdu_type, uint8_t invoke_id, uint8_t service)
+{
+    BACNET_NPDU_DATA npdu_data = { 0 };
+    uint16_t len;
+
+    npdu_encode_npdu_data(
+        &npdu_data, pdu_type == PDU_TYPE_CONFIRMED_SERVICE_REQUEST,
+        MESSAGE_PRIORITY_NORMAL);
+    len = (uint16_t)npdu_encode_pdu(pdu, NULL, NULL, &npdu_data);
+    pdu[len++] = pdu_type;
+    if (pdu_type == PDU_TYPE_CONFIRMED_SERVICE_REQUEST) {
+        pdu[len++] = 0x05;
+    }
+    pdu[len++] = invoke_id;
+    if ((pdu_type != PDU_TYPE_REJECT) && (pdu_type != PDU_TYPE_ABORT)) {
+        pdu[len++] = service;
+    }
+
+    return len;
+}
+
+/**
+ * @brief Queue a PDU to be sent by the datalink
+ * @param destination - MS/TP address of the receiver
+ * @param pdu_type - APDU type
+ * @param invoke_id - invoke ID of the APDU
+ * @param service - service choice of the APDU
+ */
+static void test_send_pdu(
+    uint8_t destination, uint8_t pdu_type, uint8_t invoke_id, uint8_t service)
+{
+    BACNET_ADDRESS dest = { 0 };
+    BACNET_NPDU_DATA npdu_data = { 0 };
+    uint8_t pdu[16] = { 0 };
+    uint16_t len;
+
+    len = test_encode_pdu(pdu, pdu_type, invoke_id, service);
+    dest.mac_len = 1;
+    dest.mac[0] = destination;
+    npdu_data.data_expecting_reply =
+        (pdu_type == PDU_TYPE_CONFIRMED_SERVICE_REQUEST);
+    zassert_equal(dlmstp_send_pdu(&dest, &npdu_data, pdu, len), len, NULL);
+}
+
+/**
+ * @brief Look for the reply to a DATA_EXPECTING_REPLY frame
+ * @param invoke_id - invoke ID of the confirmed request
+ * @param service - service choice of the confirmed request
+ * @return number of bytes in the reply frame, or 0 if none
+ */
+static uint16_t test_get_reply(uint8_t invoke_id, uint8_t service)
+{
+    struct mstp_port_struct_t port = { 0 };
+    uint8_t request[16] = { 0 };
+    uint8_t reply[DLMSTP_MPDU_MAX] = { 0 };
+
+    port.InputBuffer = request;
+    port.InputBufferSize = sizeof(request);
+    port.DataLength = test_encode_pdu(
+        request, PDU_TYPE_CONFIRMED_SERVICE_REQUEST, invoke_id, service);
+    port.SourceAddress = TEST_STATION;
+    port.OutputBuffer = reply;
+    port.OutputBufferSize = sizeof(reply);
+    Test_Frame_Length = 0;
+
+    return MSTP_Get_Reply(&port, 0);
+}
+
+/**
+ * @brief Take the next PDU from the send queue
+ * @return number of bytes in the frame, or 0 if the queue is empty
+ */
+static uint16_t test_get_send(void)
+{
+    struct mstp_port_struct_t port = { 0 };
+    uint8_t frame[DLMSTP_MPDU_MAX] = { 0 };
+
+    port.OutputBuffer = frame;
+    port.OutputBufferSize = sizeof(frame);
+    Test_Frame_Length = 0;
+
+    return MSTP_Get_Send(&port, 0);
+}
+
+/**
+ * @brief Test the receive queue, and the count of the dropped packets
+ */
+#if defined(CONFIG_ZTEST_NEW_API)
+ZTEST(dlmstp_linux_tests, testReceiveQueue)
+#else
+static void testReceiveQueue(void)
+#endif
+{
+    BACNET_ADDRESS src = { 0 };
+    uint8_t pdu[DLMSTP_MPDU_MAX] = { 0 };
+    uint8_t apdu[DLMSTP_MPDU_MAX] = { 0 };
+    uint16_t dropped;
+    unsigned i;
+
+    test_dlmstp_init();
+    /* nothing queued: no wait without a timeout, and a timed wait */
+    zassert_equal(dlmstp_receive(&src, apdu, sizeof(apdu), 0), 0, NULL);
+    zassert_equal(dlmstp_receive(&src, apdu, sizeof(apdu), 10), 0, NULL);
+    /* packets that arrive before the application reads are kept */
+    dropped = MSTP_Dropped_Packets;
+    for (i = 0; i < TEST_RECEIVE_PACKET_COUNT; i++) {
+        memset(pdu, (int)i, sizeof(pdu));
+        zassert_equal(test_put_receive(i + 1, pdu, i + 10), i + 10, NULL);
+    }
+    /* a full queue drops the packet */
+    zassert_equal(test_put_receive(100, pdu, 10), 0, NULL);
+    zassert_equal(MSTP_Dropped_Packets, dropped + 1, NULL);
+    for (i = 0; i < TEST_RECEIVE_PACKET_COUNT; i++) {
+        zassert_equal(
+            dlmstp_receive(&src, apdu, sizeof(apdu), 0), i + 10, NULL);
+        zassert_equal(src.mac_len, 1, NULL);
+        zassert_equal(src.mac[0], i + 1, NULL);
+        zassert_equal(apdu[0], i, NULL);
+        zassert_equal(apdu[i + 9], i, NULL);
+    }
+    zassert_equal(dlmstp_receive(&src, apdu, sizeof(apdu), 0), 0, NULL);
+    /* a broadcast has no MAC address */
+    zassert_equal(test_put_receive(MSTP_BROADCAST_ADDRESS, pdu, 4), 4, NULL);
+    zassert_equal(dlmstp_receive(&src, apdu, sizeof(apdu), 10), 4, NULL);
+    zassert_equal(src.mac_len, 0, NULL);
+    /* a packet larger than the application buffer is dropped and counted,
+       and does not block the packets behind it */
+    zassert_equal(test_put_receive(1, pdu, 20), 20, NULL);
+    zassert_equal(test_put_receive(2, pdu, 10), 10, NULL);
+    zassert_equal(dlmstp_receive(&src, apdu, 10, 0), 0, NULL);
+    zassert_equal(MSTP_Dropped_Packets, dropped + 2, NULL);
+    zassert_equal(dlmstp_receive(&src, apdu, 10, 0), 10, NULL);
+    zassert_equal(src.mac[0], 2, NULL);
+    zassert_equal(dlmstp_receive(&src, apdu, sizeof(apdu), 0), 0, NULL);
+}
+
+/**
+ * @brief Test the reply index of the send queue
+ */
+#if defined(CONFIG_ZTEST_NEW_API)
+ZTEST(dlmstp_linux_tests, testReplyIndex)
+#else
+static void testReplyIndex(void)
+#endif
+{
+    BACNET_NPDU_DATA npdu_data = { 0 };
+    uint8_t pdu[16] = { 0 };
+    uint16_t len;
+    unsigned i;
+
+    test_dlmstp_init();
+    zassert_equal(test_get_send(), 0, NULL);
+    /* only the last PDU is the reply, and it is queued behind
+       a request, a reply to another station, a reply with another
+       invoke ID, and a reply to another service */
+    test_send_pdu(
+        TEST_STATION, PDU_TYPE_CONFIRMED_SERVICE_REQUEST, 1,
+        SERVICE_CONFIRMED_READ_PROPERTY);
+    test_send_pdu(
+        TEST_STATION + 1, PDU_TYPE_COMPLEX_ACK, 1,
+        SERVICE_CONFIRMED_READ_PROPERTY);
+    test_send_pdu(
+        TEST_STATION, PDU_TYPE_COMPLEX_ACK, 2,
+        SERVICE_CONFIRMED_READ_PROPERTY);
+    test_send_pdu(
+        TEST_STATION, PDU_TYPE_COMPLEX_ACK, 1,
+        SERVICE_CONFIRMED_WRITE_PROPERTY);
+    test_send_pdu(
+        TEST_STATION, PDU_TYPE_COMPLEX_ACK, 1,
+        SERVICE_CONFIRMED_READ_PROPERTY);
+    zassert_equal(test_get_reply(3, SERVICE_CONFIRMED_READ_PROPERTY), 0, NULL);
+    len = test_get_reply(1, SERVICE_CONFIRMED_READ_PROPERTY);
+    zassert_true(len > 0, NULL);
+    zassert_equal(len, Test_Frame_Length, NULL);
+    zassert_equal(
+        Test_Frame_Type, FRAME_TYPE_BACNET_DATA_NOT_EXPECTING_REPLY, NULL);
+    zassert_equal(Test_Frame_Destination, TEST_STATION, NULL);
+    zassert_equal(Test_Frame_Data[len - 3], PDU_TYPE_COMPLEX_ACK, NULL);
+    zassert_equal(Test_Frame_Data[len - 2], 1, NULL);
+    zassert_equal(
+        Test_Frame_Data[len - 1], SERVICE_CONFIRMED_READ_PROPERTY, NULL);
+    /* the reply was taken out of the middle of the queue */
+    zassert_equal(test_get_reply(1, SERVICE_CONFIRMED_READ_PROPERTY), 0, NULL);
+    /* an abort is matched by the invoke ID alone */
+    test_send_pdu(TEST_STATION, PDU_TYPE_ABORT, 3, 0);
+    len = test_get_reply(3, SERVICE_CONFIRMED_READ_PROPERTY);
+    zassert_true(len > 0, NULL);
+    zassert_equal(Test_Frame_Data[len - 2], PDU_TYPE_ABORT, NULL);
+    zassert_equal(Test_Frame_Data[len - 1], 3, NULL);
+    /* the other PDUs are still sent in order */
+    zassert_true(test_get_send() > 0, NULL);
+    zassert_equal(
+        Test_Frame_Type, FRAME_TYPE_BACNET_DATA_EXPECTING_REPLY, NULL);
+    for (i = 0; i < 3; i++) {
+        len = test_get_send();
+        zassert_true(len > 0, NULL);
+        zassert_equal(
+            Test_Frame_Type, FRAME_TYPE_BACNET_DATA_NOT_EXPECTING_REPLY,
+            NULL);
+        zassert_equal(Test_Frame_Data[len - 3], PDU_TYPE_COMPLEX_ACK, NULL);
+    }
+    zassert_equal(Test_Frame_Destination, TEST_STATION, NULL);
+    zassert_equal(
+        Test_Frame_Data[len - 1], SERVICE_CONFIRMED_WRITE_PROPERTY, NULL);
+    zassert_equal(test_get_send(), 0, NULL);
+    /* the send queue holds a fixed number of PDUs */
+    for (i = 0; i < TEST_PDU_PACKET_COUNT; i++) {
+        test_send_pdu(TEST_STATION, PDU_TYPE_ABORT, (uint8_t)i, 0);
+    }
+    zassert_equal(dlmstp_send_pdu(NULL, &npdu_data, pdu, 1), 0, NULL);
+    len = test_get_reply(
+        TEST_PDU_PACKET_COUNT - 1, SERVICE_CONFIRMED_READ_PROPERTY);
+    zassert_true(len > 0, NULL);
+    for (i = 0; i < (TEST_PDU_PACKET_COUNT - 1); i++) {
+        zassert_true(test_get_send() > 0, NULL);
+        zassert_equal(Test_Frame_Data[Test_Frame_Length - 1], i, NULL);
+    }
+    zassert_equal(test_get_send(), 0, NULL);
+}
+/**
+ * @}
+ */
+
+#if defined(CONFIG_ZTEST_NEW_API)
+ZTEST_SUITE(dlmstp_linux_tests, NULL, NULL, NULL, NULL, NULL);
+#else
+void test_main(void)
+{
+    ztest_test_suite(
+        dlmstp_linux_tests, ztest_unit_test(testReceiveQueue),
+        ztest_unit_test(testReplyIndex));
+
+    ztest_run_test_suite(dlmstp_linux_tests);
+}
+#endif
@@ -0,0 +1,318 @@
+#!/usr/bin/env python3
+# SPDX-License-Identifier: MIT
+"""Generate the property membership bitmaps in src/bacnet/property.c
+
+The required, optional, and writable property lists in property.c are the
+source of the property membership. This script reads those lists and the
+switch statements in property_list_required(), property_list_optional(),
+and property_list_writable() that assign them to object types, and writes
+one bitmap per list, indexed by object type, between the markers
+    /* GENERATED PROPERTY BITMAPS BEGIN */
+    /* GENERATED PROPERTY BITMAPS END */
+in property.c.  Properties inside a preprocessor conditional in a list are
+emitted inside the same conditional in the bitmap.
+
+Run it from the top of the repository after changing a property list:
+    python3 tools/property-bitmap/property_bitmap.py
+or with --check to fail when the bitmaps in property.c are out of date.
+"""
+
+import argparse
+import os
+import re
+import sys
+
+ROOT = os.path.abspath(os.path.join(os.path.dirname(__file__), "..", ".."))
+BACENUM_H = os.path.join(ROOT, "src", "bacnet", "bacenum.h")
+PROPERTY_C = os.path.join(ROOT, "src", "bacnet", "property.c")
+BEGIN_MARKER = "/* GENERATED PROPERTY BITMAPS BEGIN */"
+END_MARKER = "/* GENERATED PROPERTY BITMAPS END */"
+# properties 0..511 are the ASHRAE reserved range held in the bitmaps
+BITMAP_BITS = 512
+BITMAP_WORDS = BITMAP_BITS // 32
+
+
+def enum_values(text, first, prefix):
+    """Return the name to value mapping of an enumeration in bacenum.h"""
+    values = {}
+    start = text.index(first)
+    end = text.index("}", start)
+    for name, value in re.findall(
+        r"\b(" + prefix + r"\w+)\s*=\s*(\w+)", text[start:end]
+    ):
+        if value in values:
+            values[name] = values[value]
+        else:
+            values[name] = int(value, 0)
+    return values
+
+
+def property_lists(text):
+    """Return the property lists, as name to list of (property, condition)"""
+    lists = {}
+    for name, body in re.findall(
+        r"static const int (\w+_Properties_\w+)\[\] = \{(.*?)\};", text, re.S
+    ):
+        items = []
+        condition = None
+        for line in body.splitlines():
+            line = line.strip()
+            if line.startswith("#if"):
+                condition = line
+            elif line.startswith("#endif"):
+                condition = None
+            elif line.startswith("#"):
+                raise ValueError("%s: unsupported '%s'" % (name, line))
+            else:
+                for prop in re.findall(r"\bPROP_\w+", line):
+                    items.append((prop, condition))
+        lists[name] = items
+    return lists
+
+
+def object_lists(text, function):
+    """Return the object-type to list-name assignments of a list function"""
+    signature = "const int *%s(BACNET_OBJECT_TYPE object_type)" % function
+    start = text.index(signature)
+    end = text.index("\n}\n", start)
+    assignments = {}
+    cases = []
+    default = None
+    for line in text[start:end].splitlines():
+        line = line.strip()
+        match = re.match(r"case (OBJECT_\w+):", line)
+        if match:
+            cases.append(match.group(1))
+            continue
+        if line == "default:":
+            cases.append(None)
+            continue
+        match = re.match(r"pList = (\w+);", line)
+        if match:
+            for case in cases:
+                if case is None:
+                    default = match.group(1)
+                else:
+                    assignments[case] = match.group(1)
+            cases = []
+    return assignments, default
+
+
+def bitmap(items, properties):
+    """Return the bitmap words of a list, as list of {condition: word}"""
+    words = [{None: 0} for _ in range(BITMAP_WORDS)]
+    for prop, condition in items:
+        value = properties[prop]
+        if value >= BITMAP_BITS:
+            # outside the bitmap - found by searching the list instead
+            continue
+        word = words[value // 32]
+        word[condition] = word.get(condition, 0) | (1 << (value % 32))
+    return words
+
+
+def row_text(words, indent):
+    """Return the C text of the words of one bitmap row, four per line"""
+    lines = []
+    values = []
+    for word in words:
+        base = word[None]
+        conditions = [c for c in word if c is not None]
+        if not conditions:
+            values.append("0x%08XUL," % base)
+            if len(values) == 4:
+                lines.append(indent + " ".join(values))
+                values = []
+            continue
+        if len(conditions) > 1:
+            raise ValueError("more than one condition in a bitmap word")
+        if values:
+            lines.append(indent + " ".join(values))
+            values = []
+        condition = conditions[0]
+        lines.extend(
+            [
+                condition,
+                "%s0x%08XUL," % (indent, base | word[condition]),
+                "#else",
+                "%s0x%08XUL," % (indent, base),
+                "#endif",
+            ]
+        )
+    if values:
+        lines.append(indent + " ".join(values))
+    return lines
+
+
+def comment_text(text, indent):
+    """Return a C comment wrapped to 80 columns"""
+    lines = []
+    line = indent + "/*"
+    for word in text.split():
+        if len(line) + len(word) + 4 > 80:
+            lines.append(line)
+            line = indent + "  "
+        line += " " + word
+    lines.append(line + " */")
+    return lines
+
+
+def bitmap_table(name, rows):
+    """Return the C text of a table of bitmap rows"""
+    lines = [
+        "static const uint32_t %s[][PROPERTY_BITMAP_WORDS] = {" % name,
+    ]
+    for index, (list_names, words) in enumerate(rows):
+        lines.extend(
+            comment_text("%u: %s" % (index, ", ".join(list_names)), "    ")
+        )
+        lines.append("    {")
+        lines.extend(row_text(words, "        "))
+        lines.append("    },")
+    lines.append("};")
+    return lines
+
+
+def index_table(name, objects, assignments, default, row_of):
+    """Return the C text of an object-type to bitmap row index table"""
+    lines = [
+        "static const uint8_t",
+        "    %s[BACNET_OBJECT_TYPE_LAST + 1] = {" % name,
+    ]
+    for object_name in objects:
+        list_name = assignments.get(object_name, default)
+        lines.append("    %u, /* %s */" % (row_of[list_name], object_name))
+    lines.append("};")
+    return lines
+
+
+def rows_of(list_names, lists, properties):
+    """Return the unique bitmap rows, and the row index of each list name"""
+    rows = []
+    row_of = {}
+    for list_name in list_names:
+        words = bitmap(lists[list_name], properties)
+        for index, (names, row_words) in enumerate(rows):
+            if row_words == words:
+                names.append(list_name)
+                row_of[list_name] = index
+                break
+        else:
+            row_of[list_name] = len(rows)
+            rows.append(([list_name], words))
+    return rows, row_of
+
+
+def generate(bacenum_text, property_text):
+    """Return the C text of the generated property bitmaps"""
+    properties = enum_values(bacenum_text, "PROP_ACKED_TRANSITIONS", "PROP_")
+    object_values = enum_values(bacenum_text, "OBJECT_ANALOG_INPUT", "OBJECT_")
+    match = re.search(r"BACNET_OBJECT_TYPE_LAST = (OBJECT_\w+)", bacenum_text)
+    last = object_values[match.group(1)]
+    objects = [None] * (last + 1)
+    for name, value in object_values.items():
+        if value <= last and name.startswith("OBJECT_") and not objects[value]:
+            objects[value] = name
+    lists = property_lists(property_text)
+    required, required_default = object_lists(
+        property_text, "property_list_required"
+    )
+    optional, optional_default = object_lists(
+        property_text, "property_list_optional"
+    )
+    writable, writable_default = object_lists(
+        property_text, "property_list_writable"
+    )
+
+    def used(assignments, default):
+        names = [default]
+        for object_name in objects:
+            name = assignments.get(object_name, default)
+            if name not in names:
+                names.append(name)
+        return names
+
+    list_rows, list_row_of = rows_of(
+        used(required, required_default) + used(optional, optional_default),
+        lists,
+        properties,
+    )
+    writable_rows, writable_row_of = rows_of(
+        used(writable, writable_default), lists, properties
+    )
+    lines = [
+        BEGIN_MARKER,
+        "/* Do not edit: generated from the property lists above by",
+        "   tools/property-bitmap/property_bitmap.py */",
+        "/* clang-format off */",
+        "#define PROPERTY_BITMAP_BITS %u" % BITMAP_BITS,
+        "#define PROPERTY_BITMAP_WORDS (PROPERTY_BITMAP_BITS / 32)",
+        "",
+        "#if BACNET_PROPERTY_LISTS",
+    ]
+    lines.extend(bitmap_table("Property_List_Bitmap", list_rows))
+    lines.append("")
+    lines.extend(
+        index_table(
+            "Property_Required_Bitmap_Index",
+            objects,
+            required,
+            required_default,
+            list_row_of,
+        )
+    )
+    lines.append("")
+    lines.extend(
+        index_table(
+            "Property_Optional_Bitmap_Index",
+            objects,
+            optional,
+            optional_default,
+            list_row_of,
+        )
+    )
+    lines.append("#endif")
+    lines.append("")
+    lines.extend(bitmap_table("Property_Writable_Bitmap", writable_rows))
+    lines.append("")
+    lines.extend(
+        index_table(
+            "Property_Writable_Bitmap_Index",
+            objects,
+            writable,
+            writable_default,
+            writable_row_of,
+        )
+    )
+    lines.append("/* clang-format on */")
+    lines.append(END_MARKER)
+    return "\n".join(lines)
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument(
+        "--check",
+        action="store_true",
+        help="fail if the generated bitmaps in property.c are out of date",
+    )
+    args = parser.parse_args()
+    with open(BACENUM_H, encoding="utf-8") as file:
+        bacenum_text = file.read()
+    with open(PROPERTY_C, encoding="utf-8") as file:
+        property_text = file.read()
+    begin = property_text.index(BEGIN_MARKER)
+    end = property_text.index(END_MARKER) + len(END_MARKER)
+    generated = generate(bacenum_text, property_text)
+    if args.check:
+        if property_text[begin:end] != generated:
+            print("%s: property bitmaps are out of date" % PROPERTY_C)
+            return 1
+        return 0
+    with open(PROPERTY_C, "w", encoding="utf-8") as file:
+        file.write(property_text[:begin] + generated + property_text[end:])
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())